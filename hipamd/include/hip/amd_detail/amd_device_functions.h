@@ -942,6 +942,19 @@ unsigned __smid(void)
     #endif
 }
 
+/*
+  hipGraphSetConditional sets the condition of the conditional graph nodes, which handle was
+  created with hipGraphConditionalHandleCreate. The nodes evaluate it after the kernel is done,
+  hence the store is released at the system scope.
+*/
+__device__
+inline
+void hipGraphSetConditional(unsigned long long handle, unsigned int value)
+{
+    __hip_atomic_store(reinterpret_cast<unsigned int*>(handle), value, __ATOMIC_RELEASE,
+                       __HIP_MEMORY_SCOPE_SYSTEM);
+}
+
 /**
  * Map HIP_DYNAMIC_SHARED to "extern __shared__" for compatibility with old HIP applications
  * To be removed in a future release.
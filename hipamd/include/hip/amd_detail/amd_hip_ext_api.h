@@ -0,0 +1,669 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef HIP_INCLUDE_AMD_HIP_EXT_API_H
+#define HIP_INCLUDE_AMD_HIP_EXT_API_H
+
+#include <hip/hip_runtime_api.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ *
+ * @addtogroup GlobalDefs
+ * @{
+ *
+ */
+
+/**
+ * Attributes of a range of entries in a batched copy.
+ */
+typedef struct hipMemcpyAttributes {
+  hipMemcpyKind kind;  ///< Direction of the copies, hipMemcpyDefault infers it from the pointers
+  unsigned int flags;  ///< Reserved for future use, must be 0
+} hipMemcpyAttributes;
+
+/**
+ * Callback, which returns the dynamic shared memory size a kernel needs for a block size.
+ */
+typedef size_t (*hipOccupancyB2DSize)(int blockSize);
+
+/**
+ * Operation types of hipStreamBatchMemOp.
+ */
+typedef enum hipStreamBatchMemOpType {
+  hipStreamMemOpWaitValue32 = 0x1,        ///< Wait on a 32 bit value
+  hipStreamMemOpWriteValue32 = 0x2,       ///< Write a 32 bit value
+  hipStreamMemOpFlushRemoteWrites = 0x3,  ///< Make the remote writes visible to the stream
+  hipStreamMemOpWaitValue64 = 0x4,        ///< Wait on a 64 bit value
+  hipStreamMemOpWriteValue64 = 0x5,       ///< Write a 64 bit value
+  hipStreamMemOpBarrier = 0x6             ///< Order the preceding writes before the following ones
+} hipStreamBatchMemOpType;
+
+/**
+ * Parameters of a single operation in hipStreamBatchMemOp.
+ */
+typedef union hipStreamBatchMemOpParams {
+  hipStreamBatchMemOpType operation;  ///< Operation type, common to all members
+  struct hipStreamMemOpWaitValueParams_t {
+    hipStreamBatchMemOpType operation;  ///< hipStreamMemOpWaitValue32 or hipStreamMemOpWaitValue64
+    hipDeviceptr_t address;             ///< Address of the value to wait on
+    union {
+      uint32_t value;                   ///< Value of hipStreamMemOpWaitValue32
+      uint64_t value64;                 ///< Value of hipStreamMemOpWaitValue64
+    };
+    unsigned int flags;                 ///< Wait condition, see hipStreamWaitValue32
+    hipDeviceptr_t alias;               ///< Reserved, must be 0
+  } waitValue;
+  struct hipStreamMemOpWriteValueParams_t {
+    hipStreamBatchMemOpType operation;  ///< hipStreamMemOpWriteValue32 or hipStreamMemOpWriteValue64
+    hipDeviceptr_t address;             ///< Address of the value to write
+    union {
+      uint32_t value;                   ///< Value of hipStreamMemOpWriteValue32
+      uint64_t value64;                 ///< Value of hipStreamMemOpWriteValue64
+    };
+    unsigned int flags;                 ///< Reserved, must be 0
+    hipDeviceptr_t alias;               ///< Reserved, must be 0
+  } writeValue;
+  struct hipStreamMemOpFlushRemoteWritesParams_t {
+    hipStreamBatchMemOpType operation;  ///< hipStreamMemOpFlushRemoteWrites
+    unsigned int flags;                 ///< Reserved, must be 0
+  } flushRemoteWrites;
+  struct hipStreamMemOpMemoryBarrierParams_t {
+    hipStreamBatchMemOpType operation;  ///< hipStreamMemOpBarrier
+    unsigned int flags;                 ///< Reserved, must be 0
+  } memoryBarrier;
+  uint64_t pad[6];                      ///< Reserved
+} hipStreamBatchMemOpParams;
+
+/**
+ * Parameters of a batch memory operation graph node.
+ */
+typedef struct hipBatchMemOpNodeParams {
+  hipCtx_t ctx;                           ///< Reserved, the node runs on the device of the graph
+  unsigned int count;                     ///< Number of operations in paramArray
+  hipStreamBatchMemOpParams* paramArray;  ///< Array of operations
+  unsigned int flags;                     ///< Reserved, must be 0
+} hipBatchMemOpNodeParams;
+
+/**
+ * Graph node type of the batch memory operation nodes, which hipGraphNodeType doesn't list.
+ */
+#define hipGraphNodeTypeExtBatchMemOp ((hipGraphNodeType)0x1000)
+
+/**
+ * Handle of a conditional node condition, which the kernels of a graph set with
+ * hipGraphSetConditional.
+ */
+typedef unsigned long long hipGraphConditionalHandle;
+
+/**
+ * Flag of hipGraphConditionalHandleCreate, which resets the condition to the default value
+ * at the start of every graph launch.
+ */
+#define hipGraphCondAssignDefault 0x1
+
+/**
+ * Conditional node types.
+ */
+typedef enum hipGraphConditionalNodeType {
+  hipGraphCondTypeIf = 0,      ///< Runs the first body once if the condition is nonzero and
+                               ///< the optional second body otherwise
+  hipGraphCondTypeWhile = 1,   ///< Runs the body as long as the condition is nonzero
+  hipGraphCondTypeSwitch = 2   ///< Runs the body, which the condition value selects
+} hipGraphConditionalNodeType;
+
+/**
+ * Parameters of a conditional graph node.
+ */
+typedef struct hipConditionalNodeParams {
+  hipGraphConditionalHandle handle;  ///< Condition of the node, created on the same graph
+  hipGraphConditionalNodeType type;  ///< Type of the node
+  unsigned int size;                 ///< Number of the bodies, 1 or 2 for hipGraphCondTypeIf,
+                                     ///< 1 for hipGraphCondTypeWhile
+  hipGraph_t* phGraph_out;           ///< Array of size graphs, which receive the node bodies
+  hipCtx_t ctx;                      ///< Reserved, the node runs on the device of the graph
+} hipConditionalNodeParams;
+
+/**
+ * Graph node type of the conditional nodes, which hipGraphNodeType doesn't list.
+ */
+#define hipGraphNodeTypeExtConditional ((hipGraphNodeType)0x1001)
+
+/**
+ * Max length of a CU pool name, including the terminating zero.
+ */
+#define HIP_EXT_CU_POOL_NAME_MAX 64
+
+/**
+ * Number of the 32 bit words in the CU mask of hipExtCUPoolInfo.
+ */
+#define HIP_EXT_CU_POOL_MASK_WORDS 32
+
+/**
+ * Description of a CU pool for hipExtDevicePartitionCUs.
+ */
+typedef struct hipExtCUPoolDesc {
+  const char* name;       ///< Name of the pool, unique on the device
+  unsigned int numCUs;    ///< Number of CUs in the pool or 0 to use the fraction
+  float fraction;         ///< Fraction of the device CUs in the (0, 1] range, if numCUs is 0
+} hipExtCUPoolDesc;
+
+/**
+ * Current state of a CU pool.
+ */
+typedef struct hipExtCUPoolInfo {
+  char name[HIP_EXT_CU_POOL_NAME_MAX];           ///< Name of the pool
+  unsigned int numCUs;                           ///< Number of CUs in the pool
+  unsigned int numStreams;                       ///< Number of the live streams in the pool
+  uint32_t cuMask[HIP_EXT_CU_POOL_MASK_WORDS];   ///< CU mask as hipExtStreamCreateWithCUMask
+                                                 ///< takes it
+} hipExtCUPoolInfo;
+
+/**
+ * Statistics of the pinned host allocation cache of a device.
+ */
+typedef struct hipExtHostMemCacheStats {
+  size_t cachedBytes;           ///< Freed pinned host memory kept for reuse
+  size_t cachedBlocks;          ///< Number of the freed allocations kept for reuse
+  size_t inUseBytes;            ///< Cached allocations, which the application still holds
+  unsigned long long hits;      ///< Allocations served from the freed ones
+  unsigned long long misses;    ///< Allocations, which went to the driver
+  unsigned long long releases;  ///< Freed allocations returned to the OS
+} hipExtHostMemCacheStats;
+
+/**
+ * Operation of an entry in hipExtMemMapBatch.
+ */
+typedef enum hipExtMemMapOpType {
+  hipExtMemMapOpMap = 0,    ///< Map the allocation handle to the range, as hipMemMap
+  hipExtMemMapOpUnmap = 1   ///< Unmap the range, as hipMemUnmap
+} hipExtMemMapOpType;
+
+/**
+ * An entry of a batch of virtual memory map and unmap operations.
+ */
+typedef struct hipExtMemMapOp {
+  hipExtMemMapOpType type;                  ///< Map or unmap
+  void* ptr;                                ///< Start of the virtual range
+  size_t size;                              ///< Size of the range in bytes
+  hipMemGenericAllocationHandle_t handle;   ///< Allocation to map, ignored by unmap
+} hipExtMemMapOp;
+
+/**
+* @}
+*/
+
+/**
+ *  @ingroup Memory
+ *  @{
+ *
+ */
+/**
+ * @brief Performs a batch of independent asynchronous memory copies.
+ *
+ * The copies have no ordering between each other and complete before any later work on the
+ * stream starts. All entries are validated before any copy is issued, hence on failure
+ * nothing is enqueued.
+ *
+ * @param [in] dsts - Array of destination pointers.
+ * @param [in] srcs - Array of source pointers.
+ * @param [in] sizes - Array of copy sizes in bytes.
+ * @param [in] count - Number of copies in the batch.
+ * @param [in] attrs - Array of attributes.
+ * @param [in] attrsIdxs - Array of the first entry index each attribute applies to. Attribute i
+ * applies to the entries [attrsIdxs[i], attrsIdxs[i + 1]), the first index must be 0.
+ * @param [in] numAttrs - Number of attributes.
+ * @param [out] failIdx - Index of the entry, which failed validation, or SIZE_MAX if the error
+ * doesn't belong to an entry. Can be NULL.
+ * @param [in] stream - Stream to enqueue the copies.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorInvalidMemcpyDirection
+ *
+ */
+hipError_t hipMemcpyBatchAsync(void** dsts, void** srcs, size_t* sizes, size_t count,
+                               hipMemcpyAttributes* attrs, size_t* attrsIdxs, size_t numAttrs,
+                               size_t* failIdx, hipStream_t stream);
+/**
+ * @brief Returns the statistics of the pinned host allocation cache of a device.
+ *
+ * HIP_HOST_MEM_CACHE_SIZE enables the cache. hipHostFree then keeps the freed allocations
+ * for reuse by the next hipHostMalloc with the same size class and coherence/NUMA flags.
+ *
+ * @param [in] device - Device index.
+ * @param [out] stats - Pointer to the statistics.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidDevice, #hipErrorInvalidValue
+ */
+hipError_t hipExtHostMemCacheGetStats(int device, hipExtHostMemCacheStats* stats);
+/**
+ * @brief Returns the freed pinned host allocations of a device to the OS.
+ *
+ * The allocations still in use by the queued GPU work are released after the work completes.
+ *
+ * @param [in] device - Device index.
+ * @param [in] minBytesToKeep - Freed memory, which the cache can keep.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidDevice
+ */
+hipError_t hipExtHostMemCacheTrim(int device, size_t minBytesToKeep);
+/**
+ * @brief Maps and unmaps a batch of virtual memory ranges.
+ *
+ * The entries have no ordering between each other, hence the ranges can't overlap. The back to
+ * back ranges are processed together and the device work is drained once for all the unmaps
+ * of the batch. All entries are validated before any operation is issued, hence on failure
+ * nothing is mapped or unmapped. The call returns after the batch completes.
+ *
+ * @param [in] ops - Array of the operations.
+ * @param [in] count - Number of the operations in the batch.
+ * @param [out] failIdx - Index of the entry, which failed validation, or SIZE_MAX if the error
+ * doesn't belong to an entry. Can be NULL.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue
+ */
+hipError_t hipExtMemMapBatch(const hipExtMemMapOp* ops, size_t count, size_t* failIdx);
+/**
+ * @brief Maps and unmaps a batch of virtual memory ranges in the stream order.
+ *
+ * Works as hipExtMemMapBatch, but the batch executes after the preceding work on the stream
+ * without blocking the calling thread. The unmaps wait only for the work on the stream. The
+ * other HIP calls see the new mappings when the call returns, hence the work enqueued after the
+ * batch can use the mapped ranges. The unmapped allocations are released after the batch
+ * completes.
+ *
+ * @param [in] ops - Array of the operations.
+ * @param [in] count - Number of the operations in the batch.
+ * @param [out] failIdx - Index of the entry, which failed validation, or SIZE_MAX if the error
+ * doesn't belong to an entry. Can be NULL.
+ * @param [in] stream - Stream to enqueue the batch.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorContextIsDestroyed,
+ * #hipErrorStreamCaptureUnsupported
+ */
+hipError_t hipExtMemMapBatchAsync(const hipExtMemMapOp* ops, size_t count, size_t* failIdx,
+                                  hipStream_t stream);
+/**
+ * @brief Sets the access of the devices to a batch of mapped virtual memory ranges.
+ *
+ * Each range must be a single mapping. The ranges can't overlap. All entries are validated
+ * before any access is changed.
+ *
+ * @param [in] ptrs - Array of the range starts.
+ * @param [in] sizes - Array of the range sizes in bytes.
+ * @param [in] count - Number of the ranges.
+ * @param [in] desc - Array of the access descriptors, which apply to every range.
+ * @param [in] descCount - Number of the descriptors.
+ * @param [out] failIdx - Index of the range, which failed, or SIZE_MAX if the error doesn't
+ * belong to a range. Can be NULL.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue
+ */
+hipError_t hipExtMemSetAccessBatch(void* const* ptrs, const size_t* sizes, size_t count,
+                                   const hipMemAccessDesc* desc, size_t descCount,
+                                   size_t* failIdx);
+/**
+ * @brief Prefetches a batch of managed memory ranges to their destinations.
+ *
+ * The batch behaves as hipMemPrefetchAsync calls in the array order, but the adjacent and
+ * overlapping ranges with the same destination are merged, the overridden parts of the earlier
+ * ranges are dropped and the result is enqueued as a single command on the stream.
+ *
+ * @param [in] ptrs - Array of the range starts.
+ * @param [in] sizes - Array of the range sizes in bytes.
+ * @param [in] devices - Array of the destination devices, hipCpuDeviceId for the host.
+ * @param [in] count - Number of the ranges.
+ * @param [in] stream - Stream to enqueue the prefetch, NULL uses the null stream of the current
+ * device.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorInvalidDevice, #hipErrorNotSupported,
+ * #hipErrorContextIsDestroyed
+ */
+hipError_t hipExtMemPrefetchBatchAsync(const void* const* ptrs, const size_t* sizes,
+                                       const int* devices, size_t count, hipStream_t stream);
+/**
+ * @brief Applies a batch of advices to managed memory ranges.
+ *
+ * The batch behaves as hipMemAdvise calls in the array order, but an advice, which a later one
+ * overrides, is dropped, the adjacent and overlapping ranges with the same advice are merged and
+ * all the advices of the same range are applied with a single update. All entries are validated
+ * before any advice is applied. Without HMM support the advices are ignored.
+ *
+ * @param [in] ptrs - Array of the range starts.
+ * @param [in] sizes - Array of the range sizes in bytes.
+ * @param [in] advices - Array of the advices.
+ * @param [in] devices - Array of the devices the advices refer to, hipCpuDeviceId for the host.
+ * @param [in] count - Number of the ranges.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorInvalidDevice
+ */
+hipError_t hipExtMemAdviseBatch(const void* const* ptrs, const size_t* sizes,
+                                const hipMemoryAdvise* advices, const int* devices, size_t count);
+/**
+* @}
+*/
+
+/**
+ *  @ingroup Occupancy
+ *  @{
+ *
+ */
+/**
+ * @brief Returns the grid and block sizes, which achieve the maximum occupancy for a kernel,
+ * which dynamic shared memory size depends on the block size.
+ *
+ * All block sizes up to the limit are considered. Larger blocks are preferred, if several
+ * sizes reach the same occupancy.
+ *
+ * @param [out] gridSize - Minimum grid size for the maximum occupancy.
+ * @param [out] blockSize - Block size for the maximum occupancy, 0 if no block size fits.
+ * @param [in] f - Kernel function.
+ * @param [in] blockSizeToDynamicSMemSize - Returns the dynamic shared memory per block for a
+ * block size.
+ * @param [in] blockSizeLimit - Maximum block size the kernel is designed for, 0 for no limit.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue
+ */
+hipError_t hipModuleOccupancyMaxPotentialBlockSizeVariableSMem(
+    int* gridSize, int* blockSize, hipFunction_t f, hipOccupancyB2DSize blockSizeToDynamicSMemSize,
+    int blockSizeLimit);
+/**
+ * @brief Returns the grid and block sizes, which achieve the maximum occupancy for a kernel,
+ * which dynamic shared memory size depends on the block size.
+ *
+ * @param [out] gridSize - Minimum grid size for the maximum occupancy.
+ * @param [out] blockSize - Block size for the maximum occupancy, 0 if no block size fits.
+ * @param [in] f - Kernel function.
+ * @param [in] blockSizeToDynamicSMemSize - Returns the dynamic shared memory per block for a
+ * block size.
+ * @param [in] blockSizeLimit - Maximum block size the kernel is designed for, 0 for no limit.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorInvalidDeviceFunction
+ *
+ * @see hipModuleOccupancyMaxPotentialBlockSizeVariableSMem
+ */
+hipError_t hipExtOccupancyMaxPotentialBlockSizeVariableSMem(
+    int* gridSize, int* blockSize, const void* f, hipOccupancyB2DSize blockSizeToDynamicSMemSize,
+    int blockSizeLimit);
+/**
+ * @brief Returns the dynamic shared memory per block, which is available when numBlocks
+ * blocks of blockSize threads are resident on a compute unit.
+ *
+ * @param [out] dynamicSmemSize - Available dynamic shared memory per block in bytes.
+ * @param [in] f - Kernel function.
+ * @param [in] numBlocks - Number of resident blocks per compute unit.
+ * @param [in] blockSize - Block size.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue
+ */
+hipError_t hipModuleOccupancyAvailableDynamicSMemPerBlock(size_t* dynamicSmemSize, hipFunction_t f,
+                                                          int numBlocks, int blockSize);
+/**
+ * @brief Returns the dynamic shared memory per block, which is available when numBlocks
+ * blocks of blockSize threads are resident on a compute unit.
+ *
+ * @param [out] dynamicSmemSize - Available dynamic shared memory per block in bytes.
+ * @param [in] f - Kernel function.
+ * @param [in] numBlocks - Number of resident blocks per compute unit.
+ * @param [in] blockSize - Block size.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorInvalidDeviceFunction
+ */
+hipError_t hipOccupancyAvailableDynamicSMemPerBlock(size_t* dynamicSmemSize, const void* f,
+                                                    int numBlocks, int blockSize);
+/**
+* @}
+*/
+
+/**
+ *  @ingroup Device
+ *  @{
+ *
+ */
+/**
+ * @brief Prints the contention statistics of the runtime locks to stderr.
+ *
+ * For each lock name the statistics include the number of acquisitions, the contended
+ * acquisitions, the total and the maximum wait time and the total hold time. The statistics
+ * are collected only if the runtime was started with DEBUG_CLR_MONITOR_PROFILE=1, and are also
+ * printed at process exit.
+ *
+ * @returns #hipSuccess, #hipErrorNotSupported if the profiling is disabled
+ */
+hipError_t hipExtDumpLockProfile(void);
+/**
+ * @brief Callback of the device memory watermarks.
+ *
+ * @param [in] freeBytes - Free device memory in bytes.
+ * @param [in] belowLow - 1 if the free memory dropped below the low watermark, 0 if it rose above
+ * the high watermark.
+ * @param [in] userData - User data passed to hipExtSetMemWatermarkCallback.
+ */
+typedef void (*hipExtMemWatermarkCallback)(size_t freeBytes, int belowLow, void* userData);
+/**
+ * @brief Sets the free memory watermarks of a device.
+ *
+ * The runtime calls the callback once the free device memory drops below lowFree and again
+ * only after it rises above highFree, and vice versa. The free memory is the value, which
+ * hipMemGetInfo reports. The callback runs on the thread, which allocated or released
+ * the memory, and must not allocate or free device memory.
+ *
+ * @param [in] device - Device index.
+ * @param [in] lowFree - Low watermark in free bytes.
+ * @param [in] highFree - High watermark in free bytes, must not be smaller than lowFree.
+ * @param [in] callback - Watermark callback, nullptr disables the notifications.
+ * @param [in] userData - User data passed to the callback.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidDevice, #hipErrorInvalidValue, #hipErrorNotSupported
+ */
+hipError_t hipExtSetMemWatermarkCallback(int device, size_t lowFree, size_t highFree,
+                                         hipExtMemWatermarkCallback callback, void* userData);
+/**
+ * @brief Partitions the CUs of a device into named pools.
+ *
+ * The pools are disjoint and each pool is spread evenly over the XCCs and the shader engines
+ * of the device. The new partitioning replaces the previous one, numPools of 0 removes it.
+ * The streams created with hipExtStreamCreateInCUPool keep their CU masks, hence the call
+ * fails while any of them is alive. In WGP mode a pool CU is a WGP.
+ *
+ * @param [in] device - Device index.
+ * @param [in] pools - Array of the pool descriptions.
+ * @param [in] numPools - Number of the pools.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidDevice, #hipErrorInvalidValue if a name is invalid
+ * or duplicated, the pools need more CUs than the device has or a pool stream is alive
+ */
+hipError_t hipExtDevicePartitionCUs(int device, const hipExtCUPoolDesc* pools,
+                                    unsigned int numPools);
+/**
+ * @brief Returns the number of the CU pools of a device.
+ *
+ * @param [in] device - Device index.
+ * @param [out] count - Pointer to the number of the pools.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidDevice, #hipErrorInvalidValue
+ */
+hipError_t hipExtDeviceGetCUPoolCount(int device, unsigned int* count);
+/**
+ * @brief Returns the current state of a CU pool.
+ *
+ * @param [in] device - Device index.
+ * @param [in] index - Index of the pool in the hipExtDevicePartitionCUs order.
+ * @param [out] info - Pointer to the pool state.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidDevice, #hipErrorInvalidValue
+ */
+hipError_t hipExtDeviceGetCUPoolInfo(int device, unsigned int index, hipExtCUPoolInfo* info);
+/**
+* @}
+*/
+
+/**
+ *  @ingroup Stream
+ *  @{
+ *
+ */
+/**
+ * @brief Enqueues a batch of stream memory operations.
+ *
+ * The operations run in the array order and the later work on the stream doesn't start until
+ * all waits in the batch are satisfied. All operations are validated before anything is
+ * enqueued. A run of writes is ordered against the preceding work with a single memory
+ * barrier, hence the writes of a run may become visible in any order, unless
+ * hipStreamMemOpBarrier separates them. If GPU_STREAMOPS_CP_WAIT is enabled, the waits on
+ * memory allocated with hipExtMallocWithFlags(hipMallocSignalMemory) are performed by the
+ * command processor, the other waits always use a kernel.
+ *
+ * @param [in] stream - Stream to enqueue the operations.
+ * @param [in] count - Number of operations in paramArray, must not be 0.
+ * @param [in] paramArray - Array of operations.
+ * @param [in] flags - Reserved, must be 0.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorContextIsDestroyed
+ */
+hipError_t hipStreamBatchMemOp(hipStream_t stream, unsigned int count,
+                               hipStreamBatchMemOpParams* paramArray, unsigned int flags);
+/**
+ * @brief Creates a stream, which runs on the CUs of a pool of the current device.
+ *
+ * Each pool stream gets a hardware queue of its own. The priority applies among the streams,
+ * which share the CUs of the pool.
+ *
+ * @param [out] stream - Pointer to the new stream.
+ * @param [in] poolName - Name of the pool, see hipExtDevicePartitionCUs.
+ * @param [in] flags - hipStreamDefault or hipStreamNonBlocking.
+ * @param [in] priority - Stream priority, as hipStreamCreateWithPriority takes it.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorOutOfMemory
+ */
+hipError_t hipExtStreamCreateInCUPool(hipStream_t* stream, const char* poolName,
+                                      unsigned int flags, int priority);
+/**
+* @}
+*/
+
+/**
+ *  @ingroup Graph
+ *  @{
+ *
+ */
+/**
+ * @brief Creates a batch memory operation node and adds it to a graph.
+ *
+ * The node performs the operations as hipStreamBatchMemOp does. The operations are copied,
+ * hence the array can be released after the call.
+ *
+ * @param [out] phGraphNode - Pointer to the new node.
+ * @param [in] hGraph - Graph to add the node to.
+ * @param [in] dependencies - Dependencies of the node.
+ * @param [in] numDependencies - Number of the dependencies.
+ * @param [in] nodeParams - Parameters of the node.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue
+ */
+hipError_t hipGraphAddBatchMemOpNode(hipGraphNode_t* phGraphNode, hipGraph_t hGraph,
+                                     const hipGraphNode_t* dependencies, size_t numDependencies,
+                                     const hipBatchMemOpNodeParams* nodeParams);
+/**
+ * @brief Returns the parameters of a batch memory operation node.
+ *
+ * The returned paramArray is owned by the node and stays valid until the node parameters
+ * change or the node is destroyed.
+ *
+ * @param [in] hNode - Node to get the parameters from.
+ * @param [out] nodeParams_out - Pointer to the parameters.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue
+ */
+hipError_t hipGraphBatchMemOpNodeGetParams(hipGraphNode_t hNode,
+                                           hipBatchMemOpNodeParams* nodeParams_out);
+/**
+ * @brief Sets the parameters of a batch memory operation node.
+ *
+ * @param [in] hNode - Node to set the parameters of.
+ * @param [in] nodeParams - Parameters of the node.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue
+ */
+hipError_t hipGraphBatchMemOpNodeSetParams(hipGraphNode_t hNode,
+                                           hipBatchMemOpNodeParams* nodeParams);
+/**
+ * @brief Sets the parameters of a batch memory operation node in an executable graph.
+ *
+ * @param [in] hGraphExec - Executable graph, which contains the node.
+ * @param [in] hNode - Node of the original graph.
+ * @param [in] nodeParams - Parameters of the node.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue
+ */
+hipError_t hipGraphExecBatchMemOpNodeSetParams(hipGraphExec_t hGraphExec, hipGraphNode_t hNode,
+                                               const hipBatchMemOpNodeParams* nodeParams);
+/**
+ * @brief Creates a condition for the conditional nodes of a graph.
+ *
+ * The condition lives as long as the graph. The kernels of the graph set it with
+ * hipGraphSetConditional, the conditional nodes evaluate it once their dependencies are done.
+ *
+ * @param [out] pHandle_out - Pointer to the new condition.
+ * @param [in] graph - Graph, which owns the condition.
+ * @param [in] defaultLaunchValue - Initial value of the condition.
+ * @param [in] flags - 0 or hipGraphCondAssignDefault to reset the value on every launch.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorOutOfMemory
+ */
+hipError_t hipGraphConditionalHandleCreate(hipGraphConditionalHandle* pHandle_out,
+                                           hipGraph_t graph, unsigned int defaultLaunchValue,
+                                           unsigned int flags);
+/**
+ * @brief Creates a conditional node and adds it to a graph.
+ *
+ * The node owns its bodies, which are returned in nodeParams->phGraph_out. The bodies are
+ * empty and the application populates them after the call. The bodies can't contain memory
+ * allocation or free nodes. While the stream capture is active, the node can be added to the
+ * capture graph and the capture dependencies updated with hipStreamUpdateCaptureDependencies.
+ *
+ * The runtime evaluates the condition on the host, once the dependencies of the node are done,
+ * and launches the selected body from a runtime worker thread. The stream of the node waits on
+ * the device meanwhile, the bodies run on a hardware queue, which isn't shared with other streams.
+ * Every evaluation, i.e. every iteration of a while node, takes a round trip through the host.
+ *
+ * @param [out] pGraphNode - Pointer to the new node.
+ * @param [in] graph - Graph to add the node to.
+ * @param [in] pDependencies - Dependencies of the node.
+ * @param [in] numDependencies - Number of the dependencies.
+ * @param [in,out] nodeParams - Parameters of the node.
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorOutOfMemory
+ */
+hipError_t hipGraphAddConditionalNode(hipGraphNode_t* pGraphNode, hipGraph_t graph,
+                                      const hipGraphNode_t* pDependencies, size_t numDependencies,
+                                      hipConditionalNodeParams* nodeParams);
+/**
+* @}
+*/
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* HIP_INCLUDE_AMD_HIP_EXT_API_H */
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef HIP_INCLUDE_AMD_HIPRTC_EXT_API_H
+#define HIP_INCLUDE_AMD_HIPRTC_EXT_API_H
+
+#include <hip/hiprtc.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @addtogroup Runtime Runtime Compilation
+ * @{
+ *
+ * A program compiles for every target given with a --offload-arch option. With several targets
+ * the compiles run concurrently, hiprtcGetCode returns a clang offload bundle of all code objects
+ * and hiprtcGetProgramLog the logs of all targets. The functions below return a single target.
+ */
+
+/**
+ * @brief Returns the code object size of one target of a compiled program.
+ *
+ * @param [in] prog - Compiled program.
+ * @param [in] arch - Target as given in --offload-arch, e.g. "gfx90a:xnack-".
+ * @param [out] codeSizeRet - Size of the code object.
+ *
+ * @returns #HIPRTC_SUCCESS, #HIPRTC_ERROR_INVALID_INPUT if the program has no such target
+ */
+hiprtcResult hiprtcGetCodeSizeForArch(hiprtcProgram prog, const char* arch, size_t* codeSizeRet);
+
+/**
+ * @brief Returns the code object of one target of a compiled program.
+ *
+ * @param [in] prog - Compiled program.
+ * @param [in] arch - Target as given in --offload-arch.
+ * @param [out] code - Buffer of hiprtcGetCodeSizeForArch bytes.
+ *
+ * @returns #HIPRTC_SUCCESS, #HIPRTC_ERROR_INVALID_INPUT if the program has no such target
+ */
+hiprtcResult hiprtcGetCodeForArch(hiprtcProgram prog, const char* arch, char* code);
+
+/**
+ * @brief Returns the compile log size of one target of a program.
+ *
+ * @param [in] prog - Program.
+ * @param [in] arch - Target as given in --offload-arch.
+ * @param [out] logSizeRet - Size of the log.
+ *
+ * @returns #HIPRTC_SUCCESS, #HIPRTC_ERROR_INVALID_INPUT if the program has no such target
+ */
+hiprtcResult hiprtcGetProgramLogSizeForArch(hiprtcProgram prog, const char* arch,
+                                            size_t* logSizeRet);
+
+/**
+ * @brief Returns the compile log of one target of a program.
+ *
+ * @param [in] prog - Program.
+ * @param [in] arch - Target as given in --offload-arch.
+ * @param [out] log - Buffer of hiprtcGetProgramLogSizeForArch bytes.
+ *
+ * @returns #HIPRTC_SUCCESS, #HIPRTC_ERROR_INVALID_INPUT if the program has no such target
+ */
+hiprtcResult hiprtcGetProgramLogForArch(hiprtcProgram prog, const char* arch, char* log);
+
+/**
+ * @}
+ */
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* HIP_INCLUDE_AMD_HIPRTC_EXT_API_H */
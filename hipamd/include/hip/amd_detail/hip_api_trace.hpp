@@ -22,6 +22,7 @@
 #pragma once
 
 #include <hip/hip_runtime.h>
+#include <hip/amd_detail/amd_hip_ext_api.h>
 
 // Define some version macros for the API table. Use similar naming conventions to HSA-runtime
 // (MAJOR and STEP versions). Three groups at this time:
@@ -61,7 +62,7 @@
 // - Reset any of the *_STEP_VERSION defines to zero if the corresponding *_MAJOR_VERSION increases
 #define HIP_API_TABLE_STEP_VERSION 0
 #define HIP_COMPILER_API_TABLE_STEP_VERSION 0
-#define HIP_RUNTIME_API_TABLE_STEP_VERSION 6
+#define HIP_RUNTIME_API_TABLE_STEP_VERSION 16
 
 // HIP API interface
 typedef hipError_t (*t___hipPopCallConfiguration)(dim3* gridDim, dim3* blockDim, size_t* sharedMem,
@@ -1004,6 +1005,94 @@ typedef hipError_t (*t_hipExtHostAlloc)(void **ptr, size_t size,
 typedef hipError_t (*t_hipDeviceGetTexture1DLinearMaxWidth)(size_t *maxWidthInElements,
                                                             const hipChannelFormatDesc *fmtDesc,
                                                             int device);
+
+typedef hipError_t (*t_hipMemcpyBatchAsync)(void** dsts, void** srcs, size_t* sizes, size_t count,
+                                            hipMemcpyAttributes* attrs, size_t* attrsIdxs,
+                                            size_t numAttrs, size_t* failIdx, hipStream_t stream);
+
+typedef hipError_t (*t_hipModuleOccupancyMaxPotentialBlockSizeVariableSMem)(
+    int* gridSize, int* blockSize, hipFunction_t f, hipOccupancyB2DSize blockSizeToDynamicSMemSize,
+    int blockSizeLimit);
+
+typedef hipError_t (*t_hipExtOccupancyMaxPotentialBlockSizeVariableSMem)(
+    int* gridSize, int* blockSize, const void* f, hipOccupancyB2DSize blockSizeToDynamicSMemSize,
+    int blockSizeLimit);
+
+typedef hipError_t (*t_hipModuleOccupancyAvailableDynamicSMemPerBlock)(size_t* dynamicSmemSize,
+                                                                       hipFunction_t f,
+                                                                       int numBlocks,
+                                                                       int blockSize);
+
+typedef hipError_t (*t_hipOccupancyAvailableDynamicSMemPerBlock)(size_t* dynamicSmemSize,
+                                                                 const void* f, int numBlocks,
+                                                                 int blockSize);
+
+typedef hipError_t (*t_hipExtDumpLockProfile)();
+
+typedef hipError_t (*t_hipExtSetMemWatermarkCallback)(int device, size_t lowFree, size_t highFree,
+                                                      hipExtMemWatermarkCallback callback,
+                                                      void* userData);
+
+typedef hipError_t (*t_hipStreamBatchMemOp)(hipStream_t stream, unsigned int count,
+                                            hipStreamBatchMemOpParams* paramArray,
+                                            unsigned int flags);
+
+typedef hipError_t (*t_hipGraphAddBatchMemOpNode)(hipGraphNode_t* phGraphNode, hipGraph_t hGraph,
+                                                  const hipGraphNode_t* dependencies,
+                                                  size_t numDependencies,
+                                                  const hipBatchMemOpNodeParams* nodeParams);
+
+typedef hipError_t (*t_hipGraphBatchMemOpNodeGetParams)(hipGraphNode_t hNode,
+                                                        hipBatchMemOpNodeParams* nodeParams_out);
+
+typedef hipError_t (*t_hipGraphBatchMemOpNodeSetParams)(hipGraphNode_t hNode,
+                                                        hipBatchMemOpNodeParams* nodeParams);
+
+typedef hipError_t (*t_hipGraphExecBatchMemOpNodeSetParams)(hipGraphExec_t hGraphExec,
+                                                            hipGraphNode_t hNode,
+                                                            const hipBatchMemOpNodeParams* nodeParams);
+
+typedef hipError_t (*t_hipGraphConditionalHandleCreate)(hipGraphConditionalHandle* pHandle_out,
+                                                        hipGraph_t graph,
+                                                        unsigned int defaultLaunchValue,
+                                                        unsigned int flags);
+
+typedef hipError_t (*t_hipGraphAddConditionalNode)(hipGraphNode_t* pGraphNode, hipGraph_t graph,
+                                                   const hipGraphNode_t* pDependencies,
+                                                   size_t numDependencies,
+                                                   hipConditionalNodeParams* nodeParams);
+
+typedef hipError_t (*t_hipExtDevicePartitionCUs)(int device, const hipExtCUPoolDesc* pools,
+                                                 unsigned int numPools);
+
+typedef hipError_t (*t_hipExtDeviceGetCUPoolCount)(int device, unsigned int* count);
+
+typedef hipError_t (*t_hipExtDeviceGetCUPoolInfo)(int device, unsigned int index,
+                                                  hipExtCUPoolInfo* info);
+
+typedef hipError_t (*t_hipExtStreamCreateInCUPool)(hipStream_t* stream, const char* poolName,
+                                                   unsigned int flags, int priority);
+
+typedef hipError_t (*t_hipExtHostMemCacheGetStats)(int device, hipExtHostMemCacheStats* stats);
+
+typedef hipError_t (*t_hipExtHostMemCacheTrim)(int device, size_t minBytesToKeep);
+
+typedef hipError_t (*t_hipExtMemMapBatch)(const hipExtMemMapOp* ops, size_t count, size_t* failIdx);
+
+typedef hipError_t (*t_hipExtMemMapBatchAsync)(const hipExtMemMapOp* ops, size_t count,
+                                               size_t* failIdx, hipStream_t stream);
+
+typedef hipError_t (*t_hipExtMemSetAccessBatch)(void* const* ptrs, const size_t* sizes,
+                                                size_t count, const hipMemAccessDesc* desc,
+                                                size_t descCount, size_t* failIdx);
+
+typedef hipError_t (*t_hipExtMemPrefetchBatchAsync)(const void* const* ptrs, const size_t* sizes,
+                                                    const int* devices, size_t count,
+                                                    hipStream_t stream);
+
+typedef hipError_t (*t_hipExtMemAdviseBatch)(const void* const* ptrs, const size_t* sizes,
+                                             const hipMemoryAdvise* advices, const int* devices,
+                                             size_t count);
 // HIP Compiler dispatch table
 struct HipCompilerDispatchTable {
   size_t size;
@@ -1488,4 +1577,32 @@ struct HipDispatchTable {
   t_hipDrvGraphMemcpyNodeSetParams hipDrvGraphMemcpyNodeSetParams_fn;
   t_hipExtHostAlloc hipExtHostAlloc_fn;
   t_hipDeviceGetTexture1DLinearMaxWidth hipDeviceGetTexture1DLinearMaxWidth_fn;
+  t_hipMemcpyBatchAsync hipMemcpyBatchAsync_fn;
+  t_hipModuleOccupancyMaxPotentialBlockSizeVariableSMem
+      hipModuleOccupancyMaxPotentialBlockSizeVariableSMem_fn;
+  t_hipExtOccupancyMaxPotentialBlockSizeVariableSMem
+      hipExtOccupancyMaxPotentialBlockSizeVariableSMem_fn;
+  t_hipModuleOccupancyAvailableDynamicSMemPerBlock
+      hipModuleOccupancyAvailableDynamicSMemPerBlock_fn;
+  t_hipOccupancyAvailableDynamicSMemPerBlock hipOccupancyAvailableDynamicSMemPerBlock_fn;
+  t_hipExtDumpLockProfile hipExtDumpLockProfile_fn;
+  t_hipExtSetMemWatermarkCallback hipExtSetMemWatermarkCallback_fn;
+  t_hipStreamBatchMemOp hipStreamBatchMemOp_fn;
+  t_hipGraphAddBatchMemOpNode hipGraphAddBatchMemOpNode_fn;
+  t_hipGraphBatchMemOpNodeGetParams hipGraphBatchMemOpNodeGetParams_fn;
+  t_hipGraphBatchMemOpNodeSetParams hipGraphBatchMemOpNodeSetParams_fn;
+  t_hipGraphExecBatchMemOpNodeSetParams hipGraphExecBatchMemOpNodeSetParams_fn;
+  t_hipGraphConditionalHandleCreate hipGraphConditionalHandleCreate_fn;
+  t_hipGraphAddConditionalNode hipGraphAddConditionalNode_fn;
+  t_hipExtDevicePartitionCUs hipExtDevicePartitionCUs_fn;
+  t_hipExtDeviceGetCUPoolCount hipExtDeviceGetCUPoolCount_fn;
+  t_hipExtDeviceGetCUPoolInfo hipExtDeviceGetCUPoolInfo_fn;
+  t_hipExtStreamCreateInCUPool hipExtStreamCreateInCUPool_fn;
+  t_hipExtHostMemCacheGetStats hipExtHostMemCacheGetStats_fn;
+  t_hipExtHostMemCacheTrim hipExtHostMemCacheTrim_fn;
+  t_hipExtMemMapBatch hipExtMemMapBatch_fn;
+  t_hipExtMemMapBatchAsync hipExtMemMapBatchAsync_fn;
+  t_hipExtMemSetAccessBatch hipExtMemSetAccessBatch_fn;
+  t_hipExtMemPrefetchBatchAsync hipExtMemPrefetchBatchAsync_fn;
+  t_hipExtMemAdviseBatch hipExtMemAdviseBatch_fn;
 };
@@ -438,11 +438,36 @@ enum hip_api_id_t {
   HIP_API_ID_hipDestroyTextureObject = HIP_API_ID_NONE,
   HIP_API_ID_hipDeviceGetCount = HIP_API_ID_NONE,
   HIP_API_ID_hipDeviceGetTexture1DLinearMaxWidth = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtDeviceGetCUPoolCount = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtDeviceGetCUPoolInfo = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtDevicePartitionCUs = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtDumpLockProfile = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtHostMemCacheGetStats = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtHostMemCacheTrim = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtMemAdviseBatch = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtMemMapBatch = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtMemMapBatchAsync = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtMemPrefetchBatchAsync = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtMemSetAccessBatch = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtOccupancyMaxPotentialBlockSizeVariableSMem = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtSetMemWatermarkCallback = HIP_API_ID_NONE,
+  HIP_API_ID_hipExtStreamCreateInCUPool = HIP_API_ID_NONE,
   HIP_API_ID_hipGetTextureAlignmentOffset = HIP_API_ID_NONE,
   HIP_API_ID_hipGetTextureObjectResourceDesc = HIP_API_ID_NONE,
   HIP_API_ID_hipGetTextureObjectResourceViewDesc = HIP_API_ID_NONE,
   HIP_API_ID_hipGetTextureObjectTextureDesc = HIP_API_ID_NONE,
   HIP_API_ID_hipGetTextureReference = HIP_API_ID_NONE,
+  HIP_API_ID_hipGraphAddBatchMemOpNode = HIP_API_ID_NONE,
+  HIP_API_ID_hipGraphAddConditionalNode = HIP_API_ID_NONE,
+  HIP_API_ID_hipGraphBatchMemOpNodeGetParams = HIP_API_ID_NONE,
+  HIP_API_ID_hipGraphBatchMemOpNodeSetParams = HIP_API_ID_NONE,
+  HIP_API_ID_hipGraphConditionalHandleCreate = HIP_API_ID_NONE,
+  HIP_API_ID_hipGraphExecBatchMemOpNodeSetParams = HIP_API_ID_NONE,
+  HIP_API_ID_hipMemcpyBatchAsync = HIP_API_ID_NONE,
+  HIP_API_ID_hipModuleOccupancyAvailableDynamicSMemPerBlock = HIP_API_ID_NONE,
+  HIP_API_ID_hipModuleOccupancyMaxPotentialBlockSizeVariableSMem = HIP_API_ID_NONE,
+  HIP_API_ID_hipOccupancyAvailableDynamicSMemPerBlock = HIP_API_ID_NONE,
+  HIP_API_ID_hipStreamBatchMemOp = HIP_API_ID_NONE,
   HIP_API_ID_hipTexObjectCreate = HIP_API_ID_NONE,
   HIP_API_ID_hipTexObjectDestroy = HIP_API_ID_NONE,
   HIP_API_ID_hipTexObjectGetResourceDesc = HIP_API_ID_NONE,
@@ -6045,6 +6070,34 @@ typedef struct hip_api_data_s {
 #define INIT_hipDeviceGetCount_CB_ARGS_DATA(cb_data) {};
 // hipDeviceGetTexture1DLinearMaxWidth()
 #define INIT_hipDeviceGetTexture1DLinearMaxWidth_CB_ARGS_DATA(cb_data) {};
+// hipExtDeviceGetCUPoolCount()
+#define INIT_hipExtDeviceGetCUPoolCount_CB_ARGS_DATA(cb_data) {};
+// hipExtDeviceGetCUPoolInfo()
+#define INIT_hipExtDeviceGetCUPoolInfo_CB_ARGS_DATA(cb_data) {};
+// hipExtDevicePartitionCUs()
+#define INIT_hipExtDevicePartitionCUs_CB_ARGS_DATA(cb_data) {};
+// hipExtDumpLockProfile()
+#define INIT_hipExtDumpLockProfile_CB_ARGS_DATA(cb_data) {};
+// hipExtHostMemCacheGetStats()
+#define INIT_hipExtHostMemCacheGetStats_CB_ARGS_DATA(cb_data) {};
+// hipExtHostMemCacheTrim()
+#define INIT_hipExtHostMemCacheTrim_CB_ARGS_DATA(cb_data) {};
+// hipExtMemAdviseBatch()
+#define INIT_hipExtMemAdviseBatch_CB_ARGS_DATA(cb_data) {};
+// hipExtMemMapBatch()
+#define INIT_hipExtMemMapBatch_CB_ARGS_DATA(cb_data) {};
+// hipExtMemMapBatchAsync()
+#define INIT_hipExtMemMapBatchAsync_CB_ARGS_DATA(cb_data) {};
+// hipExtMemPrefetchBatchAsync()
+#define INIT_hipExtMemPrefetchBatchAsync_CB_ARGS_DATA(cb_data) {};
+// hipExtMemSetAccessBatch()
+#define INIT_hipExtMemSetAccessBatch_CB_ARGS_DATA(cb_data) {};
+// hipExtOccupancyMaxPotentialBlockSizeVariableSMem()
+#define INIT_hipExtOccupancyMaxPotentialBlockSizeVariableSMem_CB_ARGS_DATA(cb_data) {};
+// hipExtSetMemWatermarkCallback()
+#define INIT_hipExtSetMemWatermarkCallback_CB_ARGS_DATA(cb_data) {};
+// hipExtStreamCreateInCUPool()
+#define INIT_hipExtStreamCreateInCUPool_CB_ARGS_DATA(cb_data) {};
 // hipGetTextureAlignmentOffset()
 #define INIT_hipGetTextureAlignmentOffset_CB_ARGS_DATA(cb_data) {};
 // hipGetTextureObjectResourceDesc()
@@ -6055,6 +6108,28 @@ typedef struct hip_api_data_s {
 #define INIT_hipGetTextureObjectTextureDesc_CB_ARGS_DATA(cb_data) {};
 // hipGetTextureReference()
 #define INIT_hipGetTextureReference_CB_ARGS_DATA(cb_data) {};
+// hipGraphAddBatchMemOpNode()
+#define INIT_hipGraphAddBatchMemOpNode_CB_ARGS_DATA(cb_data) {};
+// hipGraphAddConditionalNode()
+#define INIT_hipGraphAddConditionalNode_CB_ARGS_DATA(cb_data) {};
+// hipGraphBatchMemOpNodeGetParams()
+#define INIT_hipGraphBatchMemOpNodeGetParams_CB_ARGS_DATA(cb_data) {};
+// hipGraphBatchMemOpNodeSetParams()
+#define INIT_hipGraphBatchMemOpNodeSetParams_CB_ARGS_DATA(cb_data) {};
+// hipGraphConditionalHandleCreate()
+#define INIT_hipGraphConditionalHandleCreate_CB_ARGS_DATA(cb_data) {};
+// hipGraphExecBatchMemOpNodeSetParams()
+#define INIT_hipGraphExecBatchMemOpNodeSetParams_CB_ARGS_DATA(cb_data) {};
+// hipMemcpyBatchAsync()
+#define INIT_hipMemcpyBatchAsync_CB_ARGS_DATA(cb_data) {};
+// hipModuleOccupancyAvailableDynamicSMemPerBlock()
+#define INIT_hipModuleOccupancyAvailableDynamicSMemPerBlock_CB_ARGS_DATA(cb_data) {};
+// hipModuleOccupancyMaxPotentialBlockSizeVariableSMem()
+#define INIT_hipModuleOccupancyMaxPotentialBlockSizeVariableSMem_CB_ARGS_DATA(cb_data) {};
+// hipOccupancyAvailableDynamicSMemPerBlock()
+#define INIT_hipOccupancyAvailableDynamicSMemPerBlock_CB_ARGS_DATA(cb_data) {};
+// hipStreamBatchMemOp()
+#define INIT_hipStreamBatchMemOp_CB_ARGS_DATA(cb_data) {};
 // hipTexObjectCreate()
 #define INIT_hipTexObjectCreate_CB_ARGS_DATA(cb_data) {};
 // hipTexObjectDestroy()
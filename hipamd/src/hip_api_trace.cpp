@@ -803,6 +803,55 @@ hipError_t hipExternalMemoryGetMappedMipmappedArray(
 hipError_t hipDrvGraphMemcpyNodeGetParams(hipGraphNode_t hNode, HIP_MEMCPY3D* nodeParams);
 hipError_t hipDrvGraphMemcpyNodeSetParams(hipGraphNode_t hNode, const HIP_MEMCPY3D* nodeParams);
 
+hipError_t hipMemcpyBatchAsync(void** dsts, void** srcs, size_t* sizes, size_t count,
+                               hipMemcpyAttributes* attrs, size_t* attrsIdxs, size_t numAttrs,
+                               size_t* failIdx, hipStream_t stream);
+hipError_t hipModuleOccupancyMaxPotentialBlockSizeVariableSMem(
+    int* gridSize, int* blockSize, hipFunction_t f, hipOccupancyB2DSize blockSizeToDynamicSMemSize,
+    int blockSizeLimit);
+hipError_t hipExtOccupancyMaxPotentialBlockSizeVariableSMem(
+    int* gridSize, int* blockSize, const void* f, hipOccupancyB2DSize blockSizeToDynamicSMemSize,
+    int blockSizeLimit);
+hipError_t hipModuleOccupancyAvailableDynamicSMemPerBlock(size_t* dynamicSmemSize, hipFunction_t f,
+                                                          int numBlocks, int blockSize);
+hipError_t hipOccupancyAvailableDynamicSMemPerBlock(size_t* dynamicSmemSize, const void* f,
+                                                    int numBlocks, int blockSize);
+hipError_t hipExtDumpLockProfile();
+hipError_t hipExtSetMemWatermarkCallback(int device, size_t lowFree, size_t highFree,
+                                         hipExtMemWatermarkCallback callback, void* userData);
+hipError_t hipStreamBatchMemOp(hipStream_t stream, unsigned int count,
+                               hipStreamBatchMemOpParams* paramArray, unsigned int flags);
+hipError_t hipGraphAddBatchMemOpNode(hipGraphNode_t* phGraphNode, hipGraph_t hGraph,
+                                     const hipGraphNode_t* dependencies, size_t numDependencies,
+                                     const hipBatchMemOpNodeParams* nodeParams);
+hipError_t hipGraphBatchMemOpNodeGetParams(hipGraphNode_t hNode,
+                                           hipBatchMemOpNodeParams* nodeParams_out);
+hipError_t hipGraphBatchMemOpNodeSetParams(hipGraphNode_t hNode,
+                                           hipBatchMemOpNodeParams* nodeParams);
+hipError_t hipGraphExecBatchMemOpNodeSetParams(hipGraphExec_t hGraphExec, hipGraphNode_t hNode,
+                                               const hipBatchMemOpNodeParams* nodeParams);
+hipError_t hipGraphConditionalHandleCreate(hipGraphConditionalHandle* pHandle_out, hipGraph_t graph,
+                                           unsigned int defaultLaunchValue, unsigned int flags);
+hipError_t hipGraphAddConditionalNode(hipGraphNode_t* pGraphNode, hipGraph_t graph,
+                                      const hipGraphNode_t* pDependencies, size_t numDependencies,
+                                      hipConditionalNodeParams* nodeParams);
+hipError_t hipExtDevicePartitionCUs(int device, const hipExtCUPoolDesc* pools,
+                                    unsigned int numPools);
+hipError_t hipExtDeviceGetCUPoolCount(int device, unsigned int* count);
+hipError_t hipExtDeviceGetCUPoolInfo(int device, unsigned int index, hipExtCUPoolInfo* info);
+hipError_t hipExtStreamCreateInCUPool(hipStream_t* stream, const char* poolName, unsigned int flags,
+                                      int priority);
+hipError_t hipExtHostMemCacheGetStats(int device, hipExtHostMemCacheStats* stats);
+hipError_t hipExtHostMemCacheTrim(int device, size_t minBytesToKeep);
+hipError_t hipExtMemMapBatch(const hipExtMemMapOp* ops, size_t count, size_t* failIdx);
+hipError_t hipExtMemMapBatchAsync(const hipExtMemMapOp* ops, size_t count, size_t* failIdx,
+                                  hipStream_t stream);
+hipError_t hipExtMemSetAccessBatch(void* const* ptrs, const size_t* sizes, size_t count,
+                                   const hipMemAccessDesc* desc, size_t descCount, size_t* failIdx);
+hipError_t hipExtMemPrefetchBatchAsync(const void* const* ptrs, const size_t* sizes,
+                                       const int* devices, size_t count, hipStream_t stream);
+hipError_t hipExtMemAdviseBatch(const void* const* ptrs, const size_t* sizes,
+                                const hipMemoryAdvise* advices, const int* devices, size_t count);
 }  // namespace hip
 
 namespace hip {
@@ -1298,6 +1347,36 @@ void UpdateDispatchTable(HipDispatchTable* ptrDispatchTable) {
       hip::hipExternalMemoryGetMappedMipmappedArray;
   ptrDispatchTable->hipDrvGraphMemcpyNodeGetParams_fn = hip::hipDrvGraphMemcpyNodeGetParams;
   ptrDispatchTable->hipDrvGraphMemcpyNodeSetParams_fn = hip::hipDrvGraphMemcpyNodeSetParams;
+  ptrDispatchTable->hipMemcpyBatchAsync_fn = hip::hipMemcpyBatchAsync;
+  ptrDispatchTable->hipModuleOccupancyMaxPotentialBlockSizeVariableSMem_fn =
+      hip::hipModuleOccupancyMaxPotentialBlockSizeVariableSMem;
+  ptrDispatchTable->hipExtOccupancyMaxPotentialBlockSizeVariableSMem_fn =
+      hip::hipExtOccupancyMaxPotentialBlockSizeVariableSMem;
+  ptrDispatchTable->hipModuleOccupancyAvailableDynamicSMemPerBlock_fn =
+      hip::hipModuleOccupancyAvailableDynamicSMemPerBlock;
+  ptrDispatchTable->hipOccupancyAvailableDynamicSMemPerBlock_fn =
+      hip::hipOccupancyAvailableDynamicSMemPerBlock;
+  ptrDispatchTable->hipExtDumpLockProfile_fn = hip::hipExtDumpLockProfile;
+  ptrDispatchTable->hipExtSetMemWatermarkCallback_fn = hip::hipExtSetMemWatermarkCallback;
+  ptrDispatchTable->hipStreamBatchMemOp_fn = hip::hipStreamBatchMemOp;
+  ptrDispatchTable->hipGraphAddBatchMemOpNode_fn = hip::hipGraphAddBatchMemOpNode;
+  ptrDispatchTable->hipGraphBatchMemOpNodeGetParams_fn = hip::hipGraphBatchMemOpNodeGetParams;
+  ptrDispatchTable->hipGraphBatchMemOpNodeSetParams_fn = hip::hipGraphBatchMemOpNodeSetParams;
+  ptrDispatchTable->hipGraphExecBatchMemOpNodeSetParams_fn =
+      hip::hipGraphExecBatchMemOpNodeSetParams;
+  ptrDispatchTable->hipGraphConditionalHandleCreate_fn = hip::hipGraphConditionalHandleCreate;
+  ptrDispatchTable->hipGraphAddConditionalNode_fn = hip::hipGraphAddConditionalNode;
+  ptrDispatchTable->hipExtDevicePartitionCUs_fn = hip::hipExtDevicePartitionCUs;
+  ptrDispatchTable->hipExtDeviceGetCUPoolCount_fn = hip::hipExtDeviceGetCUPoolCount;
+  ptrDispatchTable->hipExtDeviceGetCUPoolInfo_fn = hip::hipExtDeviceGetCUPoolInfo;
+  ptrDispatchTable->hipExtStreamCreateInCUPool_fn = hip::hipExtStreamCreateInCUPool;
+  ptrDispatchTable->hipExtHostMemCacheGetStats_fn = hip::hipExtHostMemCacheGetStats;
+  ptrDispatchTable->hipExtHostMemCacheTrim_fn = hip::hipExtHostMemCacheTrim;
+  ptrDispatchTable->hipExtMemMapBatch_fn = hip::hipExtMemMapBatch;
+  ptrDispatchTable->hipExtMemMapBatchAsync_fn = hip::hipExtMemMapBatchAsync;
+  ptrDispatchTable->hipExtMemSetAccessBatch_fn = hip::hipExtMemSetAccessBatch;
+  ptrDispatchTable->hipExtMemPrefetchBatchAsync_fn = hip::hipExtMemPrefetchBatchAsync;
+  ptrDispatchTable->hipExtMemAdviseBatch_fn = hip::hipExtMemAdviseBatch;
 }
 
 #if HIP_ROCPROFILER_REGISTER > 0
@@ -1878,6 +1957,31 @@ HIP_ENFORCE_ABI(HipDispatchTable, hipDrvGraphMemcpyNodeGetParams_fn, 459)
 HIP_ENFORCE_ABI(HipDispatchTable, hipDrvGraphMemcpyNodeSetParams_fn, 460)
 HIP_ENFORCE_ABI(HipDispatchTable, hipExtHostAlloc_fn, 461)
 HIP_ENFORCE_ABI(HipDispatchTable, hipDeviceGetTexture1DLinearMaxWidth_fn, 462)
+HIP_ENFORCE_ABI(HipDispatchTable, hipMemcpyBatchAsync_fn, 463)
+HIP_ENFORCE_ABI(HipDispatchTable, hipModuleOccupancyMaxPotentialBlockSizeVariableSMem_fn, 464)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtOccupancyMaxPotentialBlockSizeVariableSMem_fn, 465)
+HIP_ENFORCE_ABI(HipDispatchTable, hipModuleOccupancyAvailableDynamicSMemPerBlock_fn, 466)
+HIP_ENFORCE_ABI(HipDispatchTable, hipOccupancyAvailableDynamicSMemPerBlock_fn, 467)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtDumpLockProfile_fn, 468)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtSetMemWatermarkCallback_fn, 469)
+HIP_ENFORCE_ABI(HipDispatchTable, hipStreamBatchMemOp_fn, 470)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphAddBatchMemOpNode_fn, 471)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphBatchMemOpNodeGetParams_fn, 472)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphBatchMemOpNodeSetParams_fn, 473)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphExecBatchMemOpNodeSetParams_fn, 474)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphConditionalHandleCreate_fn, 475)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphAddConditionalNode_fn, 476)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtDevicePartitionCUs_fn, 477)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtDeviceGetCUPoolCount_fn, 478)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtDeviceGetCUPoolInfo_fn, 479)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtStreamCreateInCUPool_fn, 480)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtHostMemCacheGetStats_fn, 481)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtHostMemCacheTrim_fn, 482)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtMemMapBatch_fn, 483)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtMemMapBatchAsync_fn, 484)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtMemSetAccessBatch_fn, 485)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtMemPrefetchBatchAsync_fn, 486)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtMemAdviseBatch_fn, 487)
 
 // if HIP_ENFORCE_ABI entries are added for each new function pointer in the table, the number below
 // will be +1 of the number in the last HIP_ENFORCE_ABI line. E.g.:
@@ -1885,9 +1989,9 @@ HIP_ENFORCE_ABI(HipDispatchTable, hipDeviceGetTexture1DLinearMaxWidth_fn, 462)
 //  HIP_ENFORCE_ABI(<table>, <functor>, 8)
 //
 //  HIP_ENFORCE_ABI_VERSIONING(<table>, 9) <- 8 + 1 = 9
-HIP_ENFORCE_ABI_VERSIONING(HipDispatchTable, 463)
+HIP_ENFORCE_ABI_VERSIONING(HipDispatchTable, 488)
 
-static_assert(HIP_RUNTIME_API_TABLE_MAJOR_VERSION == 0 && HIP_RUNTIME_API_TABLE_STEP_VERSION == 6,
+static_assert(HIP_RUNTIME_API_TABLE_MAJOR_VERSION == 0 && HIP_RUNTIME_API_TABLE_STEP_VERSION == 16,
               "If you get this error, add new HIP_ENFORCE_ABI(...) code for the new function "
               "pointers and then update this check so it is true");
 #endif
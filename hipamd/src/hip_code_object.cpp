@@ -1118,6 +1118,7 @@ StatCO::StatCO() {}
 
 StatCO::~StatCO() {
   amd::ScopedLock lock(sclock_);
+  funcCache_.invalidate();
 
   for (auto& elem : functions_) {
     delete elem.second;
@@ -1156,6 +1157,8 @@ FatBinaryInfo** StatCO::addFatBinary(const void* data, bool initialized) {
 
 hipError_t StatCO::removeFatBinary(FatBinaryInfo** module) {
   amd::ScopedLock lock(sclock_);
+  // The functions of the module are deleted below
+  funcCache_.invalidate();
 
   auto vit = vars_.begin();
   while (vit != vars_.end()) {
@@ -1228,6 +1231,10 @@ const char* StatCO::getStatFuncName(const void* hostFunction) {
 }
 
 hipError_t StatCO::getStatFunc(hipFunction_t* hfunc, const void* hostFunction, int deviceId) {
+  // A resolved function doesn't change until its module is removed
+  if (funcCache_.find(hostFunction, deviceId, hfunc)) {
+    return hipSuccess;
+  }
   amd::ScopedLock lock(sclock_);
 
   const auto it = functions_.find(hostFunction);
@@ -1235,7 +1242,11 @@ hipError_t StatCO::getStatFunc(hipFunction_t* hfunc, const void* hostFunction, i
     return hipErrorInvalidSymbol;
   }
 
-  return it->second->getStatFunc(hfunc, deviceId);
+  hipError_t err = it->second->getStatFunc(hfunc, deviceId);
+  if (err == hipSuccess) {
+    funcCache_.insert(hostFunction, deviceId, *hfunc);
+  }
+  return err;
 }
 
 hipError_t StatCO::getStatFuncAttr(hipFuncAttributes* func_attr, const void* hostFunction,
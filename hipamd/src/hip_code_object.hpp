@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "hip_internal.hpp"
 #include "device/device.hpp"
 #include "platform/program.hpp"
+#include "utils/concurrent.hpp"
 
 namespace hip {
 //Forward Declaration for friend usage
@@ -182,6 +183,8 @@ private:
   std::unordered_map<const void*, FatBinaryInfo*> modules_;
   //Populated during __hipRegisterFuncs
   std::unordered_map<const void*, Function*> functions_;
+  //Resolved functions per device and thread, the launches skip sclock_ on a hit
+  amd::ThreadLookupCache<hipFunction_t> funcCache_;
   //Populated during __hipRegisterVars
   std::unordered_map<const void*, Var*> vars_;
   //Populated during __hipRegisterManagedVar
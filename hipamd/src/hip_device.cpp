@@ -23,13 +23,19 @@
 
 #include "hip_internal.hpp"
 #include "hip_mempool_impl.hpp"
+#include "hip_ipc_cache.hpp"
+#include "hip_host_cache.hpp"
 #include "hip_platform.hpp"
+#include "device/devcupartition.hpp"
 
 #undef hipGetDeviceProperties
 #undef hipDeviceProp_t
 
 namespace hip {
 
+hipError_t ihipFree(void* ptr);
+static void BuildDeviceProperties(const amd::Device* deviceHandle, hipDeviceProp_tR0600* props);
+
 // ================================================================================================
 hip::Stream* Device::NullStream(bool wait) {
   if (null_stream_ == nullptr) {
@@ -50,6 +56,10 @@ hip::Stream* Device::NullStream(bool wait) {
 
 // ================================================================================================
 bool Device::Create() {
+  // The properties and the attributes depend on the immutable device info only
+  BuildDeviceProperties(devices()[0], &props_);
+  attributes_.Build(props_, devices()[0]->info(), devices()[0]->isFineGrainSupported());
+
   // Create default memory pool
   default_mem_pool_ = new MemoryPool(this);
   if (default_mem_pool_ == nullptr) {
@@ -71,9 +81,131 @@ bool Device::Create() {
 
   // Current is default pool after device creation
   current_mem_pool_ = default_mem_pool_;
+
+  ipc_mem_cache_ = CreateIpcMemCache(this);
+  if (ipc_mem_cache_ == nullptr) {
+    return false;
+  }
+
+  host_mem_cache_ = CreateHostMemCache(this);
+  if (host_mem_cache_ == nullptr) {
+    return false;
+  }
   return true;
 }
 
+// ================================================================================================
+void* Device::AllocDescriptor(size_t size) {
+  // Descriptors of a few hundred bytes share the slabs instead of a fine grained allocation each
+  constexpr size_t kDescriptorsPerSlab = 64;
+  amd::ScopedLock lock(descriptor_lock_);
+  amd::SlabAllocator*& slab = descriptor_slabs_[size];
+  if (slab == nullptr) {
+    slab = new amd::SlabAllocator(size, kDescriptorsPerSlab,
+        [](size_t slabSize) -> void* {
+          void* ptr = nullptr;
+          hipError_t err = ihipMalloc(&ptr, slabSize, CL_MEM_SVM_FINE_GRAIN_BUFFER);
+          return (err == hipSuccess) ? ptr : nullptr;
+        },
+        [](void* ptr) { ihipFree(ptr); });
+  }
+  return slab->allocate();
+}
+
+// ================================================================================================
+void Device::FreeDescriptor(void* ptr) {
+  amd::ScopedLock lock(descriptor_lock_);
+  for (auto& it : descriptor_slabs_) {
+    if (it.second->release(ptr)) {
+      return;
+    }
+  }
+  LogPrintfError("Descriptor %p doesn't belong to device %d", ptr, deviceId_);
+}
+
+// ================================================================================================
+void Device::DestroyDescriptorSlabs() {
+  amd::ScopedLock lock(descriptor_lock_);
+  for (auto& it : descriptor_slabs_) {
+    delete it.second;
+  }
+  descriptor_slabs_.clear();
+}
+
+// ================================================================================================
+hipError_t Device::PartitionCUs(const hipExtCUPoolDesc* pools, unsigned int numPools) {
+  const auto& info = devices()[0]->info();
+  amd::device::CuTopology topo = {info.maxComputeUnits_,
+                                  static_cast<uint32_t>(info.numberOfShaderEngines),
+                                  static_cast<uint32_t>(info.numberOfXccs)};
+  std::vector<uint32_t> counts(numPools);
+  for (unsigned int i = 0; i < numPools; ++i) {
+    if ((pools[i].name == nullptr) || (::strlen(pools[i].name) == 0) ||
+        (::strlen(pools[i].name) >= HIP_EXT_CU_POOL_NAME_MAX)) {
+      return hipErrorInvalidValue;
+    }
+    for (unsigned int j = 0; j < i; ++j) {
+      if (::strcmp(pools[i].name, pools[j].name) == 0) {
+        return hipErrorInvalidValue;
+      }
+    }
+    counts[i] = (pools[i].numCUs != 0) ? pools[i].numCUs
+                                       : amd::device::CuCountFromFraction(topo, pools[i].fraction);
+  }
+  std::vector<std::vector<uint32_t>> masks;
+  if (!amd::device::PartitionCUs(topo, counts, &masks)) {
+    return hipErrorInvalidValue;
+  }
+
+  amd::ScopedLock lock(cu_pool_lock_);
+  // The streams keep the hardware queues with the old masks, so they would overlap the new pools
+  for (const auto& pool : cu_pools_) {
+    if (!pool.streams_.empty()) {
+      return hipErrorInvalidValue;
+    }
+  }
+  cu_pools_.clear();
+  cu_pools_.reserve(numPools);
+  for (unsigned int i = 0; i < numPools; ++i) {
+    cu_pools_.push_back({pools[i].name, masks[i], counts[i], {}});
+    ClPrint(amd::LOG_INFO, amd::LOG_QUEUE, "CU pool %s on device %d: %u CUs", pools[i].name,
+            deviceId_, counts[i]);
+  }
+  return hipSuccess;
+}
+
+// ================================================================================================
+CuPool* Device::FindCuPool(const char* name) {
+  for (auto& pool : cu_pools_) {
+    if (pool.name_ == name) {
+      return &pool;
+    }
+  }
+  return nullptr;
+}
+
+// ================================================================================================
+size_t Device::CuPoolCount() {
+  amd::ScopedLock lock(cu_pool_lock_);
+  return cu_pools_.size();
+}
+
+// ================================================================================================
+hipError_t Device::GetCuPoolInfo(size_t index, hipExtCUPoolInfo* info) {
+  amd::ScopedLock lock(cu_pool_lock_);
+  if (index >= cu_pools_.size()) {
+    return hipErrorInvalidValue;
+  }
+  const CuPool& pool = cu_pools_[index];
+  ::memset(info, 0, sizeof(hipExtCUPoolInfo));
+  ::strncpy(info->name, pool.name_.c_str(), HIP_EXT_CU_POOL_NAME_MAX - 1);
+  info->numCUs = pool.numCUs_;
+  info->numStreams = static_cast<unsigned int>(pool.streams_.size());
+  size_t words = std::min(pool.cuMask_.size(), static_cast<size_t>(HIP_EXT_CU_POOL_MASK_WORDS));
+  ::memcpy(info->cuMask, pool.cuMask_.data(), words * sizeof(uint32_t));
+  return hipSuccess;
+}
+
 // ================================================================================================
 bool Device::IsMemoryPoolValid(MemoryPool* pool) {
   amd::ScopedLock lock(lock_);
@@ -148,8 +280,15 @@ void Device::Reset() {
     }
     mem_pools_.clear();
   }
+  // Detach the IPC mappings and free the cached host memory before the streams go away
+  // and the memory objects are purged. Create() makes new caches
+  delete ipc_mem_cache_;
+  ipc_mem_cache_ = nullptr;
+  delete host_mem_cache_;
+  host_mem_cache_ = nullptr;
   flags_ = hipDeviceScheduleSpin;
   destroyAllStreams();
+  DestroyDescriptorSlabs();
   amd::MemObjMap::Purge(devices()[0]);
   Create();
 }
@@ -221,8 +360,14 @@ void Device::AddStream(Stream* stream) {
 
 // ================================================================================================
 void Device::RemoveStream(Stream* stream){
-  amd::ScopedLock lock(streamSetLock);
-  streamSet.erase(stream);
+  {
+    amd::ScopedLock lock(streamSetLock);
+    streamSet.erase(stream);
+  }
+  amd::ScopedLock lock(cu_pool_lock_);
+  for (auto& pool : cu_pools_) {
+    pool.streams_.erase(stream);
+  }
 }
 
 // ================================================================================================
@@ -295,8 +440,25 @@ bool Device::existsActiveStreamForDevice() {
   return false;
 }
 
+// ================================================================================================
+void Device::GetLastCommands(std::vector<amd::Command*>* commands) {
+  amd::ScopedLock lock(streamSetLock);
+  for (auto it : streamSet) {
+    amd::Command* command = it->getLastQueuedCommand(true);
+    if (command != nullptr) {
+      commands->push_back(command);
+    }
+  }
+}
+
 // ================================================================================================
 Device::~Device() {
+  // Detach the idle IPC mappings and free the cached host memory, while the streams are alive
+  delete ipc_mem_cache_;
+  delete host_mem_cache_;
+
+  DestroyDescriptorSlabs();
+
   if (default_mem_pool_ != nullptr) {
     default_mem_pool_->release();
   }
@@ -436,16 +598,52 @@ hipError_t hipDeviceGetUuid(hipUUID* uuid, hipDevice_t device) {
   HIP_RETURN(hipSuccess);
 }
 
-hipError_t ihipGetDeviceProperties(hipDeviceProp_tR0600* props, int device) {
-  if (props == nullptr) {
-    return hipErrorInvalidValue;
+hipError_t hipExtDevicePartitionCUs(int device, const hipExtCUPoolDesc* pools,
+                                    unsigned int numPools) {
+  HIP_INIT_API(hipExtDevicePartitionCUs, device, pools, numPools);
+
+  if (device < 0 || static_cast<size_t>(device) >= g_devices.size()) {
+    HIP_RETURN(hipErrorInvalidDevice);
   }
 
-  if (unsigned(device) >= g_devices.size()) {
-    return hipErrorInvalidDevice;
+  if (numPools > 0 && pools == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
   }
-  auto* deviceHandle = g_devices[device]->devices()[0];
 
+  HIP_RETURN(g_devices[device]->PartitionCUs(pools, numPools));
+}
+
+hipError_t hipExtDeviceGetCUPoolCount(int device, unsigned int* count) {
+  HIP_INIT_API(hipExtDeviceGetCUPoolCount, device, count);
+
+  if (device < 0 || static_cast<size_t>(device) >= g_devices.size()) {
+    HIP_RETURN(hipErrorInvalidDevice);
+  }
+
+  if (count == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+
+  *count = static_cast<unsigned int>(g_devices[device]->CuPoolCount());
+  HIP_RETURN(hipSuccess);
+}
+
+hipError_t hipExtDeviceGetCUPoolInfo(int device, unsigned int index, hipExtCUPoolInfo* info) {
+  HIP_INIT_API(hipExtDeviceGetCUPoolInfo, device, index, info);
+
+  if (device < 0 || static_cast<size_t>(device) >= g_devices.size()) {
+    HIP_RETURN(hipErrorInvalidDevice);
+  }
+
+  if (info == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+
+  HIP_RETURN(g_devices[device]->GetCuPoolInfo(index, info));
+}
+
+// ================================================================================================
+static void BuildDeviceProperties(const amd::Device* deviceHandle, hipDeviceProp_tR0600* props) {
   constexpr auto int32_max = static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
   constexpr auto uint16_max = static_cast<uint64_t>(std::numeric_limits<uint16_t>::max()) + 1;
   hipDeviceProp_tR0600 deviceProps = {0};
@@ -628,6 +826,19 @@ hipError_t ihipGetDeviceProperties(hipDeviceProp_tR0600* props, int device) {
   deviceProps.integrated = info.hostUnifiedMemory_;
 
   *props = deviceProps;
+}
+
+// ================================================================================================
+hipError_t ihipGetDeviceProperties(hipDeviceProp_tR0600* props, int device) {
+  if (props == nullptr) {
+    return hipErrorInvalidValue;
+  }
+
+  if (unsigned(device) >= g_devices.size()) {
+    return hipErrorInvalidDevice;
+  }
+
+  *props = g_devices[device]->Properties();
   return hipSuccess;
 }
 
@@ -0,0 +1,167 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_device_attributes.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace hip {
+
+// ================================================================================================
+DeviceAttributes::Value* DeviceAttributes::Slot(hipDeviceAttribute_t attr) {
+  const bool amdSpecific = (attr >= hipDeviceAttributeAmdSpecificBegin);
+  const size_t index = attr - (amdSpecific ? hipDeviceAttributeAmdSpecificBegin :
+                                             hipDeviceAttributeCudaCompatibleBegin);
+  auto& range = ranges_[amdSpecific ? 1 : 0];
+  if (index >= range.size()) {
+    range.resize(index + 1);
+  }
+  return &range[index];
+}
+
+// ================================================================================================
+bool DeviceAttributes::Get(hipDeviceAttribute_t attr, int* pi) const {
+  if (attr < hipDeviceAttributeCudaCompatibleBegin || attr >= hipDeviceAttributeAmdSpecificEnd) {
+    return false;
+  }
+  const bool amdSpecific = (attr >= hipDeviceAttributeAmdSpecificBegin);
+  const size_t index = attr - (amdSpecific ? hipDeviceAttributeAmdSpecificBegin :
+                                             hipDeviceAttributeCudaCompatibleBegin);
+  const auto& range = ranges_[amdSpecific ? 1 : 0];
+  if (index >= range.size() || !range[index].valid_) {
+    return false;
+  }
+  if (range[index].pointer_) {
+    *reinterpret_cast<unsigned int**>(pi) = reinterpret_cast<unsigned int*>(range[index].value_);
+  } else {
+    *pi = static_cast<int>(range[index].value_);
+  }
+  return true;
+}
+
+// ================================================================================================
+void DeviceAttributes::Build(const hipDeviceProp_tR0600& prop, const amd::device::Info& info,
+                             bool fineGrainSupported) {
+  constexpr auto int32_max = static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+
+  Set(hipDeviceAttributeMaxThreadsPerBlock, prop.maxThreadsPerBlock);
+  Set(hipDeviceAttributeAsyncEngineCount, prop.asyncEngineCount);
+  Set(hipDeviceAttributeMaxBlockDimX, prop.maxThreadsDim[0]);
+  Set(hipDeviceAttributeMaxBlockDimY, prop.maxThreadsDim[1]);
+  Set(hipDeviceAttributeMaxBlockDimZ, prop.maxThreadsDim[2]);
+  Set(hipDeviceAttributeMaxGridDimX, prop.maxGridSize[0]);
+  Set(hipDeviceAttributeMaxGridDimY, prop.maxGridSize[1]);
+  Set(hipDeviceAttributeMaxGridDimZ, prop.maxGridSize[2]);
+  Set(hipDeviceAttributeMaxSurface1D, prop.maxSurface1D);
+  Set(hipDeviceAttributeMaxSharedMemoryPerBlock, prop.sharedMemPerBlock);
+  Set(hipDeviceAttributeSharedMemPerBlockOptin, prop.sharedMemPerBlockOptin);
+  Set(hipDeviceAttributeSharedMemPerMultiprocessor, prop.sharedMemPerMultiprocessor);
+  Set(hipDeviceAttributeStreamPrioritiesSupported, prop.streamPrioritiesSupported);
+  Set(hipDeviceAttributeSurfaceAlignment, prop.surfaceAlignment);
+  // size_t to int casting
+  Set(hipDeviceAttributeTotalConstantMemory, std::min(prop.totalConstMem, int32_max));
+  Set(hipDeviceAttributeTotalGlobalMem, std::min(prop.totalGlobalMem, int32_max));
+  Set(hipDeviceAttributeWarpSize, prop.warpSize);
+  Set(hipDeviceAttributeMaxRegistersPerBlock, prop.regsPerBlock);
+  Set(hipDeviceAttributeClockRate, prop.clockRate);
+  Set(hipDeviceAttributeWallClockRate, info.wallClockFrequency_);
+  Set(hipDeviceAttributeMemoryClockRate, prop.memoryClockRate);
+  Set(hipDeviceAttributeMemoryBusWidth, prop.memoryBusWidth);
+  Set(hipDeviceAttributeMultiprocessorCount, prop.multiProcessorCount);
+  Set(hipDeviceAttributeComputeMode, prop.computeMode);
+  Set(hipDeviceAttributeComputePreemptionSupported, prop.computePreemptionSupported);
+  Set(hipDeviceAttributeL2CacheSize, prop.l2CacheSize);
+  Set(hipDeviceAttributeLocalL1CacheSupported, prop.localL1CacheSupported);
+  Set(hipDeviceAttributeLuidDeviceNodeMask, prop.luidDeviceNodeMask);
+  Set(hipDeviceAttributeMaxThreadsPerMultiProcessor, prop.maxThreadsPerMultiProcessor);
+  Set(hipDeviceAttributeComputeCapabilityMajor, prop.major);
+  Set(hipDeviceAttributeComputeCapabilityMinor, prop.minor);
+  Set(hipDeviceAttributeMultiGpuBoardGroupID, prop.multiGpuBoardGroupID);
+  Set(hipDeviceAttributePciBusId, prop.pciBusID);
+  Set(hipDeviceAttributeConcurrentKernels, prop.concurrentKernels);
+  Set(hipDeviceAttributePciDeviceId, prop.pciDeviceID);
+  Set(hipDeviceAttributePciDomainID, prop.pciDomainID);
+  Set(hipDeviceAttributePersistingL2CacheMaxSize, prop.persistingL2CacheMaxSize);
+  Set(hipDeviceAttributeMaxRegistersPerMultiprocessor, prop.regsPerMultiprocessor);
+  Set(hipDeviceAttributeReservedSharedMemPerBlock, prop.reservedSharedMemPerBlock);
+  Set(hipDeviceAttributeMaxSharedMemoryPerMultiprocessor, prop.maxSharedMemoryPerMultiProcessor);
+  Set(hipDeviceAttributeIsMultiGpuBoard, prop.isMultiGpuBoard);
+  Set(hipDeviceAttributeCooperativeLaunch, prop.cooperativeLaunch);
+  // AMD GPUs allow you to register host memory regardless of the GPU
+  Set(hipDeviceAttributeHostRegisterSupported, 1);
+  Set(hipDeviceAttributeDeviceOverlap, prop.asyncEngineCount > 0 ? 1 : 0);
+  Set(hipDeviceAttributeCooperativeMultiDeviceLaunch, prop.cooperativeMultiDeviceLaunch);
+  Set(hipDeviceAttributeIntegrated, prop.integrated);
+  Set(hipDeviceAttributeMaxTexture1DWidth, prop.maxTexture1D);
+  Set(hipDeviceAttributeMaxTexture1DLinear, prop.maxTexture1DLinear);
+  Set(hipDeviceAttributeMaxTexture1DMipmap, prop.maxTexture1DMipmap);
+  Set(hipDeviceAttributeMaxTextureCubemap, prop.maxTextureCubemap);
+  Set(hipDeviceAttributeMaxTexture2DWidth, prop.maxTexture2D[0]);
+  Set(hipDeviceAttributeMaxTexture2DHeight, prop.maxTexture2D[1]);
+  Set(hipDeviceAttributeMaxTexture3DWidth, prop.maxTexture3D[0]);
+  Set(hipDeviceAttributeMaxTexture3DHeight, prop.maxTexture3D[1]);
+  Set(hipDeviceAttributeMaxTexture3DDepth, prop.maxTexture3D[2]);
+  SetPointer(hipDeviceAttributeHdpMemFlushCntl, prop.hdpMemFlushCntl);
+  SetPointer(hipDeviceAttributeHdpRegFlushCntl, prop.hdpRegFlushCntl);
+  // size_t to int casting
+  Set(hipDeviceAttributeMaxPitch, std::min(prop.memPitch, int32_max));
+  Set(hipDeviceAttributeTextureAlignment, prop.textureAlignment);
+  Set(hipDeviceAttributeTexturePitchAlignment, prop.texturePitchAlignment);
+  Set(hipDeviceAttributeKernelExecTimeout, prop.kernelExecTimeoutEnabled);
+  Set(hipDeviceAttributeCanMapHostMemory, prop.canMapHostMemory);
+  Set(hipDeviceAttributeCanUseHostPointerForRegisteredMem, prop.canUseHostPointerForRegisteredMem);
+  Set(hipDeviceAttributeEccEnabled, prop.ECCEnabled);
+  Set(hipDeviceAttributeCooperativeMultiDeviceUnmatchedFunc,
+      prop.cooperativeMultiDeviceUnmatchedFunc);
+  Set(hipDeviceAttributeCooperativeMultiDeviceUnmatchedGridDim,
+      prop.cooperativeMultiDeviceUnmatchedGridDim);
+  Set(hipDeviceAttributeCooperativeMultiDeviceUnmatchedBlockDim,
+      prop.cooperativeMultiDeviceUnmatchedBlockDim);
+  Set(hipDeviceAttributeCooperativeMultiDeviceUnmatchedSharedMem,
+      prop.cooperativeMultiDeviceUnmatchedSharedMem);
+  Set(hipDeviceAttributeAsicRevision, prop.asicRevision);
+  Set(hipDeviceAttributeManagedMemory, prop.managedMemory);
+  Set(hipDeviceAttributeMaxBlocksPerMultiProcessor, prop.maxBlocksPerMultiProcessor);
+  Set(hipDeviceAttributeDirectManagedMemAccessFromHost, prop.directManagedMemAccessFromHost);
+  Set(hipDeviceAttributeGlobalL1CacheSupported, prop.globalL1CacheSupported);
+  Set(hipDeviceAttributeHostNativeAtomicSupported, prop.hostNativeAtomicSupported);
+  Set(hipDeviceAttributeConcurrentManagedAccess, prop.concurrentManagedAccess);
+  Set(hipDeviceAttributePageableMemoryAccess, prop.pageableMemoryAccess);
+  Set(hipDeviceAttributePageableMemoryAccessUsesHostPageTables,
+      prop.pageableMemoryAccessUsesHostPageTables);
+  Set(hipDeviceAttributeIsLargeBar, prop.isLargeBar);
+  // HIP runtime always uses SVM for host memory allocations.
+  // Note: Host registered memory isn't covered by this feature
+  // and still requires hipMemHostGetDevicePointer() call
+  Set(hipDeviceAttributeUnifiedAddressing, true);
+  // hipStreamWaitValue64() and hipStreamWaitValue32() support
+  Set(hipDeviceAttributeCanUseStreamWaitValue, info.aqlBarrierValue_);
+  Set(hipDeviceAttributeImageSupport, static_cast<int>(info.imageSupport_));
+  Set(hipDeviceAttributePhysicalMultiProcessorCount, info.maxPhysicalComputeUnits_);
+  Set(hipDeviceAttributeFineGrainSupport, static_cast<int>(fineGrainSupported));
+  Set(hipDeviceAttributeMemoryPoolsSupported, HIP_MEM_POOL_SUPPORT);
+  Set(hipDeviceAttributeMemoryPoolSupportedHandleTypes, prop.memoryPoolSupportedHandleTypes);
+  Set(hipDeviceAttributeVirtualMemoryManagementSupported,
+      static_cast<int>(info.virtualMemoryManagement_));
+  Set(hipDeviceAttributeAccessPolicyMaxWindowSize, prop.accessPolicyMaxWindowSize);
+}
+
+}  // namespace hip
@@ -0,0 +1,64 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <hip/hip_runtime_api.h>
+#include "device/device.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace hip {
+
+/// Device attributes, built once at device creation and indexed by hipDeviceAttribute_t
+class DeviceAttributes {
+ public:
+  /// Fills the table from the cached properties and the ROCclr device info
+  void Build(const hipDeviceProp_tR0600& prop, const amd::device::Info& info,
+             bool fineGrainSupported);
+
+  /// Returns false if the attribute is unknown
+  bool Get(hipDeviceAttribute_t attr, int* pi) const;
+
+ private:
+  struct Value {
+    bool valid_ = false;    //!< The attribute is reported by the device
+    bool pointer_ = false;  //!< The attribute returns a pointer instead of an int
+    intptr_t value_ = 0;
+  };
+  //! CUDA compatible and AMD specific attributes, the index is the offset in the range
+  std::vector<Value> ranges_[2];
+
+  Value* Slot(hipDeviceAttribute_t attr);
+  void Set(hipDeviceAttribute_t attr, int value) {
+    Value* slot = Slot(attr);
+    slot->valid_ = true;
+    slot->value_ = value;
+  }
+  void SetPointer(hipDeviceAttribute_t attr, unsigned int* value) {
+    Value* slot = Slot(attr);
+    slot->valid_ = true;
+    slot->pointer_ = true;
+    slot->value_ = reinterpret_cast<intptr_t>(value);
+  }
+};
+
+}  // namespace hip
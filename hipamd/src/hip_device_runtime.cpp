@@ -157,6 +157,7 @@ hipError_t hipChooseDeviceR0000(int* device, const hipDeviceProp_tR0000* propert
   HIP_RETURN(ihipChooseDevice(device, properties));
 }
 
+// ================================================================================================
 hipError_t hipDeviceGetAttribute(int* pi, hipDeviceAttribute_t attr, int device) {
   HIP_INIT_API(hipDeviceGetAttribute, pi, attr, device);
 
@@ -171,282 +172,8 @@ hipError_t hipDeviceGetAttribute(int* pi, hipDeviceAttribute_t attr, int device)
     HIP_RETURN(hipErrorInvalidDevice);
   }
 
-  // FIXME: should we cache the props, or just select from deviceHandle->info_?
-  hipDeviceProp_tR0600 prop = {0};
-  HIP_RETURN_ONFAIL(ihipGetDeviceProperties(&prop, device));
-
-  constexpr auto int32_max = static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
-
-  switch (attr) {
-    case hipDeviceAttributeMaxThreadsPerBlock:
-      *pi = prop.maxThreadsPerBlock;
-      break;
-    case hipDeviceAttributeAsyncEngineCount:
-      *pi = prop.asyncEngineCount;
-      break;
-    case hipDeviceAttributeMaxBlockDimX:
-      *pi = prop.maxThreadsDim[0];
-      break;
-    case hipDeviceAttributeMaxBlockDimY:
-      *pi = prop.maxThreadsDim[1];
-      break;
-    case hipDeviceAttributeMaxBlockDimZ:
-      *pi = prop.maxThreadsDim[2];
-      break;
-    case hipDeviceAttributeMaxGridDimX:
-      *pi = prop.maxGridSize[0];
-      break;
-    case hipDeviceAttributeMaxGridDimY:
-      *pi = prop.maxGridSize[1];
-      break;
-    case hipDeviceAttributeMaxGridDimZ:
-      *pi = prop.maxGridSize[2];
-      break;
-    case hipDeviceAttributeMaxSurface1D:
-      *pi = prop.maxSurface1D;
-      break;
-    case hipDeviceAttributeMaxSharedMemoryPerBlock:
-      *pi = prop.sharedMemPerBlock;
-      break;
-    case hipDeviceAttributeSharedMemPerBlockOptin:
-      *pi = prop.sharedMemPerBlockOptin;
-      break;
-    case hipDeviceAttributeSharedMemPerMultiprocessor:
-      *pi = prop.sharedMemPerMultiprocessor;
-      break;
-    case hipDeviceAttributeStreamPrioritiesSupported:
-      *pi = prop.streamPrioritiesSupported;
-      break;
-    case hipDeviceAttributeSurfaceAlignment:
-      *pi = prop.surfaceAlignment;
-      break;
-    case hipDeviceAttributeTotalConstantMemory:
-      // size_t to int casting
-      *pi = std::min(prop.totalConstMem, int32_max);
-      break;
-    case hipDeviceAttributeTotalGlobalMem:
-      *pi = std::min(prop.totalGlobalMem, int32_max);
-      break;
-    case hipDeviceAttributeWarpSize:
-      *pi = prop.warpSize;
-      break;
-    case hipDeviceAttributeMaxRegistersPerBlock:
-      *pi = prop.regsPerBlock;
-      break;
-    case hipDeviceAttributeClockRate:
-      *pi = prop.clockRate;
-      break;
-    case hipDeviceAttributeWallClockRate:
-      *pi = g_devices[device]->devices()[0]->info().wallClockFrequency_;
-      break;
-    case hipDeviceAttributeMemoryClockRate:
-      *pi = prop.memoryClockRate;
-      break;
-    case hipDeviceAttributeMemoryBusWidth:
-      *pi = prop.memoryBusWidth;
-      break;
-    case hipDeviceAttributeMultiprocessorCount:
-      *pi = prop.multiProcessorCount;
-      break;
-    case hipDeviceAttributeComputeMode:
-      *pi = prop.computeMode;
-      break;
-    case hipDeviceAttributeComputePreemptionSupported:
-      *pi = prop.computePreemptionSupported;
-      break;
-    case hipDeviceAttributeL2CacheSize:
-      *pi = prop.l2CacheSize;
-      break;
-    case hipDeviceAttributeLocalL1CacheSupported:
-      *pi = prop.localL1CacheSupported;
-      break;
-    case hipDeviceAttributeLuidDeviceNodeMask:
-      *pi = prop.luidDeviceNodeMask;
-      break;
-    case hipDeviceAttributeMaxThreadsPerMultiProcessor:
-      *pi = prop.maxThreadsPerMultiProcessor;
-      break;
-    case hipDeviceAttributeComputeCapabilityMajor:
-      *pi = prop.major;
-      break;
-    case hipDeviceAttributeComputeCapabilityMinor:
-      *pi = prop.minor;
-      break;
-    case hipDeviceAttributeMultiGpuBoardGroupID:
-      *pi = prop.multiGpuBoardGroupID;
-      break;
-    case hipDeviceAttributePciBusId:
-      *pi = prop.pciBusID;
-      break;
-    case hipDeviceAttributeConcurrentKernels:
-      *pi = prop.concurrentKernels;
-      break;
-    case hipDeviceAttributePciDeviceId:
-      *pi = prop.pciDeviceID;
-      break;
-    case hipDeviceAttributePciDomainID:
-      *pi = prop.pciDomainID;
-      break;
-    case hipDeviceAttributePersistingL2CacheMaxSize:
-      *pi = prop.persistingL2CacheMaxSize;
-      break;
-    case hipDeviceAttributeMaxRegistersPerMultiprocessor:
-      *pi = prop.regsPerMultiprocessor;
-      break;
-    case hipDeviceAttributeReservedSharedMemPerBlock:
-      *pi = prop.reservedSharedMemPerBlock;
-      break;
-    case hipDeviceAttributeMaxSharedMemoryPerMultiprocessor:
-      *pi = prop.maxSharedMemoryPerMultiProcessor;
-      break;
-    case hipDeviceAttributeIsMultiGpuBoard:
-      *pi = prop.isMultiGpuBoard;
-      break;
-    case hipDeviceAttributeCooperativeLaunch:
-      *pi = prop.cooperativeLaunch;
-      break;
-    case hipDeviceAttributeHostRegisterSupported:
-      *pi = 1;  // AMD GPUs allow you to register host memory regardless of the GPU
-      break;
-    case hipDeviceAttributeDeviceOverlap:
-      *pi = prop.asyncEngineCount > 0 ? 1 : 0;
-      break;
-    case hipDeviceAttributeCooperativeMultiDeviceLaunch:
-      *pi = prop.cooperativeMultiDeviceLaunch;
-      break;
-    case hipDeviceAttributeIntegrated:
-      *pi = prop.integrated;
-      break;
-    case hipDeviceAttributeMaxTexture1DWidth:
-      *pi = prop.maxTexture1D;
-      break;
-    case hipDeviceAttributeMaxTexture1DLinear:
-      *pi = prop.maxTexture1DLinear;
-      break;
-    case hipDeviceAttributeMaxTexture1DMipmap:
-      *pi = prop.maxTexture1DMipmap;
-      break;
-    case hipDeviceAttributeMaxTextureCubemap:
-      *pi = prop.maxTextureCubemap;
-      break;
-    case hipDeviceAttributeMaxTexture2DWidth:
-      *pi = prop.maxTexture2D[0];
-      break;
-    case hipDeviceAttributeMaxTexture2DHeight:
-      *pi = prop.maxTexture2D[1];
-      break;
-    case hipDeviceAttributeMaxTexture3DWidth:
-      *pi = prop.maxTexture3D[0];
-      break;
-    case hipDeviceAttributeMaxTexture3DHeight:
-      *pi = prop.maxTexture3D[1];
-      break;
-    case hipDeviceAttributeMaxTexture3DDepth:
-      *pi = prop.maxTexture3D[2];
-      break;
-    case hipDeviceAttributeHdpMemFlushCntl:
-      *reinterpret_cast<unsigned int**>(pi) = prop.hdpMemFlushCntl;
-      break;
-    case hipDeviceAttributeHdpRegFlushCntl:
-      *reinterpret_cast<unsigned int**>(pi) = prop.hdpRegFlushCntl;
-      break;
-    case hipDeviceAttributeMaxPitch:
-      // size_t to int casting
-      *pi = std::min(prop.memPitch, int32_max);
-      break;
-    case hipDeviceAttributeTextureAlignment:
-      *pi = prop.textureAlignment;
-      break;
-    case hipDeviceAttributeTexturePitchAlignment:
-      *pi = prop.texturePitchAlignment;
-      break;
-    case hipDeviceAttributeKernelExecTimeout:
-      *pi = prop.kernelExecTimeoutEnabled;
-      break;
-    case hipDeviceAttributeCanMapHostMemory:
-      *pi = prop.canMapHostMemory;
-      break;
-    case hipDeviceAttributeCanUseHostPointerForRegisteredMem:
-      *pi = prop.canUseHostPointerForRegisteredMem;
-      break;
-    case hipDeviceAttributeEccEnabled:
-      *pi = prop.ECCEnabled;
-      break;
-    case hipDeviceAttributeCooperativeMultiDeviceUnmatchedFunc:
-      *pi = prop.cooperativeMultiDeviceUnmatchedFunc;
-      break;
-    case hipDeviceAttributeCooperativeMultiDeviceUnmatchedGridDim:
-      *pi = prop.cooperativeMultiDeviceUnmatchedGridDim;
-      break;
-    case hipDeviceAttributeCooperativeMultiDeviceUnmatchedBlockDim:
-      *pi = prop.cooperativeMultiDeviceUnmatchedBlockDim;
-      break;
-    case hipDeviceAttributeCooperativeMultiDeviceUnmatchedSharedMem:
-      *pi = prop.cooperativeMultiDeviceUnmatchedSharedMem;
-      break;
-    case hipDeviceAttributeAsicRevision:
-      *pi = prop.asicRevision;
-      break;
-    case hipDeviceAttributeManagedMemory:
-      *pi = prop.managedMemory;
-      break;
-    case hipDeviceAttributeMaxBlocksPerMultiProcessor:
-      *pi = prop.maxBlocksPerMultiProcessor;
-      break;
-    case hipDeviceAttributeDirectManagedMemAccessFromHost:
-      *pi = prop.directManagedMemAccessFromHost;
-      break;
-    case hipDeviceAttributeGlobalL1CacheSupported:
-      *pi = prop.globalL1CacheSupported;
-      break;
-    case hipDeviceAttributeHostNativeAtomicSupported:
-      *pi = prop.hostNativeAtomicSupported;
-      break;
-    case hipDeviceAttributeConcurrentManagedAccess:
-      *pi = prop.concurrentManagedAccess;
-      break;
-    case hipDeviceAttributePageableMemoryAccess:
-      *pi = prop.pageableMemoryAccess;
-      break;
-    case hipDeviceAttributePageableMemoryAccessUsesHostPageTables:
-      *pi = prop.pageableMemoryAccessUsesHostPageTables;
-      break;
-    case hipDeviceAttributeIsLargeBar:
-      *pi = prop.isLargeBar;
-      break;
-    case hipDeviceAttributeUnifiedAddressing:
-      // HIP runtime always uses SVM for host memory allocations.
-      // Note: Host registered memory isn't covered by this feature
-      // and still requires hipMemHostGetDevicePointer() call
-      *pi = true;
-      break;
-    case hipDeviceAttributeCanUseStreamWaitValue:
-      // hipStreamWaitValue64() and hipStreamWaitValue32() support
-      *pi = g_devices[device]->devices()[0]->info().aqlBarrierValue_;
-      break;
-    case hipDeviceAttributeImageSupport:
-      *pi = static_cast<int>(g_devices[device]->devices()[0]->info().imageSupport_);
-      break;
-    case hipDeviceAttributePhysicalMultiProcessorCount:
-      *pi = g_devices[device]->devices()[0]->info().maxPhysicalComputeUnits_;
-      break;
-    case hipDeviceAttributeFineGrainSupport:
-      *pi = static_cast<int>(g_devices[device]->devices()[0]->isFineGrainSupported());
-      break;
-    case hipDeviceAttributeMemoryPoolsSupported:
-      *pi = HIP_MEM_POOL_SUPPORT;
-      break;
-    case hipDeviceAttributeMemoryPoolSupportedHandleTypes:
-      *pi = prop.memoryPoolSupportedHandleTypes;
-      break;
-    case hipDeviceAttributeVirtualMemoryManagementSupported:
-      *pi = static_cast<int>(g_devices[device]->devices()[0]->info().virtualMemoryManagement_);
-      break;
-    case hipDeviceAttributeAccessPolicyMaxWindowSize:
-      *pi = prop.accessPolicyMaxWindowSize;
-       break;
-    default:
-      HIP_RETURN(hipErrorInvalidValue);
+  if (!g_devices[device]->GetAttribute(attr, pi)) {
+    HIP_RETURN(hipErrorInvalidValue);
   }
 
   HIP_RETURN(hipSuccess);
@@ -640,6 +367,15 @@ hipError_t hipDeviceSynchronize() {
   HIP_RETURN(hipSuccess);
 }
 
+hipError_t hipExtDumpLockProfile() {
+  HIP_INIT_API(hipExtDumpLockProfile);
+  if (!DEBUG_CLR_MONITOR_PROFILE) {
+    HIP_RETURN(hipErrorNotSupported);
+  }
+  amd::profile_monitor::Monitor::dump(stderr);
+  HIP_RETURN(hipSuccess);
+}
+
 int ihipGetDevice() {
   hip::Device* device = hip::getCurrentDevice();
   if (device == nullptr) {
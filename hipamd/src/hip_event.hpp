@@ -69,6 +69,8 @@ void CL_CALLBACK ihipStreamCallback(cl_event event, cl_int command_exec_status,
 
 
 #define IPC_SIGNALS_PER_EVENT 32
+//! The shared segment of an IPC event. The futex fields at the end changed its layout,
+//! hence the processes sharing an event must run runtimes with the same layout
 typedef struct ihipIpcEventShmem_s {
   std::atomic<int> owners;
   std::atomic<int> owners_device_id;
@@ -76,8 +78,40 @@ typedef struct ihipIpcEventShmem_s {
   std::atomic<int> read_index;
   std::atomic<int> write_index;
   uint32_t signal[IPC_SIGNALS_PER_EVENT];
+  std::atomic<uint32_t> futex_word;     //!< Bumped on every state change, waiters sleep on it
+  std::atomic<uint32_t> futex_waiters;  //!< Number of threads sleeping on futex_word
 } ihipIpcEventShmem_t;
 
+//! Timeout for a single futex sleep, bounds the delay if a wake is ever missed. A missed
+//! wake costs up to 10ms, where the former 1ms polling noticed the change sooner
+constexpr uint64_t kIpcEventWaitTimeoutNs = 10 * 1000 * 1000;
+
+//! Posts a wake to all the processes waiting on the IPC event shared memory
+void IpcEventShmemWake(ihipIpcEventShmem_t* shmem);
+
+//! Blocks until done() returns true. Sleeps on the shared futex word between the checks
+//! and falls back to polling if the OS can't wait on a shared address
+template <typename F>
+void IpcEventShmemWait(ihipIpcEventShmem_t* shmem, F done) {
+  while (true) {
+    // Sample the word before the check, so a state change after it fails the futex wait
+    uint32_t word = shmem->futex_word.load();
+    if (done()) {
+      break;
+    }
+    bool slept = false;
+    if (DEBUG_HIP_IPC_EVENT_FUTEX) {
+      shmem->futex_waiters++;
+      slept = amd::Os::waitOnAddress(reinterpret_cast<volatile uint32_t*>(&shmem->futex_word),
+                                     word, kIpcEventWaitTimeoutNs);
+      shmem->futex_waiters--;
+    }
+    if (!slept) {
+      amd::Os::sleep(1);
+    }
+  }
+}
+
 class EventMarker : public amd::Marker {
  public:
   EventMarker(amd::HostQueue& stream, bool disableFlush, bool markerTs = false,
@@ -200,6 +234,11 @@ class IPCEvent : public Event {
     void setipcname(const char* name) { ipc_name_ = std::string(name); }
   };
   ihipIpcEvent_t ipc_evt_;
+  std::atomic<uint32_t> pending_wakes_ = 0;  //!< Wake callbacks, which still access ipc_shmem_
+
+  static void CL_CALLBACK WakeCallback(cl_event event, cl_int command_exec_status,
+                                      void* user_data);
+  hipError_t enqueueWakeCommand(hipStream_t stream);
 
  public:
   ~IPCEvent() {
@@ -207,6 +246,9 @@ class IPCEvent : public Event {
       int owners = --ipc_evt_.ipc_shmem_->owners;
       // Make sure event is synchronized
       hipError_t status = synchronize();
+      while (pending_wakes_ != 0) {
+        amd::Os::yield();
+      }
       status  = ihipHostUnregister(&ipc_evt_.ipc_shmem_->signal);
       if (!amd::Os::MemoryUnmapFile(ipc_evt_.ipc_shmem_, sizeof(hip::ihipIpcEventShmem_t))) {
         // print hipErrorInvalidHandle;
@@ -32,6 +32,41 @@ namespace hip {
 
 hipError_t ihipEventCreateWithFlags(hipEvent_t* event, unsigned flags);
 
+void IpcEventShmemWake(ihipIpcEventShmem_t* shmem) {
+  shmem->futex_word++;
+  // Skip the syscall if nobody sleeps. A waiter, registered after the check, will see
+  // the new futex_word value and won't sleep
+  if (shmem->futex_waiters != 0) {
+    amd::Os::wakeOnAddress(reinterpret_cast<volatile uint32_t*>(&shmem->futex_word));
+  }
+}
+
+void CL_CALLBACK IPCEvent::WakeCallback(cl_event event, cl_int command_exec_status,
+                                        void* user_data) {
+  IPCEvent* ipc_event = reinterpret_cast<IPCEvent*>(user_data);
+  IpcEventShmemWake(ipc_event->ipc_evt_.ipc_shmem_);
+  ipc_event->pending_wakes_--;
+}
+
+hipError_t IPCEvent::enqueueWakeCommand(hipStream_t stream) {
+  // The device clears the signal slot, hence the host wake has to come from a marker,
+  // which completes after the stream write
+  amd::Command* command = new amd::Marker(*hip::getStream(stream), !kMarkerDisableFlush);
+  if (command == nullptr) {
+    return hipErrorOutOfMemory;
+  }
+  pending_wakes_++;
+  if (!command->setCallback(CL_COMPLETE, WakeCallback, this)) {
+    pending_wakes_--;
+    command->release();
+    return hipErrorInvalidHandle;
+  }
+  command->enqueue();
+  command->notifyCmdQueue();
+  command->release();
+  return hipSuccess;
+}
+
 bool IPCEvent::createIpcEventShmemIfNeeded() {
   if (ipc_evt_.ipc_shmem_) {
     // ipc_shmem_ already created, no need to create it again
@@ -61,6 +96,8 @@ bool IPCEvent::createIpcEventShmemIfNeeded() {
   ipc_evt_.ipc_shmem_->owners = 1;
   ipc_evt_.ipc_shmem_->read_index = -1;
   ipc_evt_.ipc_shmem_->write_index = 0;
+  ipc_evt_.ipc_shmem_->futex_word = 0;
+  ipc_evt_.ipc_shmem_->futex_waiters = 0;
   for (uint32_t sig_idx = 0; sig_idx < IPC_SIGNALS_PER_EVENT; ++sig_idx) {
     ipc_evt_.ipc_shmem_->signal[sig_idx] = 0;
   }
@@ -92,10 +129,11 @@ hipError_t IPCEvent::synchronize() {
     int prev_read_idx = ipc_evt_.ipc_shmem_->read_index;
     if (prev_read_idx >= 0) {
       int offset = (prev_read_idx % IPC_SIGNALS_PER_EVENT);
-      while ((ipc_evt_.ipc_shmem_->read_index < prev_read_idx + IPC_SIGNALS_PER_EVENT) &&
-             (ipc_evt_.ipc_shmem_->signal[offset] != 0)) {
-        amd::Os::sleep(1);
-      }
+      auto shmem = ipc_evt_.ipc_shmem_;
+      IpcEventShmemWait(shmem, [shmem, prev_read_idx, offset]() {
+        return (shmem->read_index >= prev_read_idx + IPC_SIGNALS_PER_EVENT) ||
+               (shmem->signal[offset] == 0);
+      });
     }
   }
   return hipSuccess;
@@ -156,9 +194,8 @@ hipError_t IPCEvent::enqueueRecordCommand(hipStream_t stream, amd::Command* comm
     createIpcEventShmemIfNeeded();
     int write_index = ipc_evt_.ipc_shmem_->write_index++;
     int offset = write_index % IPC_SIGNALS_PER_EVENT;
-    while (ipc_evt_.ipc_shmem_->signal[offset] != 0) {
-      amd::Os::sleep(1);
-    }
+    auto shmem = ipc_evt_.ipc_shmem_;
+    IpcEventShmemWait(shmem, [shmem, offset]() { return shmem->signal[offset] == 0; });
     // Lock signal.
     ipc_evt_.ipc_shmem_->signal[offset] = 1;
     ipc_evt_.ipc_shmem_->owners_device_id = deviceId();
@@ -173,12 +210,20 @@ hipError_t IPCEvent::enqueueRecordCommand(hipStream_t stream, amd::Command* comm
     if (status != hipSuccess) {
       return status;
     }
+    if (DEBUG_HIP_IPC_EVENT_FUTEX) {
+      // The slot is taken already, so the read index must be published regardless. Without
+      // the wake the waiters notice the completion on their futex timeout only
+      if (enqueueWakeCommand(stream) != hipSuccess) {
+        LogWarning("IPC event wake marker failed, waiters fall back to timed polling");
+      }
+    }
 
     // Update read index to indicate new signal.
-    int expected = write_index - 1;
-    while (!ipc_evt_.ipc_shmem_->read_index.compare_exchange_weak(expected, write_index)) {
-      amd::Os::sleep(1);
-    }
+    IpcEventShmemWait(shmem, [shmem, write_index]() {
+      int expected = write_index - 1;
+      return shmem->read_index.compare_exchange_strong(expected, write_index);
+    });
+    IpcEventShmemWake(shmem);
   } else {
     return Event::enqueueRecordCommand(stream, command, record);
   }
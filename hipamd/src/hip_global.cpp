@@ -123,6 +123,23 @@ DeviceFunc::~DeviceFunc() {
   }
 }
 
+bool DeviceFunc::getOccupancyLimits(const amd::Device& device, OccupancyLimits* limits) {
+  amd::ScopedLock lock(dflock_);
+  for (const auto& it : occupancy_) {
+    if (it.first == &device) {
+      *limits = it.second;
+      return true;
+    }
+  }
+  const device::Kernel::WorkGroupInfo* wrkGrpInfo = kernel_->getDeviceKernel(device)->workGroupInfo();
+  if (!ComputeOccupancyLimits(limits, *wrkGrpInfo, device.info(), device.isa().versionMajor(),
+                              device.settings().enableWgpMode_)) {
+    return false;
+  }
+  occupancy_.emplace_back(&device, *limits);
+  return true;
+}
+
 //Abstract functions
 Function::Function(const std::string& name, FatBinaryInfo** modules)
                    : name_(name), modules_(modules) {
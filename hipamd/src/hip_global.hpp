@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "hip/hip_runtime.h"
 #include "hip_internal.hpp"
 #include "hip_fatbin.hpp"
+#include "hip_occupancy.hpp"
 #include "platform/program.hpp"
 
 namespace hip {
@@ -71,9 +72,13 @@ public:
   std::string name() const { return name_; }
   amd::Kernel* kernel() const { return kernel_; }
 
+  //Returns the occupancy limits on the device. They are computed on the first request only.
+  bool getOccupancyLimits(const amd::Device& device, OccupancyLimits* limits);
+
 private:
   std::string name_;        //name of the func(not unique identifier)
   amd::Kernel* kernel_;     //Kernel ptr referencing to ROCclr Symbol
+  std::vector<std::pair<const amd::Device*, OccupancyLimits>> occupancy_;  //Limits per device
 };
 
 //Abstract Structures
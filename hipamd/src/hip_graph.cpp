@@ -793,6 +793,35 @@ hipError_t capturehipLaunchHostFunc(hipStream_t& stream, hipHostFn_t& fn, void*&
   return hipSuccess;
 }
 
+// ================================================================================================
+hipError_t capturehipStreamBatchMemOp(hipStream_t& stream, unsigned int& count,
+                                      hipStreamBatchMemOpParams*& paramArray,
+                                      unsigned int& flags) {
+  ClPrint(amd::LOG_INFO, amd::LOG_API, "[hipGraph] Current capture node batch mem op on stream : %p",
+          stream);
+  if (!hip::isValid(stream)) {
+    return hipErrorContextIsDestroyed;
+  }
+  std::vector<amd::BatchStreamOperationCommand::Operation> ops;
+  hipError_t status = ihipBatchMemOpOperations(count, paramArray, flags, &ops);
+  if (status != hipSuccess) {
+    return status;
+  }
+  hipBatchMemOpNodeParams nodeParams = {};
+  nodeParams.count = count;
+  nodeParams.paramArray = paramArray;
+  nodeParams.flags = flags;
+  hip::Stream* s = reinterpret_cast<hip::Stream*>(stream);
+  hip::GraphNode* pGraphNode = new hip::GraphBatchMemOpNode(&nodeParams);
+  status = ihipGraphAddNode(pGraphNode, s->GetCaptureGraph(), s->GetLastCapturedNodes().data(),
+                            s->GetLastCapturedNodes().size());
+  if (status != hipSuccess) {
+    return status;
+  }
+  s->SetLastCapturedNode(pGraphNode);
+  return hipSuccess;
+}
+
 // ================================================================================================
 hipError_t capturehipMallocAsync(hipStream_t stream, hipMemPool_t mem_pool,
                                  size_t size, void** dev_ptr) {
@@ -1289,7 +1318,7 @@ hipError_t hipGraphAddChildGraphNode(hipGraphNode_t* pGraphNode, hipGraph_t grap
 }
 
 hipError_t ihipGraphInstantiate(hip::GraphExec** pGraphExec, hip::Graph* graph,
-                                uint64_t flags = 0) {
+                                uint64_t flags = 0, bool dedicatedQueues = false) {
   if (pGraphExec == nullptr || graph == nullptr) {
     return hipErrorInvalidValue;
   }
@@ -1319,7 +1348,7 @@ hipError_t ihipGraphInstantiate(hip::GraphExec** pGraphExec, hip::Graph* graph,
   }
   *pGraphExec =
       new hip::GraphExec(graphNodes, parallelLists, nodeWaitLists, clonedGraph, clonedNodes,
-                         flags);
+                         flags, dedicatedQueues);
   if (*pGraphExec != nullptr) {
     graph->SetGraphInstantiated(true);
     if (DEBUG_HIP_GRAPH_DOT_PRINT) {
@@ -3149,6 +3178,142 @@ hipError_t hipGraphExecExternalSemaphoresWaitNodeSetParams(hipGraphExec_t hGraph
       nodeParams));
 }
 
+hipError_t hipGraphAddBatchMemOpNode(hipGraphNode_t* phGraphNode, hipGraph_t hGraph,
+                                     const hipGraphNode_t* dependencies, size_t numDependencies,
+                                     const hipBatchMemOpNodeParams* nodeParams) {
+  HIP_INIT_API(hipGraphAddBatchMemOpNode, phGraphNode, hGraph, dependencies, numDependencies,
+               nodeParams);
+  if (phGraphNode == nullptr || hGraph == nullptr ||
+      (numDependencies > 0 && dependencies == nullptr) || nodeParams == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  std::vector<amd::BatchStreamOperationCommand::Operation> ops;
+  hipError_t status = ihipBatchMemOpOperations(nodeParams->count, nodeParams->paramArray,
+                                               nodeParams->flags, &ops);
+  if (status != hipSuccess) {
+    HIP_RETURN(status);
+  }
+  hip::GraphNode* node = new hip::GraphBatchMemOpNode(nodeParams);
+  status = ihipGraphAddNode(node, reinterpret_cast<hip::Graph*>(hGraph),
+                            reinterpret_cast<hip::GraphNode* const*>(dependencies),
+                            numDependencies);
+  *phGraphNode = reinterpret_cast<hipGraphNode_t>(node);
+  HIP_RETURN(status);
+}
+
+hipError_t hipGraphBatchMemOpNodeGetParams(hipGraphNode_t hNode,
+                                           hipBatchMemOpNodeParams* nodeParams_out) {
+  HIP_INIT_API(hipGraphBatchMemOpNodeGetParams, hNode, nodeParams_out);
+  hip::GraphNode* n = reinterpret_cast<hip::GraphNode*>(hNode);
+  if (!hip::GraphNode::isNodeValid(n) || nodeParams_out == nullptr ||
+      n->GetType() != hipGraphNodeTypeExtBatchMemOp) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  reinterpret_cast<hip::GraphBatchMemOpNode*>(n)->GetParams(nodeParams_out);
+  HIP_RETURN(hipSuccess);
+}
+
+hipError_t hipGraphBatchMemOpNodeSetParams(hipGraphNode_t hNode,
+                                           hipBatchMemOpNodeParams* nodeParams) {
+  HIP_INIT_API(hipGraphBatchMemOpNodeSetParams, hNode, nodeParams);
+  hip::GraphNode* n = reinterpret_cast<hip::GraphNode*>(hNode);
+  if (!hip::GraphNode::isNodeValid(n) || nodeParams == nullptr ||
+      n->GetType() != hipGraphNodeTypeExtBatchMemOp) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  HIP_RETURN(reinterpret_cast<hip::GraphBatchMemOpNode*>(n)->SetParams(nodeParams));
+}
+
+hipError_t hipGraphExecBatchMemOpNodeSetParams(hipGraphExec_t hGraphExec, hipGraphNode_t hNode,
+                                               const hipBatchMemOpNodeParams* nodeParams) {
+  HIP_INIT_API(hipGraphExecBatchMemOpNodeSetParams, hGraphExec, hNode, nodeParams);
+  hip::GraphNode* n = reinterpret_cast<hip::GraphNode*>(hNode);
+  hip::GraphExec* graphExec = reinterpret_cast<hip::GraphExec*>(hGraphExec);
+  if (hGraphExec == nullptr || hNode == nullptr || !hip::GraphExec::isGraphExecValid(graphExec) ||
+      !hip::GraphNode::isNodeValid(n) || nodeParams == nullptr ||
+      n->GetType() != hipGraphNodeTypeExtBatchMemOp) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  hip::GraphNode* clonedNode = graphExec->GetClonedNode(n);
+  if (clonedNode == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  HIP_RETURN(reinterpret_cast<hip::GraphBatchMemOpNode*>(clonedNode)->SetParams(nodeParams));
+}
+
+hipError_t hipGraphConditionalHandleCreate(hipGraphConditionalHandle* pHandle_out,
+                                           hipGraph_t graph, unsigned int defaultLaunchValue,
+                                           unsigned int flags) {
+  HIP_INIT_API(hipGraphConditionalHandleCreate, pHandle_out, graph, defaultLaunchValue, flags);
+  hip::Graph* g = reinterpret_cast<hip::Graph*>(graph);
+  if (pHandle_out == nullptr || !hip::Graph::isGraphValid(g) ||
+      (flags & ~hipGraphCondAssignDefault) != 0) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  hip::ConditionalHandle* handle =
+      new hip::ConditionalHandle(defaultLaunchValue, (flags & hipGraphCondAssignDefault) != 0);
+  if (handle == nullptr || !handle->Create()) {
+    if (handle != nullptr) {
+      handle->release();
+    }
+    HIP_RETURN(hipErrorOutOfMemory);
+  }
+  g->AddConditionalHandle(handle);
+  *pHandle_out = handle->GetHandle();
+  HIP_RETURN(hipSuccess);
+}
+
+hipError_t hipGraphAddConditionalNode(hipGraphNode_t* pGraphNode, hipGraph_t graph,
+                                      const hipGraphNode_t* pDependencies, size_t numDependencies,
+                                      hipConditionalNodeParams* nodeParams) {
+  HIP_INIT_API(hipGraphAddConditionalNode, pGraphNode, graph, pDependencies, numDependencies,
+               nodeParams);
+  hip::Graph* g = reinterpret_cast<hip::Graph*>(graph);
+  if (pGraphNode == nullptr || !hip::Graph::isGraphValid(g) ||
+      (numDependencies > 0 && pDependencies == nullptr) || nodeParams == nullptr ||
+      nodeParams->phGraph_out == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  // The condition must belong to the graph, which contains the node
+  hip::ConditionalHandle* handle = g->GetConditionalHandle(nodeParams->handle);
+  if (handle == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  amd::ConditionalType type;
+  switch (nodeParams->type) {
+    case hipGraphCondTypeIf:
+      type = amd::ConditionalType::If;
+      break;
+    case hipGraphCondTypeWhile:
+      type = amd::ConditionalType::While;
+      break;
+    case hipGraphCondTypeSwitch:
+      type = amd::ConditionalType::Switch;
+      break;
+    default:
+      HIP_RETURN(hipErrorInvalidValue);
+  }
+  if (!amd::ValidConditionalBodies(type, nodeParams->size)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  hip::GraphConditionalNode* node =
+      new hip::GraphConditionalNode(handle, type, nodeParams->size, hip::getCurrentDevice());
+  // A node added to a capture graph is tracked as a manual node, so the capture can continue
+  // from it after hipStreamUpdateCaptureDependencies
+  hipError_t status = ihipGraphAddNode(node, g,
+                                       reinterpret_cast<hip::GraphNode* const*>(pDependencies),
+                                       numDependencies, false);
+  if (status != hipSuccess) {
+    HIP_RETURN(status);
+  }
+  const std::vector<hip::Graph*>& bodies = node->GetBodies();
+  for (size_t i = 0; i < bodies.size(); ++i) {
+    nodeParams->phGraph_out[i] = reinterpret_cast<hipGraph_t>(bodies[i]);
+  }
+  *pGraphNode = reinterpret_cast<hipGraphNode_t>(node);
+  HIP_RETURN(hipSuccess);
+}
+
 hipError_t hipDrvGraphAddMemFreeNode(hipGraphNode_t* phGraphNode, hipGraph_t hGraph,
                                   const hipGraphNode_t* dependencies, size_t numDependencies,
                                   hipDeviceptr_t dptr) {
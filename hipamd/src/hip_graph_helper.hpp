@@ -29,13 +29,22 @@ hipError_t ihipDrvMemcpy3D_validate(const HIP_MEMCPY3D* pCopy);
 
 hipError_t ihipMemcpy_validate(void* dst, const void* src, size_t sizeBytes, hipMemcpyKind kind);
 
+hipError_t ihipMemcpy_validate(const ResolvedPtr& dst, const ResolvedPtr& src, size_t sizeBytes,
+                               hipMemcpyKind kind);
+
 hipError_t ihipMemcpyCommand(amd::Command*& command, void* dst, const void* src, size_t sizeBytes,
                              hipMemcpyKind kind, hip::Stream& stream, bool isAsync = false);
 
+hipError_t ihipMemcpyCommand(amd::Command*& command, const ResolvedPtr& dst,
+                             const ResolvedPtr& src, size_t sizeBytes, hipMemcpyKind kind,
+                             hip::Stream& stream, bool isAsync = false);
+
 void ihipHtoHMemcpy(void* dst, const void* src, size_t sizeBytes, hip::Stream& stream);
 
 bool IsHtoHMemcpy(void* dst, const void* src);
 
+bool IsHtoHMemcpy(const ResolvedPtr& dst, const ResolvedPtr& src);
+
 hipError_t ihipLaunchKernel_validate(hipFunction_t f, uint32_t globalWorkSizeX,
                                      uint32_t globalWorkSizeY, uint32_t globalWorkSizeZ,
                                      uint32_t blockDimX, uint32_t blockDimY, uint32_t blockDimZ,
@@ -44,6 +53,9 @@ hipError_t ihipLaunchKernel_validate(hipFunction_t f, uint32_t globalWorkSizeX,
 
 hipError_t ihipMemset_validate(void* dst, int64_t value, size_t valueSize, size_t sizeBytes);
 
+hipError_t ihipMemset_validate(const ResolvedPtr& dst, int64_t value, size_t valueSize,
+                               size_t sizeBytes);
+
 hipError_t ihipMemset3D_validate(hipPitchedPtr pitchedDevPtr, int value, hipExtent extent,
                                  size_t sizeBytes);
 
@@ -65,6 +77,10 @@ hipError_t ihipGetMemcpyParam3DCommand(amd::Command*& command, const HIP_MEMCPY3
 hipError_t ihipMemsetCommand(std::vector<amd::Command*>& commands, void* dst, int64_t value,
                              size_t valueSize, size_t sizeBytes, hip::Stream* stream);
 
+hipError_t ihipMemsetCommand(std::vector<amd::Command*>& commands, const ResolvedPtr& dst,
+                             int64_t value, size_t valueSize, size_t sizeBytes,
+                             hip::Stream* stream);
+
 hipError_t ihipMemset3DCommand(std::vector<amd::Command*>& commands, hipPitchedPtr pitchedDevPtr,
                                int value, hipExtent extent, hip::Stream* stream,
                                size_t elementSize = 1);
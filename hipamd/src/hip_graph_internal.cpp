@@ -21,6 +21,9 @@
 #include "hip_graph_internal.hpp"
 #include <queue>
 
+hipError_t ihipGraphInstantiate(hip::GraphExec** pGraphExec, hip::Graph* graph, uint64_t flags,
+                                bool dedicatedQueues);
+
 #define CASE_STRING(X, C)                                                                          \
   case X:                                                                                          \
     case_string = #C;                                                                              \
@@ -43,6 +46,8 @@ const char* GetGraphNodeTypeString(uint32_t op) {
     CASE_STRING(hipGraphNodeTypeMemFree, MemFreeNode)
     CASE_STRING(hipGraphNodeTypeMemcpyFromSymbol, MemcpyFromSymbolNode)
     CASE_STRING(hipGraphNodeTypeMemcpyToSymbol, MemcpyToSymbolNode)
+    CASE_STRING(hipGraphNodeTypeExtBatchMemOp, BatchMemOpNode)
+    CASE_STRING(hipGraphNodeTypeExtConditional, ConditionalNode)
     default:
       case_string = "Unknown node type";
   };
@@ -356,6 +361,10 @@ Graph* Graph::clone(std::unordered_map<Node, Node>& clonedNodes) const {
     userObj->retain();
     newGraph->graphUserObj_.insert(userObj);
   }
+  for (auto& it : conditionalHandles_) {
+    it.second->retain();
+    newGraph->conditionalHandles_.insert(it);
+  }
   // Clone the root nodes to the new graph
   if (roots_.size() > 0) {
     memcpy(&newGraph->roots_[0], &roots_[0], sizeof(Node) * roots_.size());
@@ -380,7 +389,8 @@ hipError_t GraphExec::CreateStreams(uint32_t num_streams) {
   parallel_streams_.reserve(num_streams);
   for (uint32_t i = 0; i < num_streams; ++i) {
     auto stream = new hip::Stream(hip::getCurrentDevice(),
-                                  hip::Stream::Priority::Normal, hipStreamNonBlocking);
+                                  hip::Stream::Priority::Normal, hipStreamNonBlocking, false, {},
+                                  hipStreamCaptureStatusNone, dedicatedQueues_);
     if (stream == nullptr || !stream->Create()) {
       if (stream != nullptr) {
         hip::Stream::Destroy(stream);
@@ -824,6 +834,12 @@ hipError_t GraphExec::Run(hipStream_t graph_launch_stream) {
     repeatLaunch_ = true;
   }
 
+  // The conditions must be reset before any node of the graph runs
+  status = clonedGraph_->ResetConditionalHandles(launch_stream);
+  if (status != hipSuccess) {
+    return status;
+  }
+
   if (parallelLists_.size() == 1 &&
       instantiateDeviceId_ == launch_stream->DeviceId()) {
     if (DEBUG_CLR_GRAPH_PACKET_CAPTURE) {
@@ -978,4 +994,270 @@ void GraphKernelArgManager::ReadBackOrFlush() {
     }
   }
 }
+
+// ================================================================================================
+hipError_t ConditionalHandle::EnqueueReset(hip::Stream* stream) const {
+  if (!assignDefault_) {
+    return hipSuccess;
+  }
+  size_t offset = 0;
+  amd::Memory* memory = getMemoryObject(value_, offset);
+  if (memory == nullptr) {
+    return hipErrorInvalidValue;
+  }
+  amd::Command::EventWaitList waitList;
+  amd::Command* command = new amd::StreamOperationCommand(
+      *stream, ROCCLR_COMMAND_STREAM_WRITE_VALUE, waitList, *memory->asBuffer(), defaultValue_, 0,
+      0, offset, sizeof(uint32_t));
+  if (command == nullptr) {
+    return hipErrorOutOfMemory;
+  }
+  command->enqueue();
+  command->release();
+  return hipSuccess;
+}
+
+// ================================================================================================
+void GraphConditionalNode::Launch::Complete(bool success) {
+  if (!success) {
+    ClPrint(amd::LOG_ERROR, amd::LOG_CODE, "[hipGraph] Conditional node %d failed to launch a body",
+            node_->GetID());
+  }
+  // Release the node stream, which waits on the gate. The node can be destroyed right after
+  // that, hence it's the last access
+  __atomic_store_n(node_->gate_, seq_, __ATOMIC_RELEASE);
+}
+
+// ================================================================================================
+GraphConditionalNode::~GraphConditionalNode() {
+  ReleaseBodyExecs();
+  for (auto bodyStream : bodyStreams_) {
+    if (bodyStream != nullptr) {
+      hip::Stream::Destroy(bodyStream);
+    }
+  }
+  if (gate_ != nullptr) {
+    ihipFree(gate_);
+  }
+  delete pendingLaunch_;
+  for (auto body : bodies_) {
+    delete body;
+  }
+  handle_->release();
+}
+
+// ================================================================================================
+void GraphConditionalNode::ReleaseBodyExecs() {
+  if (bodyExecs_.empty()) {
+    return;
+  }
+  for (auto bodyStream : bodyStreams_) {
+    if (bodyStream != nullptr) {
+      bodyStream->finish();
+    }
+  }
+  amd::ScopedLock lock(GraphExecStatusLock_);
+  for (auto exec : bodyExecs_) {
+    GraphExecStatus_.erase(exec);
+    exec->release();
+  }
+  bodyExecs_.clear();
+}
+
+// ================================================================================================
+hipError_t GraphConditionalNode::Prepare(hip::Stream* stream, hip::Stream** bodyStream) {
+  if (gate_ == nullptr) {
+    if (ihipHostMalloc(reinterpret_cast<void**>(&gate_), sizeof(uint64_t),
+                       hipExtHostAllocCoherent) != hipSuccess) {
+      gate_ = nullptr;
+      return hipErrorOutOfMemory;
+    }
+    *gate_ = 0;
+    launchSeq_ = 0;
+  }
+  if (worker_ == nullptr) {
+    worker_ = amd::ConditionalWorker::Instance();
+    if (worker_ == nullptr) {
+      ClPrint(amd::LOG_ERROR, amd::LOG_CODE, "[hipGraph] Failed to start conditional worker!");
+      return hipErrorOutOfMemory;
+    }
+  }
+  // The node stream blocks its hardware queue on the gate, so the bodies can't share it.
+  // The shared hardware queues are pooled, hence the bodies get a queue of their own
+  const hip::Stream::Priority priority = stream->GetPriority();
+  hip::Stream*& selected = bodyStreams_[priority - hip::Stream::Priority::High];
+  if (selected == nullptr) {
+    selected = new hip::Stream(stream->GetDevice(), priority, hipStreamNonBlocking, false, {},
+                               hipStreamCaptureStatusNone, true);
+    if (selected == nullptr || !selected->Create()) {
+      if (selected != nullptr) {
+        hip::Stream::Destroy(selected);
+        selected = nullptr;
+      }
+      ClPrint(amd::LOG_ERROR, amd::LOG_CODE, "[hipGraph] Failed to create conditional stream!");
+      return hipErrorOutOfMemory;
+    }
+  }
+  *bodyStream = selected;
+  if (bodyExecs_.empty()) {
+    for (auto body : bodies_) {
+      GraphExec* exec = nullptr;
+      // The parallel streams of the bodies can't share the blocked queue either
+      hipError_t status = ihipGraphInstantiate(&exec, body, 0, true);
+      if (status != hipSuccess) {
+        if (exec != nullptr) {
+          exec->release();
+        }
+        ReleaseBodyExecs();
+        return status;
+      }
+      bodyExecs_.push_back(exec);
+    }
+  }
+  return hipSuccess;
+}
+
+// ================================================================================================
+hipError_t GraphConditionalNode::CreateCommand(hip::Stream* stream) {
+  hipError_t status = GraphNode::CreateCommand(stream);
+  if (status != hipSuccess) {
+    return status;
+  }
+  hip::Stream* bodyStream = nullptr;
+  status = Prepare(stream, &bodyStream);
+  if (status != hipSuccess) {
+    return status;
+  }
+  size_t offset = 0;
+  amd::Memory* gateMemory = getMemoryObject(gate_, offset);
+  if (gateMemory == nullptr) {
+    return hipErrorInvalidValue;
+  }
+  amd::Command::EventWaitList waitList;
+  commands_.reserve(2);
+  amd::Command* evaluate = new amd::Marker(*stream, !kMarkerDisableFlush, waitList);
+  if (evaluate == nullptr) {
+    return hipErrorOutOfMemory;
+  }
+  commands_.emplace_back(evaluate);
+
+  amd::BatchStreamOperationCommand::Operation op = {};
+  op.type_ = ROCCLR_COMMAND_STREAM_WAIT_VALUE;
+  op.memory_ = gateMemory;
+  op.value_ = ++launchSeq_;
+  op.mask_ = ~0ULL;
+  op.flags_ = ROCCLR_STREAM_WAIT_VALUE_GTE;
+  op.offset_ = offset;
+  op.sizeBytes_ = sizeof(uint64_t);
+  amd::Command* wait = new amd::BatchStreamOperationCommand(*stream, waitList, {op});
+  if (wait == nullptr) {
+    return hipErrorOutOfMemory;
+  }
+  commands_.emplace_back(wait);
+
+  // A launch, which was created but never enqueued, can't complete anymore. The later launches
+  // open the gate for its sequence number
+  delete pendingLaunch_;
+  pendingLaunch_ = new Launch(this, bodyStream, launchSeq_);
+  return hipSuccess;
+}
+
+// ================================================================================================
+void GraphConditionalNode::EnqueueCommands(hip::Stream* stream) {
+  if (commands_.empty()) {
+    return;
+  }
+  Launch* launch = pendingLaunch_;
+  pendingLaunch_ = nullptr;
+  if (!commands_[0]->setCallback(CL_COMPLETE, GraphConditionalNode::EvaluateCallback, launch)) {
+    ClPrint(amd::LOG_ERROR, amd::LOG_CODE, "[hipGraph] Failed during setCallback");
+    // Nothing evaluates the condition, hence open the gate to keep the stream going
+    launch->Complete(false);
+    delete launch;
+  }
+  for (auto& command : commands_) {
+    command->enqueue();
+    command->release();
+  }
+}
+
+// ================================================================================================
+bool GraphConditionalNode::LaunchBody(size_t body, Launch* launch) {
+  hip::Stream* bodyStream = launch->stream_;
+  // The worker thread doesn't have the current device of the application
+  hip::setCurrentDevice(bodyStream->DeviceId());
+  if (bodyExecs_[body]->Run(reinterpret_cast<hipStream_t>(bodyStream)) != hipSuccess) {
+    return false;
+  }
+  amd::Command::EventWaitList waitList;
+  amd::Command* marker = new amd::Marker(*bodyStream, !kMarkerDisableFlush, waitList);
+  if (marker == nullptr) {
+    return false;
+  }
+  if (!marker->setCallback(CL_COMPLETE, GraphConditionalNode::BodyCallback, launch)) {
+    marker->release();
+    return false;
+  }
+  // The body callback owns the launch from here on
+  marker->enqueue();
+  marker->release();
+  return true;
+}
+
+// ================================================================================================
+void GraphConditionalNode::EvaluateCallback(cl_event event, cl_int command_exec_status,
+                                            void* user_data) {
+  Launch* launch = reinterpret_cast<Launch*>(user_data);
+  launch->node_->worker_->Post(GraphConditionalNode::StartTask, launch);
+}
+
+// ================================================================================================
+void GraphConditionalNode::BodyCallback(cl_event event, cl_int command_exec_status,
+                                        void* user_data) {
+  Launch* launch = reinterpret_cast<Launch*>(user_data);
+  launch->node_->worker_->Post(GraphConditionalNode::ContinueTask, launch);
+}
+
+// ================================================================================================
+void GraphConditionalNode::StartTask(void* data) {
+  Launch* launch = reinterpret_cast<Launch*>(data);
+  if (launch->driver_.Start()) {
+    delete launch;
+  }
+}
+
+// ================================================================================================
+void GraphConditionalNode::ContinueTask(void* data) {
+  Launch* launch = reinterpret_cast<Launch*>(data);
+  if (launch->driver_.Continue()) {
+    delete launch;
+  }
+}
+
+// ================================================================================================
+hipError_t GraphConditionalNode::SetParams(GraphNode* node) {
+  const GraphConditionalNode* condNode = static_cast<GraphConditionalNode const*>(node);
+  if ((condNode->condType_ != condType_) || (condNode->bodies_.size() != bodies_.size())) {
+    return hipErrorInvalidValue;
+  }
+  for (size_t i = 0; i < bodies_.size(); ++i) {
+    const std::vector<Node>& newNodes = condNode->bodies_[i]->GetNodes();
+    const std::vector<Node>& oldNodes = bodies_[i]->GetNodes();
+    if (newNodes.size() != oldNodes.size()) {
+      return hipErrorInvalidValue;
+    }
+    for (size_t j = 0; j < newNodes.size(); ++j) {
+      hipError_t status = oldNodes[j]->SetParams(newNodes[j]);
+      if (status != hipSuccess) {
+        return status;
+      }
+    }
+  }
+  condNode->handle_->retain();
+  handle_->release();
+  handle_ = condNode->handle_;
+  // The instances hold copies of the old parameters
+  ReleaseBodyExecs();
+  return hipSuccess;
+}
 }  // namespace hip
@@ -34,6 +34,7 @@
 #include "hip_platform.hpp"
 #include "hip_mempool_impl.hpp"
 #include "hip_vm.hpp"
+#include "platform/conditional.hpp"
 
 typedef struct ihipExtKernelEvents {
   hipEvent_t startEvent_;
@@ -470,6 +471,45 @@ struct GraphNode : public hipGraphNodeDOTAttribute {
   }
 };
 
+// ================================================================================================
+//! Condition of the conditional nodes. The value lives in coherent host memory, so the kernels
+//! set it with a system scope store and the runtime reads it without a copy
+class ConditionalHandle : public amd::ReferenceCountedObject {
+  uint32_t* value_ = nullptr;   //!< The condition value
+  uint32_t defaultValue_;       //!< The value at creation and, optionally, at every launch
+  bool assignDefault_;          //!< Reset the value to the default one on every launch
+
+ public:
+  ConditionalHandle(uint32_t defaultValue, bool assignDefault)
+      : defaultValue_(defaultValue), assignDefault_(assignDefault) {}
+
+  ~ConditionalHandle() {
+    if (value_ != nullptr) {
+      ihipFree(value_);
+    }
+  }
+
+  //! Allocates the condition value
+  bool Create() {
+    if (ihipHostMalloc(reinterpret_cast<void**>(&value_), sizeof(uint32_t),
+                       hipExtHostAllocCoherent) != hipSuccess) {
+      value_ = nullptr;
+      return false;
+    }
+    *value_ = defaultValue_;
+    return true;
+  }
+
+  //! Returns the application handle, which is the address of the value
+  hipGraphConditionalHandle GetHandle() const {
+    return static_cast<hipGraphConditionalHandle>(reinterpret_cast<uintptr_t>(value_));
+  }
+  //! Returns the current value of the condition
+  uint32_t Read() const { return __atomic_load_n(value_, __ATOMIC_ACQUIRE); }
+  //! Enqueues the reset of the value to the default one, if the handle requires it
+  hipError_t EnqueueReset(hip::Stream* stream) const;
+};
+
 struct Graph {
   // Mark GraphExec as friend for faster access to the Graph fields.
   // (@todo GrpahExec should be derived from Graph)
@@ -494,6 +534,8 @@ struct Graph {
   std::unordered_set<GraphNode*> capturedNodes_;
   bool graphInstantiated_;
   std::unordered_set<void*> memAllocNodePtrs_;
+  //! Conditions of the conditional nodes, created on the graph
+  std::unordered_map<hipGraphConditionalHandle, ConditionalHandle*> conditionalHandles_;
  public:
   Graph(hip::Device* device, const Graph* original = nullptr)
       : pOriginalGraph_(original)
@@ -518,6 +560,9 @@ struct Graph {
     for (auto userobj : graphUserObj_) {
       userobj->release();
     }
+    for (auto& it : conditionalHandles_) {
+      it.second->release();
+    }
     if (mem_pool_ != nullptr) {
       mem_pool_->release();
     }
@@ -569,6 +614,25 @@ struct Graph {
   }
   // Delete user obj resource from graph
   void RemoveUserObjGraph(UserObject* pUserObj) { graphUserObj_.erase(pUserObj); }
+  //! Adds a condition to the graph, the graph takes the reference of the caller
+  void AddConditionalHandle(ConditionalHandle* handle) {
+    conditionalHandles_[handle->GetHandle()] = handle;
+  }
+  //! Returns the condition of the graph with the application handle or nullptr
+  ConditionalHandle* GetConditionalHandle(hipGraphConditionalHandle handle) const {
+    auto it = conditionalHandles_.find(handle);
+    return (it != conditionalHandles_.end()) ? it->second : nullptr;
+  }
+  //! Enqueues the reset of the conditions to the default values at the start of a launch
+  hipError_t ResetConditionalHandles(hip::Stream* stream) const {
+    for (const auto& it : conditionalHandles_) {
+      hipError_t status = it.second->EnqueueReset(stream);
+      if (status != hipSuccess) {
+        return status;
+      }
+    }
+    return hipSuccess;
+  }
 
   void GetRunListUtil(Node v, std::unordered_map<Node, bool>& visited,
                       std::vector<Node>& singleList, std::vector<std::vector<Node>>& parallelLists,
@@ -708,11 +772,13 @@ struct GraphExec : public amd::ReferenceCountedObject {
   int instantiateDeviceId_ = -1;
   bool hasHiddenHeap_ = false;  //!< Hidden heap indicator for Kernel node
   bool repeatLaunch_ = false;
+  bool dedicatedQueues_ = false;  //!< The parallel streams don't share hardware queues
 
  public:
   GraphExec(std::vector<Node>& topoOrder, std::vector<std::vector<Node>>& lists,
             std::unordered_map<Node, std::vector<Node>>& nodeWaitLists, struct Graph*& clonedGraph,
-            std::unordered_map<Node, Node>& clonedNodes, uint64_t flags = 0)
+            std::unordered_map<Node, Node>& clonedNodes, uint64_t flags = 0,
+            bool dedicatedQueues = false)
       : ReferenceCountedObject(),
         parallelLists_(lists),
         topoOrder_(topoOrder),
@@ -721,7 +787,8 @@ struct GraphExec : public amd::ReferenceCountedObject {
         clonedNodes_(clonedNodes),
         lastEnqueuedCommand_(nullptr),
         currentQueueIndex_(0),
-        flags_(flags) {
+        flags_(flags),
+        dedicatedQueues_(dedicatedQueues) {
     amd::ScopedLock lock(graphExecSetLock_);
     graphExecSet_.insert(this);
   }
@@ -2737,4 +2804,175 @@ class hipGraphExternalSemWaitNode : public GraphNode {
   }
 };
 
+class GraphBatchMemOpNode : public GraphNode {
+  std::vector<hipStreamBatchMemOpParams> paramArray_;  //!< Copy of the user operations
+  unsigned int flags_;
+
+ public:
+  GraphBatchMemOpNode(const hipBatchMemOpNodeParams* pNodeParams)
+      : GraphNode(hipGraphNodeTypeExtBatchMemOp, "solid", "rectangle", "BATCH_MEM_OP"),
+        paramArray_(pNodeParams->paramArray, pNodeParams->paramArray + pNodeParams->count),
+        flags_(pNodeParams->flags) {}
+
+  GraphBatchMemOpNode(const GraphBatchMemOpNode& rhs) : GraphNode(rhs) {
+    paramArray_ = rhs.paramArray_;
+    flags_ = rhs.flags_;
+  }
+  ~GraphBatchMemOpNode() {}
+
+  GraphNode* clone() const {
+    return new GraphBatchMemOpNode(static_cast<GraphBatchMemOpNode const&>(*this));
+  }
+
+  hipError_t CreateCommand(hip::Stream* stream) {
+    hipError_t status = GraphNode::CreateCommand(stream);
+    if (status != hipSuccess) {
+      return status;
+    }
+    // The memory objects are resolved on every launch, since they could be freed meanwhile
+    std::vector<amd::BatchStreamOperationCommand::Operation> ops;
+    status = ihipBatchMemOpOperations(paramArray_.size(), paramArray_.data(), flags_, &ops);
+    if (status != hipSuccess) {
+      return status;
+    }
+    amd::Command::EventWaitList waitList;
+    commands_.reserve(1);
+    amd::Command* command = new amd::BatchStreamOperationCommand(*stream, waitList, ops);
+    if (command == nullptr) {
+      return hipErrorOutOfMemory;
+    }
+    commands_.emplace_back(command);
+    return hipSuccess;
+  }
+
+  void GetParams(hipBatchMemOpNodeParams* pNodeParams) {
+    pNodeParams->ctx = nullptr;
+    pNodeParams->count = static_cast<unsigned int>(paramArray_.size());
+    pNodeParams->paramArray = paramArray_.data();
+    pNodeParams->flags = flags_;
+  }
+
+  hipError_t SetParams(const hipBatchMemOpNodeParams* pNodeParams) {
+    std::vector<amd::BatchStreamOperationCommand::Operation> ops;
+    hipError_t status = ihipBatchMemOpOperations(pNodeParams->count, pNodeParams->paramArray,
+                                                 pNodeParams->flags, &ops);
+    if (status != hipSuccess) {
+      return status;
+    }
+    paramArray_.assign(pNodeParams->paramArray, pNodeParams->paramArray + pNodeParams->count);
+    flags_ = pNodeParams->flags;
+    return hipSuccess;
+  }
+
+  virtual hipError_t SetParams(GraphNode* node) override {
+    const GraphBatchMemOpNode* batchNode = static_cast<GraphBatchMemOpNode const*>(node);
+    paramArray_ = batchNode->paramArray_;
+    flags_ = batchNode->flags_;
+    return hipSuccess;
+  }
+};
+
+// ================================================================================================
+//! Conditional node. The condition is evaluated on the host: a marker reports the completion
+//! of the dependencies, the conditional worker thread reads the condition and launches the
+//! selected body on a side stream with a hardware queue of its own, while the node stream waits
+//! on a gate value, which the runtime writes once the last body is done. The application thread
+//! never waits for the condition, but every evaluation, i.e. every iteration of a while node,
+//! is a round trip through the host
+class GraphConditionalNode : public GraphNode {
+  //! State of a single launch of the node. The pending callback owns it, i.e. the evaluation
+  //! callback until it launches a body, then the callback of the body
+  struct Launch : public amd::ConditionalDriver::Backend {
+    GraphConditionalNode* node_;      //!< The launched node
+    hip::Stream* stream_;             //!< The stream, which runs the bodies
+    uint64_t seq_;                    //!< Launch number, written to the gate on completion
+    amd::ConditionalDriver driver_;   //!< Evaluates the condition
+
+    Launch(GraphConditionalNode* node, hip::Stream* stream, uint64_t seq)
+        : node_(node),
+          stream_(stream),
+          seq_(seq),
+          driver_(node->condType_, node->bodies_.size(), this) {}
+
+    uint32_t ReadCondition() override { return node_->handle_->Read(); }
+    bool LaunchBody(size_t body) override { return node_->LaunchBody(body, this); }
+    void Complete(bool success) override;
+  };
+
+  ConditionalHandle* handle_;             //!< The condition of the node
+  amd::ConditionalType condType_;         //!< Kind of the node
+  std::vector<Graph*> bodies_;            //!< The bodies, owned by the node
+  std::vector<GraphExec*> bodyExecs_;     //!< The bodies, instantiated on the first launch
+  hip::Stream* bodyStreams_[3] = {};      //!< The streams, which run the bodies, per priority
+  amd::ConditionalWorker* worker_ = nullptr;  //!< Evaluates the condition of the launches
+  uint64_t* gate_ = nullptr;              //!< The number of the last completed launch
+  uint64_t launchSeq_ = 0;                //!< The number of the last enqueued launch
+  Launch* pendingLaunch_ = nullptr;       //!< The launch, created with the commands
+
+  //! Instantiates the bodies and allocates the execution resources of the node.
+  //! Returns the stream for the bodies of a launch on the stream
+  hipError_t Prepare(hip::Stream* stream, hip::Stream** bodyStream);
+  //! Releases the body instances, so the next launch picks up the new body parameters
+  void ReleaseBodyExecs();
+  //! Launches a body on the body stream, the completion continues the evaluation
+  bool LaunchBody(size_t body, Launch* launch);
+
+  //! The command callbacks post the evaluation to the worker, which launches the bodies
+  static void EvaluateCallback(cl_event event, cl_int command_exec_status, void* user_data);
+  static void BodyCallback(cl_event event, cl_int command_exec_status, void* user_data);
+  static void StartTask(void* data);
+  static void ContinueTask(void* data);
+
+ public:
+  GraphConditionalNode(ConditionalHandle* handle, amd::ConditionalType type, size_t numBodies,
+                       hip::Device* device)
+      : GraphNode(hipGraphNodeTypeExtConditional, "solid", "rectangle", "CONDITIONAL"),
+        handle_(handle),
+        condType_(type) {
+    handle_->retain();
+    for (size_t i = 0; i < numBodies; ++i) {
+      bodies_.push_back(new Graph(device));
+    }
+  }
+
+  GraphConditionalNode(const GraphConditionalNode& rhs) : GraphNode(rhs) {
+    handle_ = rhs.handle_;
+    handle_->retain();
+    condType_ = rhs.condType_;
+    for (auto body : rhs.bodies_) {
+      bodies_.push_back(body->clone());
+    }
+  }
+
+  ~GraphConditionalNode();
+
+  GraphNode* clone() const override {
+    return new GraphConditionalNode(static_cast<GraphConditionalNode const&>(*this));
+  }
+
+  const std::vector<Graph*>& GetBodies() const { return bodies_; }
+
+  //! Creates the evaluation marker and the wait on the gate. The dependencies wait on both,
+  //! since the commands on other streams depend on the first command of a node
+  hipError_t CreateCommand(hip::Stream* stream) override;
+
+  void EnqueueCommands(hip::Stream* stream) override;
+
+  hipError_t SetParams(GraphNode* node) override;
+
+  virtual std::string GetLabel(hipGraphDebugDotFlags flag) override {
+    std::string label = std::to_string(GetID()) + "\n" + label_;
+    for (auto body : bodies_) {
+      label += "\ngraph_" + std::to_string(body->GetID());
+    }
+    return label;
+  }
+
+  virtual void GenerateDOT(std::ostream& fout, hipGraphDebugDotFlags flag) override {
+    for (auto body : bodies_) {
+      body->GenerateDOT(fout, flag);
+    }
+  }
+};
+
 }  // namespace hip
@@ -24,6 +24,10 @@
 #include "platform/context.hpp"
 #include "platform/command.hpp"
 #include "platform/memory.hpp"
+#include "device/devsvmbatch.hpp"
+
+#include <map>
+#include <tuple>
 
 namespace hip {
 
@@ -167,6 +171,179 @@ hipError_t hipMemAdvise(const void* dev_ptr, size_t count, hipMemoryAdvise advic
   HIP_RETURN(hipSuccess);
 }
 
+// ================================================================================================
+hipError_t hipExtMemPrefetchBatchAsync(const void* const* ptrs, const size_t* sizes,
+                                       const int* devices, size_t count, hipStream_t stream) {
+  HIP_INIT_API(hipExtMemPrefetchBatchAsync, ptrs, sizes, devices, count, stream);
+
+  if ((ptrs == nullptr) || (sizes == nullptr) || (devices == nullptr) || (count == 0)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+
+  if (!hip::isValid(stream)) {
+    HIP_RETURN(hipErrorContextIsDestroyed);
+  }
+
+  // The ranges of different allocations aren't merged, the value is the destination device
+  // index + 1, 0 - CPU
+  std::map<amd::Memory*, uint64_t> keys;
+  std::vector<amd::device::SvmBatchRange> ranges;
+  ranges.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const int device = devices[i];
+    if ((ptrs[i] == nullptr) || (sizes[i] == 0)) {
+      HIP_RETURN(hipErrorInvalidValue);
+    }
+    size_t offset = 0;
+    amd::Memory* memObj = getMemoryObject(ptrs[i], offset);
+    if ((memObj != nullptr) && (sizes[i] > (memObj->getSize() - offset))) {
+      HIP_RETURN(hipErrorInvalidValue);
+    }
+    if (device != hipCpuDeviceId && (static_cast<size_t>(device) >= g_devices.size())) {
+      HIP_RETURN(hipErrorInvalidDevice);
+    }
+    if ((memObj == nullptr) && (device != hipCpuDeviceId) &&
+        (!g_devices[device]->devices()[0]->info().hmmCpuMemoryAccessible_)) {
+      HIP_RETURN(hipErrorNotSupported);
+    }
+    uint64_t key = keys.emplace(memObj, keys.size()).first->second;
+    ranges.push_back({reinterpret_cast<uintptr_t>(ptrs[i]), sizes[i], key,
+                      static_cast<uint64_t>(device + 1)});
+  }
+
+  hip::Stream* hip_stream = (stream == nullptr || stream == hipStreamLegacy) ?
+                            hip::getCurrentDevice()->NullStream() : hip::getStream(stream);
+  if (hip_stream == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+
+  std::vector<amd::SvmPrefetchAsyncCommand::Range> prefetches;
+  for (const auto& run : amd::device::PlanSvmBatch(ranges)) {
+    bool cpu_access = (run.value_ == 0);
+    amd::Device* dev = cpu_access ? nullptr : g_devices[run.value_ - 1]->devices()[0];
+    prefetches.push_back({reinterpret_cast<const void*>(run.start_), run.size_, dev, cpu_access});
+  }
+  ClPrint(amd::LOG_DEBUG, amd::LOG_API, "Batch of %zu prefetches in %zu ranges", count,
+          prefetches.size());
+
+  amd::Command::EventWaitList waitList;
+  amd::SvmPrefetchAsyncCommand* command =
+      new amd::SvmPrefetchAsyncCommand(*hip_stream, waitList, std::move(prefetches));
+  if (command == nullptr) {
+    HIP_RETURN(hipErrorOutOfMemory);
+  }
+
+  command->enqueue();
+  command->release();
+
+  HIP_RETURN(hipSuccess);
+}
+
+// ================================================================================================
+hipError_t hipExtMemAdviseBatch(const void* const* ptrs, const size_t* sizes,
+                                const hipMemoryAdvise* advices, const int* devices,
+                                size_t count) {
+  HIP_INIT_API(hipExtMemAdviseBatch, ptrs, sizes, advices, devices, count);
+
+  if ((ptrs == nullptr) || (sizes == nullptr) || (advices == nullptr) || (devices == nullptr) ||
+      (count == 0)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+
+  // The advices override each other, if they set the same attribute of the same allocation.
+  // The attribute of SetAccessedBy is the access of the referred device. The value is
+  // the advice and the device index + 1, 0 - CPU or no device
+  amd::Device* dev = g_devices[0]->devices()[0];
+  std::map<std::tuple<amd::Memory*, uint32_t, int>, uint64_t> keys;
+  std::vector<amd::device::SvmBatchRange> ranges;
+  ranges.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    hipMemoryAdvise advice = advices[i];
+    int device = devices[i];
+    bool isAdviseReadMostly = (advice == hipMemAdviseSetReadMostly) ||
+                              (advice == hipMemAdviseUnsetReadMostly);
+
+    if (!isAdviseReadMostly && ((device != hipCpuDeviceId) &&
+        (static_cast<size_t>(device) >= g_devices.size()))) {
+      HIP_RETURN(hipErrorInvalidDevice);
+    }
+    if ((ptrs[i] == nullptr) || (sizes[i] == 0)) {
+      HIP_RETURN(hipErrorInvalidValue);
+    }
+    size_t offset = 0;
+    amd::Memory* memObj = getMemoryObject(ptrs[i], offset);
+    if (memObj && sizes[i] > (memObj->getSize() - offset)) {
+      HIP_RETURN(hipErrorInvalidValue);
+    }
+    // The runs are parts of the ranges, hence none of the updates fails on an unknown range
+    if (!dev->ValidateSvmRange(ptrs[i], sizes[i])) {
+      HIP_RETURN(hipErrorInvalidValue);
+    }
+
+    uint32_t attribute = 0;
+    switch (advice) {
+      case hipMemAdviseSetReadMostly:
+      case hipMemAdviseUnsetReadMostly:
+        device = hipCpuDeviceId;
+        attribute = amd::MemRangeAttribute::ReadMostly;
+        break;
+      case hipMemAdviseSetPreferredLocation:
+        attribute = amd::MemRangeAttribute::PreferredLocation;
+        break;
+      case hipMemAdviseUnsetPreferredLocation:
+        // The unset doesn't depend on the device, so the unsets of all devices merge
+        device = hipCpuDeviceId;
+        attribute = amd::MemRangeAttribute::PreferredLocation;
+        break;
+      case hipMemAdviseSetAccessedBy:
+      case hipMemAdviseUnsetAccessedBy:
+        attribute = amd::MemRangeAttribute::AccessedBy;
+        break;
+      case hipMemAdviseSetCoarseGrain:
+      case hipMemAdviseUnsetCoarseGrain:
+        device = hipCpuDeviceId;
+        attribute = amd::MemRangeAttribute::CoherencyMode;
+        break;
+      default:
+        HIP_RETURN(hipErrorInvalidValue);
+    }
+    int keyDevice = (attribute == amd::MemRangeAttribute::AccessedBy) ? device : hipCpuDeviceId;
+    uint64_t key = keys.emplace(std::make_tuple(memObj, attribute, keyDevice),
+                                keys.size()).first->second;
+    uint64_t value = (static_cast<uint64_t>(advice) << 32) | static_cast<uint32_t>(device + 1);
+    ranges.push_back({reinterpret_cast<uintptr_t>(ptrs[i]), sizes[i], key, value});
+  }
+
+  if (!dev->info().hmmSupported_) {
+    // Every advice is a no-op without HMM, as hipMemAdvise ignores it
+    LogWarning("hipExtMemAdviseBatch is ignored, because no HMM support");
+    HIP_RETURN(hipSuccess);
+  }
+
+  // Apply all the advices of the same bytes with a single update
+  auto runs = amd::device::PlanSvmBatch(ranges);
+  size_t updates = 0;
+  for (size_t first = 0; first < runs.size();) {
+    std::vector<amd::SvmAdvice> svmAdvices;
+    size_t last = first;
+    for (; (last < runs.size()) && (runs[last].start_ == runs[first].start_) &&
+           (runs[last].size_ == runs[first].size_); ++last) {
+      uint32_t device = static_cast<uint32_t>(runs[last].value_);
+      svmAdvices.push_back({static_cast<amd::MemoryAdvice>(runs[last].value_ >> 32),
+                            (device == 0) ? nullptr : g_devices[device - 1]->devices()[0]});
+    }
+    if (!dev->SetSvmAttributes(reinterpret_cast<const void*>(runs[first].start_),
+                               runs[first].size_, svmAdvices)) {
+      HIP_RETURN(hipErrorInvalidValue);
+    }
+    ++updates;
+    first = last;
+  }
+  ClPrint(amd::LOG_DEBUG, amd::LOG_API, "Batch of %zu advices in %zu updates", count, updates);
+
+  HIP_RETURN(hipSuccess);
+}
+
 // ================================================================================================
 hipError_t hipMemRangeGetAttribute(void* data, size_t data_size, hipMemRangeAttribute attribute,
                                    const void* dev_ptr, size_t count) {
@@ -0,0 +1,173 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_host_cache.hpp"
+
+namespace hip {
+
+// ================================================================================================
+HostMemCache::~HostMemCache() {
+  Trim(0);
+  delete backend_;
+}
+
+// ================================================================================================
+size_t HostMemCache::SizeClass(size_t size) {
+  // The pinning granularity is a page, the smaller classes don't save memory
+  constexpr size_t kMinClass = 4 * Ki;
+  if (size <= kMinClass) {
+    return kMinClass;
+  }
+  // 4 classes between the powers of two
+  return amd::alignUp(size, std::max(amd::nextPowerOfTwo(size) / 8, kMinClass));
+}
+
+// ================================================================================================
+hipError_t HostMemCache::Alloc(size_t size, unsigned int flags, void** ptr) {
+  const size_t size_class = SizeClass(size);
+  if (!Enabled() || (size_class > max_idle_bytes_)) {
+    // The allocation could never stay in the cache
+    return backend_->Alloc(size, flags, ptr);
+  }
+
+  const Key key(flags, size_class);
+  {
+    amd::ScopedLock lock(lock_);
+    auto range = idle_by_key_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      auto block = it->second;
+      if ((block->fence_ != nullptr) && !backend_->FenceDone(block->fence_, false)) {
+        // The GPU may still access the memory
+        continue;
+      }
+      if (block->fence_ != nullptr) {
+        backend_->ReleaseFence(block->fence_);
+        block->fence_ = nullptr;
+      }
+      *ptr = block->ptr_;
+      block->size_ = size;
+      idle_bytes_ -= size_class;
+      in_use_bytes_ += size_class;
+      in_use_.emplace(*ptr, *block);
+      idle_by_key_.erase(it);
+      idle_.erase(block);
+      hits_++;
+      return hipSuccess;
+    }
+    misses_++;
+  }
+
+  hipError_t status = backend_->Alloc(size_class, flags, ptr);
+  if (status == hipErrorOutOfMemory) {
+    // Give the freed memory back and retry
+    Trim(0);
+    status = backend_->Alloc(size_class, flags, ptr);
+  }
+  if (status == hipSuccess) {
+    amd::ScopedLock lock(lock_);
+    in_use_bytes_ += size_class;
+    in_use_.emplace(*ptr, Block{*ptr, size, key, nullptr, idle_by_key_.end()});
+  }
+  return status;
+}
+
+// ================================================================================================
+bool HostMemCache::Free(void* ptr) {
+  std::vector<Block> evicted;
+  {
+    amd::ScopedLock lock(lock_);
+
+    auto it = in_use_.find(ptr);
+    if (it == in_use_.end()) {
+      return false;
+    }
+    const size_t size = it->second.key_.second;
+    idle_.push_front(it->second);
+    in_use_.erase(it);
+    in_use_bytes_ -= size;
+
+    // The free doesn't wait for the device, the reuse waits for the work queued so far
+    auto block = idle_.begin();
+    block->size_ = 0;
+    block->fence_ = backend_->RecordFence();
+    block->key_it_ = idle_by_key_.emplace(block->key_, block);
+    idle_bytes_ += size;
+    Evict(max_idle_bytes_, &evicted);
+  }
+  Release(evicted);
+  return true;
+}
+
+// ================================================================================================
+bool HostMemCache::GetSize(void* ptr, size_t* size) const {
+  amd::ScopedLock lock(lock_);
+  auto it = in_use_.find(ptr);
+  if (it == in_use_.end()) {
+    return false;
+  }
+  *size = it->second.size_;
+  return true;
+}
+
+// ================================================================================================
+void HostMemCache::Trim(size_t min_bytes_to_keep) {
+  std::vector<Block> evicted;
+  {
+    amd::ScopedLock lock(lock_);
+    Evict(min_bytes_to_keep, &evicted);
+  }
+  Release(evicted);
+}
+
+// ================================================================================================
+void HostMemCache::GetStats(hipExtHostMemCacheStats* stats) const {
+  amd::ScopedLock lock(lock_);
+  stats->cachedBytes = idle_bytes_;
+  stats->cachedBlocks = idle_.size();
+  stats->inUseBytes = in_use_bytes_;
+  stats->hits = hits_;
+  stats->misses = misses_;
+  stats->releases = releases_;
+}
+
+// ================================================================================================
+void HostMemCache::Evict(size_t max_bytes, std::vector<Block>* evicted) {
+  while (!idle_.empty() && (idle_bytes_ > max_bytes)) {
+    Block& block = idle_.back();
+    idle_bytes_ -= block.key_.second;
+    idle_by_key_.erase(block.key_it_);
+    evicted->push_back(block);
+    idle_.pop_back();
+    releases_++;
+  }
+}
+
+// ================================================================================================
+void HostMemCache::Release(std::vector<Block>& evicted) {
+  for (auto& block : evicted) {
+    if (block.fence_ != nullptr) {
+      backend_->FenceDone(block.fence_, true);
+      backend_->ReleaseFence(block.fence_);
+    }
+    backend_->Free(block.ptr_);
+  }
+}
+
+}  // namespace hip
@@ -0,0 +1,122 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <hip/hip_runtime.h>
+#include "hip_internal.hpp"
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace hip {
+
+class Device;
+
+/// Size-classed cache of the pinned host allocations on a device.
+/// A freed allocation is parked with a fence of the GPU work queued at the free, so the
+/// free doesn't wait for the device. The next allocation with the same size class and
+/// ROCclr flags (coherence, NUMA policy) reuses it once the fence is complete. The idle
+/// allocations are bounded by a bytes budget, the real release is deferred until an
+/// eviction or Trim()
+class HostMemCache : public amd::HeapObject {
+public:
+  /// Allocation backend. The device backend goes to ROCclr, tests can provide a stub
+  class Backend : public amd::HeapObject {
+  public:
+    virtual ~Backend() {}
+    /// Allocates pinned host memory with the ROCclr SVM flags
+    virtual hipError_t Alloc(size_t size, unsigned int flags, void** ptr) = 0;
+    /// Returns the memory to the OS, the GPU work on it is complete
+    virtual void Free(void* ptr) = 0;
+    /// Returns a fence of the GPU work queued so far or nullptr if nothing is outstanding
+    virtual void* RecordFence() = 0;
+    /// Returns true if the fenced work is complete, waits for it if wait is set
+    virtual bool FenceDone(void* fence, bool wait) = 0;
+    /// Destroys the fence
+    virtual void ReleaseFence(void* fence) = 0;
+  };
+
+  HostMemCache(Backend* backend, size_t max_idle_bytes)
+    : lock_("Host memory cache lock", true), backend_(backend),
+      max_idle_bytes_(max_idle_bytes) {}
+  ~HostMemCache();
+
+  /// Returns true if the freed allocations are kept for reuse
+  bool Enabled() const { return max_idle_bytes_ != 0; }
+
+  /// Allocates pinned host memory of at least size bytes, reuses a freed allocation if possible
+  hipError_t Alloc(size_t size, unsigned int flags, void** ptr);
+
+  /// Parks the allocation for reuse. Returns false if the pointer wasn't allocated by the cache
+  bool Free(void* ptr);
+
+  /// Returns the requested size of a cached allocation, which the application holds.
+  /// Returns false if the pointer wasn't allocated by the cache
+  bool GetSize(void* ptr, size_t* size) const;
+
+  /// Returns the idle allocations to the OS until at most min_bytes_to_keep stay cached
+  void Trim(size_t min_bytes_to_keep);
+
+  /// Fills the cache statistics
+  void GetStats(hipExtHostMemCacheStats* stats) const;
+
+  /// Rounds the size up to the cached size class. Every power of two is split into 4 classes,
+  /// so the rounding wastes at most 25%
+  static size_t SizeClass(size_t size);
+
+private:
+  /// Allocations are interchangeable with equal ROCclr flags and size class
+  typedef std::pair<unsigned int, size_t> Key;
+
+  struct Block {
+    void* ptr_;                                     //!< Host address
+    size_t size_;                                   //!< Requested size, if in use
+    Key key_;                                       //!< ROCclr flags and size class
+    void* fence_;                                   //!< GPU work queued at the free, if idle
+    std::multimap<Key, std::list<Block>::iterator>::iterator key_it_;  //!< Lookup position
+  };
+
+  /// Removes the least recently freed allocations until the budget is met.
+  /// The caller holds the lock and passes the evicted allocations to Release()
+  void Evict(size_t max_bytes, std::vector<Block>* evicted);
+
+  /// Waits for the GPU work on the evicted allocations and returns them to the OS.
+  /// Runs without the lock, so the other threads don't wait for the device
+  void Release(std::vector<Block>& evicted);
+
+  mutable amd::Monitor lock_;                       //!< Lock for the cache state
+  Backend* backend_;                                //!< Allocation backend
+  std::unordered_map<void*, Block> in_use_;         //!< Cached allocations owned by the app
+  std::list<Block> idle_;                           //!< Freed allocations, the front is newest
+  std::multimap<Key, std::list<Block>::iterator> idle_by_key_;  //!< Freed allocations per key
+  size_t idle_bytes_ = 0;                           //!< Size of all freed allocations
+  size_t in_use_bytes_ = 0;                         //!< Size of all allocations owned by the app
+  size_t max_idle_bytes_;                           //!< Max size of freed allocations
+  uint64_t hits_ = 0;                               //!< Allocations served from the freed ones
+  uint64_t misses_ = 0;                             //!< Allocations from the backend
+  uint64_t releases_ = 0;                           //!< Freed allocations returned to the OS
+};
+
+/// Creates the pinned host allocation cache for the device with the device backend
+HostMemCache* CreateHostMemCache(hip::Device* device);
+
+}  // namespace hip
@@ -53,3 +53,14 @@ extern "C" void hipRegisterTracerCallback(int (*function)(activity_domain_t doma
                                                           uint32_t operation_id, void* data)) {
   amd::activity_prof::report_activity.store(function, std::memory_order_relaxed);
 }
+
+// The records are buffered per queue and delivered on the queue finish, when a buffer is full
+// or on hipFlushTracerActivity(). The callback registered with hipRegisterTracerCallback()
+// still enables the activity and receives the records if the batch callback is removed.
+extern "C" void hipRegisterTracerBatchCallback(activity_batch_callback_t function) {
+  // Deliver the pending records to the previous callback
+  amd::activity_prof::RecordBuffer::flushAll();
+  amd::activity_prof::report_activity_batch.store(function, std::memory_order_relaxed);
+}
+
+extern "C" void hipFlushTracerActivity() { amd::activity_prof::RecordBuffer::flushAll(); }
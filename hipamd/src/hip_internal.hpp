@@ -25,8 +25,11 @@
 #include "hip_prof_api.h"
 #include "trace_helper.h"
 #include "utils/debug.hpp"
+#include "utils/slab.hpp"
 #include "hip_formatting.hpp"
+#include <hip/amd_detail/amd_hip_ext_api.h>
 #include "hip_graph_capture.hpp"
+#include "hip_device_attributes.hpp"
 
 #include <unordered_set>
 #include <thread>
@@ -274,6 +277,8 @@ public:
 
   class Device;
   class MemoryPool;
+  class IpcMemCache;
+  class HostMemCache;
   class Event;
   class Stream : public amd::HostQueue {
   public:
@@ -318,7 +323,8 @@ public:
   public:
     Stream(Device* dev, Priority p = Priority::Normal, unsigned int f = 0, bool null_stream = false,
            const std::vector<uint32_t>& cuMask = {},
-           hipStreamCaptureStatus captureStatus = hipStreamCaptureStatusNone);
+           hipStreamCaptureStatus captureStatus = hipStreamCaptureStatusNone,
+           bool dedicatedQueue = false);
 
     /// Creates the hip stream object, including AMD host queue
     bool Create();
@@ -451,6 +457,14 @@ public:
       ~Stream() {};
   };
 
+  /// A named partition of the device CUs, which the streams of the pool run on
+  struct CuPool {
+    std::string name_;                        //!< Name of the pool, unique on the device
+    std::vector<uint32_t> cuMask_;            //!< CU mask of the pool streams
+    uint32_t numCUs_;                         //!< Number of CUs in the mask
+    std::unordered_set<Stream*> streams_;     //!< Live streams, created in the pool
+  };
+
   /// HIP Device class
   class Device : public amd::ReferenceCountedObject {
     amd::Monitor lock_{"Device lock", true};
@@ -478,6 +492,19 @@ public:
 
     std::set<MemoryPool*> mem_pools_;
 
+    IpcMemCache* ipc_mem_cache_ = nullptr;  //!< Attached IPC memory handles
+    HostMemCache* host_mem_cache_ = nullptr;  //!< Freed pinned host allocations
+
+    amd::Monitor descriptor_lock_{"Guards descriptor slabs"};
+    //! Fine grained texture and surface descriptors per descriptor size
+    std::map<size_t, amd::SlabAllocator*> descriptor_slabs_;
+
+    amd::Monitor cu_pool_lock_{"Guards CU pools", true};
+    std::vector<CuPool> cu_pools_;  //!< The CU partitions of the device
+
+    hipDeviceProp_tR0600 props_ = {};   //!< Device properties, immutable after Create()
+    DeviceAttributes attributes_;      //!< Attribute table, derived from props_
+
   public:
     Device(amd::Context* ctx, int devId): context_(ctx),
         deviceId_(devId),
@@ -568,6 +595,44 @@ public:
     /// Add safe streams into the memppools for reuse
     void AddSafeStream(Stream* event_stream, Stream* wait_stream);
 
+    /// Returns the cache of the attached IPC memory handles
+    IpcMemCache* GetIpcMemCache() const { return ipc_mem_cache_; }
+
+    /// Returns the cache of the pinned host allocations
+    HostMemCache* GetHostMemCache() const { return host_mem_cache_; }
+
+    /// Returns a fine grained block for a texture or surface descriptor
+    void* AllocDescriptor(size_t size);
+
+    /// Recycles a block returned by AllocDescriptor()
+    void FreeDescriptor(void* ptr);
+
+    /// Frees the descriptor slabs, the live descriptors become invalid
+    void DestroyDescriptorSlabs();
+
+    /// Replaces the CU partitions of the device. Fails if a stream still runs in a pool
+    hipError_t PartitionCUs(const hipExtCUPoolDesc* pools, unsigned int numPools);
+
+    /// Guards the CU pools, while a stream is created in one of them
+    amd::Monitor& CuPoolLock() { return cu_pool_lock_; }
+
+    /// Returns the CU pool with the name or nullptr. The caller must hold CuPoolLock()
+    CuPool* FindCuPool(const char* name);
+
+    /// Returns the number of the CU pools
+    size_t CuPoolCount();
+
+    /// Returns the description of the CU pool with the index
+    hipError_t GetCuPoolInfo(size_t index, hipExtCUPoolInfo* info);
+
+    /// Returns the device properties, cached at device creation
+    const hipDeviceProp_tR0600& Properties() const { return props_; }
+
+    /// Returns a device attribute, false if the attribute is unknown
+    bool GetAttribute(hipDeviceAttribute_t attr, int* pi) const {
+      return attributes_.Get(attr, pi);
+    }
+
     /// Returns true if memory pool is valid on this device
     bool IsMemoryPoolValid(MemoryPool* pool);
     void AddStream(Stream* stream);
@@ -583,6 +648,9 @@ public:
     bool StreamCaptureBlocking();
 
     bool existsActiveStreamForDevice();
+
+    /// Collects the last queued command of every stream, the commands are retained
+    void GetLastCommands(std::vector<amd::Command*>* commands);
   /// Wait all active streams on the blocking queue. The method enqueues a wait command and
   /// doesn't stall the current thread
     void WaitActiveStreams(hip::Stream* blocking_stream, bool wait_null_stream = false);
@@ -643,6 +711,20 @@ public:
   extern hipError_t ihipHostMalloc(void** ptr, size_t sizeBytes, unsigned int flags);
   extern amd::Memory* getMemoryObject(const void* ptr, size_t& offset, size_t size = 0);
   extern amd::Memory* getMemoryObjectWithOffset(const void* ptr, const size_t size = 0);
+
+  //! User pointer classified once at API entry, so memcpy/memset validation, kind inference and
+  //! command construction don't look it up in MemObjMap again
+  struct ResolvedPtr {
+    const void* ptr_ = nullptr;               //!< User pointer
+    amd::Memory* memory_ = nullptr;           //!< Owning memory object, null for host memory
+    size_t offset_ = 0;                       //!< Offset of ptr_ inside memory_
+    amd::Device* device_ = nullptr;           //!< Device owning memory_
+    hipMemoryType type_ = hipMemoryTypeHost;  //!< Device, or host for fine grain/host ptr memory
+    cl_mem_flags flags_ = 0;                  //!< Memory flags of memory_
+
+    ResolvedPtr() = default;
+    explicit ResolvedPtr(const void* ptr);
+  };
   extern void getStreamPerThread(hipStream_t& stream);
   extern hipStream_t getPerThreadDefaultStream();
   extern hipError_t ihipUnbindTexture(textureReference* texRef);
@@ -654,6 +736,9 @@ public:
   extern hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void* ptr,
                                         uint64_t value, uint64_t mask, unsigned int flags,
                                         size_t sizeBytes);
+  extern hipError_t ihipBatchMemOpOperations(
+      size_t count, const hipStreamBatchMemOpParams* paramArray, unsigned int flags,
+      std::vector<amd::BatchStreamOperationCommand::Operation>* ops);
   hipError_t ihipMemcpy(void* dst, const void* src, size_t sizeBytes, hipMemcpyKind kind,
                         hip::Stream& stream, bool isHostAsync = false, bool isGPUAsync = true);
   constexpr bool kOptionChangeable = true;
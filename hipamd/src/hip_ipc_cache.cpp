@@ -0,0 +1,125 @@
+/* Copyright (c) 2023 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_ipc_cache.hpp"
+
+namespace hip {
+
+// ================================================================================================
+IpcMemCache::~IpcMemCache() {
+  // The device teardown or reset invalidates the open mappings as well
+  for (const auto& it : entries_) {
+    if (!backend_->Detach(it.second.dev_ptr_)) {
+      LogPrintfError("Failed to detach IPC memory: 0x%x", it.second.dev_ptr_);
+    }
+  }
+  delete backend_;
+}
+
+// ================================================================================================
+bool IpcMemCache::Open(const ihipIpcMemHandle_t& handle, unsigned int flags, void** dev_ptr) {
+  IpcMemKey key(handle);
+  amd::ScopedLock lock(lock_);
+  // Don't revive a mapping, which the exporter may have freed meanwhile
+  Evict(max_idle_entries_, max_idle_bytes_);
+
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    if (it->second.refs_ == 0) {
+      // Revive the idle mapping
+      idle_.erase(it->second.idle_it_);
+      idle_bytes_ -= key.size_;
+    }
+    it->second.refs_++;
+    *dev_ptr = it->second.dev_ptr_;
+    return true;
+  }
+
+  if (!backend_->Attach(handle, flags, dev_ptr)) {
+    return false;
+  }
+  entries_.emplace(key, Entry{*dev_ptr, 1, idle_.end(), 0});
+  ptr_to_key_.emplace(*dev_ptr, key);
+  return true;
+}
+
+// ================================================================================================
+bool IpcMemCache::Close(void* dev_ptr) {
+  amd::ScopedLock lock(lock_);
+
+  auto pit = ptr_to_key_.find(dev_ptr);
+  if (pit == ptr_to_key_.end()) {
+    return false;
+  }
+  auto it = entries_.find(pit->second);
+  assert(it != entries_.end() && "IPC cache is out of sync");
+  if (it->second.refs_ == 0) {
+    // The mapping was already closed
+    return false;
+  }
+  if (--it->second.refs_ != 0) {
+    return true;
+  }
+
+  const size_t size = it->first.size_;
+  if ((max_idle_entries_ == 0) || (size > max_idle_bytes_)) {
+    // Caching is disabled or the mapping alone exceeds the budget
+    bool result = backend_->Detach(dev_ptr);
+    ptr_to_key_.erase(pit);
+    entries_.erase(it);
+    return result;
+  }
+  idle_.push_front(it->first);
+  it->second.idle_it_ = idle_.begin();
+  it->second.idle_since_ = backend_->Now();
+  idle_bytes_ += size;
+  Evict(max_idle_entries_, max_idle_bytes_);
+  return true;
+}
+
+// ================================================================================================
+void IpcMemCache::Trim() {
+  amd::ScopedLock lock(lock_);
+  Evict(0, 0);
+}
+
+// ================================================================================================
+void IpcMemCache::Evict(size_t max_entries, size_t max_bytes) {
+  const uint64_t now = idle_.empty() ? 0 : backend_->Now();
+  while (!idle_.empty()) {
+    auto it = entries_.find(idle_.back());
+    assert(it != entries_.end() && "IPC cache is out of sync");
+    // The back of the LRU list is the oldest idle mapping
+    if ((idle_.size() <= max_entries) && (idle_bytes_ <= max_bytes) &&
+        (now - it->second.idle_since_ <= max_idle_ns_)) {
+      break;
+    }
+    void* dev_ptr = it->second.dev_ptr_;
+    idle_bytes_ -= it->first.size_;
+    idle_.pop_back();
+    if (!backend_->Detach(dev_ptr)) {
+      LogPrintfError("Failed to detach IPC memory: 0x%x", dev_ptr);
+    }
+    ptr_to_key_.erase(dev_ptr);
+    entries_.erase(it);
+  }
+}
+
+}  // namespace hip
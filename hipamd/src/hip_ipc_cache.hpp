@@ -0,0 +1,124 @@
+/* Copyright (c) 2023 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <hip/hip_runtime.h>
+#include "hip_internal.hpp"
+#include <cstring>
+#include <list>
+#include <map>
+#include <unordered_map>
+
+namespace hip {
+
+class Device;
+
+/// Identity of an IPC memory handle. Equal keys refer to the same exported allocation
+struct IpcMemKey {
+  IpcMemKey(const ihipIpcMemHandle_t& handle)
+    : size_(handle.psize), offset_(handle.poffset), pid_(handle.owners_process_id) {
+    ::memcpy(handle_, handle.ipc_handle, IHIP_IPC_MEM_HANDLE_SIZE);
+  }
+  bool operator<(const IpcMemKey& rhs) const {
+    if (size_ != rhs.size_) return size_ < rhs.size_;
+    if (offset_ != rhs.offset_) return offset_ < rhs.offset_;
+    if (pid_ != rhs.pid_) return pid_ < rhs.pid_;
+    return ::memcmp(handle_, rhs.handle_, IHIP_IPC_MEM_HANDLE_SIZE) < 0;
+  }
+
+  size_t size_;
+  size_t offset_;
+  int pid_;
+  char handle_[IHIP_IPC_MEM_HANDLE_SIZE];
+};
+
+/// Reference counted cache of the attached IPC memory handles on a device.
+/// Repeated opens of the same handle share one mapping. The last close parks the mapping
+/// on an idle LRU list, which is bounded by the entries and bytes budget, and the real
+/// detach is deferred until an eviction or Trim(). An idle mapping keeps the exported
+/// memory alive after the exporter frees it, hence it expires after the idle time limit
+/// on the next open or close
+class IpcMemCache : public amd::HeapObject {
+public:
+  /// Attach/detach backend. The device backend goes to ROCclr, tests can provide a stub
+  class Backend : public amd::HeapObject {
+  public:
+    virtual ~Backend() {}
+    /// Maps the exported memory into the process address space
+    virtual bool Attach(const ihipIpcMemHandle_t& handle, unsigned int flags,
+                        void** dev_ptr) = 0;
+    /// Unmaps the memory, the backend is responsible for the GPU idle state
+    virtual bool Detach(void* dev_ptr) = 0;
+    /// Returns the current time in ns for the idle time limit
+    virtual uint64_t Now() { return amd::Os::timeNanos(); }
+  };
+
+  IpcMemCache(Backend* backend, size_t max_idle_entries, size_t max_idle_bytes,
+              uint64_t max_idle_ns)
+    : lock_("IPC memory cache lock", true), backend_(backend),
+      max_idle_entries_(max_idle_entries), max_idle_bytes_(max_idle_bytes),
+      max_idle_ns_(max_idle_ns) {}
+  /// Detaches all mappings, including the ones still open
+  ~IpcMemCache();
+
+  /// Returns the mapping of the handle, attaches it on the first open
+  bool Open(const ihipIpcMemHandle_t& handle, unsigned int flags, void** dev_ptr);
+
+  /// Drops a reference. Returns false if the pointer wasn't opened through the cache
+  bool Close(void* dev_ptr);
+
+  /// Detaches all idle mappings
+  void Trim();
+
+  /// Number of attached mappings, including the idle ones
+  size_t Size() const { return entries_.size(); }
+
+  /// Number of idle mappings, kept alive for reuse
+  size_t IdleSize() const { return idle_.size(); }
+
+private:
+  struct Entry {
+    void* dev_ptr_;                           //!< Mapped address
+    uint32_t refs_;                           //!< Number of outstanding opens
+    std::list<IpcMemKey>::iterator idle_it_;  //!< Position in the LRU list if idle
+    uint64_t idle_since_;                     //!< Time of the last close if idle
+  };
+
+  /// Detaches the least recently used idle mappings until the budget is met and
+  /// the expired ones
+  void Evict(size_t max_entries, size_t max_bytes);
+
+  amd::Monitor lock_;                                //!< Lock for the cache state
+  Backend* backend_;                                 //!< Attach/detach backend
+  std::map<IpcMemKey, Entry> entries_;               //!< Attached mappings
+  std::unordered_map<void*, IpcMemKey> ptr_to_key_;  //!< Reverse lookup for close
+  std::list<IpcMemKey> idle_;                        //!< Idle mappings, the front is the newest
+  size_t idle_bytes_ = 0;                            //!< Size of all idle mappings
+  size_t max_idle_entries_;                          //!< Max number of idle mappings
+  size_t max_idle_bytes_;                            //!< Max size of idle mappings
+  uint64_t max_idle_ns_;                             //!< Max idle time of a mapping
+};
+
+/// Creates the IPC memory cache for the device with the device attach backend.
+/// Defined next to the IPC memory API
+IpcMemCache* CreateIpcMemCache(hip::Device* device);
+
+}  // namespace hip
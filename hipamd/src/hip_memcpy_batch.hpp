@@ -0,0 +1,112 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace hip {
+
+/// Copy direction classes of a batch. The batch is issued in this order
+enum class MemcpyBatchGroup : uint32_t {
+  HostToHost = 0,
+  DeviceToDevice,
+  HostToDevice,
+  DeviceToHost,
+  PeerToPeer
+};
+
+/// Where a copy source or destination lives
+struct MemcpyBatchEndpoint {
+  bool host_;           //!< Host memory, pinned or not
+  const void* device_;  //!< Device of the runtime allocation
+  bool shared_;         //!< The allocation is visible to all devices
+};
+
+/// Returns the group of a copy. Pinned host memory belongs to the host side, a peer copy
+/// needs device memory of two different devices
+inline MemcpyBatchGroup ClassifyMemcpyBatchCopy(const MemcpyBatchEndpoint& src,
+                                                const MemcpyBatchEndpoint& dst) {
+  if (src.host_ && dst.host_) {
+    return MemcpyBatchGroup::HostToHost;
+  } else if (src.host_) {
+    return MemcpyBatchGroup::HostToDevice;
+  } else if (dst.host_) {
+    return MemcpyBatchGroup::DeviceToHost;
+  } else if ((src.device_ != dst.device_) && !src.shared_ && !dst.shared_) {
+    return MemcpyBatchGroup::PeerToPeer;
+  }
+  return MemcpyBatchGroup::DeviceToDevice;
+}
+
+/// One copy of a batch. The memory objects are opaque for the planner and only identify
+/// the allocation, nullptr means unregistered host memory
+struct MemcpyBatchCopy {
+  MemcpyBatchGroup group_;
+  uint32_t kind_;        //!< Requested copy kind
+  const void* src_mem_;  //!< Source memory object
+  const void* dst_mem_;  //!< Destination memory object
+  const char* src_;      //!< Source address
+  char* dst_;            //!< Destination address
+  size_t size_;          //!< Size of the copy in bytes
+  size_t index_;         //!< Index of the first batch entry covered by the copy
+  size_t start_;         //!< Index of the batch entry, at which the addresses of the copy start
+
+  /// Both sides are unregistered host memory, the host copies it
+  bool IsHostCopy() const { return (src_mem_ == nullptr) && (dst_mem_ == nullptr); }
+  /// Unregistered host memory can't be accessed after return, so the host waits for the copy
+  bool NeedsHostWait() const { return (src_mem_ == nullptr) || (dst_mem_ == nullptr); }
+};
+
+/// Orders the copies by group and allocation and merges the copies, which are contiguous
+/// in both the source and the destination, into a single copy
+inline void PlanMemcpyBatch(std::vector<MemcpyBatchCopy>& copies) {
+  if (copies.size() < 2) {
+    return;
+  }
+  auto key = [](const MemcpyBatchCopy& c) {
+    return std::make_tuple(c.group_, c.kind_, c.src_mem_, c.dst_mem_, c.src_, c.dst_);
+  };
+  std::stable_sort(copies.begin(), copies.end(),
+                   [&key](const MemcpyBatchCopy& a, const MemcpyBatchCopy& b) {
+                     return key(a) < key(b);
+                   });
+  size_t last = 0;
+  for (size_t i = 1; i < copies.size(); ++i) {
+    MemcpyBatchCopy& prev = copies[last];
+    const MemcpyBatchCopy& cur = copies[i];
+    if ((cur.group_ == prev.group_) && (cur.kind_ == prev.kind_) &&
+        (cur.src_mem_ == prev.src_mem_) &&
+        (cur.dst_mem_ == prev.dst_mem_) && (cur.src_ == prev.src_ + prev.size_) &&
+        (cur.dst_ == prev.dst_ + prev.size_)) {
+      prev.size_ += cur.size_;
+      prev.index_ = std::min(prev.index_, cur.index_);
+    } else {
+      copies[++last] = cur;
+    }
+  }
+  copies.resize(last + 1);
+}
+
+}  // namespace hip
@@ -0,0 +1,49 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <hip/hip_runtime_api.h>
+#include "CL/cl.h"
+
+namespace hip {
+
+/// Runtime allocations the copy paths access as host memory: fine grain SVM and registered
+/// host memory
+inline bool IsHostAccessMemory(cl_mem_flags flags) {
+  return ((CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_USE_HOST_PTR) & flags) != 0;
+}
+
+/// Returns the memory type a 2D/3D copy uses for one side. A unified pointer takes the type of
+/// its allocation, or host if the runtime doesn't know it. Host memory the runtime knows is
+/// already pinned, so it is copied as device memory to avoid pinning it again
+inline hipMemoryType ResolveMemcpyMemoryType(hipMemoryType declared, bool found,
+                                             hipMemoryType allocType) {
+  hipMemoryType type = declared;
+  if (type == hipMemoryTypeUnified) {
+    type = found ? allocType : hipMemoryTypeHost;
+  }
+  if ((type == hipMemoryTypeHost) && found) {
+    type = hipMemoryTypeDevice;
+  }
+  return type;
+}
+
+}  // namespace hip
@@ -18,10 +18,17 @@
  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  THE SOFTWARE. */
 
+#include <limits>
+#include <unordered_set>
+
 #include <hip/hip_runtime.h>
 #include "hip_internal.hpp"
 #include "hip_platform.hpp"
 #include "hip_conversions.hpp"
+#include "hip_ipc_cache.hpp"
+#include "hip_host_cache.hpp"
+#include "hip_memcpy_batch.hpp"
+#include "hip_memcpy_type.hpp"
 #include "platform/context.hpp"
 #include "platform/command.hpp"
 #include "platform/memory.hpp"
@@ -42,6 +49,19 @@ amd::Memory* getMemoryObject(const void* ptr, size_t& offset, size_t size) {
   return memObj;
 }
 
+// ================================================================================================
+ResolvedPtr::ResolvedPtr(const void* ptr) : ptr_(ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  memory_ = getMemoryObject(ptr, offset_);
+  if (memory_ != nullptr) {
+    device_ = memory_->GetDeviceById();
+    flags_ = memory_->getMemFlags();
+    type_ = IsHostAccessMemory(flags_) ? hipMemoryTypeHost : hipMemoryTypeDevice;
+  }
+}
+
 // ================================================================================================
 amd::Memory* getMemoryObjectWithOffset(const void* ptr, const size_t size) {
   size_t offset = 0;
@@ -76,6 +96,10 @@ hipError_t ihipFree(void *ptr) {
   if (memory_object != nullptr) {
     // Wait on the device, associated with the current memory object during allocation
     auto device_id = memory_object->getUserData().deviceId;
+    // The cached pinned host memory goes back to the cache without a wait
+    if (g_devices[device_id]->GetHostMemCache()->Free(ptr)) {
+      return hipSuccess;
+    }
     g_devices[device_id]->SyncAllStreams();
 
     // Find out if memory belongs to any memory pool
@@ -378,7 +402,8 @@ hipError_t ihipHostMalloc(void** ptr, size_t sizeBytes, unsigned int flags)
     ihipFlags &= ~CL_MEM_SVM_ATOMICS;
   }
 
-  hipError_t status = ihipMalloc(ptr, sizeBytes, ihipFlags);
+  // The cache keys on the ROCclr flags, so the coherence and the NUMA policy always match
+  hipError_t status = hip::getCurrentDevice()->GetHostMemCache()->Alloc(sizeBytes, ihipFlags, ptr);
 
   if ((status == hipSuccess) && ((*ptr) != nullptr)) {
     size_t offset = 0; // This is ignored
@@ -391,12 +416,8 @@ hipError_t ihipHostMalloc(void** ptr, size_t sizeBytes, unsigned int flags)
 }
 
 // ================================================================================================
-bool IsHtoHMemcpyValid(void* dst, const void* src, hipMemcpyKind kind) {
-  size_t sOffset = 0;
-  amd::Memory* srcMemory = getMemoryObject(src, sOffset);
-  size_t dOffset = 0;
-  amd::Memory* dstMemory = getMemoryObject(dst, dOffset);
-  if (src && dst && srcMemory == nullptr && dstMemory == nullptr) {
+bool IsHtoHMemcpyValid(const ResolvedPtr& dst, const ResolvedPtr& src, hipMemcpyKind kind) {
+  if (src.ptr_ && dst.ptr_ && src.memory_ == nullptr && dst.memory_ == nullptr) {
     if (!g_devices[0]->devices()[0]->info().hmmCpuMemoryAccessible_ &&
          kind != hipMemcpyHostToHost && kind != hipMemcpyDefault) {
       return false;
@@ -406,18 +427,23 @@ bool IsHtoHMemcpyValid(void* dst, const void* src, hipMemcpyKind kind) {
 }
 
 // ================================================================================================
-hipError_t ihipMemcpy_validate(void* dst, const void* src, size_t sizeBytes,
-                                      hipMemcpyKind kind) {
-  if (dst == nullptr || src == nullptr) {
+bool IsHtoHMemcpyValid(void* dst, const void* src, hipMemcpyKind kind) {
+  return IsHtoHMemcpyValid(ResolvedPtr(dst), ResolvedPtr(src), kind);
+}
+
+// ================================================================================================
+hipError_t ihipMemcpy_validate(const ResolvedPtr& dst, const ResolvedPtr& src,
+                               size_t sizeBytes, hipMemcpyKind kind) {
+  if (dst.ptr_ == nullptr || src.ptr_ == nullptr) {
     return hipErrorInvalidValue;
   }
   if (static_cast<uint32_t>(kind) > hipMemcpyDefault && kind != hipMemcpyDeviceToDeviceNoCU) {
     return hipErrorInvalidMemcpyDirection;
   }
-  size_t sOffset = 0;
-  amd::Memory* srcMemory = getMemoryObject(src, sOffset);
-  size_t dOffset = 0;
-  amd::Memory* dstMemory = getMemoryObject(dst, dOffset);
+  amd::Memory* srcMemory = src.memory_;
+  size_t sOffset = src.offset_;
+  amd::Memory* dstMemory = dst.memory_;
+  size_t dOffset = dst.offset_;
 
   if (srcMemory != nullptr) {
     // Validate Mem Access in case of VMM Memory
@@ -463,13 +489,23 @@ hipError_t ihipMemcpy_validate(void* dst, const void* src, size_t sizeBytes,
 }
 
 // ================================================================================================
-hipError_t ihipMemcpyCommand(amd::Command*& command, void* dst, const void* src, size_t sizeBytes,
-                             hipMemcpyKind kind, hip::Stream& stream, bool isAsync) {
+hipError_t ihipMemcpy_validate(void* dst, const void* src, size_t sizeBytes,
+                                      hipMemcpyKind kind) {
+  if (dst == nullptr || src == nullptr) {
+    return hipErrorInvalidValue;
+  }
+  return ihipMemcpy_validate(ResolvedPtr(dst), ResolvedPtr(src), sizeBytes, kind);
+}
+
+// ================================================================================================
+hipError_t ihipMemcpyCommand(amd::Command*& command, const ResolvedPtr& dst,
+                             const ResolvedPtr& src, size_t sizeBytes, hipMemcpyKind kind,
+                             hip::Stream& stream, bool isAsync) {
   amd::Command::EventWaitList waitList;
-  size_t sOffset = 0;
-  amd::Memory* srcMemory = getMemoryObject(src, sOffset);
-  size_t dOffset = 0;
-  amd::Memory* dstMemory = getMemoryObject(dst, dOffset);
+  amd::Memory* srcMemory = src.memory_;
+  size_t sOffset = src.offset_;
+  amd::Memory* dstMemory = dst.memory_;
+  size_t dOffset = dst.offset_;
   amd::Device* queueDevice = &stream.device();
   amd::CopyMetadata copyMetadata(isAsync, amd::CopyMetadata::CopyEnginePreference::NONE);
   if ((srcMemory == nullptr) && (dstMemory != nullptr)) {
@@ -482,7 +518,7 @@ hipError_t ihipMemcpyCommand(amd::Command*& command, void* dst, const void* src,
       }
     }
     command = new amd::WriteMemoryCommand(*pStream, CL_COMMAND_WRITE_BUFFER, waitList,
-              *dstMemory->asBuffer(), dOffset, sizeBytes, src, 0, 0, copyMetadata);
+              *dstMemory->asBuffer(), dOffset, sizeBytes, src.ptr_, 0, 0, copyMetadata);
   } else if ((srcMemory != nullptr) && (dstMemory == nullptr)) {
     hip::Stream* pStream = &stream;
     if (queueDevice != srcMemory->GetDeviceById()) {
@@ -493,7 +529,8 @@ hipError_t ihipMemcpyCommand(amd::Command*& command, void* dst, const void* src,
       }
     }
     command = new amd::ReadMemoryCommand(*pStream, CL_COMMAND_READ_BUFFER, waitList,
-              *srcMemory->asBuffer(), sOffset, sizeBytes, dst, 0, 0, copyMetadata);
+              *srcMemory->asBuffer(), sOffset, sizeBytes, const_cast<void*>(dst.ptr_), 0, 0,
+              copyMetadata);
   } else if ((srcMemory != nullptr) && (dstMemory != nullptr)) {
     // Check if the queue device doesn't match the device on any memory object.
     // And any of them are not host allocation.
@@ -557,15 +594,22 @@ hipError_t ihipMemcpyCommand(amd::Command*& command, void* dst, const void* src,
   }
   return hipSuccess;
 }
+
+// ================================================================================================
+hipError_t ihipMemcpyCommand(amd::Command*& command, void* dst, const void* src, size_t sizeBytes,
+                             hipMemcpyKind kind, hip::Stream& stream, bool isAsync) {
+  return ihipMemcpyCommand(command, ResolvedPtr(dst), ResolvedPtr(src), sizeBytes, kind, stream,
+                           isAsync);
+}
+
+// ================================================================================================
+bool IsHtoHMemcpy(const ResolvedPtr& dst, const ResolvedPtr& src) {
+  return (src.memory_ == nullptr) && (dst.memory_ == nullptr);
+}
+
+// ================================================================================================
 bool IsHtoHMemcpy(void* dst, const void* src) {
-  size_t sOffset = 0;
-  amd::Memory* srcMemory = getMemoryObject(src, sOffset);
-  size_t dOffset = 0;
-  amd::Memory* dstMemory = getMemoryObject(dst, dOffset);
-  if (srcMemory == nullptr && dstMemory == nullptr) {
-    return true;
-  }
-  return false;
+  return IsHtoHMemcpy(ResolvedPtr(dst), ResolvedPtr(src));
 }
 
 // ================================================================================================
@@ -582,37 +626,34 @@ hipError_t ihipMemcpy(void* dst, const void* src, size_t sizeBytes, hipMemcpyKin
     // Skip if nothing needs writing.
     return hipSuccess;
   }
-  status = ihipMemcpy_validate(dst, src, sizeBytes, kind);
+  // Resolve both pointers once, validation and command construction reuse the result
+  const ResolvedPtr dstPtr(dst);
+  const ResolvedPtr srcPtr(src);
+  status = ihipMemcpy_validate(dstPtr, srcPtr, sizeBytes, kind);
   if (status != hipSuccess) {
     return status;
   }
   if (src == dst && kind == hipMemcpyDefault) {
     return hipSuccess;
   }
-  size_t sOffset = 0;
-  amd::Memory* srcMemory = getMemoryObject(src, sOffset);
-  size_t dOffset = 0;
-  amd::Memory* dstMemory = getMemoryObject(dst, dOffset);
+  amd::Memory* srcMemory = srcPtr.memory_;
+  amd::Memory* dstMemory = dstPtr.memory_;
   if (srcMemory == nullptr && dstMemory == nullptr) {
     ihipHtoHMemcpy(dst, src, sizeBytes, stream);
     return hipSuccess;
   } else if (((srcMemory == nullptr) && (dstMemory != nullptr)) ||
              ((srcMemory != nullptr) && (dstMemory == nullptr))) {
     isHostAsync = false;
-  } else if (srcMemory->GetDeviceById() == dstMemory->GetDeviceById()) {
-    hipMemoryType srcMemoryType = ((CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_USE_HOST_PTR) &
-        srcMemory->getMemFlags())? hipMemoryTypeHost : hipMemoryTypeDevice;
-    hipMemoryType dstMemoryType = ((CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_USE_HOST_PTR) &
-        dstMemory->getMemFlags())? hipMemoryTypeHost : hipMemoryTypeDevice;
+  } else if (srcPtr.device_ == dstPtr.device_) {
     // Device to Device copies do not need to host side synchronization.
-    if ((srcMemoryType == hipMemoryTypeDevice) && (dstMemoryType == hipMemoryTypeDevice) &&
+    if ((srcPtr.type_ == hipMemoryTypeDevice) && (dstPtr.type_ == hipMemoryTypeDevice) &&
         (!srcMemory->getUserData().sync_mem_ops_ || !dstMemory->getUserData().sync_mem_ops_)) {
       isHostAsync = true;
     }
   }
 
   amd::Command* command = nullptr;
-  status = ihipMemcpyCommand(command, dst, src, sizeBytes, kind, stream, isHostAsync);
+  status = ihipMemcpyCommand(command, dstPtr, srcPtr, sizeBytes, kind, stream, isHostAsync);
   if (status != hipSuccess) {
     return status;
   }
@@ -620,7 +661,7 @@ hipError_t ihipMemcpy(void* dst, const void* src, size_t sizeBytes, hipMemcpyKin
   if (!isHostAsync) {
     command->queue()->finish();
   } else if (!isGPUAsync) {
-    hip::Stream* pStream = hip::getNullStream(dstMemory->GetDeviceById()->context());
+    hip::Stream* pStream = hip::getNullStream(dstPtr.device_->context());
     amd::Command::EventWaitList waitList;
     waitList.push_back(command);
     amd::Command* depdentMarker = new amd::Marker(*pStream, false, waitList);
@@ -766,7 +807,12 @@ hipError_t hipMemPtrGetInfo(void *ptr, size_t *size) {
     HIP_RETURN(hipErrorInvalidValue);
   }
 
-  *size = svmMem->getSize();
+  // A cached pinned host allocation is rounded up to its size class, report the requested size
+  auto device_id = svmMem->getUserData().deviceId;
+  void* base = (svmMem->getSvmPtr() != nullptr) ? svmMem->getSvmPtr() : ptr;
+  if (!g_devices[device_id]->GetHostMemCache()->GetSize(base, size)) {
+    *size = svmMem->getSize();
+  }
 
   HIP_RETURN(hipSuccess);
 }
@@ -784,6 +830,32 @@ hipError_t hipHostFree(void* ptr) {
   HIP_RETURN(ihipFree(ptr));
 }
 
+hipError_t hipExtHostMemCacheGetStats(int device, hipExtHostMemCacheStats* stats) {
+  HIP_INIT_API(hipExtHostMemCacheGetStats, device, stats);
+
+  if (device < 0 || static_cast<size_t>(device) >= g_devices.size()) {
+    HIP_RETURN(hipErrorInvalidDevice);
+  }
+
+  if (stats == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+
+  g_devices[device]->GetHostMemCache()->GetStats(stats);
+  HIP_RETURN(hipSuccess);
+}
+
+hipError_t hipExtHostMemCacheTrim(int device, size_t minBytesToKeep) {
+  HIP_INIT_API(hipExtHostMemCacheTrim, device, minBytesToKeep);
+
+  if (device < 0 || static_cast<size_t>(device) >= g_devices.size()) {
+    HIP_RETURN(hipErrorInvalidDevice);
+  }
+
+  g_devices[device]->GetHostMemCache()->Trim(minBytesToKeep);
+  HIP_RETURN(hipSuccess);
+}
+
 hipError_t ihipArrayDestroy(hipArray_t array) {
   if (array == nullptr) {
     return hipErrorInvalidValue;
@@ -861,6 +933,27 @@ hipError_t hipMemGetInfo(size_t* free, size_t* total) {
   HIP_RETURN(hipSuccess);
 }
 
+// ================================================================================================
+hipError_t hipExtSetMemWatermarkCallback(int device, size_t lowFree, size_t highFree,
+                                         hipExtMemWatermarkCallback callback, void* userData) {
+  HIP_INIT_API(hipExtSetMemWatermarkCallback, device, lowFree, highFree, callback, userData);
+
+  if (device < 0 || static_cast<size_t>(device) >= g_devices.size()) {
+    HIP_RETURN(hipErrorInvalidDevice);
+  }
+  if (lowFree > highFree) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  amd::device::MemoryAccounting* accounting =
+      g_devices[device]->devices()[0]->memoryAccounting();
+  if (accounting == nullptr) {
+    HIP_RETURN(hipErrorNotSupported);
+  }
+  accounting->setWatermarks(lowFree, highFree, callback, userData);
+
+  HIP_RETURN(hipSuccess);
+}
+
 hipError_t ihipMallocPitch(void** ptr, size_t* pitch, size_t width, size_t height, size_t depth) {
 
   amd::Device* device = hip::getCurrentDevice()->devices()[0];
@@ -1578,6 +1671,211 @@ hipError_t hipMemcpyAsync_spt(void* dst, const void* src, size_t sizeBytes,
   HIP_RETURN_DURATION(hipMemcpyAsync_common(dst, src, sizeBytes, kind, stream));
 }
 
+// ================================================================================================
+static hipError_t ihipMemcpyBatch_validate(void** dsts, void** srcs, size_t* sizes, size_t count,
+                                          hipMemcpyAttributes* attrs, size_t* attrsIdxs,
+                                          size_t numAttrs) {
+  if (dsts == nullptr || srcs == nullptr || sizes == nullptr || count == 0 ||
+      attrs == nullptr || attrsIdxs == nullptr || numAttrs == 0 || numAttrs > count ||
+      attrsIdxs[0] != 0) {
+    return hipErrorInvalidValue;
+  }
+  for (size_t i = 0; i < numAttrs; ++i) {
+    if ((i > 0) && ((attrsIdxs[i] <= attrsIdxs[i - 1]) || (attrsIdxs[i] >= count))) {
+      return hipErrorInvalidValue;
+    }
+    if (attrs[i].flags != 0) {
+      return hipErrorInvalidValue;
+    }
+    if (static_cast<uint32_t>(attrs[i].kind) > hipMemcpyDefault &&
+        attrs[i].kind != hipMemcpyDeviceToDeviceNoCU) {
+      return hipErrorInvalidMemcpyDirection;
+    }
+  }
+  return hipSuccess;
+}
+
+// ================================================================================================
+hipError_t ihipMemcpyBatchAsync(void** dsts, void** srcs, size_t* sizes, size_t count,
+                                hipMemcpyAttributes* attrs, size_t* attrsIdxs, size_t numAttrs,
+                                size_t* failIdx, hipStream_t stream) {
+  if (!hip::isValid(stream)) {
+    return hipErrorContextIsDestroyed;
+  }
+  hip::Stream* hip_stream = hip::getStream(stream);
+  if (hip_stream == nullptr) {
+    return hipErrorInvalidValue;
+  }
+
+  // Validate all entries and classify them, before anything is enqueued
+  hipError_t status = hipSuccess;
+  std::vector<hip::MemcpyBatchCopy> copies;
+  copies.reserve(count);
+  // The resolved destination and source of every entry, the commands reuse them
+  std::vector<std::pair<ResolvedPtr, ResolvedPtr>> resolved(count);
+  size_t attr = 0;
+  auto endpoint = [](const ResolvedPtr& ptr) {
+    return hip::MemcpyBatchEndpoint{ptr.type_ == hipMemoryTypeHost, ptr.device_,
+                                    (ptr.memory_ != nullptr) &&
+                                    (ptr.memory_->getContext().devices().size() != 1)};
+  };
+  for (size_t i = 0; i < count; ++i) {
+    if ((attr + 1 < numAttrs) && (i == attrsIdxs[attr + 1])) {
+      ++attr;
+    }
+    hipMemcpyKind kind = attrs[attr].kind;
+    if (sizes[i] == 0) {
+      continue;
+    }
+    resolved[i] = {ResolvedPtr(dsts[i]), ResolvedPtr(srcs[i])};
+    const ResolvedPtr& dstPtr = resolved[i].first;
+    const ResolvedPtr& srcPtr = resolved[i].second;
+    status = ihipMemcpy_validate(dstPtr, srcPtr, sizes[i], kind);
+    if (status != hipSuccess) {
+      if (failIdx != nullptr) {
+        *failIdx = i;
+      }
+      return status;
+    }
+    if (srcs[i] == dsts[i] && kind == hipMemcpyDefault) {
+      continue;
+    }
+    amd::Memory* srcMemory = srcPtr.memory_;
+    amd::Memory* dstMemory = dstPtr.memory_;
+    hip::MemcpyBatchGroup group = hip::ClassifyMemcpyBatchCopy(endpoint(srcPtr),
+                                                              endpoint(dstPtr));
+    copies.push_back({group, static_cast<uint32_t>(kind), srcMemory, dstMemory,
+                      reinterpret_cast<const char*>(srcs[i]), reinterpret_cast<char*>(dsts[i]),
+                      sizes[i], i, i});
+  }
+
+  // Group the copies by direction and memory, and merge the contiguous ones
+  hip::PlanMemcpyBatch(copies);
+
+  // Create all commands first, so a failure leaves nothing enqueued and no host copy done
+  std::vector<amd::Command*> commands(copies.size(), nullptr);
+  for (size_t i = 0; i < copies.size(); ++i) {
+    const auto& copy = copies[i];
+    if (copy.IsHostCopy()) {
+      continue;
+    }
+    // Unregistered host memory can't be accessed after return, as in the single copy.
+    // A merged copy starts at the addresses of its start entry, so its pointers are valid
+    const auto& ptrs = resolved[copy.start_];
+    status = ihipMemcpyCommand(commands[i], ptrs.first, ptrs.second, copy.size_,
+        static_cast<hipMemcpyKind>(copy.kind_), *hip_stream, !copy.NeedsHostWait());
+    if (status != hipSuccess) {
+      if (failIdx != nullptr) {
+        *failIdx = copy.index_;
+      }
+      for (auto command : commands) {
+        if (command != nullptr) {
+          command->release();
+        }
+      }
+      return status;
+    }
+  }
+
+  bool host_sync = false;
+  std::unordered_set<amd::HostQueue*> other_queues;  // Queues, other than the stream
+  std::unordered_set<amd::HostQueue*> wait_queues;   // Queues with unpinned host memory copies
+  for (size_t i = 0; i < copies.size(); ++i) {
+    const auto& copy = copies[i];
+    if (copy.IsHostCopy()) {
+      if (!host_sync) {
+        hip_stream->finish();
+        host_sync = true;
+      }
+      memcpy(copy.dst_, copy.src_, copy.size_);
+      continue;
+    }
+    amd::Command* command = commands[i];
+    command->enqueue();
+    if (command->queue() != hip_stream) {
+      other_queues.insert(command->queue());
+    }
+    if (copy.NeedsHostWait()) {
+      wait_queues.insert(command->queue());
+    }
+    command->release();
+  }
+
+  // A single dependency for each queue, which executed a part of the batch
+  for (auto queue : other_queues) {
+    amd::Command* cmd = queue->getLastQueuedCommand(true);
+    if (cmd == nullptr) {
+      continue;
+    }
+    amd::Command::EventWaitList waitList;
+    waitList.push_back(cmd);
+    amd::Command* depdentMarker = new amd::Marker(*hip_stream, true, waitList);
+    if (depdentMarker != nullptr) {
+      depdentMarker->enqueue();
+      depdentMarker->release();
+    }
+    cmd->release();
+  }
+  // A single CPU wait for all unpinned host memory copies
+  for (auto queue : wait_queues) {
+    queue->finish();
+  }
+  return hipSuccess;
+}
+
+// ================================================================================================
+hipError_t hipMemcpyBatchAsync(void** dsts, void** srcs, size_t* sizes, size_t count,
+                               hipMemcpyAttributes* attrs, size_t* attrsIdxs, size_t numAttrs,
+                               size_t* failIdx, hipStream_t stream) {
+  HIP_INIT_API(hipMemcpyBatchAsync, dsts, srcs, sizes, count, attrs, attrsIdxs, numAttrs,
+               failIdx, stream);
+  if (failIdx != nullptr) {
+    *failIdx = std::numeric_limits<size_t>::max();
+  }
+  hipError_t status = ihipMemcpyBatch_validate(dsts, srcs, sizes, count, attrs, attrsIdxs,
+                                               numAttrs);
+  if (status != hipSuccess) {
+    HIP_RETURN(status);
+  }
+  hip::getStreamPerThread(stream);
+  if (stream != nullptr && stream != hipStreamLegacy &&
+      reinterpret_cast<hip::Stream*>(stream)->GetCaptureStatus() != hipStreamCaptureStatusNone) {
+    // Captured batches become regular memcpy nodes. Validate all entries first, so
+    // an invalid entry doesn't leave the earlier ones in the graph
+    auto kindOf = [&](size_t i) {
+      size_t attr = 0;
+      while ((attr + 1 < numAttrs) && (attrsIdxs[attr + 1] <= i)) {
+        ++attr;
+      }
+      return attrs[attr].kind;
+    };
+    for (size_t i = 0; i < count; ++i) {
+      if (sizes[i] == 0) {
+        continue;
+      }
+      status = ihipMemcpy_validate(dsts[i], srcs[i], sizes[i], kindOf(i));
+      if (status != hipSuccess) {
+        if (failIdx != nullptr) {
+          *failIdx = i;
+        }
+        HIP_RETURN(status);
+      }
+    }
+    for (size_t i = 0; i < count; ++i) {
+      status = hipMemcpyAsync_common(dsts[i], srcs[i], sizes[i], kindOf(i), stream);
+      if (status != hipSuccess) {
+        if (failIdx != nullptr) {
+          *failIdx = i;
+        }
+        HIP_RETURN(status);
+      }
+    }
+    HIP_RETURN(hipSuccess);
+  }
+  HIP_RETURN_DURATION(ihipMemcpyBatchAsync(dsts, srcs, sizes, count, attrs, attrsIdxs, numAttrs,
+                                           failIdx, stream));
+}
+
 hipError_t hipMemcpyHtoDAsync(hipDeviceptr_t dstDevice, void* srcHost, size_t ByteCount,
                               hipStream_t stream) {
   HIP_INIT_API(hipMemcpyHtoDAsync, dstDevice, srcHost, ByteCount, stream);
@@ -1635,13 +1933,14 @@ hipError_t hipMemcpyDtoHAsync(void* dstHost, hipDeviceptr_t srcDevice, size_t By
       ihipMemcpy(dstHost, srcDevice, ByteCount, kind, *hip_stream, true));
 }
 
-hipError_t ihipMemcpyAtoDValidate(hipArray_t srcArray, void* dstDevice, amd::Coord3D& srcOrigin,
-                                  amd::Coord3D& dstOrigin, amd::Coord3D& copyRegion,
-                                  size_t dstRowPitch, size_t dstSlicePitch,
-                                  amd::Memory*& dstMemory, amd::Image*& srcImage,
-                                  amd::BufferRect& srcRect, amd::BufferRect& dstRect) {
-  size_t dstOffset = 0;
-  dstMemory = getMemoryObject(dstDevice, dstOffset);
+hipError_t ihipMemcpyAtoDValidate(hipArray_t srcArray, const ResolvedPtr& dst,
+                                  amd::Coord3D& srcOrigin, amd::Coord3D& dstOrigin,
+                                  amd::Coord3D& copyRegion, size_t dstRowPitch,
+                                  size_t dstSlicePitch, amd::Memory*& dstMemory,
+                                  amd::Image*& srcImage, amd::BufferRect& srcRect,
+                                  amd::BufferRect& dstRect) {
+  size_t dstOffset = dst.offset_;
+  dstMemory = dst.memory_;
   if (srcArray == nullptr || (dstMemory == nullptr)) {
     return hipErrorInvalidValue;
   }
@@ -1682,16 +1981,26 @@ hipError_t ihipMemcpyAtoDValidate(hipArray_t srcArray, void* dstDevice, amd::Coo
   return hipSuccess;
 }
 
-hipError_t ihipMemcpyAtoDCommand(amd::Command*& command, hipArray_t srcArray, void* dstDevice,
-                                 amd::Coord3D srcOrigin, amd::Coord3D dstOrigin,
-                                 amd::Coord3D copyRegion, size_t dstRowPitch, size_t dstSlicePitch,
-                                 hip::Stream* stream) {
+hipError_t ihipMemcpyAtoDValidate(hipArray_t srcArray, void* dstDevice, amd::Coord3D& srcOrigin,
+                                  amd::Coord3D& dstOrigin, amd::Coord3D& copyRegion,
+                                  size_t dstRowPitch, size_t dstSlicePitch,
+                                  amd::Memory*& dstMemory, amd::Image*& srcImage,
+                                  amd::BufferRect& srcRect, amd::BufferRect& dstRect) {
+  return ihipMemcpyAtoDValidate(srcArray, ResolvedPtr(dstDevice), srcOrigin, dstOrigin,
+                                copyRegion, dstRowPitch, dstSlicePitch, dstMemory, srcImage,
+                                srcRect, dstRect);
+}
+
+hipError_t ihipMemcpyAtoDCommand(amd::Command*& command, hipArray_t srcArray,
+                                 const ResolvedPtr& dst, amd::Coord3D srcOrigin,
+                                 amd::Coord3D dstOrigin, amd::Coord3D copyRegion,
+                                 size_t dstRowPitch, size_t dstSlicePitch, hip::Stream* stream) {
   amd::BufferRect srcRect;
   amd::BufferRect dstRect;
   amd::Memory* dstMemory;
   amd::Image* srcImage;
   hipError_t status =
-      ihipMemcpyAtoDValidate(srcArray, dstDevice, srcOrigin, dstOrigin, copyRegion, dstRowPitch,
+      ihipMemcpyAtoDValidate(srcArray, dst, srcOrigin, dstOrigin, copyRegion, dstRowPitch,
                              dstSlicePitch, dstMemory, srcImage, srcRect, dstRect);
   if (status != hipSuccess) {
     return status;
@@ -1713,13 +2022,14 @@ hipError_t ihipMemcpyAtoDCommand(amd::Command*& command, hipArray_t srcArray, vo
   return hipSuccess;
 }
 
-hipError_t ihipMemcpyDtoAValidate(void* srcDevice, hipArray_t dstArray, amd::Coord3D& srcOrigin,
-                                  amd::Coord3D& dstOrigin, amd::Coord3D& copyRegion,
-                                  size_t srcRowPitch, size_t srcSlicePitch, amd::Image*& dstImage,
+hipError_t ihipMemcpyDtoAValidate(const ResolvedPtr& src, hipArray_t dstArray,
+                                  amd::Coord3D& srcOrigin, amd::Coord3D& dstOrigin,
+                                  amd::Coord3D& copyRegion, size_t srcRowPitch,
+                                  size_t srcSlicePitch, amd::Image*& dstImage,
                                   amd::Memory*& srcMemory, amd::BufferRect& dstRect,
                                   amd::BufferRect& srcRect) {
-  size_t srcOffset = 0;
-  srcMemory = getMemoryObject(srcDevice, srcOffset);
+  size_t srcOffset = src.offset_;
+  srcMemory = src.memory_;
   if ((srcMemory == nullptr) || dstArray == nullptr) {
     return hipErrorInvalidValue;
   }
@@ -1759,16 +2069,26 @@ hipError_t ihipMemcpyDtoAValidate(void* srcDevice, hipArray_t dstArray, amd::Coo
   return hipSuccess;
 }
 
-hipError_t ihipMemcpyDtoACommand(amd::Command*& command, void* srcDevice, hipArray_t dstArray,
-                                 amd::Coord3D srcOrigin, amd::Coord3D dstOrigin,
-                                 amd::Coord3D copyRegion, size_t srcRowPitch, size_t srcSlicePitch,
-                                 hip::Stream* stream) {
+hipError_t ihipMemcpyDtoAValidate(void* srcDevice, hipArray_t dstArray, amd::Coord3D& srcOrigin,
+                                  amd::Coord3D& dstOrigin, amd::Coord3D& copyRegion,
+                                  size_t srcRowPitch, size_t srcSlicePitch, amd::Image*& dstImage,
+                                  amd::Memory*& srcMemory, amd::BufferRect& dstRect,
+                                  amd::BufferRect& srcRect) {
+  return ihipMemcpyDtoAValidate(ResolvedPtr(srcDevice), dstArray, srcOrigin, dstOrigin,
+                                copyRegion, srcRowPitch, srcSlicePitch, dstImage, srcMemory,
+                                dstRect, srcRect);
+}
+
+hipError_t ihipMemcpyDtoACommand(amd::Command*& command, const ResolvedPtr& src,
+                                 hipArray_t dstArray, amd::Coord3D srcOrigin,
+                                 amd::Coord3D dstOrigin, amd::Coord3D copyRegion,
+                                 size_t srcRowPitch, size_t srcSlicePitch, hip::Stream* stream) {
   amd::Image* dstImage;
   amd::Memory* srcMemory;
   amd::BufferRect dstRect;
   amd::BufferRect srcRect;
   hipError_t status =
-      ihipMemcpyDtoAValidate(srcDevice, dstArray, srcOrigin, dstOrigin, copyRegion, srcRowPitch,
+      ihipMemcpyDtoAValidate(src, dstArray, srcOrigin, dstOrigin, copyRegion, srcRowPitch,
                              srcSlicePitch, dstImage, srcMemory, dstRect, srcRect);
   if (status != hipSuccess) {
     return status;
@@ -1789,16 +2109,16 @@ hipError_t ihipMemcpyDtoACommand(amd::Command*& command, void* srcDevice, hipArr
   return hipSuccess;
 }
 
-hipError_t ihipMemcpyDtoDValidate(void* srcDevice, void* dstDevice, amd::Coord3D& srcOrigin,
-                                  amd::Coord3D& dstOrigin, amd::Coord3D& copyRegion,
-                                  size_t srcRowPitch, size_t srcSlicePitch, size_t dstRowPitch,
-                                  size_t dstSlicePitch, amd::Memory*& srcMemory,
-                                  amd::Memory*& dstMemory, amd::BufferRect& srcRect,
-                                  amd::BufferRect& dstRect) {
-  size_t srcOffset = 0;
-  srcMemory = getMemoryObject(srcDevice, srcOffset);
-  size_t dstOffset = 0;
-  dstMemory = getMemoryObject(dstDevice, dstOffset);
+hipError_t ihipMemcpyDtoDValidate(const ResolvedPtr& src, const ResolvedPtr& dst,
+                                  amd::Coord3D& srcOrigin, amd::Coord3D& dstOrigin,
+                                  amd::Coord3D& copyRegion, size_t srcRowPitch,
+                                  size_t srcSlicePitch, size_t dstRowPitch, size_t dstSlicePitch,
+                                  amd::Memory*& srcMemory, amd::Memory*& dstMemory,
+                                  amd::BufferRect& srcRect, amd::BufferRect& dstRect) {
+  size_t srcOffset = src.offset_;
+  srcMemory = src.memory_;
+  size_t dstOffset = dst.offset_;
+  dstMemory = dst.memory_;
 
   if ((srcMemory == nullptr) || (dstMemory == nullptr)) {
     return hipErrorInvalidValue;
@@ -1830,16 +2150,28 @@ hipError_t ihipMemcpyDtoDValidate(void* srcDevice, void* dstDevice, amd::Coord3D
   return hipSuccess;
 }
 
-hipError_t ihipMemcpyDtoDCommand(amd::Command*& command, void* srcDevice, void* dstDevice,
-                                 amd::Coord3D srcOrigin, amd::Coord3D dstOrigin,
-                                 amd::Coord3D copyRegion, size_t srcRowPitch, size_t srcSlicePitch,
-                                 size_t dstRowPitch, size_t dstSlicePitch, hip::Stream* stream) {
+hipError_t ihipMemcpyDtoDValidate(void* srcDevice, void* dstDevice, amd::Coord3D& srcOrigin,
+                                  amd::Coord3D& dstOrigin, amd::Coord3D& copyRegion,
+                                  size_t srcRowPitch, size_t srcSlicePitch, size_t dstRowPitch,
+                                  size_t dstSlicePitch, amd::Memory*& srcMemory,
+                                  amd::Memory*& dstMemory, amd::BufferRect& srcRect,
+                                  amd::BufferRect& dstRect) {
+  return ihipMemcpyDtoDValidate(ResolvedPtr(srcDevice), ResolvedPtr(dstDevice), srcOrigin,
+                                dstOrigin, copyRegion, srcRowPitch, srcSlicePitch, dstRowPitch,
+                                dstSlicePitch, srcMemory, dstMemory, srcRect, dstRect);
+}
+
+hipError_t ihipMemcpyDtoDCommand(amd::Command*& command, const ResolvedPtr& src,
+                                 const ResolvedPtr& dst, amd::Coord3D srcOrigin,
+                                 amd::Coord3D dstOrigin, amd::Coord3D copyRegion,
+                                 size_t srcRowPitch, size_t srcSlicePitch, size_t dstRowPitch,
+                                 size_t dstSlicePitch, hip::Stream* stream) {
   amd::Memory* srcMemory;
   amd::Memory* dstMemory;
   amd::BufferRect srcRect;
   amd::BufferRect dstRect;
 
-  hipError_t status = ihipMemcpyDtoDValidate(srcDevice, dstDevice, srcOrigin, dstOrigin, copyRegion,
+  hipError_t status = ihipMemcpyDtoDValidate(src, dst, srcOrigin, dstOrigin, copyRegion,
                                              srcRowPitch, srcSlicePitch, dstRowPitch, dstSlicePitch,
                                              srcMemory, dstMemory, srcRect, dstRect);
   if (status != hipSuccess) {
@@ -1863,13 +2195,14 @@ hipError_t ihipMemcpyDtoDCommand(amd::Command*& command, void* srcDevice, void*
   return hipSuccess;
 }
 
-hipError_t ihipMemcpyDtoHValidate(void* srcDevice, void* dstHost, amd::Coord3D& srcOrigin,
-                                  amd::Coord3D& dstOrigin, amd::Coord3D& copyRegion,
-                                  size_t srcRowPitch, size_t srcSlicePitch, size_t dstRowPitch,
-                                  size_t dstSlicePitch, amd::Memory*& srcMemory,
-                                  amd::BufferRect& srcRect, amd::BufferRect& dstRect) {
-  size_t srcOffset = 0;
-  srcMemory = getMemoryObject(srcDevice, srcOffset);
+hipError_t ihipMemcpyDtoHValidate(const ResolvedPtr& src, const void* dstHost,
+                                  amd::Coord3D& srcOrigin, amd::Coord3D& dstOrigin,
+                                  amd::Coord3D& copyRegion, size_t srcRowPitch,
+                                  size_t srcSlicePitch, size_t dstRowPitch, size_t dstSlicePitch,
+                                  amd::Memory*& srcMemory, amd::BufferRect& srcRect,
+                                  amd::BufferRect& dstRect) {
+  size_t srcOffset = src.offset_;
+  srcMemory = src.memory_;
 
   if ((srcMemory == nullptr) || (dstHost == nullptr)) {
     return hipErrorInvalidValue;
@@ -1894,18 +2227,28 @@ hipError_t ihipMemcpyDtoHValidate(void* srcDevice, void* dstHost, amd::Coord3D&
   return hipSuccess;
 }
 
-hipError_t ihipMemcpyDtoHCommand(amd::Command*& command, void* srcDevice, void* dstHost,
-                                 amd::Coord3D srcOrigin, amd::Coord3D dstOrigin,
-                                 amd::Coord3D copyRegion, size_t srcRowPitch, size_t srcSlicePitch,
-                                 size_t dstRowPitch, size_t dstSlicePitch, hip::Stream* stream,
+hipError_t ihipMemcpyDtoHValidate(void* srcDevice, void* dstHost, amd::Coord3D& srcOrigin,
+                                  amd::Coord3D& dstOrigin, amd::Coord3D& copyRegion,
+                                  size_t srcRowPitch, size_t srcSlicePitch, size_t dstRowPitch,
+                                  size_t dstSlicePitch, amd::Memory*& srcMemory,
+                                  amd::BufferRect& srcRect, amd::BufferRect& dstRect) {
+  return ihipMemcpyDtoHValidate(ResolvedPtr(srcDevice), dstHost, srcOrigin, dstOrigin,
+                                copyRegion, srcRowPitch, srcSlicePitch, dstRowPitch,
+                                dstSlicePitch, srcMemory, srcRect, dstRect);
+}
+
+hipError_t ihipMemcpyDtoHCommand(amd::Command*& command, const ResolvedPtr& src,
+                                 const ResolvedPtr& dst, amd::Coord3D srcOrigin,
+                                 amd::Coord3D dstOrigin, amd::Coord3D copyRegion,
+                                 size_t srcRowPitch, size_t srcSlicePitch, size_t dstRowPitch,
+                                 size_t dstSlicePitch, hip::Stream* stream,
                                  bool isAsync = false) {
   amd::Memory* srcMemory;
   amd::BufferRect srcRect;
   amd::BufferRect dstRect;
-  size_t dOffset = 0;
-  amd::Memory* dstMemory = getMemoryObject(dstHost, dOffset);
+  amd::Memory* dstMemory = dst.memory_;
 
-  hipError_t status = ihipMemcpyDtoHValidate(srcDevice, dstHost, srcOrigin, dstOrigin, copyRegion,
+  hipError_t status = ihipMemcpyDtoHValidate(src, dst.ptr_, srcOrigin, dstOrigin, copyRegion,
                                              srcRowPitch, srcSlicePitch, dstRowPitch, dstSlicePitch,
                                              srcMemory, srcRect, dstRect);
   if (status != hipSuccess) {
@@ -1926,8 +2269,8 @@ hipError_t ihipMemcpyDtoHCommand(amd::Command*& command, void* srcDevice, void*
   } else {
     amd::ReadMemoryCommand* readCommand =
       new amd::ReadMemoryCommand(*stream, CL_COMMAND_READ_BUFFER_RECT, amd::Command::EventWaitList{},
-                                 *srcMemory, srcStart, copyRegion, dstHost, srcRect, dstRect,
-                                 copyMetadata);
+                                 *srcMemory, srcStart, copyRegion, const_cast<void*>(dst.ptr_),
+                                 srcRect, dstRect, copyMetadata);
     if (readCommand == nullptr) {
       return hipErrorOutOfMemory;
     }
@@ -1942,13 +2285,14 @@ hipError_t ihipMemcpyDtoHCommand(amd::Command*& command, void* srcDevice, void*
   return hipSuccess;
 }
 
-hipError_t ihipMemcpyHtoDValidate(const void* srcHost, void* dstDevice, amd::Coord3D& srcOrigin,
-                                  amd::Coord3D& dstOrigin, amd::Coord3D& copyRegion,
-                                  size_t srcRowPitch, size_t srcSlicePitch, size_t dstRowPitch,
-                                  size_t dstSlicePitch, amd::Memory*& dstMemory,
-                                  amd::BufferRect& srcRect, amd::BufferRect& dstRect) {
-  size_t dstOffset = 0;
-  dstMemory = getMemoryObject(dstDevice, dstOffset);
+hipError_t ihipMemcpyHtoDValidate(const void* srcHost, const ResolvedPtr& dst,
+                                  amd::Coord3D& srcOrigin, amd::Coord3D& dstOrigin,
+                                  amd::Coord3D& copyRegion, size_t srcRowPitch,
+                                  size_t srcSlicePitch, size_t dstRowPitch, size_t dstSlicePitch,
+                                  amd::Memory*& dstMemory, amd::BufferRect& srcRect,
+                                  amd::BufferRect& dstRect) {
+  size_t dstOffset = dst.offset_;
+  dstMemory = dst.memory_;
 
   if ((srcHost == nullptr) || (dstMemory == nullptr)) {
     return hipErrorInvalidValue;
@@ -1973,18 +2317,28 @@ hipError_t ihipMemcpyHtoDValidate(const void* srcHost, void* dstDevice, amd::Coo
   return hipSuccess;
 }
 
-hipError_t ihipMemcpyHtoDCommand(amd::Command*& command, const void* srcHost, void* dstDevice,
-                                 amd::Coord3D srcOrigin, amd::Coord3D dstOrigin,
-                                 amd::Coord3D copyRegion, size_t srcRowPitch, size_t srcSlicePitch,
-                                 size_t dstRowPitch, size_t dstSlicePitch, hip::Stream* stream,
+hipError_t ihipMemcpyHtoDValidate(const void* srcHost, void* dstDevice, amd::Coord3D& srcOrigin,
+                                  amd::Coord3D& dstOrigin, amd::Coord3D& copyRegion,
+                                  size_t srcRowPitch, size_t srcSlicePitch, size_t dstRowPitch,
+                                  size_t dstSlicePitch, amd::Memory*& dstMemory,
+                                  amd::BufferRect& srcRect, amd::BufferRect& dstRect) {
+  return ihipMemcpyHtoDValidate(srcHost, ResolvedPtr(dstDevice), srcOrigin, dstOrigin,
+                                copyRegion, srcRowPitch, srcSlicePitch, dstRowPitch,
+                                dstSlicePitch, dstMemory, srcRect, dstRect);
+}
+
+hipError_t ihipMemcpyHtoDCommand(amd::Command*& command, const ResolvedPtr& src,
+                                 const ResolvedPtr& dst, amd::Coord3D srcOrigin,
+                                 amd::Coord3D dstOrigin, amd::Coord3D copyRegion,
+                                 size_t srcRowPitch, size_t srcSlicePitch, size_t dstRowPitch,
+                                 size_t dstSlicePitch, hip::Stream* stream,
                                  bool isAsync = false) {
   amd::Memory* dstMemory;
   amd::BufferRect srcRect;
   amd::BufferRect dstRect;
-  size_t sOffset = 0;
-  amd::Memory* srcMemory = getMemoryObject(srcHost, sOffset);
+  amd::Memory* srcMemory = src.memory_;
 
-  hipError_t status = ihipMemcpyHtoDValidate(srcHost, dstDevice, srcOrigin, dstOrigin, copyRegion,
+  hipError_t status = ihipMemcpyHtoDValidate(src.ptr_, dst, srcOrigin, dstOrigin, copyRegion,
                                              srcRowPitch, srcSlicePitch, dstRowPitch, dstSlicePitch,
                                              dstMemory, srcRect, dstRect);
   if (status != hipSuccess) {
@@ -2005,7 +2359,7 @@ hipError_t ihipMemcpyHtoDCommand(amd::Command*& command, const void* srcHost, vo
   } else {
     amd::WriteMemoryCommand *writeCommand = new amd::WriteMemoryCommand(
       *stream, CL_COMMAND_WRITE_BUFFER_RECT, amd::Command::EventWaitList{}, *dstMemory, dstStart,
-      copyRegion, srcHost, dstRect, srcRect, copyMetadata);
+      copyRegion, src.ptr_, dstRect, srcRect, copyMetadata);
     if (writeCommand == nullptr) {
       return hipErrorOutOfMemory;
     }
@@ -2173,16 +2527,16 @@ hipError_t ihipMemcpyHtoAValidate(const void* srcHost, hipArray_t dstArray,
   return hipSuccess;
 }
 
-hipError_t ihipMemcpyHtoACommand(amd::Command*& command, const void* srcHost, hipArray_t dstArray,
-                                 amd::Coord3D srcOrigin, amd::Coord3D dstOrigin,
-                                 amd::Coord3D copyRegion, size_t srcRowPitch, size_t srcSlicePitch,
-                                 hip::Stream* stream, bool isAsync = false) {
+hipError_t ihipMemcpyHtoACommand(amd::Command*& command, const ResolvedPtr& src,
+                                 hipArray_t dstArray, amd::Coord3D srcOrigin,
+                                 amd::Coord3D dstOrigin, amd::Coord3D copyRegion,
+                                 size_t srcRowPitch, size_t srcSlicePitch, hip::Stream* stream,
+                                 bool isAsync = false) {
   amd::Image* dstImage;
   size_t start = 0;  //!< Start offset for the copy region
-  size_t sOffset = 0;
-  amd::Memory* srcMemory = getMemoryObject(srcHost, sOffset);
+  amd::Memory* srcMemory = src.memory_;
 
-  hipError_t status = ihipMemcpyHtoAValidate(srcHost, dstArray, srcOrigin, dstOrigin, copyRegion,
+  hipError_t status = ihipMemcpyHtoAValidate(src.ptr_, dstArray, srcOrigin, dstOrigin, copyRegion,
                                              srcRowPitch, srcSlicePitch, dstImage, start);
   if (status != hipSuccess) {
     return status;
@@ -2201,7 +2555,7 @@ hipError_t ihipMemcpyHtoACommand(amd::Command*& command, const void* srcHost, hi
   } else {
     amd::WriteMemoryCommand* writeMemCmd = new amd::WriteMemoryCommand(
       *stream, CL_COMMAND_WRITE_IMAGE, amd::Command::EventWaitList{}, *dstImage, dstOrigin,
-      copyRegion, static_cast<const char*>(srcHost) + start, srcRowPitch, srcSlicePitch,
+      copyRegion, static_cast<const char*>(src.ptr_) + start, srcRowPitch, srcSlicePitch,
       copyMetadata);
     if (writeMemCmd == nullptr) {
       return hipErrorOutOfMemory;
@@ -2245,15 +2599,16 @@ hipError_t ihipMemcpyAtoHValidate(hipArray_t srcArray, void* dstHost, amd::Coord
   return hipSuccess;
 }
 
-hipError_t ihipMemcpyAtoHCommand(amd::Command*& command, hipArray_t srcArray, void* dstHost,
-                                 amd::Coord3D srcOrigin, amd::Coord3D dstOrigin,
-                                 amd::Coord3D copyRegion, size_t dstRowPitch, size_t dstSlicePitch,
-                                 hip::Stream* stream, bool isAsync = false) {
+hipError_t ihipMemcpyAtoHCommand(amd::Command*& command, hipArray_t srcArray,
+                                 const ResolvedPtr& dst, amd::Coord3D srcOrigin,
+                                 amd::Coord3D dstOrigin, amd::Coord3D copyRegion,
+                                 size_t dstRowPitch, size_t dstSlicePitch, hip::Stream* stream,
+                                 bool isAsync = false) {
   amd::Image* srcImage;
   amd::BufferRect dstRect;
   size_t start = 0;  //!< Start offset for the copy region
-  size_t dOffset = 0;
-  amd::Memory* dstMemory = getMemoryObject(dstHost, dOffset);
+  void* dstHost = const_cast<void*>(dst.ptr_);
+  amd::Memory* dstMemory = dst.memory_;
 
   hipError_t status = ihipMemcpyAtoHValidate(srcArray, dstHost, srcOrigin, dstOrigin, copyRegion,
                                              dstRowPitch, dstSlicePitch, srcImage, start);
@@ -2290,116 +2645,116 @@ hipError_t ihipMemcpyAtoHCommand(amd::Command*& command, hipArray_t srcArray, vo
   return hipSuccess;
 }
 
+// Resolves the pointer of one copy side, unless the caller resolved it already
+static void ihipResolveCopyPtr(ResolvedPtr& resolved, const void* ptr) {
+  if (resolved.ptr_ != ptr) {
+    resolved = ResolvedPtr(ptr);
+  }
+}
+
 void ihipCopyMemParamSet(const HIP_MEMCPY3D* pCopy, hipMemoryType& srcMemType,
-                         hipMemoryType& dstMemType)  {
-  size_t offset = 0;
+                         hipMemoryType& dstMemType, ResolvedPtr& srcPtr, ResolvedPtr& dstPtr) {
   // If {src/dst}MemoryType is hipMemoryTypeUnified, {src/dst}Device and {src/dst}Pitch
   // specify the (unified virtual address space)
   // base address of the source data and the bytes per row to apply. {src/dst}Array is ignored.
-  hipMemoryType srcMemoryType = pCopy->srcMemoryType;
-  if (srcMemoryType == hipMemoryTypeUnified) {
-    amd::Memory* memObj = getMemoryObject(pCopy->srcDevice, offset);
-    if (memObj != nullptr) {
-      srcMemoryType = ((CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_USE_HOST_PTR) &
-            memObj->getMemFlags()) ? hipMemoryTypeHost : hipMemoryTypeDevice;
-    } else {
-      srcMemoryType = hipMemoryTypeHost;
-      const_cast<HIP_MEMCPY3D*>(pCopy)->srcXInBytes += offset;
+  const hipMemoryType srcDeclared = pCopy->srcMemoryType;
+  if (srcDeclared == hipMemoryTypeUnified) {
+    ihipResolveCopyPtr(srcPtr, pCopy->srcDevice);
+    if (srcPtr.memory_ == nullptr) {
+      const_cast<HIP_MEMCPY3D*>(pCopy)->srcXInBytes += srcPtr.offset_;
     }
-
-    if (srcMemoryType == hipMemoryTypeHost) {
+    if (srcPtr.type_ == hipMemoryTypeHost) {
       // {src/dst}Host may be unitialized. Copy over {src/dst}Device into it if we
       //  detect system memory.
       const_cast<HIP_MEMCPY3D*>(pCopy)->srcHost = pCopy->srcDevice;
       // We don't need detect memory type again for hipMemoryTypeUnified
-      const_cast<HIP_MEMCPY3D*>(pCopy)->srcMemoryType = srcMemoryType;
+      const_cast<HIP_MEMCPY3D*>(pCopy)->srcMemoryType = hipMemoryTypeHost;
     }
-  }
-  offset = 0;
-  hipMemoryType dstMemoryType = pCopy->dstMemoryType;
-  if (dstMemoryType == hipMemoryTypeUnified) {
-    amd::Memory* memObj = getMemoryObject(pCopy->dstDevice, offset);
-    if (memObj != nullptr) {
-      dstMemoryType = ((CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_USE_HOST_PTR) &
-            memObj->getMemFlags()) ? hipMemoryTypeHost : hipMemoryTypeDevice;
-    } else {
-      dstMemoryType = hipMemoryTypeHost;
-      const_cast<HIP_MEMCPY3D*>(pCopy)->dstXInBytes += offset;
+  } else if (srcDeclared == hipMemoryTypeHost) {
+    ihipResolveCopyPtr(srcPtr, pCopy->srcHost);
+  } else if (srcDeclared == hipMemoryTypeDevice) {
+    ihipResolveCopyPtr(srcPtr, pCopy->srcDevice);
+  }
+  const hipMemoryType dstDeclared = pCopy->dstMemoryType;
+  if (dstDeclared == hipMemoryTypeUnified) {
+    ihipResolveCopyPtr(dstPtr, pCopy->dstDevice);
+    if (dstPtr.memory_ == nullptr) {
+      const_cast<HIP_MEMCPY3D*>(pCopy)->dstXInBytes += dstPtr.offset_;
     }
-
-    if (dstMemoryType == hipMemoryTypeHost) {
+    if (dstPtr.type_ == hipMemoryTypeHost) {
       const_cast<HIP_MEMCPY3D*>(pCopy)->dstHost = pCopy->dstDevice;
       // We don't need detect memory type again for hipMemoryTypeUnified
-      const_cast<HIP_MEMCPY3D*>(pCopy)->dstMemoryType = dstMemoryType;
+      const_cast<HIP_MEMCPY3D*>(pCopy)->dstMemoryType = hipMemoryTypeHost;
     }
+  } else if (dstDeclared == hipMemoryTypeHost) {
+    ihipResolveCopyPtr(dstPtr, pCopy->dstHost);
+  } else if (dstDeclared == hipMemoryTypeDevice) {
+    ihipResolveCopyPtr(dstPtr, pCopy->dstDevice);
   }
-  offset = 0;
-  // If {src/dst}MemoryType is hipMemoryTypeHost, check if the memory was prepinned.
-  // In that case upgrade the copy type to hipMemoryTypeDevice to avoid extra pinning.
-  if (srcMemoryType == hipMemoryTypeHost) {
-    srcMemoryType = getMemoryObject(pCopy->srcHost, offset) ? hipMemoryTypeDevice :
-                    hipMemoryTypeHost;
+  srcMemType = ResolveMemcpyMemoryType(srcDeclared, srcPtr.memory_ != nullptr, srcPtr.type_);
+  dstMemType = ResolveMemcpyMemoryType(dstDeclared, dstPtr.memory_ != nullptr, dstPtr.type_);
 
-    if (srcMemoryType == hipMemoryTypeDevice) {
-      const_cast<HIP_MEMCPY3D*>(pCopy)->srcDevice = const_cast<void*>(pCopy->srcHost);
-    }
+  // If {src/dst}MemoryType is hipMemoryTypeHost and the memory was prepinned, the copy type was
+  // upgraded to hipMemoryTypeDevice to avoid extra pinning.
+  if ((pCopy->srcMemoryType == hipMemoryTypeHost) && (srcMemType == hipMemoryTypeDevice)) {
+    const_cast<HIP_MEMCPY3D*>(pCopy)->srcDevice = const_cast<void*>(pCopy->srcHost);
   }
-  offset = 0;
-  if (dstMemoryType == hipMemoryTypeHost) {
-    dstMemoryType = getMemoryObject(pCopy->dstHost, offset) ? hipMemoryTypeDevice :
-                    hipMemoryTypeHost;
-
-    if (dstMemoryType == hipMemoryTypeDevice) {
-      const_cast<HIP_MEMCPY3D*>(pCopy)->dstDevice = const_cast<void*>(pCopy->dstHost);
-    }
+  if ((pCopy->dstMemoryType == hipMemoryTypeHost) && (dstMemType == hipMemoryTypeDevice)) {
+    const_cast<HIP_MEMCPY3D*>(pCopy)->dstDevice = pCopy->dstHost;
   }
-  srcMemType = srcMemoryType;
-  dstMemType = dstMemoryType;
 }
 
-hipError_t ihipGetMemcpyParam3DCommand(amd::Command*& command, const HIP_MEMCPY3D* pCopy,
-                                       hip::Stream* stream) {
-  hipMemoryType srcMemoryType;
-  hipMemoryType dstMemoryType;
-  ihipCopyMemParamSet(pCopy, srcMemoryType, dstMemoryType);
-
+void ihipCopyMemParamSet(const HIP_MEMCPY3D* pCopy, hipMemoryType& srcMemType,
+                         hipMemoryType& dstMemType) {
+  ResolvedPtr srcPtr;
+  ResolvedPtr dstPtr;
+  ihipCopyMemParamSet(pCopy, srcMemType, dstMemType, srcPtr, dstPtr);
+}
+
+// Builds the copy command of a descriptor ihipCopyMemParamSet() already classified. srcPtr and
+// dstPtr are the resolved linear sides, the array sides don't use them
+static hipError_t ihipGetMemcpyParam3DCommand(amd::Command*& command, const HIP_MEMCPY3D* pCopy,
+                                              hip::Stream* stream, hipMemoryType srcMemoryType,
+                                              hipMemoryType dstMemoryType,
+                                              const ResolvedPtr& srcPtr,
+                                              const ResolvedPtr& dstPtr) {
   amd::Coord3D srcOrigin = {pCopy->srcXInBytes, pCopy->srcY, pCopy->srcZ};
   amd::Coord3D dstOrigin = {pCopy->dstXInBytes, pCopy->dstY, pCopy->dstZ};
   amd::Coord3D copyRegion = {pCopy->WidthInBytes, pCopy->Height, pCopy->Depth};
 
   if ((srcMemoryType == hipMemoryTypeHost) && (dstMemoryType == hipMemoryTypeDevice)) {
     // Host to Device.
-    return ihipMemcpyHtoDCommand(command, pCopy->srcHost, pCopy->dstDevice, srcOrigin, dstOrigin,
+    return ihipMemcpyHtoDCommand(command, srcPtr, dstPtr, srcOrigin, dstOrigin,
                                  copyRegion, pCopy->srcPitch, pCopy->srcPitch * pCopy->srcHeight,
                                  pCopy->dstPitch, pCopy->dstPitch * pCopy->dstHeight, stream);
   } else if ((srcMemoryType == hipMemoryTypeDevice) && (dstMemoryType == hipMemoryTypeHost)) {
     // Device to Host.
-    return ihipMemcpyDtoHCommand(command, pCopy->srcDevice, pCopy->dstHost, srcOrigin, dstOrigin,
+    return ihipMemcpyDtoHCommand(command, srcPtr, dstPtr, srcOrigin, dstOrigin,
                                  copyRegion, pCopy->srcPitch, pCopy->srcPitch * pCopy->srcHeight,
                                  pCopy->dstPitch, pCopy->dstPitch * pCopy->dstHeight, stream);
   } else if ((srcMemoryType == hipMemoryTypeDevice) && (dstMemoryType == hipMemoryTypeDevice)) {
     // Device to Device.
-    return ihipMemcpyDtoDCommand(command, pCopy->srcDevice, pCopy->dstDevice, srcOrigin, dstOrigin,
+    return ihipMemcpyDtoDCommand(command, srcPtr, dstPtr, srcOrigin, dstOrigin,
                                  copyRegion, pCopy->srcPitch, pCopy->srcPitch * pCopy->srcHeight,
                                  pCopy->dstPitch, pCopy->dstPitch * pCopy->dstHeight, stream);
   } else if ((srcMemoryType == hipMemoryTypeHost) && (dstMemoryType == hipMemoryTypeArray)) {
     // Host to Image.
-    return ihipMemcpyHtoACommand(command, pCopy->srcHost, pCopy->dstArray, srcOrigin, dstOrigin,
+    return ihipMemcpyHtoACommand(command, srcPtr, pCopy->dstArray, srcOrigin, dstOrigin,
                                  copyRegion, pCopy->srcPitch, pCopy->srcPitch * pCopy->srcHeight,
                                  stream);
   } else if ((srcMemoryType == hipMemoryTypeArray) && (dstMemoryType == hipMemoryTypeHost)) {
     // Image to Host.
-    return ihipMemcpyAtoHCommand(command, pCopy->srcArray, pCopy->dstHost, srcOrigin, dstOrigin,
+    return ihipMemcpyAtoHCommand(command, pCopy->srcArray, dstPtr, srcOrigin, dstOrigin,
                                  copyRegion, pCopy->dstPitch, pCopy->dstPitch * pCopy->dstHeight,
                                  stream);
   } else if ((srcMemoryType == hipMemoryTypeDevice) && (dstMemoryType == hipMemoryTypeArray)) {
     // Device to Image.
-    return ihipMemcpyDtoACommand(command, pCopy->srcDevice, pCopy->dstArray, srcOrigin, dstOrigin,
+    return ihipMemcpyDtoACommand(command, srcPtr, pCopy->dstArray, srcOrigin, dstOrigin,
                                  copyRegion, pCopy->srcPitch, pCopy->srcPitch * pCopy->srcHeight,
                                  stream);
   } else if ((srcMemoryType == hipMemoryTypeArray) && (dstMemoryType == hipMemoryTypeDevice)) {
     // Image to Device.
-    return ihipMemcpyAtoDCommand(command, pCopy->srcArray, pCopy->dstDevice, srcOrigin, dstOrigin,
+    return ihipMemcpyAtoDCommand(command, pCopy->srcArray, dstPtr, srcOrigin, dstOrigin,
                                  copyRegion, pCopy->dstPitch, pCopy->dstPitch * pCopy->dstHeight,
                                  stream);
   } else if ((srcMemoryType == hipMemoryTypeArray) && (dstMemoryType == hipMemoryTypeArray)) {
@@ -2413,6 +2768,17 @@ hipError_t ihipGetMemcpyParam3DCommand(amd::Command*& command, const HIP_MEMCPY3
   return hipSuccess;
 }
 
+hipError_t ihipGetMemcpyParam3DCommand(amd::Command*& command, const HIP_MEMCPY3D* pCopy,
+                                       hip::Stream* stream) {
+  hipMemoryType srcMemoryType;
+  hipMemoryType dstMemoryType;
+  ResolvedPtr srcPtr;
+  ResolvedPtr dstPtr;
+  ihipCopyMemParamSet(pCopy, srcMemoryType, dstMemoryType, srcPtr, dstPtr);
+  return ihipGetMemcpyParam3DCommand(command, pCopy, stream, srcMemoryType, dstMemoryType, srcPtr,
+                                     dstPtr);
+}
+
 inline hipError_t ihipMemcpyCmdEnqueue(amd::Command* command, bool isAsync = false) {
   hipError_t status = hipSuccess;
   if (command == nullptr) {
@@ -2426,7 +2792,9 @@ inline hipError_t ihipMemcpyCmdEnqueue(amd::Command* command, bool isAsync = fal
   return status;
 }
 
-hipError_t ihipMemcpyParam3D(const HIP_MEMCPY3D* pCopy, hipStream_t stream, bool isAsync = false) {
+// srcPtr and dstPtr may hold the pointers the caller resolved already, the copy reuses them
+hipError_t ihipMemcpyParam3D(const HIP_MEMCPY3D* pCopy, hipStream_t stream, bool isAsync,
+                             ResolvedPtr srcPtr, ResolvedPtr dstPtr) {
   hipError_t status;
   if (pCopy == nullptr) {
     return hipErrorInvalidValue;
@@ -2441,7 +2809,7 @@ hipError_t ihipMemcpyParam3D(const HIP_MEMCPY3D* pCopy, hipStream_t stream, bool
   }
   hipMemoryType srcMemoryType;
   hipMemoryType dstMemoryType;
-  ihipCopyMemParamSet(pCopy, srcMemoryType, dstMemoryType);
+  ihipCopyMemParamSet(pCopy, srcMemoryType, dstMemoryType, srcPtr, dstPtr);
 
   if ((srcMemoryType == hipMemoryTypeHost) && (dstMemoryType == hipMemoryTypeHost)) {
     amd::Coord3D srcOrigin = {pCopy->srcXInBytes, pCopy->srcY, pCopy->srcZ};
@@ -2459,7 +2827,8 @@ hipError_t ihipMemcpyParam3D(const HIP_MEMCPY3D* pCopy, hipStream_t stream, bool
     if (hip_stream == nullptr) {
       return hipErrorInvalidValue;
     }
-    status = ihipGetMemcpyParam3DCommand(command, pCopy, hip_stream);
+    status = ihipGetMemcpyParam3DCommand(command, pCopy, hip_stream, srcMemoryType,
+                                         dstMemoryType, srcPtr, dstPtr);
     if (status != hipSuccess) return status;
 
     // Transfers from device memory to pageable host memory and transfers from any
@@ -2478,6 +2847,10 @@ hipError_t ihipMemcpyParam3D(const HIP_MEMCPY3D* pCopy, hipStream_t stream, bool
   }
 }
 
+hipError_t ihipMemcpyParam3D(const HIP_MEMCPY3D* pCopy, hipStream_t stream, bool isAsync = false) {
+  return ihipMemcpyParam3D(pCopy, stream, isAsync, ResolvedPtr(), ResolvedPtr());
+}
+
 hipError_t ihipMemcpyParam2D(const hip_Memcpy2D* pCopy,
                              hipStream_t stream,
                              bool isAsync = false) {
@@ -2752,8 +3125,8 @@ hipError_t ihipMemcpyAtoD(hipArray_t srcArray, void* dstDevice, amd::Coord3D src
     return hipErrorInvalidValue;
   }
   hipError_t status =
-      ihipMemcpyAtoDCommand(command, srcArray, dstDevice, srcOrigin, dstOrigin, copyRegion,
-                               dstRowPitch, dstSlicePitch, hip_stream);
+      ihipMemcpyAtoDCommand(command, srcArray, ResolvedPtr(dstDevice), srcOrigin, dstOrigin,
+                            copyRegion, dstRowPitch, dstSlicePitch, hip_stream);
   if (status != hipSuccess) return status;
   return ihipMemcpyCmdEnqueue(command, isAsync);
 }
@@ -2766,8 +3139,8 @@ hipError_t ihipMemcpyDtoA(void* srcDevice, hipArray_t dstArray, amd::Coord3D src
     return hipErrorInvalidValue;
   }
   hipError_t status =
-      ihipMemcpyDtoACommand(command, srcDevice, dstArray, srcOrigin, dstOrigin, copyRegion,
-                               srcRowPitch, srcSlicePitch, hip_stream);
+      ihipMemcpyDtoACommand(command, ResolvedPtr(srcDevice), dstArray, srcOrigin, dstOrigin,
+                            copyRegion, srcRowPitch, srcSlicePitch, hip_stream);
   if (status != hipSuccess) return status;
   return ihipMemcpyCmdEnqueue(command, isAsync);
 }
@@ -2780,9 +3153,10 @@ hipError_t ihipMemcpyDtoD(void* srcDevice, void* dstDevice, amd::Coord3D srcOrig
   if (hip_stream == nullptr) {
     return hipErrorInvalidValue;
   }
-  hipError_t status = ihipMemcpyDtoDCommand(command, srcDevice, dstDevice, srcOrigin, dstOrigin,
-                                               copyRegion, srcRowPitch, srcSlicePitch, dstRowPitch,
-                                               dstSlicePitch, hip_stream);
+  hipError_t status = ihipMemcpyDtoDCommand(command, ResolvedPtr(srcDevice), ResolvedPtr(dstDevice),
+                                            srcOrigin, dstOrigin, copyRegion, srcRowPitch,
+                                            srcSlicePitch, dstRowPitch, dstSlicePitch,
+                                            hip_stream);
   if (status != hipSuccess) return status;
   return ihipMemcpyCmdEnqueue(command, isAsync);
 }
@@ -2795,9 +3169,10 @@ hipError_t ihipMemcpyDtoH(void* srcDevice, void* dstHost, amd::Coord3D srcOrigin
   if (hip_stream == nullptr) {
     return hipErrorInvalidValue;
   }
-  hipError_t status = ihipMemcpyDtoHCommand(command, srcDevice, dstHost, srcOrigin, dstOrigin,
-                                               copyRegion, srcRowPitch, srcSlicePitch, dstRowPitch,
-                                               dstSlicePitch, hip_stream, isAsync);
+  hipError_t status = ihipMemcpyDtoHCommand(command, ResolvedPtr(srcDevice), ResolvedPtr(dstHost),
+                                            srcOrigin, dstOrigin, copyRegion, srcRowPitch,
+                                            srcSlicePitch, dstRowPitch, dstSlicePitch,
+                                            hip_stream, isAsync);
   if (status != hipSuccess) return status;
   return ihipMemcpyCmdEnqueue(command, isAsync);
 }
@@ -2810,9 +3185,10 @@ hipError_t ihipMemcpyHtoD(const void* srcHost, void* dstDevice, amd::Coord3D src
   if (hip_stream == nullptr) {
     return hipErrorInvalidValue;
   }
-  hipError_t status = ihipMemcpyHtoDCommand(command, srcHost, dstDevice, srcOrigin, dstOrigin,
-                                               copyRegion, srcRowPitch, srcSlicePitch, dstRowPitch,
-                                               dstSlicePitch, hip_stream, isAsync);
+  hipError_t status = ihipMemcpyHtoDCommand(command, ResolvedPtr(srcHost), ResolvedPtr(dstDevice),
+                                            srcOrigin, dstOrigin, copyRegion, srcRowPitch,
+                                            srcSlicePitch, dstRowPitch, dstSlicePitch,
+                                            hip_stream, isAsync);
   if (status != hipSuccess) return status;
   return ihipMemcpyCmdEnqueue(command, isAsync);
 }
@@ -2838,8 +3214,8 @@ hipError_t ihipMemcpyHtoA(const void* srcHost, hipArray_t dstArray, amd::Coord3D
     return hipErrorInvalidValue;
   }
   hipError_t status =
-      ihipMemcpyHtoACommand(command, srcHost, dstArray, srcOrigin, dstOrigin, copyRegion,
-                               srcRowPitch, srcSlicePitch, hip_stream, isAsync);
+      ihipMemcpyHtoACommand(command, ResolvedPtr(srcHost), dstArray, srcOrigin, dstOrigin,
+                            copyRegion, srcRowPitch, srcSlicePitch, hip_stream, isAsync);
   if (status != hipSuccess) return status;
   return ihipMemcpyCmdEnqueue(command, isAsync);
 }
@@ -2852,8 +3228,8 @@ hipError_t ihipMemcpyAtoH(hipArray_t srcArray, void* dstHost, amd::Coord3D srcOr
     return hipErrorInvalidValue;
   }
   hipError_t status =
-      ihipMemcpyAtoHCommand(command, srcArray, dstHost, srcOrigin, dstOrigin, copyRegion,
-                               dstRowPitch, dstSlicePitch, hip_stream, isAsync);
+      ihipMemcpyAtoHCommand(command, srcArray, ResolvedPtr(dstHost), srcOrigin, dstOrigin,
+                            copyRegion, dstRowPitch, dstSlicePitch, hip_stream, isAsync);
   if (status != hipSuccess) return status;
   return ihipMemcpyCmdEnqueue(command, isAsync);
 }
@@ -2876,7 +3252,9 @@ hipError_t hipMemcpyAtoH(void* dstHost,
   HIP_RETURN_DURATION(ihipMemcpyAtoH(srcArray, dstHost, {srcOffset, 0, 0}, {0, 0, 0}, {ByteCount, 1, 1}, 0, 0, nullptr));
 }
 
-hipError_t ihipMemcpy3D_validate(const hipMemcpy3DParms* p) {
+// srcPtr and dstPtr are the resolved p->srcPtr.ptr and p->dstPtr.ptr
+static hipError_t ihipMemcpy3D_validate(const hipMemcpy3DParms* p, const ResolvedPtr& srcPtr,
+                                        const ResolvedPtr& dstPtr) {
   // Passing more than one non-zero source or destination will cause hipMemcpy3D() to
   // return an error.
   if (p == nullptr || ((p->srcArray != nullptr) && (p->srcPtr.ptr != nullptr)) ||
@@ -2919,9 +3297,8 @@ hipError_t ihipMemcpy3D_validate(const hipMemcpy3DParms* p) {
     }
     auto totalExtentBytes = p->extent.width * p->extent.height * p->extent.depth;
     // get memory obj of the PitchPtr
-    size_t offset = 0;
-    amd::Memory* srcPtrMemObj = getMemoryObject(p->srcPtr.ptr, offset);
-    amd::Memory* dstPtrMemObj = getMemoryObject(p->dstPtr.ptr, offset);
+    amd::Memory* srcPtrMemObj = srcPtr.memory_;
+    amd::Memory* dstPtrMemObj = dstPtr.memory_;
 
     if (dstPtrMemObj != nullptr && (p->dstPtr.xsize != 0 && p->dstPtr.ysize != 0)) {
       // Use the memoryObj to get 3d data
@@ -2961,12 +3338,19 @@ hipError_t ihipMemcpy3D_validate(const hipMemcpy3DParms* p) {
     return hipErrorInvalidMemcpyDirection;
   }
   //If src and dst ptr are null then kind must be either h2h or def.
-  if (!IsHtoHMemcpyValid(p->dstPtr.ptr, p->srcPtr.ptr, p->kind)) {
+  if (!IsHtoHMemcpyValid(dstPtr, srcPtr, p->kind)) {
     return hipErrorInvalidValue;
   }
   return hipSuccess;
 }
 
+hipError_t ihipMemcpy3D_validate(const hipMemcpy3DParms* p) {
+  if (p == nullptr) {
+    return hipErrorInvalidValue;
+  }
+  return ihipMemcpy3D_validate(p, ResolvedPtr(p->srcPtr.ptr), ResolvedPtr(p->dstPtr.ptr));
+}
+
 hipError_t ihipDrvMemcpy3D_validate(const HIP_MEMCPY3D* pCopy) {
   hipError_t status;
   if (pCopy->WidthInBytes == 0 || pCopy->Height == 0 || pCopy->Depth == 0) {
@@ -2976,7 +3360,9 @@ hipError_t ihipDrvMemcpy3D_validate(const HIP_MEMCPY3D* pCopy) {
   }
   hipMemoryType srcMemoryType;
   hipMemoryType dstMemoryType;
-  ihipCopyMemParamSet(pCopy, srcMemoryType, dstMemoryType);
+  ResolvedPtr srcPtr;
+  ResolvedPtr dstPtr;
+  ihipCopyMemParamSet(pCopy, srcMemoryType, dstMemoryType, srcPtr, dstPtr);
 
   amd::Coord3D srcOrigin = {pCopy->srcXInBytes, pCopy->srcY, pCopy->srcZ};
   amd::Coord3D dstOrigin = {pCopy->dstXInBytes, pCopy->dstY, pCopy->dstZ};
@@ -2990,7 +3376,7 @@ hipError_t ihipDrvMemcpy3D_validate(const HIP_MEMCPY3D* pCopy) {
     amd::BufferRect dstRect;
 
     status =
-        ihipMemcpyHtoDValidate(pCopy->srcHost, pCopy->dstDevice, srcOrigin, dstOrigin, copyRegion,
+        ihipMemcpyHtoDValidate(pCopy->srcHost, dstPtr, srcOrigin, dstOrigin, copyRegion,
                                pCopy->srcPitch, pCopy->srcPitch * pCopy->srcHeight, pCopy->dstPitch,
                                pCopy->dstPitch * pCopy->dstHeight, dstMemory, srcRect, dstRect);
     if (status != hipSuccess) {
@@ -3002,7 +3388,7 @@ hipError_t ihipDrvMemcpy3D_validate(const HIP_MEMCPY3D* pCopy) {
     amd::BufferRect srcRect;
     amd::BufferRect dstRect;
     status =
-        ihipMemcpyDtoHValidate(pCopy->srcDevice, pCopy->dstHost, srcOrigin, dstOrigin, copyRegion,
+        ihipMemcpyDtoHValidate(srcPtr, pCopy->dstHost, srcOrigin, dstOrigin, copyRegion,
                                pCopy->srcPitch, pCopy->srcPitch * pCopy->srcHeight, pCopy->dstPitch,
                                pCopy->dstPitch * pCopy->dstHeight, srcMemory, srcRect, dstRect);
     if (status != hipSuccess) {
@@ -3015,7 +3401,7 @@ hipError_t ihipDrvMemcpy3D_validate(const HIP_MEMCPY3D* pCopy) {
     amd::BufferRect srcRect;
     amd::BufferRect dstRect;
 
-    status = ihipMemcpyDtoDValidate(pCopy->srcDevice, pCopy->dstDevice, srcOrigin, dstOrigin,
+    status = ihipMemcpyDtoDValidate(srcPtr, dstPtr, srcOrigin, dstOrigin,
                                     copyRegion, pCopy->srcPitch, pCopy->srcPitch * pCopy->srcHeight,
                                     pCopy->dstPitch, pCopy->dstPitch * pCopy->dstHeight, srcMemory,
                                     dstMemory, srcRect, dstRect);
@@ -3051,7 +3437,7 @@ hipError_t ihipDrvMemcpy3D_validate(const HIP_MEMCPY3D* pCopy) {
     amd::Memory* srcMemory;
     amd::BufferRect dstRect;
     amd::BufferRect srcRect;
-    status = ihipMemcpyDtoAValidate(pCopy->srcDevice, pCopy->dstArray, srcOrigin, dstOrigin,
+    status = ihipMemcpyDtoAValidate(srcPtr, pCopy->dstArray, srcOrigin, dstOrigin,
                                     copyRegion, pCopy->srcPitch, pCopy->srcPitch * pCopy->srcHeight,
                                     dstImage, srcMemory, dstRect, srcRect);
     if (status != hipSuccess) {
@@ -3063,7 +3449,7 @@ hipError_t ihipDrvMemcpy3D_validate(const HIP_MEMCPY3D* pCopy) {
     amd::BufferRect dstRect;
     amd::Memory* dstMemory;
     amd::Image* srcImage;
-    status = ihipMemcpyAtoDValidate(pCopy->srcArray, pCopy->dstDevice, srcOrigin, dstOrigin,
+    status = ihipMemcpyAtoDValidate(pCopy->srcArray, dstPtr, srcOrigin, dstOrigin,
                                     copyRegion, pCopy->dstPitch, pCopy->dstPitch * pCopy->dstHeight,
                                     dstMemory, srcImage, srcRect, dstRect);
     if (status != hipSuccess) {
@@ -3101,13 +3487,19 @@ hipError_t ihipMemcpy3DCommand(amd::Command*& command, const hipMemcpy3DParms* p
 }
 
 hipError_t ihipMemcpy3D(const hipMemcpy3DParms* p, hipStream_t stream, bool isAsync = false) {
-  hipError_t status = ihipMemcpy3D_validate(p);
+  if (p == nullptr) {
+    return hipErrorInvalidValue;
+  }
+  // Resolve the pitched pointers once, the validation and the copy reuse the result
+  const ResolvedPtr srcPtr(p->srcPtr.ptr);
+  const ResolvedPtr dstPtr(p->dstPtr.ptr);
+  hipError_t status = ihipMemcpy3D_validate(p, srcPtr, dstPtr);
   if (status != hipSuccess) {
     return status;
   }
   const HIP_MEMCPY3D desc = hip::getDrvMemcpy3DDesc(*p);
 
-  return ihipMemcpyParam3D(&desc, stream, isAsync);
+  return ihipMemcpyParam3D(&desc, stream, isAsync, srcPtr, dstPtr);
 }
 
 hipError_t hipMemcpy3D_common(const hipMemcpy3DParms* p, hipStream_t stream = nullptr) {
@@ -3180,19 +3572,19 @@ hipError_t packFillMemoryCommand(amd::Command*& command, amd::Memory* memory, si
   return hipSuccess;
 }
 
-hipError_t ihipMemset_validate(void* dst, int64_t value, size_t valueSize,
-                                      size_t sizeBytes) {
+hipError_t ihipMemset_validate(const ResolvedPtr& dst, int64_t value, size_t valueSize,
+                               size_t sizeBytes) {
   if (sizeBytes == 0) {
     // Skip if nothing needs filling.
     return hipSuccess;
   }
 
-  if (dst == nullptr) {
+  if (dst.ptr_ == nullptr) {
     return hipErrorInvalidValue;
   }
 
-  size_t offset = 0;
-  amd::Memory* memory = getMemoryObject(dst, offset);
+  size_t offset = dst.offset_;
+  amd::Memory* memory = dst.memory_;
   if (memory == nullptr) {
     // dst ptr is host ptr hence error
     return hipErrorInvalidValue;
@@ -3215,6 +3607,15 @@ hipError_t ihipMemset_validate(void* dst, int64_t value, size_t valueSize,
   return hipSuccess;
 }
 
+hipError_t ihipMemset_validate(void* dst, int64_t value, size_t valueSize,
+                                      size_t sizeBytes) {
+  if (sizeBytes == 0) {
+    // Skip if nothing needs filling.
+    return hipSuccess;
+  }
+  return ihipMemset_validate(ResolvedPtr(dst), value, valueSize, sizeBytes);
+}
+
 hipError_t ihipGraphMemsetParams_validate(const hipMemsetParams* pNodeParams) {
   if (pNodeParams == nullptr) {
     return hipErrorInvalidValue;
@@ -3248,23 +3649,22 @@ hipError_t ihipGraphMemsetParams_validate(const hipMemsetParams* pNodeParams) {
   return hipSuccess;
 }
 
-hipError_t ihipMemsetCommand(std::vector<amd::Command*>& commands, void* dst, int64_t value,
-                             size_t valueSize, size_t sizeBytes, hip::Stream* stream) {
-  hipError_t hip_error = hipSuccess;
-  auto aligned_dst = amd::alignUp(reinterpret_cast<address>(dst), sizeof(uint64_t));
-  size_t offset = 0;
-  amd::Memory* memory = getMemoryObject(dst, offset);
-  size_t n_head_bytes = 0;
-  size_t n_tail_bytes = 0;
+hipError_t ihipMemsetCommand(std::vector<amd::Command*>& commands, const ResolvedPtr& dst,
+                             int64_t value, size_t valueSize, size_t sizeBytes,
+                             hip::Stream* stream) {
   amd::Command* command;
-
-  hip_error = packFillMemoryCommand(command, memory, offset, value, valueSize, sizeBytes,
-                                    stream);
+  hipError_t hip_error = packFillMemoryCommand(command, dst.memory_, dst.offset_, value,
+                                               valueSize, sizeBytes, stream);
   commands.push_back(command);
 
   return hip_error;
 }
 
+hipError_t ihipMemsetCommand(std::vector<amd::Command*>& commands, void* dst, int64_t value,
+                             size_t valueSize, size_t sizeBytes, hip::Stream* stream) {
+  return ihipMemsetCommand(commands, ResolvedPtr(dst), value, valueSize, sizeBytes, stream);
+}
+
 hipError_t ihipMemset(void* dst, int64_t value, size_t valueSize, size_t sizeBytes,
                       hipStream_t stream, bool isAsync = false) {
   hipError_t hip_error = hipSuccess;
@@ -3274,8 +3674,10 @@ hipError_t ihipMemset(void* dst, int64_t value, size_t valueSize, size_t sizeByt
       break;
     }
 
+    // Resolve dst once, validation and command construction reuse the result
+    const ResolvedPtr dstPtr(dst);
     // In case of validation failure stop processing. Returns hip_error.
-    hip_error = ihipMemset_validate(dst, value, valueSize, sizeBytes);
+    hip_error = ihipMemset_validate(dstPtr, value, valueSize, sizeBytes);
     if (hip_error != hipSuccess) {
       break;
     }
@@ -3283,18 +3685,16 @@ hipError_t ihipMemset(void* dst, int64_t value, size_t valueSize, size_t sizeByt
     // spec says hipMemset will be asynchronous when destination memory is device memory
     // and pointer is non-offseted
     if (isAsync == false) {
-      size_t offset = 0;
-      amd::Memory* memObj = getMemoryObject(dst, offset);
-      auto flags = memObj->getMemFlags();
-      if ((memObj->getUserData().sync_mem_ops_)
-           || (offset == 0 && !(flags & (CL_MEM_SVM_FINE_GRAIN_BUFFER
+      auto flags = dstPtr.flags_;
+      if ((dstPtr.memory_->getUserData().sync_mem_ops_)
+           || (dstPtr.offset_ == 0 && !(flags & (CL_MEM_SVM_FINE_GRAIN_BUFFER
                                          | CL_MEM_SVM_ATOMICS | CL_MEM_USE_HOST_PTR)))) {
         isAsync = true;
       }
     }
     std::vector<amd::Command*> commands;
     hip::Stream* hip_stream = hip::getStream(stream);
-    hip_error = ihipMemsetCommand(commands, dst, value, valueSize, sizeBytes, hip_stream);
+    hip_error = ihipMemsetCommand(commands, dstPtr, value, valueSize, sizeBytes, hip_stream);
     if (hip_error != hipSuccess) {
       break;
     }
@@ -3412,13 +3812,14 @@ hipError_t ihipMemset3D_validate(hipPitchedPtr pitchedDevPtr, int value, hipExte
 
 hipError_t ihipMemset3DCommand(std::vector<amd::Command*> &commands, hipPitchedPtr pitchedDevPtr,
                                int value, hipExtent extent, hip::Stream* stream, size_t elementSize = 1) {
-  size_t offset = 0;
   auto sizeBytes = extent.width * extent.height * extent.depth;
-  amd::Memory* memory = getMemoryObject(pitchedDevPtr.ptr, offset);
+  const ResolvedPtr dst(pitchedDevPtr.ptr);
   if (pitchedDevPtr.pitch == extent.width) {
-    return ihipMemsetCommand(commands, pitchedDevPtr.ptr, value, elementSize,
+    return ihipMemsetCommand(commands, dst, value, elementSize,
                                   static_cast<size_t>(sizeBytes), stream);
   }
+  size_t offset = dst.offset_;
+  amd::Memory* memory = dst.memory_;
   // Workaround for cases when pitch > row until fill kernel will be updated to support pitch.
   // Fall back to filling one row at a time.
   amd::Coord3D origin(offset);
@@ -3568,6 +3969,102 @@ hipError_t hipMemAllocHost(void** ptr, size_t size) {
   HIP_RETURN_DURATION(hipHostMalloc(ptr, size, 0));
 }
 
+// ================================================================================================
+class DeviceIpcBackend : public IpcMemCache::Backend {
+public:
+  DeviceIpcBackend(hip::Device* device): device_(device) {}
+
+  bool Attach(const ihipIpcMemHandle_t& handle, unsigned int flags, void** dev_ptr) override {
+    if (!device_->devices()[0]->IpcAttach(&handle.ipc_handle, handle.psize,
+                                          handle.poffset, flags, dev_ptr)) {
+      return false;
+    }
+    size_t offset = 0;
+    amd::Memory* amd_mem_obj = getMemoryObject(*dev_ptr, offset);
+    amd_mem_obj->getUserData().deviceId = device_->deviceId();
+    return true;
+  }
+
+  bool Detach(void* dev_ptr) override {
+    // The peer memory can't go away while any queue may still access it
+    hip::getNullStream()->finish();
+    device_->SyncAllStreams();
+    return device_->devices()[0]->IpcDetach(dev_ptr);
+  }
+
+private:
+  hip::Device* device_;
+};
+
+// ================================================================================================
+IpcMemCache* CreateIpcMemCache(hip::Device* device) {
+  return new IpcMemCache(new DeviceIpcBackend(device), HIP_IPC_MEM_CACHE_ENTRIES,
+                         HIP_IPC_MEM_CACHE_SIZE * Mi, HIP_IPC_MEM_CACHE_TTL * 1000 * 1000ULL);
+}
+
+// ================================================================================================
+class DeviceHostMemBackend : public HostMemCache::Backend {
+public:
+  DeviceHostMemBackend(hip::Device* device): device_(device) {}
+
+  hipError_t Alloc(size_t size, unsigned int flags, void** ptr) override {
+    return ihipMalloc(ptr, size, flags);
+  }
+
+  void Free(void* ptr) override {
+    size_t offset = 0;
+    amd::Memory* memory_object = getMemoryObject(ptr, offset);
+    if (memory_object != nullptr) {
+      amd::SvmBuffer::free(memory_object->getContext(), ptr);
+    }
+  }
+
+  void* RecordFence() override {
+    auto commands = new std::vector<amd::Command*>();
+    device_->GetLastCommands(commands);
+    if (commands->empty()) {
+      delete commands;
+      return nullptr;
+    }
+    return commands;
+  }
+
+  bool FenceDone(void* fence, bool wait) override {
+    auto commands = reinterpret_cast<std::vector<amd::Command*>*>(fence);
+    while (!commands->empty()) {
+      amd::Command* command = commands->back();
+      if (command->status() != CL_COMPLETE) {
+        if (wait) {
+          command->awaitCompletion();
+        } else if (!device_->devices()[0]->IsHwEventReady(*command)) {
+          return false;
+        }
+      }
+      // Drop the completed commands, so the next check doesn't repeat them
+      command->release();
+      commands->pop_back();
+    }
+    return true;
+  }
+
+  void ReleaseFence(void* fence) override {
+    auto commands = reinterpret_cast<std::vector<amd::Command*>*>(fence);
+    for (auto command : *commands) {
+      command->release();
+    }
+    delete commands;
+  }
+
+private:
+  hip::Device* device_;
+};
+
+// ================================================================================================
+HostMemCache* CreateHostMemCache(hip::Device* device) {
+  return new HostMemCache(new DeviceHostMemBackend(device), HIP_HOST_MEM_CACHE_SIZE * Mi);
+}
+
+// ================================================================================================
 hipError_t hipIpcGetMemHandle(hipIpcMemHandle_t* handle, void* dev_ptr) {
   HIP_INIT_API(hipIpcGetMemHandle, handle, dev_ptr);
 
@@ -3593,17 +4090,12 @@ hipError_t hipIpcGetMemHandle(hipIpcMemHandle_t* handle, void* dev_ptr) {
 hipError_t hipIpcOpenMemHandle(void** dev_ptr, hipIpcMemHandle_t handle, unsigned int flags) {
   HIP_INIT_API(hipIpcOpenMemHandle, dev_ptr, &handle, flags);
 
-  amd::Memory* amd_mem_obj = nullptr;
-  amd::Device* device = nullptr;
   ihipIpcMemHandle_t* ihandle = nullptr;
-  size_t offset = 0;
 
   if (dev_ptr == nullptr || flags != hipIpcMemLazyEnablePeerAccess) {
     HIP_RETURN(hipErrorInvalidValue);
   }
 
-  /* Call the IPC Attach from Device class */
-  device = hip::getCurrentDevice()->devices()[0];
   ihandle = reinterpret_cast<ihipIpcMemHandle_t *>(&handle);
 
   if (ihandle->psize == 0) {
@@ -3614,45 +4106,34 @@ hipError_t hipIpcOpenMemHandle(void** dev_ptr, hipIpcMemHandle_t handle, unsigne
     HIP_RETURN(hipErrorInvalidContext);
   }
 
-  if(!device->IpcAttach(&(ihandle->ipc_handle), ihandle->psize,
-                        ihandle->poffset, flags, dev_ptr)) {
+  /* Attach through the device cache, repeated opens share the mapping */
+  if (!hip::getCurrentDevice()->GetIpcMemCache()->Open(*ihandle, flags, dev_ptr)) {
     LogPrintfError("Cannot attach ipc_handle: with ipc_size: %u"
                       "ipc_offset: %u flags: %u", ihandle->psize, flags);
     HIP_RETURN(hipErrorInvalidDevicePointer);
   }
 
-  amd_mem_obj = getMemoryObject(*dev_ptr, offset);
-  amd_mem_obj->getUserData().deviceId = hip::getCurrentDevice()->deviceId();
-
   HIP_RETURN(hipSuccess);
 }
 
 hipError_t hipIpcCloseMemHandle(void* dev_ptr) {
   HIP_INIT_API(hipIpcCloseMemHandle, dev_ptr);
 
-  amd::Device* device = nullptr;
   amd::Memory* amd_mem_obj = nullptr;
 
-  hip::getNullStream()->finish();
-
   if (dev_ptr == nullptr) {
     HIP_RETURN(hipErrorInvalidValue);
   }
 
   amd_mem_obj = amd::MemObjMap::FindMemObj(dev_ptr);
-  if (amd_mem_obj != nullptr) {
-    auto device_id = amd_mem_obj->getUserData().deviceId;
-    g_devices[device_id]->SyncAllStreams();
-  }
-
-  /* Call IPC Detach from Device class */
-  device = hip::getCurrentDevice()->devices()[0];
-  if (device == nullptr) {
-    HIP_RETURN(hipErrorNoDevice);
+  if (amd_mem_obj == nullptr || !amd_mem_obj->ipcShared()) {
+    HIP_RETURN(hipErrorInvalidValue);
   }
 
-  /* detach the memory */
-  if (!device->IpcDetach(dev_ptr)){
+  /* Drop the reference in the cache of the device, which attached the memory. The cache
+     synchronizes the streams only when the memory is really detached */
+  auto device_id = amd_mem_obj->getUserData().deviceId;
+  if (!g_devices[device_id]->GetIpcMemCache()->Close(dev_ptr)) {
     HIP_RETURN(hipErrorInvalidValue);
   }
 
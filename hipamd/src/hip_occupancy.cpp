@@ -0,0 +1,150 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_occupancy.hpp"
+
+#include <algorithm>
+
+namespace hip {
+
+// ================================================================================================
+bool ComputeOccupancyLimits(OccupancyLimits* limits,
+                            const amd::device::Kernel::WorkGroupInfo& wrkGrpInfo,
+                            const amd::device::Info& info, uint32_t isaMajor, bool enableWgpMode) {
+  // Find wave occupancy per CU => simd_per_cu * GPR usage
+  size_t MaxWavesPerSimd;
+
+  if (isaMajor <= 9) {
+    MaxWavesPerSimd = 8;  // Limited by SPI 32 per CU, hence 8 per SIMD
+  } else {
+    MaxWavesPerSimd = 16;
+  }
+  size_t VgprWaves = MaxWavesPerSimd;
+  uint32_t VgprGranularity = info.vgprAllocGranularity_;
+  size_t maxVGPRs = info.vgprsPerSimd_;
+  size_t wavefrontSize = wrkGrpInfo.wavefrontSize_;
+  if (isaMajor >= 10) {
+    if (wavefrontSize == 64) {
+      maxVGPRs = maxVGPRs >> 1;
+      VgprGranularity = VgprGranularity >> 1;
+    }
+  }
+  if (wrkGrpInfo.usedVGPRs_ > 0) {
+    VgprWaves = maxVGPRs / amd::alignUp(wrkGrpInfo.usedVGPRs_, VgprGranularity);
+  }
+
+  if (VgprWaves == 0) {
+    // This should not happen ideally, but in case the usedVGPRs_/availableVGPRs_ values are
+    // incorrect, it can lead to a crash. By returning error, API can exit gracefully.
+    return false;
+  }
+
+  size_t GprWaves = VgprWaves;
+  if (wrkGrpInfo.usedSGPRs_ > 0) {
+    size_t maxSGPRs = info.sgprsPerSimd_;
+    const size_t SgprWaves = maxSGPRs / amd::alignUp(wrkGrpInfo.usedSGPRs_, 16);
+    GprWaves = std::min(VgprWaves, SgprWaves);
+  }
+  uint32_t simdPerCU = (isaMajor <= 9) ? info.simdPerCU_ : (wrkGrpInfo.isWGPMode_ ? 4 : 2);
+  const size_t alu_occupancy = simdPerCU * std::min(MaxWavesPerSimd, GprWaves);
+
+  uint32_t maxCUs = info.maxComputeUnits_;
+  if (wrkGrpInfo.isWGPMode_ == false && enableWgpMode == true) {
+    maxCUs *= 2;
+  } else if ((wrkGrpInfo.isWGPMode_ == true && enableWgpMode == false)) {
+    maxCUs /= 2;
+  }
+
+  limits->wavefrontSize_ = static_cast<int>(wavefrontSize);
+  limits->maxBlockSize_ = static_cast<int>(info.maxWorkGroupSize_);
+  limits->aluLimitedThreads_ = static_cast<int>(alu_occupancy * wavefrontSize);
+  limits->staticLds_ = wrkGrpInfo.usedLDSSize_;
+  limits->ldsPerCU_ = info.localMemSize_;
+  limits->maxCUs_ = maxCUs;
+  return true;
+}
+
+// ================================================================================================
+int OccupancyBlocksPerCU(const OccupancyLimits& limits, int blockSize, size_t dynamicSMemSize) {
+  if ((blockSize <= 0) || (blockSize > limits.maxBlockSize_)) {
+    return 0;
+  }
+  // Blocks are allocated in whole waves, i.e. 65 threads take 128 thread slots with wave64
+  int blocks = limits.aluLimitedThreads_ / amd::alignUp(blockSize, limits.wavefrontSize_);
+  const size_t total_used_lds = limits.staticLds_ + dynamicSMemSize;
+  if (total_used_lds != 0) {
+    blocks = static_cast<int>(
+        std::min(static_cast<size_t>(blocks), limits.ldsPerCU_ / total_used_lds));
+  }
+  return blocks;
+}
+
+// ================================================================================================
+void OccupancyMaxPotentialBlockSize(const OccupancyLimits& limits, OccupancyBlockToSMem smemFunc,
+                                    size_t dynamicSMemSize, int blockSizeLimit, int* gridSize,
+                                    int* blockSize) {
+  int maxBlockSize = limits.maxBlockSize_;
+  if ((blockSizeLimit > 0) && (blockSizeLimit < maxBlockSize)) {
+    maxBlockSize = blockSizeLimit;
+  }
+  // A block larger than the ALU limit can't be resident at all
+  maxBlockSize = std::min(maxBlockSize, limits.aluLimitedThreads_);
+
+  int bestThreads = 0;
+  int bestBlockSize = 0;
+  int bestBlocks = 0;
+  const int waveSize = limits.wavefrontSize_;
+  // The candidates are the limit itself and the whole wave multiples below it,
+  // since the hardware allocates the blocks in whole waves
+  for (int size = maxBlockSize; size > 0;
+       size = (size % waveSize != 0) ? (size - size % waveSize) : (size - waveSize)) {
+    // The ALU bound can only be lowered by LDS, hence skip the sizes, which can't win, without
+    // an evaluation of the shared memory callback
+    const int aluThreads = (limits.aluLimitedThreads_ / amd::alignUp(size, waveSize)) * size;
+    if (aluThreads <= bestThreads) {
+      continue;
+    }
+    const size_t smem = (smemFunc != nullptr) ? smemFunc(size) : dynamicSMemSize;
+    const int blocks = OccupancyBlocksPerCU(limits, size, smem);
+    if (blocks * size > bestThreads) {
+      bestThreads = blocks * size;
+      bestBlockSize = size;
+      bestBlocks = blocks;
+      if (bestThreads == limits.aluLimitedThreads_) {
+        // Full occupancy, smaller blocks can't improve it
+        break;
+      }
+    }
+  }
+  *blockSize = bestBlockSize;
+  *gridSize = static_cast<int>(limits.maxCUs_) * bestBlocks;
+}
+
+// ================================================================================================
+size_t OccupancyAvailableDynamicSMem(const OccupancyLimits& limits, int numBlocks,
+                                     int blockSize) {
+  if ((numBlocks <= 0) || (OccupancyBlocksPerCU(limits, blockSize, 0) < numBlocks)) {
+    return 0;
+  }
+  const size_t ldsPerBlock = limits.ldsPerCU_ / numBlocks;
+  return (ldsPerBlock > limits.staticLds_) ? (ldsPerBlock - limits.staticLds_) : 0;
+}
+
+}  // namespace hip
@@ -0,0 +1,62 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "device/device.hpp"
+
+namespace hip {
+
+/// Resource limits of a kernel on a device. They don't depend on the launch configuration,
+/// hence they are computed once per kernel and device
+struct OccupancyLimits {
+  int wavefrontSize_ = 0;      //!< Wavefront size of the kernel
+  int maxBlockSize_ = 0;       //!< Max workgroup size of the device
+  int aluLimitedThreads_ = 0;  //!< Max threads per CU, limited by the wave slots and GPRs
+  size_t staticLds_ = 0;       //!< Static LDS usage of the kernel
+  size_t ldsPerCU_ = 0;        //!< LDS size of a CU
+  uint32_t maxCUs_ = 0;        //!< Number of CUs in the execution mode of the kernel
+};
+
+/// Maps a block size to the dynamic shared memory size the kernel needs for it
+typedef size_t (*OccupancyBlockToSMem)(int blockSize);
+
+/// Computes the occupancy limits from the kernel resource usage and the device properties.
+/// Returns false if the reported GPR usage doesn't fit a single wave
+bool ComputeOccupancyLimits(OccupancyLimits* limits,
+                            const amd::device::Kernel::WorkGroupInfo& wrkGrpInfo,
+                            const amd::device::Info& info, uint32_t isaMajor, bool enableWgpMode);
+
+/// Returns the number of blocks, which can be resident on a CU at once
+int OccupancyBlocksPerCU(const OccupancyLimits& limits, int blockSize, size_t dynamicSMemSize);
+
+/// Finds the block size with the highest number of resident threads per CU among the block size
+/// limit and the wave multiples below it. Larger blocks win the ties. If smemFunc isn't nullptr,
+/// it provides the dynamic shared memory for each block size, otherwise dynamicSMemSize is used.
+/// Returns 0 for both sizes if no block size fits
+void OccupancyMaxPotentialBlockSize(const OccupancyLimits& limits, OccupancyBlockToSMem smemFunc,
+                                    size_t dynamicSMemSize, int blockSizeLimit, int* gridSize,
+                                    int* blockSize);
+
+/// Returns the max dynamic shared memory per block, which still allows numBlocks blocks of
+/// blockSize threads to be resident on a CU at once
+size_t OccupancyAvailableDynamicSMem(const OccupancyLimits& limits, int numBlocks, int blockSize);
+
+}  // namespace hip
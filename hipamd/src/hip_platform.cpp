@@ -333,80 +333,41 @@ hipError_t ihipOccupancyMaxActiveBlocksPerMultiprocessor(
     int* maxBlocksPerCU, int* numBlocksPerGrid, int* bestBlockSize, const amd::Device& device,
     hipFunction_t func, int inputBlockSize, size_t dynamicSMemSize, bool bCalcPotentialBlkSz) {
   hip::DeviceFunc* function = hip::DeviceFunc::asFunction(func);
-  const amd::Kernel& kernel = *function->kernel();
+  hip::OccupancyLimits limits;
+  if (!function->getOccupancyLimits(device, &limits)) {
+    // The GPR usage of the kernel doesn't fit a wave, hence exit gracefully
+    return hipErrorUnknown;
+  }
 
-  const device::Kernel::WorkGroupInfo* wrkGrpInfo = kernel.getDeviceKernel(device)->workGroupInfo();
   if (bCalcPotentialBlkSz == false) {
     if (inputBlockSize <= 0) {
       return hipErrorInvalidValue;
     }
     *bestBlockSize = 0;
     // Make sure the requested block size is smaller than max supported
-    if (inputBlockSize > int(device.info().maxWorkGroupSize_)) {
+    if (inputBlockSize > limits.maxBlockSize_) {
       *maxBlocksPerCU = 0;
       *numBlocksPerGrid = 0;
       return hipSuccess;
     }
   } else {
-    if (inputBlockSize > int(device.info().maxWorkGroupSize_) || inputBlockSize <= 0) {
+    if (inputBlockSize > limits.maxBlockSize_ || inputBlockSize <= 0) {
       // The user wrote the kernel to work with a workgroup size
       // bigger than this hardware can support. Or they do not care
       // about the size So just assume its maximum size is
       // constrained by hardware
-      inputBlockSize = device.info().maxWorkGroupSize_;
-    }
-  }
-  // Find wave occupancy per CU => simd_per_cu * GPR usage
-  size_t MaxWavesPerSimd;
-
-  if (device.isa().versionMajor() <= 9) {
-    MaxWavesPerSimd = 8;  // Limited by SPI 32 per CU, hence 8 per SIMD
-  } else {
-    MaxWavesPerSimd = 16;
-  }
-  size_t VgprWaves = MaxWavesPerSimd;
-  uint32_t VgprGranularity = device.info().vgprAllocGranularity_;
-  size_t maxVGPRs = device.info().vgprsPerSimd_;
-  size_t wavefrontSize = wrkGrpInfo->wavefrontSize_;
-  if (device.isa().versionMajor() >= 10) {
-    if (wavefrontSize == 64) {
-      maxVGPRs = maxVGPRs >> 1;
-      VgprGranularity = VgprGranularity >> 1;
+      inputBlockSize = limits.maxBlockSize_;
     }
   }
-  if (wrkGrpInfo->usedVGPRs_ > 0) {
-    VgprWaves = maxVGPRs / amd::alignUp(wrkGrpInfo->usedVGPRs_, VgprGranularity);
-  }
-
-  if (VgprWaves == 0) {
-    // This should not happen ideally, but in case the usedVGPRs_/availableVGPRs_ values are
-    // incorrect, it can lead to a crash. By returning error, API can exit gracefully.
-    return hipErrorUnknown;
-  }
-
-  size_t GprWaves = VgprWaves;
-  if (wrkGrpInfo->usedSGPRs_ > 0) {
-    size_t maxSGPRs = device.info().sgprsPerSimd_;
-    const size_t SgprWaves = maxSGPRs / amd::alignUp(wrkGrpInfo->usedSGPRs_, 16);
-    GprWaves = std::min(VgprWaves, SgprWaves);
-  }
-  uint32_t simdPerCU = (device.isa().versionMajor() <= 9) ? device.info().simdPerCU_
-                                                          : (wrkGrpInfo->isWGPMode_ ? 4 : 2);
-  const size_t alu_occupancy = simdPerCU * std::min(MaxWavesPerSimd, GprWaves);
-  const int alu_limited_threads = alu_occupancy * wrkGrpInfo->wavefrontSize_;
+  const int alu_limited_threads = limits.aluLimitedThreads_;
 
   int lds_occupancy_wgs = INT_MAX;
-  const size_t total_used_lds = wrkGrpInfo->usedLDSSize_ + dynamicSMemSize;
+  const size_t total_used_lds = limits.staticLds_ + dynamicSMemSize;
   if (total_used_lds != 0) {
-    lds_occupancy_wgs = static_cast<int>(device.info().localMemSize_ / total_used_lds);
+    lds_occupancy_wgs = static_cast<int>(limits.ldsPerCU_ / total_used_lds);
   }
-  // Calculate how many blocks of inputBlockSize we can fit per CU
-  // Need to align with hardware wavefront size. If they want 65 threads, but
-  // waves are 64, then we need 128 threads per block.
-  // So this calculates how many blocks we can fit.
-  *maxBlocksPerCU = alu_limited_threads / amd::alignUp(inputBlockSize, wrkGrpInfo->wavefrontSize_);
-  // Unless those blocks are further constrained by LDS size.
-  *maxBlocksPerCU = std::min(*maxBlocksPerCU, lds_occupancy_wgs);
+  // Calculate how many blocks of inputBlockSize we can fit per CU, constrained by LDS size
+  *maxBlocksPerCU = hip::OccupancyBlocksPerCU(limits, inputBlockSize, dynamicSMemSize);
 
   // Some callers of this function want to return the block size, in threads, that
   // leads to the maximum occupancy. In that case, inputBlockSize is the maximum
@@ -416,18 +377,12 @@ hipError_t ihipOccupancyMaxActiveBlocksPerMultiprocessor(
   // user. e.g., if the user indicates the maximum block size is 64 threads, but we
   // calculate that 128 threads can fit in each CU, we have to give up and return 64.
   *bestBlockSize =
-      std::min(alu_limited_threads, amd::alignUp(inputBlockSize, wrkGrpInfo->wavefrontSize_));
+      std::min(alu_limited_threads, amd::alignUp(inputBlockSize, limits.wavefrontSize_));
   // If the best block size is smaller than the block size used to fit the maximum,
   // then we need to make the grid bigger for full occupancy.
   const int bestBlocksPerCU = alu_limited_threads / (*bestBlockSize);
-  uint32_t maxCUs = device.info().maxComputeUnits_;
-  if (wrkGrpInfo->isWGPMode_ == false && device.settings().enableWgpMode_ == true) {
-    maxCUs *= 2;
-  } else if ((wrkGrpInfo->isWGPMode_ == true && device.settings().enableWgpMode_ == false)) {
-    maxCUs /= 2;
-  }
   // Unless those blocks are further constrained by LDS size.
-  *numBlocksPerGrid = (maxCUs * std::min(bestBlocksPerCU, lds_occupancy_wgs));
+  *numBlocksPerGrid = (limits.maxCUs_ * std::min(bestBlocksPerCU, lds_occupancy_wgs));
 
   return hipSuccess;
 }
@@ -603,6 +558,79 @@ hipError_t hipOccupancyMaxActiveBlocksPerMultiprocessorWithFlags(int* numBlocks,
   HIP_RETURN(ret);
 }
 
+static hipError_t ihipGetOccupancyLimits(hip::OccupancyLimits* limits, hipFunction_t func) {
+  const amd::Device& device = *hip::getCurrentDevice()->devices()[0];
+  if (!hip::DeviceFunc::asFunction(func)->getOccupancyLimits(device, limits)) {
+    return hipErrorUnknown;
+  }
+  return hipSuccess;
+}
+
+hipError_t hipModuleOccupancyMaxPotentialBlockSizeVariableSMem(
+    int* gridSize, int* blockSize, hipFunction_t f, hipOccupancyB2DSize blockSizeToDynamicSMemSize,
+    int blockSizeLimit) {
+  HIP_INIT_API(hipModuleOccupancyMaxPotentialBlockSizeVariableSMem, f, blockSizeToDynamicSMemSize,
+               blockSizeLimit);
+  if ((gridSize == nullptr) || (blockSize == nullptr) || (f == nullptr) ||
+      (blockSizeToDynamicSMemSize == nullptr)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  hip::OccupancyLimits limits;
+  HIP_RETURN_ONFAIL(ihipGetOccupancyLimits(&limits, f));
+  hip::OccupancyMaxPotentialBlockSize(limits, blockSizeToDynamicSMemSize, 0, blockSizeLimit,
+                                      gridSize, blockSize);
+  HIP_RETURN(hipSuccess);
+}
+
+hipError_t hipExtOccupancyMaxPotentialBlockSizeVariableSMem(
+    int* gridSize, int* blockSize, const void* f, hipOccupancyB2DSize blockSizeToDynamicSMemSize,
+    int blockSizeLimit) {
+  HIP_INIT_API(hipExtOccupancyMaxPotentialBlockSizeVariableSMem, f, blockSizeToDynamicSMemSize,
+               blockSizeLimit);
+  if ((gridSize == nullptr) || (blockSize == nullptr) || (blockSizeToDynamicSMemSize == nullptr)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  hipFunction_t func = nullptr;
+  hipError_t hip_error = PlatformState::instance().getStatFunc(&func, f, ihipGetDevice());
+  if ((hip_error != hipSuccess) || (func == nullptr)) {
+    HIP_RETURN(hipErrorInvalidDeviceFunction);
+  }
+  hip::OccupancyLimits limits;
+  HIP_RETURN_ONFAIL(ihipGetOccupancyLimits(&limits, func));
+  hip::OccupancyMaxPotentialBlockSize(limits, blockSizeToDynamicSMemSize, 0, blockSizeLimit,
+                                      gridSize, blockSize);
+  HIP_RETURN(hipSuccess);
+}
+
+hipError_t hipModuleOccupancyAvailableDynamicSMemPerBlock(size_t* dynamicSmemSize, hipFunction_t f,
+                                                          int numBlocks, int blockSize) {
+  HIP_INIT_API(hipModuleOccupancyAvailableDynamicSMemPerBlock, f, numBlocks, blockSize);
+  if ((dynamicSmemSize == nullptr) || (f == nullptr) || (numBlocks <= 0) || (blockSize <= 0)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  hip::OccupancyLimits limits;
+  HIP_RETURN_ONFAIL(ihipGetOccupancyLimits(&limits, f));
+  *dynamicSmemSize = hip::OccupancyAvailableDynamicSMem(limits, numBlocks, blockSize);
+  HIP_RETURN(hipSuccess, *dynamicSmemSize);
+}
+
+hipError_t hipOccupancyAvailableDynamicSMemPerBlock(size_t* dynamicSmemSize, const void* f,
+                                                    int numBlocks, int blockSize) {
+  HIP_INIT_API(hipOccupancyAvailableDynamicSMemPerBlock, f, numBlocks, blockSize);
+  if ((dynamicSmemSize == nullptr) || (numBlocks <= 0) || (blockSize <= 0)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  hipFunction_t func = nullptr;
+  hipError_t hip_error = PlatformState::instance().getStatFunc(&func, f, ihipGetDevice());
+  if ((hip_error != hipSuccess) || (func == nullptr)) {
+    HIP_RETURN(hipErrorInvalidDeviceFunction);
+  }
+  hip::OccupancyLimits limits;
+  HIP_RETURN_ONFAIL(ihipGetOccupancyLimits(&limits, func));
+  *dynamicSmemSize = hip::OccupancyAvailableDynamicSMem(limits, numBlocks, blockSize);
+  HIP_RETURN(hipSuccess, *dynamicSmemSize);
+}
+
 hipError_t ihipLaunchKernel(const void* hostFunction, dim3 gridDim, dim3 blockDim, void** args,
                             size_t sharedMemBytes, hipStream_t stream, hipEvent_t startEvent,
                             hipEvent_t stopEvent, int flags) {
@@ -28,9 +28,10 @@ namespace hip {
 
 // ================================================================================================
 Stream::Stream(hip::Device* dev, Priority p, unsigned int f, bool null_stream,
-               const std::vector<uint32_t>& cuMask, hipStreamCaptureStatus captureStatus)
+               const std::vector<uint32_t>& cuMask, hipStreamCaptureStatus captureStatus,
+               bool dedicatedQueue)
     : amd::HostQueue(*dev->asContext(), *dev->devices()[0], 0, amd::CommandQueue::RealTimeDisabled,
-        convertToQueuePriority(p), cuMask),
+        convertToQueuePriority(p), cuMask, dedicatedQueue),
       lock_("Stream Callback lock"),
       device_(dev),
       priority_(p),
@@ -200,6 +201,16 @@ static hipError_t ihipStreamCreate(hipStream_t* stream,
   return hipSuccess;
 }
 
+// ================================================================================================
+static hip::Stream::Priority ihipStreamPriority(int priority) {
+  if (priority <= hip::Stream::Priority::High) {
+    return hip::Stream::Priority::High;
+  } else if (priority >= hip::Stream::Priority::Low) {
+    return hip::Stream::Priority::Low;
+  }
+  return hip::Stream::Priority::Normal;
+}
+
 // ================================================================================================
 
 stream_per_thread::stream_per_thread() {
@@ -293,16 +304,7 @@ hipError_t hipStreamCreateWithPriority(hipStream_t* stream, unsigned int flags,
     HIP_RETURN(hipErrorInvalidValue);
   }
 
-  hip::Stream::Priority streamPriority;
-  if (priority <= hip::Stream::Priority::High) {
-    streamPriority = hip::Stream::Priority::High;
-  } else if (priority >= hip::Stream::Priority::Low) {
-    streamPriority = hip::Stream::Priority::Low;
-  } else {
-    streamPriority = hip::Stream::Priority::Normal;
-  }
-
-  HIP_RETURN(ihipStreamCreate(stream, flags, streamPriority), *stream);
+  HIP_RETURN(ihipStreamCreate(stream, flags, ihipStreamPriority(priority)), *stream);
 }
 
 // ================================================================================================
@@ -436,10 +438,10 @@ hipError_t hipStreamDestroy(hipStream_t stream) {
 void WaitThenDecrementSignal(hipStream_t stream, hipError_t status, void* user_data) {
   CallbackData* data =  reinterpret_cast<CallbackData*>(user_data);
   int offset = data->previous_read_index % IPC_SIGNALS_PER_EVENT;
-  while (data->shmem->read_index < data->previous_read_index + IPC_SIGNALS_PER_EVENT &&
-         data->shmem->signal[offset] != 0) {
-    amd::Os::sleep(1);
-  }
+  IpcEventShmemWait(data->shmem, [data, offset]() {
+    return data->shmem->read_index >= data->previous_read_index + IPC_SIGNALS_PER_EVENT ||
+           data->shmem->signal[offset] == 0;
+  });
   delete data;
 }
 
@@ -677,6 +679,29 @@ hipError_t hipExtStreamCreateWithCUMask(hipStream_t* stream, uint32_t cuMaskSize
   HIP_RETURN(ihipStreamCreate(stream, hipStreamDefault, hip::Stream::Priority::Normal, cuMaskv), *stream);
 }
 
+// ================================================================================================
+hipError_t hipExtStreamCreateInCUPool(hipStream_t* stream, const char* poolName,
+                                      unsigned int flags, int priority) {
+  HIP_INIT_API(hipExtStreamCreateInCUPool, stream, poolName, flags, priority);
+
+  if (stream == nullptr || poolName == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+
+  hip::Device* device = hip::getCurrentDevice();
+  // Hold the pools, so a concurrent partitioning can't miss the new stream
+  amd::ScopedLock lock(device->CuPoolLock());
+  hip::CuPool* pool = device->FindCuPool(poolName);
+  if (pool == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  hipError_t status = ihipStreamCreate(stream, flags, ihipStreamPriority(priority), pool->cuMask_);
+  if (status == hipSuccess) {
+    pool->streams_.insert(reinterpret_cast<hip::Stream*>(*stream));
+  }
+  HIP_RETURN(status, *stream);
+}
+
 // ================================================================================================
 hipError_t hipStreamGetPriority_common(hipStream_t stream, int* priority) {
   if ((priority != nullptr) && (stream == nullptr)) {
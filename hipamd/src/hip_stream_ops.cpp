@@ -23,6 +23,27 @@
 #include "platform/command_utils.hpp"
 
 namespace hip {
+// Converts the wait condition of the stream operations to the ROCclr condition
+static bool ihipStreamWaitFlags(unsigned int flags, unsigned int* outFlags) {
+  switch (flags) {
+    case hipStreamWaitValueGte:
+      *outFlags = ROCCLR_STREAM_WAIT_VALUE_GTE;
+    break;
+    case hipStreamWaitValueEq:
+      *outFlags = ROCCLR_STREAM_WAIT_VALUE_EQ;
+    break;
+    case hipStreamWaitValueAnd:
+      *outFlags = ROCCLR_STREAM_WAIT_VALUE_AND;
+    break;
+    case hipStreamWaitValueNor:
+      *outFlags = ROCCLR_STREAM_WAIT_VALUE_NOR;
+    break;
+    default:
+      return false;
+  }
+  return true;
+}
+
 hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void* ptr,
                                uint64_t value, uint64_t mask, unsigned int flags, size_t sizeBytes) {
   size_t offset = 0;
@@ -49,22 +70,8 @@ hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void
       if (GPU_STREAMOPS_CP_WAIT && (!(memory->getMemFlags() & ROCCLR_MEM_HSA_SIGNAL_MEMORY))) {
       return hipErrorInvalidValue;
     }
-    switch (flags) {
-      case hipStreamWaitValueGte:
-        outFlags = ROCCLR_STREAM_WAIT_VALUE_GTE;
-      break;
-      case hipStreamWaitValueEq:
-        outFlags = ROCCLR_STREAM_WAIT_VALUE_EQ;
-      break;
-      case hipStreamWaitValueAnd:
-        outFlags = ROCCLR_STREAM_WAIT_VALUE_AND;
-      break;
-      case hipStreamWaitValueNor:
-        outFlags = ROCCLR_STREAM_WAIT_VALUE_NOR;
-      break;
-      default:
-        return hipErrorInvalidValue;
-      break;
+    if (!ihipStreamWaitFlags(flags, &outFlags)) {
+      return hipErrorInvalidValue;
     }
   } else if (cmdType != ROCCLR_COMMAND_STREAM_WRITE_VALUE) {
     return hipErrorInvalidValue;
@@ -85,6 +92,99 @@ hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void
   return hipSuccess;
 }
 
+// ================================================================================================
+hipError_t ihipBatchMemOpOperations(size_t count, const hipStreamBatchMemOpParams* paramArray,
+                                    unsigned int flags,
+                                    std::vector<amd::BatchStreamOperationCommand::Operation>* ops) {
+  if ((count == 0) || (paramArray == nullptr) || (flags != 0)) {
+    return hipErrorInvalidValue;
+  }
+  ops->clear();
+  ops->reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const hipStreamBatchMemOpParams& param = paramArray[i];
+    amd::BatchStreamOperationCommand::Operation op = {};
+    void* ptr = nullptr;
+    switch (param.operation) {
+      case hipStreamMemOpWaitValue32:
+      case hipStreamMemOpWaitValue64: {
+        const bool is64 = (param.operation == hipStreamMemOpWaitValue64);
+        if ((param.waitValue.alias != nullptr) ||
+            !ihipStreamWaitFlags(param.waitValue.flags, &op.flags_)) {
+          return hipErrorInvalidValue;
+        }
+        op.type_ = ROCCLR_COMMAND_STREAM_WAIT_VALUE;
+        op.value_ = is64 ? param.waitValue.value64 : param.waitValue.value;
+        op.mask_ = is64 ? ~0ULL : 0xFFFFFFFFULL;
+        op.sizeBytes_ = is64 ? sizeof(uint64_t) : sizeof(uint32_t);
+        ptr = param.waitValue.address;
+        break;
+      }
+      case hipStreamMemOpWriteValue32:
+      case hipStreamMemOpWriteValue64: {
+        const bool is64 = (param.operation == hipStreamMemOpWriteValue64);
+        if ((param.writeValue.alias != nullptr) || (param.writeValue.flags != 0)) {
+          return hipErrorInvalidValue;
+        }
+        op.type_ = ROCCLR_COMMAND_STREAM_WRITE_VALUE;
+        op.value_ = is64 ? param.writeValue.value64 : param.writeValue.value;
+        op.sizeBytes_ = is64 ? sizeof(uint64_t) : sizeof(uint32_t);
+        ptr = param.writeValue.address;
+        break;
+      }
+      case hipStreamMemOpFlushRemoteWrites:
+      case hipStreamMemOpBarrier:
+        // Both only order the memory accesses, the stream doesn't cache remote writes
+        op.type_ = ROCCLR_COMMAND_STREAM_MEM_BARRIER;
+        break;
+      default:
+        return hipErrorInvalidValue;
+    }
+    if (op.type_ != ROCCLR_COMMAND_STREAM_MEM_BARRIER) {
+      if (ptr == nullptr) {
+        return hipErrorInvalidValue;
+      }
+      amd::Memory* memory = getMemoryObject(ptr, op.offset_);
+      if ((memory == nullptr) || (memory->asBuffer() == nullptr)) {
+        return hipErrorInvalidValue;
+      }
+      op.memory_ = memory;
+    }
+    ops->push_back(op);
+  }
+  return hipSuccess;
+}
+
+// ================================================================================================
+hipError_t ihipStreamBatchMemOp(hipStream_t stream, unsigned int count,
+                                hipStreamBatchMemOpParams* paramArray, unsigned int flags) {
+  STREAM_CAPTURE(hipStreamBatchMemOp, stream, count, paramArray, flags);
+
+  if (!hip::isValid(stream)) {
+    return hipErrorContextIsDestroyed;
+  }
+
+  // Validate the whole batch before anything is enqueued
+  std::vector<amd::BatchStreamOperationCommand::Operation> ops;
+  hipError_t status = ihipBatchMemOpOperations(count, paramArray, flags, &ops);
+  if (status != hipSuccess) {
+    return status;
+  }
+
+  hip::Stream* hip_stream = hip::getStream(stream);
+  amd::Command::EventWaitList waitList;
+
+  amd::BatchStreamOperationCommand* command =
+    new amd::BatchStreamOperationCommand(*hip_stream, waitList, ops);
+
+  if (command == nullptr) {
+    return hipErrorOutOfMemory;
+  }
+  command->enqueue();
+  command->release();
+  return hipSuccess;
+}
+
 hipError_t hipStreamWaitValue32(hipStream_t stream, void* ptr, uint32_t value, unsigned int flags,
                                 uint32_t mask) {
   HIP_INIT_API(hipStreamWaitValue32, stream, ptr, value, mask, flags);
@@ -136,4 +236,10 @@ hipError_t hipStreamWriteValue64(hipStream_t stream, void* ptr, uint64_t value,
       0,  // flags un-used for now set it to 0
       sizeof(uint64_t)));
 }
+
+hipError_t hipStreamBatchMemOp(hipStream_t stream, unsigned int count,
+                               hipStreamBatchMemOpParams* paramArray, unsigned int flags) {
+  HIP_INIT_API(hipStreamBatchMemOp, stream, count, paramArray, flags);
+  HIP_RETURN_DURATION(ihipStreamBatchMemOp(stream, count, paramArray, flags));
+}
 }  // namespace hip
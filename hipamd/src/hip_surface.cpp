@@ -27,9 +27,10 @@ struct __hip_surface {
   uint32_t imageSRD[HIP_IMAGE_OBJECT_SIZE_DWORD];
   amd::Image* image;
   hipResourceDesc resDesc;
+  hip::Device* owner;  // Owner of the descriptor slab
 
   __hip_surface(amd::Image* image_, const hipResourceDesc& resDesc_)
-      : image(image_), resDesc(resDesc_) {
+      : image(image_), resDesc(resDesc_), owner(hip::getCurrentDevice()) {
     amd::Context& context = *hip::getCurrentDevice()->asContext();
     amd::Device& device = *context.devices()[0];
 
@@ -40,7 +41,6 @@ struct __hip_surface {
 
 namespace hip {
 
-hipError_t ihipFree(void* ptr);
 hipError_t ihipCreateSurfaceObject(hipSurfaceObject_t* pSurfObject,
                                    const hipResourceDesc* pResDesc) {
   amd::Device* device = hip::getCurrentDevice()->devices()[0];
@@ -73,10 +73,8 @@ hipError_t ihipCreateSurfaceObject(hipSurfaceObject_t* pSurfObject,
   }
   image = as_amd(memObj)->asImage();
 
-  void* surfObjectBuffer = nullptr;
-  hipError_t err = ihipMalloc(&surfObjectBuffer, sizeof(__hip_surface),
-                              CL_MEM_SVM_FINE_GRAIN_BUFFER);
-  if (surfObjectBuffer == nullptr || err != hipSuccess) {
+  void* surfObjectBuffer = hip::getCurrentDevice()->AllocDescriptor(sizeof(__hip_surface));
+  if (surfObjectBuffer == nullptr) {
     return hipErrorOutOfMemory;
   }
   *pSurfObject = new (surfObjectBuffer) __hip_surface{image, *pResDesc};
@@ -96,7 +94,10 @@ hipError_t ihipDestroySurfaceObject(hipSurfaceObject_t surfaceObject) {
     return hipSuccess;
   }
 
-  return ihipFree(surfaceObject);
+  hip::Device* owner = surfaceObject->owner;
+  surfaceObject->~__hip_surface();
+  owner->FreeDescriptor(surfaceObject);
+  return hipSuccess;
 }
 
 hipError_t hipDestroySurfaceObject(hipSurfaceObject_t surfaceObject) {
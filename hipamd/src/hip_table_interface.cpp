@@ -1808,3 +1808,116 @@ hipError_t hipDrvGraphMemcpyNodeSetParams(hipGraphNode_t hNode, const HIP_MEMCPY
 hipError_t hipExtHostAlloc(void** ptr, size_t size, unsigned int flags) {
   return hip::GetHipDispatchTable()->hipExtHostAlloc_fn(ptr, size, flags);
 }
+hipError_t hipMemcpyBatchAsync(void** dsts, void** srcs, size_t* sizes, size_t count,
+                               hipMemcpyAttributes* attrs, size_t* attrsIdxs, size_t numAttrs,
+                               size_t* failIdx, hipStream_t stream) {
+  return hip::GetHipDispatchTable()->hipMemcpyBatchAsync_fn(dsts, srcs, sizes, count, attrs,
+      attrsIdxs, numAttrs, failIdx, stream);
+}
+hipError_t hipModuleOccupancyMaxPotentialBlockSizeVariableSMem(
+    int* gridSize, int* blockSize, hipFunction_t f, hipOccupancyB2DSize blockSizeToDynamicSMemSize,
+    int blockSizeLimit) {
+  return hip::GetHipDispatchTable()->hipModuleOccupancyMaxPotentialBlockSizeVariableSMem_fn(
+      gridSize, blockSize, f, blockSizeToDynamicSMemSize, blockSizeLimit);
+}
+hipError_t hipExtOccupancyMaxPotentialBlockSizeVariableSMem(
+    int* gridSize, int* blockSize, const void* f, hipOccupancyB2DSize blockSizeToDynamicSMemSize,
+    int blockSizeLimit) {
+  return hip::GetHipDispatchTable()->hipExtOccupancyMaxPotentialBlockSizeVariableSMem_fn(
+      gridSize, blockSize, f, blockSizeToDynamicSMemSize, blockSizeLimit);
+}
+hipError_t hipModuleOccupancyAvailableDynamicSMemPerBlock(size_t* dynamicSmemSize, hipFunction_t f,
+                                                          int numBlocks, int blockSize) {
+  return hip::GetHipDispatchTable()->hipModuleOccupancyAvailableDynamicSMemPerBlock_fn(
+      dynamicSmemSize, f, numBlocks, blockSize);
+}
+hipError_t hipOccupancyAvailableDynamicSMemPerBlock(size_t* dynamicSmemSize, const void* f,
+                                                    int numBlocks, int blockSize) {
+  return hip::GetHipDispatchTable()->hipOccupancyAvailableDynamicSMemPerBlock_fn(
+      dynamicSmemSize, f, numBlocks, blockSize);
+}
+hipError_t hipExtDumpLockProfile() {
+  return hip::GetHipDispatchTable()->hipExtDumpLockProfile_fn();
+}
+hipError_t hipExtSetMemWatermarkCallback(int device, size_t lowFree, size_t highFree,
+                                         hipExtMemWatermarkCallback callback, void* userData) {
+  return hip::GetHipDispatchTable()->hipExtSetMemWatermarkCallback_fn(device, lowFree, highFree,
+      callback, userData);
+}
+hipError_t hipStreamBatchMemOp(hipStream_t stream, unsigned int count,
+                               hipStreamBatchMemOpParams* paramArray, unsigned int flags) {
+  return hip::GetHipDispatchTable()->hipStreamBatchMemOp_fn(stream, count, paramArray, flags);
+}
+hipError_t hipGraphAddBatchMemOpNode(hipGraphNode_t* phGraphNode, hipGraph_t hGraph,
+                                     const hipGraphNode_t* dependencies, size_t numDependencies,
+                                     const hipBatchMemOpNodeParams* nodeParams) {
+  return hip::GetHipDispatchTable()->hipGraphAddBatchMemOpNode_fn(phGraphNode, hGraph, dependencies,
+      numDependencies, nodeParams);
+}
+hipError_t hipGraphBatchMemOpNodeGetParams(hipGraphNode_t hNode,
+                                           hipBatchMemOpNodeParams* nodeParams_out) {
+  return hip::GetHipDispatchTable()->hipGraphBatchMemOpNodeGetParams_fn(hNode, nodeParams_out);
+}
+hipError_t hipGraphBatchMemOpNodeSetParams(hipGraphNode_t hNode,
+                                           hipBatchMemOpNodeParams* nodeParams) {
+  return hip::GetHipDispatchTable()->hipGraphBatchMemOpNodeSetParams_fn(hNode, nodeParams);
+}
+hipError_t hipGraphExecBatchMemOpNodeSetParams(hipGraphExec_t hGraphExec, hipGraphNode_t hNode,
+                                               const hipBatchMemOpNodeParams* nodeParams) {
+  return hip::GetHipDispatchTable()->hipGraphExecBatchMemOpNodeSetParams_fn(hGraphExec, hNode,
+      nodeParams);
+}
+hipError_t hipGraphConditionalHandleCreate(hipGraphConditionalHandle* pHandle_out, hipGraph_t graph,
+                                           unsigned int defaultLaunchValue, unsigned int flags) {
+  return hip::GetHipDispatchTable()->hipGraphConditionalHandleCreate_fn(pHandle_out, graph,
+      defaultLaunchValue, flags);
+}
+hipError_t hipGraphAddConditionalNode(hipGraphNode_t* pGraphNode, hipGraph_t graph,
+                                      const hipGraphNode_t* pDependencies, size_t numDependencies,
+                                      hipConditionalNodeParams* nodeParams) {
+  return hip::GetHipDispatchTable()->hipGraphAddConditionalNode_fn(pGraphNode, graph, pDependencies,
+      numDependencies, nodeParams);
+}
+hipError_t hipExtDevicePartitionCUs(int device, const hipExtCUPoolDesc* pools,
+                                    unsigned int numPools) {
+  return hip::GetHipDispatchTable()->hipExtDevicePartitionCUs_fn(device, pools, numPools);
+}
+hipError_t hipExtDeviceGetCUPoolCount(int device, unsigned int* count) {
+  return hip::GetHipDispatchTable()->hipExtDeviceGetCUPoolCount_fn(device, count);
+}
+hipError_t hipExtDeviceGetCUPoolInfo(int device, unsigned int index, hipExtCUPoolInfo* info) {
+  return hip::GetHipDispatchTable()->hipExtDeviceGetCUPoolInfo_fn(device, index, info);
+}
+hipError_t hipExtStreamCreateInCUPool(hipStream_t* stream, const char* poolName, unsigned int flags,
+                                      int priority) {
+  return hip::GetHipDispatchTable()->hipExtStreamCreateInCUPool_fn(stream, poolName, flags,
+      priority);
+}
+hipError_t hipExtHostMemCacheGetStats(int device, hipExtHostMemCacheStats* stats) {
+  return hip::GetHipDispatchTable()->hipExtHostMemCacheGetStats_fn(device, stats);
+}
+hipError_t hipExtHostMemCacheTrim(int device, size_t minBytesToKeep) {
+  return hip::GetHipDispatchTable()->hipExtHostMemCacheTrim_fn(device, minBytesToKeep);
+}
+hipError_t hipExtMemMapBatch(const hipExtMemMapOp* ops, size_t count, size_t* failIdx) {
+  return hip::GetHipDispatchTable()->hipExtMemMapBatch_fn(ops, count, failIdx);
+}
+hipError_t hipExtMemMapBatchAsync(const hipExtMemMapOp* ops, size_t count, size_t* failIdx,
+                                  hipStream_t stream) {
+  return hip::GetHipDispatchTable()->hipExtMemMapBatchAsync_fn(ops, count, failIdx, stream);
+}
+hipError_t hipExtMemSetAccessBatch(void* const* ptrs, const size_t* sizes, size_t count,
+                                   const hipMemAccessDesc* desc, size_t descCount,
+                                   size_t* failIdx) {
+  return hip::GetHipDispatchTable()->hipExtMemSetAccessBatch_fn(ptrs, sizes, count, desc, descCount,
+      failIdx);
+}
+hipError_t hipExtMemPrefetchBatchAsync(const void* const* ptrs, const size_t* sizes,
+                                       const int* devices, size_t count, hipStream_t stream) {
+  return hip::GetHipDispatchTable()->hipExtMemPrefetchBatchAsync_fn(ptrs, sizes, devices, count,
+      stream);
+}
+hipError_t hipExtMemAdviseBatch(const void* const* ptrs, const size_t* sizes,
+                                const hipMemoryAdvise* advices, const int* devices, size_t count) {
+  return hip::GetHipDispatchTable()->hipExtMemAdviseBatch_fn(ptrs, sizes, advices, devices, count);
+}
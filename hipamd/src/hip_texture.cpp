@@ -25,6 +25,8 @@
 #include "hip_conversions.hpp"
 #include "platform/sampler.hpp"
 
+#include <tuple>
+
 struct __hip_texture {
   uint32_t imageSRD[HIP_IMAGE_OBJECT_SIZE_DWORD];
   uint32_t samplerSRD[HIP_SAMPLER_OBJECT_SIZE_DWORD];
@@ -33,6 +35,7 @@ struct __hip_texture {
   hipResourceDesc resDesc;
   hipTextureDesc texDesc;
   hipResourceViewDesc resViewDesc;
+  hip::Device* owner;  // Owner of the descriptor slab
 
   __hip_texture(amd::Image* image_,
                 amd::Sampler* sampler_,
@@ -43,7 +46,8 @@ struct __hip_texture {
     sampler(sampler_),
     resDesc(resDesc_),
     texDesc(texDesc_),
-    resViewDesc(resViewDesc_) {
+    resViewDesc(resViewDesc_),
+    owner(hip::getCurrentDevice()) {
     amd::Context& context = *hip::getCurrentDevice()->asContext();
     amd::Device& device = *context.devices()[0];
 
@@ -57,7 +61,32 @@ struct __hip_texture {
 
 namespace hip {
 
-hipError_t ihipFree(void* ptr);
+namespace {
+// State of a sampler, which texture objects can share
+struct SamplerState {
+  amd::Context* context_;
+  bool normalizedCoords_;
+  cl_addressing_mode addressMode_;
+  cl_filter_mode filterMode_;
+  cl_filter_mode mipFilterMode_;
+  float minLod_;
+  float maxLod_;
+
+  bool operator<(const SamplerState& rhs) const {
+    return std::tie(context_, normalizedCoords_, addressMode_, filterMode_, mipFilterMode_,
+                    minLod_, maxLod_) <
+           std::tie(rhs.context_, rhs.normalizedCoords_, rhs.addressMode_, rhs.filterMode_,
+                    rhs.mipFilterMode_, rhs.minLod_, rhs.maxLod_);
+  }
+};
+
+amd::SharedObjectCache<SamplerState, amd::Sampler>& SamplerCache() {
+  // Never destroyed, the texture objects may outlive the static destructors
+  static auto* cache = new amd::SharedObjectCache<SamplerState, amd::Sampler>();
+  return *cache;
+}
+}  // namespace
+
 amd::Image* ihipImageCreate(const cl_channel_order channelOrder,
                             const cl_channel_type channelType,
                             const cl_mem_object_type imageType,
@@ -201,23 +230,6 @@ hipError_t ihipCreateTextureObject(hipTextureObject_t* pTexObject,
     mipFilterMode = hip::getCLFilterMode(pTexDesc->mipmapFilterMode);
   }
 
-  amd::Sampler* sampler = new amd::Sampler(*hip::getCurrentDevice()->asContext(),
-                                           pTexDesc->normalizedCoords,
-                                           addressMode,
-                                           filterMode,
-                                           mipFilterMode,
-                                           pTexDesc->minMipmapLevelClamp,
-                                           pTexDesc->maxMipmapLevelClamp);
-
-  if (sampler == nullptr) {
-    return hipErrorOutOfMemory;
-  }
-
-  if (!sampler->create()) {
-    delete sampler;
-    return hipErrorOutOfMemory;
-  }
-
   amd::Image* image = nullptr;
   switch (pResDesc->resType) {
   case hipResourceTypeArray: {
@@ -362,9 +374,29 @@ hipError_t ihipCreateTextureObject(hipTextureObject_t* pTexObject,
   }
   }
 
-  void *texObjectBuffer = nullptr;
-  hipError_t err = ihipMalloc(&texObjectBuffer, sizeof(__hip_texture), CL_MEM_SVM_FINE_GRAIN_BUFFER);
-  if (texObjectBuffer == nullptr || err != hipSuccess) {
+  // Equal sampler states share one sampler
+  const SamplerState state{hip::getCurrentDevice()->asContext(), pTexDesc->normalizedCoords != 0,
+                           addressMode, filterMode, mipFilterMode,
+                           pTexDesc->minMipmapLevelClamp, pTexDesc->maxMipmapLevelClamp};
+  amd::Sampler* sampler = SamplerCache().acquire(state, [&state]() -> amd::Sampler* {
+    amd::Sampler* sampler = new amd::Sampler(*state.context_, state.normalizedCoords_,
+                                             state.addressMode_, state.filterMode_,
+                                             state.mipFilterMode_, state.minLod_, state.maxLod_);
+    if ((sampler != nullptr) && !sampler->create()) {
+      delete sampler;
+      return nullptr;
+    }
+    return sampler;
+  });
+  if (sampler == nullptr) {
+    image->release();
+    return hipErrorOutOfMemory;
+  }
+
+  void* texObjectBuffer = hip::getCurrentDevice()->AllocDescriptor(sizeof(__hip_texture));
+  if (texObjectBuffer == nullptr) {
+    SamplerCache().release(sampler);
+    image->release();
     return hipErrorOutOfMemory;
   }
   *pTexObject = new (texObjectBuffer) __hip_texture{image, sampler, *pResDesc, *pTexDesc, (pResViewDesc != nullptr) ? *pResViewDesc : hipResourceViewDesc{}};
@@ -397,10 +429,12 @@ hipError_t ihipDestroyTextureObject(hipTextureObject_t texObject) {
   }
 
   // The texture object always owns the sampler SRD.
-  texObject->sampler->release();
+  SamplerCache().release(texObject->sampler);
 
-  // TODO Should call ihipFree() to not polute the api trace.
-  return ihipFree(texObject);
+  hip::Device* owner = texObject->owner;
+  texObject->~__hip_texture();
+  owner->FreeDescriptor(texObject);
+  return hipSuccess;
 }
 
 hipError_t ihipUnbindTexture(textureReference* texRef) {
@@ -21,6 +21,9 @@
 #include <hip/hip_runtime.h>
 #include "hip_internal.hpp"
 #include "hip_vm.hpp"
+
+#include <set>
+
 namespace hip {
 
 static_assert(static_cast<uint32_t>(hipMemAccessFlagsProtNone)
@@ -374,5 +377,273 @@ hipError_t hipMemUnmap(void* ptr, size_t size) {
 
   HIP_RETURN(hipSuccess);
 }
+
+// Validates a batch of map and unmap operations and sorts its ranges into runs
+static hipError_t ihipMemMapBatch_validate(const hipExtMemMapOp* ops, size_t count,
+                                           size_t* failIdx,
+                                           std::vector<amd::VirtualMapCommand::Range>* ranges,
+                                           std::vector<amd::VirtualMapCommand::Run>* runs,
+                                           std::vector<int>* devices) {
+  if (ops == nullptr || count == 0) {
+    return hipErrorInvalidValue;
+  }
+  ranges->reserve(count);
+  devices->reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const hipExtMemMapOp& op = ops[i];
+    if (op.ptr == nullptr || op.size == 0) {
+      *failIdx = i;
+      return hipErrorInvalidValue;
+    }
+    if (op.type == hipExtMemMapOpMap) {
+      if (op.handle == nullptr) {
+        *failIdx = i;
+        return hipErrorInvalidValue;
+      }
+      if (amd::MemObjMap::FindMemObj(op.ptr) != nullptr) {
+        // The address is mapped already
+        *failIdx = i;
+        return hipErrorInvalidValue;
+      }
+      hip::GenericAllocation* ga = reinterpret_cast<hip::GenericAllocation*>(op.handle);
+      ranges->push_back({op.ptr, op.size, &ga->asAmdMemory(), i});
+      devices->push_back(ga->GetProperties().location.id);
+    } else if (op.type == hipExtMemMapOpUnmap) {
+      amd::Memory* vaddr_sub_obj = amd::MemObjMap::FindMemObj(op.ptr);
+      if (vaddr_sub_obj == nullptr || vaddr_sub_obj->getSize() != op.size ||
+          vaddr_sub_obj->getUserData().phys_mem_obj == nullptr) {
+        *failIdx = i;
+        return hipErrorInvalidValue;
+      }
+      ranges->push_back({op.ptr, op.size, nullptr, i});
+      devices->push_back(vaddr_sub_obj->getUserData().phys_mem_obj->getUserData().deviceId);
+    } else {
+      *failIdx = i;
+      return hipErrorInvalidValue;
+    }
+  }
+  if (!amd::device::PlanVirtualMap(ranges, runs, failIdx)) {
+    return hipErrorInvalidValue;
+  }
+  return hipSuccess;
+}
+
+// Updates MemObjMap for a validated batch before it's enqueued: creates and adds the views of
+// the mapped ranges and removes the unmapped ones. The work enqueued after a stream-ordered
+// batch then finds the new mappings as if the batch had executed. Returns false and the index
+// of the failed range in failIdx, if a view can't be created. MemObjMap is unchanged then
+static bool ihipMemMapBatch_publish(std::vector<amd::VirtualMapCommand::Range>* ranges,
+                                    size_t* failIdx) {
+  for (size_t i = 0; i < ranges->size(); ++i) {
+    auto& range = (*ranges)[i];
+    if (range.memory_ == nullptr) {
+      continue;
+    }
+    amd::Memory* phys_mem_obj = range.memory_;
+    constexpr bool kParent = false;
+    range.view_ = phys_mem_obj->getContext().devices()[0]->CreateVirtualBuffer(
+                  phys_mem_obj->getContext(), range.ptr_, range.size_,
+                  phys_mem_obj->getUserData().deviceId, kParent);
+    if (range.view_ == nullptr) {
+      *failIdx = range.index_;
+      for (size_t j = 0; j < i; ++j) {
+        if ((*ranges)[j].view_ != nullptr) {
+          (*ranges)[j].view_->release();
+          (*ranges)[j].view_ = nullptr;
+        }
+      }
+      return false;
+    }
+  }
+
+  for (auto& range : *ranges) {
+    if (range.memory_ != nullptr) {
+      amd::MemObjMap::AddMemObj(range.ptr_, range.view_);
+      range.view_->getUserData().phys_mem_obj = range.memory_;
+      range.memory_->getUserData().vaddr_mem_obj = range.view_;
+    } else {
+      range.view_ = amd::MemObjMap::FindMemObj(range.ptr_);
+      amd::MemObjMap::RemoveMemObj(range.ptr_);
+      range.view_->getUserData().phys_mem_obj->getUserData().vaddr_mem_obj = nullptr;
+      range.view_->getUserData().phys_mem_obj = nullptr;
+    }
+  }
+  return true;
+}
+
+// Releases the allocations a stream-ordered batch unmapped, once the batch executed
+static void CL_CALLBACK ihipMemMapBatchCallback(cl_event event, cl_int command_exec_status,
+                                                void* user_data) {
+  auto unmapped = reinterpret_cast<std::vector<hip::GenericAllocation*>*>(user_data);
+  for (auto ga : *unmapped) {
+    ga->release();
+  }
+  delete unmapped;
+}
+
+// Maps and unmaps a batch. The batch goes to the given stream or, if it's nullptr, to the null
+// streams of the devices owning the allocations as hipMemMap does, then the call waits for it
+static hipError_t ihipMemMapBatch(const hipExtMemMapOp* ops, size_t count, size_t* failIdx,
+                                  hip::Stream* stream) {
+  std::vector<amd::VirtualMapCommand::Range> ranges;
+  std::vector<amd::VirtualMapCommand::Run> runs;
+  std::vector<int> devices;
+  hipError_t status = ihipMemMapBatch_validate(ops, count, failIdx, &ranges, &runs, &devices);
+  if (status != hipSuccess) {
+    return status;
+  }
+
+  // The unmapped allocations are released once the unmap executed. Collect them before
+  // publishing the batch clears the links to them
+  std::vector<hip::GenericAllocation*> unmapped;
+  for (size_t i = 0; i < count; ++i) {
+    if (ops[i].type == hipExtMemMapOpUnmap) {
+      amd::Memory* vaddr_sub_obj = amd::MemObjMap::FindMemObj(ops[i].ptr);
+      amd::Memory* phys_mem_obj = vaddr_sub_obj->getUserData().phys_mem_obj;
+      unmapped.push_back(
+          reinterpret_cast<hip::GenericAllocation*>(phys_mem_obj->getUserData().data));
+    }
+  }
+  if (!ihipMemMapBatch_publish(&ranges, failIdx)) {
+    return hipErrorInvalidValue;
+  }
+  // The mapped allocations stay retained until unmapped
+  for (size_t i = 0; i < count; ++i) {
+    if (ops[i].type == hipExtMemMapOpMap) {
+      reinterpret_cast<hip::GenericAllocation*>(ops[i].handle)->retain();
+    }
+  }
+
+  if (stream != nullptr) {
+    amd::Command* cmd = new amd::VirtualMapCommand(*stream, amd::Command::EventWaitList{},
+                                                   std::move(ranges), std::move(runs));
+    auto released = new std::vector<hip::GenericAllocation*>(std::move(unmapped));
+    unmapped.clear();
+    if (!cmd->setCallback(CL_COMPLETE, ihipMemMapBatchCallback, released)) {
+      // The release can't be deferred, wait for the batch instead
+      unmapped = std::move(*released);
+      delete released;
+      released = nullptr;
+    }
+    cmd->enqueue();
+    if (released != nullptr) {
+      cmd->notifyCmdQueue();
+    } else {
+      cmd->awaitCompletion();
+    }
+    cmd->release();
+  } else {
+    // A command per owning device, the ranges stay sorted
+    std::vector<amd::Command*> commands;
+    for (int device : std::set<int>(devices.begin(), devices.end())) {
+      std::vector<amd::VirtualMapCommand::Range> device_ranges;
+      for (const auto& range : ranges) {
+        if (devices[range.index_] == device) {
+          device_ranges.push_back(range);
+        }
+      }
+      std::vector<amd::VirtualMapCommand::Run> device_runs;
+      size_t discard_idx = 0;
+      amd::device::PlanVirtualMap(&device_ranges, &device_runs, &discard_idx);
+      amd::Command* cmd = new amd::VirtualMapCommand(*g_devices[device]->NullStream(),
+                                                     amd::Command::EventWaitList{},
+                                                     std::move(device_ranges),
+                                                     std::move(device_runs));
+      cmd->enqueue();
+      commands.push_back(cmd);
+    }
+    for (auto cmd : commands) {
+      cmd->awaitCompletion();
+      cmd->release();
+    }
+  }
+
+  for (auto ga : unmapped) {
+    ga->release();
+  }
+  return hipSuccess;
+}
+
+hipError_t hipExtMemMapBatch(const hipExtMemMapOp* ops, size_t count, size_t* failIdx) {
+  HIP_INIT_API(hipExtMemMapBatch, ops, count, failIdx);
+
+  size_t discard_idx = 0;
+  if (failIdx == nullptr) {
+    failIdx = &discard_idx;
+  }
+  *failIdx = std::numeric_limits<size_t>::max();
+
+  HIP_RETURN(ihipMemMapBatch(ops, count, failIdx, nullptr));
+}
+
+hipError_t hipExtMemMapBatchAsync(const hipExtMemMapOp* ops, size_t count, size_t* failIdx,
+                                  hipStream_t stream) {
+  HIP_INIT_API(hipExtMemMapBatchAsync, ops, count, failIdx, stream);
+
+  size_t discard_idx = 0;
+  if (failIdx == nullptr) {
+    failIdx = &discard_idx;
+  }
+  *failIdx = std::numeric_limits<size_t>::max();
+
+  if (!hip::isValid(stream)) {
+    HIP_RETURN(hipErrorContextIsDestroyed);
+  }
+  hip::Stream* hip_stream = hip::getStream(stream);
+  if (hip_stream == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  if (hip_stream->GetCaptureStatus() != hipStreamCaptureStatusNone) {
+    HIP_RETURN(hipErrorStreamCaptureUnsupported);
+  }
+
+  HIP_RETURN(ihipMemMapBatch(ops, count, failIdx, hip_stream));
+}
+
+hipError_t hipExtMemSetAccessBatch(void* const* ptrs, const size_t* sizes, size_t count,
+                                   const hipMemAccessDesc* desc, size_t descCount,
+                                   size_t* failIdx) {
+  HIP_INIT_API(hipExtMemSetAccessBatch, ptrs, sizes, count, desc, descCount, failIdx);
+
+  size_t discard_idx = 0;
+  if (failIdx == nullptr) {
+    failIdx = &discard_idx;
+  }
+  *failIdx = std::numeric_limits<size_t>::max();
+
+  if (ptrs == nullptr || sizes == nullptr || count == 0 || desc == nullptr || descCount == 0) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  for (size_t desc_idx = 0; desc_idx < descCount; ++desc_idx) {
+    if (desc[desc_idx].location.id >= g_devices.size()) {
+      HIP_RETURN(hipErrorInvalidValue);
+    }
+  }
+
+  std::vector<amd::VirtualMapCommand::Range> ranges;
+  ranges.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    ranges.push_back({ptrs[i], sizes[i], nullptr, i});
+  }
+  std::vector<amd::VirtualMapCommand::Run> runs;
+  if (!amd::device::PlanVirtualMap(&ranges, &runs, failIdx)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+
+  // HSA sets the access of a single mapping per call, hence the runs aren't merged
+  for (const auto& range : ranges) {
+    for (size_t desc_idx = 0; desc_idx < descCount; ++desc_idx) {
+      auto& dev = g_devices[desc[desc_idx].location.id];
+      amd::Device::VmmAccess access_flags =
+          static_cast<amd::Device::VmmAccess>(desc[desc_idx].flags);
+      if (!dev->devices()[0]->SetMemAccess(range.ptr_, range.size_, access_flags)) {
+        *failIdx = range.index_;
+        HIP_RETURN(hipErrorInvalidValue);
+      }
+    }
+  }
+
+  HIP_RETURN(hipSuccess);
+}
 } //namespace hip
 
@@ -21,6 +21,7 @@ THE SOFTWARE.
 */
 
 #include <hip/hiprtc.h>
+#include <hip/amd_detail/amd_hiprtc_ext_api.h>
 #include "hiprtcInternal.hpp"
 
 namespace hiprtc {
@@ -226,6 +227,75 @@ hiprtcResult hiprtcGetProgramLogSize(hiprtcProgram prog, size_t* logSizeRet) {
   HIPRTC_RETURN(HIPRTC_SUCCESS);
 }
 
+hiprtcResult hiprtcGetCodeSizeForArch(hiprtcProgram prog, const char* arch, size_t* codeSizeRet) {
+  HIPRTC_INIT_API(prog, arch, codeSizeRet);
+
+  if (arch == nullptr || codeSizeRet == nullptr) {
+    HIPRTC_RETURN(HIPRTC_ERROR_INVALID_INPUT);
+  }
+  auto* rtcProgram = hiprtc::RTCCompileProgram::as_RTCCompileProgram(prog);
+  const std::vector<char>* exec = nullptr;
+  const std::string* log = nullptr;
+  if (!rtcProgram->getArchResult(arch, &exec, &log)) {
+    HIPRTC_RETURN(HIPRTC_ERROR_INVALID_INPUT);
+  }
+  *codeSizeRet = exec->size();
+
+  HIPRTC_RETURN(HIPRTC_SUCCESS);
+}
+
+hiprtcResult hiprtcGetCodeForArch(hiprtcProgram prog, const char* arch, char* code) {
+  HIPRTC_INIT_API(prog, arch, code);
+
+  if (arch == nullptr || code == nullptr) {
+    HIPRTC_RETURN(HIPRTC_ERROR_INVALID_INPUT);
+  }
+  auto* rtcProgram = hiprtc::RTCCompileProgram::as_RTCCompileProgram(prog);
+  const std::vector<char>* exec = nullptr;
+  const std::string* log = nullptr;
+  if (!rtcProgram->getArchResult(arch, &exec, &log)) {
+    HIPRTC_RETURN(HIPRTC_ERROR_INVALID_INPUT);
+  }
+  ::memcpy(code, exec->data(), exec->size());
+
+  HIPRTC_RETURN(HIPRTC_SUCCESS);
+}
+
+hiprtcResult hiprtcGetProgramLogSizeForArch(hiprtcProgram prog, const char* arch,
+                                            size_t* logSizeRet) {
+  HIPRTC_INIT_API(prog, arch, logSizeRet);
+
+  if (arch == nullptr || logSizeRet == nullptr) {
+    HIPRTC_RETURN(HIPRTC_ERROR_INVALID_INPUT);
+  }
+  auto* rtcProgram = hiprtc::RTCCompileProgram::as_RTCCompileProgram(prog);
+  const std::vector<char>* exec = nullptr;
+  const std::string* log = nullptr;
+  if (!rtcProgram->getArchResult(arch, &exec, &log)) {
+    HIPRTC_RETURN(HIPRTC_ERROR_INVALID_INPUT);
+  }
+  *logSizeRet = log->size();
+
+  HIPRTC_RETURN(HIPRTC_SUCCESS);
+}
+
+hiprtcResult hiprtcGetProgramLogForArch(hiprtcProgram prog, const char* arch, char* dst) {
+  HIPRTC_INIT_API(prog, arch, dst);
+
+  if (arch == nullptr || dst == nullptr) {
+    HIPRTC_RETURN(HIPRTC_ERROR_INVALID_INPUT);
+  }
+  auto* rtcProgram = hiprtc::RTCCompileProgram::as_RTCCompileProgram(prog);
+  const std::vector<char>* exec = nullptr;
+  const std::string* log = nullptr;
+  if (!rtcProgram->getArchResult(arch, &exec, &log)) {
+    HIPRTC_RETURN(HIPRTC_ERROR_INVALID_INPUT);
+  }
+  ::memcpy(dst, log->data(), log->size());
+
+  HIPRTC_RETURN(HIPRTC_SUCCESS);
+}
+
 hiprtcResult hiprtcVersion(int* major, int* minor) {
   HIPRTC_INIT_API(major, minor);
 
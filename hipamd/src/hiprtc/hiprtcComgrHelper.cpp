@@ -502,6 +502,94 @@ bool addCodeObjData(amd_comgr_data_set_t& input, const std::vector<char>& source
   return true;
 }
 
+bool copyDataSet(const amd_comgr_data_set_t src, amd_comgr_data_set_t dst,
+                 const amd_comgr_data_kind_t type) {
+  size_t count = 0;
+  if (auto res = amd::Comgr::action_data_count(src, type, &count);
+      res != AMD_COMGR_STATUS_SUCCESS) {
+    return false;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    amd_comgr_data_t data;
+    if (auto res = amd::Comgr::action_data_get_data(src, type, i, &data);
+        res != AMD_COMGR_STATUS_SUCCESS) {
+      return false;
+    }
+    // Both sets reference the same data, the bytes aren't copied
+    auto res = amd::Comgr::data_set_add(dst, data);
+    amd::Comgr::release_data(data);
+    if (res != AMD_COMGR_STATUS_SUCCESS) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool createOffloadBundle(const std::vector<std::pair<std::string, std::vector<char>>>& codeObjects,
+                         std::vector<char>& bundle) {
+  // Layout of clang-offload-bundler: the magic, the entry count and the entry descriptors
+  // {offset, size, id size, id}, followed by the code objects. The host entry is empty.
+  constexpr size_t kCodeObjectAlignment = 4096;
+  // The host entry names the triple of the host compiler, as the bundles of hipcc do
+#if defined(_WIN32)
+  constexpr char const* kHostEntryId = "host-x86_64-pc-windows-msvc";
+#else
+  constexpr char const* kHostEntryId = "host-x86_64-unknown-linux";
+#endif
+
+  std::vector<std::pair<std::string, const std::vector<char>*>> entries;
+  static const std::vector<char> kEmpty;
+  entries.emplace_back(kHostEntryId, &kEmpty);
+  for (const auto& codeObject : codeObjects) {
+    if (codeObject.second.empty()) {
+      return false;
+    }
+    entries.emplace_back(std::string(OFFLOAD_KIND_HIPV4) + '-' + codeObject.first,
+                         &codeObject.second);
+  }
+
+  size_t headerSize = (bundle_magic_string_size - 1) + sizeof(uint64_t);
+  for (const auto& entry : entries) {
+    headerSize += 3 * sizeof(uint64_t) + entry.first.size();
+  }
+
+  // Place the code objects after the header, each one aligned
+  std::vector<uint64_t> offsets;
+  size_t size = headerSize;
+  for (const auto& entry : entries) {
+    if (!entry.second->empty()) {
+      size = amd::alignUp(size, kCodeObjectAlignment);
+    }
+    offsets.push_back(size);
+    size += entry.second->size();
+  }
+
+  bundle.assign(size, 0);
+  char* ptr = bundle.data();
+  auto write = [&ptr](const void* src, size_t bytes) {
+    ::memcpy(ptr, src, bytes);
+    ptr += bytes;
+  };
+  write(CLANG_OFFLOAD_BUNDLER_MAGIC_STR, bundle_magic_string_size - 1);
+  uint64_t numEntries = entries.size();
+  write(&numEntries, sizeof(numEntries));
+  for (size_t i = 0; i < entries.size(); ++i) {
+    uint64_t entrySize = entries[i].second->size();
+    uint64_t idSize = entries[i].first.size();
+    write(&offsets[i], sizeof(uint64_t));
+    write(&entrySize, sizeof(entrySize));
+    write(&idSize, sizeof(idSize));
+    write(entries[i].first.data(), idSize);
+  }
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (!entries[i].second->empty()) {
+      ::memcpy(bundle.data() + offsets[i], entries[i].second->data(), entries[i].second->size());
+    }
+  }
+  return true;
+}
+
 bool extractBuildLog(amd_comgr_data_set_t dataSet, std::string& buildLog) {
   size_t count;
   if (auto res = amd::Comgr::action_data_count(dataSet, AMD_COMGR_DATA_KIND_LOG, &count);
@@ -730,6 +818,45 @@ bool compileToBitCode(const amd_comgr_data_set_t compileInputs, const std::strin
   return true;
 }
 
+bool compileToPrecompiledHeader(const amd_comgr_data_set_t headerInputs, const std::string& isa,
+                                std::vector<std::string>& compileOptions, std::string& buildLog,
+                                std::vector<char>& pch) {
+  // Comgr has no action, which emits a PCH. The front end action of the BC compile is replaced
+  // instead and the output data of the BC kind holds the AST file.
+  std::vector<std::string> pchOptions(compileOptions);
+  pchOptions.push_back("-Xclang");
+  pchOptions.push_back("-emit-pch");
+
+  amd_comgr_action_info_t action;
+  amd_comgr_data_set_t output;
+
+  if (auto res = createAction(action, pchOptions, isa, AMD_COMGR_LANGUAGE_HIP);
+      res != AMD_COMGR_STATUS_SUCCESS) {
+    return false;
+  }
+
+  if (auto res = amd::Comgr::create_data_set(&output); res != AMD_COMGR_STATUS_SUCCESS) {
+    amd::Comgr::destroy_action_info(action);
+    return false;
+  }
+
+  if (auto res = amd::Comgr::do_action(AMD_COMGR_ACTION_COMPILE_SOURCE_TO_BC, action,
+                                       headerInputs, output);
+      res != AMD_COMGR_STATUS_SUCCESS) {
+    extractBuildLog(output, buildLog);
+    amd::Comgr::destroy_action_info(action);
+    amd::Comgr::destroy_data_set(output);
+    return false;
+  }
+
+  bool result = extractByteCodeBinary(output, AMD_COMGR_DATA_KIND_BC, pch);
+
+  // Clean up
+  amd::Comgr::destroy_action_info(action);
+  amd::Comgr::destroy_data_set(output);
+  return result && !pch.empty();
+}
+
 bool linkLLVMBitcode(const amd_comgr_data_set_t linkInputs, const std::string& isa,
                      std::vector<std::string>& linkOptions, std::string& buildLog,
                      std::vector<char>& LinkedLLVMBitcode) {
@@ -35,6 +35,10 @@ bool UnbundleBitCode(const std::vector<char>& bundled_bit_code, const std::strin
                      size_t& co_offset, size_t& co_size);
 bool addCodeObjData(amd_comgr_data_set_t& input, const std::vector<char>& source,
                     const std::string& name, const amd_comgr_data_kind_t type);
+bool copyDataSet(const amd_comgr_data_set_t src, amd_comgr_data_set_t dst,
+                 const amd_comgr_data_kind_t type);
+bool createOffloadBundle(const std::vector<std::pair<std::string, std::vector<char>>>& codeObjects,
+                         std::vector<char>& bundle);
 bool extractBuildLog(amd_comgr_data_set_t dataSet, std::string& buildLog);
 bool extractByteCodeBinary(const amd_comgr_data_set_t inDataSet,
                            const amd_comgr_data_kind_t dataKind, std::vector<char>& bin);
@@ -48,6 +52,9 @@ bool compileToExecutable(const amd_comgr_data_set_t compileInputs, const std::st
 bool compileToBitCode(const amd_comgr_data_set_t compileInputs, const std::string& isa,
                       std::vector<std::string>& compileOptions, std::string& buildLog,
                       std::vector<char>& LLVMBitcode);
+bool compileToPrecompiledHeader(const amd_comgr_data_set_t headerInputs, const std::string& isa,
+                                std::vector<std::string>& compileOptions, std::string& buildLog,
+                                std::vector<char>& pch);
 bool linkLLVMBitcode(const amd_comgr_data_set_t linkInputs, const std::string& isa,
                      std::vector<std::string>& linkOptions, std::string& buildLog,
                      std::vector<char>& LinkedLLVMBitcode);
@@ -22,8 +22,11 @@ THE SOFTWARE.
 
 #include "hiprtcInternal.hpp"
 
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <streambuf>
+#include <thread>
 #include <vector>
 
 #include <sys/stat.h>
@@ -274,8 +277,8 @@ bool RTCCompileProgram::transformOptions(std::vector<std::string>& compile_optio
   for (auto& i : compile_options) {
     if (i == "-hip-pch") {
       LogInfo(
-          "-hip-pch is deprecated option, has no impact on execution of new hiprtc programs, it "
-          "can be removed");
+          "-hip-pch is deprecated option, the builtin header is precompiled with "
+          "HIPRTC_USE_BUILTIN_PCH=1, it can be removed");
       i.clear();
       continue;
     }
@@ -293,13 +296,27 @@ bool RTCCompileProgram::transformOptions(std::vector<std::string>& compile_optio
       std::remove(compile_options.begin(), compile_options.end(), std::string("")),
       compile_options.end());
 
-  if (auto res = std::find_if(
-          compile_options.begin(), compile_options.end(),
-          [](const std::string& str) { return str.find("--offload-arch=") != std::string::npos; });
-      res != compile_options.end()) {
-    auto isaName = getValueOf(*res);
-    isa_ = "amdgcn-amd-amdhsa--" + isaName;
+  isas_.clear();
+  auto isArchOption = [](const std::string& str) {
+    return str.find("--offload-arch=") != std::string::npos;
+  };
+  for (const auto& option : compile_options) {
+    if (isArchOption(option)) {
+      auto isaName = "amdgcn-amd-amdhsa--" + getValueOf(option);
+      if (std::find(isas_.begin(), isas_.end(), isaName) == isas_.end()) {
+        isas_.push_back(isaName);
+      }
+    }
+  }
+  if (!isas_.empty()) {
+    isa_ = isas_[0];
     settings_.offloadArchProvided = true;
+    if (isas_.size() > 1) {
+      // Every target gets its own --offload-arch in compileArchs()
+      compile_options.erase(
+          std::remove_if(compile_options.begin(), compile_options.end(), isArchOption),
+          compile_options.end());
+    }
     return true;
   }
   // App has not provided the gpu archiecture, need to find it
@@ -308,6 +325,211 @@ bool RTCCompileProgram::transformOptions(std::vector<std::string>& compile_optio
 
 amd::Monitor RTCProgram::lock_("HIPRTC Program", true);
 
+// Builtin PCH Member Functions
+amd::Monitor BuiltinPch::lock_("HIPRTC builtin PCH", true);
+std::map<std::string, std::shared_ptr<BuiltinPch::Entry>> BuiltinPch::entries_;
+
+static constexpr const char* kBuiltinHeaderName = "hiprtc_runtime.h";
+
+std::string BuiltinPch::Key(const std::string& isa, const std::vector<std::string>& options) {
+  size_t comgrMajor = 0;
+  size_t comgrMinor = 0;
+  amd::Comgr::get_version(&comgrMajor, &comgrMinor);
+
+  // The AST file is valid for the exact header, compiler and language options only
+  std::string key = "hip " + std::to_string(HIP_VERSION_MAJOR) + '.' +
+                    std::to_string(HIP_VERSION_MINOR) + '.' + std::to_string(HIP_VERSION_PATCH) +
+                    " comgr " + std::to_string(comgrMajor) + '.' + std::to_string(comgrMinor) +
+                    " header " + std::to_string(__hipRTC_header_size) + ' ' + isa;
+  for (const auto& option : HeaderOptions(options)) {
+    key += '\n';
+    key += option;
+  }
+  return key;
+}
+
+bool BuiltinPch::IsCompatible(const std::vector<std::string>& options) {
+  for (const auto& option : options) {
+    // The app's own PCH and the dumps of the intermediate files need the plain header parse
+    if (option.rfind("-include-pch", 0) == 0 || option.find("save-temps") != std::string::npos) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::string> BuiltinPch::PchOptions(const std::vector<std::string>& options) {
+  std::vector<std::string> res;
+  res.reserve(options.size());
+  for (size_t i = 0; i < options.size(); ++i) {
+    if (options[i] == "-include" && (i + 1) < options.size() &&
+        options[i + 1] == kBuiltinHeaderName) {
+      ++i;
+      continue;
+    }
+    res.push_back(options[i]);
+  }
+  return res;
+}
+
+std::vector<std::string> BuiltinPch::HeaderOptions(const std::vector<std::string>& options) {
+  std::vector<std::string> res;
+  res.reserve(options.size());
+  for (size_t i = 0; i < options.size(); ++i) {
+    const std::string& option = options[i];
+    if (option == "-include" && (i + 1) < options.size() &&
+        options[i + 1] == kBuiltinHeaderName) {
+      ++i;
+      continue;
+    }
+    // The diagnostics, the debug info and the backend options don't change the parsed header,
+    // so the programs, which differ in them only, share the PCH
+    if (option == "-mllvm" && (i + 1) < options.size()) {
+      ++i;
+      continue;
+    }
+    if (option.rfind("-W", 0) == 0 || option == "-w" || option.rfind("-g", 0) == 0 ||
+        option.rfind("-Rpass", 0) == 0) {
+      continue;
+    }
+    res.push_back(option);
+  }
+  return res;
+}
+
+bool BuiltinPch::IsPchError(const std::string& log) {
+  // Clang reports a rejected AST file with one of these, the other errors are in the source
+  for (const char* pattern : {"PCH file", "precompiled header", "AST file"}) {
+    if (log.find(pattern) != std::string::npos) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool BuiltinPch::Build(const std::string& isa, const std::vector<std::string>& options,
+                       std::vector<char>& pch) {
+  amd_comgr_data_set_t input;
+  if (amd::Comgr::create_data_set(&input) != AMD_COMGR_STATUS_SUCCESS) {
+    return false;
+  }
+  std::vector<char> header(__hipRTC_header, __hipRTC_header + __hipRTC_header_size);
+  std::vector<std::string> pchOptions = HeaderOptions(options);
+  std::string log;
+  bool result = addCodeObjData(input, header, kBuiltinHeaderName, AMD_COMGR_DATA_KIND_SOURCE) &&
+                compileToPrecompiledHeader(input, isa, pchOptions, log, pch);
+  amd::Comgr::destroy_data_set(input);
+  if (!result) {
+    LogPrintfInfo("Unable to precompile the builtin header: %s", log.c_str());
+  }
+  return result;
+}
+
+std::string BuiltinPch::CacheFile(const std::string& key) {
+  if (HIPRTC_PCH_CACHE_PATH == nullptr || HIPRTC_PCH_CACHE_PATH[0] == '\0') {
+    return std::string();
+  }
+  std::stringstream name;
+  name << HIPRTC_PCH_CACHE_PATH << "/hiprtc_" << std::hex << std::hash<std::string>{}(key)
+       << ".pch";
+  return name.str();
+}
+
+bool BuiltinPch::Load(const std::string& key, std::vector<char>& pch) {
+  std::string fileName = CacheFile(key);
+  if (fileName.empty()) {
+    return false;
+  }
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  // The file starts with the full key, which resolves the hash collisions
+  if (data.size() <= key.size() + 1 || !std::equal(key.begin(), key.end(), data.begin()) ||
+      data[key.size()] != '\0') {
+    return false;
+  }
+  pch.assign(data.begin() + key.size() + 1, data.end());
+  return true;
+}
+
+void BuiltinPch::Store(const std::string& key, const std::vector<char>& pch) {
+  std::string fileName = CacheFile(key);
+  if (fileName.empty()) {
+    return;
+  }
+  // Write a unique file and rename it, so the concurrent processes never read a partial PCH
+  std::string tmpName = fileName + ".XXXXXX";
+  GenerateUniqueFileName(tmpName);
+  {
+    std::ofstream file(tmpName, std::ios::binary);
+    if (!file) {
+      LogPrintfInfo("Unable to write the builtin PCH into %s", tmpName.c_str());
+      return;
+    }
+    file.write(key.c_str(), key.size() + 1);
+    file.write(pch.data(), pch.size());
+    if (!file) {
+      file.close();
+      std::remove(tmpName.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    std::remove(tmpName.c_str());
+  }
+}
+
+std::shared_ptr<const std::vector<char>> BuiltinPch::Get(const std::string& isa,
+                                                         const std::vector<std::string>& options) {
+  if (!HIPRTC_USE_BUILTIN_PCH || !IsCompatible(options)) {
+    return nullptr;
+  }
+  std::string key = Key(isa, options);
+  std::shared_ptr<Entry> entry;
+  {
+    amd::ScopedLock lock(lock_);
+    auto& slot = entries_[key];
+    if (slot == nullptr) {
+      slot = std::make_shared<Entry>();
+    }
+    entry = slot;
+  }
+
+  // Only one thread builds the PCH of a signature, the others wait for it
+  std::call_once(entry->built_, [&]() {
+    auto pch = std::make_shared<std::vector<char>>();
+    if (!Load(key, *pch)) {
+      if (!Build(isa, options, *pch)) {
+        return;
+      }
+      Store(key, *pch);
+    }
+    amd::ScopedLock lock(lock_);
+    entry->pch_ = pch;
+  });
+
+  amd::ScopedLock lock(lock_);
+  return entry->pch_;
+}
+
+void BuiltinPch::Reject(const std::string& isa, const std::vector<std::string>& options) {
+  std::string key = Key(isa, options);
+  {
+    amd::ScopedLock lock(lock_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      it->second->pch_.reset();
+    }
+  }
+  std::string fileName = CacheFile(key);
+  if (!fileName.empty()) {
+    std::remove(fileName.c_str());
+  }
+}
+
 bool RTCCompileProgram::compile(const std::vector<std::string>& options, bool fgpu_rdc) {
   if (!addSource_impl()) {
     LogError("Error in hiprtc: unable to add source code");
@@ -326,22 +548,22 @@ bool RTCCompileProgram::compile(const std::vector<std::string>& options, bool fg
     return false;
   }
 
-  if (fgpu_rdc_) {
-    if (!compileToBitCode(compile_input_, isa_, compileOpts, build_log_, LLVMBitcode_)) {
-      LogError("Error in hiprtc: unable to compile source to bitcode");
+  arch_results_.clear();
+  if (isas_.size() > 1) {
+    if (!compileArchs(compileOpts)) {
       return false;
     }
   } else {
-    LogInfo("Using the new path of comgr");
-    if (!compileToExecutable(compile_input_, isa_, compileOpts, link_options_, build_log_,
-                             executable_)) {
-      LogError("Failing to compile to realloc");
+    auto& output = fgpu_rdc_ ? LLVMBitcode_ : executable_;
+    if (!compileIsa(compile_input_, isa_, compileOpts, build_log_, output)) {
       return false;
     }
   }
 
   if (!mangled_names_.empty()) {
-    auto& compile_step_output = fgpu_rdc_ ? LLVMBitcode_ : executable_;
+    // The names are the same for all targets, the bundle itself isn't an ELF
+    auto& compile_step_output = fgpu_rdc_ ? LLVMBitcode_
+        : (arch_results_.empty() ? executable_ : arch_results_[0].executable_);
     if (!fillMangledNames(compile_step_output, mangled_names_, fgpu_rdc_)) {
       LogError("Error in hiprtc: unable to fill mangled names");
       return false;
@@ -351,6 +573,146 @@ bool RTCCompileProgram::compile(const std::vector<std::string>& options, bool fg
   return true;
 }
 
+bool RTCCompileProgram::compileIsa(amd_comgr_data_set_t input, const std::string& isa,
+                                   std::vector<std::string>& options, std::string& log,
+                                   std::vector<char>& output) {
+  // Each target compiles with a private copy, the compiles of compileArchs() run concurrently
+  std::vector<std::string> linkOptions(link_options_);
+  auto compileStep = [&](std::vector<std::string>& opts, std::string& stepLog) {
+    if (fgpu_rdc_) {
+      return compileToBitCode(input, isa, opts, stepLog, output);
+    }
+    return compileToExecutable(input, isa, opts, linkOptions, stepLog, output);
+  };
+
+  const char* error = fgpu_rdc_ ? "Error in hiprtc: unable to compile source to bitcode"
+                                : "Failing to compile to realloc";
+
+  // Try the precompiled builtin header first
+  bool pchCompiled = false;
+  auto pch = BuiltinPch::Get(isa, options);
+  if (pch != nullptr) {
+    std::vector<std::string> pchOpts = BuiltinPch::PchOptions(options);
+    std::string pchLog;
+    if (addCodeObjData(input, *pch, "hiprtc_runtime.pch",
+                       AMD_COMGR_DATA_KIND_PRECOMPILED_HEADER)) {
+      pchCompiled = compileStep(pchOpts, pchLog);
+      amd::Comgr::data_set_remove(input, AMD_COMGR_DATA_KIND_PRECOMPILED_HEADER);
+      if (!pchCompiled) {
+        if (!BuiltinPch::IsPchError(pchLog)) {
+          // The plain compile would fail on the same source errors, so don't repeat it
+          log += pchLog;
+          LogError(error);
+          return false;
+        }
+        LogInfo("Builtin PCH is incompatible with the compile options, parsing the header");
+        BuiltinPch::Reject(isa, options);
+      }
+    }
+    if (pchCompiled) {
+      log += pchLog;
+    }
+  }
+
+  if (!pchCompiled) {
+    if (!fgpu_rdc_) {
+      LogInfo("Using the new path of comgr");
+    }
+    if (!compileStep(options, log)) {
+      LogError(error);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RTCCompileProgram::compileArchs(const std::vector<std::string>& options) {
+  if (fgpu_rdc_) {
+    build_log_ += "Error: -fgpu-rdc accepts a single --offload-arch\n";
+    LogError("Error in hiprtc: -fgpu-rdc with several targets");
+    return false;
+  }
+
+  const std::string kIsaPrefix = "amdgcn-amd-amdhsa--";
+  arch_results_.resize(isas_.size());
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+  auto worker = [&]() {
+    for (size_t i = next++; i < isas_.size(); i = next++) {
+      auto& result = arch_results_[i];
+      result.isa_ = isas_[i];
+      // Comgr actions on the same data set don't run concurrently, hence a set per target
+      amd_comgr_data_set_t input;
+      if (amd::Comgr::create_data_set(&input) != AMD_COMGR_STATUS_SUCCESS) {
+        failed = true;
+        continue;
+      }
+      std::vector<std::string> archOptions(options);
+      archOptions.push_back("--offload-arch=" + isas_[i].substr(kIsaPrefix.size()));
+      if (!copyDataSet(compile_input_, input, AMD_COMGR_DATA_KIND_SOURCE) ||
+          !copyDataSet(compile_input_, input, AMD_COMGR_DATA_KIND_INCLUDE) ||
+          !compileIsa(input, result.isa_, archOptions, result.build_log_, result.executable_)) {
+        failed = true;
+      }
+      amd::Comgr::destroy_data_set(input);
+    }
+  };
+
+  size_t numWorkers = HIPRTC_COMPILE_THREADS;
+  if (numWorkers == 0) {
+    numWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  numWorkers = std::min(numWorkers, isas_.size());
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < numWorkers; ++i) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : workers) {
+    thread.join();
+  }
+
+  // The program log holds the logs of all targets
+  for (const auto& result : arch_results_) {
+    if (!result.build_log_.empty()) {
+      build_log_ += "--- " + result.isa_ + " ---\n" + result.build_log_;
+    }
+  }
+  if (failed) {
+    return false;
+  }
+
+  std::vector<std::pair<std::string, std::vector<char>>> codeObjects;
+  for (const auto& result : arch_results_) {
+    codeObjects.emplace_back(result.isa_, result.executable_);
+  }
+  if (!createOffloadBundle(codeObjects, executable_)) {
+    LogError("Error in hiprtc: unable to bundle the code objects");
+    return false;
+  }
+  return true;
+}
+
+bool RTCCompileProgram::getArchResult(const std::string& arch, const std::vector<char>** exec,
+                                      const std::string** log) const {
+  const std::string isa = "amdgcn-amd-amdhsa--" + arch;
+  if (arch_results_.empty()) {
+    if (isa != isa_ || fgpu_rdc_) {
+      return false;
+    }
+    *exec = &executable_;
+    *log = &build_log_;
+    return true;
+  }
+  for (const auto& result : arch_results_) {
+    if (result.isa_ == isa) {
+      *exec = &result.executable_;
+      *log = &result.build_log_;
+      return true;
+    }
+  }
+  return false;
+}
 
 void RTCCompileProgram::stripNamedExpression(std::string& strippedName) {
   if (strippedName.back() == ')') {
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #endif
 #include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 
@@ -111,6 +112,42 @@ struct Settings {
   bool offloadArchProvided{false};
 };
 
+// Precompiled headers of the builtin hiprtc header, built once per ISA and option signature.
+// The AST files persist in HIPRTC_PCH_CACHE_PATH, if set, keyed by the HIP and comgr versions.
+class BuiltinPch {
+ public:
+  // Returns the PCH for the compile options or nullptr, if it can't be built for them
+  static std::shared_ptr<const std::vector<char>> Get(const std::string& isa,
+                                                      const std::vector<std::string>& options);
+  // Drops the PCH of the options after comgr rejected it, the later compiles parse the header
+  static void Reject(const std::string& isa, const std::vector<std::string>& options);
+  // Returns the options for a compile against the PCH, without the builtin header include
+  static std::vector<std::string> PchOptions(const std::vector<std::string>& options);
+  // Returns false if the options can't be combined with the builtin PCH
+  static bool IsCompatible(const std::vector<std::string>& options);
+  // Returns the options, which affect the parsed builtin header. The PCH is built and keyed
+  // with them only
+  static std::vector<std::string> HeaderOptions(const std::vector<std::string>& options);
+  // Returns true if the compile log shows, that clang rejected the PCH
+  static bool IsPchError(const std::string& log);
+
+ private:
+  struct Entry {
+    std::once_flag built_;
+    std::shared_ptr<const std::vector<char>> pch_;
+  };
+
+  static std::string Key(const std::string& isa, const std::vector<std::string>& options);
+  static bool Build(const std::string& isa, const std::vector<std::string>& options,
+                    std::vector<char>& pch);
+  static std::string CacheFile(const std::string& key);
+  static bool Load(const std::string& key, std::vector<char>& pch);
+  static void Store(const std::string& key, const std::vector<char>& pch);
+
+  static amd::Monitor lock_;
+  static std::map<std::string, std::shared_ptr<Entry>> entries_;
+};
+
 class RTCProgram {
  protected:
   // Lock and control variables
@@ -150,8 +187,20 @@ class RTCCompileProgram : public RTCProgram {
   bool fgpu_rdc_;
   std::vector<char> LLVMBitcode_;
 
+  // Result of one target in a multi-architecture compile
+  struct ArchResult {
+    std::string isa_;
+    std::string build_log_;
+    std::vector<char> executable_;
+  };
+  std::vector<std::string> isas_;          // All --offload-arch targets of the compile
+  std::vector<ArchResult> arch_results_;   // Empty unless isas_ has several targets
+
   // Private Member functions
   bool addSource_impl();
+  bool compileIsa(amd_comgr_data_set_t input, const std::string& isa,
+                  std::vector<std::string>& options, std::string& log, std::vector<char>& output);
+  bool compileArchs(const std::vector<std::string>& options);
   bool addBuiltinHeader();
   bool transformOptions(std::vector<std::string>& compile_options);
   bool findExeOptions(const std::vector<std::string>& options,
@@ -192,6 +241,9 @@ class RTCCompileProgram : public RTCProgram {
   size_t getExecSize() const { return executable_.size(); }
   const std::string& getLog() const { return build_log_; }
   size_t getLogSize() const { return build_log_.size(); }
+  // Returns the code object and the log of one target or false if the program has no such target
+  bool getArchResult(const std::string& arch, const std::vector<char>** exec,
+                     const std::string** log) const;
 };
 
 // Linker Arguments passed via hipLinkCreate
@@ -0,0 +1,448 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_device_attributes.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+using hip::DeviceAttributes;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+// The per-query switch, which hipDeviceGetAttribute used before the table.
+// Returns false for the attributes it doesn't know
+static bool legacyAttribute(const hipDeviceProp_tR0600& prop, const amd::device::Info& info,
+                            bool fineGrainSupported, hipDeviceAttribute_t attr, int* pi) {
+  constexpr auto int32_max = static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+
+  switch (attr) {
+    case hipDeviceAttributeMaxThreadsPerBlock:
+      *pi = prop.maxThreadsPerBlock;
+      break;
+    case hipDeviceAttributeAsyncEngineCount:
+      *pi = prop.asyncEngineCount;
+      break;
+    case hipDeviceAttributeMaxBlockDimX:
+      *pi = prop.maxThreadsDim[0];
+      break;
+    case hipDeviceAttributeMaxBlockDimY:
+      *pi = prop.maxThreadsDim[1];
+      break;
+    case hipDeviceAttributeMaxBlockDimZ:
+      *pi = prop.maxThreadsDim[2];
+      break;
+    case hipDeviceAttributeMaxGridDimX:
+      *pi = prop.maxGridSize[0];
+      break;
+    case hipDeviceAttributeMaxGridDimY:
+      *pi = prop.maxGridSize[1];
+      break;
+    case hipDeviceAttributeMaxGridDimZ:
+      *pi = prop.maxGridSize[2];
+      break;
+    case hipDeviceAttributeMaxSurface1D:
+      *pi = prop.maxSurface1D;
+      break;
+    case hipDeviceAttributeMaxSharedMemoryPerBlock:
+      *pi = prop.sharedMemPerBlock;
+      break;
+    case hipDeviceAttributeSharedMemPerBlockOptin:
+      *pi = prop.sharedMemPerBlockOptin;
+      break;
+    case hipDeviceAttributeSharedMemPerMultiprocessor:
+      *pi = prop.sharedMemPerMultiprocessor;
+      break;
+    case hipDeviceAttributeStreamPrioritiesSupported:
+      *pi = prop.streamPrioritiesSupported;
+      break;
+    case hipDeviceAttributeSurfaceAlignment:
+      *pi = prop.surfaceAlignment;
+      break;
+    case hipDeviceAttributeTotalConstantMemory:
+      // size_t to int casting
+      *pi = std::min(prop.totalConstMem, int32_max);
+      break;
+    case hipDeviceAttributeTotalGlobalMem:
+      *pi = std::min(prop.totalGlobalMem, int32_max);
+      break;
+    case hipDeviceAttributeWarpSize:
+      *pi = prop.warpSize;
+      break;
+    case hipDeviceAttributeMaxRegistersPerBlock:
+      *pi = prop.regsPerBlock;
+      break;
+    case hipDeviceAttributeClockRate:
+      *pi = prop.clockRate;
+      break;
+    case hipDeviceAttributeWallClockRate:
+      *pi = info.wallClockFrequency_;
+      break;
+    case hipDeviceAttributeMemoryClockRate:
+      *pi = prop.memoryClockRate;
+      break;
+    case hipDeviceAttributeMemoryBusWidth:
+      *pi = prop.memoryBusWidth;
+      break;
+    case hipDeviceAttributeMultiprocessorCount:
+      *pi = prop.multiProcessorCount;
+      break;
+    case hipDeviceAttributeComputeMode:
+      *pi = prop.computeMode;
+      break;
+    case hipDeviceAttributeComputePreemptionSupported:
+      *pi = prop.computePreemptionSupported;
+      break;
+    case hipDeviceAttributeL2CacheSize:
+      *pi = prop.l2CacheSize;
+      break;
+    case hipDeviceAttributeLocalL1CacheSupported:
+      *pi = prop.localL1CacheSupported;
+      break;
+    case hipDeviceAttributeLuidDeviceNodeMask:
+      *pi = prop.luidDeviceNodeMask;
+      break;
+    case hipDeviceAttributeMaxThreadsPerMultiProcessor:
+      *pi = prop.maxThreadsPerMultiProcessor;
+      break;
+    case hipDeviceAttributeComputeCapabilityMajor:
+      *pi = prop.major;
+      break;
+    case hipDeviceAttributeComputeCapabilityMinor:
+      *pi = prop.minor;
+      break;
+    case hipDeviceAttributeMultiGpuBoardGroupID:
+      *pi = prop.multiGpuBoardGroupID;
+      break;
+    case hipDeviceAttributePciBusId:
+      *pi = prop.pciBusID;
+      break;
+    case hipDeviceAttributeConcurrentKernels:
+      *pi = prop.concurrentKernels;
+      break;
+    case hipDeviceAttributePciDeviceId:
+      *pi = prop.pciDeviceID;
+      break;
+    case hipDeviceAttributePciDomainID:
+      *pi = prop.pciDomainID;
+      break;
+    case hipDeviceAttributePersistingL2CacheMaxSize:
+      *pi = prop.persistingL2CacheMaxSize;
+      break;
+    case hipDeviceAttributeMaxRegistersPerMultiprocessor:
+      *pi = prop.regsPerMultiprocessor;
+      break;
+    case hipDeviceAttributeReservedSharedMemPerBlock:
+      *pi = prop.reservedSharedMemPerBlock;
+      break;
+    case hipDeviceAttributeMaxSharedMemoryPerMultiprocessor:
+      *pi = prop.maxSharedMemoryPerMultiProcessor;
+      break;
+    case hipDeviceAttributeIsMultiGpuBoard:
+      *pi = prop.isMultiGpuBoard;
+      break;
+    case hipDeviceAttributeCooperativeLaunch:
+      *pi = prop.cooperativeLaunch;
+      break;
+    case hipDeviceAttributeHostRegisterSupported:
+      *pi = 1;
+      break;
+    case hipDeviceAttributeDeviceOverlap:
+      *pi = prop.asyncEngineCount > 0 ? 1 : 0;
+      break;
+    case hipDeviceAttributeCooperativeMultiDeviceLaunch:
+      *pi = prop.cooperativeMultiDeviceLaunch;
+      break;
+    case hipDeviceAttributeIntegrated:
+      *pi = prop.integrated;
+      break;
+    case hipDeviceAttributeMaxTexture1DWidth:
+      *pi = prop.maxTexture1D;
+      break;
+    case hipDeviceAttributeMaxTexture1DLinear:
+      *pi = prop.maxTexture1DLinear;
+      break;
+    case hipDeviceAttributeMaxTexture1DMipmap:
+      *pi = prop.maxTexture1DMipmap;
+      break;
+    case hipDeviceAttributeMaxTextureCubemap:
+      *pi = prop.maxTextureCubemap;
+      break;
+    case hipDeviceAttributeMaxTexture2DWidth:
+      *pi = prop.maxTexture2D[0];
+      break;
+    case hipDeviceAttributeMaxTexture2DHeight:
+      *pi = prop.maxTexture2D[1];
+      break;
+    case hipDeviceAttributeMaxTexture3DWidth:
+      *pi = prop.maxTexture3D[0];
+      break;
+    case hipDeviceAttributeMaxTexture3DHeight:
+      *pi = prop.maxTexture3D[1];
+      break;
+    case hipDeviceAttributeMaxTexture3DDepth:
+      *pi = prop.maxTexture3D[2];
+      break;
+    case hipDeviceAttributeHdpMemFlushCntl:
+      *reinterpret_cast<unsigned int**>(pi) = prop.hdpMemFlushCntl;
+      break;
+    case hipDeviceAttributeHdpRegFlushCntl:
+      *reinterpret_cast<unsigned int**>(pi) = prop.hdpRegFlushCntl;
+      break;
+    case hipDeviceAttributeMaxPitch:
+      // size_t to int casting
+      *pi = std::min(prop.memPitch, int32_max);
+      break;
+    case hipDeviceAttributeTextureAlignment:
+      *pi = prop.textureAlignment;
+      break;
+    case hipDeviceAttributeTexturePitchAlignment:
+      *pi = prop.texturePitchAlignment;
+      break;
+    case hipDeviceAttributeKernelExecTimeout:
+      *pi = prop.kernelExecTimeoutEnabled;
+      break;
+    case hipDeviceAttributeCanMapHostMemory:
+      *pi = prop.canMapHostMemory;
+      break;
+    case hipDeviceAttributeCanUseHostPointerForRegisteredMem:
+      *pi = prop.canUseHostPointerForRegisteredMem;
+      break;
+    case hipDeviceAttributeEccEnabled:
+      *pi = prop.ECCEnabled;
+      break;
+    case hipDeviceAttributeCooperativeMultiDeviceUnmatchedFunc:
+      *pi = prop.cooperativeMultiDeviceUnmatchedFunc;
+      break;
+    case hipDeviceAttributeCooperativeMultiDeviceUnmatchedGridDim:
+      *pi = prop.cooperativeMultiDeviceUnmatchedGridDim;
+      break;
+    case hipDeviceAttributeCooperativeMultiDeviceUnmatchedBlockDim:
+      *pi = prop.cooperativeMultiDeviceUnmatchedBlockDim;
+      break;
+    case hipDeviceAttributeCooperativeMultiDeviceUnmatchedSharedMem:
+      *pi = prop.cooperativeMultiDeviceUnmatchedSharedMem;
+      break;
+    case hipDeviceAttributeAsicRevision:
+      *pi = prop.asicRevision;
+      break;
+    case hipDeviceAttributeManagedMemory:
+      *pi = prop.managedMemory;
+      break;
+    case hipDeviceAttributeMaxBlocksPerMultiProcessor:
+      *pi = prop.maxBlocksPerMultiProcessor;
+      break;
+    case hipDeviceAttributeDirectManagedMemAccessFromHost:
+      *pi = prop.directManagedMemAccessFromHost;
+      break;
+    case hipDeviceAttributeGlobalL1CacheSupported:
+      *pi = prop.globalL1CacheSupported;
+      break;
+    case hipDeviceAttributeHostNativeAtomicSupported:
+      *pi = prop.hostNativeAtomicSupported;
+      break;
+    case hipDeviceAttributeConcurrentManagedAccess:
+      *pi = prop.concurrentManagedAccess;
+      break;
+    case hipDeviceAttributePageableMemoryAccess:
+      *pi = prop.pageableMemoryAccess;
+      break;
+    case hipDeviceAttributePageableMemoryAccessUsesHostPageTables:
+      *pi = prop.pageableMemoryAccessUsesHostPageTables;
+      break;
+    case hipDeviceAttributeIsLargeBar:
+      *pi = prop.isLargeBar;
+      break;
+    case hipDeviceAttributeUnifiedAddressing:
+      *pi = true;
+      break;
+    case hipDeviceAttributeCanUseStreamWaitValue:
+      *pi = info.aqlBarrierValue_;
+      break;
+    case hipDeviceAttributeImageSupport:
+      *pi = static_cast<int>(info.imageSupport_);
+      break;
+    case hipDeviceAttributePhysicalMultiProcessorCount:
+      *pi = info.maxPhysicalComputeUnits_;
+      break;
+    case hipDeviceAttributeFineGrainSupport:
+      *pi = static_cast<int>(fineGrainSupported);
+      break;
+    case hipDeviceAttributeMemoryPoolsSupported:
+      *pi = HIP_MEM_POOL_SUPPORT;
+      break;
+    case hipDeviceAttributeMemoryPoolSupportedHandleTypes:
+      *pi = prop.memoryPoolSupportedHandleTypes;
+      break;
+    case hipDeviceAttributeVirtualMemoryManagementSupported:
+      *pi = static_cast<int>(info.virtualMemoryManagement_);
+      break;
+    case hipDeviceAttributeAccessPolicyMaxWindowSize:
+      *pi = prop.accessPolicyMaxWindowSize;
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+// Every field gets a different value, so a table entry, which reads the wrong field, shows up.
+// The size_t fields end up far above INT32_MAX and the HDP pointers use the upper 32 bits
+static void makeProps(hipDeviceProp_tR0600* prop) {
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(prop);
+  for (size_t i = 0; i < sizeof(*prop); ++i) {
+    bytes[i] = static_cast<uint8_t>(i * 7 + 1);
+  }
+}
+
+static void makeInfo(amd::device::Info* info) {
+  info->wallClockFrequency_ = 100000;
+  info->aqlBarrierValue_ = true;
+  info->imageSupport_ = 1;
+  info->maxPhysicalComputeUnits_ = 120;
+  info->virtualMemoryManagement_ = true;
+}
+
+// Compares the table with the switch over the whole CUDA compatible and AMD specific ranges
+// and a few values around them. The pointer attributes fill a whole pointer, the others only
+// the int, so the result is compared as a pointer sized value
+static bool compare(const hipDeviceProp_tR0600& prop, const amd::device::Info& info,
+                    bool fineGrainSupported) {
+  DeviceAttributes attributes;
+  attributes.Build(prop, info, fineGrainSupported);
+
+  const int ranges[][2] = {
+      {hipDeviceAttributeCudaCompatibleBegin, hipDeviceAttributeCudaCompatibleEnd + 1},
+      {hipDeviceAttributeAmdSpecificBegin - 1, hipDeviceAttributeAmdSpecificEnd + 1},
+      {hipDeviceAttributeVendorSpecificBegin - 1, hipDeviceAttributeVendorSpecificBegin + 1}};
+  int known = 0;
+  for (const auto& range : ranges) {
+    for (int value = range[0]; value <= range[1]; ++value) {
+      const auto attr = static_cast<hipDeviceAttribute_t>(value);
+      intptr_t expected = 0;
+      intptr_t actual = 0;
+      const bool expectedValid =
+          legacyAttribute(prop, info, fineGrainSupported, attr, reinterpret_cast<int*>(&expected));
+      const bool actualValid = attributes.Get(attr, reinterpret_cast<int*>(&actual));
+      if ((expectedValid != actualValid) || (expected != actual)) {
+        printf("attribute %d: table %d 0x%zx, switch %d 0x%zx\n", value, actualValid,
+               static_cast<size_t>(actual), expectedValid, static_cast<size_t>(expected));
+      }
+      CHECK(expectedValid == actualValid);
+      CHECK(expected == actual);
+      known += expectedValid ? 1 : 0;
+    }
+  }
+  // Every case of the switch is reported
+  CHECK(known == 87);
+  return true;
+}
+
+static bool testSyntheticProps() {
+  hipDeviceProp_tR0600 prop;
+  makeProps(&prop);
+  amd::device::Info info = {};
+  makeInfo(&info);
+  CHECK(compare(prop, info, true));
+
+  info = {};
+  CHECK(compare(prop, info, false));
+  return true;
+}
+
+// The size_t attributes are clamped to INT32_MAX, the values below it pass through
+static bool testClamps() {
+  constexpr size_t int32_max = std::numeric_limits<int32_t>::max();
+  const size_t values[] = {0, 4096, int32_max - 1, int32_max, int32_max + 1,
+                           std::numeric_limits<size_t>::max()};
+  amd::device::Info info = {};
+  makeInfo(&info);
+  for (size_t value : values) {
+    hipDeviceProp_tR0600 prop;
+    makeProps(&prop);
+    prop.totalGlobalMem = value;
+    prop.totalConstMem = value;
+    prop.memPitch = value;
+    CHECK(compare(prop, info, true));
+
+    DeviceAttributes attributes;
+    attributes.Build(prop, info, true);
+    const int expected = static_cast<int>(std::min(value, int32_max));
+    int pi = -1;
+    CHECK(attributes.Get(hipDeviceAttributeTotalGlobalMem, &pi) && (pi == expected));
+    CHECK(attributes.Get(hipDeviceAttributeTotalConstantMemory, &pi) && (pi == expected));
+    CHECK(attributes.Get(hipDeviceAttributeMaxPitch, &pi) && (pi == expected));
+  }
+  return true;
+}
+
+// The HDP registers are returned as whole pointers, a null register stays null
+static bool testHdpPointers() {
+  amd::device::Info info = {};
+  makeInfo(&info);
+  hipDeviceProp_tR0600 prop;
+  makeProps(&prop);
+  unsigned int memFlush = 0;
+  unsigned int regFlush = 0;
+  prop.hdpMemFlushCntl = &memFlush;
+  prop.hdpRegFlushCntl = &regFlush;
+  CHECK(compare(prop, info, true));
+
+  DeviceAttributes attributes;
+  attributes.Build(prop, info, true);
+  unsigned int* pointer = nullptr;
+  CHECK(attributes.Get(hipDeviceAttributeHdpMemFlushCntl, reinterpret_cast<int*>(&pointer)));
+  CHECK(pointer == &memFlush);
+  CHECK(attributes.Get(hipDeviceAttributeHdpRegFlushCntl, reinterpret_cast<int*>(&pointer)));
+  CHECK(pointer == &regFlush);
+
+  prop.hdpMemFlushCntl = nullptr;
+  prop.hdpRegFlushCntl = nullptr;
+  CHECK(compare(prop, info, true));
+  return true;
+}
+
+// A table, which wasn't built, knows no attribute
+static bool testEmpty() {
+  DeviceAttributes attributes;
+  int pi = -1;
+  CHECK(!attributes.Get(hipDeviceAttributeMaxThreadsPerBlock, &pi));
+  CHECK(!attributes.Get(hipDeviceAttributeHdpMemFlushCntl, &pi));
+  CHECK(pi == -1);
+  return true;
+}
+
+int main() {
+  amd::Flag::init();
+  bool passed = true;
+  passed &= testSyntheticProps();
+  passed &= testClamps();
+  passed &= testHdpPointers();
+  passed &= testEmpty();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <hip/hiprtc.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// Compile time of small JIT kernels with and without the builtin PCH. HIPRTC_USE_BUILTIN_PCH
+// is read once per process, hence every mode runs in a child process with a fresh runtime
+
+static const char* kKernel = R"(
+extern "C" __global__ void saxpy(float a, const float* x, float* y, size_t n) {
+  size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < n) {
+    y[i] = a * x[i] + y[i];
+  }
+}
+)";
+
+// The source error is reported from the compile against the PCH, without a second compile
+static const char* kBrokenKernel = R"(
+extern "C" __global__ void broken(float* y) {
+  y[threadIdx.x] = undeclared;
+}
+)";
+
+struct Result {
+  double firstMs_ = 0;   //!< The first compile, which builds the PCH
+  double nextMs_ = 0;    //!< Average of the next compiles
+  double optionsMs_ = 0; //!< A compile, which adds the diagnostic and debug options
+  double brokenMs_ = 0;  //!< A compile with a source error
+  bool passed_ = false;
+};
+
+static bool compile(const char* source, const std::vector<const char*>& options, double* ms,
+                    std::string* log) {
+  hiprtcProgram prog;
+  if (hiprtcCreateProgram(&prog, source, "bench.cu", 0, nullptr, nullptr) != HIPRTC_SUCCESS) {
+    return false;
+  }
+  auto start = std::chrono::steady_clock::now();
+  hiprtcResult result = hiprtcCompileProgram(prog, static_cast<int>(options.size()),
+                                             const_cast<const char**>(options.data()));
+  *ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+  size_t logSize = 0;
+  if (log != nullptr && hiprtcGetProgramLogSize(prog, &logSize) == HIPRTC_SUCCESS) {
+    log->resize(logSize);
+    if (logSize != 0) {
+      hiprtcGetProgramLog(prog, &(*log)[0]);
+    }
+  }
+  hiprtcDestroyProgram(&prog);
+  return result == HIPRTC_SUCCESS;
+}
+
+static Result run(size_t iterations) {
+  Result res;
+  const std::vector<const char*> options = {"-O3"};
+  if (!compile(kKernel, options, &res.firstMs_, nullptr)) {
+    return res;
+  }
+  for (size_t i = 0; i < iterations; ++i) {
+    double ms = 0;
+    if (!compile(kKernel, options, &ms, nullptr)) {
+      return res;
+    }
+    res.nextMs_ += ms / iterations;
+  }
+  // The warnings and the debug info don't change the header, so the PCH is shared
+  if (!compile(kKernel, {"-O3", "-Wall", "-g"}, &res.optionsMs_, nullptr)) {
+    return res;
+  }
+  std::string log;
+  if (compile(kBrokenKernel, options, &res.brokenMs_, &log) ||
+      (log.find("undeclared") == std::string::npos)) {
+    printf("The source error isn't reported: %s\n", log.c_str());
+    return res;
+  }
+  res.passed_ = true;
+  return res;
+}
+
+static bool runChild(bool pch, size_t iterations, Result* res) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return false;
+  }
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    setenv("HIPRTC_USE_BUILTIN_PCH", pch ? "1" : "0", 1);
+    unsetenv("HIPRTC_PCH_CACHE_PATH");
+    Result child = run(iterations);
+    ssize_t written = write(fds[1], &child, sizeof(child));
+    _exit((written == sizeof(child)) ? 0 : 1);
+  }
+  close(fds[1]);
+  ssize_t size = (pid > 0) ? read(fds[0], res, sizeof(*res)) : 0;
+  close(fds[0]);
+  int status = 0;
+  if (pid > 0) {
+    waitpid(pid, &status, 0);
+  }
+  return (size == sizeof(*res)) && WIFEXITED(status) && (WEXITSTATUS(status) == 0) &&
+         res->passed_;
+}
+
+int main() {
+  constexpr size_t kIterations = 10;
+  bool passed = true;
+  for (bool pch : {false, true}) {
+    Result res;
+    bool ok = runChild(pch, kIterations, &res);
+    passed &= ok;
+    printf("%s: %s, first %.1f ms, next %.1f ms, -Wall -g %.1f ms, source error %.1f ms\n",
+           pch ? "builtin pch" : "plain header", ok ? "Succeeded" : "Failed", res.firstMs_,
+           res.nextMs_, res.optionsMs_, res.brokenMs_);
+  }
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,297 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_host_cache.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using hip::HostMemCache;
+
+// Stand-in for the device allocations. The fences complete when the test says so
+class Backend : public HostMemCache::Backend {
+ public:
+  struct Fence {
+    bool done_ = false;
+  };
+
+  hipError_t Alloc(size_t size, unsigned int flags, void** ptr) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (failures_ > 0) {
+      failures_--;
+      return hipErrorOutOfMemory;
+    }
+    allocs_++;
+    *ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(allocs_) << 32);
+    live_.insert(*ptr);
+    sizes_.push_back(size);
+    return hipSuccess;
+  }
+  void Free(void* ptr) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    frees_++;
+    live_.erase(ptr);
+  }
+  void* RecordFence() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idle_) {
+      return nullptr;
+    }
+    Fence* fence = new Fence();
+    fences_.insert(fence);
+    return fence;
+  }
+  bool FenceDone(void* fence, bool wait) override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Fence* f = reinterpret_cast<Fence*>(fence);
+    if (wait) {
+      waiting_ = true;
+      cv_.notify_all();
+      if (block_) {
+        cv_.wait(lock, [f]() { return f->done_; });
+      }
+      f->done_ = true;
+    }
+    return f->done_;
+  }
+  void ReleaseFence(void* fence) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fences_.erase(reinterpret_cast<Fence*>(fence));
+    delete reinterpret_cast<Fence*>(fence);
+  }
+
+  //! Completes the GPU work queued so far
+  void Complete() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto fence : fences_) {
+      fence->done_ = true;
+    }
+    cv_.notify_all();
+  }
+  //! Waits until the cache waits on a fence
+  void WaitForWaiter() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return waiting_; });
+  }
+
+  bool idle_ = false;           //!< No GPU work is outstanding at the free
+  bool block_ = false;          //!< The fence waits block until Complete()
+  bool waiting_ = false;        //!< The cache waited on a fence
+  int failures_ = 0;            //!< Number of the allocations to fail
+  int allocs_ = 0;
+  int frees_ = 0;
+  std::set<void*> live_;
+  std::vector<size_t> sizes_;
+  std::set<Fence*> fences_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+// The runtime locks need an amd::Thread, as an API call creates it for the application threads
+static void attachThread() {
+  if (amd::Thread::current() == nullptr) {
+    new amd::HostThread();
+  }
+}
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+// 4 classes per power of two, the page is the smallest one
+static bool testSizeClass() {
+  CHECK(HostMemCache::SizeClass(1) == 4096);
+  CHECK(HostMemCache::SizeClass(4096) == 4096);
+  CHECK(HostMemCache::SizeClass(4097) == 8192);
+  CHECK(HostMemCache::SizeClass(64 * Ki + 1) == 80 * Ki);
+  CHECK(HostMemCache::SizeClass(80 * Ki) == 80 * Ki);
+  CHECK(HostMemCache::SizeClass(Mi + 1) == Mi + 256 * Ki);
+  for (size_t size = 32 * Ki + 1; size < 64 * Mi; size = size * 3 / 2) {
+    const size_t sizeClass = HostMemCache::SizeClass(size);
+    CHECK((sizeClass >= size) && (sizeClass - size <= size / 4));
+  }
+  return true;
+}
+
+// A freed allocation serves the next one with the same flags and size class
+static bool testReuse() {
+  Backend* backend = new Backend();
+  backend->idle_ = true;
+  HostMemCache* cache = new HostMemCache(backend, 16 * Mi);
+  void* a = nullptr;
+  void* b = nullptr;
+  size_t size = 0;
+  CHECK(cache->Alloc(100 * Ki, 1, &a) == hipSuccess);
+  CHECK(backend->sizes_.back() == 112 * Ki);
+  // The application sees the requested size, not the size class
+  CHECK(cache->GetSize(a, &size) && (size == 100 * Ki));
+  CHECK(cache->Free(a));
+  CHECK(!cache->GetSize(a, &size));
+  CHECK(!cache->Free(a));
+
+  CHECK(cache->Alloc(110 * Ki, 1, &b) == hipSuccess);
+  CHECK((a == b) && (backend->allocs_ == 1));
+  CHECK(cache->GetSize(b, &size) && (size == 110 * Ki));
+  CHECK(cache->Free(b));
+  // Other flags, i.e. coherence or NUMA policy, never share the allocation
+  CHECK(cache->Alloc(100 * Ki, 2, &b) == hipSuccess);
+  CHECK((a != b) && (backend->allocs_ == 2));
+  CHECK(cache->Free(b));
+
+  hipExtHostMemCacheStats stats = {};
+  cache->GetStats(&stats);
+  CHECK((stats.hits == 1) && (stats.misses == 2) && (stats.releases == 0));
+  CHECK((stats.cachedBlocks == 2) && (stats.cachedBytes == 2 * 112 * Ki));
+  CHECK(stats.inUseBytes == 0);
+
+  int local = 0;
+  CHECK(!cache->Free(&local));
+  cache->Trim(0);
+  CHECK(backend->live_.empty());
+  delete cache;
+  return true;
+}
+
+// The GPU may still access a freed allocation until its fence is complete
+static bool testFence() {
+  Backend* backend = new Backend();
+  HostMemCache* cache = new HostMemCache(backend, 16 * Mi);
+  void* a = nullptr;
+  void* b = nullptr;
+  CHECK(cache->Alloc(8 * Ki, 0, &a) == hipSuccess);
+  CHECK(cache->Free(a));
+  CHECK(cache->Alloc(8 * Ki, 0, &b) == hipSuccess);
+  CHECK((a != b) && (backend->allocs_ == 2));
+  backend->Complete();
+  void* c = nullptr;
+  CHECK(cache->Alloc(8 * Ki, 0, &c) == hipSuccess);
+  CHECK((c == a) && (backend->allocs_ == 2));
+  CHECK(cache->Free(b));
+  CHECK(cache->Free(c));
+  cache->Trim(0);
+  CHECK(backend->live_.empty() && backend->fences_.empty());
+  delete cache;
+  return true;
+}
+
+// The idle allocations stay within the budget, the oldest one goes first
+static bool testBudget() {
+  Backend* backend = new Backend();
+  backend->idle_ = true;
+  HostMemCache* cache = new HostMemCache(backend, 3 * 64 * Ki);
+  void* ptr[4] = {};
+  for (int i = 0; i < 4; ++i) {
+    CHECK(cache->Alloc(64 * Ki, 0, &ptr[i]) == hipSuccess);
+  }
+  for (int i = 0; i < 4; ++i) {
+    CHECK(cache->Free(ptr[i]));
+  }
+  CHECK((backend->frees_ == 1) && (backend->live_.count(ptr[0]) == 0));
+
+  // An allocation above the budget goes to the backend
+  void* big = nullptr;
+  CHECK(cache->Alloc(Mi, 0, &big) == hipSuccess);
+  CHECK(!cache->Free(big));
+  backend->Free(big);
+
+  cache->Trim(64 * Ki);
+  CHECK((backend->frees_ == 4) && (backend->live_.count(ptr[3]) == 1));
+  cache->Trim(0);
+  CHECK(backend->live_.empty());
+
+  hipExtHostMemCacheStats stats = {};
+  cache->GetStats(&stats);
+  CHECK((stats.releases == 4) && (stats.cachedBytes == 0) && (stats.cachedBlocks == 0));
+  delete cache;
+  return true;
+}
+
+// An out of memory returns the idle allocations and retries
+static bool testOutOfMemory() {
+  Backend* backend = new Backend();
+  backend->idle_ = true;
+  HostMemCache* cache = new HostMemCache(backend, 16 * Mi);
+  void* a = nullptr;
+  void* b = nullptr;
+  CHECK(cache->Alloc(64 * Ki, 0, &a) == hipSuccess);
+  CHECK(cache->Free(a));
+  backend->failures_ = 1;
+  CHECK(cache->Alloc(Mi, 0, &b) == hipSuccess);
+  CHECK((backend->frees_ == 1) && (backend->live_.size() == 1));
+  backend->failures_ = 2;
+  CHECK(cache->Alloc(Mi, 0, &a) == hipErrorOutOfMemory);
+  CHECK(cache->Free(b));
+  delete cache;
+  return true;
+}
+
+// The eviction waits for the GPU without the cache lock, so the other threads go on
+static bool testEvictionWait() {
+  Backend* backend = new Backend();
+  backend->block_ = true;
+  HostMemCache* cache = new HostMemCache(backend, 16 * Mi);
+  void* a = nullptr;
+  CHECK(cache->Alloc(64 * Ki, 0, &a) == hipSuccess);
+  CHECK(cache->Free(a));
+
+  std::thread trim([&]() {
+    attachThread();
+    cache->Trim(0);
+  });
+  backend->WaitForWaiter();
+  auto other = std::async(std::launch::async, [&]() {
+    attachThread();
+    void* b = nullptr;
+    hipExtHostMemCacheStats stats = {};
+    cache->GetStats(&stats);
+    return (cache->Alloc(64 * Ki, 0, &b) == hipSuccess) && cache->Free(b) &&
+           (stats.cachedBlocks == 0);
+  });
+  const bool progressed = other.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+  backend->Complete();
+  trim.join();
+  CHECK(progressed && other.get());
+  backend->block_ = false;
+  cache->Trim(0);
+  CHECK(backend->live_.empty() && backend->fences_.empty());
+  delete cache;
+  return true;
+}
+
+int main() {
+  amd::Flag::init();
+  attachThread();
+  bool passed = true;
+  passed &= testSizeClass();
+  passed &= testReuse();
+  passed &= testFence();
+  passed &= testBudget();
+  passed &= testOutOfMemory();
+  passed &= testEvictionWait();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_ipc_cache.hpp"
+
+#include <cstdio>
+#include <map>
+#include <set>
+
+using hip::IpcMemCache;
+
+// Stand-in for the device attach. Every attach returns a new fake address
+class Backend : public IpcMemCache::Backend {
+ public:
+  bool Attach(const ihipIpcMemHandle_t& handle, unsigned int flags, void** dev_ptr) override {
+    if (fail_) {
+      return false;
+    }
+    attaches_++;
+    *dev_ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(attaches_) << 20);
+    attached_.insert(*dev_ptr);
+    return true;
+  }
+  bool Detach(void* dev_ptr) override {
+    detaches_++;
+    if (total_detaches_ != nullptr) {
+      (*total_detaches_)++;
+    }
+    return attached_.erase(dev_ptr) == 1;
+  }
+  uint64_t Now() override { return *now_; }
+
+  uint64_t* now_;
+  int* total_detaches_ = nullptr;  //!< Outlives the backend, which the cache deletes
+  bool fail_ = false;
+  int attaches_ = 0;
+  int detaches_ = 0;
+  std::set<void*> attached_;
+};
+
+constexpr uint64_t kMs = 1000 * 1000;
+
+static ihipIpcMemHandle_t makeHandle(char id, size_t size) {
+  ihipIpcMemHandle_t handle = {};
+  handle.ipc_handle[0] = id;
+  handle.psize = size;
+  handle.owners_process_id = 1234;
+  return handle;
+}
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+// Repeated opens share the mapping, without caching the last close detaches it
+static bool testSharing() {
+  uint64_t now = 0;
+  Backend* backend = new Backend();
+  backend->now_ = &now;
+  IpcMemCache* cache = new IpcMemCache(backend, 0, 0, 0);
+  void* a = nullptr;
+  void* b = nullptr;
+  CHECK(cache->Open(makeHandle(1, 4096), 0, &a));
+  CHECK(cache->Open(makeHandle(1, 4096), 0, &b));
+  CHECK((a == b) && (backend->attaches_ == 1));
+  // A different offset is a different mapping
+  ihipIpcMemHandle_t other = makeHandle(1, 4096);
+  other.poffset = 64;
+  CHECK(cache->Open(other, 0, &b));
+  CHECK((a != b) && (cache->Size() == 2));
+  CHECK(cache->Close(a));
+  CHECK(backend->detaches_ == 0);
+  CHECK(cache->Close(a));
+  CHECK(backend->detaches_ == 1);
+  CHECK(!cache->Close(a));
+  int local = 0;
+  CHECK(!cache->Close(&local));
+  CHECK(cache->Size() == 1);
+
+  backend->fail_ = true;
+  CHECK(!cache->Open(makeHandle(2, 4096), 0, &a));
+  CHECK(cache->Size() == 1);
+  delete cache;
+  return true;
+}
+
+// The closed mappings stay attached within the entries and bytes budget, the least
+// recently used one is detached first
+static bool testIdleBudget() {
+  uint64_t now = 0;
+  Backend* backend = new Backend();
+  backend->now_ = &now;
+  IpcMemCache* cache = new IpcMemCache(backend, 2, 3 * 4096, 1000 * kMs);
+  void* ptr[4] = {};
+  for (char i = 0; i < 3; ++i) {
+    CHECK(cache->Open(makeHandle(i, 4096), 0, &ptr[i]));
+  }
+  for (char i = 0; i < 3; ++i) {
+    CHECK(cache->Close(ptr[i]));
+  }
+  CHECK((cache->IdleSize() == 2) && (backend->detaches_ == 1));
+  CHECK(backend->attached_.count(ptr[0]) == 0);
+
+  // A reopen revives the idle mapping
+  void* again = nullptr;
+  CHECK(cache->Open(makeHandle(1, 4096), 0, &again));
+  CHECK((again == ptr[1]) && (backend->attaches_ == 3));
+  CHECK(cache->IdleSize() == 1);
+
+  // A mapping above the bytes budget isn't kept
+  CHECK(cache->Open(makeHandle(3, 4 * 4096), 0, &ptr[3]));
+  CHECK(cache->Close(ptr[3]));
+  CHECK(backend->attached_.count(ptr[3]) == 0);
+
+  // The teardown detaches the open and the idle mappings
+  int detaches = backend->detaches_;
+  const int attaches = backend->attaches_;
+  backend->total_detaches_ = &detaches;
+  delete cache;
+  CHECK(attaches == detaches);
+  return true;
+}
+
+// An idle mapping expires after the idle time limit, so it can't outlive the exporter's
+// free indefinitely
+static bool testExpiry() {
+  uint64_t now = 0;
+  Backend* backend = new Backend();
+  backend->now_ = &now;
+  IpcMemCache* cache = new IpcMemCache(backend, 4, 1 << 30, 100 * kMs);
+  void* a = nullptr;
+  void* b = nullptr;
+  CHECK(cache->Open(makeHandle(1, 4096), 0, &a));
+  CHECK(cache->Close(a));
+  now = 50 * kMs;
+  CHECK(cache->Open(makeHandle(1, 4096), 0, &b));
+  CHECK((a == b) && (backend->attaches_ == 1));
+  CHECK(cache->Close(b));
+
+  // The next open detaches the expired mapping and attaches the handle again
+  now = 200 * kMs;
+  CHECK(cache->Open(makeHandle(1, 4096), 0, &b));
+  CHECK((backend->detaches_ == 1) && (backend->attaches_ == 2));
+  CHECK(cache->Close(b));
+  now = 400 * kMs;
+  cache->Trim();
+  CHECK((cache->Size() == 0) && backend->attached_.empty());
+  delete cache;
+  return true;
+}
+
+int main() {
+  amd::Flag::init();
+  bool passed = true;
+  passed &= testSharing();
+  passed &= testIdleBudget();
+  passed &= testExpiry();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
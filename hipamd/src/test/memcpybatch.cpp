@@ -0,0 +1,127 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_memcpy_batch.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using hip::ClassifyMemcpyBatchCopy;
+using hip::MemcpyBatchCopy;
+using hip::MemcpyBatchEndpoint;
+using hip::MemcpyBatchGroup;
+using hip::PlanMemcpyBatch;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+static int gpu0;
+static int gpu1;
+
+// Pinned host memory stays on the host side, only private memory of two devices is peer
+static bool testClassify() {
+  const MemcpyBatchEndpoint host = {true, nullptr, false};
+  const MemcpyBatchEndpoint pinned = {true, &gpu0, true};
+  const MemcpyBatchEndpoint dev0 = {false, &gpu0, false};
+  const MemcpyBatchEndpoint dev1 = {false, &gpu1, false};
+  const MemcpyBatchEndpoint managed = {false, &gpu1, true};
+  CHECK(ClassifyMemcpyBatchCopy(host, host) == MemcpyBatchGroup::HostToHost);
+  CHECK(ClassifyMemcpyBatchCopy(pinned, host) == MemcpyBatchGroup::HostToHost);
+  CHECK(ClassifyMemcpyBatchCopy(host, dev0) == MemcpyBatchGroup::HostToDevice);
+  CHECK(ClassifyMemcpyBatchCopy(pinned, dev1) == MemcpyBatchGroup::HostToDevice);
+  CHECK(ClassifyMemcpyBatchCopy(dev0, pinned) == MemcpyBatchGroup::DeviceToHost);
+  CHECK(ClassifyMemcpyBatchCopy(dev0, dev0) == MemcpyBatchGroup::DeviceToDevice);
+  CHECK(ClassifyMemcpyBatchCopy(dev0, dev1) == MemcpyBatchGroup::PeerToPeer);
+  CHECK(ClassifyMemcpyBatchCopy(dev0, managed) == MemcpyBatchGroup::DeviceToDevice);
+  return true;
+}
+
+static MemcpyBatchCopy copy(MemcpyBatchGroup group, const void* srcMem, const void* dstMem,
+                            size_t src, size_t dst, size_t size, size_t index) {
+  return {group, 0, srcMem, dstMem, reinterpret_cast<const char*>(src),
+          reinterpret_cast<char*>(dst), size, index, index};
+}
+
+// The copies contiguous in the source and the destination of one allocation pair merge
+static bool testPlan() {
+  int a;
+  int b;
+  std::vector<MemcpyBatchCopy> copies = {
+      copy(MemcpyBatchGroup::HostToDevice, nullptr, &a, 0x2000, 0x9000, 0x100, 0),
+      copy(MemcpyBatchGroup::DeviceToDevice, &a, &b, 0x9100, 0x5100, 0x100, 1),
+      copy(MemcpyBatchGroup::DeviceToDevice, &a, &b, 0x9000, 0x5000, 0x100, 2),
+      // Contiguous source, but the destination has a gap
+      copy(MemcpyBatchGroup::DeviceToDevice, &a, &b, 0x9200, 0x5300, 0x100, 3),
+      copy(MemcpyBatchGroup::HostToHost, nullptr, nullptr, 0x1000, 0x3000, 0x10, 4),
+      copy(MemcpyBatchGroup::HostToDevice, nullptr, &a, 0x2100, 0x9100, 0x100, 5),
+  };
+  PlanMemcpyBatch(copies);
+  CHECK(copies.size() == 4);
+  CHECK(copies[0].group_ == MemcpyBatchGroup::HostToHost);
+  CHECK(copies[0].IsHostCopy() && copies[0].NeedsHostWait());
+  CHECK(copies[1].group_ == MemcpyBatchGroup::DeviceToDevice);
+  CHECK((copies[1].size_ == 0x200) && (copies[1].index_ == 1) && (copies[1].start_ == 2));
+  CHECK(!copies[1].IsHostCopy() && !copies[1].NeedsHostWait());
+  CHECK((copies[2].size_ == 0x100) && (copies[2].index_ == 3));
+  CHECK(copies[3].group_ == MemcpyBatchGroup::HostToDevice);
+  CHECK((copies[3].size_ == 0x200) && (copies[3].index_ == 0) && (copies[3].start_ == 0));
+  CHECK(!copies[3].IsHostCopy() && copies[3].NeedsHostWait());
+  return true;
+}
+
+// Plans a batch of chunked uploads into a few buffers, like a model weights upload.
+// Returns the number of the resulting copies
+static size_t plan(size_t chunks, size_t buffers, double* seconds) {
+  static int mem[64];
+  std::vector<MemcpyBatchCopy> copies;
+  copies.reserve(chunks);
+  constexpr size_t kChunk = 64 * 1024;
+  for (size_t i = 0; i < chunks; ++i) {
+    // Interleave the buffers, so the planner has to sort
+    const size_t buffer = i % buffers;
+    const size_t offset = (i / buffers) * kChunk;
+    copies.push_back(copy(MemcpyBatchGroup::HostToDevice, nullptr, &mem[buffer],
+                          0x10000000 * (buffer + 1) + offset, 0x80000000 * (buffer + 1) + offset,
+                          kChunk, i));
+  }
+  auto start = std::chrono::steady_clock::now();
+  PlanMemcpyBatch(copies);
+  *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return copies.size();
+}
+
+int main() {
+  bool passed = true;
+  passed &= testClassify();
+  passed &= testPlan();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+
+  for (size_t chunks : {64, 1024, 16384}) {
+    double seconds = 0;
+    size_t planned = plan(chunks, 8, &seconds);
+    printf("plan: %zu copies into %zu commands in %.1f us (%.1f ns per copy)\n", chunks, planned,
+           seconds * 1e6, seconds * 1e9 / chunks);
+  }
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_memcpy_type.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <vector>
+
+using hip::IsHostAccessMemory;
+using hip::ResolveMemcpyMemoryType;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+// Fine grain SVM and registered host memory are host side, everything else is device memory
+static bool testHostAccess() {
+  CHECK(IsHostAccessMemory(CL_MEM_SVM_FINE_GRAIN_BUFFER));
+  CHECK(IsHostAccessMemory(CL_MEM_USE_HOST_PTR));
+  CHECK(IsHostAccessMemory(CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE));
+  CHECK(!IsHostAccessMemory(0));
+  CHECK(!IsHostAccessMemory(CL_MEM_READ_WRITE));
+  CHECK(!IsHostAccessMemory(CL_MEM_ALLOC_HOST_PTR));
+  return true;
+}
+
+// A unified side takes the allocation type, a known host pointer is copied as device memory
+static bool testResolve() {
+  constexpr hipMemoryType host = hipMemoryTypeHost;
+  constexpr hipMemoryType device = hipMemoryTypeDevice;
+  constexpr hipMemoryType unified = hipMemoryTypeUnified;
+  constexpr hipMemoryType array = hipMemoryTypeArray;
+  // Pageable host memory
+  CHECK(ResolveMemcpyMemoryType(unified, false, host) == host);
+  CHECK(ResolveMemcpyMemoryType(host, false, host) == host);
+  // Pinned or fine grain host memory
+  CHECK(ResolveMemcpyMemoryType(unified, true, host) == device);
+  CHECK(ResolveMemcpyMemoryType(host, true, host) == device);
+  // Device memory
+  CHECK(ResolveMemcpyMemoryType(unified, true, device) == device);
+  CHECK(ResolveMemcpyMemoryType(device, true, device) == device);
+  // A declared device side is never downgraded, its validation rejects unknown pointers
+  CHECK(ResolveMemcpyMemoryType(device, false, host) == device);
+  CHECK(ResolveMemcpyMemoryType(array, false, host) == array);
+  return true;
+}
+
+// Pointer lookup with the same shape as amd::MemObjMap: an ordered map behind a lock
+class AllocationMap {
+ public:
+  void add(uintptr_t base, size_t size) { map_[base] = size; }
+  bool find(uintptr_t ptr) {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = map_.upper_bound(ptr);
+    if (it == map_.begin()) {
+      return false;
+    }
+    --it;
+    return ptr < it->first + it->second;
+  }
+
+ private:
+  std::mutex lock_;
+  std::map<uintptr_t, size_t> map_;
+};
+
+// Time of the pointer lookups of one copy, with the given number of lookups per copy
+static double lookups(AllocationMap& map, size_t allocations, size_t copies, size_t perCopy) {
+  constexpr size_t kAllocation = 1 << 20;
+  size_t found = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < copies; ++i) {
+    const uintptr_t ptr = kAllocation * ((i * 7919) % allocations + 1) + 64;
+    for (size_t j = 0; j < perCopy; ++j) {
+      found += map.find(ptr) ? 1 : 0;
+    }
+  }
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (found != copies * perCopy) {
+    printf("lookup: lost allocations\n");
+  }
+  return seconds * 1e9 / copies;
+}
+
+int main() {
+  bool passed = true;
+  passed &= testHostAccess();
+  passed &= testResolve();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+
+  // A pageable host to device hipMemcpy3D looked its pointers up 8 times, it resolves them once
+  constexpr size_t kCopies = 100000;
+  for (size_t allocations : {16, 1024, 65536}) {
+    AllocationMap map;
+    for (size_t i = 0; i < allocations; ++i) {
+      map.add((1 << 20) * (i + 1), 1 << 20);
+    }
+    double before = lookups(map, allocations, kCopies, 8);
+    double after = lookups(map, allocations, kCopies, 2);
+    printf("3D copy lookups: %zu allocations, %.1f ns per copy before, %.1f ns after\n",
+           allocations, before, after);
+  }
+  return passed ? 0 : 1;
+}
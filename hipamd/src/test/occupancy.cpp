@@ -0,0 +1,171 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_occupancy.hpp"
+
+#include <cstdio>
+
+using hip::OccupancyLimits;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+// A gfx9 like device: 4 SIMDs with 512 VGPRs and 800 SGPRs each, 64KiB LDS per CU
+static void makeDevice(amd::device::Info* info) {
+  info->vgprAllocGranularity_ = 4;
+  info->vgprsPerSimd_ = 512;
+  info->sgprsPerSimd_ = 800;
+  info->simdPerCU_ = 4;
+  info->maxComputeUnits_ = 60;
+  info->maxWorkGroupSize_ = 1024;
+  info->localMemSize_ = 64 * 1024;
+}
+
+static void makeKernel(amd::device::Kernel::WorkGroupInfo* wrkGrpInfo, size_t vgprs,
+                       size_t lds) {
+  wrkGrpInfo->wavefrontSize_ = 64;
+  wrkGrpInfo->usedVGPRs_ = vgprs;
+  wrkGrpInfo->usedSGPRs_ = 32;
+  wrkGrpInfo->usedLDSSize_ = lds;
+  wrkGrpInfo->isWGPMode_ = false;
+}
+
+static bool testLimits() {
+  amd::device::Info info = {};
+  makeDevice(&info);
+  amd::device::Kernel::WorkGroupInfo wrkGrpInfo = {};
+  makeKernel(&wrkGrpInfo, 32, 1024);
+  OccupancyLimits limits;
+  CHECK(hip::ComputeOccupancyLimits(&limits, wrkGrpInfo, info, 9, false));
+  // 512 / 32 VGPRs = 16 waves, capped at 8 waves per SIMD
+  CHECK(limits.aluLimitedThreads_ == 4 * 8 * 64);
+  CHECK((limits.maxCUs_ == 60) && (limits.staticLds_ == 1024));
+  makeKernel(&wrkGrpInfo, 128, 0);
+  CHECK(hip::ComputeOccupancyLimits(&limits, wrkGrpInfo, info, 9, false));
+  CHECK(limits.aluLimitedThreads_ == 4 * 4 * 64);
+  // More VGPRs than a SIMD has can't be resident
+  makeKernel(&wrkGrpInfo, 1024, 0);
+  CHECK(!hip::ComputeOccupancyLimits(&limits, wrkGrpInfo, info, 9, false));
+  return true;
+}
+
+static OccupancyLimits makeLimits(int aluThreads, size_t staticLds) {
+  OccupancyLimits limits;
+  limits.wavefrontSize_ = 64;
+  limits.maxBlockSize_ = 1024;
+  limits.aluLimitedThreads_ = aluThreads;
+  limits.staticLds_ = staticLds;
+  limits.ldsPerCU_ = 64 * 1024;
+  limits.maxCUs_ = 60;
+  return limits;
+}
+
+static bool testBlocksPerCU() {
+  OccupancyLimits limits = makeLimits(2048, 0);
+  CHECK(hip::OccupancyBlocksPerCU(limits, 256, 0) == 8);
+  // The blocks take whole waves
+  CHECK(hip::OccupancyBlocksPerCU(limits, 65, 0) == 16);
+  CHECK(hip::OccupancyBlocksPerCU(limits, 256, 16 * 1024) == 4);
+  CHECK(hip::OccupancyBlocksPerCU(limits, 0, 0) == 0);
+  CHECK(hip::OccupancyBlocksPerCU(limits, 1025, 0) == 0);
+  CHECK(hip::OccupancyAvailableDynamicSMem(limits, 4, 256) == 16 * 1024);
+  CHECK(hip::OccupancyAvailableDynamicSMem(limits, 9, 256) == 0);
+  limits.staticLds_ = 1024;
+  CHECK(hip::OccupancyAvailableDynamicSMem(limits, 4, 256) == 15 * 1024);
+  return true;
+}
+
+static int smemCalls = 0;
+static size_t smemPerThread = 0;
+
+static size_t smemOfBlock(int blockSize) {
+  smemCalls++;
+  return blockSize * smemPerThread;
+}
+
+// The exhaustive search over the same candidates, as a reference
+static int bestThreads(const OccupancyLimits& limits, int* blockSize) {
+  int best = 0;
+  *blockSize = 0;
+  for (int size = limits.maxBlockSize_; size > 0; --size) {
+    if ((size != limits.maxBlockSize_) && (size % limits.wavefrontSize_ != 0)) {
+      continue;
+    }
+    int threads = hip::OccupancyBlocksPerCU(limits, size, size * smemPerThread) * size;
+    if (threads > best) {
+      best = threads;
+      *blockSize = size;
+    }
+  }
+  return best;
+}
+
+static bool testVariableSMem() {
+  int gridSize = 0;
+  int blockSize = 0;
+  // Without shared memory the limit is full occupancy, the search stops at once
+  OccupancyLimits limits = makeLimits(2048, 0);
+  smemPerThread = 0;
+  smemCalls = 0;
+  hip::OccupancyMaxPotentialBlockSize(limits, smemOfBlock, 0, 0, &gridSize, &blockSize);
+  CHECK((blockSize == 1024) && (gridSize == 2 * 60) && (smemCalls == 1));
+
+  // 128 bytes per thread: 1024 threads don't fit, 512 threads are a single block
+  smemPerThread = 128;
+  smemCalls = 0;
+  hip::OccupancyMaxPotentialBlockSize(limits, smemOfBlock, 0, 0, &gridSize, &blockSize);
+  CHECK((blockSize == 512) && (gridSize == 60));
+
+  // The pruned search matches the exhaustive one for every LDS pressure and ALU limit
+  for (int aluThreads : {640, 1024, 1536, 2048}) {
+    for (size_t perThread : {0, 8, 24, 40, 64, 100}) {
+      for (size_t staticLds : {0, 4096}) {
+        limits = makeLimits(aluThreads, staticLds);
+        smemPerThread = perThread;
+        int expectedSize = 0;
+        int expected = bestThreads(limits, &expectedSize);
+        hip::OccupancyMaxPotentialBlockSize(limits, smemOfBlock, 0, 0, &gridSize, &blockSize);
+        int threads = hip::OccupancyBlocksPerCU(limits, blockSize, blockSize * perThread) *
+                      blockSize;
+        CHECK(threads == expected);
+      }
+    }
+  }
+
+  // The block size limit caps the search. 200 threads take 4 waves, 128 threads fill a CU
+  limits = makeLimits(2048, 0);
+  hip::OccupancyMaxPotentialBlockSize(limits, nullptr, 0, 200, &gridSize, &blockSize);
+  CHECK((blockSize == 128) && (gridSize == 16 * 60));
+  hip::OccupancyMaxPotentialBlockSize(limits, nullptr, 64 * 1024, 200, &gridSize, &blockSize);
+  CHECK((blockSize == 200) && (gridSize == 60));
+  return true;
+}
+
+int main() {
+  bool passed = true;
+  passed &= testLimits();
+  passed &= testBlocksPerCU();
+  passed &= testVariableSMem();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hiprtcComgrHelper.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using hiprtc::helpers::createOffloadBundle;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+typedef std::vector<std::pair<std::string, std::vector<char>>> CodeObjects;
+
+struct Entry {
+  uint64_t offset_;
+  uint64_t size_;
+  std::string id_;
+};
+
+// Reads the bundle as clang-offload-bundler does: the magic, the entry count and the entries
+static bool parse(const std::vector<char>& bundle, std::vector<Entry>* entries) {
+  static const char kMagic[] = "__CLANG_OFFLOAD_BUNDLE__";
+  const size_t magicSize = sizeof(kMagic) - 1;
+  CHECK(bundle.size() >= magicSize + sizeof(uint64_t));
+  CHECK(memcmp(bundle.data(), kMagic, magicSize) == 0);
+  size_t pos = magicSize;
+  auto read = [&](uint64_t* value) {
+    if (pos + sizeof(uint64_t) > bundle.size()) {
+      return false;
+    }
+    memcpy(value, bundle.data() + pos, sizeof(uint64_t));
+    pos += sizeof(uint64_t);
+    return true;
+  };
+  uint64_t count = 0;
+  CHECK(read(&count));
+  for (uint64_t i = 0; i < count; ++i) {
+    Entry entry;
+    uint64_t idSize = 0;
+    CHECK(read(&entry.offset_) && read(&entry.size_) && read(&idSize));
+    CHECK(pos + idSize <= bundle.size());
+    entry.id_.assign(bundle.data() + pos, idSize);
+    pos += idSize;
+    CHECK(entry.offset_ + entry.size_ <= bundle.size());
+    entries->push_back(entry);
+  }
+  return true;
+}
+
+static std::vector<char> fakeCodeObject(size_t size, char seed) {
+  std::vector<char> co(size);
+  for (size_t i = 0; i < size; ++i) {
+    co[i] = static_cast<char>(seed + i * 7);
+  }
+  memcpy(co.data(), "\x7f" "ELF", 4);
+  return co;
+}
+
+static bool testLayout() {
+  CodeObjects codeObjects = {{"amdgcn-amd-amdhsa--gfx90a:xnack+", fakeCodeObject(100, 1)},
+                             {"amdgcn-amd-amdhsa--gfx1100", fakeCodeObject(5000, 2)}};
+  std::vector<char> bundle;
+  CHECK(createOffloadBundle(codeObjects, bundle));
+  std::vector<Entry> entries;
+  CHECK(parse(bundle, &entries));
+  CHECK(entries.size() == 3);
+
+  // The empty host entry comes first
+  CHECK(entries[0].id_.rfind("host-x86_64-", 0) == 0);
+  CHECK(entries[0].size_ == 0);
+  uint64_t end = 0;
+  for (size_t i = 1; i < entries.size(); ++i) {
+    const auto& co = codeObjects[i - 1];
+    CHECK(entries[i].id_ == "hipv4-" + co.first);
+    CHECK(entries[i].size_ == co.second.size());
+    CHECK((entries[i].offset_ % 4096) == 0);
+    CHECK(entries[i].offset_ >= end);
+    CHECK(memcmp(bundle.data() + entries[i].offset_, co.second.data(), co.second.size()) == 0);
+    end = entries[i].offset_ + entries[i].size_;
+  }
+  CHECK(end == bundle.size());
+  return true;
+}
+
+static bool testInvalid() {
+  std::vector<char> bundle;
+  CHECK(!createOffloadBundle({{"amdgcn-amd-amdhsa--gfx90a", {}}}, bundle));
+  return true;
+}
+
+// Unbundles the file with clang-offload-bundler, if the ROCm install has it
+static bool testOfflineRoundTrip() {
+  const char* rocm = getenv("ROCM_PATH");
+  std::string tool = std::string((rocm != nullptr) ? rocm : "/opt/rocm") +
+                     "/llvm/bin/clang-offload-bundler";
+  if (access(tool.c_str(), X_OK) != 0) {
+    printf("testOfflineRoundTrip: %s not found, skipped\n", tool.c_str());
+    return true;
+  }
+  CodeObjects codeObjects = {{"amdgcn-amd-amdhsa--gfx90a", fakeCodeObject(3000, 3)},
+                             {"amdgcn-amd-amdhsa--gfx942", fakeCodeObject(10000, 4)}};
+  std::vector<char> bundle;
+  CHECK(createOffloadBundle(codeObjects, bundle));
+
+  char dir[] = "/tmp/offloadbundleXXXXXX";
+  CHECK(mkdtemp(dir) != nullptr);
+  const std::string input = std::string(dir) + "/bundle.co";
+  {
+    std::ofstream file(input, std::ios::binary);
+    file.write(bundle.data(), bundle.size());
+    CHECK(file.good());
+  }
+  std::string targets;
+  std::string outputs;
+  for (size_t i = 0; i < codeObjects.size(); ++i) {
+    targets += (i == 0 ? "" : ",") + std::string("hipv4-") + codeObjects[i].first;
+    outputs += " --output=" + std::string(dir) + "/co" + std::to_string(i);
+  }
+  const std::string command = tool + " --unbundle --type=o --targets=" + targets +
+                              " --input=" + input + outputs;
+  CHECK(system(command.c_str()) == 0);
+  for (size_t i = 0; i < codeObjects.size(); ++i) {
+    const std::string name = std::string(dir) + "/co" + std::to_string(i);
+    std::ifstream file(name, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+    CHECK(data == codeObjects[i].second);
+    remove(name.c_str());
+  }
+  remove(input.c_str());
+  rmdir(dir);
+  return true;
+}
+
+int main() {
+  bool passed = true;
+  passed &= testLayout();
+  passed &= testInvalid();
+  passed &= testOfflineRoundTrip();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,1287 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "cl_common.hpp"
+#include "cl_command_buffer_khr.h"
+#include "platform/context.hpp"
+#include "platform/command.hpp"
+#include "platform/commandbuffer.hpp"
+#include "platform/kernel.hpp"
+#include "platform/program.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+//! Checks the launch sizes of the kernel the same way clEnqueueNDRangeKernel does
+static cl_int validateWorkSizes(const device::Kernel& devKernel, cl_uint work_dim,
+                                const size_t* global_work_size, const size_t* local_work_size) {
+  for (cl_uint dim = 0; dim < work_dim; ++dim) {
+    // >32bits global work size is not supported.
+    if ((global_work_size[dim] == 0) ||
+        (global_work_size[dim] > static_cast<size_t>(0xffffffff))) {
+      return CL_INVALID_GLOBAL_WORK_SIZE;
+    }
+  }
+  if (local_work_size == NULL) {
+    return CL_SUCCESS;
+  }
+  size_t numWorkItems = 1;
+  for (cl_uint dim = 0; dim < work_dim; ++dim) {
+    if ((devKernel.workGroupInfo()->compileSize_[0] != 0) &&
+        (local_work_size[dim] != devKernel.workGroupInfo()->compileSize_[dim])) {
+      return CL_INVALID_WORK_GROUP_SIZE;
+    }
+    numWorkItems *= local_work_size[dim];
+  }
+  // Make sure local work size is valid
+  if ((numWorkItems == 0) || (numWorkItems > devKernel.workGroupInfo()->size_)) {
+    return CL_INVALID_WORK_GROUP_SIZE;
+  }
+  // Check if uniform was requested and validate dimensions
+  if (devKernel.workGroupInfo()->uniformWorkGroupSize_) {
+    for (cl_uint dim = 0; dim < work_dim; ++dim) {
+      if ((global_work_size[dim] % local_work_size[dim]) != 0) {
+        return CL_INVALID_WORK_GROUP_SIZE;
+      }
+    }
+  }
+  return CL_SUCCESS;
+}
+
+//! Returns the queue of the recorded commands. A single queue buffer accepts NULL
+//! or its own queue only
+static amd::HostQueue* recordQueue(amd::CommandBuffer& commandBuffer,
+                                   cl_command_queue command_queue) {
+  if ((command_queue != NULL) && (as_amd(command_queue) != &commandBuffer.queue())) {
+    return NULL;
+  }
+  return &commandBuffer.queue();
+}
+
+//! Returns an array of values the same way amd::clGetInfo returns a single value
+static cl_int getArrayInfo(const void* values, size_t valueSize, size_t param_value_size,
+                           void* param_value, size_t* param_value_size_ret) {
+  if ((param_value != NULL) && (param_value_size < valueSize)) {
+    return CL_INVALID_VALUE;
+  }
+  *not_null(param_value_size_ret) = valueSize;
+  if ((param_value != NULL) && (valueSize != 0)) {
+    ::memcpy(param_value, values, valueSize);
+  }
+  return CL_SUCCESS;
+}
+
+//! Holds the image of the mip level in an image origin. The image itself, if it has no mip
+//! levels, or a view of the level, which the recorded command keeps alive
+class MipLevel : public amd::EmbeddedObject {
+ public:
+  //! Selects the level and resets it in the origin of the level
+  MipLevel(amd::Image* image, const size_t* origin, amd::Coord3D& levelOrigin)
+      : image_(image), view_(NULL) {
+    if (image->getMipLevels() > 1) {
+      // Create a view for the specified mip level
+      view_ = image->createView(image->getContext(), image->getImageFormat(), NULL,
+                                origin[image->getDims()]);
+      image_ = view_;
+      // Reset the mip level value to 0, since a view was created
+      if (image->getDims() < 3) {
+        levelOrigin.c[image->getDims()] = 0;
+      }
+    }
+  }
+  ~MipLevel() {
+    if (view_ != NULL) {
+      view_->release();
+    }
+  }
+
+  //! Returns the image of the level or NULL if the view can't be created
+  amd::Image* operator()() const { return image_; }
+
+ private:
+  amd::Image* image_;  //!< The image of the level
+  amd::Image* view_;   //!< The view of the level, owned by the holder
+
+  //! Disable copy constructor
+  MipLevel(const MipLevel&);
+
+  //! Disable assignment
+  MipLevel& operator=(const MipLevel&);
+};
+
+/*! \addtogroup API
+ *  @{
+ *
+ *  \addtogroup KHR_Extensions
+ *  @{
+ *
+ */
+
+/*! \brief Creates a command buffer, which records the commands of the queue.
+ *
+ *  \return A valid non-zero command buffer object and errcode_ret is set to
+ *  CL_SUCCESS if the command buffer is created successfully. Otherwise, it
+ *  returns a NULL value with one of the following error values:
+ *  - CL_INVALID_VALUE if \a num_queues isn't one, \a queues is NULL or
+ *    \a properties has an unknown property or flag.
+ *  - CL_INVALID_COMMAND_QUEUE if the queue is invalid or its device doesn't
+ *    support cl_khr_command_buffer.
+ *  - CL_OUT_OF_HOST_MEMORY if there is a failure to allocate resources.
+ */
+RUNTIME_ENTRY_RET(cl_command_buffer_khr, clCreateCommandBufferKHR,
+                  (cl_uint num_queues, const cl_command_queue* queues,
+                   const cl_command_buffer_properties_khr* properties, cl_int* errcode_ret)) {
+  if ((num_queues != 1) || (queues == NULL)) {
+    *not_null(errcode_ret) = CL_INVALID_VALUE;
+    return (cl_command_buffer_khr)0;
+  }
+  if (!is_valid(queues[0])) {
+    *not_null(errcode_ret) = CL_INVALID_COMMAND_QUEUE;
+    return (cl_command_buffer_khr)0;
+  }
+  amd::HostQueue* queue = as_amd(queues[0])->asHostQueue();
+  if ((queue == NULL) || !queue->device().settings().checkExtension(ClKhrCommandBuffer)) {
+    *not_null(errcode_ret) = CL_INVALID_COMMAND_QUEUE;
+    return (cl_command_buffer_khr)0;
+  }
+
+  cl_command_buffer_flags_khr flags = 0;
+  std::vector<cl_command_buffer_properties_khr> propertiesArray;
+  if (properties != NULL) {
+    const cl_command_buffer_properties_khr* p = properties;
+    while (*p != 0) {
+      if ((*p != CL_COMMAND_BUFFER_FLAGS_KHR) ||
+          ((p[1] & ~(CL_COMMAND_BUFFER_SIMULTANEOUS_USE_KHR | CL_COMMAND_BUFFER_MUTABLE_KHR)) !=
+           0)) {
+        *not_null(errcode_ret) = CL_INVALID_VALUE;
+        return (cl_command_buffer_khr)0;
+      }
+      flags |= p[1];
+      p += 2;
+    }
+    propertiesArray.assign(properties, p + 1);
+  }
+
+  amd::CommandBuffer* commandBuffer = new amd::CommandBuffer(*queue, flags, propertiesArray);
+  if (commandBuffer == NULL) {
+    *not_null(errcode_ret) = CL_OUT_OF_HOST_MEMORY;
+    return (cl_command_buffer_khr)0;
+  }
+
+  *not_null(errcode_ret) = CL_SUCCESS;
+  return as_cl(commandBuffer);
+}
+RUNTIME_EXIT
+
+/*! \brief Ends the recording of the command buffer.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_OPERATION if \a command_buffer was finalized already.
+ */
+RUNTIME_ENTRY(cl_int, clFinalizeCommandBufferKHR, (cl_command_buffer_khr command_buffer)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  return as_amd(command_buffer)->finalize();
+}
+RUNTIME_EXIT
+
+/*! \brief Increments the command buffer reference count.
+ */
+RUNTIME_ENTRY(cl_int, clRetainCommandBufferKHR, (cl_command_buffer_khr command_buffer)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  as_amd(command_buffer)->retain();
+  return CL_SUCCESS;
+}
+RUNTIME_EXIT
+
+/*! \brief Decrements the command buffer reference count. The pending replays keep
+ *  their commands alive after the last release.
+ */
+RUNTIME_ENTRY(cl_int, clReleaseCommandBufferKHR, (cl_command_buffer_khr command_buffer)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  as_amd(command_buffer)->release();
+  return CL_SUCCESS;
+}
+RUNTIME_EXIT
+
+/*! \brief Replays the recorded commands with a single enqueue.
+ *
+ *  \param queues is NULL to replay on the queue of the recording or a queue with
+ *  the same device, context and out-of-order mode.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_VALUE if \a num_queues and \a queues don't match or
+ *    \a num_queues is greater than one.
+ *  - CL_INVALID_COMMAND_QUEUE if the queue isn't valid.
+ *  - CL_INCOMPATIBLE_COMMAND_QUEUE_KHR if the queue doesn't match the recording.
+ *  - CL_INVALID_OPERATION if \a command_buffer isn't finalized or it is pending
+ *    without CL_COMMAND_BUFFER_SIMULTANEOUS_USE_KHR.
+ *  - CL_INVALID_EVENT_WAIT_LIST if the event wait list isn't valid.
+ */
+RUNTIME_ENTRY(cl_int, clEnqueueCommandBufferKHR,
+              (cl_uint num_queues, cl_command_queue* queues, cl_command_buffer_khr command_buffer,
+               cl_uint num_events_in_wait_list, const cl_event* event_wait_list,
+               cl_event* event)) {
+  *not_null(event) = NULL;
+
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+
+  if ((num_queues == 0) != (queues == NULL)) {
+    return CL_INVALID_VALUE;
+  }
+  if (num_queues > 1) {
+    return CL_INVALID_VALUE;
+  }
+  amd::HostQueue* queue = &commandBuffer->queue();
+  if (num_queues == 1) {
+    if (!is_valid(queues[0])) {
+      return CL_INVALID_COMMAND_QUEUE;
+    }
+    queue = as_amd(queues[0])->asHostQueue();
+    if (NULL == queue) {
+      return CL_INVALID_COMMAND_QUEUE;
+    }
+    const amd::HostQueue& recordQueue = commandBuffer->queue();
+    if ((&queue->device() != &recordQueue.device()) ||
+        (&queue->context() != &recordQueue.context()) ||
+        (queue->properties().test(CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE) !=
+         recordQueue.properties().test(CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE))) {
+      return CL_INCOMPATIBLE_COMMAND_QUEUE_KHR;
+    }
+  }
+  amd::HostQueue& hostQueue = *queue;
+
+  amd::Command::EventWaitList eventWaitList;
+  cl_int err = amd::clSetEventWaitList(eventWaitList, hostQueue, num_events_in_wait_list,
+                                       event_wait_list);
+  if (err != CL_SUCCESS) {
+    return err;
+  }
+
+  amd::Command* command = NULL;
+  err = commandBuffer->enqueue(hostQueue, eventWaitList, &command);
+  if (err != CL_SUCCESS) {
+    return err;
+  }
+
+  *not_null(event) = as_cl(&command->event());
+  if (event == NULL) {
+    command->release();
+  }
+  return CL_SUCCESS;
+}
+RUNTIME_EXIT
+
+/*! \brief Records a barrier. It waits for the sync points or for all earlier
+ *  commands if there are none, all later commands wait for the barrier.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_COMMAND_QUEUE if \a command_queue isn't NULL or the queue of
+ *    \a command_buffer.
+ *  - CL_INVALID_OPERATION if \a command_buffer was finalized.
+ *  - CL_INVALID_SYNC_POINT_WAIT_LIST_KHR if the sync point wait list isn't valid.
+ */
+RUNTIME_ENTRY(cl_int, clCommandBarrierWithWaitListKHR,
+              (cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+               cl_uint num_sync_points_in_wait_list, const cl_sync_point_khr* sync_point_wait_list,
+               cl_sync_point_khr* sync_point, cl_mutable_command_khr* mutable_handle)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+  if (recordQueue(*commandBuffer, command_queue) == NULL) {
+    return CL_INVALID_COMMAND_QUEUE;
+  }
+  *not_null(mutable_handle) = NULL;
+
+  amd::CommandBuffer::Node* node = new amd::CommandBuffer::BarrierNode();
+  if (node == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  return commandBuffer->record(node, num_sync_points_in_wait_list, sync_point_wait_list, true,
+                               sync_point);
+}
+RUNTIME_EXIT
+
+/*! \brief Records a buffer to buffer copy.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_COMMAND_QUEUE if \a command_queue isn't NULL or the queue of
+ *    \a command_buffer.
+ *  - CL_INVALID_MEM_OBJECT if a buffer isn't valid.
+ *  - CL_INVALID_CONTEXT if the buffers and the queue have different contexts.
+ *  - CL_INVALID_VALUE if the regions are out of bounds.
+ *  - CL_MEM_COPY_OVERLAP if the regions overlap in the same buffer.
+ *  - CL_INVALID_OPERATION if \a command_buffer was finalized.
+ *  - CL_INVALID_SYNC_POINT_WAIT_LIST_KHR if the sync point wait list isn't valid.
+ */
+RUNTIME_ENTRY(cl_int, clCommandCopyBufferKHR,
+              (cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+               cl_mem src_buffer, cl_mem dst_buffer, size_t src_offset, size_t dst_offset,
+               size_t size, cl_uint num_sync_points_in_wait_list,
+               const cl_sync_point_khr* sync_point_wait_list, cl_sync_point_khr* sync_point,
+               cl_mutable_command_khr* mutable_handle)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+  amd::HostQueue* queue = recordQueue(*commandBuffer, command_queue);
+  if (queue == NULL) {
+    return CL_INVALID_COMMAND_QUEUE;
+  }
+  *not_null(mutable_handle) = NULL;
+
+  if (!is_valid(src_buffer) || !is_valid(dst_buffer)) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+  amd::Buffer* srcBuffer = as_amd(src_buffer)->asBuffer();
+  amd::Buffer* dstBuffer = as_amd(dst_buffer)->asBuffer();
+  if (srcBuffer == NULL || dstBuffer == NULL) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+
+  if (queue->context() != srcBuffer->getContext() ||
+      queue->context() != dstBuffer->getContext()) {
+    return CL_INVALID_CONTEXT;
+  }
+
+  amd::Coord3D srcOffset(src_offset, 0, 0);
+  amd::Coord3D dstOffset(dst_offset, 0, 0);
+  amd::Coord3D copySize(size, 1, 1);
+
+  if (!srcBuffer->validateRegion(srcOffset, copySize) ||
+      !dstBuffer->validateRegion(dstOffset, copySize)) {
+    return CL_INVALID_VALUE;
+  }
+
+  if (srcBuffer == dstBuffer && ((src_offset <= dst_offset && dst_offset < src_offset + size) ||
+                                 (dst_offset <= src_offset && src_offset < dst_offset + size))) {
+    return CL_MEM_COPY_OVERLAP;
+  }
+
+  amd::CommandBuffer::Node* node = new amd::CommandBuffer::CopyNode(
+      CL_COMMAND_COPY_BUFFER, *srcBuffer, *dstBuffer, srcOffset, dstOffset, copySize);
+  if (node == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  return commandBuffer->record(node, num_sync_points_in_wait_list, sync_point_wait_list, false,
+                               sync_point);
+}
+RUNTIME_EXIT
+
+/*! \brief Records a buffer fill with a pattern.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_COMMAND_QUEUE if \a command_queue isn't NULL or the queue of
+ *    \a command_buffer.
+ *  - CL_INVALID_MEM_OBJECT if \a buffer isn't valid.
+ *  - CL_INVALID_CONTEXT if the buffer and the queue have different contexts.
+ *  - CL_INVALID_VALUE if the pattern or the region isn't valid.
+ *  - CL_INVALID_OPERATION if \a command_buffer was finalized.
+ *  - CL_INVALID_SYNC_POINT_WAIT_LIST_KHR if the sync point wait list isn't valid.
+ */
+RUNTIME_ENTRY(cl_int, clCommandFillBufferKHR,
+              (cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+               cl_mem buffer, const void* pattern, size_t pattern_size, size_t offset,
+               size_t size, cl_uint num_sync_points_in_wait_list,
+               const cl_sync_point_khr* sync_point_wait_list, cl_sync_point_khr* sync_point,
+               cl_mutable_command_khr* mutable_handle)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+  amd::HostQueue* queue = recordQueue(*commandBuffer, command_queue);
+  if (queue == NULL) {
+    return CL_INVALID_COMMAND_QUEUE;
+  }
+  *not_null(mutable_handle) = NULL;
+
+  if (!is_valid(buffer)) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+  amd::Buffer* fillBuffer = as_amd(buffer)->asBuffer();
+  if (fillBuffer == NULL) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+
+  if ((pattern == NULL) || (pattern_size == 0) ||
+      (pattern_size > amd::FillMemoryCommand::MaxFillPatterSize) ||
+      ((pattern_size & (pattern_size - 1)) != 0)) {
+    return CL_INVALID_VALUE;
+  }
+
+  // Offset and size must be multiple of pattern_size
+  if (!(amd::isMultipleOf(offset, pattern_size) && amd::isMultipleOf(size, pattern_size))) {
+    return CL_INVALID_VALUE;
+  }
+
+  if (queue->context() != fillBuffer->getContext()) {
+    return CL_INVALID_CONTEXT;
+  }
+
+  amd::Coord3D fillOffset(offset, 0, 0);
+  amd::Coord3D fillSize(size, 1, 1);
+  if (!fillBuffer->validateRegion(fillOffset, fillSize)) {
+    return CL_INVALID_VALUE;
+  }
+
+  // surface takes [pitch, width, height]
+  amd::Coord3D surface(size, size, 1);
+  amd::CommandBuffer::Node* node = new amd::CommandBuffer::FillNode(
+      CL_COMMAND_FILL_BUFFER, *fillBuffer, pattern, pattern_size, fillOffset, fillSize, surface);
+  if (node == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  return commandBuffer->record(node, num_sync_points_in_wait_list, sync_point_wait_list, false,
+                               sync_point);
+}
+RUNTIME_EXIT
+
+/*! \brief Records a rectangular buffer to buffer copy.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_COMMAND_QUEUE if \a command_queue isn't NULL or the queue of
+ *    \a command_buffer.
+ *  - CL_INVALID_MEM_OBJECT if a buffer isn't valid.
+ *  - CL_INVALID_CONTEXT if the buffers and the queue have different contexts.
+ *  - CL_INVALID_VALUE if the rectangles or the regions aren't valid.
+ *  - CL_MEM_COPY_OVERLAP if the regions overlap in the same buffer.
+ *  - CL_INVALID_OPERATION if \a command_buffer was finalized.
+ *  - CL_INVALID_SYNC_POINT_WAIT_LIST_KHR if the sync point wait list isn't valid.
+ */
+RUNTIME_ENTRY(cl_int, clCommandCopyBufferRectKHR,
+              (cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+               cl_mem src_buffer, cl_mem dst_buffer, const size_t* src_origin,
+               const size_t* dst_origin, const size_t* region, size_t src_row_pitch,
+               size_t src_slice_pitch, size_t dst_row_pitch, size_t dst_slice_pitch,
+               cl_uint num_sync_points_in_wait_list, const cl_sync_point_khr* sync_point_wait_list,
+               cl_sync_point_khr* sync_point, cl_mutable_command_khr* mutable_handle)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+  amd::HostQueue* queue = recordQueue(*commandBuffer, command_queue);
+  if (queue == NULL) {
+    return CL_INVALID_COMMAND_QUEUE;
+  }
+  *not_null(mutable_handle) = NULL;
+
+  if (!is_valid(src_buffer) || !is_valid(dst_buffer)) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+  amd::Buffer* srcBuffer = as_amd(src_buffer)->asBuffer();
+  amd::Buffer* dstBuffer = as_amd(dst_buffer)->asBuffer();
+  if (srcBuffer == NULL || dstBuffer == NULL) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+
+  if (queue->context() != srcBuffer->getContext() ||
+      queue->context() != dstBuffer->getContext()) {
+    return CL_INVALID_CONTEXT;
+  }
+
+  // Create buffer rectangle info structure
+  amd::BufferRect srcRect;
+  amd::BufferRect dstRect;
+
+  if (!srcRect.create(src_origin, region, src_row_pitch, src_slice_pitch) ||
+      !dstRect.create(dst_origin, region, dst_row_pitch, dst_slice_pitch)) {
+    return CL_INVALID_VALUE;
+  }
+
+  amd::Coord3D srcStart(srcRect.start_, 0, 0);
+  amd::Coord3D dstStart(dstRect.start_, 0, 0);
+  amd::Coord3D srcEnd(srcRect.end_, 1, 1);
+  amd::Coord3D dstEnd(dstRect.end_, 1, 1);
+
+  if (!srcBuffer->validateRegion(srcStart, srcEnd) ||
+      !dstBuffer->validateRegion(dstStart, dstEnd)) {
+    return CL_INVALID_VALUE;
+  }
+
+  // Check if regions overlap each other
+  if ((srcBuffer == dstBuffer) &&
+      (std::abs(static_cast<long>(src_origin[0]) - static_cast<long>(dst_origin[0])) <
+       static_cast<long>(region[0])) &&
+      (std::abs(static_cast<long>(src_origin[1]) - static_cast<long>(dst_origin[1])) <
+       static_cast<long>(region[1])) &&
+      (std::abs(static_cast<long>(src_origin[2]) - static_cast<long>(dst_origin[2])) <
+       static_cast<long>(region[2]))) {
+    return CL_MEM_COPY_OVERLAP;
+  }
+
+  amd::Coord3D size(region[0], region[1], region[2]);
+  amd::CommandBuffer::Node* node =
+      new amd::CommandBuffer::CopyNode(CL_COMMAND_COPY_BUFFER_RECT, *srcBuffer, *dstBuffer,
+                                       srcStart, dstStart, size, srcRect, dstRect);
+  if (node == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  return commandBuffer->record(node, num_sync_points_in_wait_list, sync_point_wait_list, false,
+                               sync_point);
+}
+RUNTIME_EXIT
+
+/*! \brief Records a buffer to image copy.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_COMMAND_QUEUE if \a command_queue isn't NULL or the queue of
+ *    \a command_buffer.
+ *  - CL_INVALID_MEM_OBJECT if the buffer or the image isn't valid.
+ *  - CL_INVALID_CONTEXT if the memory objects and the queue have different contexts.
+ *  - CL_INVALID_VALUE if the regions are out of bounds.
+ *  - CL_INVALID_OPERATION if the image is a depth stencil image or \a command_buffer
+ *    was finalized.
+ *  - CL_INVALID_SYNC_POINT_WAIT_LIST_KHR if the sync point wait list isn't valid.
+ */
+RUNTIME_ENTRY(cl_int, clCommandCopyBufferToImageKHR,
+              (cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+               cl_mem src_buffer, cl_mem dst_image, size_t src_offset, const size_t* dst_origin,
+               const size_t* region, cl_uint num_sync_points_in_wait_list,
+               const cl_sync_point_khr* sync_point_wait_list, cl_sync_point_khr* sync_point,
+               cl_mutable_command_khr* mutable_handle)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+  amd::HostQueue* queue = recordQueue(*commandBuffer, command_queue);
+  if (queue == NULL) {
+    return CL_INVALID_COMMAND_QUEUE;
+  }
+  *not_null(mutable_handle) = NULL;
+
+  if (!is_valid(src_buffer) || !is_valid(dst_image)) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+  amd::Buffer* srcBuffer = as_amd(src_buffer)->asBuffer();
+  amd::Image* dstImage = as_amd(dst_image)->asImage();
+  if (srcBuffer == NULL || dstImage == NULL) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+
+  if (queue->context() != srcBuffer->getContext() ||
+      queue->context() != dstImage->getContext()) {
+    return CL_INVALID_CONTEXT;
+  }
+
+  if (dstImage->getImageFormat().image_channel_order == CL_DEPTH_STENCIL) {
+    return CL_INVALID_OPERATION;
+  }
+
+  amd::Coord3D dstOrigin(dst_origin[0], dst_origin[1], dst_origin[2]);
+  amd::Coord3D srcOffset(src_offset, 0, 0);
+  amd::Coord3D dstRegion(region[0], region[1], region[2]);
+  amd::Coord3D copySize(
+      region[0] * region[1] * region[2] * dstImage->getImageFormat().getElementSize(), 0, 0);
+
+  MipLevel dstLevel(dstImage, dst_origin, dstOrigin);
+  if (dstLevel() == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+
+  if (!srcBuffer->validateRegion(srcOffset, copySize) ||
+      !dstLevel()->validateRegion(dstOrigin, dstRegion)) {
+    return CL_INVALID_VALUE;
+  }
+
+  amd::CommandBuffer::Node* node =
+      new amd::CommandBuffer::CopyNode(CL_COMMAND_COPY_BUFFER_TO_IMAGE, *srcBuffer, *dstLevel(),
+                                       srcOffset, dstOrigin, dstRegion);
+  if (node == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  return commandBuffer->record(node, num_sync_points_in_wait_list, sync_point_wait_list, false,
+                               sync_point);
+}
+RUNTIME_EXIT
+
+/*! \brief Records an image to image copy.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_COMMAND_QUEUE if \a command_queue isn't NULL or the queue of
+ *    \a command_buffer.
+ *  - CL_INVALID_MEM_OBJECT if an image isn't valid.
+ *  - CL_INVALID_CONTEXT if the images and the queue have different contexts.
+ *  - CL_IMAGE_FORMAT_MISMATCH if the images have different formats.
+ *  - CL_INVALID_VALUE if the regions are out of bounds.
+ *  - CL_MEM_COPY_OVERLAP if the regions overlap in the same image.
+ *  - CL_INVALID_OPERATION if the images are depth stencil images or \a command_buffer
+ *    was finalized.
+ *  - CL_INVALID_SYNC_POINT_WAIT_LIST_KHR if the sync point wait list isn't valid.
+ */
+RUNTIME_ENTRY(cl_int, clCommandCopyImageKHR,
+              (cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+               cl_mem src_image, cl_mem dst_image, const size_t* src_origin,
+               const size_t* dst_origin, const size_t* region,
+               cl_uint num_sync_points_in_wait_list, const cl_sync_point_khr* sync_point_wait_list,
+               cl_sync_point_khr* sync_point, cl_mutable_command_khr* mutable_handle)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+  amd::HostQueue* queue = recordQueue(*commandBuffer, command_queue);
+  if (queue == NULL) {
+    return CL_INVALID_COMMAND_QUEUE;
+  }
+  *not_null(mutable_handle) = NULL;
+
+  if (!is_valid(src_image) || !is_valid(dst_image)) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+  amd::Image* srcImage = as_amd(src_image)->asImage();
+  amd::Image* dstImage = as_amd(dst_image)->asImage();
+  if (srcImage == NULL || dstImage == NULL) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+
+  if (queue->context() != srcImage->getContext() ||
+      queue->context() != dstImage->getContext()) {
+    return CL_INVALID_CONTEXT;
+  }
+
+  if (srcImage->getImageFormat() != dstImage->getImageFormat()) {
+    return CL_IMAGE_FORMAT_MISMATCH;
+  }
+
+  if (srcImage->getImageFormat().image_channel_order == CL_DEPTH_STENCIL) {
+    return CL_INVALID_OPERATION;
+  }
+
+  amd::Coord3D srcOrigin(src_origin[0], src_origin[1], src_origin[2]);
+  amd::Coord3D dstOrigin(dst_origin[0], dst_origin[1], dst_origin[2]);
+  amd::Coord3D copyRegion(region[0], region[1], region[2]);
+
+  MipLevel srcLevel(srcImage, src_origin, srcOrigin);
+  if (srcLevel() == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  if (!srcLevel()->validateRegion(srcOrigin, copyRegion)) {
+    return CL_INVALID_VALUE;
+  }
+
+  MipLevel dstLevel(dstImage, dst_origin, dstOrigin);
+  if (dstLevel() == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  if (!dstLevel()->validateRegion(dstOrigin, copyRegion)) {
+    return CL_INVALID_VALUE;
+  }
+
+  if (src_image == dst_image) {
+    if ((src_origin[0] <= dst_origin[0] && dst_origin[0] < src_origin[0] + region[0]) ||
+        (dst_origin[0] <= src_origin[0] && src_origin[0] < dst_origin[0] + region[0]) ||
+        (src_origin[1] <= dst_origin[1] && dst_origin[1] < src_origin[1] + region[1]) ||
+        (dst_origin[1] <= src_origin[1] && src_origin[1] < dst_origin[1] + region[1])) {
+      return CL_MEM_COPY_OVERLAP;
+    }
+    if (srcImage->getDims() > 2) {
+      if ((src_origin[2] <= dst_origin[2] && dst_origin[2] < src_origin[2] + region[2]) ||
+          (dst_origin[2] <= src_origin[2] && src_origin[2] < dst_origin[2] + region[2])) {
+        return CL_MEM_COPY_OVERLAP;
+      }
+    }
+  }
+
+  amd::CommandBuffer::Node* node =
+      new amd::CommandBuffer::CopyNode(CL_COMMAND_COPY_IMAGE, *srcLevel(), *dstLevel(),
+                                       srcOrigin, dstOrigin, copyRegion);
+  if (node == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  return commandBuffer->record(node, num_sync_points_in_wait_list, sync_point_wait_list, false,
+                               sync_point);
+}
+RUNTIME_EXIT
+
+/*! \brief Records an image to buffer copy.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_COMMAND_QUEUE if \a command_queue isn't NULL or the queue of
+ *    \a command_buffer.
+ *  - CL_INVALID_MEM_OBJECT if the image or the buffer isn't valid.
+ *  - CL_INVALID_CONTEXT if the memory objects and the queue have different contexts.
+ *  - CL_INVALID_VALUE if the regions are out of bounds.
+ *  - CL_INVALID_OPERATION if the image is a depth stencil image or \a command_buffer
+ *    was finalized.
+ *  - CL_INVALID_SYNC_POINT_WAIT_LIST_KHR if the sync point wait list isn't valid.
+ */
+RUNTIME_ENTRY(cl_int, clCommandCopyImageToBufferKHR,
+              (cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+               cl_mem src_image, cl_mem dst_buffer, const size_t* src_origin,
+               const size_t* region, size_t dst_offset, cl_uint num_sync_points_in_wait_list,
+               const cl_sync_point_khr* sync_point_wait_list, cl_sync_point_khr* sync_point,
+               cl_mutable_command_khr* mutable_handle)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+  amd::HostQueue* queue = recordQueue(*commandBuffer, command_queue);
+  if (queue == NULL) {
+    return CL_INVALID_COMMAND_QUEUE;
+  }
+  *not_null(mutable_handle) = NULL;
+
+  if (!is_valid(src_image) || !is_valid(dst_buffer)) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+  amd::Image* srcImage = as_amd(src_image)->asImage();
+  amd::Buffer* dstBuffer = as_amd(dst_buffer)->asBuffer();
+  if (srcImage == NULL || dstBuffer == NULL) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+
+  if (queue->context() != srcImage->getContext() ||
+      queue->context() != dstBuffer->getContext()) {
+    return CL_INVALID_CONTEXT;
+  }
+
+  if (srcImage->getImageFormat().image_channel_order == CL_DEPTH_STENCIL) {
+    return CL_INVALID_OPERATION;
+  }
+
+  amd::Coord3D srcOrigin(src_origin[0], src_origin[1], src_origin[2]);
+  amd::Coord3D dstOffset(dst_offset, 0, 0);
+  amd::Coord3D srcRegion(region[0], region[1], region[2]);
+  amd::Coord3D copySize(
+      region[0] * region[1] * region[2] * srcImage->getImageFormat().getElementSize(), 0, 0);
+
+  MipLevel srcLevel(srcImage, src_origin, srcOrigin);
+  if (srcLevel() == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+
+  if (!srcLevel()->validateRegion(srcOrigin, srcRegion) ||
+      !dstBuffer->validateRegion(dstOffset, copySize)) {
+    return CL_INVALID_VALUE;
+  }
+
+  amd::CommandBuffer::Node* node =
+      new amd::CommandBuffer::CopyNode(CL_COMMAND_COPY_IMAGE_TO_BUFFER, *srcLevel(), *dstBuffer,
+                                       srcOrigin, dstOffset, srcRegion);
+  if (node == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  return commandBuffer->record(node, num_sync_points_in_wait_list, sync_point_wait_list, false,
+                               sync_point);
+}
+RUNTIME_EXIT
+
+/*! \brief Records an image fill with a color.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_COMMAND_QUEUE if \a command_queue isn't NULL or the queue of
+ *    \a command_buffer.
+ *  - CL_INVALID_MEM_OBJECT if \a image isn't valid.
+ *  - CL_INVALID_CONTEXT if the image and the queue have different contexts.
+ *  - CL_INVALID_VALUE if \a fill_color is NULL or the region is out of bounds.
+ *  - CL_INVALID_OPERATION if the image is a depth stencil image or \a command_buffer
+ *    was finalized.
+ *  - CL_INVALID_SYNC_POINT_WAIT_LIST_KHR if the sync point wait list isn't valid.
+ */
+RUNTIME_ENTRY(cl_int, clCommandFillImageKHR,
+              (cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+               cl_mem image, const void* fill_color, const size_t* origin, const size_t* region,
+               cl_uint num_sync_points_in_wait_list, const cl_sync_point_khr* sync_point_wait_list,
+               cl_sync_point_khr* sync_point, cl_mutable_command_khr* mutable_handle)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+  amd::HostQueue* queue = recordQueue(*commandBuffer, command_queue);
+  if (queue == NULL) {
+    return CL_INVALID_COMMAND_QUEUE;
+  }
+  *not_null(mutable_handle) = NULL;
+
+  if (!is_valid(image)) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+
+  if (fill_color == NULL) {
+    return CL_INVALID_VALUE;
+  }
+
+  amd::Image* fillImage = as_amd(image)->asImage();
+  if (fillImage == NULL) {
+    return CL_INVALID_MEM_OBJECT;
+  }
+
+  if (queue->context() != fillImage->getContext()) {
+    return CL_INVALID_CONTEXT;
+  }
+
+  if (fillImage->getImageFormat().image_channel_order == CL_DEPTH_STENCIL) {
+    return CL_INVALID_OPERATION;
+  }
+
+  amd::Coord3D fillOrigin(origin[0], origin[1], origin[2]);
+  amd::Coord3D fillRegion(region[0], region[1], region[2]);
+  // surface takes [pitch, width, height]
+  amd::Coord3D surface(region[0], region[0], region[2]);
+
+  MipLevel fillLevel(fillImage, origin, fillOrigin);
+  if (fillLevel() == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+
+  if (!fillLevel()->validateRegion(fillOrigin, fillRegion)) {
+    return CL_INVALID_VALUE;
+  }
+
+  amd::CommandBuffer::Node* node = new amd::CommandBuffer::FillNode(
+      CL_COMMAND_FILL_IMAGE, *fillLevel(), fill_color,
+      sizeof(cl_float4),  // @note color size is always 16 bytes value
+      fillOrigin, fillRegion, surface);
+  if (node == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  return commandBuffer->record(node, num_sync_points_in_wait_list, sync_point_wait_list, false,
+                               sync_point);
+}
+RUNTIME_EXIT
+
+/*! \brief Records a kernel launch. The kernel arguments are captured at the record
+ *  time, later clSetKernelArg calls don't affect the recorded launch.
+ *
+ *  \param properties may have CL_MUTABLE_DISPATCH_UPDATABLE_FIELDS_KHR, which limits
+ *  the fields clUpdateMutableCommandsKHR can change. All supported fields are
+ *  updatable by default.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_COMMAND_QUEUE if \a command_queue isn't NULL or the queue of
+ *    \a command_buffer.
+ *  - CL_INVALID_KERNEL, CL_INVALID_CONTEXT, CL_INVALID_PROGRAM_EXECUTABLE,
+ *    CL_INVALID_WORK_DIMENSION, CL_INVALID_GLOBAL_WORK_SIZE,
+ *    CL_INVALID_WORK_GROUP_SIZE and CL_INVALID_KERNEL_ARGS under the same
+ *    conditions as clEnqueueNDRangeKernel.
+ *  - CL_INVALID_VALUE if \a properties isn't valid.
+ *  - CL_INVALID_OPERATION if \a command_buffer was finalized.
+ *  - CL_INVALID_SYNC_POINT_WAIT_LIST_KHR if the sync point wait list isn't valid.
+ */
+RUNTIME_ENTRY(cl_int, clCommandNDRangeKernelKHR,
+              (cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+               const cl_ndrange_kernel_command_properties_khr* properties, cl_kernel kernel,
+               cl_uint work_dim, const size_t* global_work_offset, const size_t* global_work_size,
+               const size_t* local_work_size, cl_uint num_sync_points_in_wait_list,
+               const cl_sync_point_khr* sync_point_wait_list, cl_sync_point_khr* sync_point,
+               cl_mutable_command_khr* mutable_handle)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+  amd::HostQueue* queue = recordQueue(*commandBuffer, command_queue);
+  if (queue == NULL) {
+    return CL_INVALID_COMMAND_QUEUE;
+  }
+  if (!is_valid(kernel)) {
+    return CL_INVALID_KERNEL;
+  }
+
+  cl_mutable_dispatch_fields_khr updatableFields = amd::CommandBuffer::MutableFields;
+  std::vector<cl_ndrange_kernel_command_properties_khr> propertiesArray;
+  if (properties != NULL) {
+    const cl_ndrange_kernel_command_properties_khr* p = properties;
+    while (*p != 0) {
+      if ((*p != CL_MUTABLE_DISPATCH_UPDATABLE_FIELDS_KHR) ||
+          ((p[1] & ~amd::CommandBuffer::MutableFields) != 0)) {
+        return CL_INVALID_VALUE;
+      }
+      updatableFields = p[1];
+      p += 2;
+    }
+    propertiesArray.assign(properties, p + 1);
+  }
+
+  const amd::Kernel* amdKernel = as_amd(kernel);
+  if (&queue->context() != &amdKernel->program().context()) {
+    return CL_INVALID_CONTEXT;
+  }
+
+  const amd::Device& device = queue->device();
+  const device::Kernel* devKernel = amdKernel->getDeviceKernel(device);
+  if (devKernel == NULL) {
+    return CL_INVALID_PROGRAM_EXECUTABLE;
+  }
+
+  if (amdKernel->parameters().getSvmSystemPointersSupport() == FGS_YES &&
+      !(device.info().svmCapabilities_ & CL_DEVICE_SVM_FINE_GRAIN_SYSTEM)) {
+    // The user indicated that this kernel will access SVM system pointers,
+    // but the device does not support them.
+    return CL_INVALID_OPERATION;
+  }
+
+  if (work_dim < 1 || work_dim > 3) {
+    return CL_INVALID_WORK_DIMENSION;
+  }
+  if (global_work_size == NULL) {
+    return CL_INVALID_VALUE;
+  }
+  cl_int err = validateWorkSizes(*devKernel, work_dim, global_work_size, local_work_size);
+  if (err != CL_SUCCESS) {
+    return err;
+  }
+  if (local_work_size == NULL) {
+    static size_t zeroes[3] = {0, 0, 0};
+    local_work_size = zeroes;
+  }
+
+  // Check that all parameters have been defined.
+  if (!amdKernel->parameters().check()) {
+    return CL_INVALID_KERNEL_ARGS;
+  }
+
+  // The copy holds the current arguments. The node owns it from now on
+  amd::Kernel* recordedKernel = new amd::Kernel(*amdKernel);
+  if (recordedKernel == NULL) {
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  amd::NDRangeContainer ndrange(static_cast<size_t>(work_dim), global_work_offset,
+                                global_work_size, local_work_size);
+  amd::CommandBuffer::KernelNode* node = new amd::CommandBuffer::KernelNode(
+      *commandBuffer, *as_amd(kernel), *recordedKernel, ndrange, propertiesArray,
+      updatableFields);
+  if (node == NULL) {
+    recordedKernel->release();
+    return CL_OUT_OF_HOST_MEMORY;
+  }
+  err = commandBuffer->record(node, num_sync_points_in_wait_list, sync_point_wait_list, false,
+                              sync_point);
+  if (err != CL_SUCCESS) {
+    return err;
+  }
+  *not_null(mutable_handle) = reinterpret_cast<cl_mutable_command_khr>(
+      static_cast<amd::CommandBuffer::Node*>(node));
+  return CL_SUCCESS;
+}
+RUNTIME_EXIT
+
+/*! \brief Returns information about the command buffer.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_VALUE if \a param_name isn't supported or \a param_value_size
+ *    is too small.
+ */
+RUNTIME_ENTRY(cl_int, clGetCommandBufferInfoKHR,
+              (cl_command_buffer_khr command_buffer, cl_command_buffer_info_khr param_name,
+               size_t param_value_size, void* param_value, size_t* param_value_size_ret)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+
+  switch (param_name) {
+    case CL_COMMAND_BUFFER_QUEUES_KHR: {
+      cl_command_queue queue = as_cl(static_cast<amd::CommandQueue*>(&commandBuffer->queue()));
+      return amd::clGetInfo(queue, param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_COMMAND_BUFFER_NUM_QUEUES_KHR: {
+      cl_uint numQueues = 1;
+      return amd::clGetInfo(numQueues, param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_COMMAND_BUFFER_REFERENCE_COUNT_KHR: {
+      cl_uint count = commandBuffer->referenceCount();
+      return amd::clGetInfo(count, param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_COMMAND_BUFFER_STATE_KHR: {
+      cl_command_buffer_state_khr state = commandBuffer->state();
+      return amd::clGetInfo(state, param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_COMMAND_BUFFER_PROPERTIES_ARRAY_KHR: {
+      const auto& properties = commandBuffer->properties();
+      return getArrayInfo(properties.data(),
+                          properties.size() * sizeof(cl_command_buffer_properties_khr),
+                          param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_COMMAND_BUFFER_CONTEXT_KHR: {
+      cl_context context = const_cast<cl_context>(as_cl(&commandBuffer->queue().context()));
+      return amd::clGetInfo(context, param_value_size, param_value, param_value_size_ret);
+    }
+    default:
+      break;
+  }
+
+  return CL_INVALID_VALUE;
+}
+RUNTIME_EXIT
+
+/*! \brief Changes the arguments and the sizes of the recorded kernel launches. The
+ *  updates apply to the later replays, the enqueued replays keep their values. On an
+ *  error none of the updates applies.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_COMMAND_BUFFER_KHR if \a command_buffer isn't valid.
+ *  - CL_INVALID_OPERATION if \a command_buffer isn't finalized or wasn't created
+ *    with CL_COMMAND_BUFFER_MUTABLE_KHR, or a field isn't updatable.
+ *  - CL_INVALID_VALUE if \a mutable_config isn't valid.
+ *  - CL_INVALID_MUTABLE_COMMAND_KHR if a command isn't a kernel launch of
+ *    \a command_buffer.
+ *  - The errors of clSetKernelArg and clSetKernelArgSVMPointer for the arguments and
+ *    of clEnqueueNDRangeKernel for the sizes.
+ */
+RUNTIME_ENTRY(cl_int, clUpdateMutableCommandsKHR,
+              (cl_command_buffer_khr command_buffer,
+               const cl_mutable_base_config_khr* mutable_config)) {
+  if (!is_valid(command_buffer)) {
+    return CL_INVALID_COMMAND_BUFFER_KHR;
+  }
+  amd::CommandBuffer* commandBuffer = as_amd(command_buffer);
+  if (((commandBuffer->flags() & CL_COMMAND_BUFFER_MUTABLE_KHR) == 0) ||
+      (commandBuffer->state() == CL_COMMAND_BUFFER_STATE_RECORDING_KHR)) {
+    return CL_INVALID_OPERATION;
+  }
+  if ((mutable_config == NULL) ||
+      (mutable_config->type != CL_STRUCTURE_TYPE_MUTABLE_BASE_CONFIG_KHR) ||
+      (mutable_config->next != NULL) ||
+      ((mutable_config->num_mutable_dispatch == 0) !=
+       (mutable_config->mutable_dispatch_list == NULL))) {
+    return CL_INVALID_VALUE;
+  }
+
+  amd::ScopedLock sl(commandBuffer->lock());
+
+  // The update of a launch, several configs of the same launch accumulate
+  struct Update {
+    amd::CommandBuffer::KernelNode* node_;  //!< The updated launch
+    amd::Kernel* kernel_;                   //!< A kernel copy with the new arguments or NULL
+    size_t offset_[3];                      //!< The new global offset
+    size_t global_[3];                      //!< The new global size
+    size_t local_[3];                       //!< The new local size
+  };
+
+  // Check the whole update and stage it first, so an invalid config doesn't leave
+  // a partial update. The new arguments go to kernel copies, which replace the node kernels
+  std::vector<Update> updates;
+  cl_int err = CL_SUCCESS;
+  for (cl_uint i = 0; (i < mutable_config->num_mutable_dispatch) && (err == CL_SUCCESS); ++i) {
+    const cl_mutable_dispatch_config_khr& config = mutable_config->mutable_dispatch_list[i];
+    amd::CommandBuffer::KernelNode* node = commandBuffer->mutableNode(config.command);
+    if (node == NULL) {
+      err = CL_INVALID_MUTABLE_COMMAND_KHR;
+      break;
+    }
+    const amd::NDRangeContainer& sizes = node->sizes();
+    const size_t workDim = sizes.dimensions();
+    err = amd::ValidateMutableDispatch(config, node->updatableFields(), workDim);
+    if (err != CL_SUCCESS) {
+      break;
+    }
+
+    Update* update = NULL;
+    for (auto& it : updates) {
+      if (it.node_ == node) {
+        update = &it;
+        break;
+      }
+    }
+    if (update == NULL) {
+      updates.push_back({node, NULL});
+      update = &updates.back();
+      for (size_t dim = 0; dim < workDim; ++dim) {
+        update->offset_[dim] = sizes.offset()[dim];
+        update->global_[dim] = sizes.global()[dim];
+        update->local_[dim] = sizes.local()[dim];
+      }
+    }
+
+    if ((config.global_work_size != NULL) || (config.local_work_size != NULL)) {
+      size_t global[3];
+      size_t local[3];
+      bool localSet = true;
+      for (size_t dim = 0; dim < workDim; ++dim) {
+        global[dim] = (config.global_work_size != NULL) ? config.global_work_size[dim]
+                                                        : update->global_[dim];
+        local[dim] = (config.local_work_size != NULL) ? config.local_work_size[dim]
+                                                      : update->local_[dim];
+        localSet &= (local[dim] != 0);
+      }
+      const device::Kernel* devKernel =
+          node->kernel().getDeviceKernel(commandBuffer->queue().device());
+      err = validateWorkSizes(*devKernel, static_cast<cl_uint>(workDim), global,
+                              localSet ? local : NULL);
+      if (err != CL_SUCCESS) {
+        break;
+      }
+    }
+    for (size_t dim = 0; dim < workDim; ++dim) {
+      if (config.global_work_offset != NULL) {
+        update->offset_[dim] = config.global_work_offset[dim];
+      }
+      if (config.global_work_size != NULL) {
+        update->global_[dim] = config.global_work_size[dim];
+      }
+      if (config.local_work_size != NULL) {
+        update->local_[dim] = config.local_work_size[dim];
+      }
+    }
+
+    if ((config.num_args == 0) && (config.num_svm_args == 0)) {
+      continue;
+    }
+    if (update->kernel_ == NULL) {
+      update->kernel_ = new amd::Kernel(node->kernel());
+      if (update->kernel_ == NULL) {
+        err = CL_OUT_OF_HOST_MEMORY;
+        break;
+      }
+    }
+    cl_kernel kernel = as_cl(update->kernel_);
+    for (cl_uint j = 0; (j < config.num_args) && (err == CL_SUCCESS); ++j) {
+      const cl_mutable_dispatch_arg_khr& arg = config.arg_list[j];
+      err = commandBuffer->dispatch_->clSetKernelArg(kernel, arg.arg_index, arg.arg_size,
+                                                     arg.arg_value);
+    }
+    for (cl_uint j = 0; (j < config.num_svm_args) && (err == CL_SUCCESS); ++j) {
+      const cl_mutable_dispatch_arg_khr& arg = config.arg_svm_list[j];
+      err = commandBuffer->dispatch_->clSetKernelArgSVMPointer(kernel, arg.arg_index,
+                                                               arg.arg_value);
+    }
+  }
+
+  if (err != CL_SUCCESS) {
+    for (const auto& update : updates) {
+      if (update.kernel_ != NULL) {
+        update.kernel_->release();
+      }
+    }
+    return err;
+  }
+
+  for (const auto& update : updates) {
+    if (update.kernel_ != NULL) {
+      update.node_->setKernel(*update.kernel_);
+    }
+    update.node_->sizes().update(update.node_->sizes().dimensions(), update.offset_,
+                                 update.global_, update.local_);
+  }
+  return CL_SUCCESS;
+}
+RUNTIME_EXIT
+
+/*! \brief Returns information about a recorded kernel launch. The sizes include
+ *  the updates of clUpdateMutableCommandsKHR.
+ *
+ *  \return One of the following values:
+ *  - CL_SUCCESS if the function is executed successfully.
+ *  - CL_INVALID_MUTABLE_COMMAND_KHR if \a command is NULL.
+ *  - CL_INVALID_VALUE if \a param_name isn't supported or \a param_value_size
+ *    is too small.
+ */
+RUNTIME_ENTRY(cl_int, clGetMutableCommandInfoKHR,
+              (cl_mutable_command_khr command, cl_mutable_command_info_khr param_name,
+               size_t param_value_size, void* param_value, size_t* param_value_size_ret)) {
+  if (command == NULL) {
+    return CL_INVALID_MUTABLE_COMMAND_KHR;
+  }
+  // Only the kernel launches return a mutable handle
+  amd::CommandBuffer::KernelNode* node = static_cast<amd::CommandBuffer::KernelNode*>(
+      reinterpret_cast<amd::CommandBuffer::Node*>(command));
+  amd::CommandBuffer& commandBuffer = node->commandBuffer();
+
+  switch (param_name) {
+    case CL_MUTABLE_COMMAND_COMMAND_QUEUE_KHR: {
+      cl_command_queue queue = as_cl(static_cast<amd::CommandQueue*>(&commandBuffer.queue()));
+      return amd::clGetInfo(queue, param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_MUTABLE_COMMAND_COMMAND_BUFFER_KHR: {
+      cl_command_buffer_khr buffer = as_cl(&commandBuffer);
+      return amd::clGetInfo(buffer, param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_MUTABLE_COMMAND_COMMAND_TYPE_KHR: {
+      cl_command_type type = CL_COMMAND_NDRANGE_KERNEL;
+      return amd::clGetInfo(type, param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_MUTABLE_DISPATCH_PROPERTIES_ARRAY_KHR: {
+      const auto& properties = node->properties();
+      return getArrayInfo(properties.data(),
+                          properties.size() * sizeof(cl_ndrange_kernel_command_properties_khr),
+                          param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_MUTABLE_DISPATCH_KERNEL_KHR: {
+      cl_kernel kernel = as_cl(&node->recorded());
+      return amd::clGetInfo(kernel, param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_MUTABLE_DISPATCH_DIMENSIONS_KHR:
+    case CL_MUTABLE_DISPATCH_GLOBAL_WORK_OFFSET_KHR:
+    case CL_MUTABLE_DISPATCH_GLOBAL_WORK_SIZE_KHR:
+    case CL_MUTABLE_DISPATCH_LOCAL_WORK_SIZE_KHR: {
+      // The updates change the sizes under the lock
+      amd::ScopedLock sl(commandBuffer.lock());
+      const amd::NDRangeContainer& sizes = node->sizes();
+      const size_t workDim = sizes.dimensions();
+      if (param_name == CL_MUTABLE_DISPATCH_DIMENSIONS_KHR) {
+        cl_uint dimensions = static_cast<cl_uint>(workDim);
+        return amd::clGetInfo(dimensions, param_value_size, param_value, param_value_size_ret);
+      }
+      const amd::NDRange& range = (param_name == CL_MUTABLE_DISPATCH_GLOBAL_WORK_OFFSET_KHR)
+          ? sizes.offset()
+          : (param_name == CL_MUTABLE_DISPATCH_GLOBAL_WORK_SIZE_KHR) ? sizes.global()
+                                                                     : sizes.local();
+      size_t values[3];
+      for (size_t dim = 0; dim < workDim; ++dim) {
+        values[dim] = range[dim];
+      }
+      return getArrayInfo(values, workDim * sizeof(size_t), param_value_size, param_value,
+                          param_value_size_ret);
+    }
+    default:
+      break;
+  }
+
+  return CL_INVALID_VALUE;
+}
+RUNTIME_EXIT
+
+/*! @}
+ *  @}
+ */
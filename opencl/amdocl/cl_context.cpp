@@ -35,6 +35,7 @@
 #include "cl_sdi_amd.h"
 #include "cl_thread_trace_amd.h"
 #include "cl_p2p_amd.h"
+#include "cl_command_buffer_khr.h"
 
 #include <GL/gl.h>
 #include <GL/glext.h>
@@ -468,6 +469,16 @@ CL_API_ENTRY void* CL_API_CALL clGetExtensionFunctionAddress(const char* func_na
   switch (func_name[2]) {
     case 'C':
       CL_EXTENSION_ENTRYPOINT_CHECK(clCreateEventFromGLsyncKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clCreateCommandBufferKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clCommandBarrierWithWaitListKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clCommandCopyBufferKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clCommandCopyBufferRectKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clCommandCopyBufferToImageKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clCommandCopyImageKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clCommandCopyImageToBufferKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clCommandFillBufferKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clCommandFillImageKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clCommandNDRangeKernelKHR);
       CL_EXTENSION_ENTRYPOINT_CHECK(clCreatePerfCounterAMD);
       CL_EXTENSION_ENTRYPOINT_CHECK(clCreateThreadTraceAMD);
       CL_EXTENSION_ENTRYPOINT_CHECK(clCreateFromGLBuffer);
@@ -493,6 +504,7 @@ CL_API_ENTRY void* CL_API_CALL clGetExtensionFunctionAddress(const char* func_na
       break;
     case 'E':
       CL_EXTENSION_ENTRYPOINT_CHECK(clEnqueueBeginPerfCounterAMD);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clEnqueueCommandBufferKHR);
       CL_EXTENSION_ENTRYPOINT_CHECK(clEnqueueEndPerfCounterAMD);
       CL_EXTENSION_ENTRYPOINT_CHECK(clEnqueueAcquireGLObjects);
       CL_EXTENSION_ENTRYPOINT_CHECK(clEnqueueReleaseGLObjects);
@@ -511,8 +523,13 @@ CL_API_ENTRY void* CL_API_CALL clGetExtensionFunctionAddress(const char* func_na
       CL_EXTENSION_ENTRYPOINT_CHECK(clEnqueueCopyBufferP2PAMD);
 #endif  // cl_amd_copy_buffer_p2p
       break;
+    case 'F':
+      CL_EXTENSION_ENTRYPOINT_CHECK(clFinalizeCommandBufferKHR);
+      break;
     case 'G':
       CL_EXTENSION_ENTRYPOINT_CHECK(clGetKernelInfoAMD);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clGetCommandBufferInfoKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clGetMutableCommandInfoKHR);
       CL_EXTENSION_ENTRYPOINT_CHECK(clGetPerfCounterInfoAMD);
       CL_EXTENSION_ENTRYPOINT_CHECK(clGetGLObjectInfo);
       CL_EXTENSION_ENTRYPOINT_CHECK(clGetGLTextureInfo);
@@ -535,6 +552,8 @@ CL_API_ENTRY void* CL_API_CALL clGetExtensionFunctionAddress(const char* func_na
       CL_EXTENSION_ENTRYPOINT_CHECK(clRetainPerfCounterAMD);
       CL_EXTENSION_ENTRYPOINT_CHECK(clReleaseThreadTraceAMD);
       CL_EXTENSION_ENTRYPOINT_CHECK(clRetainThreadTraceAMD);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clReleaseCommandBufferKHR);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clRetainCommandBufferKHR);
       break;
     case 'S':
       CL_EXTENSION_ENTRYPOINT_CHECK(clSetThreadTraceParamAMD);
@@ -542,6 +561,7 @@ CL_API_ENTRY void* CL_API_CALL clGetExtensionFunctionAddress(const char* func_na
       break;
     case 'U':
       CL_EXTENSION_ENTRYPOINT_CHECK(clUnloadPlatformAMD);
+      CL_EXTENSION_ENTRYPOINT_CHECK(clUpdateMutableCommandsKHR);
     default:
       break;
   }
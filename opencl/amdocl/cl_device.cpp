@@ -22,6 +22,7 @@
 #include "vdi_common.hpp"
 #include "device/device.hpp"
 #include "platform/runtime.hpp"
+#include "platform/commandbuffer.hpp"
 #include "utils/versions.hpp"
 #include "os/os.hpp"
 #include "cl_semaphore_amd.h"
@@ -377,6 +378,18 @@ RUNTIME_ENTRY(cl_int, clGetDeviceInfo,
       CASE(CL_DEVICE_PRINTF_BUFFER_SIZE, printfBufferSize_);
       CASE(CL_DEVICE_IMAGE_PITCH_ALIGNMENT, imagePitchAlignment_);
       CASE(CL_DEVICE_IMAGE_BASE_ADDRESS_ALIGNMENT, imageBaseAddressAlignment_);
+    case CL_DEVICE_COMMAND_BUFFER_CAPABILITIES_KHR: {
+      cl_device_command_buffer_capabilities_khr capabilities = amd::CommandBuffer::Capabilities;
+      return amd::clGetInfo(capabilities, param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_DEVICE_COMMAND_BUFFER_REQUIRED_QUEUE_PROPERTIES_KHR: {
+      cl_command_queue_properties properties = 0;
+      return amd::clGetInfo(properties, param_value_size, param_value, param_value_size_ret);
+    }
+    case CL_DEVICE_MUTABLE_DISPATCH_CAPABILITIES_KHR: {
+      cl_mutable_dispatch_fields_khr fields = amd::CommandBuffer::MutableFields;
+      return amd::clGetInfo(fields, param_value_size, param_value, param_value_size_ret);
+    }
 
     default:
       break;
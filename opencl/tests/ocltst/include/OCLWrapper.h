@@ -437,6 +437,10 @@ class OCLWrapper {
                                           void *user_data),
       void *user_data);
 
+  cl_event clCreateUserEvent(cl_context context, cl_int *errcode_ret);
+
+  cl_int clSetUserEventStatus(cl_event event, cl_int execution_status);
+
   cl_int clEnqueueFillImage(cl_command_queue command_queue, cl_mem image,
                             void *ptr, const size_t *origin,
                             const size_t *region,
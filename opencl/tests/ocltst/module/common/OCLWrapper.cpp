@@ -698,6 +698,16 @@ cl_int OCLWrapper::clSetEventCallback(
                               pfn_event_notify, user_data);
 }
 
+cl_event OCLWrapper::clCreateUserEvent(cl_context context,
+                                       cl_int *errcode_ret) {
+  return ::clCreateUserEvent(context, errcode_ret);
+}
+
+cl_int OCLWrapper::clSetUserEventStatus(cl_event event,
+                                        cl_int execution_status) {
+  return ::clSetUserEventStatus(event, execution_status);
+}
+
 cl_int OCLWrapper::clEnqueueFillImage(
     cl_command_queue command_queue, cl_mem image, void *ptr,
     const size_t *origin, const size_t *region, cl_uint num_events_in_wait_list,
@@ -0,0 +1,212 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "OCLPerfCommandBuffer.h"
+
+#include <Timer.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "CL/cl.h"
+#include "CL/cl_ext.h"
+
+// The replay creates and captures the arguments of every kernel again, the test compares
+// its cost per kernel with the enqueue of the same kernels one by one
+static const size_t NumKernels[] = {1, 16, 256};
+static const size_t NumKernelCnts = sizeof(NumKernels) / sizeof(NumKernels[0]);
+static const size_t Dispatches = 0x10000;
+
+typedef cl_command_buffer_khr(CL_API_CALL* CreateCommandBuffer)(
+    cl_uint num_queues, const cl_command_queue* queues,
+    const cl_command_buffer_properties_khr* properties, cl_int* errcode_ret);
+typedef cl_int(CL_API_CALL* FinalizeCommandBuffer)(
+    cl_command_buffer_khr command_buffer);
+typedef cl_int(CL_API_CALL* ReleaseCommandBuffer)(
+    cl_command_buffer_khr command_buffer);
+typedef cl_int(CL_API_CALL* EnqueueCommandBuffer)(
+    cl_uint num_queues, cl_command_queue* queues,
+    cl_command_buffer_khr command_buffer, cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list, cl_event* event);
+typedef cl_int(CL_API_CALL* CommandNDRangeKernel)(
+    cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+    const cl_ndrange_kernel_command_properties_khr* properties,
+    cl_kernel kernel, cl_uint work_dim, const size_t* global_work_offset,
+    const size_t* global_work_size, const size_t* local_work_size,
+    cl_uint num_sync_points_in_wait_list,
+    const cl_sync_point_khr* sync_point_wait_list,
+    cl_sync_point_khr* sync_point, cl_mutable_command_khr* mutable_handle);
+
+static CreateCommandBuffer createCommandBuffer = NULL;
+static FinalizeCommandBuffer finalizeCommandBuffer = NULL;
+static ReleaseCommandBuffer releaseCommandBuffer = NULL;
+static EnqueueCommandBuffer enqueueCommandBuffer = NULL;
+static CommandNDRangeKernel commandNDRangeKernel = NULL;
+
+static const char* strKernel =
+    "__kernel void dummy(__global uint* out, uint value) \n"
+    "{                                                   \n"
+    "   uint id = get_global_id(0);                      \n"
+    "   out[id] = value;                                 \n"
+    "}                                                   \n";
+
+OCLPerfCommandBuffer::OCLPerfCommandBuffer() {
+  _numSubTests = NumKernelCnts * 2;
+  skip_ = false;
+  commandBuffer_ = NULL;
+}
+
+OCLPerfCommandBuffer::~OCLPerfCommandBuffer() {}
+
+void OCLPerfCommandBuffer::open(unsigned int test, char* units,
+                                double& conversion, unsigned int deviceId) {
+  _deviceId = deviceId;
+  OCLTestImp::open(test, units, conversion, deviceId);
+  CHECK_RESULT((error_ != CL_SUCCESS), "Error opening test");
+  numKernels_ = NumKernels[test % NumKernelCnts];
+  replay_ = (test >= NumKernelCnts);
+  commandBuffer_ = NULL;
+
+  size_t size = 0;
+  error_ = _wrapper->clGetDeviceInfo(devices_[deviceId], CL_DEVICE_EXTENSIONS,
+                                     0, NULL, &size);
+  CHECK_RESULT(error_ != CL_SUCCESS, "clGetDeviceInfo failed");
+  std::vector<char> extensions(size + 1, 0);
+  error_ = _wrapper->clGetDeviceInfo(devices_[deviceId], CL_DEVICE_EXTENSIONS,
+                                     size, extensions.data(), NULL);
+  CHECK_RESULT(error_ != CL_SUCCESS, "clGetDeviceInfo failed");
+  if (strstr(extensions.data(), "cl_khr_command_buffer") == NULL) {
+    skip_ = true;
+    testDescString = "cl_khr_command_buffer not supported. Test Skipped.";
+    return;
+  }
+
+  createCommandBuffer =
+      (CreateCommandBuffer)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clCreateCommandBufferKHR");
+  finalizeCommandBuffer =
+      (FinalizeCommandBuffer)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clFinalizeCommandBufferKHR");
+  releaseCommandBuffer =
+      (ReleaseCommandBuffer)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clReleaseCommandBufferKHR");
+  enqueueCommandBuffer =
+      (EnqueueCommandBuffer)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clEnqueueCommandBufferKHR");
+  commandNDRangeKernel =
+      (CommandNDRangeKernel)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clCommandNDRangeKernelKHR");
+  CHECK_RESULT((createCommandBuffer == NULL) ||
+                   (finalizeCommandBuffer == NULL) ||
+                   (releaseCommandBuffer == NULL) ||
+                   (enqueueCommandBuffer == NULL) ||
+                   (commandNDRangeKernel == NULL),
+               "cl_khr_command_buffer entry points not found");
+
+  program_ = _wrapper->clCreateProgramWithSource(context_, 1, &strKernel, NULL,
+                                                 &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateProgramWithSource() failed");
+  error_ = _wrapper->clBuildProgram(program_, 1, &devices_[deviceId], NULL,
+                                    NULL, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clBuildProgram() failed");
+  kernel_ = _wrapper->clCreateKernel(program_, "dummy", &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateKernel() failed");
+
+  cl_mem buffer = _wrapper->clCreateBuffer(
+      context_, CL_MEM_READ_WRITE, 256 * sizeof(cl_uint), NULL, &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateBuffer() failed");
+  buffers_.push_back(buffer);
+  error_ = _wrapper->clSetKernelArg(kernel_, 0, sizeof(cl_mem), &buffer);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clSetKernelArg() failed");
+
+  if (replay_) {
+    commandBuffer_ =
+        createCommandBuffer(1, &cmdQueues_[deviceId], NULL, &error_);
+    CHECK_RESULT((error_ != CL_SUCCESS), "clCreateCommandBufferKHR() failed");
+    size_t gws[1] = {256};
+    size_t lws[1] = {256};
+    for (cl_uint k = 0; k < numKernels_; ++k) {
+      error_ = _wrapper->clSetKernelArg(kernel_, 1, sizeof(cl_uint), &k);
+      CHECK_RESULT((error_ != CL_SUCCESS), "clSetKernelArg() failed");
+      error_ = commandNDRangeKernel(commandBuffer_, NULL, NULL, kernel_, 1,
+                                    NULL, gws, lws, 0, NULL, NULL, NULL);
+      CHECK_RESULT((error_ != CL_SUCCESS), "clCommandNDRangeKernelKHR() failed");
+    }
+    error_ = finalizeCommandBuffer(commandBuffer_);
+    CHECK_RESULT((error_ != CL_SUCCESS), "clFinalizeCommandBufferKHR() failed");
+  }
+}
+
+void OCLPerfCommandBuffer::run(void) {
+  if (skip_ || _errorFlag) {
+    return;
+  }
+  CPerfCounter timer;
+  cl_command_queue queue = cmdQueues_[_deviceId];
+  size_t iter = Dispatches / numKernels_;
+  size_t gws[1] = {256};
+  size_t lws[1] = {256};
+
+  // Enqueues the kernels once, either one by one or with a single replay
+  for (size_t i = 0; i <= iter; ++i) {
+    if (i == 1) {
+      // The first pass warms up
+      _wrapper->clFinish(queue);
+      timer.Reset();
+      timer.Start();
+    }
+    if (replay_) {
+      error_ = enqueueCommandBuffer(0, NULL, commandBuffer_, 0, NULL, NULL);
+      CHECK_RESULT((error_ != CL_SUCCESS), "clEnqueueCommandBufferKHR() failed");
+    } else {
+      for (cl_uint k = 0; k < numKernels_; ++k) {
+        error_ = _wrapper->clSetKernelArg(kernel_, 1, sizeof(cl_uint), &k);
+        CHECK_RESULT((error_ != CL_SUCCESS), "clSetKernelArg() failed");
+        error_ = _wrapper->clEnqueueNDRangeKernel(queue, kernel_, 1, NULL, gws,
+                                                  lws, 0, NULL, NULL);
+        CHECK_RESULT((error_ != CL_SUCCESS), "clEnqueueNDRangeKernel() failed");
+      }
+    }
+  }
+  _wrapper->clFinish(queue);
+  timer.Stop();
+
+  std::stringstream stream;
+  stream << "Time per kernel (us), " << (replay_ ? "replay " : "enqueue");
+  stream << " of ";
+  stream.width(3);
+  stream << numKernels_ << " kernels";
+  testDescString = stream.str();
+  _perfInfo = static_cast<float>(timer.GetElapsedTime() * 1000000 /
+                                 (iter * numKernels_));
+}
+
+unsigned int OCLPerfCommandBuffer::close(void) {
+  if (commandBuffer_ != NULL) {
+    error_ = releaseCommandBuffer(commandBuffer_);
+    CHECK_RESULT_NO_RETURN((error_ != CL_SUCCESS),
+                           "clReleaseCommandBufferKHR() failed");
+    commandBuffer_ = NULL;
+  }
+  return OCLTestImp::close();
+}
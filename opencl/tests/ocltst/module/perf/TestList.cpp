@@ -30,6 +30,7 @@
 #include "OCLPerfBufferReadSpeed.h"
 #include "OCLPerfBufferWriteSpeed.h"
 #include "OCLPerfCPUMemSpeed.h"
+#include "OCLPerfCommandBuffer.h"
 #include "OCLPerfCommandQueue.h"
 #include "OCLPerfConcurrency.h"
 #include "OCLPerfDevMemReadSpeed.h"
@@ -182,6 +183,7 @@ TestEntry TestList[] = {
     TEST(OCLPerfDevMemReadSpeed),
     TEST(OCLPerfDevMemWriteSpeed),
     TEST(OCLPerfVerticalFetch),
+    TEST(OCLPerfCommandBuffer),
 };
 
 unsigned int TestListCount = sizeof(TestList) / sizeof(TestList[0]);
@@ -0,0 +1,539 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "OCLCommandBuffer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include "CL/cl.h"
+#include "CL/cl_ext.h"
+
+// Records the copy and fill commands, replays them and checks the results
+enum SubTest { CopyBufferRect = 0, CopyImages, FillImage, MutableInfo, NumSubTests };
+
+static const char* SubTestNames[NumSubTests] = {"rect copy", "image copies",
+                                                "image fill", "mutable info"};
+
+// The width and the height of the images in pixels
+static const size_t ImageSize = 16;
+
+typedef cl_command_buffer_khr(CL_API_CALL* CreateCommandBuffer)(
+    cl_uint num_queues, const cl_command_queue* queues,
+    const cl_command_buffer_properties_khr* properties, cl_int* errcode_ret);
+typedef cl_int(CL_API_CALL* FinalizeCommandBuffer)(
+    cl_command_buffer_khr command_buffer);
+typedef cl_int(CL_API_CALL* ReleaseCommandBuffer)(
+    cl_command_buffer_khr command_buffer);
+typedef cl_int(CL_API_CALL* EnqueueCommandBuffer)(
+    cl_uint num_queues, cl_command_queue* queues,
+    cl_command_buffer_khr command_buffer, cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list, cl_event* event);
+typedef cl_int(CL_API_CALL* CommandCopyBufferRect)(
+    cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+    cl_mem src_buffer, cl_mem dst_buffer, const size_t* src_origin,
+    const size_t* dst_origin, const size_t* region, size_t src_row_pitch,
+    size_t src_slice_pitch, size_t dst_row_pitch, size_t dst_slice_pitch,
+    cl_uint num_sync_points_in_wait_list,
+    const cl_sync_point_khr* sync_point_wait_list,
+    cl_sync_point_khr* sync_point, cl_mutable_command_khr* mutable_handle);
+typedef cl_int(CL_API_CALL* CommandCopyBufferToImage)(
+    cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+    cl_mem src_buffer, cl_mem dst_image, size_t src_offset,
+    const size_t* dst_origin, const size_t* region,
+    cl_uint num_sync_points_in_wait_list,
+    const cl_sync_point_khr* sync_point_wait_list,
+    cl_sync_point_khr* sync_point, cl_mutable_command_khr* mutable_handle);
+typedef cl_int(CL_API_CALL* CommandCopyImage)(
+    cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+    cl_mem src_image, cl_mem dst_image, const size_t* src_origin,
+    const size_t* dst_origin, const size_t* region,
+    cl_uint num_sync_points_in_wait_list,
+    const cl_sync_point_khr* sync_point_wait_list,
+    cl_sync_point_khr* sync_point, cl_mutable_command_khr* mutable_handle);
+typedef cl_int(CL_API_CALL* CommandCopyImageToBuffer)(
+    cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+    cl_mem src_image, cl_mem dst_buffer, const size_t* src_origin,
+    const size_t* region, size_t dst_offset,
+    cl_uint num_sync_points_in_wait_list,
+    const cl_sync_point_khr* sync_point_wait_list,
+    cl_sync_point_khr* sync_point, cl_mutable_command_khr* mutable_handle);
+typedef cl_int(CL_API_CALL* CommandFillImage)(
+    cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+    cl_mem image, const void* fill_color, const size_t* origin,
+    const size_t* region, cl_uint num_sync_points_in_wait_list,
+    const cl_sync_point_khr* sync_point_wait_list,
+    cl_sync_point_khr* sync_point, cl_mutable_command_khr* mutable_handle);
+typedef cl_int(CL_API_CALL* CommandNDRangeKernel)(
+    cl_command_buffer_khr command_buffer, cl_command_queue command_queue,
+    const cl_ndrange_kernel_command_properties_khr* properties,
+    cl_kernel kernel, cl_uint work_dim, const size_t* global_work_offset,
+    const size_t* global_work_size, const size_t* local_work_size,
+    cl_uint num_sync_points_in_wait_list,
+    const cl_sync_point_khr* sync_point_wait_list,
+    cl_sync_point_khr* sync_point, cl_mutable_command_khr* mutable_handle);
+typedef cl_int(CL_API_CALL* UpdateMutableCommands)(
+    cl_command_buffer_khr command_buffer,
+    const cl_mutable_base_config_khr* mutable_config);
+typedef cl_int(CL_API_CALL* GetMutableCommandInfo)(
+    cl_mutable_command_khr command, cl_mutable_command_info_khr param_name,
+    size_t param_value_size, void* param_value, size_t* param_value_size_ret);
+
+static CreateCommandBuffer createCommandBuffer = NULL;
+static FinalizeCommandBuffer finalizeCommandBuffer = NULL;
+static ReleaseCommandBuffer releaseCommandBuffer = NULL;
+static EnqueueCommandBuffer enqueueCommandBuffer = NULL;
+static CommandCopyBufferRect commandCopyBufferRect = NULL;
+static CommandCopyBufferToImage commandCopyBufferToImage = NULL;
+static CommandCopyImage commandCopyImage = NULL;
+static CommandCopyImageToBuffer commandCopyImageToBuffer = NULL;
+static CommandFillImage commandFillImage = NULL;
+static CommandNDRangeKernel commandNDRangeKernel = NULL;
+static UpdateMutableCommands updateMutableCommands = NULL;
+static GetMutableCommandInfo getMutableCommandInfo = NULL;
+
+static const char* strKernel =
+    "__kernel void fill(__global uint* out, uint value) \n"
+    "{                                                  \n"
+    "   uint id = get_global_id(0);                     \n"
+    "   out[id] = value;                                \n"
+    "}                                                  \n";
+
+OCLCommandBuffer::OCLCommandBuffer() {
+  _numSubTests = NumSubTests;
+  skip_ = false;
+  commandBuffer_ = NULL;
+}
+
+OCLCommandBuffer::~OCLCommandBuffer() {}
+
+void OCLCommandBuffer::open(unsigned int test, char* units, double& conversion,
+                            unsigned int deviceId) {
+  _deviceId = deviceId;
+  OCLTestImp::open(test, units, conversion, deviceId);
+  CHECK_RESULT((error_ != CL_SUCCESS), "Error opening test");
+  test_ = test;
+  skip_ = false;
+  commandBuffer_ = NULL;
+  testDescString = SubTestNames[test_];
+
+  size_t size = 0;
+  error_ = _wrapper->clGetDeviceInfo(devices_[deviceId], CL_DEVICE_EXTENSIONS,
+                                     0, NULL, &size);
+  CHECK_RESULT(error_ != CL_SUCCESS, "clGetDeviceInfo failed");
+  std::vector<char> extensions(size + 1, 0);
+  error_ = _wrapper->clGetDeviceInfo(devices_[deviceId], CL_DEVICE_EXTENSIONS,
+                                     size, extensions.data(), NULL);
+  CHECK_RESULT(error_ != CL_SUCCESS, "clGetDeviceInfo failed");
+  if (strstr(extensions.data(), "cl_khr_command_buffer") == NULL) {
+    skip_ = true;
+    testDescString = "cl_khr_command_buffer not supported. Test Skipped.";
+    return;
+  }
+  if ((test_ == MutableInfo) &&
+      (strstr(extensions.data(), "cl_khr_command_buffer_mutable_dispatch") ==
+       NULL)) {
+    skip_ = true;
+    testDescString =
+        "cl_khr_command_buffer_mutable_dispatch not supported. Test Skipped.";
+    return;
+  }
+  if ((test_ == CopyImages) || (test_ == FillImage)) {
+    cl_bool imageSupport = CL_FALSE;
+    error_ = _wrapper->clGetDeviceInfo(devices_[deviceId],
+                                       CL_DEVICE_IMAGE_SUPPORT,
+                                       sizeof(imageSupport), &imageSupport, NULL);
+    CHECK_RESULT(error_ != CL_SUCCESS, "clGetDeviceInfo failed");
+    if (!imageSupport) {
+      skip_ = true;
+      testDescString = "Images not supported. Test Skipped.";
+      return;
+    }
+  }
+
+  createCommandBuffer =
+      (CreateCommandBuffer)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clCreateCommandBufferKHR");
+  finalizeCommandBuffer =
+      (FinalizeCommandBuffer)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clFinalizeCommandBufferKHR");
+  releaseCommandBuffer =
+      (ReleaseCommandBuffer)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clReleaseCommandBufferKHR");
+  enqueueCommandBuffer =
+      (EnqueueCommandBuffer)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clEnqueueCommandBufferKHR");
+  commandCopyBufferRect =
+      (CommandCopyBufferRect)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clCommandCopyBufferRectKHR");
+  commandCopyBufferToImage =
+      (CommandCopyBufferToImage)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clCommandCopyBufferToImageKHR");
+  commandCopyImage = (CommandCopyImage)clGetExtensionFunctionAddressForPlatform(
+      platform_, "clCommandCopyImageKHR");
+  commandCopyImageToBuffer =
+      (CommandCopyImageToBuffer)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clCommandCopyImageToBufferKHR");
+  commandFillImage = (CommandFillImage)clGetExtensionFunctionAddressForPlatform(
+      platform_, "clCommandFillImageKHR");
+  commandNDRangeKernel =
+      (CommandNDRangeKernel)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clCommandNDRangeKernelKHR");
+  updateMutableCommands =
+      (UpdateMutableCommands)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clUpdateMutableCommandsKHR");
+  getMutableCommandInfo =
+      (GetMutableCommandInfo)clGetExtensionFunctionAddressForPlatform(
+          platform_, "clGetMutableCommandInfoKHR");
+  CHECK_RESULT((createCommandBuffer == NULL) ||
+                   (finalizeCommandBuffer == NULL) ||
+                   (releaseCommandBuffer == NULL) ||
+                   (enqueueCommandBuffer == NULL) ||
+                   (commandCopyBufferRect == NULL) ||
+                   (commandCopyBufferToImage == NULL) ||
+                   (commandCopyImage == NULL) ||
+                   (commandCopyImageToBuffer == NULL) ||
+                   (commandFillImage == NULL) ||
+                   (commandNDRangeKernel == NULL) ||
+                   (updateMutableCommands == NULL) ||
+                   (getMutableCommandInfo == NULL),
+               "cl_khr_command_buffer entry points not found");
+
+  cl_command_buffer_properties_khr properties[3] = {
+      CL_COMMAND_BUFFER_FLAGS_KHR, CL_COMMAND_BUFFER_MUTABLE_KHR, 0};
+  commandBuffer_ = createCommandBuffer(
+      1, &cmdQueues_[deviceId], (test_ == MutableInfo) ? properties : NULL,
+      &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateCommandBufferKHR() failed");
+}
+
+void OCLCommandBuffer::run(void) {
+  if (skip_ || _errorFlag) {
+    return;
+  }
+  switch (test_) {
+    case CopyBufferRect:
+      testCopyBufferRect();
+      break;
+    case CopyImages:
+      testCopyImages();
+      break;
+    case FillImage:
+      testFillImage();
+      break;
+    case MutableInfo:
+      testMutableInfo();
+      break;
+  }
+}
+
+void OCLCommandBuffer::replay() {
+  error_ = finalizeCommandBuffer(commandBuffer_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clFinalizeCommandBufferKHR() failed");
+  error_ = enqueueCommandBuffer(0, NULL, commandBuffer_, 0, NULL, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clEnqueueCommandBufferKHR() failed");
+  error_ = _wrapper->clFinish(cmdQueues_[_deviceId]);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clFinish() failed");
+}
+
+// Copies a rectangle between buffers with different row pitches
+void OCLCommandBuffer::testCopyBufferRect() {
+  cl_command_queue queue = cmdQueues_[_deviceId];
+  const size_t srcPitch = 16;
+  const size_t dstPitch = 32;
+  const size_t height = 16;
+  std::vector<cl_uchar> src(srcPitch * height);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<cl_uchar>(i);
+  }
+  std::vector<cl_uchar> dst(dstPitch * height, 0);
+
+  cl_mem srcBuffer =
+      _wrapper->clCreateBuffer(context_, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                               src.size(), src.data(), &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateBuffer() failed");
+  buffers_.push_back(srcBuffer);
+  cl_mem dstBuffer =
+      _wrapper->clCreateBuffer(context_, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                               dst.size(), dst.data(), &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateBuffer() failed");
+  buffers_.push_back(dstBuffer);
+
+  size_t srcOrigin[3] = {2, 3, 0};
+  size_t dstOrigin[3] = {4, 1, 0};
+  size_t region[3] = {8, 5, 1};
+  error_ = commandCopyBufferRect(commandBuffer_, NULL, srcBuffer, dstBuffer,
+                                 srcOrigin, dstOrigin, region, srcPitch, 0,
+                                 dstPitch, 0, 0, NULL, NULL, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCommandCopyBufferRectKHR() failed");
+  replay();
+  if (_errorFlag) {
+    return;
+  }
+
+  error_ = _wrapper->clEnqueueReadBuffer(queue, dstBuffer, CL_TRUE, 0,
+                                         dst.size(), dst.data(), 0, NULL, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clEnqueueReadBuffer() failed");
+  for (size_t y = 0; y < height; ++y) {
+    for (size_t x = 0; x < dstPitch; ++x) {
+      cl_uchar expected = 0;
+      if ((x >= dstOrigin[0]) && (x < dstOrigin[0] + region[0]) &&
+          (y >= dstOrigin[1]) && (y < dstOrigin[1] + region[1])) {
+        expected = src[(y - dstOrigin[1] + srcOrigin[1]) * srcPitch +
+                       (x - dstOrigin[0] + srcOrigin[0])];
+      }
+      CHECK_RESULT(dst[y * dstPitch + x] != expected,
+                   "Mismatch at (%zu, %zu): %u != %u", x, y,
+                   dst[y * dstPitch + x], expected);
+    }
+  }
+}
+
+// Copies a buffer through two images back to a buffer. The sync points order
+// the copies on out-of-order queues
+void OCLCommandBuffer::testCopyImages() {
+  cl_command_queue queue = cmdQueues_[_deviceId];
+  const size_t numPixels = ImageSize * ImageSize;
+  std::vector<cl_uint> src(numPixels);
+  for (size_t i = 0; i < numPixels; ++i) {
+    src[i] = static_cast<cl_uint>(i * 0x01010101u);
+  }
+  std::vector<cl_uint> dst(numPixels, 0);
+
+  cl_mem srcBuffer =
+      _wrapper->clCreateBuffer(context_, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                               numPixels * sizeof(cl_uint), src.data(), &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateBuffer() failed");
+  buffers_.push_back(srcBuffer);
+  cl_mem dstBuffer = _wrapper->clCreateBuffer(
+      context_, CL_MEM_READ_WRITE, numPixels * sizeof(cl_uint), NULL, &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateBuffer() failed");
+  buffers_.push_back(dstBuffer);
+
+  cl_image_format format = {CL_RGBA, CL_UNSIGNED_INT8};
+  cl_image_desc desc = {};
+  desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+  desc.image_width = ImageSize;
+  desc.image_height = ImageSize;
+  cl_mem images[2];
+  for (auto& image : images) {
+    image = _wrapper->clCreateImage(context_, CL_MEM_READ_WRITE, &format, &desc,
+                                    NULL, &error_);
+    CHECK_RESULT((error_ != CL_SUCCESS), "clCreateImage() failed");
+    buffers_.push_back(image);
+  }
+
+  size_t origin[3] = {0, 0, 0};
+  size_t region[3] = {ImageSize, ImageSize, 1};
+  cl_sync_point_khr syncPoints[2];
+  error_ = commandCopyBufferToImage(commandBuffer_, NULL, srcBuffer, images[0],
+                                    0, origin, region, 0, NULL, &syncPoints[0],
+                                    NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS),
+               "clCommandCopyBufferToImageKHR() failed");
+  error_ = commandCopyImage(commandBuffer_, NULL, images[0], images[1], origin,
+                            origin, region, 1, &syncPoints[0], &syncPoints[1],
+                            NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCommandCopyImageKHR() failed");
+  error_ = commandCopyImageToBuffer(commandBuffer_, NULL, images[1], dstBuffer,
+                                    origin, region, 0, 1, &syncPoints[1], NULL,
+                                    NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS),
+               "clCommandCopyImageToBufferKHR() failed");
+  replay();
+  if (_errorFlag) {
+    return;
+  }
+
+  error_ = _wrapper->clEnqueueReadBuffer(queue, dstBuffer, CL_TRUE, 0,
+                                         numPixels * sizeof(cl_uint),
+                                         dst.data(), 0, NULL, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clEnqueueReadBuffer() failed");
+  for (size_t i = 0; i < numPixels; ++i) {
+    CHECK_RESULT(dst[i] != src[i], "Mismatch at %zu: 0x%08x != 0x%08x", i,
+                 dst[i], src[i]);
+  }
+}
+
+// Clears the image and fills a square in the middle of it
+void OCLCommandBuffer::testFillImage() {
+  cl_command_queue queue = cmdQueues_[_deviceId];
+  cl_image_format format = {CL_RGBA, CL_UNSIGNED_INT8};
+  cl_image_desc desc = {};
+  desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+  desc.image_width = ImageSize;
+  desc.image_height = ImageSize;
+  cl_mem image = _wrapper->clCreateImage(context_, CL_MEM_READ_WRITE, &format,
+                                         &desc, NULL, &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateImage() failed");
+  buffers_.push_back(image);
+
+  cl_uint clear[4] = {0, 0, 0, 0};
+  cl_uint color[4] = {1, 2, 3, 4};
+  size_t origin[3] = {0, 0, 0};
+  size_t region[3] = {ImageSize, ImageSize, 1};
+  size_t fillOrigin[3] = {4, 4, 0};
+  size_t fillRegion[3] = {8, 8, 1};
+  cl_sync_point_khr syncPoint;
+  error_ = commandFillImage(commandBuffer_, NULL, image, clear, origin, region,
+                            0, NULL, &syncPoint, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCommandFillImageKHR() failed");
+  error_ = commandFillImage(commandBuffer_, NULL, image, color, fillOrigin,
+                            fillRegion, 1, &syncPoint, NULL, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCommandFillImageKHR() failed");
+  replay();
+  if (_errorFlag) {
+    return;
+  }
+
+  std::vector<cl_uchar> pixels(ImageSize * ImageSize * 4);
+  error_ = _wrapper->clEnqueueReadImage(queue, image, CL_TRUE, origin, region,
+                                        0, 0, pixels.data(), 0, NULL, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clEnqueueReadImage() failed");
+  for (size_t y = 0; y < ImageSize; ++y) {
+    for (size_t x = 0; x < ImageSize; ++x) {
+      const bool filled = (x >= fillOrigin[0]) &&
+                          (x < fillOrigin[0] + fillRegion[0]) &&
+                          (y >= fillOrigin[1]) &&
+                          (y < fillOrigin[1] + fillRegion[1]);
+      for (size_t c = 0; c < 4; ++c) {
+        const cl_uchar expected = filled ? static_cast<cl_uchar>(color[c]) : 0;
+        const cl_uchar value = pixels[(y * ImageSize + x) * 4 + c];
+        CHECK_RESULT(value != expected, "Mismatch at (%zu, %zu, %zu): %u != %u",
+                     x, y, c, value, expected);
+      }
+    }
+  }
+}
+
+// Queries a recorded launch before and after an update of the global size
+void OCLCommandBuffer::testMutableInfo() {
+  cl_command_queue queue = cmdQueues_[_deviceId];
+  program_ = _wrapper->clCreateProgramWithSource(context_, 1, &strKernel, NULL,
+                                                 &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateProgramWithSource() failed");
+  error_ = _wrapper->clBuildProgram(program_, 1, &devices_[_deviceId], NULL,
+                                    NULL, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clBuildProgram() failed");
+  kernel_ = _wrapper->clCreateKernel(program_, "fill", &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateKernel() failed");
+
+  cl_mem buffer = _wrapper->clCreateBuffer(
+      context_, CL_MEM_READ_WRITE, 256 * sizeof(cl_uint), NULL, &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateBuffer() failed");
+  buffers_.push_back(buffer);
+  cl_uint value = 1;
+  error_ = _wrapper->clSetKernelArg(kernel_, 0, sizeof(cl_mem), &buffer);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clSetKernelArg() failed");
+  error_ = _wrapper->clSetKernelArg(kernel_, 1, sizeof(cl_uint), &value);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clSetKernelArg() failed");
+
+  cl_ndrange_kernel_command_properties_khr properties[3] = {
+      CL_MUTABLE_DISPATCH_UPDATABLE_FIELDS_KHR,
+      CL_MUTABLE_DISPATCH_GLOBAL_SIZE_KHR, 0};
+  size_t gws[1] = {128};
+  cl_mutable_command_khr command = NULL;
+  error_ = commandNDRangeKernel(commandBuffer_, NULL, properties, kernel_, 1,
+                                NULL, gws, NULL, 0, NULL, NULL, &command);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCommandNDRangeKernelKHR() failed");
+  CHECK_RESULT(command == NULL, "No mutable handle");
+
+  cl_command_queue infoQueue = NULL;
+  error_ = getMutableCommandInfo(command, CL_MUTABLE_COMMAND_COMMAND_QUEUE_KHR,
+                                 sizeof(infoQueue), &infoQueue, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS) || (infoQueue != queue),
+               "CL_MUTABLE_COMMAND_COMMAND_QUEUE_KHR failed");
+  cl_command_buffer_khr infoBuffer = NULL;
+  error_ = getMutableCommandInfo(command, CL_MUTABLE_COMMAND_COMMAND_BUFFER_KHR,
+                                 sizeof(infoBuffer), &infoBuffer, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS) || (infoBuffer != commandBuffer_),
+               "CL_MUTABLE_COMMAND_COMMAND_BUFFER_KHR failed");
+  cl_command_type infoType = 0;
+  error_ = getMutableCommandInfo(command, CL_MUTABLE_COMMAND_COMMAND_TYPE_KHR,
+                                 sizeof(infoType), &infoType, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS) || (infoType != CL_COMMAND_NDRANGE_KERNEL),
+               "CL_MUTABLE_COMMAND_COMMAND_TYPE_KHR failed");
+  cl_kernel infoKernel = NULL;
+  error_ = getMutableCommandInfo(command, CL_MUTABLE_DISPATCH_KERNEL_KHR,
+                                 sizeof(infoKernel), &infoKernel, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS) || (infoKernel != kernel_),
+               "CL_MUTABLE_DISPATCH_KERNEL_KHR failed");
+  cl_uint infoDims = 0;
+  error_ = getMutableCommandInfo(command, CL_MUTABLE_DISPATCH_DIMENSIONS_KHR,
+                                 sizeof(infoDims), &infoDims, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS) || (infoDims != 1),
+               "CL_MUTABLE_DISPATCH_DIMENSIONS_KHR failed");
+
+  size_t size = 0;
+  error_ = getMutableCommandInfo(command,
+                                 CL_MUTABLE_DISPATCH_PROPERTIES_ARRAY_KHR, 0,
+                                 NULL, &size);
+  CHECK_RESULT((error_ != CL_SUCCESS) || (size != sizeof(properties)),
+               "CL_MUTABLE_DISPATCH_PROPERTIES_ARRAY_KHR size failed");
+  cl_ndrange_kernel_command_properties_khr infoProperties[3] = {};
+  error_ = getMutableCommandInfo(command,
+                                 CL_MUTABLE_DISPATCH_PROPERTIES_ARRAY_KHR,
+                                 sizeof(infoProperties), infoProperties, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS) ||
+                   (memcmp(infoProperties, properties, sizeof(properties)) != 0),
+               "CL_MUTABLE_DISPATCH_PROPERTIES_ARRAY_KHR failed");
+
+  size_t infoGws = 0;
+  error_ = getMutableCommandInfo(command,
+                                 CL_MUTABLE_DISPATCH_GLOBAL_WORK_SIZE_KHR,
+                                 sizeof(infoGws), &infoGws, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS) || (infoGws != gws[0]),
+               "CL_MUTABLE_DISPATCH_GLOBAL_WORK_SIZE_KHR failed");
+
+  error_ = finalizeCommandBuffer(commandBuffer_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clFinalizeCommandBufferKHR() failed");
+
+  size_t newGws[1] = {256};
+  cl_mutable_dispatch_config_khr dispatch = {};
+  dispatch.type = CL_STRUCTURE_TYPE_MUTABLE_DISPATCH_CONFIG_KHR;
+  dispatch.command = command;
+  dispatch.global_work_size = newGws;
+  cl_mutable_base_config_khr config = {CL_STRUCTURE_TYPE_MUTABLE_BASE_CONFIG_KHR,
+                                       NULL, 1, &dispatch};
+  error_ = updateMutableCommands(commandBuffer_, &config);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clUpdateMutableCommandsKHR() failed");
+  error_ = getMutableCommandInfo(command,
+                                 CL_MUTABLE_DISPATCH_GLOBAL_WORK_SIZE_KHR,
+                                 sizeof(infoGws), &infoGws, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS) || (infoGws != newGws[0]),
+               "CL_MUTABLE_DISPATCH_GLOBAL_WORK_SIZE_KHR after update failed");
+
+  error_ = getMutableCommandInfo(NULL, CL_MUTABLE_DISPATCH_KERNEL_KHR,
+                                 sizeof(infoKernel), &infoKernel, NULL);
+  CHECK_RESULT(error_ != CL_INVALID_MUTABLE_COMMAND_KHR,
+               "NULL command accepted");
+}
+
+unsigned int OCLCommandBuffer::close(void) {
+  if (commandBuffer_ != NULL) {
+    error_ = releaseCommandBuffer(commandBuffer_);
+    CHECK_RESULT_NO_RETURN((error_ != CL_SUCCESS),
+                           "clReleaseCommandBufferKHR() failed");
+    commandBuffer_ = NULL;
+  }
+  return OCLTestImp::close();
+}
@@ -0,0 +1,52 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#ifndef _OCL_COMMAND_BUFFER_H_
+#define _OCL_COMMAND_BUFFER_H_
+
+#include "OCLTestImp.h"
+#include "cl_command_buffer_khr.h"
+
+class OCLCommandBuffer : public OCLTestImp {
+ public:
+  OCLCommandBuffer();
+  virtual ~OCLCommandBuffer();
+
+ public:
+  virtual void open(unsigned int test, char* units, double& conversion,
+                    unsigned int deviceID);
+  virtual void run(void);
+  virtual unsigned int close(void);
+
+ private:
+  //! Replays the command buffer once and waits for it
+  void replay();
+
+  void testCopyBufferRect();
+  void testCopyImages();
+  void testFillImage();
+  void testMutableInfo();
+
+  bool skip_;
+  unsigned int test_;
+  cl_command_buffer_khr commandBuffer_;
+};
+
+#endif  // _OCL_COMMAND_BUFFER_H_
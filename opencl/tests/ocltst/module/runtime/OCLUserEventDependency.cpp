@@ -0,0 +1,129 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "OCLUserEventDependency.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "CL/cl.h"
+
+// Sub-tests:
+//  0 - a command, which waits for a user event, keeps the queue order
+//  1 - a failed user event fails the dependent command, but not the queue
+static const unsigned int NumSubTests = 2;
+
+OCLUserEventDependency::OCLUserEventDependency() {
+  _numSubTests = NumSubTests;
+  failed_ = false;
+  test_ = 0;
+}
+
+OCLUserEventDependency::~OCLUserEventDependency() {}
+
+void OCLUserEventDependency::open(unsigned int test, char* units,
+                                  double& conversion, unsigned int deviceId) {
+  OCLTestImp::open(test, units, conversion, deviceId);
+  CHECK_RESULT((error_ != CL_SUCCESS), "Error opening test");
+
+  if (deviceId >= deviceCount_) {
+    failed_ = true;
+    return;
+  }
+  test_ = test;
+
+  cl_mem buffer;
+  buffer = _wrapper->clCreateBuffer(context_, CL_MEM_READ_WRITE,
+                                    sizeof(cl_uint), NULL, &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateBuffer() failed");
+  buffers_.push_back(buffer);
+}
+
+void OCLUserEventDependency::run(void) {
+  if (failed_) {
+    return;
+  }
+  cl_command_queue queue = cmdQueues_[_deviceId];
+  cl_uint initVal[2] = {5, 10};
+  cl_uint result = 0;
+  cl_event events[2];
+  cl_int status;
+
+  cl_event userEvent = _wrapper->clCreateUserEvent(context_, &error_);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clCreateUserEvent() failed");
+
+  // The first write waits for the user event, the second one doesn't have
+  // dependencies, but it still has to run after the first one
+  error_ = _wrapper->clEnqueueWriteBuffer(queue, buffers()[0], false, 0,
+                                          sizeof(cl_uint), &initVal[0], 1,
+                                          &userEvent, &events[0]);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clEnqueueWriteBuffer() failed");
+  error_ = _wrapper->clEnqueueWriteBuffer(queue, buffers()[0], false, 0,
+                                          sizeof(cl_uint), &initVal[1], 0,
+                                          NULL, &events[1]);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clEnqueueWriteBuffer() failed");
+  error_ = _wrapper->clFlush(queue);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clFlush() failed");
+
+  error_ = _wrapper->clGetEventInfo(events[1],
+                                    CL_EVENT_COMMAND_EXECUTION_STATUS,
+                                    sizeof(cl_int), &status, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clGetEventInfo() failed");
+  CHECK_RESULT((status == CL_COMPLETE),
+               "The command completed before the blocked command");
+
+  error_ = _wrapper->clSetUserEventStatus(userEvent,
+                                          (test_ == 0) ? CL_COMPLETE : -1);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clSetUserEventStatus() failed");
+
+  error_ = _wrapper->clFinish(queue);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clFinish() failed");
+
+  error_ = _wrapper->clGetEventInfo(events[0],
+                                    CL_EVENT_COMMAND_EXECUTION_STATUS,
+                                    sizeof(cl_int), &status, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clGetEventInfo() failed");
+  if (test_ == 0) {
+    CHECK_RESULT((status != CL_COMPLETE), "The blocked command didn't complete");
+  } else {
+    CHECK_RESULT((status >= 0), "The blocked command didn't fail");
+  }
+  error_ = _wrapper->clGetEventInfo(events[1],
+                                    CL_EVENT_COMMAND_EXECUTION_STATUS,
+                                    sizeof(cl_int), &status, NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clGetEventInfo() failed");
+  CHECK_RESULT((status != CL_COMPLETE), "The last command didn't complete");
+
+  error_ = _wrapper->clEnqueueReadBuffer(queue, buffers()[0], true, 0,
+                                         sizeof(cl_uint), &result, 0, NULL,
+                                         NULL);
+  CHECK_RESULT((error_ != CL_SUCCESS), "clEnqueueReadBuffer() failed");
+  CHECK_RESULT((result != initVal[1]), "Invalid result %u, expected %u",
+               result, initVal[1]);
+
+  _wrapper->clReleaseEvent(events[0]);
+  _wrapper->clReleaseEvent(events[1]);
+  _wrapper->clReleaseEvent(userEvent);
+}
+
+unsigned int OCLUserEventDependency::close(void) {
+  return OCLTestImp::close();
+}
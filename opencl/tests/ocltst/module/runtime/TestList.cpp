@@ -29,6 +29,7 @@
 #include "OCLBlitKernel.h"
 #include "OCLBufferFromImage.h"
 #include "OCLCPUGuardPages.h"
+#include "OCLCommandBuffer.h"
 #include "OCLCreateBuffer.h"
 #include "OCLCreateContext.h"
 #include "OCLCreateImage.h"
@@ -65,6 +66,7 @@
 #include "OCLStablePState.h"
 #include "OCLThreadTrace.h"
 #include "OCLUnalignedCopy.h"
+#include "OCLUserEventDependency.h"
 
 //
 //  Helper macro for adding tests
@@ -118,6 +120,8 @@ TestEntry TestList[] = {
     TEST(OCLReadWriteImage),
     TEST(OCLStablePState),
     TEST(OCLP2PBuffer),
+    TEST(OCLUserEventDependency),
+    TEST(OCLCommandBuffer),
     // Failures in Linux. IOL doesn't support tiling aperture and Cypress linear
     // image writes TEST(OCLPersistent),
 };
@@ -68,12 +68,19 @@ target_sources(rocclr PRIVATE
   ${ROCCLR_SRC_DIR}/device/blit.cpp
   ${ROCCLR_SRC_DIR}/device/blitcl.cpp
   ${ROCCLR_SRC_DIR}/device/comgrctx.cpp
+  ${ROCCLR_SRC_DIR}/device/devblitcache.cpp
+  ${ROCCLR_SRC_DIR}/device/devcupartition.cpp
   ${ROCCLR_SRC_DIR}/device/devhcmessages.cpp
   ${ROCCLR_SRC_DIR}/device/devhcprintf.cpp
   ${ROCCLR_SRC_DIR}/device/devhostcall.cpp
   ${ROCCLR_SRC_DIR}/device/device.cpp
   ${ROCCLR_SRC_DIR}/device/devkernel.cpp
+  ${ROCCLR_SRC_DIR}/device/devmeminfo.cpp
+  ${ROCCLR_SRC_DIR}/device/devnuma.cpp
   ${ROCCLR_SRC_DIR}/device/devprogram.cpp
+  ${ROCCLR_SRC_DIR}/device/devstreamops.cpp
+  ${ROCCLR_SRC_DIR}/device/devsvmbatch.cpp
+  ${ROCCLR_SRC_DIR}/device/devvirtualmap.cpp
   ${ROCCLR_SRC_DIR}/device/hsailctx.cpp
   ${ROCCLR_SRC_DIR}/elf/elf.cpp
   ${ROCCLR_SRC_DIR}/os/alloc.cpp
@@ -83,7 +90,10 @@ target_sources(rocclr PRIVATE
   ${ROCCLR_SRC_DIR}/platform/activity.cpp
   ${ROCCLR_SRC_DIR}/platform/agent.cpp
   ${ROCCLR_SRC_DIR}/platform/command.cpp
+  ${ROCCLR_SRC_DIR}/platform/command_schedule.cpp
+  ${ROCCLR_SRC_DIR}/platform/commandbuffer.cpp
   ${ROCCLR_SRC_DIR}/platform/commandqueue.cpp
+  ${ROCCLR_SRC_DIR}/platform/conditional.cpp
   ${ROCCLR_SRC_DIR}/platform/context.cpp
   ${ROCCLR_SRC_DIR}/platform/kernel.cpp
   ${ROCCLR_SRC_DIR}/platform/memory.cpp
@@ -95,7 +105,8 @@ target_sources(rocclr PRIVATE
   ${ROCCLR_SRC_DIR}/thread/semaphore.cpp
   ${ROCCLR_SRC_DIR}/thread/thread.cpp
   ${ROCCLR_SRC_DIR}/utils/debug.cpp
-  ${ROCCLR_SRC_DIR}/utils/flags.cpp)
+  ${ROCCLR_SRC_DIR}/utils/flags.cpp
+  ${ROCCLR_SRC_DIR}/utils/slab.cpp)
 
 if(WIN32)
   target_sources(rocclr PRIVATE
@@ -0,0 +1,63 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "device/devblitcache.hpp"
+
+namespace amd::device {
+
+// ================================================================================================
+std::string BlitCodeCache::Key(const std::string& isaName, const std::string& options,
+                               const std::string& source) {
+  return isaName + '|' + options + '|' + std::to_string(std::hash<std::string>{}(source));
+}
+
+// ================================================================================================
+bool BlitCodeCache::getOrBuild(const std::string& key, const Build& build, std::string* binary) {
+  // The lock is held over the build, so a second device with the same ISA waits for
+  // the first compile instead of compiling again
+  amd::ScopedLock lock(lock_);
+  auto it = binaries_.find(key);
+  if (it != binaries_.end()) {
+    *binary = it->second;
+    return true;
+  }
+  if (!build(binary)) {
+    return false;
+  }
+  if (!binary->empty()) {
+    binaries_.emplace(key, *binary);
+  }
+  return true;
+}
+
+// ================================================================================================
+size_t BlitCodeCache::size() const {
+  amd::ScopedLock lock(lock_);
+  return binaries_.size();
+}
+
+// ================================================================================================
+BlitCodeCache& BlitCodeCache::instance() {
+  // Never destroyed, the devices may create the blit programs until the process exit
+  static BlitCodeCache* cache = new BlitCodeCache();
+  return *cache;
+}
+
+}  // namespace amd::device
@@ -0,0 +1,58 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+#include "thread/monitor.hpp"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace amd::device {
+
+//! Code objects of the blit kernels. The devices with the same ISA and build options share
+//! one compile, the other devices load the binary of the first one.
+class BlitCodeCache : public amd::HeapObject {
+ public:
+  //! Compiles the blit program and returns its binary
+  typedef std::function<bool(std::string* binary)> Build;
+
+  //! Returns the cache key of a blit program
+  static std::string Key(const std::string& isaName, const std::string& options,
+                         const std::string& source);
+
+  //! Returns the binary for the key. Only the first request of a key calls build(), a
+  //! concurrent request of the same key waits for it. A failed build isn't cached.
+  bool getOrBuild(const std::string& key, const Build& build, std::string* binary);
+
+  //! Returns the number of cached binaries
+  size_t size() const;
+
+  //! Returns the cache of the process
+  static BlitCodeCache& instance();
+
+ private:
+  mutable amd::Monitor lock_{"Blit code cache", true};
+  std::unordered_map<std::string, std::string> binaries_;  //!< Binaries per key
+};
+
+}  // namespace amd::device
@@ -0,0 +1,104 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "device/devcupartition.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace amd::device {
+
+// ================================================================================================
+static uint32_t CusPerXcc(const CuTopology& topo) {
+  return topo.numCUs_ / std::max(topo.numXccs_, 1u);
+}
+
+// ================================================================================================
+static uint32_t SesPerXcc(const CuTopology& topo) {
+  return std::max(topo.numSEs_ / std::max(topo.numXccs_, 1u), 1u);
+}
+
+// ================================================================================================
+uint32_t CuXcc(const CuTopology& topo, uint32_t cu) {
+  uint32_t cusPerXcc = CusPerXcc(topo);
+  if (cusPerXcc == 0) {
+    return 0;
+  }
+  // The bits above the last full XCC belong to the last XCC
+  return std::min(cu / cusPerXcc, std::max(topo.numXccs_, 1u) - 1);
+}
+
+// ================================================================================================
+uint32_t CuShaderEngine(const CuTopology& topo, uint32_t cu) {
+  uint32_t xcc = CuXcc(topo, cu);
+  uint32_t sesPerXcc = SesPerXcc(topo);
+  return xcc * sesPerXcc + (cu - xcc * CusPerXcc(topo)) % sesPerXcc;
+}
+
+// ================================================================================================
+uint32_t CuCountFromFraction(const CuTopology& topo, double fraction) {
+  if (!(fraction > 0.0) || (fraction > 1.0)) {
+    return 0;
+  }
+  uint32_t count = static_cast<uint32_t>(std::lround(fraction * topo.numCUs_));
+  return std::min(std::max(count, 1u), topo.numCUs_);
+}
+
+// ================================================================================================
+bool PartitionCUs(const CuTopology& topo, const std::vector<uint32_t>& counts,
+                  std::vector<std::vector<uint32_t>>* masks) {
+  uint64_t total = 0;
+  for (auto count : counts) {
+    if (count == 0) {
+      return false;
+    }
+    total += count;
+  }
+  if (total > topo.numCUs_) {
+    return false;
+  }
+
+  // Interleave the XCCs. Consecutive bits of an XCC already alternate the shader engines,
+  // hence any run of the order is balanced over both
+  std::vector<uint32_t> order;
+  order.reserve(topo.numCUs_);
+  uint32_t numXccs = std::max(topo.numXccs_, 1u);
+  uint32_t cusPerXcc = CusPerXcc(topo);
+  for (uint32_t i = 0; i < cusPerXcc; ++i) {
+    for (uint32_t xcc = 0; xcc < numXccs; ++xcc) {
+      order.push_back(xcc * cusPerXcc + i);
+    }
+  }
+  for (uint32_t cu = numXccs * cusPerXcc; cu < topo.numCUs_; ++cu) {
+    order.push_back(cu);
+  }
+
+  masks->assign(counts.size(), std::vector<uint32_t>((topo.numCUs_ + 31) / 32, 0));
+  size_t next = 0;
+  for (size_t pool = 0; pool < counts.size(); ++pool) {
+    for (uint32_t i = 0; i < counts[pool]; ++i, ++next) {
+      uint32_t cu = order[next];
+      (*masks)[pool][cu / 32] |= 1u << (cu % 32);
+    }
+  }
+  return true;
+}
+
+}  // namespace amd::device
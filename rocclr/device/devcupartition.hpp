@@ -0,0 +1,53 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+
+#include <vector>
+
+namespace amd::device {
+
+//! Layout of the CUs in a hardware queue CU mask. The XCCs own contiguous ranges of the mask
+//! bits and the shader engines of an XCC own its bits in a round robin order
+struct CuTopology {
+  uint32_t numCUs_;   //!< Number of the mask bits, i.e. CUs or WGPs in WGP mode
+  uint32_t numSEs_;   //!< Number of the shader engines of the device
+  uint32_t numXccs_;  //!< Number of the XCCs of the device
+};
+
+//! Returns the shader engine, which owns the mask bit
+uint32_t CuShaderEngine(const CuTopology& topo, uint32_t cu);
+
+//! Returns the XCC, which owns the mask bit
+uint32_t CuXcc(const CuTopology& topo, uint32_t cu);
+
+//! Converts a fraction of the device to a CU count. The result is at least a single CU
+//! and 0 if the fraction is out of the (0, 1] range
+uint32_t CuCountFromFraction(const CuTopology& topo, double fraction);
+
+//! Splits the CUs into disjoint pools of the requested sizes. Every pool is spread evenly over
+//! the XCCs and the shader engines, so the pools don't compete for the same front ends.
+//! Returns false if a pool is empty or the pools need more CUs than the device has
+bool PartitionCUs(const CuTopology& topo, const std::vector<uint32_t>& counts,
+                  std::vector<std::vector<uint32_t>>* masks);
+
+}  // namespace amd::device
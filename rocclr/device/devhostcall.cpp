@@ -225,6 +225,7 @@ class HostcallListener {
   MessageHandler messages_;
   // Keep track of devices for which signal creation have already been done
   std::set<const amd::Device*> devices_;
+  uint32_t numaNode_ = 0;  //!< NUMA node of the device, which started the listener
 #if defined(__clang__)
 #if __has_feature(address_sanitizer)
    device::UriLocator* urilocator = nullptr;
@@ -237,6 +238,7 @@ class HostcallListener {
     //! The hostcall listener thread entry point.
     void run(void* data) {
       auto listener = reinterpret_cast<HostcallListener*>(data);
+      amd::Os::setPreferredNumaNode(listener->numaNode_);
       listener->consumePackets();
     }
   } thread_;  //!< The hostcall listener thread.
@@ -390,6 +392,7 @@ bool HostcallListener::initSignal(const amd::Device &dev) {
 #endif
     return false;
   }
+  numaNode_ = dev.getPreferredNumaNode();
   thread_.start(this);
   return true;
 }
@@ -22,6 +22,7 @@
 #include "thread/monitor.hpp"
 #include "utils/options.hpp"
 #include "comgrctx.hpp"
+#include "device/devblitcache.hpp"
 
 #include <algorithm>
 #include <array>
@@ -554,14 +555,6 @@ bool Device::BlitProgram::create(amd::Device* device, const std::string& extraKe
     kernels += extraKernels;
   }
 
-  // Create a program with all blit kernels
-  program_ = new Program(*context_, kernels.c_str(), Program::OpenCL_C);
-  if (program_ == nullptr) {
-    DevLogPrintfError("Program creation for Kernel: %s failed\n",
-                      kernels.c_str());
-    return false;
-  }
-
   // Build all kernels
   std::string opt = "-cl-internal-kernel ";
   if (!device->settings().useLightning_) {
@@ -577,21 +570,60 @@ bool Device::BlitProgram::create(amd::Device* device, const std::string& extraKe
   if (device->settings().kernel_arg_opt_) {
     opt += " -Wb,-amdgpu-kernarg-preload-count=8 ";
   }
+  // The dumps need the compile on every device
+  bool shareable = !GPU_DUMP_BLIT_KERNELS;
 #if defined(__clang__)
 #if __has_feature(address_sanitizer)
   opt += " -fsanitize=address ";
+  shareable = false;
 #endif
 #endif
-  if ((retval = program_->build(devices, opt.c_str(), nullptr, nullptr, GPU_DUMP_BLIT_KERNELS))
-      != CL_SUCCESS) {
-    DevLogPrintfError("Build failed for Kernel: %s with error code %d\n",
-                      kernels.c_str(), retval);
+  uint64_t start = Os::timeNanos();
+  bool compiled = false;
+  auto compile = [&](std::string* binary) {
+    // Create a program with all blit kernels
+    program_ = new Program(*context_, kernels.c_str(), Program::OpenCL_C);
+    if ((retval = program_->build(devices, opt.c_str(), nullptr, nullptr,
+                                  GPU_DUMP_BLIT_KERNELS)) != CL_SUCCESS) {
+      DevLogPrintfError("Build failed for Kernel: %s with error code %d\n",
+                        kernels.c_str(), retval);
+      return false;
+    }
+    compiled = true;
+    if (binary != nullptr) {
+      const device::Program::binary_t image = program_->getDeviceProgram(*device)->binary();
+      binary->assign(reinterpret_cast<const char*>(image.first), image.second);
+    }
+    return true;
+  };
+
+  if (shareable) {
+    std::string binary;
+    const std::string key = device::BlitCodeCache::Key(device->isa().isaName(), opt, kernels);
+    if (!device::BlitCodeCache::instance().getOrBuild(key, compile, &binary)) {
+      return false;
+    }
+    if (!compiled) {
+      // Another device with the same ISA has compiled the kernels already
+      program_ = new Program(*context_);
+      if ((program_->addDeviceProgram(*device, binary.data(), binary.size()) != CL_SUCCESS) ||
+          ((retval = program_->build(devices, opt.c_str(), nullptr, nullptr, false)) !=
+           CL_SUCCESS)) {
+        DevLogPrintfError("Build of the shared blit binary failed with error code %d\n",
+                          retval);
+        return false;
+      }
+    }
+  } else if (!compile(nullptr)) {
     return false;
   }
   if (!program_->load()) {
     DevLogPrintfError("Could not load the kernels: %s \n", kernels.c_str());
     return false;
   }
+  ClPrint(amd::LOG_INFO, amd::LOG_INIT, "Blit kernels for %s %s in %.3f ms",
+          device->isa().isaName().c_str(), compiled ? "compiled" : "loaded from a shared binary",
+          (Os::timeNanos() - start) / 1e6);
 
   return true;
 }
@@ -38,6 +38,7 @@
 #include "hsailctx.hpp"
 #endif
 #include "devsignal.hpp"
+#include "devmeminfo.hpp"
 
 #if defined(__clang__)
 #if __has_feature(address_sanitizer)
@@ -91,6 +92,7 @@ class SvmMapMemoryCommand;
 class SvmUnmapMemoryCommand;
 class SvmPrefetchAsyncCommand;
 class StreamOperationCommand;
+class BatchStreamOperationCommand;
 class VirtualMapCommand;
 class ExternalSemaphoreCmd;
 class Isa;
@@ -111,6 +113,12 @@ enum MemoryAdvice : uint32_t {
   UnsetCoarseGrain = 101      ///< Restore coherent cache policy at the cost of some performance
 };
 
+//! A single advice of a batch, which applies to one range
+struct SvmAdvice {
+  MemoryAdvice advice_;       ///< The advice
+  const Device* device_;      ///< Device the advice refers to, nullptr means CPU
+};
+
 enum MemRangeAttribute : uint32_t {
     ReadMostly = 1,           ///< Whether the range will mostly be read and only
                               ///< occassionally be written to
@@ -184,6 +192,8 @@ enum OclExtensions {
   ClKhrMipMapImageWrites,
   ClAmdCopyBufferP2P,
   ClAmdAssemblyProgram,
+  ClKhrCommandBuffer,
+  ClKhrCommandBufferMutableDispatch,
 #if defined(_WIN32)
   ClAmdPlanarYuv,
 #endif
@@ -227,6 +237,8 @@ static constexpr const char* OclExtensionsString[] = {"cl_khr_fp64 ",
                                             "cl_khr_mipmap_image_writes ",
                                             "cl_amd_copy_buffer_p2p ",
                                             "cl_amd_assembly_program ",
+                                            "cl_khr_command_buffer ",
+                                            "cl_khr_command_buffer_mutable_dispatch ",
 #if defined(_WIN32)
                                             "cl_amd_planar_yuv",
 #endif
@@ -283,6 +295,9 @@ struct Info : public amd::EmbeddedObject {
   //! Number of shader engines in physical GPU
   size_t numberOfShaderEngines;
 
+  //! Number of XCCs in physical GPU
+  size_t numberOfXccs;
+
   //! uint32_t Preferred native vector width size for built-in scalar types
   //  that can be put into vectors.
   uint32_t preferredVectorWidthChar_;
@@ -1305,6 +1320,9 @@ class VirtualDevice : public amd::HeapObject {
     ShouldNotReachHere();
   }
   virtual void submitStreamOperation(amd::StreamOperationCommand& cmd) { ShouldNotReachHere(); }
+  virtual void submitBatchStreamOperation(amd::BatchStreamOperationCommand& cmd) {
+    ShouldNotReachHere();
+  }
   virtual void submitVirtualMap(amd::VirtualMapCommand& cmd) { ShouldNotReachHere(); }
 
   virtual address allocKernelArguments(size_t size, size_t alignment) { return nullptr; }
@@ -1726,6 +1744,9 @@ class Device : public RuntimeObject {
   //! Create a new virtual device environment.
   virtual device::VirtualDevice* createVirtualDevice(CommandQueue* queue = NULL) = 0;
 
+  //! Releases a virtual device of a terminated command queue. The backend may keep it for reuse
+  virtual void releaseVirtualDevice(device::VirtualDevice* vdev) const { delete vdev; }
+
   //! Create a program for device.
   virtual device::Program* createProgram(amd::Program& owner, option::Options* options = NULL) = 0;
 
@@ -1771,6 +1792,9 @@ class Device : public RuntimeObject {
   virtual bool globalFreeMemory(size_t* freeMemory  //!< Free memory information on a GPU device
                                 ) const = 0;
 
+  //! Returns the runtime accounting of the device memory, nullptr if the device doesn't keep it
+  virtual device::MemoryAccounting* memoryAccounting() const { return nullptr; }
+
   virtual bool importExtSemaphore(void** extSemaphore, const amd::Os::FileDesc& handle,
                                   amd::ExternalSemaphoreHandleType sem_handle_type) = 0;
   virtual void DestroyExtSemaphore(void* extSemaphore) = 0;
@@ -1932,6 +1956,24 @@ class Device : public RuntimeObject {
     return false;
   }
 
+  /**
+   * @return True if the device successfully applied all the advices to the range in HMM
+   * with a single update
+   */
+  virtual bool SetSvmAttributes(const void* dev_ptr, size_t count,
+                                const std::vector<amd::SvmAdvice>& advices) const {
+    ShouldNotCallThis();
+    return false;
+  }
+
+  /**
+   * @return True if HMM can update the SVM attributes of the range
+   */
+  virtual bool ValidateSvmRange(const void* dev_ptr, size_t count) const {
+    ShouldNotCallThis();
+    return false;
+  }
+
   /**
    * @return True if the device successfully retrieved the SVM attributes from HMM for device memory
    */
@@ -0,0 +1,176 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "device/devmeminfo.hpp"
+#include "os/os.hpp"
+
+namespace amd::device {
+
+// ================================================================================================
+MemoryAccounting::MemoryAccounting(size_t totalBytes, QueryFree queryFree,
+                                   uint64_t reconcileIntervalNs)
+    : total_(totalBytes),
+      queryFree_(std::move(queryFree)),
+      interval_(reconcileIntervalNs),
+      allocated_(0),
+      external_(0),
+      lastReconcile_(0),
+      watermarks_(false),
+      watermarkLock_("Memory watermarks", true) {
+  reconciling_.clear();
+}
+
+// ================================================================================================
+void MemoryAccounting::release(size_t size) {
+  size_t allocated = allocated_.load(std::memory_order_relaxed);
+  size_t update;
+  do {
+    if (size > allocated) {
+      // The runtime doesn't see all allocations, i.e. some of them can go directly to the driver
+      ClPrint(amd::LOG_INFO, amd::LOG_MEM,
+              "Released size 0x%zx exceeds the allocated size 0x%zx", size, allocated);
+      update = 0;
+    } else {
+      update = allocated - size;
+    }
+  } while (!allocated_.compare_exchange_weak(allocated, update, std::memory_order_relaxed));
+  if (watermarks_.load(std::memory_order_acquire)) {
+    checkWatermarks();
+  }
+}
+
+// ================================================================================================
+size_t MemoryAccounting::currentFree() const {
+  const int64_t used = static_cast<int64_t>(allocated_.load(std::memory_order_relaxed)) +
+                       external_.load(std::memory_order_relaxed);
+  if (used <= 0) {
+    return total_;
+  }
+  return (static_cast<size_t>(used) < total_) ? (total_ - static_cast<size_t>(used)) : 0;
+}
+
+// ================================================================================================
+bool MemoryAccounting::reconcile() {
+  size_t driverFree = 0;
+  const size_t allocated = allocated_.load(std::memory_order_relaxed);
+  if (!queryFree_(&driverFree)) {
+    return false;
+  }
+  // The driver free memory must match the runtime view after the update
+  const int64_t external = static_cast<int64_t>(total_) - static_cast<int64_t>(driverFree) -
+                           static_cast<int64_t>(allocated);
+  external_.store(external, std::memory_order_relaxed);
+  lastReconcile_.store(Os::timeNanos(), std::memory_order_relaxed);
+  if (watermarks_.load(std::memory_order_acquire)) {
+    checkWatermarks();
+  }
+  return true;
+}
+
+// ================================================================================================
+bool MemoryAccounting::freeMemory(size_t* freeBytes) {
+  const uint64_t last = lastReconcile_.load(std::memory_order_relaxed);
+  if ((interval_ == 0) || (last == 0) || ((Os::timeNanos() - last) >= interval_)) {
+    if (interval_ == 0) {
+      if (!queryFree_(freeBytes)) {
+        return false;
+      }
+      // Keep the runtime counters in sync for the watermarks
+      const int64_t external = static_cast<int64_t>(total_) - static_cast<int64_t>(*freeBytes) -
+                               static_cast<int64_t>(allocated_.load(std::memory_order_relaxed));
+      external_.store(external, std::memory_order_relaxed);
+      return true;
+    }
+    // Only one thread queries the driver, the others use the current counters
+    if (!reconciling_.test_and_set(std::memory_order_acquire)) {
+      const bool result = reconcile();
+      reconciling_.clear(std::memory_order_release);
+      if (!result && (last == 0)) {
+        return false;
+      }
+    }
+  }
+  *freeBytes = currentFree();
+  return true;
+}
+
+// ================================================================================================
+void MemoryAccounting::setWatermarks(size_t lowFree, size_t highFree, WatermarkCallback callback,
+                                     void* data) {
+  amd::ScopedLock lock(watermarkLock_);
+  lowFree_ = lowFree;
+  highFree_ = highFree;
+  callback_ = callback;
+  callbackData_ = data;
+  level_ = kNormal;
+  notified_ = kNormal;
+  watermarks_.store(callback != nullptr, std::memory_order_release);
+}
+
+// ================================================================================================
+void MemoryAccounting::checkWatermarks() {
+  {
+    amd::ScopedLock lock(watermarkLock_);
+    if (callback_ == nullptr) {
+      return;
+    }
+    const size_t freeBytes = currentFree();
+    // The level between the watermarks stays unchanged, so a value around a watermark
+    // doesn't cause a notification storm
+    Level level = level_;
+    if (freeBytes < lowFree_) {
+      level = kBelowLow;
+    } else if (freeBytes > highFree_) {
+      level = kAboveHigh;
+    }
+    if (level == level_) {
+      return;
+    }
+    level_ = level;
+    levelFree_ = freeBytes;
+    // A thread is already in the notification loop and will deliver the new level
+    if (notifying_) {
+      return;
+    }
+    notifying_ = true;
+  }
+  // The callback runs without the lock, since it may allocate or free memory itself
+  while (true) {
+    WatermarkCallback callback;
+    void* data;
+    size_t freeBytes;
+    Level level;
+    {
+      amd::ScopedLock lock(watermarkLock_);
+      if ((callback_ == nullptr) || (notified_ == level_)) {
+        notifying_ = false;
+        return;
+      }
+      notified_ = level_;
+      level = level_;
+      freeBytes = levelFree_;
+      callback = callback_;
+      data = callbackData_;
+    }
+    callback(freeBytes, (level == kBelowLow) ? 1 : 0, data);
+  }
+}
+
+}  // namespace amd::device
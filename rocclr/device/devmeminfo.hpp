@@ -0,0 +1,123 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+#include "thread/monitor.hpp"
+
+#include <atomic>
+#include <functional>
+
+namespace amd::device {
+
+//! Runtime accounting of the device memory. The allocations and releases are counted
+//! in the runtime, while the memory outside of the runtime's view (other processes, direct
+//! driver allocations) is refreshed from the driver at the reconcile interval. That keeps
+//! the free memory query off the driver for the most calls.
+class MemoryAccounting : public amd::HeapObject {
+ public:
+  //! Queries the free device memory in bytes from the driver
+  typedef std::function<bool(size_t* freeBytes)> QueryFree;
+
+  //! Called when the free memory drops below the low watermark (belowLow is 1) or
+  //! rises above the high watermark (belowLow is 0)
+  typedef void (*WatermarkCallback)(size_t freeBytes, int belowLow, void* data);
+
+  //! Origin of the memory behind a runtime buffer
+  enum class Origin : int {
+    kAllocation = 0,  //!< Device memory allocated for the buffer
+    kPhysical = 1,    //!< Physical handle of a virtual memory allocation
+    kImported = 2,    //!< Physical handle, which another process exported
+    kView = 3         //!< Address of the memory, which another buffer or process owns
+  };
+
+  MemoryAccounting(size_t totalBytes, QueryFree queryFree, uint64_t reconcileIntervalNs);
+
+  //! Returns true if the buffer has to be counted on creation and release. The mappings of
+  //! a physical handle and the IPC imports are views, hence the memory is counted once by
+  //! its owner, or by the reconcile for the other processes
+  static bool counted(Origin origin) {
+    return (origin == Origin::kAllocation) || (origin == Origin::kPhysical);
+  }
+
+  //! Records an allocation of device memory
+  void allocate(size_t size) {
+    allocated_.fetch_add(size, std::memory_order_relaxed);
+    if (watermarks_.load(std::memory_order_acquire)) {
+      checkWatermarks();
+    }
+  }
+
+  //! Records a release of device memory
+  void release(size_t size);
+
+  //! Returns the bytes allocated through the runtime
+  size_t allocated() const { return allocated_.load(std::memory_order_relaxed); }
+
+  //! Returns the total device memory
+  size_t total() const { return total_; }
+
+  //! Returns the free memory, reconciles with the driver if the interval has expired
+  bool freeMemory(size_t* freeBytes);
+
+  //! Queries the driver and updates the memory used outside of the runtime
+  bool reconcile();
+
+  //! Sets the watermarks in free bytes. A null callback disables the notifications.
+  //! The callback runs without the runtime locks, so a notification in delivery may still
+  //! arrive after the callback was replaced
+  void setWatermarks(size_t lowFree, size_t highFree, WatermarkCallback callback, void* data);
+
+ private:
+  //! Disable copy constructor
+  MemoryAccounting(const MemoryAccounting&) = delete;
+
+  //! Disable assignment
+  MemoryAccounting& operator=(const MemoryAccounting&) = delete;
+
+  //! Returns the free memory from the runtime counters
+  size_t currentFree() const;
+
+  //! Sends a notification if the free memory crossed a watermark
+  void checkWatermarks();
+
+  enum Level : int { kNormal = 0, kBelowLow = 1, kAboveHigh = 2 };
+
+  const size_t total_;                    //!< Total device memory
+  const QueryFree queryFree_;             //!< Driver query of the free memory
+  const uint64_t interval_;               //!< Reconcile interval in ns, 0 - query every time
+  std::atomic<size_t> allocated_;         //!< Bytes allocated through the runtime
+  std::atomic<int64_t> external_;         //!< Bytes used outside of the runtime
+  std::atomic<uint64_t> lastReconcile_;   //!< Time of the last reconcile
+  std::atomic_flag reconciling_;          //!< A thread queries the driver
+  std::atomic<bool> watermarks_;          //!< The watermark notifications are enabled
+  amd::Monitor watermarkLock_;            //!< Serializes the watermark notifications
+  size_t lowFree_ = 0;                    //!< Low watermark in free bytes
+  size_t highFree_ = 0;                   //!< High watermark in free bytes
+  WatermarkCallback callback_ = nullptr;  //!< Watermark notification
+  void* callbackData_ = nullptr;          //!< User data of the notification
+  Level level_ = kNormal;                 //!< The last crossed watermark
+  size_t levelFree_ = 0;                  //!< Free bytes at the last crossing
+  Level notified_ = kNormal;              //!< The last delivered watermark
+  bool notifying_ = false;                //!< A thread delivers the notifications
+};
+
+}  // namespace amd::device
@@ -0,0 +1,48 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "device/devnuma.hpp"
+#include "utils/debug.hpp"
+#include "utils/flags.hpp"
+
+namespace amd::device {
+
+// ================================================================================================
+uint32_t SelectNumaNode(const std::vector<uint32_t>& distances, int32_t overrideNode) {
+  if (overrideNode >= 0) {
+    if (static_cast<size_t>(overrideNode) < distances.size()) {
+      return static_cast<uint32_t>(overrideNode);
+    }
+    ClPrint(amd::LOG_WARNING, amd::LOG_INIT,
+            "NUMA node %d is out of range (%zu nodes), using the nearest one", overrideNode,
+            distances.size());
+  }
+  uint32_t index = 0;
+  uint32_t distance = kNumaDistanceUnknown;
+  for (uint32_t i = 0; i < distances.size(); i++) {
+    if (distances[i] < distance) {
+      distance = distances[i];
+      index = i;
+    }
+  }
+  return index;
+}
+
+}  // namespace amd::device
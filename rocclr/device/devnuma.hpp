@@ -0,0 +1,39 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+
+#include <limits>
+#include <vector>
+
+namespace amd::device {
+
+//! Link distance of a CPU NUMA node, which the driver couldn't report
+constexpr uint32_t kNumaDistanceUnknown = std::numeric_limits<uint32_t>::max();
+
+//! Selects the CPU NUMA node for the host buffers and the runtime threads of a GPU.
+//! distances holds the link distance from the GPU to every CPU node. A valid override
+//! wins, otherwise the nearest node is selected and the lowest index breaks the ties.
+//! Node 0 is the fallback if no distance is known.
+uint32_t SelectNumaNode(const std::vector<uint32_t>& distances, int32_t overrideNode);
+
+}  // namespace amd::device
@@ -0,0 +1,112 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+#include "thread/monitor.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace amd::device {
+
+//! The queue properties, which a recycled queue must match to serve a new one
+struct QueueTraits {
+  uint32_t priority_;              //!< The queue priority
+  bool profiling_;                 //!< Profiling is enabled on the queue
+  std::vector<uint32_t> cuMask_;   //!< The CU mask of the queue, empty - all CUs
+  bool dedicated_ = false;         //!< The hardware queue isn't shared
+
+  bool operator==(const QueueTraits& rhs) const {
+    return (priority_ == rhs.priority_) && (profiling_ == rhs.profiling_) &&
+           (cuMask_ == rhs.cuMask_) && (dedicated_ == rhs.dedicated_);
+  }
+};
+
+//! Destroyed queues of a device, kept for reuse by the next queue with the same traits.
+//! The pool doesn't own the objects until recycle() accepts them
+template <typename T>
+class QueueRecyclePool : public amd::HeapObject {
+ public:
+  explicit QueueRecyclePool(size_t capacity) : capacity_(capacity) {}
+
+  ~QueueRecyclePool() { assert(entries_.empty() && "Drain the pool before destruction!"); }
+
+  //! Returns a recycled object with the same traits or nullptr. The most recently recycled
+  //! object goes first, since its memory is likely still in the caches
+  T* acquire(const QueueTraits& traits) {
+    amd::ScopedLock lock(lock_);
+    for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+      if (it->first == traits) {
+        T* object = it->second;
+        entries_.erase(std::next(it).base());
+        ++hits_;
+        return object;
+      }
+    }
+    ++misses_;
+    return nullptr;
+  }
+
+  //! Keeps the object for a later acquire(). Returns false if the pool is full,
+  //! then the caller must destroy the object
+  bool recycle(const QueueTraits& traits, T* object) {
+    amd::ScopedLock lock(lock_);
+    if (entries_.size() >= capacity_) {
+      return false;
+    }
+    entries_.emplace_back(traits, object);
+    return true;
+  }
+
+  //! Removes all objects from the pool and passes them to release()
+  template <typename Release> void drain(Release release) {
+    std::vector<std::pair<QueueTraits, T*>> entries;
+    {
+      amd::ScopedLock lock(lock_);
+      entries.swap(entries_);
+    }
+    for (auto& it : entries) {
+      release(it.second);
+    }
+  }
+
+  //! Returns the number of the pooled objects
+  size_t size() const {
+    amd::ScopedLock lock(lock_);
+    return entries_.size();
+  }
+
+  //! Returns the number of acquire() calls served from the pool
+  uint64_t hits() const { return hits_; }
+
+  //! Returns the number of acquire() calls without a matching object
+  uint64_t misses() const { return misses_; }
+
+ private:
+  const size_t capacity_;                                //!< Max number of the pooled objects
+  mutable amd::Monitor lock_{"Queue recycle pool", true};
+  std::vector<std::pair<QueueTraits, T*>> entries_;      //!< Pooled objects, the latest last
+  uint64_t hits_ = 0;                                    //!< Acquires served from the pool
+  uint64_t misses_ = 0;                                  //!< Acquires without a match
+};
+
+}  // namespace amd::device
@@ -0,0 +1,75 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "device/devstreamops.hpp"
+
+namespace amd::device {
+
+// ================================================================================================
+size_t LowerStreamOps(const std::vector<StreamOpKind>& ops, bool cpWait,
+                      StreamOpsLowering* backend) {
+  size_t packets = 0;
+  // The barrier operations are deferred, so they can be merged with each other
+  // and with the release barrier of the next write
+  bool pendingBarrier = false;
+  // The work before the batch isn't released yet
+  bool released = false;
+
+  auto release = [&]() {
+    backend->releaseBarrier();
+    ++packets;
+    pendingBarrier = false;
+    released = true;
+  };
+
+  for (size_t i = 0; i < ops.size(); ++i) {
+    switch (ops[i]) {
+      case StreamOpKind::Barrier:
+        pendingBarrier = true;
+        break;
+      case StreamOpKind::Write:
+        if (pendingBarrier || !released) {
+          release();
+        }
+        backend->writeKernel(i);
+        ++packets;
+        break;
+      case StreamOpKind::SignalWait:
+      case StreamOpKind::Wait:
+        if (pendingBarrier) {
+          release();
+        }
+        if (cpWait && (ops[i] == StreamOpKind::SignalWait)) {
+          backend->waitBarrierValue(i);
+        } else {
+          backend->waitKernel(i);
+        }
+        ++packets;
+        break;
+    }
+  }
+  // A trailing barrier still orders the batch against the following work in the stream
+  if (pendingBarrier) {
+    release();
+  }
+  return packets;
+}
+
+}  // namespace amd::device
@@ -0,0 +1,60 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+
+#include <vector>
+
+namespace amd::device {
+
+//! Kind of a single operation in a batch of stream memory operations
+enum class StreamOpKind : uint32_t {
+  Wait,        //!< Wait on a value in regular memory
+  SignalWait,  //!< Wait on a value in HSA signal memory
+  Write,       //!< Write a value
+  Barrier      //!< Make the preceding writes visible before the following operations
+};
+
+//! The packets a batch of stream memory operations can be lowered to. The backend
+//! dispatches them, the op argument is the index of the operation in the batch
+class StreamOpsLowering {
+ public:
+  virtual ~StreamOpsLowering() {}
+
+  //! Dispatches a barrier packet with system scope release
+  virtual void releaseBarrier() = 0;
+  //! Dispatches a barrier-value packet, which the CP waits on
+  virtual void waitBarrierValue(size_t op) = 0;
+  //! Dispatches the blit kernel, which spins on the value
+  virtual void waitKernel(size_t op) = 0;
+  //! Dispatches the blit kernel, which writes the value
+  virtual void writeKernel(size_t op) = 0;
+};
+
+//! Lowers a batch of stream memory operations to the fewest packets. A run of writes shares
+//! a single release barrier and the adjacent barrier operations are merged with it. The waits
+//! on signal memory use barrier-value packets if cpWait is set, the other waits use the blit
+//! kernel. Returns the number of dispatched packets
+size_t LowerStreamOps(const std::vector<StreamOpKind>& ops, bool cpWait,
+                      StreamOpsLowering* backend);
+
+}  // namespace amd::device
@@ -0,0 +1,82 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "device/devsvmbatch.hpp"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
+
+namespace amd::device {
+
+// ================================================================================================
+std::vector<SvmBatchRun> PlanSvmBatch(const std::vector<SvmBatchRange>& ranges) {
+  // The batch indices of the ranges of each key
+  std::map<uint64_t, std::vector<size_t>> keys;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    if (ranges[i].size_ != 0) {
+      keys[ranges[i].key_].push_back(i);
+    }
+  }
+
+  std::vector<SvmBatchRun> runs;
+  for (const auto& key : keys) {
+    // A range starts at (start, true, index) and ends at (end, false, index)
+    std::vector<std::tuple<uintptr_t, bool, size_t>> events;
+    events.reserve(2 * key.second.size());
+    for (size_t i : key.second) {
+      events.emplace_back(ranges[i].start_, true, i);
+      events.emplace_back(ranges[i].start_ + ranges[i].size_, false, i);
+    }
+    std::sort(events.begin(), events.end());
+
+    // The last range of the batch, which covers the current bytes, sets their value
+    std::set<size_t> active;
+    size_t first = runs.size();
+    uintptr_t position = 0;
+    for (const auto& event : events) {
+      uintptr_t next = std::get<0>(event);
+      if (!active.empty() && next > position) {
+        uint64_t value = ranges[*active.rbegin()].value_;
+        SvmBatchRun* last = (runs.size() > first) ? &runs.back() : nullptr;
+        if ((last != nullptr) && (last->start_ + last->size_ == position) &&
+            (last->value_ == value)) {
+          last->size_ += next - position;
+        } else {
+          runs.push_back({position, next - position, key.first, value});
+        }
+      }
+      position = next;
+      if (std::get<1>(event)) {
+        active.insert(std::get<2>(event));
+      } else {
+        active.erase(std::get<2>(event));
+      }
+    }
+  }
+
+  std::sort(runs.begin(), runs.end(), [](const SvmBatchRun& lhs, const SvmBatchRun& rhs) {
+    return std::tie(lhs.start_, lhs.size_, lhs.key_) < std::tie(rhs.start_, rhs.size_, rhs.key_);
+  });
+  return runs;
+}
+
+}  // namespace amd::device
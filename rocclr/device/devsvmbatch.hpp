@@ -0,0 +1,52 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+
+#include <vector>
+
+namespace amd::device {
+
+//! A range of a batch of SVM prefetches or advices. A later range of the batch overrides
+//! the earlier ones with the same key on the bytes they share
+struct SvmBatchRange {
+  uintptr_t start_;  //!< Start of the range
+  size_t size_;      //!< Size of the range in bytes
+  uint64_t key_;     //!< What the range sets, the ranges with different keys are independent
+  uint64_t value_;   //!< Destination of a prefetch or value of an advice
+};
+
+//! Back to back bytes of the batch with the same key and the same final value
+struct SvmBatchRun {
+  uintptr_t start_;  //!< Start of the run
+  size_t size_;      //!< Size of the run in bytes
+  uint64_t key_;     //!< Key of the ranges, which produced the run
+  uint64_t value_;   //!< Final value of the run
+};
+
+//! Applies the ranges in the batch order and merges the adjacent or overlapping bytes with
+//! the same key and final value into runs. The overridden parts of the ranges are dropped.
+//! The runs are sorted by start, then size and key, so the runs of the different keys over
+//! the same bytes are next to each other
+std::vector<SvmBatchRun> PlanSvmBatch(const std::vector<SvmBatchRange>& ranges);
+
+}  // namespace amd::device
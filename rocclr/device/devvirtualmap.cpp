@@ -0,0 +1,96 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "device/devvirtualmap.hpp"
+
+#include <algorithm>
+
+namespace amd::device {
+
+// ================================================================================================
+bool PlanVirtualMap(std::vector<VirtualMapRange>* ranges, std::vector<VirtualMapRun>* runs,
+                    size_t* failIdx) {
+  runs->clear();
+  for (const auto& range : *ranges) {
+    if (range.ptr_ == nullptr || range.size_ == 0) {
+      *failIdx = range.index_;
+      return false;
+    }
+  }
+  std::sort(ranges->begin(), ranges->end(),
+            [](const VirtualMapRange& lhs, const VirtualMapRange& rhs) {
+              return reinterpret_cast<uintptr_t>(lhs.ptr_) < reinterpret_cast<uintptr_t>(rhs.ptr_);
+            });
+
+  uintptr_t end = 0;
+  for (size_t i = 0; i < ranges->size(); ++i) {
+    const VirtualMapRange& range = (*ranges)[i];
+    uintptr_t start = reinterpret_cast<uintptr_t>(range.ptr_);
+    if (i != 0 && start < end) {
+      // Report the range, which comes later in the caller's batch
+      *failIdx = std::max(range.index_, (*ranges)[i - 1].index_);
+      runs->clear();
+      return false;
+    }
+    if (i != 0 && start == end) {
+      runs->back().count_++;
+    } else {
+      runs->push_back({i, 1});
+    }
+    end = start + range.size_;
+  }
+  return true;
+}
+
+// ================================================================================================
+size_t LowerVirtualMap(const std::vector<VirtualMapRange>& ranges,
+                       const std::vector<VirtualMapRun>& runs, VirtualMapLowering* backend) {
+  // The unmapped memory can't be in use, hence drain the queue once for the whole batch
+  if (std::any_of(ranges.begin(), ranges.end(),
+                  [](const VirtualMapRange& range) { return range.memory_ == nullptr; })) {
+    backend->waitIdle();
+  }
+
+  size_t failed = 0;
+  for (const auto& run : runs) {
+    const VirtualMapRange& first = ranges[run.first_];
+    const VirtualMapRange& last = ranges[run.first_ + run.count_ - 1];
+    size_t size = reinterpret_cast<uintptr_t>(last.ptr_) + last.size_ -
+                  reinterpret_cast<uintptr_t>(first.ptr_);
+    amd::Memory* runReservation = backend->findReservation(first.ptr_, size);
+
+    for (size_t i = run.first_; i < run.first_ + run.count_; ++i) {
+      amd::Memory* reservation = (runReservation != nullptr) ? runReservation :
+          backend->findReservation(ranges[i].ptr_, ranges[i].size_);
+      if (reservation == nullptr) {
+        ++failed;
+        continue;
+      }
+      bool done = (ranges[i].memory_ != nullptr) ? backend->map(i, reservation) :
+                                                    backend->unmap(i);
+      if (!done) {
+        ++failed;
+      }
+    }
+  }
+  return failed;
+}
+
+}  // namespace amd::device
@@ -0,0 +1,78 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+
+#include <vector>
+
+namespace amd {
+class Memory;
+}
+
+namespace amd::device {
+
+//! A single range of a batch of virtual memory map and unmap operations
+struct VirtualMapRange {
+  void* ptr_;            //!< Start of the virtual range
+  size_t size_;          //!< Size of the range in bytes
+  amd::Memory* memory_;  //!< Physical memory to map, nullptr means unmap
+  size_t index_;         //!< Index of the range in the caller's batch
+  //! View of the range, which the caller created or removed from MemObjMap at enqueue time.
+  //! nullptr if the backend updates MemObjMap when the range executes
+  amd::Memory* view_ = nullptr;
+};
+
+//! Back to back ranges of a sorted batch. They share the lookup of the virtual address
+//! reservation, if the run doesn't cross the reservation boundary
+struct VirtualMapRun {
+  size_t first_;  //!< Index of the first range of the run in the sorted batch
+  size_t count_;  //!< Number of the ranges in the run
+};
+
+//! Sorts the ranges by address and coalesces the back to back ones into runs. Returns false
+//! and the caller's index of the range in failIdx if a range is empty or overlaps another one
+bool PlanVirtualMap(std::vector<VirtualMapRange>* ranges, std::vector<VirtualMapRun>* runs,
+                    size_t* failIdx);
+
+//! The operations a planned batch of virtual memory map and unmap is lowered to. The backend
+//! executes them, the range argument is the index of the range in the sorted batch
+class VirtualMapLowering {
+ public:
+  virtual ~VirtualMapLowering() {}
+
+  //! Waits for the preceding work on the queue, before the first range is unmapped
+  virtual void waitIdle() = 0;
+  //! Returns the virtual address reservation, which contains [ptr, ptr + size), or nullptr
+  virtual amd::Memory* findReservation(const void* ptr, size_t size) = 0;
+  //! Maps the physical memory of the range to its addresses in the reservation
+  virtual bool map(size_t range, amd::Memory* reservation) = 0;
+  //! Unmaps the range
+  virtual bool unmap(size_t range) = 0;
+};
+
+//! Executes a planned batch. The queue is drained once if the batch unmaps anything and the
+//! reservation is looked up once per run, a run across several reservations falls back to
+//! a lookup per range. Returns the number of the ranges, which failed
+size_t LowerVirtualMap(const std::vector<VirtualMapRange>& ranges,
+                       const std::vector<VirtualMapRun>& runs, VirtualMapLowering* backend);
+
+}  // namespace amd::device
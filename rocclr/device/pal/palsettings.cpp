@@ -343,6 +343,8 @@ bool Settings::create(const Pal::DeviceProperties& palProp,
   }
   // Enable some platform extensions
   enableExtension(ClAmdDeviceAttributeQuery);
+  enableExtension(ClKhrCommandBuffer);
+  enableExtension(ClKhrCommandBufferMutableDispatch);
 
   if (hwLDSSize_ == 0) {
     // Use hardcoded values for now, since PAL properties aren't available with offline devices
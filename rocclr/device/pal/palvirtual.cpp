@@ -2192,79 +2192,162 @@ void VirtualGPU::submitStreamOperation(amd::StreamOperationCommand& cmd) {
   profilingEnd(cmd);
 }
 
+// ================================================================================================
+void VirtualGPU::submitBatchStreamOperation(amd::BatchStreamOperationCommand& cmd) {
+  // Make sure VirtualGPU has an exclusive access to the resources
+  amd::ScopedLock lock(execution());
+  profilingBegin(cmd);
+
+  for (const auto& op : cmd.operations()) {
+    // The blit kernels are serialized on the queue, so the barriers don't need packets
+    if (op.type_ == ROCCLR_COMMAND_STREAM_MEM_BARRIER) {
+      continue;
+    }
+    Memory* memory = dev().getGpuMemory(op.memory_);
+    bool result = (op.type_ == ROCCLR_COMMAND_STREAM_WAIT_VALUE)
+        ? static_cast<KernelBlitManager&>(blitMgr()).streamOpsWait(*memory, op.value_, op.offset_,
+                                                                    op.sizeBytes_, op.flags_,
+                                                                    op.mask_)
+        : static_cast<KernelBlitManager&>(blitMgr()).streamOpsWrite(*memory, op.value_,
+                                                                     op.offset_, op.sizeBytes_);
+    if (!result) {
+      LogError("submitBatchStreamOperation: Stream operation failed!");
+    }
+  }
+  profilingEnd(cmd);
+}
+
 // ================================================================================================
 void VirtualGPU::submitVirtualMap(amd::VirtualMapCommand& vcmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
   profilingBegin(vcmd);
-  amd::Memory* phys_mem_obj = vcmd.memory();
-  amd::Memory* vaddr_base_obj = amd::MemObjMap::FindVirtualMemObj(vcmd.ptr());
-  if (vaddr_base_obj == nullptr || !(vaddr_base_obj->getMemFlags() & CL_MEM_VA_RANGE_AMD)) {
-    profilingEnd(vcmd);
-    return;
-  }
 
-  // Create a view, since original base obj will map the whole memory and multimap cases wont work.
-  amd::Memory* vaddr_sub_obj = nullptr;
-  size_t vaddr_offset = 0;
-  if (phys_mem_obj != nullptr) {
-    constexpr bool kParent = false;
-    vaddr_sub_obj = phys_mem_obj->getContext().devices()[0]->CreateVirtualBuffer(
-                      phys_mem_obj->getContext(), const_cast<void*>(vcmd.ptr()),
-                      vcmd.size(), phys_mem_obj->getUserData().deviceId, kParent);
-
-    // Calculate the offset from the original pointer.
-    vaddr_offset = (reinterpret_cast<address>(vaddr_sub_obj->getSvmPtr())
-                     - reinterpret_cast<address>(vaddr_base_obj->getSvmPtr()));
-  }
-
-  // The imem() in the backend is shared between base and sub/view object.
-  pal::Memory* vaddr_pal_mem = dev().getGpuMemory(vaddr_base_obj);
-  Pal::IGpuMemory* phymem_igpu_mem = (phys_mem_obj == nullptr) ?
-      nullptr : dev().getGpuMemory(phys_mem_obj)->iMem();
-
-  Pal::VirtualMemoryRemapRange range{
-    vaddr_pal_mem->iMem(),
-    vaddr_offset,
-    phymem_igpu_mem,
-    0,
-    vcmd.size(),
-    Pal::VirtualGpuMemAccessMode::NoAccess
-  };
-
-  // Wait for previous operations before unmap
-  if (phys_mem_obj == nullptr) {
-    // @note: Need to verify if compute requires a wait or IB flush is enough
-    WaitForIdleCompute();
-    WaitForIdleSdma();
-  }
-
-  eventBegin(MainEngine);
-  auto result = queue(MainEngine).iQueue_->RemapVirtualMemoryPages(1, &range, false, nullptr);
-  // Capture GPU event for the paging operation
-  GpuEvent event;
-  eventEnd(MainEngine, event);
-  setGpuEvent(event);
-  if (result == Pal::Result::Success) {
-    if (phys_mem_obj != nullptr) {
-      // assert the vaddr_mem_obj wasn't mapped already
-      assert(amd::MemObjMap::FindMemObj(vcmd.ptr()) == nullptr);
-      amd::MemObjMap::AddMemObj(vcmd.ptr(), vaddr_sub_obj);
-      vaddr_sub_obj->getUserData().phys_mem_obj = phys_mem_obj;
-      phys_mem_obj->getUserData().vaddr_mem_obj = vaddr_sub_obj;
-    } else {
-      // assert the vaddr_mem_obj is mapped and needs to be removed
-      amd::Memory* vaddr_sub_obj = amd::MemObjMap::FindMemObj(vcmd.ptr());
-      assert(vaddr_sub_obj != nullptr);
-      assert(vcmd.ptr() == vaddr_sub_obj->getSvmPtr());
+  // Collects the remap ranges of the batch, PAL remaps all of them in a single call
+  class Lowering : public amd::device::VirtualMapLowering {
+   public:
+    Lowering(VirtualGPU& gpu, const std::vector<amd::VirtualMapCommand::Range>& ranges)
+        : gpu_(gpu), ranges_(ranges) {}
+
+    void waitIdle() override {
+      // Wait for previous operations before unmap
+      // @note: Need to verify if compute requires a wait or IB flush is enough
+      gpu_.WaitForIdleCompute();
+      gpu_.WaitForIdleSdma();
+    }
+
+    amd::Memory* findReservation(const void* ptr, size_t size) override {
+      amd::Memory* vaddr_base_obj = amd::MemObjMap::FindVirtualMemObj(ptr);
+      if (vaddr_base_obj == nullptr || !(vaddr_base_obj->getMemFlags() & CL_MEM_VA_RANGE_AMD)) {
+        return nullptr;
+      }
+      const_address base = reinterpret_cast<const_address>(vaddr_base_obj->getSvmPtr());
+      if (reinterpret_cast<const_address>(ptr) + size > base + vaddr_base_obj->getSize()) {
+        return nullptr;
+      }
+      return vaddr_base_obj;
+    }
 
-      amd::MemObjMap::RemoveMemObj(vcmd.ptr());
-      if (vaddr_sub_obj->getUserData().phys_mem_obj != nullptr) {
-        vaddr_sub_obj->getUserData().phys_mem_obj->getUserData().vaddr_mem_obj = nullptr;
-        vaddr_sub_obj->getUserData().phys_mem_obj = nullptr;
+    bool map(size_t range, amd::Memory* reservation) override {
+      const auto& vrange = ranges_[range];
+      amd::Memory* phys_mem_obj = vrange.memory_;
+      // Create a view, since original base obj will map the whole memory and multimap cases
+      // wont work.
+      amd::Memory* vaddr_sub_obj = vrange.view_;
+      if (vaddr_sub_obj == nullptr) {
+        constexpr bool kParent = false;
+        vaddr_sub_obj = phys_mem_obj->getContext().devices()[0]->CreateVirtualBuffer(
+                        phys_mem_obj->getContext(), vrange.ptr_,
+                        vrange.size_, phys_mem_obj->getUserData().deviceId, kParent);
       }
+      add(range, reservation, gpu_.dev().getGpuMemory(phys_mem_obj)->iMem(), vaddr_sub_obj);
+      return true;
+    }
+
+    bool unmap(size_t range) override {
+      add(range, amd::MemObjMap::FindVirtualMemObj(ranges_[range].ptr_), nullptr, nullptr);
+      return true;
     }
+
+    //! Remaps the collected ranges and updates the mappings of the virtual addresses
+    bool remap() {
+      if (remap_.empty()) {
+        return true;
+      }
+      gpu_.eventBegin(MainEngine);
+      auto result = gpu_.queue(MainEngine).iQueue_->RemapVirtualMemoryPages(
+          static_cast<uint32_t>(remap_.size()), remap_.data(), false, nullptr);
+      // Capture GPU event for the paging operation
+      GpuEvent event;
+      gpu_.eventEnd(MainEngine, event);
+      gpu_.setGpuEvent(event);
+      if (result != Pal::Result::Success) {
+        // Withdraw the mappings the caller published at enqueue time
+        for (size_t i = 0; i < remap_.size(); ++i) {
+          const auto& vrange = ranges_[rangeIdx_[i]];
+          if ((vrange.view_ != nullptr) && (vrange.memory_ != nullptr)) {
+            amd::MemObjMap::RemoveMemObj(vrange.ptr_);
+            vrange.memory_->getUserData().vaddr_mem_obj = nullptr;
+            vrange.view_->getUserData().phys_mem_obj = nullptr;
+          }
+        }
+        return false;
+      }
+
+      for (size_t i = 0; i < remap_.size(); ++i) {
+        const auto& vrange = ranges_[rangeIdx_[i]];
+        amd::Memory* vaddr_sub_obj = subObjs_[i];
+        if (vrange.view_ != nullptr) {
+          // The caller updated MemObjMap at enqueue time
+          continue;
+        }
+        if (vaddr_sub_obj != nullptr) {
+          // assert the vaddr_mem_obj wasn't mapped already
+          assert(amd::MemObjMap::FindMemObj(vrange.ptr_) == nullptr);
+          amd::MemObjMap::AddMemObj(vrange.ptr_, vaddr_sub_obj);
+          vaddr_sub_obj->getUserData().phys_mem_obj = vrange.memory_;
+          vrange.memory_->getUserData().vaddr_mem_obj = vaddr_sub_obj;
+        } else {
+          // assert the vaddr_mem_obj is mapped and needs to be removed
+          vaddr_sub_obj = amd::MemObjMap::FindMemObj(vrange.ptr_);
+          assert(vaddr_sub_obj != nullptr);
+          assert(vrange.ptr_ == vaddr_sub_obj->getSvmPtr());
+
+          amd::MemObjMap::RemoveMemObj(vrange.ptr_);
+          if (vaddr_sub_obj->getUserData().phys_mem_obj != nullptr) {
+            vaddr_sub_obj->getUserData().phys_mem_obj->getUserData().vaddr_mem_obj = nullptr;
+            vaddr_sub_obj->getUserData().phys_mem_obj = nullptr;
+          }
+        }
+      }
+      return true;
+    }
+
+   private:
+    void add(size_t range, amd::Memory* reservation, Pal::IGpuMemory* phys_mem,
+             amd::Memory* vaddr_sub_obj) {
+      // The imem() in the backend is shared between base and sub/view object.
+      pal::Memory* vaddr_pal_mem = gpu_.dev().getGpuMemory(reservation);
+      // Calculate the offset from the original pointer.
+      size_t vaddr_offset = reinterpret_cast<address>(ranges_[range].ptr_) -
+                            reinterpret_cast<address>(reservation->getSvmPtr());
+      remap_.push_back({vaddr_pal_mem->iMem(), vaddr_offset, phys_mem, 0, ranges_[range].size_,
+                        Pal::VirtualGpuMemAccessMode::NoAccess});
+      rangeIdx_.push_back(range);
+      subObjs_.push_back(vaddr_sub_obj);
+    }
+
+    VirtualGPU& gpu_;
+    const std::vector<amd::VirtualMapCommand::Range>& ranges_;
+    std::vector<Pal::VirtualMemoryRemapRange> remap_;  //!< PAL ranges of the batch
+    std::vector<size_t> rangeIdx_;                     //!< Batch range of each PAL range
+    std::vector<amd::Memory*> subObjs_;                //!< New views of the mapped ranges
+  } lowering(*this, vcmd.ranges());
+
+  amd::device::LowerVirtualMap(vcmd.ranges(), vcmd.runs(), &lowering);
+  if (!lowering.remap()) {
+    LogError("PAL RemapVirtualMemoryPages failed!");
   }
   profilingEnd(vcmd);
 }
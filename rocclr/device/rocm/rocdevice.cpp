@@ -33,6 +33,7 @@
 #include "vdi_common.hpp"
 #include "device/comgrctx.hpp"
 #include "device/devhostcall.hpp"
+#include "device/devnuma.hpp"
 #include "device/rocm/rocdevice.hpp"
 #include "device/rocm/rocblit.hpp"
 #include "device/rocm/rocvirtual.hpp"
@@ -180,12 +181,13 @@ Device::Device(hsa_agent_t bkendDevice)
     , xferQueue_(nullptr)
     , xferRead_(nullptr)
     , xferWrite_(nullptr)
-    , freeMem_(0)
+    , memAccounting_(nullptr)
     , vgpusAccess_("Virtual GPU List Ops Lock", true)
     , hsa_exclusive_gpu_access_(false)
     , queuePool_(QueuePriority::Total)
     , coopHostcallBuffer_(nullptr)
     , queueWithCUMaskPool_(QueuePriority::Total)
+    , recycledVgpus_(ROC_QUEUE_RECYCLE_POOL_SIZE)
     , numOfVgpus_(0)
     , preferred_numa_node_(0)
     , maxSdmaReadMask_(0)
@@ -203,19 +205,18 @@ Device::Device(hsa_agent_t bkendDevice)
 }
 
 void Device::setupCpuAgent() {
-  int32_t numaDistance = std::numeric_limits<int32_t>::max();
-  uint32_t index = 0; // 0 as default
-  auto size = cpu_agents_.size();
-  for (uint32_t i = 0; i < size; i++) {
+  std::vector<uint32_t> distances(cpu_agents_.size(), device::kNumaDistanceUnknown);
+  for (uint32_t i = 0; i < cpu_agents_.size(); i++) {
     std::vector<amd::Device::LinkAttrType> link_attrs;
     link_attrs.push_back(std::make_pair(LinkAttribute::kLinkDistance, 0));
-    if (findLinkInfo(cpu_agents_[i].fine_grain_pool, &link_attrs)) {
-      if (link_attrs[0].second < numaDistance) {
-        numaDistance = link_attrs[0].second;
-        index = i;
-      }
+    if (findLinkInfo(cpu_agents_[i].fine_grain_pool, &link_attrs) &&
+        (link_attrs[0].second >= 0)) {
+      distances[i] = link_attrs[0].second;
     }
   }
+  // All host pools below come from the selected node, so the staging, kernarg and hostcall
+  // buffers stay local to the threads, which run on the same node
+  uint32_t index = device::SelectNumaNode(distances, ROC_PREFERRED_NUMA_NODE);
   std::vector<amd::Device::LinkAttrType> link_attrs;
   link_attrs.push_back(std::make_pair(LinkAttribute::kLinkLinkType, 0));
   if (findLinkInfo(cpu_agents_[0].fine_grain_pool, &link_attrs)) {
@@ -243,6 +244,9 @@ void Device::checkAtomicSupport() {
 }
 
 Device::~Device() {
+  // Destroy the recycled virtual GPUs, before their HSA queues go away
+  recycledVgpus_.drain([](VirtualGPU* vgpu) { delete vgpu; });
+
   if (coopHostcallBuffer_) {
     amd::disableHostcalls(coopHostcallBuffer_);
     context().svmFree(coopHostcallBuffer_);
@@ -256,6 +260,7 @@ Device::~Device() {
   }
   delete mapCache_;
   delete mapCacheOps_;
+  delete memAccounting_;
 
   if (nullptr != p2p_stage_) {
     p2p_stage_->release();
@@ -1423,7 +1428,9 @@ bool Device::populateOCLDeviceConstants() {
     }
   }
 
-  freeMem_ = info_.globalMemSize_;
+  memAccounting_ = new device::MemoryAccounting(
+      info_.globalMemSize_, [this](size_t* freeBytes) { return queryFreeMemory(freeBytes); },
+      static_cast<uint64_t>(HIP_MEMINFO_RECONCILE_INTERVAL) * 1000 * 1000);
 
   // Make sure the max allocation size is not larger than the available memory size.
   info_.maxMemAllocSize_ = std::min(info_.maxMemAllocSize_, info_.globalMemSize_);
@@ -1713,6 +1720,24 @@ bool Device::populateOCLDeviceConstants() {
     }
 
     info_.maxThreadsPerCU_ = info_.wavefrontWidth_ * max_waves_per_cu;
+
+    // The topology is only used for the CU partitioning, so keep a single die layout
+    // if the runtime can't report it
+    uint32_t num_shader_engines = 1;
+    if (HSA_STATUS_SUCCESS !=
+        hsa_agent_get_info(bkendDevice_,
+                           static_cast<hsa_agent_info_t>(HSA_AMD_AGENT_INFO_NUM_SHADER_ENGINES),
+                           &num_shader_engines)) {
+      num_shader_engines = 1;
+    }
+    info_.numberOfShaderEngines = num_shader_engines;
+    uint32_t num_xcc = 1;
+    if (HSA_STATUS_SUCCESS !=
+        hsa_agent_get_info(bkendDevice_, static_cast<hsa_agent_info_t>(HSA_AMD_AGENT_INFO_NUM_XCC),
+                           &num_xcc) || (num_xcc == 0)) {
+      num_xcc = 1;
+    }
+    info_.numberOfXccs = num_xcc;
     uint32_t cache_sizes[4];
     /* FIXIT [skudchad] -  Seems like hardcoded in HSA backend so 0*/
     if (HSA_STATUS_SUCCESS !=
@@ -1911,12 +1936,25 @@ device::VirtualDevice* Device::createVirtualDevice(amd::CommandQueue* queue) {
   // queue creation time.
   const std::vector<uint32_t> defaultCuMask = {};
   bool q = (queue != nullptr);
+  if (q) {
+    // Reuse the virtual GPU of a terminated queue with the same traits
+    const amd::device::QueueTraits traits = {static_cast<uint32_t>(queue->priority()),
+                                             profiling, queue->cuMask(),
+                                             queue->dedicatedQueue()};
+    VirtualGPU* recycled = recycledVgpus_.acquire(traits);
+    if (recycled != nullptr) {
+      ClPrint(amd::LOG_INFO, amd::LOG_QUEUE, "Reusing virtual GPU %p", recycled);
+      return recycled;
+    }
+  }
   VirtualGPU* virtualDevice = new VirtualGPU(*this, profiling, cooperative,
                                             q ? queue->cuMask() : defaultCuMask,
                                             q ? queue->priority()
-                                              : amd::CommandQueue::Priority::Normal);
+                                              : amd::CommandQueue::Priority::Normal,
+                                            q && queue->dedicatedQueue());
 
-  if (!virtualDevice->create()) {
+  // The internal queue serves the device blits, hence it creates all resources upfront
+  if (!virtualDevice->create(q && ROC_LAZY_QUEUE_RESOURCES)) {
     delete virtualDevice;
     return nullptr;
   }
@@ -1924,9 +1962,17 @@ device::VirtualDevice* Device::createVirtualDevice(amd::CommandQueue* queue) {
   return virtualDevice;
 }
 
-bool Device::globalFreeMemory(size_t* freeMemory) const {
-  const uint TotalFreeMemory = 0;
-  const uint LargestFreeBlock = 1;
+// ================================================================================================
+void Device::releaseVirtualDevice(device::VirtualDevice* vdev) const {
+  VirtualGPU* vgpu = static_cast<VirtualGPU*>(vdev);
+  // Note: recycle() waits for the queue to become idle, hence it runs outside of the locks
+  if ((ROC_QUEUE_RECYCLE_POOL_SIZE == 0) || !vgpu->recycle() ||
+      !recycledVgpus_.recycle(vgpu->traits(), vgpu)) {
+    delete vgpu;
+  }
+}
+
+bool Device::queryFreeMemory(size_t* freeBytes) const {
   uint64_t globalAvailMemory;
   // Queries memory available in bytes across all global pools owned by the agent
   if (HSA_STATUS_SUCCESS !=
@@ -1936,8 +1982,25 @@ bool Device::globalFreeMemory(size_t* freeMemory) const {
     LogError("HSA_AMD_AGENT_INFO_MEMORY_AVAIL query failed.");
     return false;
   }
+  *freeBytes = static_cast<size_t>(globalAvailMemory);
+  return true;
+}
 
-  globalAvailMemory = globalAvailMemory / Ki;
+bool Device::globalFreeMemory(size_t* freeMemory) const {
+  const uint TotalFreeMemory = 0;
+  const uint LargestFreeBlock = 1;
+  size_t availMemory;
+  // The runtime accounting reconciles with the driver only at HIP_MEMINFO_RECONCILE_INTERVAL.
+  // It's created with the device info, so query the driver before that
+  if (memAccounting_ != nullptr) {
+    if (!memAccounting_->freeMemory(&availMemory)) {
+      return false;
+    }
+  } else if (!queryFreeMemory(&availMemory)) {
+    return false;
+  }
+
+  uint64_t globalAvailMemory = availMemory / Ki;
   if (globalAvailMemory > HIP_HIDDEN_FREE_MEM * Ki) {
     globalAvailMemory -= HIP_HIDDEN_FREE_MEM * Ki;
   } else {
@@ -2395,23 +2458,16 @@ void Device::memFree(void* ptr, size_t size) const {
 }
 
 void Device::updateFreeMemory(size_t size, bool free) {
+  if (memAccounting_ == nullptr) {
+    return;
+  }
   if (free) {
-    freeMem_ += size;
-  }
-  else {
-    if (size > freeMem_) {
-      // To avoid underflow of the freeMem_
-      // This can happen if the free mem tracked is inaccurate, as some allocations can happen
-      // directly via ROCr
-      ClPrint(amd::LOG_ERROR, amd::LOG_ALWAYS,
-             "Free memory set to zero on device 0x%lx, requested size = 0x%zx, freeMem_ = 0x%zx",
-             this, size, freeMem_.load());
-      freeMem_ = 0;
-      return;
-    }
-    freeMem_ -= size;
+    memAccounting_->release(size);
+  } else {
+    memAccounting_->allocate(size);
   }
-  ClPrint(amd::LOG_INFO, amd::LOG_MEM, "Device=0x%lx, freeMem_ = 0x%zx", this, freeMem_.load());
+  ClPrint(amd::LOG_INFO, amd::LOG_MEM, "Device=0x%lx, allocated = 0x%zx", this,
+          memAccounting_->allocated());
 }
 
 // ================================================================================================
@@ -2593,9 +2649,8 @@ amd::Memory* Device::ImportShareableVMMHandle(void* osHandle) {
 }
 
 // ================================================================================================
-bool Device::SetSvmAttributesInt(const void* dev_ptr, size_t count,
-                              amd::MemoryAdvice advice, bool first_alloc, bool use_cpu) const {
-  if ((settings().hmmFlags_ & Settings::Hmm::EnableSvmTracking) && !first_alloc) {
+bool Device::ValidateSvmRange(const void* dev_ptr, size_t count) const {
+  if (settings().hmmFlags_ & Settings::Hmm::EnableSvmTracking) {
     amd::Memory* svm_mem = amd::MemObjMap::FindMemObj(dev_ptr);
     if ((nullptr == svm_mem) || ((svm_mem->getMemFlags() & CL_MEM_ALLOC_HOST_PTR) == 0) ||
         // Validate the range of provided memory
@@ -2605,63 +2660,80 @@ bool Device::SetSvmAttributesInt(const void* dev_ptr, size_t count,
       return false;
     }
   }
-  if (info().hmmSupported_) {
-    std::vector<hsa_amd_svm_attribute_pair_t> attr;
+  return true;
+}
 
-    switch (advice) {
-      case amd::MemoryAdvice::SetReadMostly:
-        attr.push_back({HSA_AMD_SVM_ATTRIB_READ_MOSTLY, true});
-        break;
-      case amd::MemoryAdvice::UnsetReadMostly:
-        attr.push_back({HSA_AMD_SVM_ATTRIB_READ_MOSTLY, false});
-        break;
-      case amd::MemoryAdvice::SetPreferredLocation:
-        if (use_cpu) {
-          attr.push_back({HSA_AMD_SVM_ATTRIB_PREFERRED_LOCATION, getCpuAgent().handle});
-        } else {
-          attr.push_back({HSA_AMD_SVM_ATTRIB_PREFERRED_LOCATION, getBackendDevice().handle});
-        }
-        break;
-      case amd::MemoryAdvice::UnsetPreferredLocation:
-        // @note: 0 may cause a failure on old runtimes
-        attr.push_back({HSA_AMD_SVM_ATTRIB_PREFERRED_LOCATION, 0});
-        break;
-      case amd::MemoryAdvice::SetAccessedBy: {
-        const uint64_t attrib = (first_alloc) ? HSA_AMD_SVM_ATTRIB_AGENT_ACCESSIBLE :
-                                                HSA_AMD_SVM_ATTRIB_AGENT_ACCESSIBLE_IN_PLACE;
-        if (use_cpu) {
-          attr.push_back({attrib, getCpuAgent().handle});
-        } else {
-          if (first_alloc) {
-            // Provide access to all possible devices.
-            //! @note: HMM should support automatic page table update with xnack enabled,
-            //! but currently it doesn't and runtime explicitly enables access from all devices
-            for (const auto dev : devices()) {
-              // Skip null devices
-              if (static_cast<Device*>(dev)->getBackendDevice().handle != 0) {
-                attr.push_back({attrib, static_cast<Device*>(dev)->getBackendDevice().handle});
-              }
+// ================================================================================================
+bool Device::AddSvmAttributes(amd::MemoryAdvice advice, bool first_alloc, bool use_cpu,
+                              std::vector<hsa_amd_svm_attribute_pair_t>* attr) const {
+  switch (advice) {
+    case amd::MemoryAdvice::SetReadMostly:
+      attr->push_back({HSA_AMD_SVM_ATTRIB_READ_MOSTLY, true});
+      break;
+    case amd::MemoryAdvice::UnsetReadMostly:
+      attr->push_back({HSA_AMD_SVM_ATTRIB_READ_MOSTLY, false});
+      break;
+    case amd::MemoryAdvice::SetPreferredLocation:
+      if (use_cpu) {
+        attr->push_back({HSA_AMD_SVM_ATTRIB_PREFERRED_LOCATION, getCpuAgent().handle});
+      } else {
+        attr->push_back({HSA_AMD_SVM_ATTRIB_PREFERRED_LOCATION, getBackendDevice().handle});
+      }
+      break;
+    case amd::MemoryAdvice::UnsetPreferredLocation:
+      // @note: 0 may cause a failure on old runtimes
+      attr->push_back({HSA_AMD_SVM_ATTRIB_PREFERRED_LOCATION, 0});
+      break;
+    case amd::MemoryAdvice::SetAccessedBy: {
+      const uint64_t attrib = (first_alloc) ? HSA_AMD_SVM_ATTRIB_AGENT_ACCESSIBLE :
+                                              HSA_AMD_SVM_ATTRIB_AGENT_ACCESSIBLE_IN_PLACE;
+      if (use_cpu) {
+        attr->push_back({attrib, getCpuAgent().handle});
+      } else {
+        if (first_alloc) {
+          // Provide access to all possible devices.
+          //! @note: HMM should support automatic page table update with xnack enabled,
+          //! but currently it doesn't and runtime explicitly enables access from all devices
+          for (const auto dev : devices()) {
+            // Skip null devices
+            if (static_cast<Device*>(dev)->getBackendDevice().handle != 0) {
+              attr->push_back({attrib, static_cast<Device*>(dev)->getBackendDevice().handle});
             }
-          } else {
-            attr.push_back({attrib, getBackendDevice().handle});
           }
+        } else {
+          attr->push_back({attrib, getBackendDevice().handle});
         }
-        break;
       }
-      case amd::MemoryAdvice::UnsetAccessedBy:
-        // When unsetting we should use HSA_AMD_SVM_ATTRIB_AGENT_ACCESSIBLE for the agent
-        attr.push_back({HSA_AMD_SVM_ATTRIB_AGENT_ACCESSIBLE, getBackendDevice().handle});
-        break;
-      case amd::MemoryAdvice::SetCoarseGrain:
-        attr.push_back({HSA_AMD_SVM_ATTRIB_GLOBAL_FLAG, HSA_AMD_SVM_GLOBAL_FLAG_COARSE_GRAINED});
-        break;
-      case amd::MemoryAdvice::UnsetCoarseGrain:
-        attr.push_back({HSA_AMD_SVM_ATTRIB_GLOBAL_FLAG, HSA_AMD_SVM_GLOBAL_FLAG_FINE_GRAINED});
-        break;
-      default:
-        return false;
       break;
     }
+    case amd::MemoryAdvice::UnsetAccessedBy:
+      // When unsetting we should use HSA_AMD_SVM_ATTRIB_AGENT_ACCESSIBLE for the agent
+      attr->push_back({HSA_AMD_SVM_ATTRIB_AGENT_ACCESSIBLE, getBackendDevice().handle});
+      break;
+    case amd::MemoryAdvice::SetCoarseGrain:
+      attr->push_back({HSA_AMD_SVM_ATTRIB_GLOBAL_FLAG, HSA_AMD_SVM_GLOBAL_FLAG_COARSE_GRAINED});
+      break;
+    case amd::MemoryAdvice::UnsetCoarseGrain:
+      attr->push_back({HSA_AMD_SVM_ATTRIB_GLOBAL_FLAG, HSA_AMD_SVM_GLOBAL_FLAG_FINE_GRAINED});
+      break;
+    default:
+      return false;
+    break;
+  }
+  return true;
+}
+
+// ================================================================================================
+bool Device::SetSvmAttributesInt(const void* dev_ptr, size_t count,
+                              amd::MemoryAdvice advice, bool first_alloc, bool use_cpu) const {
+  if (!first_alloc && !ValidateSvmRange(dev_ptr, count)) {
+    return false;
+  }
+  if (info().hmmSupported_) {
+    std::vector<hsa_amd_svm_attribute_pair_t> attr;
+    if (!AddSvmAttributes(advice, first_alloc, use_cpu, &attr)) {
+      return false;
+    }
 
     hsa_status_t status = hsa_amd_svm_attributes_set(const_cast<void*>(dev_ptr), count,
                                                     attr.data(), attr.size());
@@ -2682,6 +2754,38 @@ bool Device::SetSvmAttributes(const void* dev_ptr, size_t count,
   return SetSvmAttributesInt(dev_ptr, count, advice, kFirstAlloc, use_cpu);
 }
 
+// ================================================================================================
+bool Device::SetSvmAttributes(const void* dev_ptr, size_t count,
+                              const std::vector<amd::SvmAdvice>& advices) const {
+  if (!ValidateSvmRange(dev_ptr, count)) {
+    return false;
+  }
+  if (info().hmmSupported_) {
+    constexpr bool kFirstAlloc = false;
+    std::vector<hsa_amd_svm_attribute_pair_t> attr;
+    for (const auto& advice : advices) {
+      // The device specific attributes use the agent of the device the advice refers to
+      const Device* dev = (advice.device_ != nullptr) ?
+                          static_cast<const Device*>(advice.device_) : this;
+      if (!dev->AddSvmAttributes(advice.advice_, kFirstAlloc, advice.device_ == nullptr,
+                                 &attr)) {
+        return false;
+      }
+    }
+
+    hsa_status_t status = hsa_amd_svm_attributes_set(const_cast<void*>(dev_ptr), count,
+                                                    attr.data(), attr.size());
+    if (status != HSA_STATUS_SUCCESS) {
+      LogPrintfError("hsa_amd_svm_attributes_set() failed. Advices: %zu, status: %d",
+                     advices.size(), status);
+      return false;
+    }
+  } else {
+    LogWarning("hsa_amd_svm_attributes_set() is ignored, because no HMM support");
+  }
+  return true;
+}
+
 // ================================================================================================
 bool Device::GetSvmAttributes(void** data, size_t* data_sizes, int* attributes,
                               size_t num_attributes, const void* dev_ptr, size_t count) const {
@@ -3037,7 +3141,7 @@ hsa_queue_t* Device::getQueueFromPool(const uint qIndex) {
 
 hsa_queue_t* Device::acquireQueue(uint32_t queue_size_hint, bool coop_queue,
                                   const std::vector<uint32_t>& cuMask,
-                                  amd::CommandQueue::Priority priority) {
+                                  amd::CommandQueue::Priority priority, bool dedicated) {
   assert(queuePool_[QueuePriority::Low].size() <= GPU_MAX_HW_QUEUES ||
          queuePool_[QueuePriority::Normal].size() <= GPU_MAX_HW_QUEUES ||
          queuePool_[QueuePriority::High].size() <= GPU_MAX_HW_QUEUES);
@@ -3070,7 +3174,7 @@ hsa_queue_t* Device::acquireQueue(uint32_t queue_size_hint, bool coop_queue,
   // If we have reached the max number of queues, reuse an existing queue with the matching queue priority,
   // choosing the one with the least number of users.
   // Note: Don't attempt to reuse the cooperative queue, since it's single per device
-  if (!coop_queue && (cuMask.size() == 0) &&
+  if (!coop_queue && (cuMask.size() == 0) && !dedicated &&
       ((queuePool_[qIndex].size() == GPU_MAX_HW_QUEUES) || queuePool_[qIndex].size() > 0)) {
     hsa_queue_t* queue = getQueueFromPool(qIndex);
     if (queue != nullptr) {
@@ -3102,7 +3206,7 @@ hsa_queue_t* Device::acquireQueue(uint32_t queue_size_hint, bool coop_queue,
     queue_size >>= 1;
     if (queue_size < 64) {
       // if a queue with the same requested priority available from the pool, returns it here
-      if (!coop_queue && (cuMask.size() == 0) && (queuePool_[qIndex].size() > 0)) {
+      if (!coop_queue && (cuMask.size() == 0) && !dedicated && (queuePool_[qIndex].size() > 0)) {
         return getQueueFromPool(qIndex);
       }
       DevLogError("Device::acquireQueue: hsa_queue_create failed!");
@@ -3204,6 +3308,16 @@ hsa_queue_t* Device::acquireQueue(uint32_t queue_size_hint, bool coop_queue,
     }
   }
 
+  if (dedicated) {
+    // The dedicated queues stay out of the shared pool, so no other queue can reuse them
+    auto result = queueWithCUMaskPool_[qIndex].emplace(std::make_pair(queue, QueueInfo()));
+    assert(result.second && "QueueInfo already exists");
+    result.first->second.refCount = 1;
+    ClPrint(amd::LOG_INFO, amd::LOG_QUEUE, "Created dedicated hardware queue %p",
+            queue->base_address);
+    return queue;
+  }
+
   if (coop_queue) {
     // Skip queue recycling for cooperative queues, since it should be just one
     // per device.
@@ -3218,8 +3332,10 @@ hsa_queue_t* Device::acquireQueue(uint32_t queue_size_hint, bool coop_queue,
   return queue;
 }
 
-void Device::releaseQueue(hsa_queue_t* queue, const std::vector<uint32_t>& cuMask, bool coop_queue) {
-  for (auto& it : cuMask.size() == 0 ? queuePool_ : queueWithCUMaskPool_) {
+void Device::releaseQueue(hsa_queue_t* queue, const std::vector<uint32_t>& cuMask, bool coop_queue,
+                          bool dedicated) {
+  const bool shared = cuMask.empty() && !dedicated;
+  for (auto& it : shared ? queuePool_ : queueWithCUMaskPool_) {
     auto qIter = it.find(queue);
     if (qIter != it.end()) {
       auto &qInfo = qIter->second;
@@ -3227,10 +3343,10 @@ void Device::releaseQueue(hsa_queue_t* queue, const std::vector<uint32_t>& cuMas
       qInfo.refCount--;
       ClPrint(amd::LOG_INFO, amd::LOG_QUEUE, "releaseQueue refCount:%p (%d)",
               qIter->first->base_address, qIter->second.refCount);
-      // hsa queues with cumask set are not being reused. Hence, if the app uses multiple
-      // such queues it can cause memory leak and those must be destroyed here once the
-      // refcount reaches 0.
-      if ((!cuMask.empty()) && (qInfo.refCount == 0)) {
+      // hsa queues with cumask set and dedicated queues are not being reused. Hence, if the app
+      // uses multiple such queues it can cause memory leak and those must be destroyed here once
+      // the refcount reaches 0.
+      if (!shared && (qInfo.refCount == 0)) {
         if (qInfo.hostcallBuffer_) {
           ClPrint(amd::LOG_INFO, amd::LOG_QUEUE,
                   "Deleting hostcall buffer %p for hardware queue %p",
@@ -3254,17 +3370,18 @@ void Device::releaseQueue(hsa_queue_t* queue, const std::vector<uint32_t>& cuMas
 }
 
 void* Device::getOrCreateHostcallBuffer(hsa_queue_t* queue, bool coop_queue,
-                                        const std::vector<uint32_t>& cuMask) {
+                                        const std::vector<uint32_t>& cuMask, bool dedicated) {
   decltype(queuePool_)::value_type::iterator qIter;
+  const bool shared = cuMask.empty() && !dedicated;
 
   if (!coop_queue) {
-    for (auto &it : cuMask.size() == 0 ? queuePool_ : queueWithCUMaskPool_) {
+    for (auto &it : shared ? queuePool_ : queueWithCUMaskPool_) {
       qIter = it.find(queue);
       if (qIter != it.end()) {
         break;
       }
     }
-    if (cuMask.size() == 0) {
+    if (shared) {
       assert(qIter != queuePool_[QueuePriority::High].end());
     } else {
       assert(qIter != queueWithCUMaskPool_[QueuePriority::High].end());
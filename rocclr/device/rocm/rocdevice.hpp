@@ -25,6 +25,7 @@
 #include "top.hpp"
 #include "CL/cl.h"
 #include "device/device.hpp"
+#include "device/devrecyclepool.hpp"
 #include "platform/command.hpp"
 #include "platform/program.hpp"
 #include "platform/perfctr.hpp"
@@ -410,6 +411,9 @@ class Device : public NullDevice {
   //! Instantiate a new virtual device
   virtual device::VirtualDevice* createVirtualDevice(amd::CommandQueue* queue = nullptr);
 
+  //! Keeps the virtual device of a terminated queue for reuse or destroys it
+  virtual void releaseVirtualDevice(device::VirtualDevice* vdev) const;
+
   //! Construct an HSAIL program object from the ELF assuming it is valid
   virtual device::Program* createProgram(amd::Program& owner, amd::option::Options* options = nullptr);
 
@@ -454,6 +458,9 @@ class Device : public NullDevice {
   //! Gets free memory on a GPU device
   virtual bool globalFreeMemory(size_t* freeMemory) const;
 
+  //! Queries the free memory in bytes from the driver
+  bool queryFreeMemory(size_t* freeBytes) const;
+
   virtual void* hostAlloc(size_t size, size_t alignment,
                           MemorySegment mem_seg = MemorySegment::kNoAtomics) const;
 
@@ -476,6 +483,9 @@ class Device : public NullDevice {
 
   virtual bool SetSvmAttributes(const void* dev_ptr, size_t count,
                                 amd::MemoryAdvice advice, bool use_cpu = false) const;
+  virtual bool SetSvmAttributes(const void* dev_ptr, size_t count,
+                                const std::vector<amd::SvmAdvice>& advices) const;
+  virtual bool ValidateSvmRange(const void* dev_ptr, size_t count) const;
   virtual bool GetSvmAttributes(void** data, size_t* data_sizes, int* attributes,
                                 size_t num_attributes, const void* dev_ptr, size_t count) const;
 
@@ -545,6 +555,9 @@ class Device : public NullDevice {
   // Update the global free memory size
   void updateFreeMemory(size_t size, bool free);
 
+  //! Returns the runtime accounting of the device memory
+  device::MemoryAccounting* memoryAccounting() const override { return memAccounting_; }
+
   bool AcquireExclusiveGpuAccess();
   void ReleaseExclusiveGpuAccess(VirtualGPU& vgpu) const;
 
@@ -563,18 +576,21 @@ class Device : public NullDevice {
   hsa_amd_memory_pool_t SystemCoarseSegment() const { return system_coarse_segment_; }
 
   //! Acquire HSA queue. This method can create a new HSA queue or
-  //! share previously created
+  //! share previously created. A dedicated queue is always created and never shared
   hsa_queue_t* acquireQueue(uint32_t queue_size_hint, bool coop_queue = false,
                             const std::vector<uint32_t>& cuMask = {},
-                            amd::CommandQueue::Priority priority = amd::CommandQueue::Priority::Normal);
+                            amd::CommandQueue::Priority priority = amd::CommandQueue::Priority::Normal,
+                            bool dedicated = false);
 
   //! Release HSA queue
-  void releaseQueue(hsa_queue_t*, const std::vector<uint32_t>& cuMask = {}, bool coop_queue = false);
+  void releaseQueue(hsa_queue_t*, const std::vector<uint32_t>& cuMask = {}, bool coop_queue = false,
+                    bool dedicated = false);
 
   //! For the given HSA queue, return an existing hostcall buffer or create a
   //! new one. queuePool_ keeps a mapping from HSA queue to hostcall buffer.
   void* getOrCreateHostcallBuffer(hsa_queue_t* queue, bool coop_queue = false,
-                                  const std::vector<uint32_t>& cuMask = {});
+                                  const std::vector<uint32_t>& cuMask = {},
+                                  bool dedicated = false);
 
   //! Return multi GPU grid launch sync buffer
   address MGSync() const { return mg_sync_; }
@@ -617,6 +633,9 @@ class Device : public NullDevice {
 
   bool SetSvmAttributesInt(const void* dev_ptr, size_t count, amd::MemoryAdvice advice,
                            bool first_alloc = false, bool use_cpu = false) const;
+  //! Adds the HMM attributes of the advice for this device or CPU
+  bool AddSvmAttributes(amd::MemoryAdvice advice, bool first_alloc, bool use_cpu,
+                        std::vector<hsa_amd_svm_attribute_pair_t>* attr) const;
   static constexpr hsa_signal_value_t InitSignalValue = 1;
 
   static hsa_ven_amd_loader_1_00_pfn_t amd_loader_ext_table;
@@ -654,7 +673,7 @@ class Device : public NullDevice {
 
   XferBuffers* xferRead_;   //!< Transfer buffers read
   XferBuffers* xferWrite_;  //!< Transfer buffers write
-  std::atomic<size_t> freeMem_;   //!< Total of free memory available
+  device::MemoryAccounting* memAccounting_;  //!< Runtime accounting of the device memory
   mutable amd::Monitor vgpusAccess_;     //!< Lock to serialise virtual gpu list access
   bool hsa_exclusive_gpu_access_;  //!< TRUE if current device was moved into exclusive GPU access mode
   static address mg_sync_;  //!< MGPU grid launch sync memory (SVM location)
@@ -675,9 +694,13 @@ class Device : public NullDevice {
   virtual bool findLinkInfo(const hsa_amd_memory_pool_t& pool,
                             std::vector<LinkAttrType>* link_attr);
 
-  //! Pool of HSA queues with custom CU masks
+  //! Pool of HSA queues, which aren't shared: the queues with custom CU masks and
+  //! the dedicated queues
   std::vector<std::map<hsa_queue_t*, QueueInfo>> queueWithCUMaskPool_;
 
+  //! Virtual GPUs of the terminated queues, kept for reuse by the new queues
+  mutable amd::device::QueueRecyclePool<VirtualGPU> recycledVgpus_;
+
   //! Read and Write mask for device<->host
   uint32_t maxSdmaReadMask_;
   uint32_t maxSdmaWriteMask_;
@@ -651,6 +651,9 @@ void Buffer::destroy() {
     if (memFlags & ROCCLR_MEM_PHYMEM) {
       // If this is physical memory, dont call hsa free function, since device mem was never created
       dev().deviceVmemRelease(owner()->getUserData().hsa_handle);
+      if (device::MemoryAccounting::counted(accountingOrigin(memFlags))) {
+        const_cast<Device&>(dev()).updateFreeMemory(size(), true);
+      }
       return;
     }
 
@@ -679,8 +682,9 @@ void Buffer::destroy() {
       }
     }
 
-    if ((deviceMemory_ != nullptr) &&
-        (dev().settings().apuSystem_ || !isFineGrain)) {
+    if ((deviceMemory_ != nullptr) && (dev().settings().apuSystem_ || !isFineGrain) &&
+        (kind_ != MEMORY_KIND_ARENA) &&
+        device::MemoryAccounting::counted(accountingOrigin(memFlags))) {
       const_cast<Device&>(dev()).updateFreeMemory(size(), true);
     }
 
@@ -728,6 +732,16 @@ void Buffer::destroy() {
   }
 }
 
+// ================================================================================================
+device::MemoryAccounting::Origin Buffer::accountingOrigin(cl_mem_flags memFlags) const {
+  using Origin = device::MemoryAccounting::Origin;
+  if (memFlags & ROCCLR_MEM_PHYMEM) {
+    return (memFlags & ROCCLR_MEM_INTERPROCESS) ? Origin::kImported : Origin::kPhysical;
+  }
+  // The mappings of the physical memory, VA ranges and IPC attachments reuse the memory
+  return (kind_ == MEMORY_KIND_PTRGIVEN) ? Origin::kView : Origin::kAllocation;
+}
+
 // ================================================================================================
 bool Buffer::create(bool alloc_local) {
   if (owner() == nullptr) {
@@ -790,6 +804,10 @@ bool Buffer::create(bool alloc_local) {
 
     owner()->setSvmPtr(reinterpret_cast<void*>(owner()->getUserData().hsa_handle));
 
+    if (device::MemoryAccounting::counted(accountingOrigin(memFlags))) {
+      const_cast<Device&>(dev()).updateFreeMemory(size(), false);
+    }
+
     return true;
   }
 
@@ -871,8 +889,9 @@ bool Buffer::create(bool alloc_local) {
       }
     }
 
-    if ((deviceMemory_ != nullptr) && (dev().settings().apuSystem_ || !isFineGrain)
-                                   && (kind_ != MEMORY_KIND_ARENA)) {
+    if ((deviceMemory_ != nullptr) && (dev().settings().apuSystem_ || !isFineGrain) &&
+        (kind_ != MEMORY_KIND_ARENA) &&
+        device::MemoryAccounting::counted(accountingOrigin(memFlags))) {
       const_cast<Device&>(dev()).updateFreeMemory(size(), false);
     }
 
@@ -191,6 +191,9 @@ class Buffer : public roc::Memory {
 
   // Free device memory.
   void destroy();
+
+  // Returns the origin of the buffer memory for the memory accounting
+  device::MemoryAccounting::Origin accountingOrigin(cl_mem_flags memFlags) const;
 };
 
 class Image : public roc::Memory {
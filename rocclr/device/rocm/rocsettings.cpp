@@ -148,6 +148,9 @@ bool Settings::create(bool fullProfile, const amd::Isa& isa,
   enableExtension(ClKhrDepthImages);
   enableExtension(ClAmdCopyBufferP2P);
   enableExtension(ClKhrFp16);
+  // Command buffers are recorded and replayed by the runtime on top of the queue commands
+  enableExtension(ClKhrCommandBuffer);
+  enableExtension(ClKhrCommandBufferMutableDispatch);
   supportDepthsRGB_ = true;
 
   if (useLightning_) {
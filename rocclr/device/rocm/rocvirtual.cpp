@@ -19,6 +19,7 @@
  THE SOFTWARE. */
 
 #include "device/devhostcall.hpp"
+#include "device/devstreamops.hpp"
 #include "device/rocm/rocdevice.hpp"
 #include "device/rocm/rocvirtual.hpp"
 #include "device/rocm/rockernel.hpp"
@@ -1220,7 +1221,7 @@ bool VirtualGPU::releaseGpuMemoryFence(bool skip_cpu_wait) {
 // ================================================================================================
 VirtualGPU::VirtualGPU(Device& device, bool profiling, bool cooperative,
                        const std::vector<uint32_t>& cuMask,
-                       amd::CommandQueue::Priority priority)
+                       amd::CommandQueue::Priority priority, bool dedicatedQueue)
     : device::VirtualDevice(device),
       state_(0),
       gpu_queue_(nullptr),
@@ -1236,6 +1237,7 @@ VirtualGPU::VirtualGPU(Device& device, bool profiling, bool cooperative,
       kernarg_pool_signal_(KernelArgPoolNumSignal),
       cuMask_(cuMask),
       priority_(priority),
+      dedicatedQueue_(dedicatedQueue),
       copy_command_type_(0),
       fence_state_(Device::CacheState::kCacheStateInvalid),
       fence_dirty_(false),
@@ -1332,41 +1334,23 @@ VirtualGPU::~VirtualGPU() {
   }
 
   if (gpu_queue_) {
-    roc_device_.releaseQueue(gpu_queue_, cuMask_, cooperative_);
+    roc_device_.releaseQueue(gpu_queue_, cuMask_, cooperative_, dedicatedQueue_);
   }
 }
 
 // ================================================================================================
-bool VirtualGPU::create() {
+bool VirtualGPU::create(bool lazy) {
   // Pick a reasonable queue size
   uint32_t queue_size = ROC_AQL_QUEUE_SIZE;
-  gpu_queue_ = roc_device_.acquireQueue(queue_size, cooperative_, cuMask_, priority_);
+  gpu_queue_ = roc_device_.acquireQueue(queue_size, cooperative_, cuMask_, priority_,
+                                        dedicatedQueue_);
   if (!gpu_queue_) return false;
 
-  if (!initPool(dev().settings().kernargPoolSize_)) {
-    LogError("Couldn't allocate arguments/signals for the queue");
-    return false;
-  }
-
-  device::BlitManager::Setup blitSetup;
-  blitMgr_ = new KernelBlitManager(*this, blitSetup);
-  if ((nullptr == blitMgr_) || !blitMgr_->create(roc_device_)) {
-    LogError("Could not create BlitManager!");
-    return false;
-  }
-
   // Initialize barrier and barrier value packets
   memset(&barrier_packet_, 0, sizeof(barrier_packet_));
   barrier_packet_.header = kInvalidAql;
   barrier_value_packet_.header.header = kInvalidAql;
 
-  // Create a object of PrintfDbg
-  printfdbg_ = new PrintfDbg(roc_device_);
-  if (nullptr == printfdbg_) {
-    LogError("\nCould not create printfDbg Object!");
-    return false;
-  }
-
   // Initialize timestamp conversion factor
   if (Timestamp::getGpuTicksToTime() == 0) {
     uint64_t frequency;
@@ -1374,17 +1358,102 @@ bool VirtualGPU::create() {
     Timestamp::setGpuTicksToTime(1e9 / double(frequency));
   }
 
-  if (!memoryDependency().create(GPU_NUM_MEM_DEPENDENCY)) {
-    LogError("Could not create the array of memory objects!");
-    return false;
-  }
-
   // Allocate signal tracker for ROCr copy queue
   tracking_created_ = Barriers().Create();
   if (!tracking_created_) {
     LogError("Could not create signal for copy queue!");
     return false;
   }
+
+  // The queues, which may never launch a kernel or a blit, defer the rest to the first use
+  if (!lazy) {
+    if (!initKernelResources() || !initBlitMgr()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ================================================================================================
+bool VirtualGPU::initKernelResources() {
+  if (kernelResources_) {
+    return true;
+  }
+
+  if ((kernarg_pool_base_ == nullptr) && !initPool(dev().settings().kernargPoolSize_)) {
+    LogError("Couldn't allocate arguments/signals for the queue");
+    destroyPool();
+    return false;
+  }
+
+  // Create a object of PrintfDbg
+  if (printfdbg_ == nullptr) {
+    printfdbg_ = new PrintfDbg(roc_device_);
+    if (nullptr == printfdbg_) {
+      LogError("\nCould not create printfDbg Object!");
+      return false;
+    }
+  }
+
+  if ((memoryDependency().maxMemObjectsInQueue() == 0) &&
+      !memoryDependency().create(GPU_NUM_MEM_DEPENDENCY)) {
+    LogError("Could not create the array of memory objects!");
+    return false;
+  }
+
+  kernelResources_ = true;
+  return true;
+}
+
+// ================================================================================================
+bool VirtualGPU::initBlitMgr() {
+  device::BlitManager::Setup blitSetup;
+  KernelBlitManager* blitMgr = new KernelBlitManager(*this, blitSetup);
+  if ((nullptr == blitMgr) || !blitMgr->create(roc_device_)) {
+    LogError("Could not create BlitManager!");
+    delete blitMgr;
+    return false;
+  }
+  blitMgr_ = blitMgr;
+  return true;
+}
+
+// ================================================================================================
+bool VirtualGPU::initResources(amd::Command& cmd) {
+  // The blits allocate the constant buffers in the kernel args pool, hence the pool goes first
+  if (!initKernelResources() || ((blitMgr_ == nullptr) && !initBlitMgr())) {
+    cmd.setStatus(CL_OUT_OF_RESOURCES);
+    return false;
+  }
+  return true;
+}
+
+// ================================================================================================
+bool VirtualGPU::recycle() {
+  // The device enqueue and the cooperative queues aren't shared
+  if ((virtualQueue_ != nullptr) || cooperative_ || !tracking_created_) {
+    return false;
+  }
+
+  // Make sure VirtualGPU has an exclusive access to the resources
+  amd::ScopedLock lock(execution());
+
+  // Wait for the outstanding work, it also resets the kernel args pool and memory dependencies
+  releaseGpuMemoryFence();
+  releasePinnedMem();
+
+  if (timestamp_ != nullptr) {
+    timestamp_->release();
+    timestamp_ = nullptr;
+  }
+
+  // Drop the states of the previous command queue. The kernel resources and the blit
+  // manager stay, so the next queue doesn't pay for them again
+  hasPendingDispatch_ = false;
+  addSystemScope_ = false;
+  retainExternalSignals_ = false;
+  copy_command_type_ = 0;
+  aqlHeader_ = dispatchPacketHeader_;
   return true;
 }
 
@@ -1421,10 +1490,12 @@ void VirtualGPU::destroyPool() {
   for (auto& it : kernarg_pool_signal_) {
     if (it.handle != 0) {
       hsa_signal_destroy(it);
+      it.handle = 0;
     }
   }
   if (kernarg_pool_base_ != nullptr) {
     roc_device_.hostFree(kernarg_pool_base_, kernarg_pool_size_);
+    kernarg_pool_base_ = nullptr;
   }
 }
 
@@ -1467,6 +1538,9 @@ address VirtualGPU::allocKernelArguments(size_t size, size_t alignment) {
   if (ROC_SKIP_KERNEL_ARG_COPY) {
     // Make sure VirtualGPU has an exclusive access to the resources
     amd::ScopedLock lock(execution());
+    if (!initKernelResources()) {
+      return nullptr;
+    }
     return reinterpret_cast<address>(allocKernArg(size, alignment));
   } else {
     return nullptr;
@@ -1623,6 +1697,10 @@ void VirtualGPU::submitReadMemory(amd::ReadMemoryCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(cmd)) {
+    return;
+  }
+
   profilingBegin(cmd, true);
 
   size_t offset = 0;
@@ -1726,6 +1804,10 @@ void VirtualGPU::submitWriteMemory(amd::WriteMemoryCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(cmd)) {
+    return;
+  }
+
   profilingBegin(cmd, true);
 
   size_t offset = 0;
@@ -1846,22 +1928,33 @@ void VirtualGPU::submitSvmPrefetchAsync(amd::SvmPrefetchAsyncCommand& cmd) {
   profilingBegin(cmd);
 
   if (dev().info().hmmSupported_) {
-    // Initialize signal for the barrier
+    // Initialize signal for the barrier. Every prefetch of the batch decrements it
+    const auto& ranges = cmd.ranges();
     auto wait_events = Barriers().WaitingSignal(HwQueueEngine::Unknown);
-    hsa_signal_t active = Barriers().ActiveSignal(kInitSignalValueOne, timestamp_);
-
-    // Find the requested agent for the transfer
-    hsa_agent_t agent = (cmd.cpu_access() ||
-        (dev().settings().hmmFlags_ & Settings::Hmm::EnableSystemMemory)) ?
-        dev().getCpuAgent() : (static_cast<const roc::Device*>(cmd.device()))->getBackendDevice();
-
-    // Initiate a prefetch command
-    hsa_status_t status = hsa_amd_svm_prefetch_async(
-        const_cast<void*>(cmd.dev_ptr()), cmd.count(), agent,
-        wait_events.size(), wait_events.data(), active);
+    hsa_signal_t active = Barriers().ActiveSignal(ranges.size(), timestamp_);
+
+    hsa_status_t status = HSA_STATUS_SUCCESS;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      // Find the requested agent for the transfer
+      hsa_agent_t agent = (ranges[i].cpu_access_ ||
+          (dev().settings().hmmFlags_ & Settings::Hmm::EnableSystemMemory)) ?
+          dev().getCpuAgent() :
+          (static_cast<const roc::Device*>(ranges[i].dev_))->getBackendDevice();
+
+      // Initiate a prefetch command
+      status = hsa_amd_svm_prefetch_async(
+          const_cast<void*>(ranges[i].dev_ptr_), ranges[i].count_, agent,
+          wait_events.size(), wait_events.data(), active);
+      if (status != HSA_STATUS_SUCCESS) {
+        // Drop the prefetches, which won't be issued, so the wait below covers the issued ones
+        hsa_signal_subtract_relaxed(active, ranges.size() - i);
+        break;
+      }
+    }
 
     // Wait for the prefetch. Should skip wait, but may require extra tracking for kernel execution
-    if ((status != HSA_STATUS_SUCCESS) || !Barriers().WaitCurrent()) {
+    bool done = Barriers().WaitCurrent();
+    if ((status != HSA_STATUS_SUCCESS) || !done) {
       Barriers().ResetCurrentSignal();
       LogError("hsa_amd_svm_prefetch_async failed");
       cmd.setStatus(CL_INVALID_OPERATION);
@@ -1971,6 +2064,10 @@ void VirtualGPU::submitCopyMemory(amd::CopyMemoryCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(cmd)) {
+    return;
+  }
+
   profilingBegin(cmd, true);
 
   cl_command_type type = cmd.type();
@@ -1994,6 +2091,10 @@ void VirtualGPU::submitSvmCopyMemory(amd::SvmCopyMemoryCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(cmd)) {
+    return;
+  }
+
   profilingBegin(cmd, true);
   // no op for FGS supported device
   if (!dev().isFineGrainedSystem(true)) {
@@ -2076,6 +2177,10 @@ void VirtualGPU::submitCopyMemoryP2P(amd::CopyMemoryP2PCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(cmd)) {
+    return;
+  }
+
   profilingBegin(cmd, true);
 
   Memory* srcDevMem = static_cast<roc::Memory*>(
@@ -2173,6 +2278,10 @@ void VirtualGPU::submitSvmMapMemory(amd::SvmMapMemoryCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(cmd)) {
+    return;
+  }
+
   profilingBegin(cmd, true);
 
   // no op for FGS supported device
@@ -2211,6 +2320,10 @@ void VirtualGPU::submitSvmUnmapMemory(amd::SvmUnmapMemoryCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(cmd)) {
+    return;
+  }
+
   profilingBegin(cmd, true);
 
   // no op for FGS supported device
@@ -2251,6 +2364,10 @@ void VirtualGPU::submitMapMemory(amd::MapMemoryCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(cmd)) {
+    return;
+  }
+
   profilingBegin(cmd, true);
 
   //! @todo add multi-devices synchronization when supported.
@@ -2355,6 +2472,10 @@ void VirtualGPU::submitUnmapMemory(amd::UnmapMemoryCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(cmd)) {
+    return;
+  }
+
   roc::Memory* devMemory = static_cast<roc::Memory*>(cmd.memory().getDeviceMemory(dev(), false));
 
   const device::Memory::WriteMapInfo* mapInfo = devMemory->writeMapInfo(cmd.mapPtr());
@@ -2511,6 +2632,10 @@ void VirtualGPU::submitFillMemory(amd::FillMemoryCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(cmd)) {
+    return;
+  }
+
   profilingBegin(cmd);
 
   bool force_blit = false;
@@ -2529,10 +2654,76 @@ void VirtualGPU::submitFillMemory(amd::FillMemoryCommand& cmd) {
   profilingEnd(cmd);
 }
 
+// ================================================================================================
+void VirtualGPU::streamOpsWait(Memory* memory, uint64_t value, uint64_t mask, unsigned int flags,
+                               size_t offset, size_t sizeBytes, bool cpWait) {
+  if (cpWait) {
+    uint16_t header = kBarrierVendorPacketHeader;
+    Buffer* buff = static_cast<Buffer*>(memory);
+    hsa_signal_t signal = buff->getSignal();
+
+    // mask is always applied on value at signal before performing
+    // the comparision defiend by 'condition'
+    switch (flags) {
+      case ROCCLR_STREAM_WAIT_VALUE_GTE: {
+        dispatchBarrierValuePacket(header, false, signal, value, mask,
+                                   HSA_SIGNAL_CONDITION_GTE, true);
+        break;
+      }
+      case ROCCLR_STREAM_WAIT_VALUE_EQ: {
+        dispatchBarrierValuePacket(header,false, signal, value, mask,
+                                   HSA_SIGNAL_CONDITION_EQ, true);
+        break;
+      }
+      case ROCCLR_STREAM_WAIT_VALUE_AND: {
+        dispatchBarrierValuePacket(header, false, signal, 0, (value & mask),
+                                   HSA_SIGNAL_CONDITION_NE, true);
+        break;
+      }
+      case ROCCLR_STREAM_WAIT_VALUE_NOR: {
+        uint64_t norValue = ~value & mask;
+        dispatchBarrierValuePacket(header, false, signal, norValue, norValue,
+                                  HSA_SIGNAL_CONDITION_NE, true);
+        break;
+      }
+      default:
+        ShouldNotReachHere();
+        break;
+    }
+  }
+  // Use a blit kernel to perform the wait operation
+  else {
+  // mask is applied on value before performing
+  // the comparision defined by 'condition'
+    bool result = static_cast<KernelBlitManager&>(blitMgr()).streamOpsWait(*memory, value, offset,
+                                                                            sizeBytes, flags, mask);
+    ClPrint(amd::LOG_DEBUG, amd::LOG_COPY, "Waiting for value: 0x%lx."
+            " Flags: 0x%lx mask: 0x%lx", value, flags, mask);
+    if (!result) {
+      LogError("submitStreamOperation: Wait failed!");
+    }
+  }
+}
+
+// ================================================================================================
+void VirtualGPU::streamOpsWrite(Memory* memory, uint64_t value, size_t offset, size_t sizeBytes) {
+  bool result = static_cast<KernelBlitManager&>(blitMgr()).streamOpsWrite(*memory, value,
+                                                                          offset, sizeBytes);
+  ClPrint(amd::LOG_DEBUG, amd::LOG_COPY, "Writing value: 0x%lx", value);
+  if (!result) {
+    LogError("submitStreamOperation: Write failed!");
+  }
+}
+
 // ================================================================================================
 void VirtualGPU::submitStreamOperation(amd::StreamOperationCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
+
+  if (!initResources(cmd)) {
+    return;
+  }
+
   profilingBegin(cmd);
 
   const cl_command_type type = cmd.type();
@@ -2546,64 +2737,11 @@ void VirtualGPU::submitStreamOperation(amd::StreamOperationCommand& cmd) {
   Memory* memory = dev().getRocMemory(amdMemory);
 
   if (type == ROCCLR_COMMAND_STREAM_WAIT_VALUE) {
-    if (GPU_STREAMOPS_CP_WAIT) {
-      uint16_t header = kBarrierVendorPacketHeader;
-      Buffer* buff = static_cast<Buffer*>(memory);
-      hsa_signal_t signal = buff->getSignal();
-
-      // mask is always applied on value at signal before performing
-      // the comparision defiend by 'condition'
-      switch (flags) {
-        case ROCCLR_STREAM_WAIT_VALUE_GTE: {
-          dispatchBarrierValuePacket(header, false, signal, value, mask,
-                                     HSA_SIGNAL_CONDITION_GTE, true);
-          break;
-        }
-        case ROCCLR_STREAM_WAIT_VALUE_EQ: {
-          dispatchBarrierValuePacket(header,false, signal, value, mask,
-                                     HSA_SIGNAL_CONDITION_EQ, true);
-          break;
-        }
-        case ROCCLR_STREAM_WAIT_VALUE_AND: {
-          dispatchBarrierValuePacket(header, false, signal, 0, (value & mask),
-                                     HSA_SIGNAL_CONDITION_NE, true);
-          break;
-        }
-        case ROCCLR_STREAM_WAIT_VALUE_NOR: {
-          uint64_t norValue = ~value & mask;
-          dispatchBarrierValuePacket(header, false, signal, norValue, norValue,
-                                    HSA_SIGNAL_CONDITION_NE, true);
-          break;
-        }
-        default:
-          ShouldNotReachHere();
-          break;
-      }
-    }
-    // Use a blit kernel to perform the wait operation
-    else {
-    // mask is applied on value before performing
-    // the comparision defined by 'condition'
-      bool result = static_cast<KernelBlitManager&>(blitMgr()).streamOpsWait(*memory, value, offset,
-                                                                              sizeBytes, flags, mask);
-      ClPrint(amd::LOG_DEBUG, amd::LOG_COPY, "Waiting for value: 0x%lx."
-              " Flags: 0x%lx mask: 0x%lx", value, flags, mask);
-      if (!result) {
-        LogError("submitStreamOperation: Wait failed!");
-      }
-    }
+    streamOpsWait(memory, value, mask, flags, offset, sizeBytes, GPU_STREAMOPS_CP_WAIT);
   } else if (type == ROCCLR_COMMAND_STREAM_WRITE_VALUE) {
-    amd::Coord3D origin(offset);
-    amd::Coord3D size(sizeBytes);
     // Ensure memory ordering preceding the write
     dispatchBarrierPacket(kBarrierPacketReleaseHeader);
-
-    bool result = static_cast<KernelBlitManager&>(blitMgr()).streamOpsWrite(*memory, value,
-                                                                            offset, sizeBytes);
-    ClPrint(amd::LOG_DEBUG, amd::LOG_COPY, "Writing value: 0x%lx", value);
-    if (!result) {
-      LogError("submitStreamOperation: Write failed!");
-    }
+    streamOpsWrite(memory, value, offset, sizeBytes);
   } else {
     ShouldNotReachHere();
   }
@@ -2611,63 +2749,165 @@ void VirtualGPU::submitStreamOperation(amd::StreamOperationCommand& cmd) {
 }
 
 // ================================================================================================
-void VirtualGPU::submitVirtualMap(amd::VirtualMapCommand& vcmd) {
+void VirtualGPU::submitBatchStreamOperation(amd::BatchStreamOperationCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
-  profilingBegin(vcmd);
-
-  // Find the amd::Memory object for virtual ptr. vcmd.ptr() is vaddr.
-  amd::Memory* vaddr_base_obj = amd::MemObjMap::FindVirtualMemObj(vcmd.ptr());
-  if (vaddr_base_obj == nullptr || !(vaddr_base_obj->getMemFlags() & CL_MEM_VA_RANGE_AMD)) {
-    profilingEnd(vcmd);
+  if (!initResources(cmd)) {
     return;
   }
 
-  // Get the amd::Memory object for the physical address
-  amd::Memory* phys_mem_obj = vcmd.memory();
-  hsa_status_t hsa_status = HSA_STATUS_SUCCESS;
-
-  // If Physical address is not set, then it is map command. If set, it is unmap command.
-  if (phys_mem_obj != nullptr) {
-    constexpr bool kParent = false;
-    amd::Memory* vaddr_sub_obj = phys_mem_obj->getContext().devices()[0]->CreateVirtualBuffer(
-                                 phys_mem_obj->getContext(), const_cast<void*>(vcmd.ptr()),
-                                 vcmd.size(), phys_mem_obj->getUserData().deviceId, kParent);
-    // Map the physical to virtual address the hsa api
-    hsa_amd_vmem_alloc_handle_t opaque_hsa_handle;
-    opaque_hsa_handle.handle = phys_mem_obj->getUserData().hsa_handle;
-    if ((hsa_status = hsa_amd_vmem_map(vaddr_sub_obj->getSvmPtr(), vcmd.size(),
-                        vaddr_sub_obj->getOffset(), opaque_hsa_handle, 0)) == HSA_STATUS_SUCCESS) {
-      assert(amd::MemObjMap::FindMemObj(vcmd.ptr()) == nullptr);
-      amd::MemObjMap::AddMemObj(vcmd.ptr(), vaddr_sub_obj);
-      vaddr_sub_obj->getUserData().phys_mem_obj = phys_mem_obj;
-      phys_mem_obj->getUserData().vaddr_mem_obj = vaddr_sub_obj;
+  profilingBegin(cmd);
+
+  using Operation = amd::BatchStreamOperationCommand::Operation;
+  const std::vector<Operation>& ops = cmd.operations();
+  std::vector<Memory*> memories(ops.size(), nullptr);
+  std::vector<amd::device::StreamOpKind> kinds;
+  kinds.reserve(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (ops[i].type_ == ROCCLR_COMMAND_STREAM_MEM_BARRIER) {
+      kinds.push_back(amd::device::StreamOpKind::Barrier);
+      continue;
+    }
+    memories[i] = dev().getRocMemory(ops[i].memory_);
+    if (ops[i].type_ == ROCCLR_COMMAND_STREAM_WRITE_VALUE) {
+      kinds.push_back(amd::device::StreamOpKind::Write);
+    } else if (ops[i].memory_->getMemFlags() & ROCCLR_MEM_HSA_SIGNAL_MEMORY) {
+      kinds.push_back(amd::device::StreamOpKind::SignalWait);
     } else {
-      LogError("HSA Command: hsa_amd_vmem_map failed!");
+      kinds.push_back(amd::device::StreamOpKind::Wait);
     }
-  } else {
-    dispatchBarrierPacket(kBarrierPacketHeader, false);
-    Barriers().WaitCurrent();
+  }
+
+  // Dispatches the lowered packets on this queue
+  class Lowering : public amd::device::StreamOpsLowering {
+   public:
+    Lowering(VirtualGPU& gpu, const std::vector<Operation>& ops,
+             const std::vector<Memory*>& memories)
+        : gpu_(gpu), ops_(ops), memories_(memories) {}
+
+    void releaseBarrier() override { gpu_.dispatchBarrierPacket(kBarrierPacketReleaseHeader); }
+    void waitBarrierValue(size_t op) override { wait(op, true); }
+    void waitKernel(size_t op) override { wait(op, false); }
+    void writeKernel(size_t op) override {
+      gpu_.streamOpsWrite(memories_[op], ops_[op].value_, ops_[op].offset_, ops_[op].sizeBytes_);
+    }
+
+   private:
+    void wait(size_t op, bool cpWait) {
+      gpu_.streamOpsWait(memories_[op], ops_[op].value_, ops_[op].mask_, ops_[op].flags_,
+                         ops_[op].offset_, ops_[op].sizeBytes_, cpWait);
+    }
+
+    VirtualGPU& gpu_;
+    const std::vector<Operation>& ops_;
+    const std::vector<Memory*>& memories_;
+  } lowering(*this, ops, memories);
+
+  size_t packets = amd::device::LowerStreamOps(kinds, GPU_STREAMOPS_CP_WAIT, &lowering);
+  ClPrint(amd::LOG_DEBUG, amd::LOG_COPY, "Batch of %zu stream operations in %zu packets",
+          ops.size(), packets);
+  profilingEnd(cmd);
+}
 
-    amd::Memory* vaddr_sub_obj = amd::MemObjMap::FindMemObj(vcmd.ptr());
-    assert(vaddr_sub_obj != nullptr);
+// ================================================================================================
+void VirtualGPU::submitVirtualMap(amd::VirtualMapCommand& vcmd) {
+  // Make sure VirtualGPU has an exclusive access to the resources
+  amd::ScopedLock lock(execution());
+
+  profilingBegin(vcmd);
 
-    // Unmap the object, since the physical addr is set.
-    if ((hsa_status = hsa_amd_vmem_unmap(vaddr_sub_obj->getSvmPtr(), vcmd.size()))
-                        == HSA_STATUS_SUCCESS) {
+  // Maps and unmaps the ranges of the batch with HSA VMM api
+  class Lowering : public amd::device::VirtualMapLowering {
+   public:
+    Lowering(VirtualGPU& gpu, const std::vector<amd::VirtualMapCommand::Range>& ranges)
+        : gpu_(gpu), ranges_(ranges) {}
+
+    void waitIdle() override {
+      gpu_.dispatchBarrierPacket(kBarrierPacketHeader, false);
+      gpu_.Barriers().WaitCurrent();
+    }
+
+    amd::Memory* findReservation(const void* ptr, size_t size) override {
+      amd::Memory* vaddr_base_obj = amd::MemObjMap::FindVirtualMemObj(ptr);
+      if (vaddr_base_obj == nullptr || !(vaddr_base_obj->getMemFlags() & CL_MEM_VA_RANGE_AMD)) {
+        return nullptr;
+      }
+      const_address base = reinterpret_cast<const_address>(vaddr_base_obj->getSvmPtr());
+      if (reinterpret_cast<const_address>(ptr) + size > base + vaddr_base_obj->getSize()) {
+        return nullptr;
+      }
+      return vaddr_base_obj;
+    }
+
+    bool map(size_t range, amd::Memory* reservation) override {
+      const auto& vrange = ranges_[range];
+      // Get the amd::Memory object for the physical address
+      amd::Memory* phys_mem_obj = vrange.memory_;
+      amd::Memory* vaddr_sub_obj = vrange.view_;
+      if (vaddr_sub_obj == nullptr) {
+        constexpr bool kParent = false;
+        vaddr_sub_obj = phys_mem_obj->getContext().devices()[0]->CreateVirtualBuffer(
+                        phys_mem_obj->getContext(), vrange.ptr_,
+                        vrange.size_, phys_mem_obj->getUserData().deviceId, kParent);
+      }
+      // Map the physical to virtual address the hsa api
+      hsa_amd_vmem_alloc_handle_t opaque_hsa_handle;
+      opaque_hsa_handle.handle = phys_mem_obj->getUserData().hsa_handle;
+      if (hsa_amd_vmem_map(vaddr_sub_obj->getSvmPtr(), vrange.size_,
+                           vaddr_sub_obj->getOffset(), opaque_hsa_handle, 0)
+                           != HSA_STATUS_SUCCESS) {
+        LogError("HSA Command: hsa_amd_vmem_map failed!");
+        if (vrange.view_ != nullptr) {
+          // The caller published the mapping at enqueue time, withdraw it
+          amd::MemObjMap::RemoveMemObj(vrange.ptr_);
+          phys_mem_obj->getUserData().vaddr_mem_obj = nullptr;
+          vaddr_sub_obj->getUserData().phys_mem_obj = nullptr;
+          vaddr_sub_obj->getContext().devices()[0]->DestroyVirtualBuffer(vaddr_sub_obj);
+        }
+        return false;
+      }
+      if (vrange.view_ == nullptr) {
+        assert(amd::MemObjMap::FindMemObj(vrange.ptr_) == nullptr);
+        amd::MemObjMap::AddMemObj(vrange.ptr_, vaddr_sub_obj);
+        vaddr_sub_obj->getUserData().phys_mem_obj = phys_mem_obj;
+        phys_mem_obj->getUserData().vaddr_mem_obj = vaddr_sub_obj;
+      }
+      return true;
+    }
+
+    bool unmap(size_t range) override {
+      const auto& vrange = ranges_[range];
+      // The caller may have removed the view from MemObjMap at enqueue time already
+      amd::Memory* vaddr_sub_obj = (vrange.view_ != nullptr) ? vrange.view_ :
+                                   amd::MemObjMap::FindMemObj(vrange.ptr_);
+      assert(vaddr_sub_obj != nullptr);
+
+      // Unmap the object, since the physical addr isn't set.
+      if (hsa_amd_vmem_unmap(vaddr_sub_obj->getSvmPtr(), vrange.size_) != HSA_STATUS_SUCCESS) {
+        LogError("HSA Command: hsa_amd_vmem_unmap failed");
+        return false;
+      }
       // assert the va is mapped and needs to be removed
       vaddr_sub_obj->getContext().devices()[0]->DestroyVirtualBuffer(vaddr_sub_obj);
-      amd::MemObjMap::RemoveMemObj(vcmd.ptr());
-      if (vaddr_sub_obj->getUserData().phys_mem_obj != nullptr) {
-        vaddr_sub_obj->getUserData().phys_mem_obj->getUserData().vaddr_mem_obj = nullptr;
-        vaddr_sub_obj->getUserData().phys_mem_obj = nullptr;
+      if (vrange.view_ == nullptr) {
+        amd::MemObjMap::RemoveMemObj(vrange.ptr_);
+        if (vaddr_sub_obj->getUserData().phys_mem_obj != nullptr) {
+          vaddr_sub_obj->getUserData().phys_mem_obj->getUserData().vaddr_mem_obj = nullptr;
+          vaddr_sub_obj->getUserData().phys_mem_obj = nullptr;
+        }
       }
-    } else {
-      LogError("HSA Command: hsa_amd_vmem_unmap failed");
+      return true;
     }
-  }
 
+   private:
+    VirtualGPU& gpu_;
+    const std::vector<amd::VirtualMapCommand::Range>& ranges_;
+  } lowering(*this, vcmd.ranges());
+
+  size_t failed = amd::device::LowerVirtualMap(vcmd.ranges(), vcmd.runs(), &lowering);
+  ClPrint(amd::LOG_DEBUG, amd::LOG_MEM, "Batch of %zu virtual map ranges in %zu runs, %zu failed",
+          vcmd.ranges().size(), vcmd.runs().size(), failed);
   profilingEnd(vcmd);
 }
 
@@ -2676,6 +2916,10 @@ void VirtualGPU::submitSvmFillMemory(amd::SvmFillMemoryCommand& cmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(cmd)) {
+    return;
+  }
+
   profilingBegin(cmd);
 
   amd::Memory* dstMemory = amd::MemObjMap::FindMemObj(cmd.dst());
@@ -2715,6 +2959,10 @@ void VirtualGPU::submitMigrateMemObjects(amd::MigrateMemObjectsCommand& vcmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
   amd::ScopedLock lock(execution());
 
+  if (!initResources(vcmd)) {
+    return;
+  }
+
   profilingBegin(vcmd);
 
   for (auto itr : vcmd.memObjects()) {
@@ -3002,6 +3250,11 @@ bool VirtualGPU::submitKernelInternal(const amd::NDRangeContainer& sizes,
   bool imageBufferWrtBack = false; // Image buffer write back is required
   std::vector<device::Memory*> wrtBackImageBuffer; // Array of images for write back
 
+  // Create the kernel args pool and the printf buffer on the first launch
+  if (!initKernelResources()) {
+    return false;
+  }
+
   // Check memory dependency and SVM objects
   bool coopGroups = (vcmd != nullptr) ? vcmd->cooperativeGroups() : false;
   if (!processMemObjects(kernel, parameters, ldsUsage, coopGroups,
@@ -3097,7 +3350,8 @@ bool VirtualGPU::submitKernelInternal(const amd::NDRangeContainer& sizes,
           if (amd::IS_HIP) {
             if (dev().info().pcie_atomics_) {
               uintptr_t buffer = reinterpret_cast<uintptr_t>(
-                roc_device_.getOrCreateHostcallBuffer(gpu_queue_, coopGroups, cuMask_));
+                roc_device_.getOrCreateHostcallBuffer(gpu_queue_, coopGroups, cuMask_,
+                                                      dedicatedQueue_));
               if (!buffer) {
                 LogError("Kernel expects a hostcall buffer, but none found");
                 return false;
@@ -3464,6 +3718,10 @@ void VirtualGPU::submitKernel(amd::NDRangeKernelCommand& vcmd) {
     // Make sure VirtualGPU has an exclusive access to the resources
     amd::ScopedLock lock(execution());
 
+    if (!initResources(vcmd)) {
+      return;
+    }
+
     profilingBegin(vcmd);
 
     // Submit kernel to HW
@@ -3623,7 +3881,7 @@ amd::Memory* VirtualGPU::findPinnedMem(void* addr, size_t size) {
 }
 
 // ================================================================================================
-void VirtualGPU::enableSyncBlit() const { blitMgr_->enableSynchronization(); }
+void VirtualGPU::enableSyncBlit() const { blitMgr().enableSynchronization(); }
 
 // ================================================================================================
 void VirtualGPU::submitPerfCounter(amd::PerfCounterCommand& vcmd) {
@@ -21,6 +21,7 @@
 #pragma once
 
 #include "platform/commandqueue.hpp"
+#include "device/devrecyclepool.hpp"
 #include "rocdefs.hpp"
 #include "rocdevice.hpp"
 #include "utils/util.hpp"
@@ -299,10 +300,23 @@ class VirtualGPU : public device::VirtualDevice {
 
   VirtualGPU(Device& device, bool profiling = false, bool cooperative = false,
              const std::vector<uint32_t>& cuMask = {},
-             amd::CommandQueue::Priority priority = amd::CommandQueue::Priority::Normal);
+             amd::CommandQueue::Priority priority = amd::CommandQueue::Priority::Normal,
+             bool dedicatedQueue = false);
   ~VirtualGPU();
 
-  bool create();
+  //! Creates the queue. With lazy set the blit manager, the kernel args pool, the printf buffer
+  //! and the memory dependency tracker are created on the first use
+  bool create(bool lazy = false);
+
+  //! Prepares an idle queue for reuse by another command queue with the same traits.
+  //! Returns false if the queue can't be recycled
+  bool recycle();
+
+  //! Returns the traits a command queue must have to reuse this queue
+  amd::device::QueueTraits traits() const {
+    return {static_cast<uint32_t>(priority_), profiling_ != 0, cuMask_, dedicatedQueue_};
+  }
+
   const Device& dev() const { return roc_device_; }
 
   void profilingBegin(amd::Command& command, bool sdmaProfiling = false);
@@ -335,6 +349,7 @@ class VirtualGPU : public device::VirtualDevice {
   void flush(amd::Command* list = nullptr, bool wait = false);
   void submitFillMemory(amd::FillMemoryCommand& cmd);
   void submitStreamOperation(amd::StreamOperationCommand& cmd);
+  void submitBatchStreamOperation(amd::BatchStreamOperationCommand& cmd);
   void submitVirtualMap(amd::VirtualMapCommand& cmd);
   void submitMigrateMemObjects(amd::MigrateMemObjectsCommand& cmd);
 
@@ -374,6 +389,14 @@ class VirtualGPU : public device::VirtualDevice {
   // Return pointer to PrintfDbg
   PrintfDbg* printfDbg() const { return printfdbg_; }
 
+  //! Creates the resources of the kernel dispatches if the queue deferred them
+  bool initKernelResources();
+
+  //! Creates the deferred kernel resources and the blit manager before the command submission.
+  //! Fails the command with CL_OUT_OF_RESOURCES if they can't be created.
+  //! The caller must hold the execution lock
+  bool initResources(amd::Command& cmd);
+
   //! Returns memory dependency class
   MemoryDependency& memoryDependency() { return memoryDependency_; }
 
@@ -423,6 +446,7 @@ class VirtualGPU : public device::VirtualDevice {
   void setLastUsedSdmaEngine(uint32_t mask) { lastUsedSdmaEngineMask_ = mask; }
   uint32_t getLastUsedSdmaEngine() const { return lastUsedSdmaEngineMask_.load(); }
   // } roc OpenCL integration
+
  private:
   //! Dispatches a barrier with blocking HSA signals
   void dispatchBlockingWait();
@@ -452,9 +476,19 @@ class VirtualGPU : public device::VirtualDevice {
   void initializeDispatchPacket(hsa_kernel_dispatch_packet_t* packet,
                                 amd::NDRangeContainer& sizes);
 
+  //! Waits on the value in memory with a barrier-value packet if cpWait is set,
+  //! otherwise with the blit kernel
+  void streamOpsWait(Memory* memory, uint64_t value, uint64_t mask, unsigned int flags,
+                     size_t offset, size_t sizeBytes, bool cpWait);
+  //! Writes the value to memory with the blit kernel. The caller must release the prior work
+  void streamOpsWrite(Memory* memory, uint64_t value, size_t offset, size_t sizeBytes);
+
   bool initPool(size_t kernarg_pool_size);
   void destroyPool();
 
+  //! Creates the blit manager of the queue
+  bool initBlitMgr();
+
   void resetKernArgPool() {
     kernarg_pool_cur_offset_ = 0;
     kernarg_pool_chunk_end_ = kernarg_pool_size_ / KernelArgPoolNumSignal;
@@ -511,6 +545,7 @@ class VirtualGPU : public device::VirtualDevice {
       uint32_t addSystemScope_        : 1; //!< Insert a system scope to the next aql
       uint32_t tracking_created_      : 1; //!< Enabled if tracking object was properly initialized
       uint32_t retainExternalSignals_ : 1; //!< Indicate to retain external signal array
+      uint32_t kernelResources_       : 1; //!< Kernel args pool and printf buffer are created
     };
     uint32_t  state_;
   };
@@ -563,6 +598,7 @@ class VirtualGPU : public device::VirtualDevice {
   //!< bit-vector representing the CU mask. Each active bit represents using one CU
   const std::vector<uint32_t> cuMask_;
   amd::CommandQueue::Priority priority_; //!< The priority for the hsa queue
+  const bool dedicatedQueue_;            //!< The hsa queue isn't shared with other queues
 
   cl_command_type copy_command_type_;   //!< Type of the copy command, used for ROC profiler
                                         //!< OCL doesn't distinguish diffrent copy types,
@@ -0,0 +1,174 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <device/devblitcache.hpp>
+#include <thread/thread.hpp>
+#include <utils/flags.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using amd::device::BlitCodeCache;
+
+// Stand-in for a device: the ISA and the blit build options
+struct FakeDevice {
+  std::string isa_;
+  std::string options_;
+};
+
+static const char* kSource = "__kernel void copy(__global int* a, __global int* b) {}";
+
+// Fake JIT: takes compileMs and returns a binary, which depends on the ISA
+struct FakeCompiler {
+  std::atomic<uint32_t> compiles_{0};
+  uint32_t compileMs_ = 0;
+  bool fail_ = false;
+
+  bool compile(const FakeDevice& device, std::string* binary) {
+    compiles_++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(compileMs_));
+    if (fail_) {
+      return false;
+    }
+    if (binary != nullptr) {
+      *binary = "ELF:" + device.isa_ + ":" + device.options_;
+    }
+    return true;
+  }
+};
+
+// The device initialization: the shared build or the compile on every device
+static bool createBlitPrograms(BlitCodeCache& cache, FakeCompiler& compiler,
+                               const std::vector<FakeDevice>& devices, bool share) {
+  for (const auto& device : devices) {
+    std::string binary;
+    if (share) {
+      const std::string key = BlitCodeCache::Key(device.isa_, device.options_, kSource);
+      if (!cache.getOrBuild(
+              key, [&](std::string* out) { return compiler.compile(device, out); }, &binary)) {
+        return false;
+      }
+    } else if (!compiler.compile(device, &binary)) {
+      return false;
+    }
+    if (binary != "ELF:" + device.isa_ + ":" + device.options_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+static bool testSharing() {
+  BlitCodeCache cache;
+  FakeCompiler compiler;
+  std::vector<FakeDevice> devices = {
+      {"gfx942", "-O3"}, {"gfx942", "-O3"}, {"gfx90a", "-O3"}, {"gfx942", "-O3"},
+      {"gfx90a", "-O3"}, {"gfx942", "-O3 -preload"}};
+  CHECK(createBlitPrograms(cache, compiler, devices, true));
+  // One compile per ISA and option set
+  CHECK(compiler.compiles_ == 3);
+  CHECK(cache.size() == 3);
+  CHECK(createBlitPrograms(cache, compiler, devices, true));
+  CHECK(compiler.compiles_ == 3);
+  return true;
+}
+
+static bool testFailure() {
+  BlitCodeCache cache;
+  FakeCompiler compiler;
+  std::vector<FakeDevice> devices = {{"gfx1100", "-O3"}};
+  compiler.fail_ = true;
+  CHECK(!createBlitPrograms(cache, compiler, devices, true));
+  CHECK(cache.size() == 0);
+  // The failure isn't cached, the next device compiles again
+  compiler.fail_ = false;
+  CHECK(createBlitPrograms(cache, compiler, devices, true));
+  CHECK(compiler.compiles_ == 2);
+  CHECK(cache.size() == 1);
+  return true;
+}
+
+// Devices initialized from several threads compile once per ISA
+static bool testConcurrent() {
+  BlitCodeCache cache;
+  FakeCompiler compiler;
+  compiler.compileMs_ = 5;
+  std::atomic<bool> failed(false);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < 8; ++i) {
+    threads.emplace_back([&, i]() {
+      if (amd::Thread::current() == nullptr) {
+        new amd::HostThread();
+      }
+      std::vector<FakeDevice> devices = {{(i & 1) ? "gfx942" : "gfx90a", "-O3"}};
+      if (!createBlitPrograms(cache, compiler, devices, true)) {
+        failed = true;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CHECK(!failed);
+  CHECK(compiler.compiles_ == 2);
+  return true;
+}
+
+// Startup of an 8 GPU node with one ISA, 20 ms per blit compile
+static bool measureStartup() {
+  std::vector<FakeDevice> devices(8, {"gfx942", "-O3"});
+  double seconds[2] = {};
+  for (int share = 0; share < 2; ++share) {
+    BlitCodeCache cache;
+    FakeCompiler compiler;
+    compiler.compileMs_ = 20;
+    auto start = std::chrono::steady_clock::now();
+    CHECK(createBlitPrograms(cache, compiler, devices, share != 0));
+    seconds[share] =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+  printf("measureStartup: 8 devices, %.1f ms shared (%.1f ms compiled per device)\n",
+         seconds[1] * 1e3, seconds[0] * 1e3);
+  CHECK(seconds[1] < seconds[0]);
+  return true;
+}
+
+int main() {
+  amd::Flag::init();
+  if (amd::Thread::current() == nullptr) {
+    new amd::HostThread();
+  }
+  bool passed = true;
+  passed &= testSharing();
+  passed &= testFailure();
+  passed &= testConcurrent();
+  passed &= measureStartup();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
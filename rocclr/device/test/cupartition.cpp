@@ -0,0 +1,155 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <device/devcupartition.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+using amd::device::CuCountFromFraction;
+using amd::device::CuShaderEngine;
+using amd::device::CuTopology;
+using amd::device::CuXcc;
+using amd::device::PartitionCUs;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+static bool isSet(const std::vector<uint32_t>& mask, uint32_t cu) {
+  return (mask[cu / 32] >> (cu % 32)) & 1;
+}
+
+// Checks the pools are disjoint, have the requested sizes and are balanced over the XCCs and SEs
+static bool checkPools(const CuTopology& topo, const std::vector<uint32_t>& counts,
+                       const std::vector<std::vector<uint32_t>>& masks) {
+  CHECK(masks.size() == counts.size());
+  std::vector<int> owner(topo.numCUs_, -1);
+  for (size_t pool = 0; pool < masks.size(); ++pool) {
+    CHECK(masks[pool].size() == (topo.numCUs_ + 31) / 32);
+    std::vector<uint32_t> perSe(topo.numSEs_, 0);
+    std::vector<uint32_t> perXcc(topo.numXccs_, 0);
+    uint32_t count = 0;
+    for (uint32_t cu = 0; cu < masks[pool].size() * 32; ++cu) {
+      if (!isSet(masks[pool], cu)) {
+        continue;
+      }
+      CHECK(cu < topo.numCUs_);
+      CHECK(owner[cu] == -1);
+      owner[cu] = static_cast<int>(pool);
+      ++perSe[CuShaderEngine(topo, cu)];
+      ++perXcc[CuXcc(topo, cu)];
+      ++count;
+    }
+    CHECK(count == counts[pool]);
+    // Every XCC gets the same share of the pool, give or take a CU
+    uint32_t minXcc = *std::min_element(perXcc.begin(), perXcc.end());
+    uint32_t maxXcc = *std::max_element(perXcc.begin(), perXcc.end());
+    CHECK(maxXcc - minXcc <= 1);
+    // The same applies to the SEs of an XCC
+    uint32_t sesPerXcc = topo.numSEs_ / topo.numXccs_;
+    for (uint32_t xcc = 0; xcc < topo.numXccs_; ++xcc) {
+      auto first = perSe.begin() + xcc * sesPerXcc;
+      uint32_t minSe = *std::min_element(first, first + sesPerXcc);
+      uint32_t maxSe = *std::max_element(first, first + sesPerXcc);
+      CHECK(maxSe - minSe <= 1);
+    }
+  }
+  return true;
+}
+
+// A single die with the SEs interleaved in the mask
+static bool testSingleXcc() {
+  CuTopology topo = {60, 4, 1};
+  CHECK(CuShaderEngine(topo, 0) == 0);
+  CHECK(CuShaderEngine(topo, 5) == 1);
+  CHECK(CuXcc(topo, 59) == 0);
+  std::vector<uint32_t> counts = {16, 30, 14};
+  std::vector<std::vector<uint32_t>> masks;
+  CHECK(PartitionCUs(topo, counts, &masks));
+  CHECK(checkPools(topo, counts, masks));
+  // The first pool takes the first bits, which alternate the SEs
+  CHECK(masks[0][0] == 0xffff);
+  return true;
+}
+
+// Multiple XCCs with 4 SEs each
+static bool testMultiXcc() {
+  CuTopology topo = {304, 32, 8};
+  CHECK(CuXcc(topo, 37) == 0);
+  CHECK(CuXcc(topo, 38) == 1);
+  CHECK(CuShaderEngine(topo, 38) == 4);
+  CHECK(CuShaderEngine(topo, 41) == 7);
+  std::vector<uint32_t> counts = {8, 100, 13, 183};
+  std::vector<std::vector<uint32_t>> masks;
+  CHECK(PartitionCUs(topo, counts, &masks));
+  CHECK(checkPools(topo, counts, masks));
+  // A pool of a CU per XCC takes the first CU of every XCC
+  for (uint32_t xcc = 0; xcc < 8; ++xcc) {
+    CHECK(isSet(masks[0], xcc * 38));
+  }
+  return true;
+}
+
+// The CUs above the last full XCC are handed out last
+static bool testUnevenXcc() {
+  CuTopology topo = {10, 2, 3};
+  std::vector<uint32_t> counts = {9, 1};
+  std::vector<std::vector<uint32_t>> masks;
+  CHECK(PartitionCUs(topo, counts, &masks));
+  CHECK(masks[1][0] == (1u << 9));
+  CHECK(CuXcc(topo, 9) == 2);
+  return true;
+}
+
+static bool testInvalid() {
+  CuTopology topo = {60, 4, 1};
+  std::vector<std::vector<uint32_t>> masks;
+  CHECK(!PartitionCUs(topo, {30, 31}, &masks));
+  CHECK(!PartitionCUs(topo, {30, 0}, &masks));
+  CHECK(PartitionCUs(topo, {}, &masks));
+  CHECK(masks.empty());
+  return true;
+}
+
+static bool testFraction() {
+  CuTopology topo = {60, 4, 1};
+  CHECK(CuCountFromFraction(topo, 0.25) == 15);
+  CHECK(CuCountFromFraction(topo, 1.0) == 60);
+  CHECK(CuCountFromFraction(topo, 0.001) == 1);
+  CHECK(CuCountFromFraction(topo, 0.0) == 0);
+  CHECK(CuCountFromFraction(topo, 1.5) == 0);
+  CHECK(CuCountFromFraction(topo, -0.5) == 0);
+  return true;
+}
+
+int main() {
+  bool passed = true;
+  passed &= testSingleXcc();
+  passed &= testMultiXcc();
+  passed &= testUnevenXcc();
+  passed &= testInvalid();
+  passed &= testFraction();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
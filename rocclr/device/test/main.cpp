@@ -0,0 +1,404 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <device/devmeminfo.hpp>
+#include <thread/thread.hpp>
+#include <utils/flags.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+static constexpr size_t TotalMemory = 1024 * Mi;
+
+// Fake allocation backend: the driver sees the runtime allocations and the memory,
+// which other processes use
+struct FakeDriver {
+  std::atomic<size_t> allocated_{0};
+  std::atomic<size_t> external_{0};
+  std::atomic<uint32_t> queries_{0};
+  bool fail_ = false;
+
+  bool queryFree(size_t* freeBytes) {
+    queries_++;
+    if (fail_) {
+      return false;
+    }
+    *freeBytes = TotalMemory - allocated_ - external_;
+    return true;
+  }
+
+  void allocate(amd::device::MemoryAccounting& accounting, size_t size) {
+    allocated_ += size;
+    accounting.allocate(size);
+  }
+
+  void release(amd::device::MemoryAccounting& accounting, size_t size) {
+    allocated_ -= size;
+    accounting.release(size);
+  }
+};
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+static amd::device::MemoryAccounting* create(FakeDriver& driver, uint64_t intervalNs) {
+  return new amd::device::MemoryAccounting(
+      TotalMemory, [&driver](size_t* freeBytes) { return driver.queryFree(freeBytes); },
+      intervalNs);
+}
+
+// The runtime allocations are visible at once, the external ones only after a reconcile
+static bool testReconcile() {
+  FakeDriver driver;
+  driver.external_ = 100 * Mi;
+  amd::device::MemoryAccounting* accounting = create(driver, ~0ull >> 1);
+  size_t freeBytes = 0;
+
+  // The first query always goes to the driver
+  CHECK(accounting->freeMemory(&freeBytes));
+  CHECK(freeBytes == TotalMemory - 100 * Mi);
+  CHECK(driver.queries_ == 1);
+
+  driver.allocate(*accounting, 200 * Mi);
+  driver.external_ = 300 * Mi;
+  CHECK(accounting->freeMemory(&freeBytes));
+  CHECK(freeBytes == TotalMemory - 300 * Mi);
+  CHECK(driver.queries_ == 1);
+
+  CHECK(accounting->reconcile());
+  CHECK(accounting->freeMemory(&freeBytes));
+  CHECK(freeBytes == TotalMemory - 500 * Mi);
+  CHECK(accounting->allocated() == 200 * Mi);
+
+  driver.release(*accounting, 200 * Mi);
+  CHECK(accounting->freeMemory(&freeBytes));
+  CHECK(freeBytes == TotalMemory - 300 * Mi);
+  CHECK(accounting->allocated() == 0);
+
+  // Releases of the memory the runtime didn't see don't underflow
+  accounting->release(Mi);
+  CHECK(accounting->allocated() == 0);
+  delete accounting;
+  return true;
+}
+
+// The zero interval queries the driver on every call
+static bool testNoCache() {
+  FakeDriver driver;
+  amd::device::MemoryAccounting* accounting = create(driver, 0);
+  size_t freeBytes = 0;
+  for (uint32_t i = 1; i <= 10; ++i) {
+    driver.external_ = i * Mi;
+    CHECK(accounting->freeMemory(&freeBytes));
+    CHECK(freeBytes == TotalMemory - i * Mi);
+    CHECK(driver.queries_ == i);
+  }
+  driver.fail_ = true;
+  CHECK(!accounting->freeMemory(&freeBytes));
+  delete accounting;
+  return true;
+}
+
+// A failed first query can't be served from the counters
+static bool testDriverFailure() {
+  FakeDriver driver;
+  driver.fail_ = true;
+  amd::device::MemoryAccounting* accounting = create(driver, ~0ull >> 1);
+  size_t freeBytes = 0;
+  CHECK(!accounting->freeMemory(&freeBytes));
+  driver.fail_ = false;
+  CHECK(accounting->freeMemory(&freeBytes));
+  CHECK(freeBytes == TotalMemory);
+  delete accounting;
+  return true;
+}
+
+// Concurrent allocations and releases keep the totals consistent with the driver
+static bool testThreads(uint32_t threads, uint32_t iterations) {
+  FakeDriver driver;
+  driver.external_ = 64 * Mi;
+  // Short interval, so the reconcile runs concurrently with the updates
+  amd::device::MemoryAccounting* accounting = create(driver, 10000);
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> workers;
+  for (uint32_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]() {
+      std::mt19937 random(t);
+      std::vector<size_t> sizes;
+      for (uint32_t i = 0; i < iterations; ++i) {
+        if (sizes.empty() || ((random() % 3) != 0)) {
+          const size_t size = (random() % 64 + 1) * 4096;
+          sizes.push_back(size);
+          driver.allocate(*accounting, size);
+        } else {
+          driver.release(*accounting, sizes.back());
+          sizes.pop_back();
+        }
+        size_t freeBytes = 0;
+        if (!accounting->freeMemory(&freeBytes) || (freeBytes > TotalMemory)) {
+          failed = true;
+        }
+      }
+      for (auto size : sizes) {
+        driver.release(*accounting, size);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  CHECK(!failed);
+  CHECK(accounting->allocated() == 0);
+  size_t freeBytes = 0;
+  CHECK(accounting->reconcile());
+  CHECK(accounting->freeMemory(&freeBytes));
+  CHECK(freeBytes == TotalMemory - 64 * Mi);
+  delete accounting;
+  return true;
+}
+
+struct Notification {
+  size_t free_;
+  int belowLow_;
+};
+
+static void watermarkCallback(size_t freeBytes, int belowLow, void* data) {
+  reinterpret_cast<std::vector<Notification>*>(data)->push_back({freeBytes, belowLow});
+}
+
+// The notifications are sent only on the crossing and keep the hysteresis
+static bool testWatermarks() {
+  FakeDriver driver;
+  amd::device::MemoryAccounting* accounting = create(driver, ~0ull >> 1);
+  std::vector<Notification> notifications;
+  size_t freeBytes = 0;
+  CHECK(accounting->freeMemory(&freeBytes));
+  accounting->setWatermarks(256 * Mi, 512 * Mi, watermarkCallback, &notifications);
+
+  driver.allocate(*accounting, 600 * Mi);
+  CHECK(notifications.empty());
+  driver.allocate(*accounting, 200 * Mi);
+  CHECK(notifications.size() == 1);
+  CHECK(notifications[0].belowLow_ == 1);
+  CHECK(notifications[0].free_ == TotalMemory - 800 * Mi);
+  driver.allocate(*accounting, 100 * Mi);
+  CHECK(notifications.size() == 1);
+
+  // Between the watermarks nothing changes
+  driver.release(*accounting, 350 * Mi);
+  CHECK(notifications.size() == 1);
+  driver.allocate(*accounting, 100 * Mi);
+  CHECK(notifications.size() == 1);
+
+  driver.release(*accounting, 300 * Mi);
+  CHECK(notifications.size() == 2);
+  CHECK(notifications[1].belowLow_ == 0);
+  CHECK(notifications[1].free_ == TotalMemory - 350 * Mi);
+
+  // External memory is detected on the reconcile
+  driver.external_ = 700 * Mi;
+  CHECK(accounting->reconcile());
+  CHECK(notifications.size() == 3);
+  CHECK(notifications[2].belowLow_ == 1);
+
+  accounting->setWatermarks(0, 0, nullptr, nullptr);
+  driver.external_ = 0;
+  CHECK(accounting->reconcile());
+  CHECK(notifications.size() == 3);
+  delete accounting;
+  return true;
+}
+
+// The watermark callback frees memory on another thread, as a tool trimming its caches does.
+// The release checks the watermarks too, so it must not wait for the callback.
+struct Trimmer {
+  FakeDriver* driver_;
+  amd::device::MemoryAccounting* accounting_;
+  std::vector<Notification> notifications_;
+};
+
+static void trimCallback(size_t freeBytes, int belowLow, void* data) {
+  Trimmer* trimmer = reinterpret_cast<Trimmer*>(data);
+  trimmer->notifications_.push_back({freeBytes, belowLow});
+  if (belowLow == 1) {
+    std::thread worker([trimmer]() {
+      // The runtime locks need an amd::Thread, as an API call creates it for the application
+      if (amd::Thread::current() == nullptr) {
+        new amd::HostThread();
+      }
+      trimmer->driver_->release(*trimmer->accounting_, 500 * Mi);
+    });
+    worker.join();
+  }
+}
+
+static bool testWatermarkReentrant() {
+  FakeDriver driver;
+  amd::device::MemoryAccounting* accounting = create(driver, ~0ull >> 1);
+  size_t freeBytes = 0;
+  CHECK(accounting->freeMemory(&freeBytes));
+  Trimmer trimmer = {&driver, accounting, {}};
+  accounting->setWatermarks(256 * Mi, 512 * Mi, trimCallback, &trimmer);
+
+  driver.allocate(*accounting, 800 * Mi);
+  // The release in the callback crosses the high watermark, which is delivered after the return
+  CHECK(trimmer.notifications_.size() == 2);
+  CHECK(trimmer.notifications_[0].belowLow_ == 1);
+  CHECK(trimmer.notifications_[0].free_ == TotalMemory - 800 * Mi);
+  CHECK(trimmer.notifications_[1].belowLow_ == 0);
+  CHECK(trimmer.notifications_[1].free_ == TotalMemory - 300 * Mi);
+  CHECK(accounting->allocated() == 300 * Mi);
+  accounting->setWatermarks(0, 0, nullptr, nullptr);
+  delete accounting;
+  return true;
+}
+
+// Fake buffer on top of the accounting, which follows the rules of the ROCm backend buffers
+struct FakeBuffer {
+  FakeBuffer(amd::device::MemoryAccounting& accounting, size_t size,
+             amd::device::MemoryAccounting::Origin origin)
+      : accounting_(accounting), size_(size), origin_(origin) {
+    if (amd::device::MemoryAccounting::counted(origin_)) {
+      accounting_.allocate(size_);
+    }
+  }
+  ~FakeBuffer() {
+    if (amd::device::MemoryAccounting::counted(origin_)) {
+      accounting_.release(size_);
+    }
+  }
+  amd::device::MemoryAccounting& accounting_;
+  const size_t size_;
+  const amd::device::MemoryAccounting::Origin origin_;
+};
+
+// Checks the free memory of the counters against the driver without a reconcile
+static bool matchesDriver(FakeDriver& driver, amd::device::MemoryAccounting* accounting) {
+  size_t freeBytes = 0;
+  size_t driverFree = 0;
+  uint32_t queries = driver.queries_;
+  CHECK(accounting->freeMemory(&freeBytes));
+  CHECK(driver.queries_ == queries);
+  CHECK(driver.queryFree(&driverFree));
+  CHECK(freeBytes == driverFree);
+  return true;
+}
+
+// A physical allocation is counted on creation and release. The mappings of it are views,
+// so mapping and unmapping neither change the free memory nor cross the watermarks
+static bool testPhysicalMappings() {
+  using Origin = amd::device::MemoryAccounting::Origin;
+  FakeDriver driver;
+  amd::device::MemoryAccounting* accounting = create(driver, ~0ull >> 1);
+  std::vector<Notification> notifications;
+  size_t freeBytes = 0;
+  CHECK(accounting->freeMemory(&freeBytes));
+  accounting->setWatermarks(256 * Mi, 512 * Mi, watermarkCallback, &notifications);
+
+  // hipMemCreate
+  driver.allocated_ += 800 * Mi;
+  FakeBuffer* physical = new FakeBuffer(*accounting, 800 * Mi, Origin::kPhysical);
+  CHECK(matchesDriver(driver, accounting));
+  CHECK(notifications.size() == 1);
+  CHECK(notifications[0].belowLow_ == 1);
+
+  // hipMemMap of the handle twice, the driver doesn't allocate anything
+  FakeBuffer* view0 = new FakeBuffer(*accounting, 800 * Mi, Origin::kView);
+  FakeBuffer* view1 = new FakeBuffer(*accounting, 800 * Mi, Origin::kView);
+  CHECK(matchesDriver(driver, accounting));
+  CHECK(accounting->allocated() == 800 * Mi);
+  CHECK(notifications.size() == 1);
+
+  // hipMemUnmap
+  delete view0;
+  delete view1;
+  CHECK(matchesDriver(driver, accounting));
+  CHECK(accounting->allocated() == 800 * Mi);
+  CHECK(notifications.size() == 1);
+
+  // hipMemRelease
+  driver.allocated_ -= 800 * Mi;
+  delete physical;
+  CHECK(matchesDriver(driver, accounting));
+  CHECK(accounting->allocated() == 0);
+  CHECK(notifications.size() == 2);
+  CHECK(notifications[1].belowLow_ == 0);
+
+  accounting->setWatermarks(0, 0, nullptr, nullptr);
+  delete accounting;
+  return true;
+}
+
+// The imported memory belongs to another process, which the reconcile accounts for. Opening
+// and closing the import leave the counters alone
+static bool testImports() {
+  using Origin = amd::device::MemoryAccounting::Origin;
+  FakeDriver driver;
+  driver.external_ = 700 * Mi;
+  amd::device::MemoryAccounting* accounting = create(driver, ~0ull >> 1);
+  std::vector<Notification> notifications;
+  size_t freeBytes = 0;
+  CHECK(accounting->freeMemory(&freeBytes));
+  accounting->setWatermarks(256 * Mi, 512 * Mi, watermarkCallback, &notifications);
+
+  // hipIpcOpenMemHandle and hipMemImportFromShareableHandle
+  FakeBuffer* ipc = new FakeBuffer(*accounting, 300 * Mi, Origin::kView);
+  FakeBuffer* imported = new FakeBuffer(*accounting, 400 * Mi, Origin::kImported);
+  CHECK(matchesDriver(driver, accounting));
+  CHECK(accounting->allocated() == 0);
+
+  // hipIpcCloseMemHandle and hipMemRelease of the imported handle
+  delete ipc;
+  delete imported;
+  CHECK(matchesDriver(driver, accounting));
+  CHECK(accounting->allocated() == 0);
+  CHECK(notifications.empty());
+
+  // The exporting process frees its memory, the reconcile picks it up
+  driver.external_ = 0;
+  CHECK(accounting->reconcile());
+  CHECK(matchesDriver(driver, accounting));
+  CHECK(notifications.size() == 1);
+  CHECK(notifications[0].belowLow_ == 0);
+
+  accounting->setWatermarks(0, 0, nullptr, nullptr);
+  delete accounting;
+  return true;
+}
+
+int main() {
+  bool passed = true;
+  passed &= testReconcile();
+  passed &= testNoCache();
+  passed &= testDriverFailure();
+  passed &= testThreads(8, 100000);
+  passed &= testWatermarks();
+  passed &= testWatermarkReentrant();
+  passed &= testPhysicalMappings();
+  passed &= testImports();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
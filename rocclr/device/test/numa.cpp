@@ -0,0 +1,72 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <device/devnuma.hpp>
+#include <utils/flags.hpp>
+
+#include <cstdio>
+#include <vector>
+
+using amd::device::kNumaDistanceUnknown;
+using amd::device::SelectNumaNode;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+// Two sockets, the GPU hangs off the second one
+static bool testNearest() {
+  std::vector<uint32_t> distances = {32, 12};
+  CHECK(SelectNumaNode(distances, -1) == 1);
+  // The lowest node wins the ties
+  distances = {20, 12, 12, 32};
+  CHECK(SelectNumaNode(distances, -1) == 1);
+  return true;
+}
+
+// Nodes without the link info are skipped, node 0 is the fallback
+static bool testUnknownDistance() {
+  std::vector<uint32_t> distances = {kNumaDistanceUnknown, 20, kNumaDistanceUnknown};
+  CHECK(SelectNumaNode(distances, -1) == 1);
+  distances = {kNumaDistanceUnknown, kNumaDistanceUnknown};
+  CHECK(SelectNumaNode(distances, -1) == 0);
+  CHECK(SelectNumaNode({}, -1) == 0);
+  return true;
+}
+
+static bool testOverride() {
+  std::vector<uint32_t> distances = {32, 12, 32, 32};
+  CHECK(SelectNumaNode(distances, 3) == 3);
+  CHECK(SelectNumaNode(distances, 0) == 0);
+  // An invalid node falls back to the nearest one
+  CHECK(SelectNumaNode(distances, 4) == 1);
+  return true;
+}
+
+int main() {
+  bool passed = true;
+  passed &= testNearest();
+  passed &= testUnknownDistance();
+  passed &= testOverride();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,236 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <device/devrecyclepool.hpp>
+#include <thread/thread.hpp>
+#include <utils/flags.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using amd::device::QueueRecyclePool;
+using amd::device::QueueTraits;
+
+// Stand-in for a virtual GPU: the traits and the cost of the creation
+struct FakeVgpu {
+  QueueTraits traits_;
+  uint32_t uses_ = 1;
+};
+
+// Stand-in for a device: creates the virtual GPUs of the queues and recycles them
+struct FakeDevice {
+  QueueRecyclePool<FakeVgpu> pool_;
+  std::atomic<uint32_t> creates_{0};
+  std::atomic<uint32_t> destroys_{0};
+  uint32_t createUs_ = 0;
+  bool recycle_ = true;
+
+  explicit FakeDevice(size_t capacity) : pool_(capacity) {}
+  ~FakeDevice() { pool_.drain([this](FakeVgpu* vgpu) { destroy(vgpu); }); }
+
+  FakeVgpu* createVirtualDevice(const QueueTraits& traits) {
+    FakeVgpu* vgpu = recycle_ ? pool_.acquire(traits) : nullptr;
+    if (vgpu != nullptr) {
+      vgpu->uses_++;
+      return vgpu;
+    }
+    creates_++;
+    std::this_thread::sleep_for(std::chrono::microseconds(createUs_));
+    return new FakeVgpu{traits};
+  }
+
+  void releaseVirtualDevice(FakeVgpu* vgpu) {
+    if (!recycle_ || !pool_.recycle(vgpu->traits_, vgpu)) {
+      destroy(vgpu);
+    }
+  }
+
+  void destroy(FakeVgpu* vgpu) {
+    destroys_++;
+    delete vgpu;
+  }
+};
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+static const QueueTraits kNormal = {1, false, {}};
+static const QueueTraits kHigh = {2, false, {}};
+static const QueueTraits kProfiling = {1, true, {}};
+static const QueueTraits kMasked = {1, false, {0x0000ffff}};
+static const QueueTraits kDedicated = {1, false, {}, true};
+
+// A destroyed queue serves the next queue with the same traits only
+static bool testMatching() {
+  FakeDevice device(4);
+  FakeVgpu* normal = device.createVirtualDevice(kNormal);
+  CHECK(device.pool_.misses() == 1);
+  device.releaseVirtualDevice(normal);
+  CHECK(device.pool_.size() == 1);
+
+  CHECK(device.pool_.acquire(kHigh) == nullptr);
+  CHECK(device.pool_.acquire(kProfiling) == nullptr);
+  CHECK(device.pool_.acquire(kMasked) == nullptr);
+  CHECK(device.pool_.acquire(kDedicated) == nullptr);
+  CHECK(device.pool_.acquire(QueueTraits{1, false, {0x0000ff00}}) == nullptr);
+
+  FakeVgpu* reused = device.createVirtualDevice(kNormal);
+  CHECK(reused == normal);
+  CHECK(reused->uses_ == 2);
+  CHECK(device.pool_.hits() == 1);
+  CHECK(device.pool_.size() == 0);
+  CHECK(device.creates_ == 1);
+
+  FakeVgpu* masked = device.createVirtualDevice(kMasked);
+  device.releaseVirtualDevice(masked);
+  CHECK(device.createVirtualDevice(kMasked) == masked);
+  device.releaseVirtualDevice(masked);
+
+  // A dedicated queue goes to the next dedicated queue only
+  FakeVgpu* dedicated = device.createVirtualDevice(kDedicated);
+  device.releaseVirtualDevice(dedicated);
+  CHECK(device.pool_.acquire(kNormal) == nullptr);
+  CHECK(device.createVirtualDevice(kDedicated) == dedicated);
+  device.releaseVirtualDevice(dedicated);
+  device.releaseVirtualDevice(reused);
+  return true;
+}
+
+// The latest recycled queue goes first and the pool doesn't grow over the capacity
+static bool testCapacity() {
+  FakeDevice device(2);
+  FakeVgpu* vgpus[3];
+  for (auto& vgpu : vgpus) {
+    vgpu = device.createVirtualDevice(kNormal);
+  }
+  for (auto& vgpu : vgpus) {
+    device.releaseVirtualDevice(vgpu);
+  }
+  CHECK(device.pool_.size() == 2);
+  CHECK(device.destroys_ == 1);
+  CHECK(device.pool_.acquire(kNormal) == vgpus[1]);
+  CHECK(device.pool_.acquire(kNormal) == vgpus[0]);
+  CHECK(device.pool_.acquire(kNormal) == nullptr);
+  device.releaseVirtualDevice(vgpus[0]);
+  device.releaseVirtualDevice(vgpus[1]);
+
+  // A disabled pool destroys every queue
+  FakeDevice disabled(0);
+  disabled.releaseVirtualDevice(disabled.createVirtualDevice(kNormal));
+  CHECK(disabled.pool_.size() == 0);
+  CHECK(disabled.destroys_ == 1);
+  return true;
+}
+
+// The device destruction releases the pooled queues
+static bool testDrain() {
+  std::atomic<uint32_t> destroys(0);
+  {
+    FakeDevice device(4);
+    device.releaseVirtualDevice(device.createVirtualDevice(kNormal));
+    device.releaseVirtualDevice(device.createVirtualDevice(kHigh));
+    CHECK(device.pool_.size() == 2);
+    device.pool_.drain([&](FakeVgpu* vgpu) {
+      destroys++;
+      delete vgpu;
+    });
+    CHECK(device.pool_.size() == 0);
+  }
+  CHECK(destroys == 2);
+  return true;
+}
+
+// Streams created and destroyed from several threads never share a queue
+static bool testConcurrent() {
+  FakeDevice device(4);
+  std::atomic<bool> failed(false);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < 8; ++i) {
+    threads.emplace_back([&, i]() {
+      if (amd::Thread::current() == nullptr) {
+        new amd::HostThread();
+      }
+      const QueueTraits& traits = (i & 1) ? kHigh : kNormal;
+      for (uint32_t j = 0; j < 1000; ++j) {
+        FakeVgpu* vgpu = device.createVirtualDevice(traits);
+        if (!(vgpu->traits_ == traits)) {
+          failed = true;
+        }
+        // Mark the queue busy, a shared queue would see the mark of another thread
+        vgpu->traits_.cuMask_.push_back(i);
+        if (vgpu->traits_.cuMask_.size() != 1) {
+          failed = true;
+        }
+        vgpu->traits_.cuMask_.clear();
+        device.releaseVirtualDevice(vgpu);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CHECK(!failed);
+  // At most one live queue per thread, plus the pooled ones
+  CHECK(device.creates_ <= 8 + 4);
+  CHECK(device.pool_.hits() + device.pool_.misses() == 8000);
+  return true;
+}
+
+// Create/destroy loop of short lived streams, 200 us per queue creation
+static bool measureCreateDestroy() {
+  constexpr uint32_t kStreams = 200;
+  double seconds[2] = {};
+  for (int recycle = 0; recycle < 2; ++recycle) {
+    FakeDevice device(4);
+    device.createUs_ = 200;
+    device.recycle_ = (recycle != 0);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < kStreams; ++i) {
+      device.releaseVirtualDevice(device.createVirtualDevice(kNormal));
+    }
+    seconds[recycle] =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+  printf("measureCreateDestroy: %u streams, %.1f us per stream recycled (%.1f us created)\n",
+         kStreams, seconds[1] * 1e6 / kStreams, seconds[0] * 1e6 / kStreams);
+  CHECK(seconds[1] < seconds[0]);
+  return true;
+}
+
+int main() {
+  amd::Flag::init();
+  if (amd::Thread::current() == nullptr) {
+    new amd::HostThread();
+  }
+  bool passed = true;
+  passed &= testMatching();
+  passed &= testCapacity();
+  passed &= testDrain();
+  passed &= testConcurrent();
+  passed &= measureCreateDestroy();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
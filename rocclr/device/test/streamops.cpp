@@ -0,0 +1,103 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <device/devstreamops.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using amd::device::LowerStreamOps;
+using amd::device::StreamOpKind;
+using amd::device::StreamOpsLowering;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+// Records the dispatched packets as "R" for a release barrier, "V<op>" for a barrier-value
+// packet, "K<op>" for a wait kernel and "W<op>" for a write kernel
+class Recorder : public StreamOpsLowering {
+ public:
+  void releaseBarrier() override { packets_ += "R "; }
+  void waitBarrierValue(size_t op) override { packets_ += "V" + std::to_string(op) + " "; }
+  void waitKernel(size_t op) override { packets_ += "K" + std::to_string(op) + " "; }
+  void writeKernel(size_t op) override { packets_ += "W" + std::to_string(op) + " "; }
+
+  std::string packets_;
+};
+
+static std::string lower(const std::vector<StreamOpKind>& ops, bool cpWait, size_t* count) {
+  Recorder recorder;
+  *count = LowerStreamOps(ops, cpWait, &recorder);
+  return recorder.packets_;
+}
+
+// A run of writes shares a single release barrier
+static bool testWrites() {
+  size_t count = 0;
+  std::vector<StreamOpKind> ops(4, StreamOpKind::Write);
+  CHECK(lower(ops, false, &count) == "R W0 W1 W2 W3 ");
+  CHECK(count == 5);
+  ops = {StreamOpKind::Write, StreamOpKind::Wait, StreamOpKind::Write};
+  CHECK(lower(ops, false, &count) == "R W0 K1 W2 ");
+  CHECK(count == 4);
+  return true;
+}
+
+// The waits on signal memory use the CP, the others fall back to the blit kernel
+static bool testWaits() {
+  size_t count = 0;
+  std::vector<StreamOpKind> ops = {StreamOpKind::SignalWait, StreamOpKind::Wait,
+                                   StreamOpKind::SignalWait};
+  CHECK(lower(ops, true, &count) == "V0 K1 V2 ");
+  CHECK(count == 3);
+  CHECK(lower(ops, false, &count) == "K0 K1 K2 ");
+  CHECK(count == 3);
+  return true;
+}
+
+// The adjacent barriers are merged with each other and with the release of the next write
+static bool testBarriers() {
+  size_t count = 0;
+  std::vector<StreamOpKind> ops = {StreamOpKind::Barrier, StreamOpKind::Barrier,
+                                   StreamOpKind::Write, StreamOpKind::Barrier,
+                                   StreamOpKind::Write};
+  CHECK(lower(ops, false, &count) == "R W2 R W4 ");
+  CHECK(count == 4);
+  ops = {StreamOpKind::Write, StreamOpKind::Barrier, StreamOpKind::SignalWait,
+         StreamOpKind::Barrier, StreamOpKind::Barrier};
+  CHECK(lower(ops, true, &count) == "R W0 R V2 R ");
+  CHECK(count == 5);
+  CHECK(lower({}, true, &count).empty());
+  CHECK(count == 0);
+  return true;
+}
+
+int main() {
+  bool passed = true;
+  passed &= testWrites();
+  passed &= testWaits();
+  passed &= testBarriers();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <device/devsvmbatch.hpp>
+
+#include <cstdio>
+#include <vector>
+
+using amd::device::PlanSvmBatch;
+using amd::device::SvmBatchRange;
+using amd::device::SvmBatchRun;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+static constexpr uintptr_t kBase = 0x7f0000000000ull;
+static constexpr size_t kPage = 4096;
+
+static SvmBatchRange range(size_t page, size_t pages, uint64_t key, uint64_t value) {
+  return {kBase + page * kPage, pages * kPage, key, value};
+}
+
+static bool isRun(const SvmBatchRun& run, size_t page, size_t pages, uint64_t key,
+                  uint64_t value) {
+  return (run.start_ == kBase + page * kPage) && (run.size_ == pages * kPage) &&
+         (run.key_ == key) && (run.value_ == value);
+}
+
+// The adjacent and the overlapping ranges with the same value merge, a gap splits them
+static bool testMerge() {
+  auto runs = PlanSvmBatch({range(4, 4, 0, 1), range(0, 4, 0, 1), range(6, 4, 0, 1),
+                            range(12, 2, 0, 1)});
+  CHECK(runs.size() == 2);
+  CHECK(isRun(runs[0], 0, 10, 0, 1));
+  CHECK(isRun(runs[1], 12, 2, 0, 1));
+  return true;
+}
+
+// A later range overrides the overlapped part of the earlier ones
+static bool testOverride() {
+  auto runs = PlanSvmBatch({range(0, 8, 0, 1), range(2, 2, 0, 2), range(3, 4, 0, 1)});
+  CHECK(runs.size() == 3);
+  CHECK(isRun(runs[0], 0, 2, 0, 1));
+  CHECK(isRun(runs[1], 2, 1, 0, 2));
+  CHECK(isRun(runs[2], 3, 5, 0, 1));
+
+  // A fully overridden range is dropped
+  runs = PlanSvmBatch({range(2, 2, 0, 2), range(0, 8, 0, 3)});
+  CHECK(runs.size() == 1);
+  CHECK(isRun(runs[0], 0, 8, 0, 3));
+
+  // The empty ranges are ignored
+  runs = PlanSvmBatch({range(0, 0, 0, 2), range(1, 1, 0, 3)});
+  CHECK(runs.size() == 1);
+  CHECK(isRun(runs[0], 1, 1, 0, 3));
+  return true;
+}
+
+// The ranges with different keys don't override each other and the runs over the same bytes
+// are next to each other
+static bool testKeys() {
+  auto runs = PlanSvmBatch({range(0, 4, 2, 7), range(0, 4, 1, 5), range(4, 4, 1, 5),
+                            range(0, 2, 2, 8)});
+  CHECK(runs.size() == 3);
+  CHECK(isRun(runs[0], 0, 2, 2, 8));
+  CHECK(isRun(runs[1], 0, 8, 1, 5));
+  CHECK(isRun(runs[2], 2, 2, 2, 7));
+
+  // The runs of different keys with the same bytes are sorted by key
+  runs = PlanSvmBatch({range(0, 4, 3, 1), range(0, 4, 1, 1)});
+  CHECK(runs.size() == 2);
+  CHECK(isRun(runs[0], 0, 4, 1, 1));
+  CHECK(isRun(runs[1], 0, 4, 3, 1));
+  return true;
+}
+
+// An optimizer step prefetches the parameter shards in a shuffled order, some of them twice.
+// Reports the number of the resulting prefetches
+static bool measureShards() {
+  constexpr size_t kShards = 512;
+  std::vector<SvmBatchRange> ranges;
+  for (size_t i = 0; i < kShards; ++i) {
+    size_t shard = (i * 7) % kShards;
+    ranges.push_back(range(shard * 16, 16, 0, 1));
+    if (i % 8 == 0) {
+      ranges.push_back(range(shard * 16, 16, 0, 1));
+    }
+  }
+  // The last shards go to the other device
+  for (size_t shard = kShards - 64; shard < kShards; ++shard) {
+    ranges.push_back(range(shard * 16, 16, 0, 2));
+  }
+  auto runs = PlanSvmBatch(ranges);
+  printf("%zu prefetches of %zu shards merged into %zu ranges\n", ranges.size(), kShards,
+         runs.size());
+  CHECK(runs.size() == 2);
+  CHECK(isRun(runs[0], 0, (kShards - 64) * 16, 0, 1));
+  CHECK(isRun(runs[1], (kShards - 64) * 16, 64 * 16, 0, 2));
+  return true;
+}
+
+int main() {
+  bool passed = true;
+  passed &= testMerge();
+  passed &= testOverride();
+  passed &= testKeys();
+  passed &= measureShards();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,230 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <device/devvirtualmap.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using amd::device::LowerVirtualMap;
+using amd::device::PlanVirtualMap;
+using amd::device::VirtualMapLowering;
+using amd::device::VirtualMapRange;
+using amd::device::VirtualMapRun;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+static constexpr uintptr_t kBase = 0x100000000ull;
+static constexpr size_t kChunk = 2 * 1024 * 1024;
+
+// A fake physical allocation, only the address matters
+static amd::Memory* const kPhys = reinterpret_cast<amd::Memory*>(0x1000);
+
+static VirtualMapRange range(size_t chunk, size_t chunks, bool map, size_t index) {
+  return {reinterpret_cast<void*>(kBase + chunk * kChunk), chunks * kChunk,
+          map ? kPhys : nullptr, index};
+}
+
+// Stand-in for a device: the virtual address reservations and the mapped chunks.
+// Records the operations as "W" for a queue drain, "M<range>" for a map and "U<range>" for
+// an unmap
+class FakeDevice : public VirtualMapLowering {
+ public:
+  explicit FakeDevice(const std::vector<VirtualMapRange>& ranges) : ranges_(ranges) {}
+
+  void waitIdle() override { ops_ += "W "; }
+
+  amd::Memory* findReservation(const void* ptr, size_t size) override {
+    ++lookups_;
+    uintptr_t start = reinterpret_cast<uintptr_t>(ptr);
+    for (size_t i = 0; i < reservations_.size(); ++i) {
+      uintptr_t base = kBase + reservations_[i].first * kChunk;
+      if (start >= base && start + size <= base + reservations_[i].second * kChunk) {
+        return reinterpret_cast<amd::Memory*>(i + 1);
+      }
+    }
+    return nullptr;
+  }
+
+  bool map(size_t range, amd::Memory* reservation) override {
+    ops_ += "M" + std::to_string(ranges_[range].index_) + " ";
+    return !fail_;
+  }
+
+  bool unmap(size_t range) override {
+    ops_ += "U" + std::to_string(ranges_[range].index_) + " ";
+    return !fail_;
+  }
+
+  const std::vector<VirtualMapRange>& ranges_;
+  std::vector<std::pair<size_t, size_t>> reservations_{{0, 1024}};  // First chunk, chunks
+  std::string ops_;
+  size_t lookups_ = 0;
+  bool fail_ = false;
+};
+
+// The ranges are sorted by address and the back to back ones share a run
+static bool testPlan() {
+  std::vector<VirtualMapRange> ranges = {range(4, 1, true, 0), range(0, 2, true, 1),
+                                         range(2, 1, false, 2), range(8, 1, true, 3)};
+  std::vector<VirtualMapRun> runs;
+  size_t failIdx = 0;
+  CHECK(PlanVirtualMap(&ranges, &runs, &failIdx));
+  CHECK(ranges[0].index_ == 1 && ranges[1].index_ == 2 && ranges[2].index_ == 0 &&
+        ranges[3].index_ == 3);
+  CHECK(runs.size() == 3);
+  CHECK(runs[0].first_ == 0 && runs[0].count_ == 2);
+  CHECK(runs[1].first_ == 2 && runs[1].count_ == 1);
+  CHECK(runs[2].first_ == 3 && runs[2].count_ == 1);
+  return true;
+}
+
+// The overlapping and the empty ranges are reported with the caller's index
+static bool testPlanErrors() {
+  std::vector<VirtualMapRange> ranges = {range(3, 1, true, 0), range(0, 4, true, 1),
+                                         range(8, 1, true, 2)};
+  std::vector<VirtualMapRun> runs;
+  size_t failIdx = 0;
+  CHECK(!PlanVirtualMap(&ranges, &runs, &failIdx));
+  CHECK(failIdx == 1);
+  CHECK(runs.empty());
+
+  ranges = {range(0, 1, true, 0), range(1, 0, true, 1)};
+  CHECK(!PlanVirtualMap(&ranges, &runs, &failIdx));
+  CHECK(failIdx == 1);
+
+  ranges = {range(0, 1, true, 0), range(0, 1, false, 1)};
+  CHECK(!PlanVirtualMap(&ranges, &runs, &failIdx));
+  CHECK(failIdx == 1);
+  return true;
+}
+
+// A batch with unmaps drains the queue once before the first operation,
+// a map only batch doesn't drain it
+static bool testDrain() {
+  std::vector<VirtualMapRange> ranges = {range(0, 1, false, 0), range(1, 1, true, 1),
+                                         range(5, 1, false, 2)};
+  std::vector<VirtualMapRun> runs;
+  size_t failIdx = 0;
+  CHECK(PlanVirtualMap(&ranges, &runs, &failIdx));
+  FakeDevice device(ranges);
+  CHECK(LowerVirtualMap(ranges, runs, &device) == 0);
+  CHECK(device.ops_ == "W U0 M1 U2 ");
+
+  ranges = {range(1, 1, true, 0), range(0, 1, true, 1)};
+  CHECK(PlanVirtualMap(&ranges, &runs, &failIdx));
+  FakeDevice mapOnly(ranges);
+  CHECK(LowerVirtualMap(ranges, runs, &mapOnly) == 0);
+  CHECK(mapOnly.ops_ == "M1 M0 ");
+  return true;
+}
+
+// A run inside a reservation looks it up once, a run across two reservations falls back
+// to a lookup per range and the ranges outside of any reservation fail
+static bool testReservations() {
+  std::vector<VirtualMapRange> ranges;
+  for (size_t i = 0; i < 8; ++i) {
+    ranges.push_back(range(i, 1, true, i));
+  }
+  std::vector<VirtualMapRun> runs;
+  size_t failIdx = 0;
+  CHECK(PlanVirtualMap(&ranges, &runs, &failIdx));
+  CHECK(runs.size() == 1);
+
+  FakeDevice single(ranges);
+  CHECK(LowerVirtualMap(ranges, runs, &single) == 0);
+  CHECK(single.lookups_ == 1);
+
+  FakeDevice split(ranges);
+  split.reservations_ = {{0, 4}, {4, 4}};
+  CHECK(LowerVirtualMap(ranges, runs, &split) == 0);
+  CHECK(split.lookups_ == 1 + 8);
+
+  FakeDevice partial(ranges);
+  partial.reservations_ = {{0, 6}};
+  CHECK(LowerVirtualMap(ranges, runs, &partial) == 2);
+  CHECK(partial.ops_ == "M0 M1 M2 M3 M4 M5 ");
+
+  FakeDevice failing(ranges);
+  failing.fail_ = true;
+  CHECK(LowerVirtualMap(ranges, runs, &failing) == 8);
+  return true;
+}
+
+// A paged allocator maps a growing arena chunk by chunk, then releases it. Reports the
+// reservation lookups and the queue drains of the batch against the calls one by one
+static bool measureArena() {
+  constexpr size_t kChunks = 1024;
+  std::vector<VirtualMapRange> maps;
+  std::vector<VirtualMapRange> unmaps;
+  for (size_t i = 0; i < kChunks; ++i) {
+    maps.push_back(range(i, 1, true, i));
+    unmaps.push_back(range(i, 1, false, i));
+  }
+
+  size_t singleLookups = 0;
+  size_t singleDrains = 0;
+  for (const auto& batch : {maps, unmaps}) {
+    for (const auto& op : batch) {
+      std::vector<VirtualMapRange> ranges = {op};
+      std::vector<VirtualMapRun> runs;
+      size_t failIdx = 0;
+      CHECK(PlanVirtualMap(&ranges, &runs, &failIdx));
+      FakeDevice device(ranges);
+      CHECK(LowerVirtualMap(ranges, runs, &device) == 0);
+      singleLookups += device.lookups_;
+      singleDrains += (device.ops_[0] == 'W') ? 1 : 0;
+    }
+  }
+
+  size_t batchLookups = 0;
+  size_t batchDrains = 0;
+  for (auto batch : {maps, unmaps}) {
+    std::vector<VirtualMapRun> runs;
+    size_t failIdx = 0;
+    CHECK(PlanVirtualMap(&batch, &runs, &failIdx));
+    FakeDevice device(batch);
+    CHECK(LowerVirtualMap(batch, runs, &device) == 0);
+    batchLookups += device.lookups_;
+    batchDrains += (device.ops_[0] == 'W') ? 1 : 0;
+  }
+
+  printf("%zu chunks: one by one %zu lookups, %zu drains; batched %zu lookups, %zu drains\n",
+         kChunks, singleLookups, singleDrains, batchLookups, batchDrains);
+  CHECK(batchLookups == 2 && batchDrains == 1);
+  CHECK(singleLookups == 2 * kChunks && singleDrains == kChunks);
+  return true;
+}
+
+int main() {
+  bool passed = true;
+  passed &= testPlan();
+  passed &= testPlanErrors();
+  passed &= testDrain();
+  passed &= testReservations();
+  passed &= measureArena();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -206,6 +206,15 @@ class Os : AllStatic {
   static void yield();
   //! Execute a pause instruction (for spin loops).
   static void spinPause();
+  /*! \brief Sleep until the 32-bit word at \a addr no longer holds \a expected,
+   *  a wake is posted on it, or \a timeoutNs elapses. The word may live in memory
+   *  shared between processes.
+   *
+   *  \result Returns false if the OS has no address based wait, so the caller must poll
+   */
+  static bool waitOnAddress(volatile uint32_t* addr, uint32_t expected, uint64_t timeoutNs);
+  //! Wake the threads (in any process) sleeping in waitOnAddress() on \a addr
+  static void wakeOnAddress(volatile uint32_t* addr);
 
   // Memory routines:
   //
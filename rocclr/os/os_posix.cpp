@@ -41,6 +41,8 @@
 #include <signal.h>
 
 #include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 #include <link.h>
 #include <time.h>
@@ -428,6 +430,23 @@ bool Os::setThreadAffinityToMainThread() {
 
 void Os::yield() { ::sched_yield(); }
 
+bool Os::waitOnAddress(volatile uint32_t* addr, uint32_t expected, uint64_t timeoutNs) {
+  struct timespec ts;
+  ts.tv_sec = static_cast<time_t>(timeoutNs / (1000ULL * 1000ULL * 1000ULL));
+  ts.tv_nsec = static_cast<long>(timeoutNs % (1000ULL * 1000ULL * 1000ULL));
+  // The word can be in a file mapping shared with other processes, hence no FUTEX_PRIVATE_FLAG
+  long ret = ::syscall(SYS_futex, addr, FUTEX_WAIT, expected, &ts, nullptr, 0);
+  if (ret == -1 && errno == ENOSYS) {
+    return false;
+  }
+  // Woken up, timed out, interrupted or the value already changed (EAGAIN)
+  return true;
+}
+
+void Os::wakeOnAddress(volatile uint32_t* addr) {
+  ::syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
 uint64_t Os::timeNanos() {
   struct timespec tp;
   ::clock_gettime(CLOCK_MONOTONIC, &tp);
@@ -348,6 +348,13 @@ bool Os::setThreadAffinityToMainThread() {
 }
 void Os::yield() { ::SwitchToThread(); }
 
+bool Os::waitOnAddress(volatile uint32_t* addr, uint32_t expected, uint64_t timeoutNs) {
+  // WaitOnAddress() is limited to the threads of one process, so the caller has to poll
+  return false;
+}
+
+void Os::wakeOnAddress(volatile uint32_t* addr) {}
+
 uint64_t Os::timeNanos() {
   LARGE_INTEGER current;
   QueryPerformanceCounter(&current);
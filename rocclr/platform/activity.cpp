@@ -23,11 +23,14 @@
 #include "platform/commandqueue.hpp"
 #include "platform/command_utils.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <thread>
 
 namespace amd::activity_prof {
 
 decltype(report_activity) report_activity{nullptr};
+decltype(report_activity_batch) report_activity_batch{nullptr};
 
 #if defined(__linux__)
 __thread activity_correlation_id_t correlation_id __attribute__((tls_model("initial-exec"))) = 0;
@@ -61,8 +64,11 @@ void ReportActivity(const amd::Command& command) {
   auto function = report_activity.load(std::memory_order_relaxed);
   if (!function) return;
 
-  const auto* queue = command.queue();
+  auto* queue = command.queue();
   assert(queue != nullptr);
+  // Buffer the records if the tool accepts batches
+  RecordBuffer* buffer = (report_activity_batch.load(std::memory_order_relaxed) != nullptr)
+      ? &queue->activityRecords() : nullptr;
   activity_record_t record{
       ACTIVITY_DOMAIN_HIP_OPS,                  // activity domain
       command.type(),                           // activity kind
@@ -110,12 +116,131 @@ void ReportActivity(const amd::Command& command) {
       record.begin_ns = it.first;
       record.end_ns = it.second;
       record.kernel_name = kernel_names[i].c_str();
-      function(ACTIVITY_DOMAIN_HIP_OPS, operation_id, &record);
+      if (buffer != nullptr) {
+        buffer->append(record);
+      } else {
+        function(ACTIVITY_DOMAIN_HIP_OPS, operation_id, &record);
+      }
     }
   } else {
       record.begin_ns = command.profilingInfo().start_;
       record.end_ns = command.profilingInfo().end_;
-      function(ACTIVITY_DOMAIN_HIP_OPS, operation_id, &record);
+      if (buffer != nullptr) {
+        buffer->append(record);
+      } else {
+        function(ACTIVITY_DOMAIN_HIP_OPS, operation_id, &record);
+      }
+  }
+}
+
+// ================================================================================================
+// All record buffers in the process. Leaked, since the queues can be destroyed at exit
+static std::mutex& bufferListLock() {
+  static std::mutex* lock = new std::mutex;
+  return *lock;
+}
+
+static std::vector<RecordBuffer*>& bufferList() {
+  static std::vector<RecordBuffer*>* list = new std::vector<RecordBuffer*>;
+  return *list;
+}
+
+// Set while the thread runs the tool callback, since the callback can call back the runtime
+static thread_local bool delivering = false;
+
+// ================================================================================================
+RecordBuffer::RecordBuffer() {
+  records_.reserve(kCapacity);
+  flushed_.reserve(kCapacity);
+  std::lock_guard<std::mutex> lock(bufferListLock());
+  bufferList().push_back(this);
+}
+
+// ================================================================================================
+RecordBuffer::~RecordBuffer() {
+  {
+    std::lock_guard<std::mutex> lock(bufferListLock());
+    auto& list = bufferList();
+    list.erase(std::find(list.begin(), list.end(), this));
+  }
+  // Wait for flushAll(), which may have picked the buffer before the removal
+  while (pins_.load(std::memory_order_acquire) != 0) {
+    std::this_thread::yield();
+  }
+  flush();
+}
+
+// ================================================================================================
+void RecordBuffer::append(const activity_record_t& record) {
+  bool full = false;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    const size_t index = records_.size();
+    records_.push_back(record);
+    if ((record.op == OP_ID_DISPATCH) && (record.kernel_name != nullptr)) {
+      if (names_.size() <= index) {
+        names_.resize(index + 1);
+      }
+      // Reuses the string storage of the previous batches
+      names_[index].assign(record.kernel_name);
+    }
+    full = (records_.size() >= kCapacity);
+  }
+  if (full) {
+    flush();
+  }
+}
+
+// ================================================================================================
+void RecordBuffer::flush() {
+  if (delivering) {
+    return;
+  }
+  std::lock_guard<std::mutex> flushLock(flushLock_);
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    if (records_.empty()) {
+      return;
+    }
+    records_.swap(flushed_);
+    names_.swap(flushedNames_);
+  }
+  // Point the kernel names to the copies, which stay valid until the delivery is done
+  for (size_t i = 0; i < flushed_.size(); ++i) {
+    if ((flushed_[i].op == OP_ID_DISPATCH) && (flushed_[i].kernel_name != nullptr)) {
+      flushed_[i].kernel_name = flushedNames_[i].c_str();
+    }
+  }
+  delivering = true;
+  if (auto batch = report_activity_batch.load(std::memory_order_relaxed)) {
+    batch(ACTIVITY_DOMAIN_HIP_OPS, flushed_.data(), flushed_.size());
+  } else if (auto function = report_activity.load(std::memory_order_relaxed)) {
+    // The batch callback was unregistered, fall back to the delivery one by one
+    for (auto& record : flushed_) {
+      function(ACTIVITY_DOMAIN_HIP_OPS, record.op, &record);
+    }
+  }
+  delivering = false;
+  flushed_.clear();
+}
+
+// ================================================================================================
+void RecordBuffer::flushAll() {
+  // The tool callback may create or destroy queues, hence it runs without the list lock.
+  // Only the buffer in delivery is pinned, so the callback can destroy the other queues.
+  for (size_t i = 0;; ++i) {
+    RecordBuffer* buffer = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(bufferListLock());
+      auto& list = bufferList();
+      if (i >= list.size()) {
+        break;
+      }
+      buffer = list[i];
+      buffer->pins_.fetch_add(1, std::memory_order_relaxed);
+    }
+    buffer->flush();
+    buffer->pins_.fetch_sub(1, std::memory_order_release);
   }
 }
 
@@ -160,6 +285,7 @@ const char* getOclCommandKindString(cl_command_type commandType) {
     CASE_STRING(CL_COMMAND_SVM_UNMAP, SvmUnmap);
     CASE_STRING(ROCCLR_COMMAND_STREAM_WAIT_VALUE, StreamWait);
     CASE_STRING(ROCCLR_COMMAND_STREAM_WRITE_VALUE, StreamWrite);
+    CASE_STRING(ROCCLR_COMMAND_STREAM_BATCH_MEM_OP, StreamBatchMemOp);
     default:
       break;
   };
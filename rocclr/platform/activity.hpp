@@ -26,7 +26,9 @@
 #include <array>
 #include <mutex>
 #include <shared_mutex>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace amd {
 class Command;
@@ -41,6 +43,10 @@ namespace amd::activity_prof {
 extern std::atomic<int (*)(activity_domain_t domain, uint32_t operation_id, void* data)>
     report_activity;
 
+//! Batched delivery of the activity records. If it isn't registered, then the records are
+//! reported one by one through report_activity
+extern std::atomic<activity_batch_callback_t> report_activity_batch;
+
 #if defined(__linux__)
 extern __thread activity_correlation_id_t correlation_id __attribute__((tls_model("initial-exec")));
 #elif defined(_WIN32)
@@ -76,7 +82,40 @@ constexpr OpId OperationId(cl_command_type commandType) {
 bool IsEnabled(OpId operation_id);
 void ReportActivity(const amd::Command& command);
 
+//! Buffers the activity records of a queue and delivers them to the tool in batches
+class RecordBuffer {
+ public:
+  //! The number of records, which triggers a flush
+  static constexpr size_t kCapacity = 256;
+
+  RecordBuffer();
+  ~RecordBuffer();
+
+  //! Appends a record. The kernel name is copied, since the kernel may be gone by the flush
+  void append(const activity_record_t& record);
+
+  //! Delivers the buffered records to the batch callback. A call from the callback itself
+  //! returns without the delivery and the records stay for the next flush
+  void flush();
+
+  //! Flushes the record buffers of all queues
+  static void flushAll();
+
+ private:
+  //! Disable copy constructor
+  RecordBuffer(const RecordBuffer&) = delete;
+
+  //! Disable assignment
+  RecordBuffer& operator=(const RecordBuffer&) = delete;
 
+  std::mutex lock_;                         //!< Protects the records, which are filled
+  std::vector<activity_record_t> records_;  //!< Records, which are filled
+  std::vector<std::string> names_;          //!< Kernel names of the filled records
+  std::mutex flushLock_;                    //!< Serializes the delivery and keeps the order
+  std::vector<activity_record_t> flushed_;  //!< Records, which are delivered
+  std::vector<std::string> flushedNames_;   //!< Kernel names of the delivered records
+  std::atomic<uint32_t> pins_{0};           //!< flushAll() calls, which use the buffer
+};
 
 const char* getOclCommandKindString(cl_command_type kind);
 }  // namespace amd::activity_prof
\ No newline at end of file
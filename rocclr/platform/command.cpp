@@ -789,10 +789,13 @@ bool CopyMemoryP2PCommand::validateMemory() {
 
 // ================================================================================================
 bool SvmPrefetchAsyncCommand::validateMemory() {
-  amd::Memory* svmMem = amd::MemObjMap::FindMemObj(dev_ptr());
-  if (nullptr == svmMem) {
-    LogPrintfError("SvmPrefetchAsync received unknown memory for prefetch: %p!", dev_ptr());
-    return false;
+  for (const auto& range : ranges_) {
+    amd::Memory* svmMem = amd::MemObjMap::FindMemObj(range.dev_ptr_);
+    if (nullptr == svmMem) {
+      LogPrintfError("SvmPrefetchAsync received unknown memory for prefetch: %p!",
+                     range.dev_ptr_);
+      return false;
+    }
   }
   return true;
 }
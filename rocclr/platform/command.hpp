@@ -30,6 +30,7 @@
 #include "platform/ndrange.hpp"
 #include "platform/kernel.hpp"
 #include "device/device.hpp"
+#include "device/devvirtualmap.hpp"
 #include "utils/concurrent.hpp"
 #include "platform/memory.hpp"
 #include "platform/perfctr.hpp"
@@ -887,6 +888,58 @@ class StreamOperationCommand : public OneMemoryArgCommand {
   const size_t sizeBytes() const { return sizeBytes_; }
 };
 
+/*! \brief      A batch of stream operations.
+ *
+ *  \details    Used to perform a sequence of stream wait, stream write and memory barrier
+ *              operations with a single command. The backend lowers the whole batch at once,
+ *              hence the barriers between the operations can be merged.
+ */
+
+class BatchStreamOperationCommand : public Command {
+ public:
+  struct Operation {
+    cl_command_type type_;  //!< ROCCLR_COMMAND_STREAM_WAIT_VALUE, _WRITE_VALUE or _MEM_BARRIER
+    Memory* memory_;        //!< Memory to wait on or to write, nullptr for a barrier
+    uint64_t value_;        //!< Value to Wait on or to Write
+    uint64_t mask_;         //!< Mask to be applied on the value for Wait operation
+    unsigned int flags_;    //!< Flags defining the Wait condition
+    size_t offset_;         //!< Offset into memory
+    size_t sizeBytes_;      //!< Size in bytes of the value
+  };
+
+ private:
+  std::vector<Operation> ops_;  //!< The operations in the submission order
+
+ public:
+  BatchStreamOperationCommand(HostQueue& queue, const EventWaitList& eventWaitList,
+                              const std::vector<Operation>& ops)
+      : Command(queue, ROCCLR_COMMAND_STREAM_BATCH_MEM_OP, eventWaitList, AMD_SERIALIZE_COPY),
+        ops_(ops) {
+    for (const auto& op : ops_) {
+      assert(((op.type_ == ROCCLR_COMMAND_STREAM_MEM_BARRIER) == (op.memory_ == nullptr)) &&
+             "Invalid Stream Operation");
+      if (op.memory_ != nullptr) {
+        op.memory_->retain();
+      }
+    }
+  }
+
+  virtual void releaseResources() {
+    for (auto& op : ops_) {
+      if (op.memory_ != nullptr) {
+        op.memory_->release();
+        DEBUG_ONLY(op.memory_ = nullptr);
+      }
+    }
+    Command::releaseResources();
+  }
+
+  virtual void submit(device::VirtualDevice& device) { device.submitBatchStreamOperation(*this); }
+
+  //! Returns the operations of the batch
+  const std::vector<Operation>& operations() const { return ops_; }
+};
+
 /*! \brief      A generic copy memory command
  *
  *  \details    Used for both buffers and images. Backends are expected
@@ -1754,69 +1807,105 @@ class CopyMemoryP2PCommand : public CopyMemoryCommand {
 
 /*! \brief      Prefetch command for SVM memory
  *
- *  \details    Prefetches SVM memory into the destination device or CPU
+ *  \details    Prefetches SVM memory into the destination device or CPU. A batch command
+ *              prefetches several ranges with a single wait
  */
 class SvmPrefetchAsyncCommand : public Command {
-  const void* dev_ptr_;   //!< Device pointer to memory for prefetch
-  size_t count_;          //!< the size for prefetch
-  bool cpu_access_;       //!< Prefetch data into CPU location
-  amd::Device* dev_;      //!< Destination device to prefetch to
+ public:
+  //! A range of the batch
+  struct Range {
+    const void* dev_ptr_;   //!< Device pointer to memory for prefetch
+    size_t count_;          //!< the size for prefetch
+    amd::Device* dev_;      //!< Destination device to prefetch to
+    bool cpu_access_;       //!< Prefetch data into CPU location
+  };
+
+ private:
+  std::vector<Range> ranges_;  //!< Ranges of the prefetch
 
  public:
   SvmPrefetchAsyncCommand(HostQueue& queue, const EventWaitList& eventWaitList,
                           const void* dev_ptr, size_t count, amd::Device* dev, bool cpu_access)
-      : Command(queue, 1, eventWaitList), dev_ptr_(dev_ptr), count_(count),
-        cpu_access_(cpu_access), dev_(dev) {}
+      : Command(queue, 1, eventWaitList), ranges_{{dev_ptr, count, dev, cpu_access}} {}
+
+  SvmPrefetchAsyncCommand(HostQueue& queue, const EventWaitList& eventWaitList,
+                          std::vector<Range>&& ranges)
+      : Command(queue, 1, eventWaitList), ranges_(std::move(ranges)) {
+    assert(!ranges_.empty() && "invalid");
+  }
 
   virtual void submit(device::VirtualDevice& device) { device.submitSvmPrefetchAsync(*this); }
 
   bool validateMemory();
 
-  const void* dev_ptr() const { return dev_ptr_; }
-  size_t count() const { return count_; }
-  amd::Device* device() const { return dev_; }
-  size_t cpu_access() const { return cpu_access_; }
+  const void* dev_ptr() const { return ranges_[0].dev_ptr_; }
+  size_t count() const { return ranges_[0].count_; }
+  amd::Device* device() const { return ranges_[0].dev_; }
+  size_t cpu_access() const { return ranges_[0].cpu_access_; }
+  const std::vector<Range>& ranges() const { return ranges_; }
 };
 
 /*! \brief  A virtual map memory command.
  *
+ *  \details Maps or unmaps a batch of virtual ranges. A single range command keeps
+ *  the original semantics of one map or unmap.
  */
 
 class VirtualMapCommand : public Command {
- private:
-  const void* ptr_;     //!< Virtual address to map to the memory
+ public:
+  typedef device::VirtualMapRange Range;
+  typedef device::VirtualMapRun Run;
 
-protected:
-  Memory* memory_;  //!< Memory to map, nullptr means unmap
-  size_t size_;     //!< Size of the mapping in bytes
+ private:
+  std::vector<Range> ranges_;  //!< Ranges of the batch, sorted by address
+  std::vector<Run> runs_;      //!< Back to back ranges of the batch
 
-public:
+ public:
   //! Construct a new VirtualMapCommand
   VirtualMapCommand(HostQueue& queue, const EventWaitList& eventWaitList,
                    void* ptr, size_t size, Memory* memory)
       : Command(queue, 1, eventWaitList),
-        ptr_(ptr),
-        size_(size),
-        memory_(memory) {
+        ranges_{{ptr, size, memory, 0}},
+        runs_{{0, 1}} {
     // Sanity checks
     assert(size > 0 && "invalid");
-    if (memory_) memory_->retain();
+    if (memory) memory->retain();
+  }
+
+  //! Construct a batch of map and unmap operations, device::PlanVirtualMap must have
+  //! sorted the ranges and built the runs
+  VirtualMapCommand(HostQueue& queue, const EventWaitList& eventWaitList,
+                   std::vector<Range>&& ranges, std::vector<Run>&& runs)
+      : Command(queue, 1, eventWaitList),
+        ranges_(std::move(ranges)),
+        runs_(std::move(runs)) {
+    // Sanity checks
+    assert(!ranges_.empty() && !runs_.empty() && "invalid");
+    for (const auto& range : ranges_) {
+      if (range.memory_) range.memory_->retain();
+    }
   }
 
   virtual void releaseResources() {
-    if (memory_) memory_->release();
-    DEBUG_ONLY(memory_ = nullptr);
+    for (auto& range : ranges_) {
+      if (range.memory_) range.memory_->release();
+      DEBUG_ONLY(range.memory_ = nullptr);
+    }
     Command::releaseResources();
   }
 
   virtual void submit(device::VirtualDevice& device) { device.submitVirtualMap(*this); }
 
-  //! Read the memory object
-  Memory* memory() const { return memory_; }
-  //! Read the size
-  size_t size() const { return size_; }
-  //! Read the pointer
-  const void* ptr() const { return ptr_; }
+  //! Read the memory object of the first range
+  Memory* memory() const { return ranges_[0].memory_; }
+  //! Read the size of the first range
+  size_t size() const { return ranges_[0].size_; }
+  //! Read the pointer of the first range
+  const void* ptr() const { return ranges_[0].ptr_; }
+  //! Read the ranges of the batch
+  const std::vector<Range>& ranges() const { return ranges_; }
+  //! Read the runs of the batch
+  const std::vector<Run>& runs() const { return runs_; }
 };
 
 //! Union used in memory suballocator, must be updated with the new commands
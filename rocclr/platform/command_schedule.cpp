@@ -0,0 +1,137 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "platform/command_schedule.hpp"
+
+#include <algorithm>
+
+namespace amd {
+
+// ================================================================================================
+int32_t CommandSchedule::add(uint32_t numWaits, const cl_sync_point_khr* waits, bool barrier,
+                             cl_sync_point_khr* syncPoint) {
+  if (finalized_) {
+    return CL_INVALID_OPERATION;
+  }
+  if ((numWaits == 0) != (waits == nullptr)) {
+    return CL_INVALID_SYNC_POINT_WAIT_LIST_KHR;
+  }
+  const uint32_t index = static_cast<uint32_t>(deps_.size());
+  std::vector<uint32_t> deps;
+  for (uint32_t i = 0; i < numWaits; ++i) {
+    const uint32_t wait = waits[i];
+    if (wait >= index) {
+      return CL_INVALID_SYNC_POINT_WAIT_LIST_KHR;
+    }
+    // Every command waits for the last barrier, which waits for the previous one. Hence
+    // the barriers and all commands before a barrier without sync points are implied
+    if (barriers_[wait] || ((lastFullBarrier_ != kNone) && (wait < lastFullBarrier_))) {
+      continue;
+    }
+    deps.push_back(wait);
+  }
+  if (barrier && (numWaits == 0)) {
+    const uint32_t first = (lastFullBarrier_ == kNone) ? 0 : lastFullBarrier_ + 1;
+    for (uint32_t i = first; i < index; ++i) {
+      if (!barriers_[i]) {
+        deps.push_back(i);
+      }
+    }
+  }
+  if (lastBarrier_ != kNone) {
+    deps.push_back(lastBarrier_);
+  }
+  std::sort(deps.begin(), deps.end());
+  deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+
+  deps_.push_back(std::move(deps));
+  barriers_.push_back(barrier);
+  if (barrier) {
+    lastBarrier_ = index;
+    if (numWaits == 0) {
+      lastFullBarrier_ = index;
+    }
+  }
+  if (syncPoint != nullptr) {
+    *syncPoint = index;
+  }
+  return CL_SUCCESS;
+}
+
+// ================================================================================================
+int32_t CommandSchedule::finalize(bool inOrder) {
+  if (finalized_) {
+    return CL_INVALID_OPERATION;
+  }
+  finalized_ = true;
+
+  if (inOrder) {
+    // The queue runs the commands in the record order, which satisfies all sync points
+    for (auto& deps : deps_) {
+      deps.clear();
+    }
+    if (!deps_.empty()) {
+      sinks_.push_back(static_cast<uint32_t>(deps_.size() - 1));
+    }
+    return CL_SUCCESS;
+  }
+
+  std::vector<bool> waited(deps_.size(), false);
+  for (const auto& deps : deps_) {
+    for (auto dep : deps) {
+      waited[dep] = true;
+    }
+  }
+  for (uint32_t i = 0; i < waited.size(); ++i) {
+    if (!waited[i]) {
+      sinks_.push_back(i);
+    }
+  }
+  return CL_SUCCESS;
+}
+
+// ================================================================================================
+int32_t ValidateMutableDispatch(const cl_mutable_dispatch_config_khr& config,
+                                cl_mutable_dispatch_fields_khr updatableFields, size_t workDim) {
+  if ((config.type != CL_STRUCTURE_TYPE_MUTABLE_DISPATCH_CONFIG_KHR) || (config.next != nullptr)) {
+    return CL_INVALID_VALUE;
+  }
+  if ((((config.num_args != 0) || (config.num_svm_args != 0)) &&
+       ((updatableFields & CL_MUTABLE_DISPATCH_ARGUMENTS_KHR) == 0)) ||
+      (config.num_exec_infos != 0) ||
+      ((config.global_work_offset != nullptr) &&
+       ((updatableFields & CL_MUTABLE_DISPATCH_GLOBAL_OFFSET_KHR) == 0)) ||
+      ((config.global_work_size != nullptr) &&
+       ((updatableFields & CL_MUTABLE_DISPATCH_GLOBAL_SIZE_KHR) == 0)) ||
+      ((config.local_work_size != nullptr) &&
+       ((updatableFields & CL_MUTABLE_DISPATCH_LOCAL_SIZE_KHR) == 0))) {
+    return CL_INVALID_OPERATION;
+  }
+  if (((config.num_args != 0) && (config.arg_list == nullptr)) ||
+      ((config.num_svm_args != 0) && (config.arg_svm_list == nullptr))) {
+    return CL_INVALID_VALUE;
+  }
+  if ((config.work_dim != 0) && (config.work_dim != workDim)) {
+    return CL_INVALID_VALUE;
+  }
+  return CL_SUCCESS;
+}
+
+}  // namespace amd
@@ -0,0 +1,75 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+#include "amdocl/cl_command_buffer_khr.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace amd {
+
+//! Sync point bookkeeping of a command buffer. The sync point of a command is its record
+//! index. The schedule doesn't know the commands, hence the recording rules are checked
+//! without a device
+class CommandSchedule {
+ public:
+  CommandSchedule() : lastBarrier_(kNone), lastFullBarrier_(kNone), finalized_(false) {}
+
+  //! Records a command, which waits for the sync points. A barrier without sync points
+  //! waits for all earlier commands. All later commands wait for a barrier
+  int32_t add(uint32_t numWaits, const cl_sync_point_khr* waits, bool barrier,
+              cl_sync_point_khr* syncPoint);
+
+  //! Ends the recording and resolves the dependencies of the commands. Waits implied by
+  //! other waits are dropped, an in-order replay drops all of them
+  int32_t finalize(bool inOrder);
+
+  //! Returns true once the recording is over
+  bool finalized() const { return finalized_; }
+
+  //! Returns the number of recorded commands
+  size_t size() const { return deps_.size(); }
+
+  //! Returns the commands, which the command waits for in a replay
+  const std::vector<uint32_t>& deps(size_t index) const { return deps_[index]; }
+
+  //! Returns the commands, which no other command waits for. Those complete a replay
+  const std::vector<uint32_t>& sinks() const { return sinks_; }
+
+ private:
+  static constexpr uint32_t kNone = static_cast<uint32_t>(-1);
+
+  std::vector<std::vector<uint32_t>> deps_;  //!< Waits of the commands
+  std::vector<bool> barriers_;               //!< Barrier flags of the commands
+  std::vector<uint32_t> sinks_;              //!< The last commands of a replay
+  uint32_t lastBarrier_;                     //!< The last recorded barrier
+  uint32_t lastFullBarrier_;                 //!< The last barrier, which waits for all
+  bool finalized_;                           //!< The recording is over
+};
+
+//! Checks the structure of a mutable dispatch update against the updatable fields and the
+//! work dimension of the recorded launch. The kernel specific rules are left to the caller
+int32_t ValidateMutableDispatch(const cl_mutable_dispatch_config_khr& config,
+                                cl_mutable_dispatch_fields_khr updatableFields, size_t workDim);
+
+}  // namespace amd
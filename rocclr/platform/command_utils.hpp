@@ -24,6 +24,9 @@
 // Dummy command types for Stream Wait and Write commands.
 #define ROCCLR_COMMAND_STREAM_WAIT_VALUE 0x4501
 #define ROCCLR_COMMAND_STREAM_WRITE_VALUE 0x4502
+// Dummy command types for a batch of stream operations and the memory barrier inside of it
+#define ROCCLR_COMMAND_STREAM_BATCH_MEM_OP 0x4503
+#define ROCCLR_COMMAND_STREAM_MEM_BARRIER 0x4504
 
 // Stream Wait Value Conidtions
 #define ROCCLR_STREAM_WAIT_VALUE_GTE 0x0
@@ -0,0 +1,236 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "platform/commandbuffer.hpp"
+
+#include <algorithm>
+
+namespace amd {
+
+// ================================================================================================
+Command* CommandBuffer::KernelNode::create(HostQueue& queue, const Command::EventWaitList& waits,
+                                           int32_t* error) {
+  NDRangeKernelCommand* command = new NDRangeKernelCommand(queue, waits, *kernel_, sizes_);
+  if (command == nullptr) {
+    *error = CL_OUT_OF_HOST_MEMORY;
+    return nullptr;
+  }
+  // The arguments go into a new kernel argument buffer on every launch
+  *error = command->captureAndValidate();
+  if (*error != CL_SUCCESS) {
+    command->setStatus(*error);
+    return nullptr;
+  }
+  return command;
+}
+
+// ================================================================================================
+Command* CommandBuffer::CopyNode::create(HostQueue& queue, const Command::EventWaitList& waits,
+                                         int32_t* error) {
+  CopyMemoryCommand* command = new CopyMemoryCommand(queue, type_, waits, src_, dst_, srcOrigin_,
+                                                     dstOrigin_, size_, srcRect_, dstRect_);
+  if (command == nullptr) {
+    *error = CL_OUT_OF_HOST_MEMORY;
+    return nullptr;
+  }
+  if (!command->validateMemory()) {
+    *error = CL_MEM_OBJECT_ALLOCATION_FAILURE;
+    command->setStatus(*error);
+    return nullptr;
+  }
+  *error = CL_SUCCESS;
+  return command;
+}
+
+// ================================================================================================
+Command* CommandBuffer::FillNode::create(HostQueue& queue, const Command::EventWaitList& waits,
+                                         int32_t* error) {
+  FillMemoryCommand* command = new FillMemoryCommand(queue, type_, waits, memory_, pattern_,
+                                                     patternSize_, origin_, size_, surface_);
+  if (command == nullptr) {
+    *error = CL_OUT_OF_HOST_MEMORY;
+    return nullptr;
+  }
+  if (!command->validateMemory()) {
+    *error = CL_MEM_OBJECT_ALLOCATION_FAILURE;
+    command->setStatus(*error);
+    return nullptr;
+  }
+  *error = CL_SUCCESS;
+  return command;
+}
+
+// ================================================================================================
+Command* CommandBuffer::BarrierNode::create(HostQueue& queue, const Command::EventWaitList& waits,
+                                            int32_t* error) {
+  Command* command = new Marker(queue, false, waits);
+  *error = (command == nullptr) ? CL_OUT_OF_HOST_MEMORY : CL_SUCCESS;
+  return command;
+}
+
+// ================================================================================================
+CommandBuffer::CommandBuffer(HostQueue& queue, cl_command_buffer_flags_khr flags,
+                             const std::vector<cl_command_buffer_properties_khr>& properties)
+    : lock_("Command buffer lock", true),
+      queue_(queue),
+      flags_(flags),
+      properties_(properties),
+      lastReplay_(nullptr) {
+  queue_.retain();
+}
+
+// ================================================================================================
+CommandBuffer::~CommandBuffer() {
+  if (lastReplay_ != nullptr) {
+    lastReplay_->release();
+  }
+  for (auto node : nodes_) {
+    delete node;
+  }
+  queue_.release();
+}
+
+// ================================================================================================
+int32_t CommandBuffer::record(Node* node, uint32_t numWaits, const cl_sync_point_khr* waits,
+                              bool barrier, cl_sync_point_khr* syncPoint) {
+  ScopedLock sl(lock_);
+  int32_t error = schedule_.add(numWaits, waits, barrier, syncPoint);
+  if (error != CL_SUCCESS) {
+    delete node;
+    return error;
+  }
+  nodes_.push_back(node);
+  return CL_SUCCESS;
+}
+
+// ================================================================================================
+int32_t CommandBuffer::finalize() {
+  ScopedLock sl(lock_);
+  const bool inOrder = !queue_.properties().test(CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+  return schedule_.finalize(inOrder);
+}
+
+// ================================================================================================
+bool CommandBuffer::pending() const {
+  if (lastReplay_ == nullptr) {
+    return false;
+  }
+  // Direct dispatch updates the status only after a queue flush
+  lastReplay_->notifyCmdQueue();
+  return lastReplay_->status() > CL_COMPLETE;
+}
+
+// ================================================================================================
+cl_command_buffer_state_khr CommandBuffer::state() {
+  ScopedLock sl(lock_);
+  if (!schedule_.finalized()) {
+    return CL_COMMAND_BUFFER_STATE_RECORDING_KHR;
+  }
+  return pending() ? CL_COMMAND_BUFFER_STATE_PENDING_KHR : CL_COMMAND_BUFFER_STATE_EXECUTABLE_KHR;
+}
+
+// ================================================================================================
+CommandBuffer::KernelNode* CommandBuffer::mutableNode(cl_mutable_command_khr handle) const {
+  Node* node = reinterpret_cast<Node*>(handle);
+  if (std::find(nodes_.begin(), nodes_.end(), node) == nodes_.end()) {
+    return nullptr;
+  }
+  return dynamic_cast<KernelNode*>(node);
+}
+
+// ================================================================================================
+int32_t CommandBuffer::enqueue(HostQueue& queue, const Command::EventWaitList& waits,
+                               Command** event) {
+  ScopedLock sl(lock_);
+  if (!schedule_.finalized()) {
+    return CL_INVALID_OPERATION;
+  }
+  if (((flags_ & CL_COMMAND_BUFFER_SIMULTANEOUS_USE_KHR) == 0) && pending()) {
+    return CL_INVALID_OPERATION;
+  }
+  const bool inOrder = !queue.properties().test(CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+
+  // Make all commands first, so a failure doesn't leave a partial replay in the queue
+  std::vector<Command*> commands(nodes_.size(), nullptr);
+  Command::EventWaitList waitList;
+  int32_t error = CL_SUCCESS;
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    const auto& deps = schedule_.deps(i);
+    waitList.clear();
+    if (deps.empty()) {
+      // The queue order covers the external waits after the first command
+      if (!inOrder || (i == 0)) {
+        waitList = waits;
+      }
+    } else {
+      for (auto dep : deps) {
+        waitList.push_back(commands[dep]);
+      }
+    }
+    commands[i] = nodes_[i]->create(queue, waitList, &error);
+    if (commands[i] == nullptr) {
+      break;
+    }
+  }
+
+  Command* marker = nullptr;
+  if (error == CL_SUCCESS) {
+    waitList.clear();
+    if (commands.empty()) {
+      waitList = waits;
+    } else if (!inOrder) {
+      for (auto sink : schedule_.sinks()) {
+        waitList.push_back(commands[sink]);
+      }
+    }
+    marker = new Marker(queue, true, waitList);
+    if (marker == nullptr) {
+      error = CL_OUT_OF_HOST_MEMORY;
+    }
+  }
+
+  if (error != CL_SUCCESS) {
+    // The later commands hold references to the earlier ones, hence go backwards
+    for (auto it = commands.rbegin(); it != commands.rend(); ++it) {
+      if (*it != nullptr) {
+        (*it)->setStatus(error);
+      }
+    }
+    return error;
+  }
+
+  for (auto command : commands) {
+    command->enqueue();
+  }
+  marker->enqueue();
+  for (auto command : commands) {
+    command->release();
+  }
+
+  if (lastReplay_ != nullptr) {
+    lastReplay_->release();
+  }
+  marker->retain();
+  lastReplay_ = marker;
+  *event = marker;
+  return CL_SUCCESS;
+}
+
+}  // namespace amd
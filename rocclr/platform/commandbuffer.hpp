@@ -0,0 +1,255 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+#include "platform/command.hpp"
+#include "platform/commandqueue.hpp"
+#include "platform/command_schedule.hpp"
+#include "amdocl/cl_command_buffer_khr.h"
+
+#include <vector>
+
+namespace amd {
+
+/*! \addtogroup Runtime
+ *  @{
+ *
+ *  \addtogroup Commands Event, Commands and Command-Queue
+ *  @{
+ */
+
+/*! \class CommandBuffer
+ *
+ *  \brief A recorded sequence of commands (cl_khr_command_buffer). The validation and the
+ *  dependency resolution happen once, every replay only makes and enqueues the commands.
+ */
+class CommandBuffer : public RuntimeObject {
+ public:
+  //! The replay orders the commands of out-of-order queues with the sync points
+  static constexpr cl_device_command_buffer_capabilities_khr Capabilities =
+      CL_COMMAND_BUFFER_CAPABILITY_SIMULTANEOUS_USE_KHR |
+      CL_COMMAND_BUFFER_CAPABILITY_OUT_OF_ORDER_KHR;
+
+  //! The kernel launch fields, which clUpdateMutableCommandsKHR can change
+  static constexpr cl_mutable_dispatch_fields_khr MutableFields =
+      CL_MUTABLE_DISPATCH_GLOBAL_OFFSET_KHR | CL_MUTABLE_DISPATCH_GLOBAL_SIZE_KHR |
+      CL_MUTABLE_DISPATCH_LOCAL_SIZE_KHR | CL_MUTABLE_DISPATCH_ARGUMENTS_KHR;
+
+  //! A recorded command. Every replay makes a new command out of it, like a graph node
+  class Node : public HeapObject {
+   public:
+    virtual ~Node() {}
+    //! Makes the command of a replay. Returns nullptr and the error code on a failure
+    virtual Command* create(HostQueue& queue, const Command::EventWaitList& waits,
+                            int32_t* error) = 0;
+  };
+
+  //! An NDRange kernel launch. The node holds a copy of the kernel with the arguments
+  //! of the record time, the mutable dispatch updates change the copy
+  class KernelNode : public Node {
+   public:
+    KernelNode(CommandBuffer& commandBuffer, Kernel& recorded, Kernel& kernel,
+               const NDRangeContainer& sizes,
+               const std::vector<cl_ndrange_kernel_command_properties_khr>& properties,
+               cl_mutable_dispatch_fields_khr updatableFields)
+        : commandBuffer_(commandBuffer),
+          recorded_(recorded),
+          kernel_(&kernel),
+          sizes_(sizes),
+          properties_(properties),
+          updatableFields_(updatableFields) {
+      recorded_.retain();
+    }
+    ~KernelNode() {
+      kernel_->release();
+      recorded_.release();
+    }
+
+    Command* create(HostQueue& queue, const Command::EventWaitList& waits,
+                    int32_t* error) override;
+
+    //! Returns the command buffer, which owns the node
+    CommandBuffer& commandBuffer() const { return commandBuffer_; }
+    //! Returns the kernel of the record call
+    Kernel& recorded() const { return recorded_; }
+    //! Returns the kernel copy of the node
+    Kernel& kernel() const { return *kernel_; }
+    //! Replaces the kernel copy of the node, the node owns the new copy. The enqueued
+    //! commands keep the old copy alive
+    void setKernel(Kernel& kernel) {
+      kernel_->release();
+      kernel_ = &kernel;
+    }
+    //! Returns the NDRange of the launch
+    NDRangeContainer& sizes() { return sizes_; }
+    //! Returns the properties of the record call
+    const std::vector<cl_ndrange_kernel_command_properties_khr>& properties() const {
+      return properties_;
+    }
+    //! Returns the fields, which clUpdateMutableCommandsKHR can change
+    cl_mutable_dispatch_fields_khr updatableFields() const { return updatableFields_; }
+
+   private:
+    CommandBuffer& commandBuffer_;                    //!< The owner of the node
+    Kernel& recorded_;                                //!< The kernel of the record call
+    Kernel* kernel_;                                  //!< The kernel copy
+    NDRangeContainer sizes_;                          //!< The NDRange of the launch
+    std::vector<cl_ndrange_kernel_command_properties_khr> properties_;  //!< Record properties
+    cl_mutable_dispatch_fields_khr updatableFields_;  //!< The mutable fields
+  };
+
+  //! A copy between buffers and images. The rectangles describe the rect buffer copies only
+  class CopyNode : public Node {
+   public:
+    CopyNode(cl_command_type type, Memory& src, Memory& dst, const Coord3D& srcOrigin,
+             const Coord3D& dstOrigin, const Coord3D& size,
+             const BufferRect& srcRect = BufferRect(), const BufferRect& dstRect = BufferRect())
+        : type_(type),
+          src_(src),
+          dst_(dst),
+          srcOrigin_(srcOrigin),
+          dstOrigin_(dstOrigin),
+          size_(size),
+          srcRect_(srcRect),
+          dstRect_(dstRect) {
+      src_.retain();
+      dst_.retain();
+    }
+    ~CopyNode() {
+      src_.release();
+      dst_.release();
+    }
+
+    Command* create(HostQueue& queue, const Command::EventWaitList& waits,
+                    int32_t* error) override;
+
+   private:
+    cl_command_type type_;  //!< The copy command type
+    Memory& src_;           //!< The source memory
+    Memory& dst_;           //!< The destination memory
+    Coord3D srcOrigin_;     //!< The source origin
+    Coord3D dstOrigin_;     //!< The destination origin
+    Coord3D size_;          //!< The copy size
+    BufferRect srcRect_;    //!< The source rectangle
+    BufferRect dstRect_;    //!< The destination rectangle
+  };
+
+  //! A buffer or an image fill with a pattern
+  class FillNode : public Node {
+   public:
+    FillNode(cl_command_type type, Memory& memory, const void* pattern, size_t patternSize,
+             const Coord3D& origin, const Coord3D& size, const Coord3D& surface)
+        : type_(type),
+          memory_(memory),
+          patternSize_(patternSize),
+          origin_(origin),
+          size_(size),
+          surface_(surface) {
+      ::memcpy(pattern_, pattern, patternSize);
+      memory_.retain();
+    }
+    ~FillNode() { memory_.release(); }
+
+    Command* create(HostQueue& queue, const Command::EventWaitList& waits,
+                    int32_t* error) override;
+
+   private:
+    cl_command_type type_;                                //!< The fill command type
+    Memory& memory_;                                      //!< The filled memory
+    char pattern_[FillMemoryCommand::MaxFillPatterSize];  //!< The fill pattern
+    size_t patternSize_;                                  //!< Pattern size
+    Coord3D origin_;                                      //!< The fill origin
+    Coord3D size_;                                        //!< The fill size
+    Coord3D surface_;                                     //!< The fill surface
+  };
+
+  //! A barrier, the schedule makes all later commands wait for it
+  class BarrierNode : public Node {
+   public:
+    Command* create(HostQueue& queue, const Command::EventWaitList& waits,
+                    int32_t* error) override;
+  };
+
+  //! Creates a command buffer, which records the commands of the queue
+  CommandBuffer(HostQueue& queue, cl_command_buffer_flags_khr flags,
+                const std::vector<cl_command_buffer_properties_khr>& properties);
+
+  //! Records the node. The buffer owns the node, even if the record fails
+  int32_t record(Node* node, uint32_t numWaits, const cl_sync_point_khr* waits, bool barrier,
+                 cl_sync_point_khr* syncPoint);
+
+  //! Ends the recording
+  int32_t finalize();
+
+  //! Replays the recorded commands on the queue. Returns the retained command, which
+  //! completes once the whole replay is done
+  int32_t enqueue(HostQueue& queue, const Command::EventWaitList& waits, Command** event);
+
+  //! Returns the kernel node of the mutable command handle or nullptr,
+  //! if the handle isn't a kernel node of this buffer
+  KernelNode* mutableNode(cl_mutable_command_khr handle) const;
+
+  //! Returns the current state of the command buffer
+  cl_command_buffer_state_khr state();
+
+  //! Returns the queue of the recorded commands
+  HostQueue& queue() const { return queue_; }
+
+  //! Returns the command buffer flags
+  cl_command_buffer_flags_khr flags() const { return flags_; }
+
+  //! Returns the properties of the creation
+  const std::vector<cl_command_buffer_properties_khr>& properties() const { return properties_; }
+
+  //! Returns the lock, which serializes the replays with the mutable dispatch updates
+  Monitor& lock() { return lock_; }
+
+  //! RTTI internal implementation
+  virtual ObjectType objectType() const { return ObjectTypeCommandBuffer; }
+
+ protected:
+  virtual ~CommandBuffer();
+
+ private:
+  //! Returns true if the last replay isn't done yet
+  bool pending() const;
+
+  Monitor lock_;                       //!< Guards the replays and the updates
+  HostQueue& queue_;                   //!< The queue of the recorded commands
+  cl_command_buffer_flags_khr flags_;  //!< The command buffer flags
+  std::vector<cl_command_buffer_properties_khr> properties_;  //!< The creation properties
+  CommandSchedule schedule_;           //!< Sync points of the recorded commands
+  std::vector<Node*> nodes_;           //!< The recorded commands
+  Command* lastReplay_;                //!< The completion of the last replay
+
+  //! Disable copy constructor
+  CommandBuffer(const CommandBuffer&);
+
+  //! Disable assignment
+  CommandBuffer& operator=(const CommandBuffer&);
+};
+
+/*! @}
+ *  @}
+ */
+
+}  // namespace amd
@@ -34,9 +34,10 @@
 namespace amd {
 
 HostQueue::HostQueue(Context& context, Device& device, cl_command_queue_properties props,
-                     uint queueRTCUs, Priority priority, const std::vector<uint32_t>& cuMask)
+                     uint queueRTCUs, Priority priority, const std::vector<uint32_t>& cuMask,
+                     bool dedicatedQueue)
     : CommandQueue(context, device, props, device.info().queueProperties_, queueRTCUs,
-                   priority, cuMask),
+                   priority, cuMask, dedicatedQueue),
       lastEnqueueCommand_(nullptr),
       head_(nullptr),
       tail_(nullptr),
@@ -113,8 +114,15 @@ bool HostQueue::terminate() {
         Os::yield();
       }
     }
+    // The last dependency callback can still hold queueLock_ after it woke up the loop
+    while (parked_.busy()) {
+      Os::yield();
+    }
   }
 
+  // Deliver the records of the completed commands to the profiler
+  activityRecords_.flush();
+
   if (Agent::shouldPostCommandQueueEvents()) {
     Agent::postCommandQueueFree(as_cl(this->asCommandQueue()));
   }
@@ -127,6 +135,7 @@ void HostQueue::finish(bool cpu_wait) {
   if (IS_HIP) {
     command = getLastQueuedCommand(true);
     if (command == nullptr) {
+      activityRecords_.flush();
       return;
     }
   }
@@ -171,6 +180,7 @@ void HostQueue::finish(bool cpu_wait) {
   }
 
   command->release();
+  activityRecords_.flush();
   ClPrint(LOG_DEBUG, LOG_CMD, "All commands finished");
 }
 
@@ -181,34 +191,61 @@ void HostQueue::loop(device::VirtualDevice* virtualDevice) {
     thread_.acceptingCommands_ = true;
     queueLock_.notify();
   }
+  // HIP processes the event callbacks before the status update, hence a callback registered
+  // in between would be lost. Keep the blocking wait for HIP.
+  const bool deferDependencies = !IS_HIP;
+  std::vector<Event*> dependencies;
   // Create a command batch with all the commands present in the queue.
   Command* head = NULL;
   Command* tail = NULL;
   while (true) {
-    // Get one command from the queue
-    Command* command = queue_.dequeue();
-    if (command == NULL) {
-      ScopedLock sl(queueLock_);
-      while ((command = queue_.dequeue()) == NULL) {
-        if (!thread_.acceptingCommands_) {
-          return;
+    Command* command = NULL;
+    if (parked_.ready()) {
+      // The dependencies of the first parked command are complete, resume it
+      command = parked_.resume();
+    } else {
+      // Get one command from the queue
+      command = queue_.dequeue();
+      if (command == NULL) {
+        ScopedLock sl(queueLock_);
+        while ((command = queue_.dequeue()) == NULL) {
+          if (parked_.ready()) {
+            break;
+          }
+          if (!thread_.acceptingCommands_ && parked_.empty()) {
+            return;
+          }
+          queueLock_.wait();
+        }
+        if (command == NULL) {
+          continue;
         }
-        queueLock_.wait();
       }
-    }
 
-    command->retain();
+      command->retain();
+
+      // Keep the order with the commands, which wait for other queues
+      if (!parked_.empty()) {
+        parked_.append(command);
+        continue;
+      }
+    }
 
     // Process the command's event wait list.
     const Command::EventWaitList& events = command->eventWaitList();
     bool dependencyFailed = false;
     ClPrint(LOG_DEBUG, LOG_CMD, "Command (%s) processing: %p ,events.size(): %d",
             amd::activity_prof::getOclCommandKindString(command->type()), command, events.size());
+    dependencies.clear();
     for (const auto& it : events) {
       // Only wait if the command is enqueued into another queue.
       if (it->command().queue() != this) {
         // Runtime has to flush the current batch only if the dependent wait is blocking
         if (it->command().status() != CL_COMPLETE) {
+          if (deferDependencies && (it->status() > CL_COMPLETE)) {
+            dependencies.push_back(it);
+            continue;
+          }
           ClPrint(LOG_DEBUG, LOG_CMD, "Command (%s) %p awaiting event: %p",
                   amd::activity_prof::getOclCommandKindString(command->type()),
                   command, it);
@@ -219,6 +256,26 @@ void HostQueue::loop(device::VirtualDevice* virtualDevice) {
       }
     }
 
+    if (!dependencies.empty()) {
+      // Park the command instead of the wait, so the batch and the queue keep draining.
+      // The last completed dependency wakes up the loop and the command is processed again.
+      ClPrint(LOG_DEBUG, LOG_CMD, "Command (%s) %p parked on %zu events",
+              amd::activity_prof::getOclCommandKindString(command->type()), command,
+              dependencies.size());
+      virtualDevice->flush(head);
+      tail = head = NULL;
+      parked_.park(command, static_cast<uint32_t>(dependencies.size()));
+      for (auto it : dependencies) {
+        // Make sure the other queue is draining its commands
+        if (!it->notifyCmdQueue() ||
+            !it->setCallback(CL_COMPLETE, dependencyCallback, this)) {
+          it->awaitCompletion();
+          dependencyCallback(as_cl(it), it->status(), this);
+        }
+      }
+      continue;
+    }
+
     // Insert the command to the linked list.
     if (NULL == head) {  // if the list is empty
       head = tail = command;
@@ -249,6 +306,16 @@ void HostQueue::loop(device::VirtualDevice* virtualDevice) {
   }  // while (true) {
 }
 
+void CL_CALLBACK HostQueue::dependencyCallback(cl_event event, int32_t status, void* data) {
+  HostQueue* queue = static_cast<HostQueue*>(data);
+  if (queue->parked_.complete()) {
+    ScopedLock sl(queue->queueLock_);
+    queue->queueLock_.notify();
+  }
+  // The queue may be destroyed right after this
+  queue->parked_.done();
+}
+
 void HostQueue::append(Command& command) {
   // We retain the command here. It will be released when its status
   // changes to CL_COMPLETE
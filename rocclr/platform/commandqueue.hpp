@@ -31,6 +31,7 @@
 #include "thread/thread.hpp"
 #include "platform/object.hpp"
 #include "platform/command.hpp"
+#include "platform/parked_commands.hpp"
 /*! \brief Holds commands that will be executed on a specific device.
  *
  *  \details A command queue is created on a specific device in
@@ -111,6 +112,9 @@ class CommandQueue : public RuntimeObject {
   //! Returns the CU mask array
   const std::vector<uint32_t>& cuMask() const { return cuMask_; }
 
+  //! Returns true if the queue doesn't share its hardware queue with other queues
+  bool dedicatedQueue() const { return dedicatedQueue_; }
+
   //! Returns the queue lock
   Monitor& lock() { return queueLock_; }
 
@@ -123,7 +127,8 @@ class CommandQueue : public RuntimeObject {
                cl_command_queue_properties propMask,     //!< Queue properties mask
                uint rtCUs = RealTimeDisabled,            //!< Avaialble real time compute units
                Priority priority = Priority::Normal,     //!< Queue priority
-               const std::vector<uint32_t>& cuMask = {}  //!< CU mask
+               const std::vector<uint32_t>& cuMask = {}, //!< CU mask
+               bool dedicatedQueue = false               //!< Don't share the hardware queue
                )
       : properties_(propMask, properties),
         rtCUs_(rtCUs),
@@ -132,7 +137,8 @@ class CommandQueue : public RuntimeObject {
         lastCmdLock_("LastQueuedCommand"),
         device_(device),
         context_(context),
-        cuMask_(cuMask) {}
+        cuMask_(cuMask),
+        dedicatedQueue_(dedicatedQueue) {}
 
   Properties properties_;               //!< Queue properties
   uint rtCUs_;                          //!< The number of used RT compute units
@@ -142,6 +148,7 @@ class CommandQueue : public RuntimeObject {
   Device& device_;                      //!< The device
   SharedReference<Context> context_;    //!< The context of this command queue
   const std::vector<uint32_t> cuMask_;  //!< The CU mask
+  const bool dedicatedQueue_;           //!< The hardware queue isn't shared
 
  private:
   //! Disable copy constructor
@@ -167,6 +174,8 @@ class HostQueue : public CommandQueue {
     //! The command queue thread entry point.
     void run(void* data) {
       HostQueue* queue = static_cast<HostQueue*>(data);
+      // Keep the worker next to the host buffers of the device
+      Os::setPreferredNumaNode(queue->device().getPreferredNumaNode());
       virtualDevice_ = queue->device().createVirtualDevice(queue);
       if (virtualDevice_ != nullptr) {
         queue->loop(virtualDevice_);
@@ -184,7 +193,11 @@ class HostQueue : public CommandQueue {
       }
     }
 
-    void Release() const { delete virtualDevice_; }
+    void Release() const {
+      if (virtualDevice_ != nullptr) {
+        virtualDevice_->device().releaseVirtualDevice(virtualDevice_);
+      }
+    }
 
     //! Get virtual device for the current thread
     device::VirtualDevice* vdev() const { return virtualDevice_; }
@@ -199,9 +212,17 @@ class HostQueue : public CommandQueue {
 
   Command* lastEnqueueCommand_;  //!< The last submitted command
 
+  //! Commands, which wait for the dependencies in other queues
+  ParkedCommands<Command*> parked_;
+
+  activity_prof::RecordBuffer activityRecords_;  //!< Activity records, which wait for delivery
+
   //! Await commands and execute them as they become ready.
   void loop(device::VirtualDevice* virtualDevice);
 
+  //! Wakes up the command loop once all dependencies of the parked command are complete
+  static void CL_CALLBACK dependencyCallback(cl_event event, int32_t status, void* data);
+
  protected:
   virtual bool terminate();
 
@@ -213,7 +234,7 @@ class HostQueue : public CommandQueue {
    */
   HostQueue(Context& context, Device& device, cl_command_queue_properties properties,
             uint queueRTCUs = 0, Priority priority = Priority::Normal,
-            const std::vector<uint32_t>& cuMask = {});
+            const std::vector<uint32_t>& cuMask = {}, bool dedicatedQueue = false);
 
   //! Returns TRUE if this command queue can accept commands.
   virtual bool create() { return thread_.acceptingCommands_; }
@@ -242,6 +263,9 @@ class HostQueue : public CommandQueue {
   //! Return the current queue as the HostQueue
   virtual HostQueue* asHostQueue() { return this; }
 
+  //! Get the activity records of the queue
+  activity_prof::RecordBuffer& activityRecords() { return activityRecords_; }
+
   //! Get last enqueued command
   Command* getLastQueuedCommand(bool retain);
 
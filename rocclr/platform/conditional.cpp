@@ -0,0 +1,155 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "platform/conditional.hpp"
+
+namespace amd {
+
+// ================================================================================================
+bool ValidConditionalBodies(ConditionalType type, size_t numBodies) {
+  switch (type) {
+    case ConditionalType::If:
+      return (numBodies == 1) || (numBodies == 2);
+    case ConditionalType::While:
+      return numBodies == 1;
+    case ConditionalType::Switch:
+      return numBodies >= 1;
+  }
+  return false;
+}
+
+// ================================================================================================
+size_t SelectConditionalBody(ConditionalType type, size_t numBodies, uint32_t value) {
+  switch (type) {
+    case ConditionalType::If:
+      if (value != 0) {
+        return 0;
+      }
+      // The else body is optional
+      return (numBodies == 2) ? 1 : kNoConditionalBody;
+    case ConditionalType::While:
+      return (value != 0) ? 0 : kNoConditionalBody;
+    case ConditionalType::Switch:
+      return (value < numBodies) ? value : kNoConditionalBody;
+  }
+  return kNoConditionalBody;
+}
+
+// ================================================================================================
+bool ConditionalDriver::Evaluate() {
+  size_t body = SelectConditionalBody(type_, numBodies_, backend_->ReadCondition());
+  if (body == kNoConditionalBody) {
+    backend_->Complete(true);
+    return true;
+  }
+  if (!backend_->LaunchBody(body)) {
+    backend_->Complete(false);
+    return true;
+  }
+  // The body may be done already and the driver destroyed, hence don't touch it anymore
+  return false;
+}
+
+// ================================================================================================
+bool ConditionalDriver::Continue() {
+  if (type_ == ConditionalType::While) {
+    // The body updates the condition, so it has to be read again after every iteration
+    return Evaluate();
+  }
+  backend_->Complete(true);
+  return true;
+}
+
+// ================================================================================================
+ConditionalWorker::ConditionalWorker()
+    : lock_("Conditional worker lock"), running_(false) {}
+
+// ================================================================================================
+ConditionalWorker::~ConditionalWorker() {
+  bool started = false;
+  {
+    ScopedLock sl(lock_);
+    started = running_;
+    running_ = false;
+    lock_.notify();
+  }
+  // The thread accesses the lock until it exits
+  while (started && (thread_.state() < Thread::FINISHED) && Os::isThreadAlive(thread_)) {
+    Os::yield();
+  }
+}
+
+// ================================================================================================
+bool ConditionalWorker::Create() {
+  if (thread_.state() < Thread::INITIALIZED) {
+    return false;
+  }
+  running_ = true;
+  if (!thread_.start(this)) {
+    running_ = false;
+    return false;
+  }
+  return true;
+}
+
+// ================================================================================================
+void ConditionalWorker::Post(Task task, void* data) {
+  ScopedLock sl(lock_);
+  tasks_.emplace_back(task, data);
+  lock_.notify();
+}
+
+// ================================================================================================
+void ConditionalWorker::Loop() {
+  while (true) {
+    std::pair<Task, void*> task;
+    {
+      ScopedLock sl(lock_);
+      while (tasks_.empty()) {
+        if (!running_) {
+          return;
+        }
+        lock_.wait();
+      }
+      task = tasks_.front();
+      tasks_.pop_front();
+    }
+    // The task may post new tasks, hence it runs without the lock
+    task.first(task.second);
+  }
+}
+
+// ================================================================================================
+ConditionalWorker* ConditionalWorker::Instance() {
+  static Monitor instanceLock("Conditional worker instance lock");
+  static ConditionalWorker* instance = nullptr;
+  ScopedLock sl(instanceLock);
+  if (instance == nullptr) {
+    ConditionalWorker* worker = new ConditionalWorker();
+    if (!worker->Create()) {
+      delete worker;
+      return nullptr;
+    }
+    instance = worker;
+  }
+  return instance;
+}
+
+}  // namespace amd
@@ -0,0 +1,133 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+#include "thread/monitor.hpp"
+#include "thread/thread.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+namespace amd {
+
+//! Kind of a conditional graph node
+enum class ConditionalType : uint32_t {
+  If,      //!< Runs the first body once if the condition is set, the optional second one if not
+  While,   //!< Runs the body again as long as the condition stays set after an iteration
+  Switch   //!< Runs the body selected by the condition value, if it's in range
+};
+
+//! The body index, which selects no body at all
+constexpr size_t kNoConditionalBody = static_cast<size_t>(-1);
+
+//! Returns true if a conditional node of the type can have numBodies bodies
+bool ValidConditionalBodies(ConditionalType type, size_t numBodies);
+
+//! Returns the body a conditional node of the type runs for the condition value
+//! or kNoConditionalBody if it skips all of them
+size_t SelectConditionalBody(ConditionalType type, size_t numBodies, uint32_t value);
+
+//! Evaluates a conditional node on the host without a blocking wait. The backend reads
+//! the condition and launches the bodies asynchronously, it calls Continue() once a launched
+//! body is done. Every iteration is a round trip through the host.
+//! Start() and Continue() return true once the node execution is complete. While a body is in
+//! flight they return false and the completion of the body owns the state of the execution,
+//! so the caller mustn't access the driver or the backend afterwards
+class ConditionalDriver {
+ public:
+  class Backend {
+   public:
+    virtual ~Backend() {}
+    //! Returns the current value of the condition
+    virtual uint32_t ReadCondition() = 0;
+    //! Launches the body asynchronously. Returns false if the launch failed
+    virtual bool LaunchBody(size_t body) = 0;
+    //! Reports the end of the node execution. It's the last call of the driver
+    virtual void Complete(bool success) = 0;
+  };
+
+  ConditionalDriver(ConditionalType type, size_t numBodies, Backend* backend)
+      : type_(type), numBodies_(numBodies), backend_(backend) {}
+
+  //! Starts the node execution once its dependencies are done
+  bool Start() { return Evaluate(); }
+  //! Processes the completion of the last launched body
+  bool Continue();
+
+ private:
+  bool Evaluate();
+
+  ConditionalType type_;  //!< Kind of the node
+  size_t numBodies_;      //!< Number of the bodies
+  Backend* backend_;      //!< The backend, which runs the bodies
+};
+
+//! Runs the evaluations of the conditional nodes on a thread of its own. A body launch enqueues
+//! new work, hence the command completion callbacks only post the evaluation. Otherwise
+//! the launch would stall the completion processing of all other commands
+class ConditionalWorker : public HeapObject {
+ public:
+  //! An evaluation step, which the worker thread runs
+  typedef void (*Task)(void* data);
+
+  ConditionalWorker();
+  //! Runs the posted tasks and stops the worker thread
+  ~ConditionalWorker();
+
+  //! Starts the worker thread. Returns false if the thread can't be created
+  bool Create();
+
+  //! Queues the task for the worker thread. The tasks run in the posting order
+  void Post(Task task, void* data);
+
+  //! Returns true if the caller is the worker thread
+  bool IsCurrent() const { return Thread::current() == &thread_; }
+
+  //! Returns the worker of the process, starts it on the first call. The worker lives until
+  //! the process exit. Returns nullptr if the worker thread can't be created
+  static ConditionalWorker* Instance();
+
+ private:
+  //! Disable copy constructor
+  ConditionalWorker(const ConditionalWorker&) = delete;
+
+  //! Disable assignment
+  ConditionalWorker& operator=(const ConditionalWorker&) = delete;
+
+  class Thread : public amd::Thread {
+   public:
+    Thread() : amd::Thread("Conditional Worker Thread", CQ_THREAD_STACK_SIZE) {}
+
+    //! The worker thread entry point
+    void run(void* data) { reinterpret_cast<ConditionalWorker*>(data)->Loop(); }
+  } thread_;  //!< The worker thread
+
+  //! Runs the posted tasks until the worker is destroyed
+  void Loop();
+
+  Monitor lock_;                                //!< Protects the task queue
+  std::deque<std::pair<Task, void*>> tasks_;    //!< The posted tasks
+  bool running_;                                //!< The worker thread accepts tasks
+};
+
+}  // namespace amd
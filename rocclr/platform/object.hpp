@@ -21,7 +21,9 @@
 #ifndef OBJECT_HPP_
 #define OBJECT_HPP_
 
+#include <map>
 #include <set>
+#include <unordered_map>
 
 #include "top.hpp"
 #include "os/alloc.hpp"
@@ -43,7 +45,8 @@
 #define AMD_CL_TYPES_DO(F)                                                                         \
   F(cl_counter_amd, Counter)                                                                       \
   F(cl_perfcounter_amd, PerfCounter)                                                               \
-  F(cl_threadtrace_amd, ThreadTrace)
+  F(cl_threadtrace_amd, ThreadTrace)                                                               \
+  F(cl_command_buffer_khr, CommandBuffer)
 
 #define CL_TYPES_DO(F)                                                                             \
   KHR_CL_TYPES_DO(F)                                                                               \
@@ -144,7 +147,8 @@ class RuntimeObject : public ReferenceCountedObject, public ICDDispatchedObject
     ObjectTypeQueue = 8,
     ObjectTypeSampler = 9,
     ObjectTypeThreadTrace = 10,
-    ObjectTypeVMMAlloc = 11
+    ObjectTypeVMMAlloc = 11,
+    ObjectTypeCommandBuffer = 12
   };
 
   virtual ObjectType objectType() const = 0;
@@ -166,6 +170,62 @@ template <typename T> class SharedReference : public EmbeddedObject {
   T& operator()() const { return reference_; }
 };
 
+/*! \brief Shares the reference counted objects with an equal state.
+ *
+ * The cache holds a reference of every object. The object is dropped from the cache,
+ * when the last reference outside of the cache is released.
+ */
+template <typename Key, typename T> class SharedObjectCache : public HeapObject {
+ private:
+  Monitor lock_;                      //!< Guards the maps
+  std::map<Key, T*> objects_;         //!< Objects per state
+  std::unordered_map<T*, Key> keys_;  //!< States per object
+
+ public:
+  SharedObjectCache() : lock_("Shared object cache", true) {}
+
+  ~SharedObjectCache() {
+    for (auto& it : objects_) {
+      it.second->release();
+    }
+  }
+
+  //! Returns a retained object for the key. create() makes a new object on a miss.
+  template <typename Create> T* acquire(const Key& key, Create create) {
+    ScopedLock lock(lock_);
+    auto it = objects_.find(key);
+    if (it != objects_.end()) {
+      it->second->retain();
+      return it->second;
+    }
+    T* object = create();
+    if (object != nullptr) {
+      object->retain();
+      objects_.emplace(key, object);
+      keys_.emplace(object, key);
+    }
+    return object;
+  }
+
+  //! Releases an object returned by acquire()
+  void release(T* object) {
+    ScopedLock lock(lock_);
+    auto it = keys_.find(object);
+    if ((it != keys_.end()) && (object->referenceCount() == 2)) {
+      objects_.erase(it->second);
+      keys_.erase(it);
+      object->release();
+    }
+    object->release();
+  }
+
+  //! Returns the number of shared objects
+  size_t size() {
+    ScopedLock lock(lock_);
+    return objects_.size();
+  }
+};
+
 /*! \brief A 1,2 or 3D coordinate.
  *!
  *! Note, dimensionality is only defined for sizes, and is given by the number
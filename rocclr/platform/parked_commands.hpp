@@ -0,0 +1,79 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+
+namespace amd {
+
+//! Commands of an in-order queue, which wait for the dependencies in other queues. Only the
+//! first parked command waits for its dependencies, all the commands behind it are parked
+//! to keep the order. The parked commands belong to the queue thread, the dependency
+//! counters are updated from the completion callbacks of the other queues
+template <typename T> class ParkedCommands {
+ public:
+  ParkedCommands() : pending_(0), callbacks_(0) {}
+
+  //! Returns true if no command is parked
+  bool empty() const { return commands_.empty(); }
+
+  //! Returns true if the dependencies of the first parked command are complete
+  bool ready() const {
+    return !commands_.empty() && (pending_.load(std::memory_order_acquire) == 0);
+  }
+
+  //! Parks the command in front of the others, until its dependencies are complete.
+  //! Every dependency must report back with complete() and then done()
+  void park(T command, uint32_t dependencies) {
+    commands_.push_front(command);
+    pending_.store(dependencies, std::memory_order_release);
+    callbacks_.fetch_add(dependencies, std::memory_order_relaxed);
+  }
+
+  //! Parks the command behind the others to keep the order of the queue
+  void append(T command) { commands_.push_back(command); }
+
+  //! Removes the first parked command, once it's ready()
+  T resume() {
+    T command = commands_.front();
+    commands_.pop_front();
+    return command;
+  }
+
+  //! Reports a completed dependency. Returns true for the last one, hence the caller
+  //! has to wake up the queue thread
+  bool complete() { return pending_.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+  //! Reports the dependency callback doesn't access the queue anymore
+  void done() { callbacks_.fetch_sub(1, std::memory_order_release); }
+
+  //! Returns true while a dependency callback may still access the queue
+  bool busy() const { return callbacks_.load(std::memory_order_acquire) != 0; }
+
+ private:
+  std::deque<T> commands_;           //!< Parked commands in the queue order
+  std::atomic<uint32_t> pending_;    //!< Incomplete dependencies of the first command
+  std::atomic<uint32_t> callbacks_;  //!< Callbacks, which may still access the queue
+};
+
+}  // namespace amd
@@ -21,6 +21,7 @@
 #ifndef INC_EXT_PROF_PROTOCOL_H_
 #define INC_EXT_PROF_PROTOCOL_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 // Traced API domains
@@ -89,5 +90,8 @@ struct activity_record_t {
 typedef void (*activity_sync_callback_t)(uint32_t cid, activity_record_t* record, const void* data, void* arg);
 // Activity async calback type
 typedef void (*activity_async_callback_t)(uint32_t op, activity_record_t* record, void* arg);
+// Activity batch calback type, delivers count records of the domain at once
+typedef void (*activity_batch_callback_t)(activity_domain_t domain,
+                                          const activity_record_t* records, size_t count);
 
 #endif  // INC_EXT_PROF_PROTOCOL_H_
@@ -0,0 +1,200 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <platform/command_schedule.hpp>
+
+#include <cstdio>
+#include <vector>
+
+using amd::CommandSchedule;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+typedef std::vector<uint32_t> Deps;
+
+// Records a command and returns its sync point
+static cl_sync_point_khr add(CommandSchedule* schedule, std::vector<cl_sync_point_khr> waits,
+                             bool barrier = false) {
+  cl_sync_point_khr syncPoint = ~0u;
+  schedule->add(static_cast<uint32_t>(waits.size()), waits.empty() ? nullptr : waits.data(),
+                barrier, &syncPoint);
+  return syncPoint;
+}
+
+// The sync points must refer to earlier commands and match their count
+static bool testValidation() {
+  CommandSchedule schedule;
+  cl_sync_point_khr syncPoint = ~0u;
+  cl_sync_point_khr waits[] = {0, 1};
+  CHECK(schedule.add(1, nullptr, false, &syncPoint) == CL_INVALID_SYNC_POINT_WAIT_LIST_KHR);
+  CHECK(schedule.add(0, waits, false, &syncPoint) == CL_INVALID_SYNC_POINT_WAIT_LIST_KHR);
+  CHECK(schedule.add(1, waits, false, &syncPoint) == CL_INVALID_SYNC_POINT_WAIT_LIST_KHR);
+  CHECK(syncPoint == ~0u);
+  CHECK(schedule.add(0, nullptr, false, &syncPoint) == CL_SUCCESS);
+  CHECK(syncPoint == 0);
+  CHECK(schedule.add(2, waits, false, &syncPoint) == CL_INVALID_SYNC_POINT_WAIT_LIST_KHR);
+  CHECK(schedule.add(1, waits, false, nullptr) == CL_SUCCESS);
+  CHECK(schedule.size() == 2);
+  return true;
+}
+
+// A finalized schedule rejects records and another finalize
+static bool testFinalize() {
+  CommandSchedule schedule;
+  CHECK(!schedule.finalized());
+  CHECK(schedule.finalize(false) == CL_SUCCESS);
+  CHECK(schedule.finalized());
+  CHECK(schedule.sinks().empty());
+  CHECK(schedule.add(0, nullptr, false, nullptr) == CL_INVALID_OPERATION);
+  CHECK(schedule.finalize(false) == CL_INVALID_OPERATION);
+  CHECK(schedule.size() == 0);
+  return true;
+}
+
+// The waits are sorted without duplicates and the unwaited commands complete a replay
+static bool testSyncPoints() {
+  CommandSchedule schedule;
+  add(&schedule, {});
+  add(&schedule, {});
+  add(&schedule, {1, 0, 1});
+  add(&schedule, {0});
+  CHECK(schedule.finalize(false) == CL_SUCCESS);
+  CHECK(schedule.deps(0).empty());
+  CHECK(schedule.deps(2) == Deps({0, 1}));
+  CHECK(schedule.deps(3) == Deps({0}));
+  CHECK(schedule.sinks() == Deps({2, 3}));
+  return true;
+}
+
+// The commands after a barrier wait for it, the implied waits are dropped
+static bool testBarriers() {
+  CommandSchedule schedule;
+  add(&schedule, {});
+  add(&schedule, {});
+  CHECK(add(&schedule, {}, true) == 2);
+  CHECK(schedule.deps(2) == Deps({0, 1}));
+  add(&schedule, {0, 2});
+  CHECK(schedule.deps(3) == Deps({2}));
+  add(&schedule, {});
+  // A barrier with sync points waits for those and the previous barrier only
+  add(&schedule, {3}, true);
+  CHECK(schedule.deps(5) == Deps({2, 3}));
+  add(&schedule, {4});
+  CHECK(schedule.deps(6) == Deps({4, 5}));
+  // A barrier without sync points waits for the commands since the last such barrier
+  add(&schedule, {}, true);
+  CHECK(schedule.deps(7) == Deps({3, 4, 5, 6}));
+  add(&schedule, {6});
+  CHECK(schedule.deps(8) == Deps({7}));
+  CHECK(schedule.finalize(false) == CL_SUCCESS);
+  CHECK(schedule.sinks() == Deps({8}));
+  return true;
+}
+
+// An in-order queue runs the commands in the record order without any waits
+static bool testInOrder() {
+  CommandSchedule schedule;
+  add(&schedule, {});
+  add(&schedule, {0});
+  add(&schedule, {}, true);
+  add(&schedule, {1});
+  CHECK(schedule.finalize(true) == CL_SUCCESS);
+  for (size_t i = 0; i < schedule.size(); ++i) {
+    CHECK(schedule.deps(i).empty());
+  }
+  CHECK(schedule.sinks() == Deps({3}));
+  return true;
+}
+
+// A mutable update can only change the updatable fields of a launch with the same work dimension
+static bool testMutableDispatch() {
+  const size_t sizes[2] = {64, 1};
+  cl_mutable_dispatch_arg_khr arg = {0, sizeof(int), &sizes[0]};
+  cl_mutable_dispatch_config_khr config = {};
+  config.type = CL_STRUCTURE_TYPE_MUTABLE_DISPATCH_CONFIG_KHR;
+  CHECK(amd::ValidateMutableDispatch(config, 0, 2) == CL_SUCCESS);
+
+  cl_mutable_dispatch_config_khr invalid = config;
+  invalid.type = CL_STRUCTURE_TYPE_MUTABLE_BASE_CONFIG_KHR;
+  CHECK(amd::ValidateMutableDispatch(invalid, 0, 2) == CL_INVALID_VALUE);
+  invalid = config;
+  invalid.next = &config;
+  CHECK(amd::ValidateMutableDispatch(invalid, 0, 2) == CL_INVALID_VALUE);
+
+  cl_mutable_dispatch_config_khr args = config;
+  args.num_args = 1;
+  args.arg_list = &arg;
+  CHECK(amd::ValidateMutableDispatch(args, CL_MUTABLE_DISPATCH_GLOBAL_SIZE_KHR, 2) ==
+        CL_INVALID_OPERATION);
+  CHECK(amd::ValidateMutableDispatch(args, CL_MUTABLE_DISPATCH_ARGUMENTS_KHR, 2) == CL_SUCCESS);
+  args.arg_list = nullptr;
+  CHECK(amd::ValidateMutableDispatch(args, CL_MUTABLE_DISPATCH_ARGUMENTS_KHR, 2) ==
+        CL_INVALID_VALUE);
+  args = config;
+  args.num_svm_args = 1;
+  CHECK(amd::ValidateMutableDispatch(args, CL_MUTABLE_DISPATCH_ARGUMENTS_KHR, 2) ==
+        CL_INVALID_VALUE);
+
+  // The exec info updates aren't supported
+  cl_mutable_dispatch_config_khr execInfo = config;
+  execInfo.num_exec_infos = 1;
+  CHECK(amd::ValidateMutableDispatch(execInfo, ~0ull, 2) == CL_INVALID_OPERATION);
+
+  cl_mutable_dispatch_config_khr ndrange = config;
+  ndrange.global_work_offset = sizes;
+  CHECK(amd::ValidateMutableDispatch(ndrange, CL_MUTABLE_DISPATCH_GLOBAL_SIZE_KHR, 2) ==
+        CL_INVALID_OPERATION);
+  CHECK(amd::ValidateMutableDispatch(ndrange, CL_MUTABLE_DISPATCH_GLOBAL_OFFSET_KHR, 2) ==
+        CL_SUCCESS);
+  ndrange = config;
+  ndrange.global_work_size = sizes;
+  CHECK(amd::ValidateMutableDispatch(ndrange, CL_MUTABLE_DISPATCH_LOCAL_SIZE_KHR, 2) ==
+        CL_INVALID_OPERATION);
+  ndrange = config;
+  ndrange.local_work_size = sizes;
+  CHECK(amd::ValidateMutableDispatch(ndrange, CL_MUTABLE_DISPATCH_GLOBAL_SIZE_KHR, 2) ==
+        CL_INVALID_OPERATION);
+  CHECK(amd::ValidateMutableDispatch(ndrange, CL_MUTABLE_DISPATCH_LOCAL_SIZE_KHR, 2) ==
+        CL_SUCCESS);
+
+  // The work dimension is optional, but must match the recorded launch
+  ndrange.work_dim = 2;
+  CHECK(amd::ValidateMutableDispatch(ndrange, CL_MUTABLE_DISPATCH_LOCAL_SIZE_KHR, 2) ==
+        CL_SUCCESS);
+  CHECK(amd::ValidateMutableDispatch(ndrange, CL_MUTABLE_DISPATCH_LOCAL_SIZE_KHR, 1) ==
+        CL_INVALID_VALUE);
+  return true;
+}
+
+int main() {
+  bool passed = true;
+  passed &= testValidation();
+  passed &= testFinalize();
+  passed &= testSyncPoints();
+  passed &= testBarriers();
+  passed &= testInOrder();
+  passed &= testMutableDispatch();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
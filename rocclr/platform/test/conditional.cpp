@@ -0,0 +1,247 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <platform/conditional.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+using amd::ConditionalDriver;
+using amd::ConditionalType;
+using amd::ConditionalWorker;
+using amd::kNoConditionalBody;
+using amd::SelectConditionalBody;
+using amd::ValidConditionalBodies;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+// Stand-in for the device. The launched bodies are queued and run by Drain(), like a stream,
+// which completes them after the launch returns. A body can update the condition value
+class Backend : public ConditionalDriver::Backend {
+ public:
+  typedef void (*Body)(Backend* backend);
+
+  uint32_t ReadCondition() override { return value_; }
+  bool LaunchBody(size_t body) override {
+    if (body == failBody_) {
+      return false;
+    }
+    trace_ += "B" + std::to_string(body) + " ";
+    pending_.push_back(body);
+    return true;
+  }
+  void Complete(bool success) override {
+    trace_ += success ? "C" : "F";
+    ++completions_;
+  }
+
+  // Runs the queued bodies and reports their completion to the driver. Only the call,
+  // which completes the node, may report the end, since it releases the launch state
+  void Drain(ConditionalDriver* driver, bool done) {
+    owners_ += done ? 1 : 0;
+    while (!pending_.empty()) {
+      if (done) {
+        ownedLaunch_ = true;
+      }
+      size_t body = pending_.front();
+      pending_.pop_front();
+      if (body < bodies_.size() && bodies_[body] != nullptr) {
+        bodies_[body](this);
+      }
+      done = driver->Continue();
+      owners_ += done ? 1 : 0;
+    }
+  }
+
+  uint32_t value_ = 0;
+  size_t failBody_ = kNoConditionalBody;
+  std::vector<Body> bodies_;
+  std::deque<size_t> pending_;
+  std::string trace_;
+  int completions_ = 0;
+  int owners_ = 0;            //!< Calls, which reported the end of the execution
+  bool ownedLaunch_ = false;  //!< A body was still in flight after the end was reported
+};
+
+static std::string run(ConditionalType type, size_t numBodies, Backend* backend) {
+  ConditionalDriver driver(type, numBodies, backend);
+  backend->Drain(&driver, driver.Start());
+  if ((backend->owners_ != 1) || backend->ownedLaunch_) {
+    return "invalid ownership";
+  }
+  return backend->trace_;
+}
+
+// Only the body counts the graph APIs accept are valid
+static bool testValidation() {
+  CHECK(!ValidConditionalBodies(ConditionalType::If, 0));
+  CHECK(ValidConditionalBodies(ConditionalType::If, 1));
+  CHECK(ValidConditionalBodies(ConditionalType::If, 2));
+  CHECK(!ValidConditionalBodies(ConditionalType::If, 3));
+  CHECK(!ValidConditionalBodies(ConditionalType::While, 0));
+  CHECK(ValidConditionalBodies(ConditionalType::While, 1));
+  CHECK(!ValidConditionalBodies(ConditionalType::While, 2));
+  CHECK(!ValidConditionalBodies(ConditionalType::Switch, 0));
+  CHECK(ValidConditionalBodies(ConditionalType::Switch, 5));
+  return true;
+}
+
+static bool testSelection() {
+  CHECK(SelectConditionalBody(ConditionalType::If, 1, 7) == 0);
+  CHECK(SelectConditionalBody(ConditionalType::If, 1, 0) == kNoConditionalBody);
+  CHECK(SelectConditionalBody(ConditionalType::If, 2, 0) == 1);
+  CHECK(SelectConditionalBody(ConditionalType::While, 1, 1) == 0);
+  CHECK(SelectConditionalBody(ConditionalType::While, 1, 0) == kNoConditionalBody);
+  CHECK(SelectConditionalBody(ConditionalType::Switch, 3, 2) == 2);
+  CHECK(SelectConditionalBody(ConditionalType::Switch, 3, 3) == kNoConditionalBody);
+  return true;
+}
+
+// If and switch nodes run at most one body once
+static bool testIfSwitch() {
+  Backend taken;
+  taken.value_ = 1;
+  CHECK(run(ConditionalType::If, 2, &taken) == "B0 C");
+  Backend otherwise;
+  CHECK(run(ConditionalType::If, 2, &otherwise) == "B1 C");
+  Backend skipped;
+  CHECK(run(ConditionalType::If, 1, &skipped) == "C");
+  Backend sw;
+  sw.value_ = 2;
+  CHECK(run(ConditionalType::Switch, 4, &sw) == "B2 C");
+  Backend outOfRange;
+  outOfRange.value_ = 4;
+  CHECK(run(ConditionalType::Switch, 4, &outOfRange) == "C");
+  CHECK(outOfRange.completions_ == 1);
+  return true;
+}
+
+// A while node runs the body until the body clears the condition
+static bool testWhile() {
+  Backend loop;
+  loop.value_ = 3;
+  loop.bodies_.push_back([](Backend* backend) { --backend->value_; });
+  CHECK(run(ConditionalType::While, 1, &loop) == "B0 B0 B0 C");
+  CHECK(loop.completions_ == 1);
+  Backend never;
+  CHECK(run(ConditionalType::While, 1, &never) == "C");
+  return true;
+}
+
+// A failed launch completes the node with an error and stops the loop
+static bool testFailure() {
+  Backend backend;
+  backend.value_ = 1;
+  backend.failBody_ = 0;
+  CHECK(run(ConditionalType::While, 1, &backend) == "F");
+  CHECK(backend.completions_ == 1);
+  return true;
+}
+
+// A launch of a while node, evaluated on the worker. The bodies complete on threads of their own,
+// which only post the evaluation, as the command completion callbacks do
+class WorkerLaunch : public ConditionalDriver::Backend {
+ public:
+  WorkerLaunch(ConditionalWorker* worker, uint32_t iterations)
+      : worker_(worker), driver_(ConditionalType::While, 1, this), value_(iterations) {}
+
+  uint32_t ReadCondition() override {
+    CheckThread();
+    return value_;
+  }
+  bool LaunchBody(size_t body) override {
+    CheckThread();
+    --value_;
+    ++launches_;
+    completions_.emplace_back([this]() {
+      // The runtime locks need an amd::Thread, as the runtime callback threads have
+      new amd::HostThread();
+      worker_->Post(ContinueTask, this);
+    });
+    return true;
+  }
+  void Complete(bool success) override {
+    CheckThread();
+    done_ = true;
+  }
+
+  void CheckThread() {
+    if (!worker_->IsCurrent()) {
+      offWorker_ = true;
+    }
+  }
+
+  static void StartTask(void* data) { reinterpret_cast<WorkerLaunch*>(data)->driver_.Start(); }
+  static void ContinueTask(void* data) {
+    reinterpret_cast<WorkerLaunch*>(data)->driver_.Continue();
+  }
+
+  ConditionalWorker* worker_;
+  ConditionalDriver driver_;
+  uint32_t value_;
+  uint32_t launches_ = 0;
+  std::atomic<bool> offWorker_{false};
+  std::atomic<bool> done_{false};
+  std::vector<std::thread> completions_;  //!< Accessed on the worker thread only
+};
+
+// The worker runs every evaluation step, the posting threads never launch a body
+static bool testWorker() {
+  if (amd::Thread::current() == nullptr) {
+    new amd::HostThread();
+  }
+  ConditionalWorker* worker = new ConditionalWorker();
+  CHECK(worker->Create());
+  CHECK(!worker->IsCurrent());
+  WorkerLaunch launch(worker, 16);
+  worker->Post(WorkerLaunch::StartTask, &launch);
+  while (!launch.done_) {
+    std::this_thread::yield();
+  }
+  // Every body completion has posted its evaluation once the launch is done
+  for (auto& it : launch.completions_) {
+    it.join();
+  }
+  delete worker;
+  CHECK(!launch.offWorker_);
+  CHECK(launch.launches_ == 16);
+  CHECK(launch.value_ == 0);
+  return true;
+}
+
+int main() {
+  bool passed = true;
+  passed &= testValidation();
+  passed &= testSelection();
+  passed &= testIfSwitch();
+  passed &= testWhile();
+  passed &= testFailure();
+  passed &= testWorker();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
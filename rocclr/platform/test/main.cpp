@@ -0,0 +1,245 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <platform/activity.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Mock profiler: it accepts all operations and keeps a copy of the delivered records
+struct MockTool {
+  struct Record {
+    activity_record_t record_;
+    std::string name_;
+  };
+  std::vector<Record> records_;
+  std::vector<size_t> batches_;
+  size_t single_ = 0;
+  void (*onBatch_)() = nullptr;  //!< Calls back the runtime from the batch callback
+
+  void add(const activity_record_t& record) {
+    records_.push_back({record, (record.op == OP_ID_DISPATCH) ? record.kernel_name : ""});
+  }
+
+  void reset() {
+    records_.clear();
+    batches_.clear();
+    single_ = 0;
+  }
+} tool;
+
+static int reportActivity(activity_domain_t domain, uint32_t operation_id, void* data) {
+  if (data != nullptr) {
+    tool.add(*reinterpret_cast<activity_record_t*>(data));
+    tool.single_++;
+  }
+  return 0;
+}
+
+static void reportActivityBatch(activity_domain_t domain, const activity_record_t* records,
+                                size_t count) {
+  tool.batches_.push_back(count);
+  for (size_t i = 0; i < count; ++i) {
+    tool.add(records[i]);
+  }
+  if (tool.onBatch_ != nullptr) {
+    tool.onBatch_();
+  }
+}
+
+static activity_record_t makeRecord(uint64_t id, uint64_t queueId, const char* name) {
+  activity_record_t record{};
+  record.domain = ACTIVITY_DOMAIN_HIP_OPS;
+  record.op = (name != nullptr) ? OP_ID_DISPATCH : OP_ID_COPY;
+  record.kind = (name != nullptr) ? CL_COMMAND_NDRANGE_KERNEL : CL_COMMAND_COPY_BUFFER;
+  record.correlation_id = id;
+  record.begin_ns = 1000 * id;
+  record.end_ns = 1000 * id + 500;
+  record.device_id = 0;
+  record.queue_id = queueId;
+  if (name != nullptr) {
+    record.kernel_name = name;
+  } else {
+    record.bytes = id;
+  }
+  return record;
+}
+
+static bool checkRecord(const MockTool::Record& record, uint64_t id) {
+  if ((record.record_.correlation_id != id) || (record.record_.begin_ns != 1000 * id) ||
+      (record.record_.end_ns != 1000 * id + 500)) {
+    printf("Record %lu has invalid id or timestamps\n", id);
+    return false;
+  }
+  if ((id % 2) == 0) {
+    if (record.name_ != "kernel_" + std::to_string(id)) {
+      printf("Record %lu has invalid kernel name %s\n", id, record.name_.c_str());
+      return false;
+    }
+  } else if (record.record_.bytes != id) {
+    printf("Record %lu has invalid size\n", id);
+    return false;
+  }
+  return true;
+}
+
+// Appends records from one thread, even records are kernels with temporary names
+static bool testOrder(size_t count) {
+  tool.reset();
+  {
+    amd::activity_prof::RecordBuffer buffer;
+    for (uint64_t id = 0; id < count; ++id) {
+      std::string name = "kernel_" + std::to_string(id);
+      buffer.append(makeRecord(id, 0, ((id % 2) == 0) ? name.c_str() : nullptr));
+      // The buffer must own the name copy
+      memset(&name[0], 'x', name.size());
+    }
+    if (tool.records_.size() != (count / amd::activity_prof::RecordBuffer::kCapacity) *
+                                    amd::activity_prof::RecordBuffer::kCapacity) {
+      printf("Only the full buffers must be delivered before the flush\n");
+      return false;
+    }
+    buffer.flush();
+  }
+  if (tool.records_.size() != count) {
+    printf("Delivered %zu records, expected %zu\n", tool.records_.size(), count);
+    return false;
+  }
+  for (auto batch : tool.batches_) {
+    if (batch > amd::activity_prof::RecordBuffer::kCapacity) {
+      printf("Batch of %zu records exceeds the capacity\n", batch);
+      return false;
+    }
+  }
+  if (tool.single_ != 0) {
+    printf("Records were delivered one by one with the batch callback\n");
+    return false;
+  }
+  for (uint64_t id = 0; id < count; ++id) {
+    if (!checkRecord(tool.records_[id], id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Appends records from several threads, each thread uses its own queue id
+static bool testThreads(uint32_t threads, size_t count) {
+  tool.reset();
+  amd::activity_prof::RecordBuffer buffer;
+  std::vector<std::thread> workers;
+  for (uint32_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&buffer, t, count]() {
+      for (uint64_t id = 0; id < count; ++id) {
+        std::string name = "kernel_" + std::to_string(id);
+        buffer.append(makeRecord(id, t, ((id % 2) == 0) ? name.c_str() : nullptr));
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  amd::activity_prof::RecordBuffer::flushAll();
+  if (tool.records_.size() != threads * count) {
+    printf("Delivered %zu records, expected %zu\n", tool.records_.size(), threads * count);
+    return false;
+  }
+  // The records of each thread must keep the order of the appends
+  std::vector<uint64_t> next(threads, 0);
+  for (const auto& record : tool.records_) {
+    uint64_t& id = next[record.record_.queue_id];
+    if (!checkRecord(record, id)) {
+      return false;
+    }
+    id++;
+  }
+  return true;
+}
+
+// Without the batch callback the pending records go through the per record callback
+static bool testFallback(size_t count) {
+  tool.reset();
+  amd::activity_prof::RecordBuffer buffer;
+  for (uint64_t id = 0; id < count; ++id) {
+    std::string name = "kernel_" + std::to_string(id);
+    buffer.append(makeRecord(id, 0, ((id % 2) == 0) ? name.c_str() : nullptr));
+  }
+  amd::activity_prof::report_activity_batch.store(nullptr);
+  buffer.flush();
+  amd::activity_prof::report_activity_batch.store(reportActivityBatch);
+  if ((tool.single_ != count) || !tool.batches_.empty()) {
+    printf("Delivered %zu records one by one, expected %zu\n", tool.single_, count);
+    return false;
+  }
+  for (uint64_t id = 0; id < count; ++id) {
+    if (!checkRecord(tool.records_[id], id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The batch callback creates and destroys a queue and flushes all queues again.
+// The nested flush of the buffer in delivery keeps its records for the next flush.
+static bool testReentrant(size_t count) {
+  tool.reset();
+  amd::activity_prof::RecordBuffer buffer;
+  for (uint64_t id = 0; id < count; ++id) {
+    std::string name = "kernel_" + std::to_string(id);
+    buffer.append(makeRecord(id, 0, ((id % 2) == 0) ? name.c_str() : nullptr));
+  }
+  tool.onBatch_ = []() {
+    amd::activity_prof::RecordBuffer other;
+    amd::activity_prof::RecordBuffer::flushAll();
+  };
+  amd::activity_prof::RecordBuffer::flushAll();
+  tool.onBatch_ = nullptr;
+  if (tool.records_.size() != count) {
+    printf("Delivered %zu records, expected %zu\n", tool.records_.size(), count);
+    return false;
+  }
+  for (uint64_t id = 0; id < count; ++id) {
+    if (!checkRecord(tool.records_[id], id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  amd::activity_prof::report_activity.store(reportActivity);
+  amd::activity_prof::report_activity_batch.store(reportActivityBatch);
+
+  bool passed = true;
+  passed &= testOrder(1);
+  passed &= testOrder(amd::activity_prof::RecordBuffer::kCapacity);
+  passed &= testOrder(10000);
+  passed &= testThreads(4, 10000);
+  passed &= testFallback(100);
+  passed &= testReentrant(100);
+
+  amd::activity_prof::report_activity_batch.store(nullptr);
+  amd::activity_prof::report_activity.store(nullptr);
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
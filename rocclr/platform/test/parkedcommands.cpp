@@ -0,0 +1,160 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <platform/parked_commands.hpp>
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using amd::ParkedCommands;
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+// The commands behind the parked command keep the queue order
+static bool testOrder() {
+  ParkedCommands<int> parked;
+  CHECK(parked.empty() && !parked.ready() && !parked.busy());
+  parked.park(1, 2);
+  parked.append(2);
+  parked.append(3);
+  CHECK(!parked.empty() && !parked.ready() && parked.busy());
+  CHECK(!parked.complete());
+  parked.done();
+  CHECK(!parked.ready());
+  CHECK(parked.complete());
+  CHECK(parked.ready());
+  // The callback may still hold the queue after the last completion
+  CHECK(parked.busy());
+  parked.done();
+  CHECK(!parked.busy());
+  CHECK(parked.resume() == 1);
+  // The next command checks its own dependencies and may park again in front
+  CHECK(parked.ready());
+  CHECK(parked.resume() == 2);
+  parked.park(2, 1);
+  CHECK(!parked.ready());
+  CHECK(parked.complete());
+  parked.done();
+  CHECK(parked.resume() == 2);
+  CHECK(parked.resume() == 3);
+  CHECK(parked.empty() && !parked.ready() && !parked.busy());
+  return true;
+}
+
+// Mirrors HostQueue::loop: the worker parks the commands with dependencies, the callbacks
+// from other threads wake it up and the termination waits for the callbacks
+static bool testCallbacks() {
+  constexpr int kCommands = 64;
+  constexpr uint32_t kDependencies = 4;
+  ParkedCommands<int> parked;
+  std::mutex lock;
+  std::condition_variable wakeup;
+  std::vector<int> queue;
+  std::vector<int> executed;
+  std::vector<std::thread> callbacks;
+  bool accepting = true;
+
+  auto callback = [&]() {
+    if (parked.complete()) {
+      std::lock_guard<std::mutex> sl(lock);
+      wakeup.notify_one();
+    }
+    parked.done();
+  };
+
+  std::thread worker([&]() {
+    size_t next = 0;
+    std::vector<bool> resumed(kCommands, false);
+    while (true) {
+      int command = -1;
+      if (parked.ready()) {
+        command = parked.resume();
+      } else {
+        std::unique_lock<std::mutex> sl(lock);
+        while (next == queue.size()) {
+          if (parked.ready()) {
+            break;
+          }
+          if (!accepting && parked.empty()) {
+            return;
+          }
+          wakeup.wait(sl);
+        }
+        if (next == queue.size()) {
+          continue;
+        }
+        command = queue[next++];
+        sl.unlock();
+        if (!parked.empty()) {
+          parked.append(command);
+          continue;
+        }
+      }
+      // Every odd command waits for other queues on the first processing
+      if ((command % 2 == 1) && !resumed[command]) {
+        resumed[command] = true;
+        parked.park(command, kDependencies);
+        for (uint32_t i = 0; i < kDependencies; ++i) {
+          callbacks.emplace_back(callback);
+        }
+        continue;
+      }
+      executed.push_back(command);
+    }
+  });
+
+  for (int i = 0; i < kCommands; ++i) {
+    std::lock_guard<std::mutex> sl(lock);
+    queue.push_back(i);
+    wakeup.notify_one();
+  }
+  {
+    std::lock_guard<std::mutex> sl(lock);
+    accepting = false;
+    wakeup.notify_one();
+  }
+  worker.join();
+  while (parked.busy()) {
+    std::this_thread::yield();
+  }
+  for (auto& it : callbacks) {
+    it.join();
+  }
+
+  CHECK(parked.empty());
+  CHECK(executed.size() == kCommands);
+  for (int i = 0; i < kCommands; ++i) {
+    CHECK(executed[i] == i);
+  }
+  return true;
+}
+
+int main() {
+  bool passed = testOrder() && testCallbacks();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -22,11 +22,15 @@
 #include "thread/semaphore.hpp"
 #include "thread/thread.hpp"
 #include "utils/util.hpp"
+#include "os/os.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <cstdlib>
 #include <cstring>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace amd {
 MonitorBase::~MonitorBase() {}
@@ -404,4 +408,196 @@ void Monitor::unlock() {
   finishUnlock();
 }
 } // namespace legacy_monitor
+
+namespace profile_monitor {
+
+static constexpr uint32_t kMaxNames = 256;  //!< Max number of profiled monitor names
+
+enum Counter { kAcquires = 0, kContended, kWaitNs, kMaxWaitNs, kHoldNs, kNumCounters };
+
+//! Statistics of a single thread. Only the owner thread updates the counters
+struct ThreadStats {
+  std::atomic<uint64_t> counters_[kMaxNames][kNumCounters] = {};
+  ThreadStats* next_ = nullptr;  //!< Next record in the list of all records
+};
+
+//! Names and statistics records. It's never destroyed, so the exit dump can still access it
+struct Registry {
+  std::mutex lock_;                        //!< Guards the names and the free records
+  char names_[kMaxNames][64] = {};         //!< Monitor names per statistics slot
+  uint32_t numNames_ = 0;                  //!< Number of used slots
+  std::atomic<ThreadStats*> threads_{};    //!< All records, including the free ones
+  std::vector<ThreadStats*> free_;         //!< Records of the finished threads
+  ThreadStats retired_;                    //!< Accumulated statistics of the finished threads
+};
+
+static Registry& registry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+static void dumpAtExit() { Monitor::dump(stderr); }
+
+static uint32_t findSlot(const char* name) {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.lock_);
+  for (uint32_t i = 0; i < reg.numNames_; ++i) {
+    if (::strcmp(reg.names_[i], name) == 0) {
+      return i;
+    }
+  }
+  if (reg.numNames_ == 0) {
+    std::atexit(dumpAtExit);
+  }
+  if (reg.numNames_ == kMaxNames) {
+    return kMaxNames - 1;
+  }
+  // Out of slots, the last one collects all other names
+  const char* slotName = (reg.numNames_ == kMaxNames - 1) ? "@other@" : name;
+  ::strncpy(reg.names_[reg.numNames_], slotName, sizeof(reg.names_[0]) - 1);
+  return reg.numNames_++;
+}
+
+//! Owner of the thread local record. Moves the statistics to the retired record on thread exit
+class ThreadStatsHolder {
+ public:
+  ThreadStats* get() {
+    if (unlikely(stats_ == nullptr)) {
+      Registry& reg = registry();
+      std::lock_guard<std::mutex> lock(reg.lock_);
+      if (!reg.free_.empty()) {
+        stats_ = reg.free_.back();
+        reg.free_.pop_back();
+      } else {
+        stats_ = new ThreadStats();
+        stats_->next_ = reg.threads_.load(std::memory_order_relaxed);
+        reg.threads_.store(stats_, std::memory_order_release);
+      }
+    }
+    return stats_;
+  }
+
+  ~ThreadStatsHolder() {
+    if (stats_ == nullptr) {
+      return;
+    }
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.lock_);
+    for (uint32_t i = 0; i < kMaxNames; ++i) {
+      for (uint32_t c = 0; c < kNumCounters; ++c) {
+        uint64_t value = stats_->counters_[i][c].exchange(0, std::memory_order_relaxed);
+        if (c == kMaxWaitNs) {
+          uint64_t prev = reg.retired_.counters_[i][c].load(std::memory_order_relaxed);
+          reg.retired_.counters_[i][c].store(std::max(prev, value), std::memory_order_relaxed);
+        } else {
+          reg.retired_.counters_[i][c].fetch_add(value, std::memory_order_relaxed);
+        }
+      }
+    }
+    reg.free_.push_back(stats_);
+    // Monitors may still be used in the exit handlers, so they get a new record
+    stats_ = nullptr;
+  }
+
+ private:
+  ThreadStats* stats_ = nullptr;
+};
+
+static thread_local ThreadStatsHolder threadStats;
+
+//! Single writer update of a thread local counter
+static inline void add(std::atomic<uint64_t>& counter, uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+Monitor::Monitor(MonitorBase* monitor)
+    : monitor_(monitor), slot_(findSlot(monitor->name())), depth_(0), holdStart_(0) {}
+
+void Monitor::acquired() {
+  if (depth_++ == 0) {
+    holdStart_ = Os::timeNanos();
+  }
+}
+
+bool Monitor::tryLock() {
+  if (!monitor_->tryLock()) {
+    return false;
+  }
+  add(threadStats.get()->counters_[slot_][kAcquires], 1);
+  acquired();
+  return true;
+}
+
+void Monitor::lock() {
+  std::atomic<uint64_t>* counters = threadStats.get()->counters_[slot_];
+  if (!monitor_->tryLock()) {
+    uint64_t start = Os::timeNanos();
+    monitor_->lock();
+    uint64_t wait = Os::timeNanos() - start;
+    add(counters[kContended], 1);
+    add(counters[kWaitNs], wait);
+    if (wait > counters[kMaxWaitNs].load(std::memory_order_relaxed)) {
+      counters[kMaxWaitNs].store(wait, std::memory_order_relaxed);
+    }
+  }
+  add(counters[kAcquires], 1);
+  acquired();
+}
+
+void Monitor::unlock() {
+  if (--depth_ == 0) {
+    add(threadStats.get()->counters_[slot_][kHoldNs], Os::timeNanos() - holdStart_);
+  }
+  monitor_->unlock();
+}
+
+void Monitor::wait() {
+  // The lock isn't held during the wait
+  add(threadStats.get()->counters_[slot_][kHoldNs], Os::timeNanos() - holdStart_);
+  monitor_->wait();
+  holdStart_ = Os::timeNanos();
+}
+
+void Monitor::dump(FILE* file) {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.lock_);
+  struct Entry {
+    const char* name_;
+    uint64_t counters_[kNumCounters];
+  };
+  std::vector<Entry> entries;
+  for (uint32_t i = 0; i < reg.numNames_; ++i) {
+    Entry entry = {reg.names_[i], {}};
+    auto accumulate = [&entry, i](const ThreadStats& stats) {
+      for (uint32_t c = 0; c < kNumCounters; ++c) {
+        uint64_t value = stats.counters_[i][c].load(std::memory_order_relaxed);
+        entry.counters_[c] = (c == kMaxWaitNs) ? std::max(entry.counters_[c], value)
+                                               : entry.counters_[c] + value;
+      }
+    };
+    accumulate(reg.retired_);
+    for (ThreadStats* stats = reg.threads_.load(std::memory_order_acquire); stats != nullptr;
+         stats = stats->next_) {
+      accumulate(*stats);
+    }
+    if (entry.counters_[kAcquires] != 0) {
+      entries.push_back(entry);
+    }
+  }
+  // The most expensive locks first
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+    return a.counters_[kWaitNs] > b.counters_[kWaitNs];
+  });
+  fprintf(file, "%-40s %12s %12s %14s %12s %14s\n", "Monitor", "Acquires", "Contended",
+          "Wait(us)", "MaxWait(us)", "Hold(us)");
+  for (const auto& entry : entries) {
+    fprintf(file, "%-40.40s %12llu %12llu %14.1f %12.1f %14.1f\n", entry.name_,
+            static_cast<unsigned long long>(entry.counters_[kAcquires]),
+            static_cast<unsigned long long>(entry.counters_[kContended]),
+            entry.counters_[kWaitNs] / 1000.0, entry.counters_[kMaxWaitNs] / 1000.0,
+            entry.counters_[kHoldNs] / 1000.0);
+  }
+  fflush(file);
+}
+} // namespace profile_monitor
 }  // namespace amd
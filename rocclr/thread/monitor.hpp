@@ -26,6 +26,7 @@
 #include "thread/semaphore.hpp"
 #include "thread/thread.hpp"
 #include <condition_variable>
+#include <cstdio>
 #include <mutex>
 #include <atomic>
 #include <tuple>
@@ -258,6 +259,40 @@ class Monitor final: public HeapObject, public MonitorBase {
 };
 } // namespace mutex_monitor
 
+namespace profile_monitor {
+/*! \brief Collects the contention statistics of a monitor.
+ *
+ *  The statistics are aggregated per monitor name in thread local counters,
+ *  hence the lock path doesn't need any additional synchronization.
+ */
+class Monitor final: public HeapObject, public MonitorBase {
+ public:
+  //! Takes the ownership of the profiled monitor
+  explicit Monitor(MonitorBase* monitor);
+  ~Monitor() { delete monitor_; }
+
+  bool tryLock();
+  void lock();
+  void unlock();
+  void wait();
+  void notify() { monitor_->notify(); }
+  void notifyAll() { monitor_->notifyAll(); }
+  const char* name() const { return monitor_->name(); }
+
+  //! Print the statistics of all profiled monitor names
+  static void dump(FILE* file);
+
+ private:
+  //! Start of the hold time for the owner
+  void acquired();
+
+  MonitorBase* monitor_;  //!< The profiled monitor
+  uint32_t slot_;         //!< Statistics slot of the monitor name
+  uint32_t depth_;        //!< Recursion depth of the owner
+  uint64_t holdStart_;    //!< Time the owner acquired the lock
+};
+} // namespace profile_monitor
+
 // Monitor API wrapper to user
 class Monitor {
 public:
@@ -268,6 +303,9 @@ public:
     else {
       monitor_ = new legacy_monitor::Monitor(name, recursive);
     }
+    if (DEBUG_CLR_MONITOR_PROFILE) {
+      monitor_ = new profile_monitor::Monitor(monitor_);
+    }
   }
   inline ~Monitor() { delete monitor_; };
   inline bool tryLock() { return monitor_->tryLock(); }
@@ -24,7 +24,9 @@
 #include "top.hpp"
 #include "os/alloc.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <mutex>
 #include <new>
 
 //! \addtogroup Utils
@@ -55,16 +57,273 @@ template <typename T, int N> struct TaggedPointerHelper {
   size_t tag() const { return reinterpret_cast<uintptr_t>(this) & TagMask; }
 };
 
+//! Hazard pointers of a thread. The records are never freed, new threads reuse them.
+struct HazardRecord {
+  static constexpr int kNumHazards = 2;
+
+  std::atomic<void*> hazards_[kNumHazards] = {};  //!< Nodes the thread may access
+  std::atomic<bool> active_{false};               //!< The record is owned by a thread
+  HazardRecord* next_ = nullptr;                  //!< Next record in the list of all records
+};
+
+/*! \brief Node allocator with safe memory reclamation for the lock-free containers.
+ *
+ * A node removed from a container is retired and becomes free only when no thread holds a
+ * hazard pointer on it. Every thread keeps its own free and retired lists, and exchanges free
+ * nodes with a shared pool in batches, hence a producer thread reuses the nodes retired by a
+ * consumer thread. The nodes are never returned to the allocator, so steady state operations
+ * don't allocate. The Node type must provide a "Node* link_" member for the lists.
+ */
+template <typename Node, size_t Alignment> class NodeRecycler : public AllStatic {
+ public:
+  //! Return the hazard pointers of the calling thread.
+  static std::atomic<void*>* hazards() { return cache_.record()->hazards_; }
+
+  //! Return a free node.
+  static Node* alloc() {
+    ThreadCache& cache = cache_;
+    if (unlikely(cache.free_ == nullptr)) {
+      cache.refill();
+    }
+    Node* node = cache.free_;
+    cache.free_ = node->link_;
+    --cache.numFree_;
+    return node;
+  }
+
+  //! Return a node, which no other thread can access, to the free list.
+  static void free(Node* node) { cache_.pushFree(node); }
+
+  //! Free the node once no thread holds a hazard pointer on it.
+  static void retire(Node* node) {
+    ThreadCache& cache = cache_;
+    node->link_ = cache.retired_;
+    cache.retired_ = node;
+    // Hazardous nodes stay retired, hence the threshold grows with the number of hazards
+    if (++cache.numRetired_ >= kBatchSize + pool().numHazards_.load(std::memory_order_relaxed)) {
+      cache.scan();
+    }
+  }
+
+ private:
+  static constexpr size_t kBatchSize = 64;         //!< Nodes exchanged with the pool at once
+  static constexpr size_t kMaxScanHazards = 256;   //!< Hazards sorted for a fast lookup
+
+  //! Nodes and hazard records shared by all threads
+  struct Pool {
+    std::mutex lock_;                              //!< Guards the node lists
+    Node* free_ = nullptr;                         //!< Free nodes
+    size_t numFree_ = 0;                           //!< Number of free nodes
+    Node* orphans_ = nullptr;                      //!< Retired nodes of the finished threads
+    std::atomic<HazardRecord*> records_{nullptr};  //!< All hazard records
+    std::atomic<size_t> numHazards_{0};            //!< Number of hazard pointers
+  };
+
+  //! The pool is never destroyed, since threads may exit after the static destructors
+  static Pool& pool() {
+    static Pool* pool = new Pool();
+    return *pool;
+  }
+
+  //! Detach up to count nodes from the list
+  static Node* split(Node*& list, size_t count) {
+    Node* head = list;
+    Node* last = nullptr;
+    for (size_t i = 0; (i < count) && (list != nullptr); ++i) {
+      last = list;
+      list = list->link_;
+    }
+    if (last != nullptr) {
+      last->link_ = nullptr;
+    }
+    return head;
+  }
+
+  //! Return true if any thread holds a hazard pointer on the node
+  static bool isHazard(const void* node) {
+    for (HazardRecord* record = pool().records_.load(std::memory_order_acquire);
+         record != nullptr; record = record->next_) {
+      for (const auto& hazard : record->hazards_) {
+        if (hazard.load(std::memory_order_seq_cst) == node) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  //! Thread local node lists. All members are trivial, so the lists still work when a container
+  //! is used in an exit handler after the destructor of the cache.
+  struct ThreadCache {
+    HazardRecord* record_;   //!< Hazard pointers of the thread
+    Node* free_;             //!< Free nodes
+    size_t numFree_;         //!< Number of free nodes
+    Node* retired_;          //!< Retired nodes
+    size_t numRetired_;      //!< Number of retired nodes
+    void* scanHazards_[kMaxScanHazards];  //!< Hazard pointers collected by the scan
+
+    //! Return the hazard record of the thread, acquire one on the first call
+    HazardRecord* record() {
+      if (likely(record_ != nullptr)) {
+        return record_;
+      }
+      Pool& shared = pool();
+      for (HazardRecord* record = shared.records_.load(std::memory_order_acquire);
+           record != nullptr; record = record->next_) {
+        bool active = false;
+        if (!record->active_.load(std::memory_order_relaxed) &&
+            record->active_.compare_exchange_strong(active, true, std::memory_order_acq_rel)) {
+          record_ = record;
+          return record_;
+        }
+      }
+      HazardRecord* record = new HazardRecord();
+      record->active_.store(true, std::memory_order_relaxed);
+      HazardRecord* head = shared.records_.load(std::memory_order_relaxed);
+      do {
+        record->next_ = head;
+      } while (!shared.records_.compare_exchange_weak(head, record, std::memory_order_release,
+                                                      std::memory_order_relaxed));
+      shared.numHazards_.fetch_add(HazardRecord::kNumHazards, std::memory_order_relaxed);
+      record_ = record;
+      return record_;
+    }
+
+    void pushFree(Node* node) {
+      node->link_ = free_;
+      free_ = node;
+      if (++numFree_ > 2 * kBatchSize) {
+        // Keep the nodes available for the other threads
+        Node* batch = split(free_, kBatchSize);
+        numFree_ -= kBatchSize;
+        Pool& shared = pool();
+        std::lock_guard<std::mutex> lock(shared.lock_);
+        Node* last = batch;
+        while (last->link_ != nullptr) {
+          last = last->link_;
+        }
+        last->link_ = shared.free_;
+        shared.free_ = batch;
+        shared.numFree_ += kBatchSize;
+      }
+    }
+
+    //! Move the retired nodes without hazard pointers to the free list
+    void scan() {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      size_t numHazards = 0;
+      bool overflow = false;
+      for (HazardRecord* record = pool().records_.load(std::memory_order_acquire);
+           record != nullptr; record = record->next_) {
+        for (const auto& hazard : record->hazards_) {
+          void* node = hazard.load(std::memory_order_seq_cst);
+          if (node != nullptr) {
+            if (numHazards < kMaxScanHazards) {
+              scanHazards_[numHazards++] = node;
+            } else {
+              overflow = true;
+            }
+          }
+        }
+      }
+      std::sort(scanHazards_, scanHazards_ + numHazards);
+
+      Node* node = retired_;
+      retired_ = nullptr;
+      numRetired_ = 0;
+      while (node != nullptr) {
+        Node* next = node->link_;
+        bool hazard = overflow
+            ? isHazard(node)
+            : std::binary_search(scanHazards_, scanHazards_ + numHazards,
+                                 static_cast<void*>(node));
+        if (hazard) {
+          node->link_ = retired_;
+          retired_ = node;
+          ++numRetired_;
+        } else {
+          pushFree(node);
+        }
+        node = next;
+      }
+    }
+
+    //! Get free nodes from the pool, the retired nodes or the allocator, in that order
+    void refill() {
+      Pool& shared = pool();
+      {
+        std::lock_guard<std::mutex> lock(shared.lock_);
+        if (shared.free_ != nullptr) {
+          size_t count = std::min(kBatchSize, shared.numFree_);
+          free_ = split(shared.free_, count);
+          numFree_ = count;
+          shared.numFree_ -= count;
+          return;
+        }
+        // Adopt the retired nodes of the finished threads
+        while (shared.orphans_ != nullptr) {
+          Node* node = shared.orphans_;
+          shared.orphans_ = node->link_;
+          node->link_ = retired_;
+          retired_ = node;
+          ++numRetired_;
+        }
+      }
+      if (retired_ != nullptr) {
+        scan();
+        if (free_ != nullptr) {
+          return;
+        }
+      }
+      for (size_t i = 0; i < kBatchSize; ++i) {
+        Node* node = new (AlignedMemory::allocate(sizeof(Node), Alignment)) Node();
+        node->link_ = free_;
+        free_ = node;
+      }
+      numFree_ = kBatchSize;
+    }
+
+    //! Give the nodes and the hazard record back to the other threads
+    ~ThreadCache() {
+      if (record_ != nullptr) {
+        for (auto& hazard : record_->hazards_) {
+          hazard.store(nullptr, std::memory_order_relaxed);
+        }
+        record_->active_.store(false, std::memory_order_release);
+        record_ = nullptr;
+      }
+      Pool& shared = pool();
+      std::lock_guard<std::mutex> lock(shared.lock_);
+      while (free_ != nullptr) {
+        Node* node = free_;
+        free_ = node->link_;
+        node->link_ = shared.free_;
+        shared.free_ = node;
+        ++shared.numFree_;
+      }
+      while (retired_ != nullptr) {
+        Node* node = retired_;
+        retired_ = node->link_;
+        node->link_ = shared.orphans_;
+        shared.orphans_ = node;
+      }
+      numFree_ = 0;
+      numRetired_ = 0;
+    }
+  };
+
+  static inline thread_local ThreadCache cache_ = {};
+};
+
 }  // namespace details
 
 /*! \brief An unbounded thread-safe queue.
  *
  * This queue orders elements first-in-first-out. It is based on the algorithm
  * "Simple, Fast, and Practical Non-Blocking and Blocking Concurrent Queue
- * Algorithms by Maged M. Michael and Michael L. Scott.".
- *
- * FIXME_lmoriche: Implement the new/delete operators for SimplyLinkedNode
- * using thread-local allocation buffers.
+ * Algorithms by Maged M. Michael and Michael L. Scott.". The nodes are recycled
+ * with hazard pointers, as in "Hazard Pointers: Safe Memory Reclamation for
+ * Lock-Free Objects by Maged M. Michael.".
  */
 template <typename T, int N = 5> class ConcurrentLinkedQueue : public HeapObject {
   //! A simply-linked node
@@ -74,6 +333,7 @@ template <typename T, int N = 5> class ConcurrentLinkedQueue : public HeapObject
 
     T value_;                //!< The value stored in that node.
     std::atomic<Ptr> next_;  //!< Pointer to the next node
+    Node* link_;             //!< Link in the free and retired lists
 
     //! Create a Node::Ptr
     static inline Ptr ptr(Node* ptr, size_t counter = 0) {
@@ -86,13 +346,13 @@ template <typename T, int N = 5> class ConcurrentLinkedQueue : public HeapObject
   std::atomic<typename Node::Ptr> tail_;  //! Pointer to the most recent element.
 
  private:
+  typedef details::NodeRecycler<Node, 1 << N> Recycler;
+
   //! \brief Allocate a free node.
-  static inline Node* allocNode() {
-    return new (AlignedMemory::allocate(sizeof(Node), 1 << N)) Node();
-  }
+  static inline Node* allocNode() { return Recycler::alloc(); }
 
   //! \brief Return a node to the free list.
-  static inline void reclaimNode(Node* node) { AlignedMemory::deallocate(node); }
+  static inline void reclaimNode(Node* node) { Recycler::free(node); }
 
  public:
   //! \brief Initialize a new concurrent linked queue.
@@ -143,8 +403,14 @@ template <typename T, int N> inline void ConcurrentLinkedQueue<T, N>::enqueue(T
   node->value_ = elem;
   node->next_ = NULL;
 
+  std::atomic<void*>* hazards = Recycler::hazards();
   for (;;) {
     typename Node::Ptr tail = tail_.load(std::memory_order_acquire);
+    // Protect the tail node, before it can be accessed
+    hazards[0].store(tail->ptr(), std::memory_order_seq_cst);
+    if (unlikely(tail != tail_.load(std::memory_order_seq_cst))) {
+      continue;
+    }
     typename Node::Ptr next = tail->ptr()->next_.load(std::memory_order_acquire);
     if (likely(tail == tail_.load(std::memory_order_acquire))) {
       if (next->ptr() == NULL) {
@@ -153,6 +419,7 @@ template <typename T, int N> inline void ConcurrentLinkedQueue<T, N>::enqueue(T
                                                      std::memory_order_acquire)) {
           tail_.compare_exchange_strong(tail, Node::ptr(node, tail->tag() + 1),
                                         std::memory_order_acq_rel, std::memory_order_acquire);
+          hazards[0].store(nullptr, std::memory_order_release);
           return;
         }
       } else {
@@ -164,13 +431,23 @@ template <typename T, int N> inline void ConcurrentLinkedQueue<T, N>::enqueue(T
 }
 
 template <typename T, int N> inline T ConcurrentLinkedQueue<T, N>::dequeue() {
+  std::atomic<void*>* hazards = Recycler::hazards();
   for (;;) {
     typename Node::Ptr head = head_.load(std::memory_order_acquire);
+    // Protect the head node, before it can be accessed
+    hazards[0].store(head->ptr(), std::memory_order_seq_cst);
+    if (unlikely(head != head_.load(std::memory_order_seq_cst))) {
+      continue;
+    }
     typename Node::Ptr tail = tail_.load(std::memory_order_acquire);
     typename Node::Ptr next = head->ptr()->next_.load(std::memory_order_acquire);
-    if (likely(head == head_.load(std::memory_order_acquire))) {
+    // Protect the next node, since its value is read after the head check
+    hazards[1].store(next->ptr(), std::memory_order_seq_cst);
+    if (likely(head == head_.load(std::memory_order_seq_cst))) {
       if (head->ptr() == tail->ptr()) {
         if (next->ptr() == NULL) {
+          hazards[0].store(nullptr, std::memory_order_release);
+          hazards[1].store(nullptr, std::memory_order_release);
           return NULL;
         }
         tail_.compare_exchange_strong(tail, Node::ptr(next->ptr(), tail->tag() + 1),
@@ -179,8 +456,10 @@ template <typename T, int N> inline T ConcurrentLinkedQueue<T, N>::dequeue() {
         T value = next->ptr()->value_;
         if (head_.compare_exchange_weak(head, Node::ptr(next->ptr(), head->tag() + 1),
                                         std::memory_order_acq_rel, std::memory_order_acquire)) {
-          // we can reclaim head now
-          reclaimNode(head->ptr());
+          hazards[0].store(nullptr, std::memory_order_release);
+          hazards[1].store(nullptr, std::memory_order_release);
+          // Other threads may still access the old head
+          Recycler::retire(head->ptr());
           return value;
         }
       }
@@ -189,21 +468,76 @@ template <typename T, int N> inline T ConcurrentLinkedQueue<T, N>::dequeue() {
 }
 
 template <typename T, int N> inline bool ConcurrentLinkedQueue<T, N>::empty() {
+  std::atomic<void*>* hazards = Recycler::hazards();
   for (;;) {
     typename Node::Ptr head = head_.load(std::memory_order_acquire);
+    hazards[0].store(head->ptr(), std::memory_order_seq_cst);
+    if (unlikely(head != head_.load(std::memory_order_seq_cst))) {
+      continue;
+    }
     typename Node::Ptr tail = tail_.load(std::memory_order_acquire);
     typename Node::Ptr next = head->ptr()->next_.load(std::memory_order_acquire);
     if (likely(head == head_.load(std::memory_order_acquire))) {
-      if (head->ptr() == tail->ptr()) {
-        if (next->ptr() == NULL) {
-          return true;
-        }
-      }
-      return false;
+      hazards[0].store(nullptr, std::memory_order_release);
+      return (head->ptr() == tail->ptr()) && (next->ptr() == NULL);
     }
   }
 }
 
+/*! \brief A per-thread cache of lookups, which don't change once resolved.
+ *
+ * A hit reads a small direct-mapped table of the calling thread and takes no lock.
+ * The entries are inserted after a resolution under the owner's lock. invalidate() drops
+ * the entries of all threads and must be serialized with insert() by the same lock.
+ */
+template <typename Value, uint32_t Size = 128> class ThreadLookupCache : public HeapObject {
+  static_assert((Size & (Size - 1)) == 0, "Size must be a power of 2");
+
+  struct Entry {
+    const void* owner_;    //!< The cache, which inserted the entry
+    const void* key_;      //!< The looked up pointer
+    uint32_t id_;          //!< The secondary key, e.g. the device index
+    uint64_t generation_;  //!< The generation of the cache at the insertion
+    Value value_;          //!< The resolved value
+  };
+
+  //! Generation of all caches of this type, 0 never matches an entry
+  static inline std::atomic<uint64_t> generation_{1};
+  static inline thread_local Entry entries_[Size] = {};
+
+  static Entry& entry(const void* key, uint32_t id) {
+    // Fibonacci hashing spreads the close host pointers over the table
+    uint64_t hash = (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key)) ^
+                     (static_cast<uint64_t>(id) << 48)) * 0x9e3779b97f4a7c15ull;
+    return entries_[(hash >> 40) & (Size - 1)];
+  }
+
+ public:
+  //! Finds the value of the key in the calling thread's cache
+  bool find(const void* key, uint32_t id, Value* value) const {
+    const Entry& e = entry(key, id);
+    if ((e.key_ == key) && (e.id_ == id) && (e.owner_ == this) &&
+        (e.generation_ == generation_.load(std::memory_order_acquire))) {
+      *value = e.value_;
+      return true;
+    }
+    return false;
+  }
+
+  //! Inserts a resolved value into the calling thread's cache
+  void insert(const void* key, uint32_t id, const Value& value) const {
+    Entry& e = entry(key, id);
+    e.owner_ = this;
+    e.key_ = key;
+    e.id_ = id;
+    e.generation_ = generation_.load(std::memory_order_relaxed);
+    e.value_ = value;
+  }
+
+  //! Drops the cached values of all threads
+  void invalidate() { generation_.fetch_add(1, std::memory_order_acq_rel); }
+};
+
 }  // namespace amd
 
 #endif /*CONCURRENT_HPP_*/
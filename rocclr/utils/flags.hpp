@@ -227,6 +227,10 @@ release(bool, DEBUG_CLR_BLIT_KERNARG_OPT, false,                              \
         "Enable blit kernel arguments optimization")                          \
 release(bool, ROC_SKIP_KERNEL_ARG_COPY, false,                                \
         "If true, then runtime can skip kernel arg copy")                     \
+release(bool, ROC_LAZY_QUEUE_RESOURCES, false,                                \
+        "Create the blit, kernel args and printf resources of queues on use") \
+release(uint, ROC_QUEUE_RECYCLE_POOL_SIZE, 0,                                 \
+        "Max number of destroyed queues kept per device for reuse, 0 - none") \
 release(bool, GPU_STREAMOPS_CP_WAIT, false,                                   \
         "Force the stream wait memory operation to wait on CP.")              \
 release(bool, HIP_USE_RUNTIME_UNBUNDLER, false,                               \
@@ -245,6 +249,12 @@ release(cstring, HIPRTC_COMPILE_OPTIONS_APPEND, "",                           \
         "Set compile options needed for hiprtc compilation")                  \
 release(cstring, HIPRTC_LINK_OPTIONS_APPEND, "",                              \
         "Set link options needed for hiprtc compilation")                     \
+release(bool, HIPRTC_USE_BUILTIN_PCH, false,                                  \
+        "Compile hiprtc programs against a precompiled builtin header")       \
+release(cstring, HIPRTC_PCH_CACHE_PATH, "",                                   \
+        "Existing directory, where hiprtc keeps the builtin header PCHs")     \
+release(uint, HIPRTC_COMPILE_THREADS, 0,                                      \
+        "Max threads of a multi-arch hiprtc compile, 0 for the CPU count")    \
 release(bool, HIP_VMEM_MANAGE_SUPPORT, true,                                  \
         "Virtual Memory Management Support")                                  \
 release(bool, DEBUG_HIP_GRAPH_DOT_PRINT, false,                               \
@@ -261,6 +271,22 @@ release(bool, DEBUG_CLR_USE_STDMUTEX_IN_AMD_MONITOR, false,                   \
         "Use std::mutex in amd::monotor")                                     \
 release(bool, DEBUG_CLR_KERNARG_HDP_FLUSH_WA, false,                          \
         "Toggle kernel arg copy workaround")                                  \
+release(bool, DEBUG_HIP_IPC_EVENT_FUTEX, true,                                 \
+        "Sleep on a futex in the IPC event shared memory instead of polling") \
+release(uint, HIP_IPC_MEM_CACHE_ENTRIES, 0,                                   \
+        "Max number of closed IPC memory handles kept attached for reuse")    \
+release(size_t, HIP_IPC_MEM_CACHE_SIZE, 1024,                                 \
+        "Max size in MiB of closed IPC memory handles kept attached")         \
+release(uint, HIP_IPC_MEM_CACHE_TTL, 1000,                                    \
+        "Max time in ms a closed IPC memory handle stays attached")           \
+release(size_t, HIP_HOST_MEM_CACHE_SIZE, 0,                                   \
+        "Max MiB of freed pinned host memory kept for reuse, 0 - disabled")   \
+release(bool, DEBUG_CLR_MONITOR_PROFILE, false,                               \
+        "Collect contention statistics of amd::Monitor locks, print at exit") \
+release(uint, HIP_MEMINFO_RECONCILE_INTERVAL, 100,                            \
+        "Interval in ms to sync the free memory with the driver, 0 - always") \
+release(int, ROC_PREFERRED_NUMA_NODE, -1,                                     \
+        "Force the NUMA node of the host buffers and runtime threads, -1 - nearest") \
 
 namespace amd {
 
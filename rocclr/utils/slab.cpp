@@ -0,0 +1,135 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "utils/slab.hpp"
+#include "utils/util.hpp"
+
+namespace amd {
+
+// ================================================================================================
+SlabAllocator::SlabAllocator(size_t blockSize, size_t blocksPerSlab, AllocSlab allocSlab,
+                             FreeSlab freeSlab)
+    : blockSize_(alignUp(blockSize, kBlockAlignment)),
+      blocksPerSlab_(blocksPerSlab),
+      allocSlab_(std::move(allocSlab)),
+      freeSlab_(std::move(freeSlab)),
+      lock_("Slab allocator", true) {
+  assert(blocksPerSlab_ > 0 && "Slab without blocks");
+}
+
+// ================================================================================================
+SlabAllocator::~SlabAllocator() {
+  for (auto& it : slabs_) {
+    freeSlab_(it.second->base_);
+    delete it.second;
+  }
+}
+
+// ================================================================================================
+void* SlabAllocator::allocate() {
+  ScopedLock lock(lock_);
+  if (available_.empty()) {
+    address base = reinterpret_cast<address>(allocSlab_(blockSize_ * blocksPerSlab_));
+    if (base == nullptr) {
+      return nullptr;
+    }
+    Slab* slab = new Slab{base, {}};
+    slab->free_.reserve(blocksPerSlab_);
+    // The lowest blocks are handed out first
+    for (size_t i = blocksPerSlab_; i > 0; --i) {
+      slab->free_.push_back(static_cast<uint32_t>(i - 1));
+    }
+    slabs_.emplace(base, slab);
+    available_.insert(slab);
+  }
+  Slab* slab = *available_.begin();
+  uint32_t index = slab->free_.back();
+  slab->free_.pop_back();
+  if (slab->free_.empty()) {
+    available_.erase(slab);
+  }
+  if (slab == empty_) {
+    empty_ = nullptr;
+  }
+  ++used_;
+  return slab->base_ + index * blockSize_;
+}
+
+// ================================================================================================
+SlabAllocator::Slab* SlabAllocator::find(const void* ptr) const {
+  const_address block = reinterpret_cast<const_address>(ptr);
+  auto it = slabs_.upper_bound(block);
+  if (it == slabs_.begin()) {
+    return nullptr;
+  }
+  --it;
+  size_t offset = block - it->first;
+  if ((offset >= blockSize_ * blocksPerSlab_) || ((offset % blockSize_) != 0)) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+// ================================================================================================
+bool SlabAllocator::release(void* ptr) {
+  ScopedLock lock(lock_);
+  Slab* slab = find(ptr);
+  if (slab == nullptr) {
+    return false;
+  }
+  slab->free_.push_back(
+      static_cast<uint32_t>((reinterpret_cast<address>(ptr) - slab->base_) / blockSize_));
+  if (slab->free_.size() == 1) {
+    available_.insert(slab);
+  }
+  --used_;
+  if (slab->free_.size() == blocksPerSlab_) {
+    if (empty_ == nullptr) {
+      empty_ = slab;
+    } else {
+      // Keep one empty slab only, so a churn of one block doesn't allocate a slab each time
+      available_.erase(slab);
+      slabs_.erase(slab->base_);
+      freeSlab_(slab->base_);
+      delete slab;
+    }
+  }
+  return true;
+}
+
+// ================================================================================================
+bool SlabAllocator::owns(const void* ptr) const {
+  ScopedLock lock(lock_);
+  return find(ptr) != nullptr;
+}
+
+// ================================================================================================
+size_t SlabAllocator::slabs() const {
+  ScopedLock lock(lock_);
+  return slabs_.size();
+}
+
+// ================================================================================================
+size_t SlabAllocator::used() const {
+  ScopedLock lock(lock_);
+  return used_;
+}
+
+}  // namespace amd
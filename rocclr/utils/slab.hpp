@@ -0,0 +1,92 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+#include "thread/monitor.hpp"
+
+#include <functional>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace amd {
+
+/*! \brief Fixed size blocks carved from larger slabs.
+ *
+ * Small objects, which need a special kind of memory, share the slabs instead of an
+ * allocation each. The freed blocks are recycled. One empty slab is kept for the next
+ * allocations, the other empty slabs are returned to the backing allocator.
+ */
+class SlabAllocator : public HeapObject {
+ public:
+  //! Backing allocator of the slabs
+  typedef std::function<void*(size_t size)> AllocSlab;
+  typedef std::function<void(void* ptr)> FreeSlab;
+
+  //! Alignment of the blocks within a slab
+  static constexpr size_t kBlockAlignment = 64;
+
+  SlabAllocator(size_t blockSize, size_t blocksPerSlab, AllocSlab allocSlab, FreeSlab freeSlab);
+
+  //! Returns all slabs to the backing allocator, the live blocks are lost
+  ~SlabAllocator();
+
+  //! Returns a block, nullptr if a new slab can't be allocated
+  void* allocate();
+
+  //! Recycles a block. Returns false if the block doesn't belong to this allocator
+  bool release(void* ptr);
+
+  //! Returns true if the block belongs to this allocator
+  bool owns(const void* ptr) const;
+
+  //! Returns the number of slabs
+  size_t slabs() const;
+
+  //! Returns the number of allocated blocks
+  size_t used() const;
+
+  //! Returns the block size, including the alignment
+  size_t blockSize() const { return blockSize_; }
+
+ private:
+  struct Slab {
+    address base_;                //!< Start of the slab memory
+    std::vector<uint32_t> free_;  //!< Indices of the free blocks
+  };
+
+  //! Returns the slab of the block, nullptr if none
+  Slab* find(const void* ptr) const;
+
+  const size_t blockSize_;      //!< Aligned block size
+  const size_t blocksPerSlab_;  //!< Number of blocks in a slab
+  AllocSlab allocSlab_;         //!< Allocates the slab memory
+  FreeSlab freeSlab_;           //!< Frees the slab memory
+
+  mutable Monitor lock_;                  //!< Guards the slab lists
+  std::map<const_address, Slab*> slabs_;  //!< All slabs, sorted by the base address
+  std::set<Slab*> available_;             //!< Slabs with a free block
+  Slab* empty_ = nullptr;                 //!< The empty slab, which is kept
+  size_t used_ = 0;                       //!< Number of allocated blocks
+};
+
+}  // namespace amd
@@ -0,0 +1,171 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <os/os.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// The wait protocol of the IPC event shared memory (hip::IpcEventShmemWait): the waiter
+// samples the futex word before the check, so a post after the check fails the futex wait
+struct Shared {
+  std::atomic<uint32_t> word_;
+  std::atomic<uint32_t> waiters_;
+  std::atomic<uint32_t> value_;
+};
+
+constexpr uint64_t kTimeoutNs = 10 * 1000 * 1000;
+
+static void waitFor(Shared* shared, uint32_t value, bool futex, uint64_t timeoutNs = kTimeoutNs) {
+  while (true) {
+    uint32_t word = shared->word_.load();
+    if (shared->value_.load() >= value) {
+      break;
+    }
+    bool slept = false;
+    if (futex) {
+      shared->waiters_++;
+      slept = amd::Os::waitOnAddress(reinterpret_cast<volatile uint32_t*>(&shared->word_), word,
+                                     timeoutNs);
+      shared->waiters_--;
+    }
+    if (!slept) {
+      amd::Os::sleep(1);
+    }
+  }
+}
+
+static void post(Shared* shared, uint32_t value) {
+  shared->value_ = value;
+  shared->word_++;
+  if (shared->waiters_ != 0) {
+    amd::Os::wakeOnAddress(reinterpret_cast<volatile uint32_t*>(&shared->word_));
+  }
+}
+
+static Shared* createShared() {
+  void* ptr = mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+                   -1, 0);
+  if (ptr == MAP_FAILED) {
+    return nullptr;
+  }
+  return new (ptr) Shared{{0}, {0}, {0}};
+}
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+// A changed word returns at once, an unchanged word sleeps until the timeout
+static bool testWaitReturns() {
+  Shared* shared = createShared();
+  CHECK(shared != nullptr);
+  volatile uint32_t* word = reinterpret_cast<volatile uint32_t*>(&shared->word_);
+  uint64_t start = amd::Os::timeNanos();
+  CHECK(amd::Os::waitOnAddress(word, 1, 1000 * 1000 * 1000));
+  CHECK(amd::Os::timeNanos() - start < 100 * 1000 * 1000);
+  start = amd::Os::timeNanos();
+  CHECK(amd::Os::waitOnAddress(word, 0, 2 * 1000 * 1000));
+  CHECK(amd::Os::timeNanos() - start >= 1000 * 1000);
+  munmap(shared, sizeof(Shared));
+  return true;
+}
+
+// A process sleeping on the shared word is woken by a post from another process long
+// before its timeout
+static bool testCrossProcessWake() {
+  Shared* shared = createShared();
+  CHECK(shared != nullptr);
+  constexpr uint64_t kLongTimeoutNs = 5ULL * 1000 * 1000 * 1000;
+  pid_t pid = fork();
+  CHECK(pid >= 0);
+  if (pid == 0) {
+    uint64_t start = amd::Os::timeNanos();
+    waitFor(shared, 1, true, kLongTimeoutNs);
+    // The parent posts after 50ms, a wake by the timeout means the post was lost
+    _exit((amd::Os::timeNanos() - start < kLongTimeoutNs) ? 0 : 1);
+  }
+  // Give the child time to go to sleep on the word
+  while (shared->waiters_ == 0) {
+    amd::Os::sleep(1);
+  }
+  amd::Os::sleep(50);
+  post(shared, 1);
+  int status = 0;
+  CHECK(waitpid(pid, &status, 0) == pid);
+  CHECK(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+  munmap(shared, sizeof(Shared));
+  return true;
+}
+
+// Ping-pong between two processes, like a record in one process and a synchronize in
+// the other. Returns the average round trip in microseconds or a negative value on error
+static double pingPong(bool futex, uint32_t rounds) {
+  Shared* shared = createShared();
+  if (shared == nullptr) {
+    return -1;
+  }
+  pid_t pid = fork();
+  if (pid < 0) {
+    return -1;
+  }
+  if (pid == 0) {
+    for (uint32_t i = 0; i < rounds; ++i) {
+      waitFor(shared, 2 * i + 1, futex);
+      post(shared, 2 * i + 2);
+    }
+    _exit(0);
+  }
+  uint64_t start = amd::Os::timeNanos();
+  for (uint32_t i = 0; i < rounds; ++i) {
+    post(shared, 2 * i + 1);
+    waitFor(shared, 2 * i + 2, futex);
+  }
+  double us = (amd::Os::timeNanos() - start) / 1000.0 / rounds;
+  int status = 0;
+  if ((waitpid(pid, &status, 0) != pid) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+    us = -1;
+  }
+  munmap(shared, sizeof(Shared));
+  return us;
+}
+
+int main() {
+  bool ret = testWaitReturns();
+  printf("testWaitReturns: %s\n", ret ? "Succeeded" : "Failed");
+  bool passed = testCrossProcessWake();
+  printf("testCrossProcessWake: %s\n", passed ? "Succeeded" : "Failed");
+  ret = ret && passed;
+
+  constexpr uint32_t kRounds = 200;
+  double futex = pingPong(true, kRounds);
+  double polling = pingPong(false, kRounds);
+  passed = (futex >= 0) && (polling >= 0);
+  ret = ret && passed;
+  printf("pingPong: %s, round trip %.1f us (1ms polling %.1f us)\n",
+         passed ? "Succeeded" : "Failed", futex, polling);
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <thread/monitor.hpp>
+#include <thread/thread.hpp>
+#include <utils/concurrent.hpp>
+#include <utils/flags.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Stand-in for the static code object: host functions map to per device kernel handles,
+// which are created on the first resolution under the registration lock
+class FakeStatCO {
+ public:
+  FakeStatCO(size_t functions, uint32_t devices) : devices_(devices) {
+    for (size_t i = 0; i < functions; ++i) {
+      functions_[&hostFunctions_[i]] = std::vector<void*>(devices, nullptr);
+    }
+  }
+
+  const void* hostFunction(size_t i) const { return &hostFunctions_[i]; }
+
+  bool resolveLocked(const void* hostFunction, uint32_t device, void** handle) {
+    amd::ScopedLock lock(lock_);
+    auto it = functions_.find(hostFunction);
+    if ((it == functions_.end()) || (device >= devices_)) {
+      return false;
+    }
+    if (it->second[device] == nullptr) {
+      it->second[device] = reinterpret_cast<void*>(
+          (reinterpret_cast<uintptr_t>(hostFunction) << 8) | (device + 1));
+    }
+    *handle = it->second[device];
+    return true;
+  }
+
+  bool resolve(const void* hostFunction, uint32_t device, void** handle) {
+    if (cache_.find(hostFunction, device, handle)) {
+      return true;
+    }
+    amd::ScopedLock lock(lock_);
+    if (!resolveLocked(hostFunction, device, handle)) {
+      return false;
+    }
+    cache_.insert(hostFunction, device, *handle);
+    return true;
+  }
+
+  //! Removes a function, as the module unregistration does
+  void remove(const void* hostFunction) {
+    amd::ScopedLock lock(lock_);
+    cache_.invalidate();
+    functions_.erase(hostFunction);
+  }
+
+ private:
+  amd::Monitor lock_{"FakeStatCO", true};
+  uint32_t devices_;
+  char hostFunctions_[256] = {};
+  std::unordered_map<const void*, std::vector<void*>> functions_;
+  amd::ThreadLookupCache<void*> cache_;
+};
+
+// The runtime locks need an amd::Thread, as an API call creates it for the application threads
+static void attachThread() {
+  if (amd::Thread::current() == nullptr) {
+    new amd::HostThread();
+  }
+}
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+static bool testInvalidate() {
+  FakeStatCO co(16, 2);
+  void* locked = nullptr;
+  void* cached = nullptr;
+  for (size_t i = 0; i < 16; ++i) {
+    for (uint32_t dev = 0; dev < 2; ++dev) {
+      CHECK(co.resolveLocked(co.hostFunction(i), dev, &locked));
+      CHECK(co.resolve(co.hostFunction(i), dev, &cached));
+      CHECK(locked == cached);
+      CHECK(co.resolve(co.hostFunction(i), dev, &cached));
+      CHECK(locked == cached);
+    }
+  }
+  CHECK(!co.resolve(co.hostFunction(0), 2, &cached));
+
+  // The removal is visible to the other threads right away
+  co.remove(co.hostFunction(3));
+  bool found = true;
+  std::thread other([&]() {
+    attachThread();
+    found = co.resolve(co.hostFunction(3), 0, &cached);
+  });
+  other.join();
+  CHECK(!found);
+  CHECK(!co.resolve(co.hostFunction(3), 1, &cached));
+  CHECK(co.resolve(co.hostFunction(4), 1, &cached));
+  return true;
+}
+
+// Launch resolution from several threads: every thread resolves the same kernels in turn
+template <bool Cached>
+static bool launches(size_t threads, size_t iterations, double* seconds) {
+  constexpr size_t kFunctions = 32;
+  FakeStatCO co(kFunctions, 2);
+  std::atomic<bool> failed(false);
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]() {
+      attachThread();
+      const uint32_t device = t & 1;
+      for (size_t i = 0; i < iterations; ++i) {
+        void* handle = nullptr;
+        const void* host = co.hostFunction(i % kFunctions);
+        bool ok = Cached ? co.resolve(host, device, &handle)
+                         : co.resolveLocked(host, device, &handle);
+        if (!ok || ((reinterpret_cast<uintptr_t>(handle) & 0xff) != device + 1)) {
+          failed = true;
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return !failed;
+}
+
+int main() {
+  amd::Flag::init();
+  attachThread();
+  bool ret = testInvalidate();
+  printf("testInvalidate: %s\n", ret ? "Succeeded" : "Failed");
+
+  constexpr size_t kIterations = 1000000;
+  for (size_t threads : {1, 4, 16}) {
+    double cached = 0;
+    double locked = 0;
+    bool passed = launches<true>(threads, kIterations, &cached);
+    passed &= launches<false>(threads, kIterations, &locked);
+    ret = ret && passed;
+    const double lookups = double(threads * kIterations);
+    printf("launches: threads %zu: %s, %.2f M/s (locked %.2f M/s)\n", threads,
+           passed ? "Succeeded" : "Failed", lookups / cached / 1e6, lookups / locked / 1e6);
+  }
+  return ret ? 0 : 1;
+}
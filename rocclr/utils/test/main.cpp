@@ -0,0 +1,211 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <utils/concurrent.hpp>
+#include <utils/flags.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// The queue before the node recycling: a node is allocated on every enqueue and retired
+// on every dequeue. It's kept here as the throughput reference only. The concurrent threads
+// may still read a dequeued node, hence the retired nodes are freed with the queue.
+template <typename T, int N = 5> class AllocatingQueue {
+  struct Node {
+    typedef amd::details::TaggedPointerHelper<Node, N> TaggedPointerHelper;
+    typedef TaggedPointerHelper* Ptr;
+
+    T value_;
+    std::atomic<Ptr> next_;
+    Node* retired_;  //!< Next node in the retired list
+
+    static inline Ptr ptr(Node* ptr, size_t counter = 0) {
+      return TaggedPointerHelper::make(ptr, counter);
+    }
+  };
+
+  std::atomic<typename Node::Ptr> head_;
+  std::atomic<typename Node::Ptr> tail_;
+  std::atomic<Node*> retired_;  //!< Dequeued nodes, which are freed with the queue
+
+  static Node* allocNode() {
+    return new (amd::AlignedMemory::allocate(sizeof(Node), 1 << N)) Node();
+  }
+
+  // The nodes are only pushed until the queue is destroyed, so the list has no ABA problem
+  void retire(Node* node) {
+    node->retired_ = retired_.load(std::memory_order_relaxed);
+    while (!retired_.compare_exchange_weak(node->retired_, node, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+  }
+
+ public:
+  AllocatingQueue() {
+    Node* dummy = allocNode();
+    dummy->next_ = NULL;
+    head_ = tail_ = Node::ptr(dummy);
+    retired_ = NULL;
+  }
+
+  ~AllocatingQueue() {
+    while (dequeue() != NULL) {
+    }
+    amd::AlignedMemory::deallocate(head_.load()->ptr());
+    for (Node* node = retired_.load(); node != NULL;) {
+      Node* next = node->retired_;
+      amd::AlignedMemory::deallocate(node);
+      node = next;
+    }
+  }
+
+  void enqueue(T elem) {
+    Node* node = allocNode();
+    node->value_ = elem;
+    node->next_ = NULL;
+    for (;;) {
+      typename Node::Ptr tail = tail_.load(std::memory_order_acquire);
+      typename Node::Ptr next = tail->ptr()->next_.load(std::memory_order_acquire);
+      if (tail == tail_.load(std::memory_order_acquire)) {
+        if (next->ptr() == NULL) {
+          if (tail->ptr()->next_.compare_exchange_weak(next, Node::ptr(node, next->tag() + 1))) {
+            tail_.compare_exchange_strong(tail, Node::ptr(node, tail->tag() + 1));
+            return;
+          }
+        } else {
+          tail_.compare_exchange_strong(tail, Node::ptr(next->ptr(), tail->tag() + 1));
+        }
+      }
+    }
+  }
+
+  T dequeue() {
+    for (;;) {
+      typename Node::Ptr head = head_.load(std::memory_order_acquire);
+      typename Node::Ptr tail = tail_.load(std::memory_order_acquire);
+      typename Node::Ptr next = head->ptr()->next_.load(std::memory_order_acquire);
+      if (head == head_.load(std::memory_order_acquire)) {
+        if (head->ptr() == tail->ptr()) {
+          if (next->ptr() == NULL) {
+            return NULL;
+          }
+          tail_.compare_exchange_strong(tail, Node::ptr(next->ptr(), tail->tag() + 1));
+        } else {
+          T value = next->ptr()->value_;
+          if (head_.compare_exchange_weak(head, Node::ptr(next->ptr(), head->tag() + 1))) {
+            retire(head->ptr());
+            return value;
+          }
+        }
+      }
+    }
+  }
+};
+
+// Every producer enqueues a strictly increasing sequence tagged with the producer id.
+// The consumers check that nothing is lost or duplicated and that the order of every
+// producer is preserved.
+static constexpr uintptr_t kProducerShift = 48;
+
+template <typename Queue>
+static bool stress(size_t producers, size_t consumers, size_t itemsPerProducer,
+                   double* seconds) {
+  Queue queue;
+  std::atomic<size_t> consumed(0);
+  std::atomic<bool> failed(false);
+  std::vector<std::atomic<uint64_t>> sums(producers);
+  for (auto& sum : sums) {
+    sum = 0;
+  }
+  const size_t total = producers * itemsPerProducer;
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < producers; ++p) {
+    threads.emplace_back([&queue, p, itemsPerProducer]() {
+      for (uintptr_t i = 1; i <= itemsPerProducer; ++i) {
+        queue.enqueue(reinterpret_cast<void*>((p << kProducerShift) | i));
+      }
+    });
+  }
+  for (size_t c = 0; c < consumers; ++c) {
+    threads.emplace_back([&]() {
+      std::vector<uintptr_t> last(producers, 0);
+      while (consumed.load(std::memory_order_relaxed) < total) {
+        void* item = queue.dequeue();
+        if (item == NULL) {
+          std::this_thread::yield();
+          continue;
+        }
+        uintptr_t value = reinterpret_cast<uintptr_t>(item);
+        size_t p = value >> kProducerShift;
+        uintptr_t seq = value & ((uintptr_t(1) << kProducerShift) - 1);
+        if ((p >= producers) || (seq <= last[p])) {
+          failed = true;
+        } else {
+          last[p] = seq;
+          sums[p] += seq;
+        }
+        consumed.fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const uint64_t expected = uint64_t(itemsPerProducer) * (itemsPerProducer + 1) / 2;
+  for (auto& sum : sums) {
+    if (sum != expected) {
+      failed = true;
+    }
+  }
+  return !failed && (queue.dequeue() == NULL);
+}
+
+int main() {
+  amd::Flag::init();
+  bool ret = true;
+
+  struct Config {
+    size_t producers;
+    size_t consumers;
+  };
+  const Config configs[] = {{1, 1}, {4, 1}, {1, 4}, {8, 8}};
+  constexpr size_t kItems = 200000;
+
+  for (const auto& config : configs) {
+    double recycled = 0;
+    double allocating = 0;
+    bool passed = stress<amd::ConcurrentLinkedQueue<void*>>(config.producers, config.consumers,
+                                                             kItems, &recycled);
+    stress<AllocatingQueue<void*>>(config.producers, config.consumers, kItems, &allocating);
+    ret = ret && passed;
+    const double items = double(config.producers * kItems);
+    printf("%s: producers %zu, consumers %zu: %s, %.2f Mops/s (allocating queue %.2f Mops/s)\n",
+           __func__, config.producers, config.consumers, passed ? "Succeeded" : "Failed",
+           items / recycled / 1e6, items / allocating / 1e6);
+  }
+  return ret ? 0 : 1;
+}
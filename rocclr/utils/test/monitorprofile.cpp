@@ -0,0 +1,182 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <thread/monitor.hpp>
+#include <thread/thread.hpp>
+#include <utils/flags.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// The runtime locks need an amd::Thread, as an API call creates it for the application threads
+static void attachThread() {
+  if (amd::Thread::current() == nullptr) {
+    new amd::HostThread();
+  }
+}
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+struct Row {
+  unsigned long long acquires_ = 0;
+  unsigned long long contended_ = 0;
+  double waitUs_ = 0;
+  double maxWaitUs_ = 0;
+  double holdUs_ = 0;
+};
+
+// Looks up the row of a monitor in the dump
+static bool readRow(const char* name, Row* row) {
+  FILE* file = tmpfile();
+  if (file == nullptr) {
+    return false;
+  }
+  amd::profile_monitor::Monitor::dump(file);
+  rewind(file);
+  char line[256];
+  char rowName[64];
+  bool found = false;
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    Row parsed;
+    if ((sscanf(line, "%63s %llu %llu %lf %lf %lf", rowName, &parsed.acquires_,
+                &parsed.contended_, &parsed.waitUs_, &parsed.maxWaitUs_, &parsed.holdUs_) == 6) &&
+        (strcmp(rowName, name) == 0)) {
+      *row = parsed;
+      found = true;
+    }
+  }
+  fclose(file);
+  return found;
+}
+
+// Threads contend a plain and a recursive monitor. The threads exit before the dump,
+// so the statistics come from the retired record, and the second round reuses the free records
+static bool testContention(size_t threads, size_t iterations) {
+  amd::Monitor plain("profile_plain");
+  amd::Monitor recursive("profile_recursive", true);
+  volatile size_t plainCount = 0;
+  volatile size_t recursiveCount = 0;
+
+  for (int round = 1; round <= 2; ++round) {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&]() {
+        attachThread();
+        for (size_t i = 0; i < iterations; ++i) {
+          {
+            amd::ScopedLock lock(plain);
+            plainCount = plainCount + 1;
+          }
+          amd::ScopedLock outer(recursive);
+          amd::ScopedLock inner(recursive);
+          recursiveCount = recursiveCount + 1;
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    const unsigned long long expected = round * threads * iterations;
+    CHECK(plainCount == expected);
+    CHECK(recursiveCount == expected);
+
+    Row row;
+    CHECK(readRow("profile_plain", &row));
+    CHECK(row.acquires_ == expected);
+    CHECK(row.contended_ <= row.acquires_);
+    CHECK(row.maxWaitUs_ <= row.waitUs_);
+    // Every nested acquisition of the recursive monitor is counted
+    CHECK(readRow("profile_recursive", &row));
+    CHECK(row.acquires_ == 2 * expected);
+    CHECK(row.contended_ <= expected);
+    CHECK(row.maxWaitUs_ <= row.waitUs_);
+  }
+  return true;
+}
+
+// The live threads are visible in the dump, and a failed tryLock isn't an acquisition
+static bool testTryLock() {
+  amd::Monitor monitor("profile_trylock");
+  amd::Monitor started("profile_started");
+  bool holding = false;
+  bool release = false;
+
+  std::thread owner([&]() {
+    attachThread();
+    monitor.lock();
+    {
+      amd::ScopedLock lock(started);
+      holding = true;
+      started.notifyAll();
+      while (!release) {
+        // The hold time doesn't include the wait of the notification monitor
+        started.wait();
+      }
+    }
+    monitor.unlock();
+  });
+
+  {
+    amd::ScopedLock lock(started);
+    while (!holding) {
+      started.wait();
+    }
+  }
+  CHECK(!monitor.tryLock());
+  Row row;
+  CHECK(readRow("profile_trylock", &row));
+  CHECK(row.acquires_ == 1);
+  CHECK(row.contended_ == 0);
+
+  {
+    amd::ScopedLock lock(started);
+    release = true;
+    started.notifyAll();
+  }
+  owner.join();
+  CHECK(monitor.tryLock());
+  monitor.unlock();
+  CHECK(readRow("profile_trylock", &row));
+  CHECK(row.acquires_ == 2);
+  return true;
+}
+
+int main() {
+  // Monitors wrap the profiler only when the flag is set at construction
+  setenv("DEBUG_CLR_MONITOR_PROFILE", "1", 1);
+  amd::Flag::init();
+  attachThread();
+
+  bool ret = testContention(8, 20000);
+  printf("testContention: %s\n", ret ? "Succeeded" : "Failed");
+  bool passed = testTryLock();
+  printf("testTryLock: %s\n", passed ? "Succeeded" : "Failed");
+  ret = ret && passed;
+  // The profiler prints the statistics to stderr at exit
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <platform/object.hpp>
+#include <thread/thread.hpp>
+#include <utils/flags.hpp>
+#include <utils/slab.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Stand-in for the fine grained allocations, which back the slabs
+struct FakeBacking {
+  size_t allocs_ = 0;
+  size_t frees_ = 0;
+  bool fail_ = false;
+
+  amd::SlabAllocator* create(size_t blockSize, size_t blocksPerSlab) {
+    return new amd::SlabAllocator(
+        blockSize, blocksPerSlab,
+        [this](size_t size) -> void* {
+          if (fail_) {
+            return nullptr;
+          }
+          allocs_++;
+          return aligned_alloc(4096, amd::alignUp(size, 4096));
+        },
+        [this](void* ptr) {
+          frees_++;
+          free(ptr);
+        });
+  }
+};
+
+// Stand-in for amd::Sampler
+struct FakeSampler : public amd::ReferenceCountedObject {
+  static inline std::atomic<int> live_{0};
+  FakeSampler() { live_++; }
+  ~FakeSampler() { live_--; }
+};
+
+struct FakeState {
+  int filter_;
+  float maxLod_;
+  bool operator<(const FakeState& rhs) const {
+    return (filter_ < rhs.filter_) || ((filter_ == rhs.filter_) && (maxLod_ < rhs.maxLod_));
+  }
+};
+
+#define CHECK(cond)                                                    \
+  if (!(cond)) {                                                       \
+    printf("%s:%d - check failed: %s\n", __FILE__, __LINE__, #cond);   \
+    return false;                                                      \
+  }
+
+static bool testSlabAccounting() {
+  FakeBacking backing;
+  amd::SlabAllocator* slab = backing.create(200, 4);
+  CHECK(slab->blockSize() == 256);
+
+  std::vector<void*> blocks;
+  std::set<void*> unique;
+  for (int i = 0; i < 9; ++i) {
+    void* block = slab->allocate();
+    CHECK(block != nullptr);
+    CHECK(reinterpret_cast<uintptr_t>(block) % amd::SlabAllocator::kBlockAlignment == 0);
+    blocks.push_back(block);
+    unique.insert(block);
+  }
+  CHECK(unique.size() == 9);
+  CHECK(slab->slabs() == 3);
+  CHECK(slab->used() == 9);
+  CHECK(backing.allocs_ == 3);
+
+  // Foreign and misaligned pointers are rejected
+  int local = 0;
+  CHECK(!slab->release(&local));
+  CHECK(!slab->release(static_cast<char*>(blocks[0]) + 8));
+  CHECK(slab->owns(blocks[5]));
+
+  // The freed blocks are reused before a new slab is allocated
+  CHECK(slab->release(blocks[1]));
+  void* reused = slab->allocate();
+  CHECK(reused == blocks[1]);
+  CHECK(backing.allocs_ == 3);
+
+  // One empty slab is kept, the others go back to the backing allocator
+  for (void* block : blocks) {
+    CHECK(slab->release(block));
+  }
+  CHECK(slab->used() == 0);
+  CHECK(slab->slabs() == 1);
+  CHECK(backing.frees_ == 2);
+  CHECK(slab->allocate() != nullptr);
+  CHECK(backing.allocs_ == 3);
+
+  delete slab;
+  CHECK(backing.frees_ == 3);
+  return true;
+}
+
+static bool testSlabFailure() {
+  FakeBacking backing;
+  amd::SlabAllocator* slab = backing.create(64, 2);
+  void* a = slab->allocate();
+  void* b = slab->allocate();
+  backing.fail_ = true;
+  CHECK(slab->allocate() == nullptr);
+  CHECK(slab->used() == 2);
+  CHECK(slab->release(a));
+  CHECK(slab->allocate() == a);
+  CHECK(slab->release(a) && slab->release(b));
+  delete slab;
+  return true;
+}
+
+static bool testSamplerDedup() {
+  amd::SharedObjectCache<FakeState, FakeSampler> cache;
+  int creates = 0;
+  auto create = [&creates]() {
+    creates++;
+    return new FakeSampler();
+  };
+  FakeSampler* a = cache.acquire({1, 8.f}, create);
+  FakeSampler* b = cache.acquire({1, 8.f}, create);
+  FakeSampler* c = cache.acquire({2, 8.f}, create);
+  FakeSampler* d = cache.acquire({1, 4.f}, create);
+  CHECK(a == b);
+  CHECK((a != c) && (a != d) && (c != d));
+  CHECK(creates == 3);
+  CHECK(cache.size() == 3);
+  // The cache and two users
+  CHECK(a->referenceCount() == 3);
+
+  cache.release(a);
+  CHECK(cache.size() == 3);
+  cache.release(b);
+  CHECK(cache.size() == 2);
+  CHECK(FakeSampler::live_ == 2);
+
+  // A released state is created again
+  a = cache.acquire({1, 8.f}, create);
+  CHECK(creates == 4);
+  cache.release(a);
+  cache.release(c);
+  cache.release(d);
+  CHECK(cache.size() == 0);
+  CHECK(FakeSampler::live_ == 0);
+
+  // A failed creation isn't cached
+  CHECK(cache.acquire({3, 0.f}, []() -> FakeSampler* { return nullptr; }) == nullptr);
+  CHECK(cache.size() == 0);
+  return true;
+}
+
+// Texture objects created and destroyed from several threads
+static bool testConcurrent() {
+  FakeBacking backing;
+  amd::SlabAllocator* slab = backing.create(320, 64);
+  amd::SharedObjectCache<FakeState, FakeSampler> cache;
+  std::atomic<bool> failed(false);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&, t]() {
+      if (amd::Thread::current() == nullptr) {
+        new amd::HostThread();
+      }
+      std::vector<std::pair<void*, FakeSampler*>> objects;
+      for (int i = 0; i < 20000; ++i) {
+        void* block = slab->allocate();
+        FakeSampler* sampler =
+            cache.acquire({(t + i) % 4, 0.f}, []() { return new FakeSampler(); });
+        if ((block == nullptr) || (sampler == nullptr)) {
+          failed = true;
+          return;
+        }
+        objects.emplace_back(block, sampler);
+        if (objects.size() > 32) {
+          for (auto& object : objects) {
+            failed = failed || !slab->release(object.first);
+            cache.release(object.second);
+          }
+          objects.clear();
+        }
+      }
+      for (auto& object : objects) {
+        failed = failed || !slab->release(object.first);
+        cache.release(object.second);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CHECK(!failed);
+  CHECK(slab->used() == 0);
+  CHECK(slab->slabs() == 1);
+  CHECK(cache.size() == 0);
+  CHECK(FakeSampler::live_ == 0);
+  delete slab;
+  return true;
+}
+
+int main() {
+  amd::Flag::init();
+  if (amd::Thread::current() == nullptr) {
+    new amd::HostThread();
+  }
+  bool passed = true;
+  passed &= testSlabAccounting();
+  passed &= testSlabFailure();
+  passed &= testSamplerDedup();
+  passed &= testConcurrent();
+  printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}